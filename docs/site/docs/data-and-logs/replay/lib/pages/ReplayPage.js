@@ -251,10 +251,10 @@ export const ReplayPage = () => {
     }
     return null;
   });
-  // Pre-computed wire frames per log row from the C++ LogReplayTask.
-  // Shape: { frames: Uint8Array[], engineResults: object[] }.
-  // engineResults is kept around for ?debug=1; not consumed by the
-  // production rendering path (the firmware sim reads bytes only).
+  // Wire frames per log row from the C++ LogReplaySeeker:
+  // frameAt(rowIdx) → Uint8Array, engineResultAt(rowIdx) → object.
+  // engineResultAt is for ?debug=1; not consumed by the production
+  // rendering path (the firmware sim reads bytes only).
   const [cppWireFrames, setCppWireFrames] = useState(null);
   const [cppBuilding, setCppBuilding] = useState(false);
   const [cppProgress, setCppProgress] = useState(0);
@@ -1262,9 +1262,10 @@ export const ReplayPage = () => {
 
   // C++-engine pre-pass. Runs once per (log, cfg) pair while
   // M5-accurate is on, and survives mode toggle JS↔C++ — clicking
-  // back to C++ reuses the cached frames, no rebuild. Invalidate
-  // only when log or cfg changes. Skipping when M5-accurate is off
-  // saves the cost on JS-only legacy-rec sessions.
+  // back to C++ reuses the same seeker, no rebuild. Invalidate
+  // only when log or cfg changes; the seeker's WASM heap is freed
+  // then. Skipping when M5-accurate is off saves the cost on
+  // JS-only legacy-rec sessions.
   useEffect(() => {
     if (!log || !cfg) {
       setCppWireFrames(null);
@@ -1272,6 +1273,7 @@ export const ReplayPage = () => {
       return;
     }
     let cancelled = false;
+    let seeker = null;
     setCppBuilding(true);
     setCppWireFrames(null);
     setCppProgress(0);
@@ -1280,7 +1282,11 @@ export const ReplayPage = () => {
       (p) => { if (!cancelled) setCppProgress(p); },
       () => cancelled,
     ).then(frames => {
-      if (cancelled) return;
+      if (cancelled) {
+        if (frames) frames.delete();
+        return;
+      }
+      seeker = frames;
       setCppWireFrames(frames);
       setCppBuilding(false);
       setCppProgress(0);
@@ -1290,7 +1296,10 @@ export const ReplayPage = () => {
       setCppBuilding(false);
       setCppProgress(0);
     });
-    return () => { cancelled = true; };
+    return () => {
+      cancelled = true;
+      if (seeker) seeker.delete();
+    };
   }, [log, cfg]);
 
   // Drive the sim's internal mode from whichever slot is active. The
@@ -1402,7 +1411,7 @@ export const ReplayPage = () => {
         : sync.logTakeoffMs + (virtMs / 1000 - sync.videoTakeoffSec) * 1000;
       const rowIdx = findRowAt(log, tickLogMs);
       if (rowIdx < 0) return;
-      const frameBytes = cppWireFrames.frames[rowIdx];
+      const frameBytes = cppWireFrames.frameAt(rowIdx);
       if (!frameBytes) return;               // synth-path lag for this row
       sim.injectBytes(frameBytes);
     };
@@ -1549,11 +1558,11 @@ export const ReplayPage = () => {
         };
         // Production wire frame from the C++ task pre-pass.
         const cppFrame = (cppWireFrames && rowIdx >= 0)
-          ? safeDecode(cppWireFrames.frames[rowIdx]) : null;
+          ? safeDecode(cppWireFrames.frameAt(rowIdx)) : null;
         // C++ engine's ReplayStepResult for this row — independent
         // of which engine arm is currently driving the visible sim.
         const cppEng = (cppWireFrames && rowIdx >= 0)
-          ? cppWireFrames.engineResults[rowIdx] : null;
+          ? cppWireFrames.engineResultAt(rowIdx) : null;
         const cppEngSlice = cppEng ? {
           aoa:    fnum(cppEng.aoaDeg, 2),
           coeffP: fnum(cppEng.coeffP, 3),
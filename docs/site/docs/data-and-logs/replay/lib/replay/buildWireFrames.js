@@ -1,5 +1,5 @@
-// buildWireFrames.js — pre-pass a parsed log through the LogReplayTask
-// and return a per-row array of 77-byte wire frames.
+// buildWireFrames.js — load a parsed log into a LogReplaySeeker, which
+// hands out the 77-byte wire frame for any row on demand.
 //
 // The single-source C++ pipeline (issue #514) handles iasAlive
 // hysteresis, engine smoothing, anchors, percent-lift, and wire
@@ -11,8 +11,7 @@
 // wireBridge.js. Both paths feed sim.injectBytes — the M5 firmware
 // decode is unchanged.
 
-import { LogReplayTask } from './logReplayTask.js';
-import { reassembleResults } from './reassemble.js';
+import { LogReplaySeeker } from './logReplaySeeker.js';
 import { detectLogSampleRate, hasFlapsRawAdc } from './parseLog.js';
 
 // Build a plain JS row object from the columnar log at index i.
@@ -62,19 +61,16 @@ function rowAt(log, i) {
   };
 }
 
-// Pre-pass the log through a fresh LogReplayTask and return a
-// per-row array of Uint8Arrays. The result has length = log.Length;
-// each entry is either a 77-byte frame or null (synth-path lag).
+// Load the log into a LogReplaySeeker and return it. frameAt(i) is the
+// 77-byte wire frame for row i (the same bytes a straight
+// processRow/flush pass yields for that row, synth-path lag already
+// re-aligned on the C++ side); engineResultAt(i) is the C++ engine's
+// ReplayStepResult for it, for the diagnostic mode's comparison
+// against the JS engine's aoaDeg.
 //
-// Synth-path lag handling: the task returns empty arrays during the
-// first ~kSynthHalfWindowTicks rows and at end-of-log returns the
-// trailing rows via flush(). reassembleResults aligns these with
-// original log indices so we can index by row directly.
-//
-// Returns { frames, engineResults } where engineResults[i] is the
-// C++ engine's ReplayStepResult at row i (or null on synth lag).
-// engineResults is provided so the diagnostic mode can compare the
-// C++ engine's per-row aoa against the JS engine's per-row aoaDeg.
+// The pre-pass only copies rows into the WASM heap and records engine
+// checkpoints — no frame is encoded until someone asks for it. Caller
+// owns the result and must delete() it when the log or cfg changes.
 export async function buildWireFramesFromTask(log, cfg, onProgress, isCancelled) {
   if (!log || !cfg) return null;
 
@@ -82,50 +78,29 @@ export async function buildWireFramesFromTask(log, cfg, onProgress, isCancelled)
   const hasPot       = hasFlapsRawAdc(log);
   const N            = log.Length;
 
-  const task = await LogReplayTask.create(cfg, sampleRateHz, hasPot);
-  // Snapshot the cfg's flap detent order as the C++ task internally
-  // sees it. Diagnostic only — verifies the cfg round-trip didn't
-  // shuffle flap entries.
-  let cfgFlapsDeg = null;
-  try { cfgFlapsDeg = task.cfgFlapsDegrees(); } catch (_) { /* binding may be missing */ }
+  const seeker = await LogReplaySeeker.create(cfg, sampleRateHz, hasPot);
   // eslint-disable-next-line no-console
-  console.log('LogReplayTask cfg.aFlaps[*].iDegrees =', cfgFlapsDeg,
-              ' hasPot=', hasPot, ' sampleRateHz=', sampleRateHz);
+  console.log('LogReplaySeeker hasPot=', hasPot, ' sampleRateHz=', sampleRateHz);
 
-  let frames;
-  let engineResults;
+  let ok = false;
   try {
-    const immediates = [];
-    const engImmediates = [];
+    seeker.reserveRows(N);
     const CHUNK = 5000;
     for (let start = 0; start < N; start += CHUNK) {
       if (isCancelled && isCancelled()) return null;
       const end = Math.min(start + CHUNK, N);
-      for (let i = start; i < end; i++) {
-        const bytes = task.processRow(rowAt(log, i));
-        if (bytes.length > 0) {
-          immediates.push(bytes);
-          // Capture the engine result that produced these bytes.
-          engImmediates.push(task.lastStep());
-        } else {
-          immediates.push(null);
-          engImmediates.push(null);
-        }
-      }
-      if (onProgress) onProgress(end / N);
+      for (let i = start; i < end; i++) seeker.appendRow(rowAt(log, i));
+      // Appending is the cheap half; leave the last 10% for the
+      // checkpoint pass below.
+      if (onProgress) onProgress(0.9 * end / N);
       await new Promise(r => setTimeout(r, 0));
     }
-    const tail = task.flush();   // Array<Uint8Array>; non-77-length impossible
-    // For synth-path tail rows we don't have engine results captured
-    // (flush doesn't yield them through the binding today). Pad with
-    // null; the diagnostic just won't have engineResults for the
-    // last ~kSynthHalfWindowTicks rows of an old-style log.
-    const tailEng = new Array(tail.length).fill(null);
-    frames = reassembleResults(immediates, tail, N, hasPot);
-    engineResults = reassembleResults(engImmediates, tailEng, N, hasPot);
+    if (isCancelled && isCancelled()) return null;
+    seeker.buildCheckpoints();
+    if (onProgress) onProgress(1);
+    ok = true;
   } finally {
-    task.delete();
+    if (!ok) seeker.delete();
   }
-
-  return { frames, engineResults };
+  return seeker;
 }
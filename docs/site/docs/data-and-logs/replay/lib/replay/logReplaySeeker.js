@@ -0,0 +1,91 @@
+// logReplaySeeker.js — JS wrapper around the LogReplaySeeker WASM binding.
+//
+// Same pipeline as LogReplayTask (logReplayTask.js), but random-access:
+// the C++ side keeps the parsed rows plus an engine checkpoint every
+// checkpointIntervalSec of log time, and hands out the 77-byte wire
+// frame for any row on demand. See
+// onspeed_core/src/replay/LogReplaySeeker.h.
+//
+// Replaces the old "encode every row up front" pre-pass: the replay page
+// holds one seeker per (log, cfg) instead of a Uint8Array per row, and a
+// scrub costs at most one checkpoint interval of engine steps. Playing
+// forward (the sim driver's 50 ms ticks, MP4 export) steps only the rows
+// in between and encodes only the frames that are injected.
+
+import { getWasmCore } from './wasm_core.js';
+
+export class LogReplaySeeker {
+  // Static factory. Throws if the WASM binding isn't available (rebuild
+  // via software/Libraries/onspeed_core/wasm/build_wasm.sh).
+  // checkpointIntervalSec <= 0 selects the C++ default (10 s).
+  static async create(cfg, logSampleRateHz, flapsRawAdcAvailable,
+                      checkpointIntervalSec = 0) {
+    const Module = await getWasmCore();
+    if (typeof Module.LogReplaySeeker !== 'function') {
+      throw new Error(
+        'LogReplaySeeker: WASM binding not available — rebuild via ' +
+        'software/Libraries/onspeed_core/wasm/build_wasm.sh');
+    }
+    const handle = new Module.LogReplaySeeker(
+      cfg, logSampleRateHz, flapsRawAdcAvailable, checkpointIntervalSec);
+    return new LogReplaySeeker(handle);
+  }
+
+  constructor(handle) {
+    this._handle = handle;
+    this._cachedIdx = -1;      // frameAt() memo: the sim re-reads a row
+    this._cachedFrame = null;  // on every render between wire ticks
+  }
+
+  // Row shape: see bindings.cpp::LogRowFromVal. Returns false once
+  // playback has reached the end of the rows appended so far.
+  appendRow(rowObj) {
+    return this._handle.appendRow(rowObj);
+  }
+
+  reserveRows(count) {
+    this._handle.reserveRows(count);
+  }
+
+  // One pass over every row, recording each checkpoint, so the first
+  // far scrub doesn't have to replay the log up to it.
+  buildCheckpoints() {
+    this._handle.buildCheckpoints();
+  }
+
+  // Wire frame (Uint8Array, 77 bytes) for row i, or null when i is out
+  // of range or the seeker has been deleted.
+  frameAt(i) {
+    if (!this._handle) return null;
+    if (i === this._cachedIdx) return this._cachedFrame;
+    if (!this._handle.seek(i)) return null;
+    const bytes = this._handle.next();
+    this._cachedIdx = i;
+    this._cachedFrame = bytes.length > 0 ? bytes : null;
+    return this._cachedFrame;
+  }
+
+  // The C++ engine's ReplayStepResult for row i (diagnostics).
+  engineResultAt(i) {
+    return this.frameAt(i) ? this._handle.lastStep() : null;
+  }
+
+  get length() {
+    return this._handle ? this._handle.rowCount() : 0;
+  }
+
+  checkpointCount() {
+    return this._handle ? this._handle.checkpointCount() : 0;
+  }
+
+  // Free the WASM-side handle (rows and checkpoints live on the WASM
+  // heap). Later frameAt() calls return null.
+  delete() {
+    if (this._handle) {
+      this._handle.delete();
+      this._handle = null;
+      this._cachedIdx = -1;
+      this._cachedFrame = null;
+    }
+  }
+}
@@ -5,9 +5,10 @@
 // and exposes a simple JS API: construct, processRow, flush, reset,
 // delete.
 //
-// Used by the M5-accurate replay path's "C++ engine" toggle to drive
-// wire bytes from a single C++ entry point — no JS-side rowObjAt or
-// buildDisplayInputs hand-derivation. See the retro at
+// Sequential only. The M5-accurate replay path's "C++ engine" toggle
+// now uses the seekable LogReplaySeeker (logReplaySeeker.js) over the
+// same C++ pipeline — no JS-side rowObjAt or buildDisplayInputs
+// hand-derivation either way. See the retro at
 // docs/superpowers/plans/2026-05-09-replay-retro.md for why the
 // hand-derivations are drift seams.
 
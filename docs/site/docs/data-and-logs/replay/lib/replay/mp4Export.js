@@ -283,13 +283,12 @@ const M5_TICK_MS = 50;
 const M5_LARGE_JUMP_MS = 5000;
 
 function driveSimToVirtMs(sim, state, targetVirtMs, log, sync, cppWireFrames) {
-  const frames = cppWireFrames && cppWireFrames.frames;
   const injectAt = (virtMs) => {
-    if (!frames) return;
+    if (!cppWireFrames) return;
     const logMs = sync.logTakeoffMs + (virtMs / 1000 - sync.videoTakeoffSec) * 1000;
     const rowIdx = findRowAt(log, logMs);
     if (rowIdx < 0) return;
-    const frameBytes = frames[rowIdx];
+    const frameBytes = cppWireFrames.frameAt(rowIdx);
     if (!frameBytes) return;
     sim.injectBytes(frameBytes);
   };
@@ -635,7 +634,7 @@ export async function exportClipAsMp4({
                     '(set both video and log anchors before exporting).');
   }
   if (!log)            throw new Error('exportClipAsMp4: log required');
-  if (!cppWireFrames || !cppWireFrames.frames) {
+  if (!cppWireFrames || typeof cppWireFrames.frameAt !== 'function') {
     throw new Error(
       'exportClipAsMp4: cppWireFrames required (build the replay engine ' +
       'pre-pass first).');
@@ -1459,7 +1458,7 @@ function newTimingsBag() {
 //   clip:               { startMs, endMs, label? } — required.
 //   sync:               { logTakeoffMs, videoTakeoffSec } — required.
 //   log:                parsed log — required.
-//   cppWireFrames:      pre-pass output { frames: Uint8Array[] } — required.
+//   cppWireFrames:      pre-pass output (LogReplaySeeker, frameAt(rowIdx)) — required.
 //   renderOverlaySvg:   (m5State, displayTypeOverride?) → SVGElement.
 //                       The override lets us render a different mode
 //                       per encoder while reusing one sim state. The
@@ -1526,7 +1525,7 @@ export async function exportOverlayOnly({
     throw new Error('exportOverlayOnly: complete sync anchor required.');
   }
   if (!log) throw new Error('exportOverlayOnly: log required');
-  if (!cppWireFrames || !cppWireFrames.frames) {
+  if (!cppWireFrames || typeof cppWireFrames.frameAt !== 'function') {
     throw new Error('exportOverlayOnly: cppWireFrames required.');
   }
   if (!renderOverlaySvg) {
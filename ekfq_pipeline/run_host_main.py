@@ -1,26 +1,38 @@
-"""Subprocess wrapper for host_main ahrs_tone in --input-format=sdlog mode.
+"""Subprocess wrappers for host_main ahrs_tone (--input-format=sdlog) and
+ekfq_sweep.
 
 Used by tune_ekf.py when --driver=host-main is selected. Writes the
 trial's EKFQConfig + PipelineQuatConfig to a temporary kv file, invokes
 host_main, parses the CSV output into a pandas DataFrame, and returns
-it for downstream composite_loss scoring.
+it for downstream composite_loss scoring. When the in-process
+`_onspeed_core` extension is built (tools/onspeed_py/_native.py),
+run_host_main calls its run_ahrs directly instead and skips the process
+spawn and the CSV round trip.
 
-Loss math stays in Python; this wrapper is pure I/O + parameter
-marshalling.
+For run_host_main the loss math stays in Python, so that wrapper is pure
+I/O and parameter marshalling. run_host_main_sweep is different: it hands
+a whole batch of configs to `host_main ekfq_sweep`, which scores them
+in C++ (replay/VnTruthLoss, a port of composite_loss) against one shared
+read of the log.
 """
 
 from __future__ import annotations
 
 import io
 import subprocess
+import sys
 import tempfile
 from pathlib import Path
 from typing import Sequence
 
+import numpy as np
 import pandas as pd
 
 from onspeed_ekf import EKFQConfig, PipelineQuatConfig
 
+sys.path.insert(0, str(Path(__file__).resolve().parents[1] / "tools"))
+from onspeed_py._native import native  # noqa: E402
+
 
 # Mapping from Python field names to the kv-file keys host_main expects.
 # tas_min_mps is intentionally omitted: it gates beta-dynamics activation
@@ -58,14 +70,19 @@ _PIPE_KV_KEYS: tuple[tuple[str, str], ...] = (
 )
 
 
-def _write_kv(ekfq_cfg: EKFQConfig, pipe_cfg: PipelineQuatConfig, path: Path) -> None:
-    lines = ["# Auto-generated by run_host_main.py"]
+def _kv_lines(ekfq_cfg: EKFQConfig, pipe_cfg: PipelineQuatConfig) -> list[str]:
+    lines = []
     for py_attr, kv_key in _KV_KEYS:
         v = getattr(ekfq_cfg, py_attr)
         lines.append(f"{kv_key}={v!r}")
     for py_attr, kv_key in _PIPE_KV_KEYS:
         v = getattr(pipe_cfg, py_attr)
         lines.append(f"{kv_key}={v!r}")
+    return lines
+
+
+def _write_kv(ekfq_cfg: EKFQConfig, pipe_cfg: PipelineQuatConfig, path: Path) -> None:
+    lines = ["# Auto-generated by run_host_main.py"] + _kv_lines(ekfq_cfg, pipe_cfg)
     path.write_text("\n".join(lines) + "\n")
 
 
@@ -77,7 +94,23 @@ def run_host_main(
     pipe_cfg: PipelineQuatConfig,
     passthrough_cols: Sequence[str],
 ) -> pd.DataFrame:
-    """Invoke host_main ahrs_tone for one Optuna trial."""
+    """Invoke host_main ahrs_tone for one Optuna trial.
+
+    Uses the in-process `_onspeed_core.run_ahrs` when it is built; the
+    returned frame has the same columns either way.
+    """
+    mod = native()
+    if mod is not None:
+        table = mod.run_ahrs(
+            str(log_path), str(config_path),
+            algorithm="ekfq",
+            ekfq_config="\n".join(_kv_lines(ekfq_cfg, pipe_cfg)),
+            passthrough=tuple(passthrough_cols),
+            row_cache=True,
+        )
+        df = pd.DataFrame(np.asarray(table), columns=list(table.columns))
+        return df.astype({"tone_level": int})
+
     with tempfile.TemporaryDirectory() as td:
         kv_path = Path(td) / "trial.kv"
         _write_kv(ekfq_cfg, pipe_cfg, kv_path)
@@ -88,6 +121,9 @@ def run_host_main(
             "--input", str(log_path),
             "--config", str(config_path),
             "--ekfq-config", str(kv_path),
+            # Every trial replays the same log; parse it once and reuse
+            # the <log>.rowcache sidecar for the rest of the study.
+            "--row-cache",
         ]
         if passthrough_cols:
             argv += ["--passthrough-cols", ",".join(passthrough_cols)]
@@ -98,3 +134,46 @@ def run_host_main(
                 f"{proc.stderr[-1000:]}"
             )
         return pd.read_csv(io.StringIO(proc.stdout))
+
+
+def run_host_main_sweep(
+    host_main_path: Path,
+    log_path: Path,
+    config_path: Path,
+    configs: Sequence[tuple[EKFQConfig, PipelineQuatConfig]],
+    loss_mode: str = "cruise-aoa",
+    threads: int | None = None,
+    sequential_update: bool = False,
+) -> pd.DataFrame:
+    """Score a batch of configs in one host_main ekfq_sweep process.
+
+    Returns one row per config (same order) with the loss breakdown
+    replay::VnTruthLoss computes: loss, pitch_rms, roll_rms, vz_rms,
+    the three *_rate_rms terms, alpha_kin_rms, alpha_pressure_diag.
+    Scores cover the whole log; there is no train/val split.
+
+    sequential_update=True runs EKFQ's scalar-at-a-time correct(),
+    which is cheaper per step and matches the batch loss to rounding.
+    """
+    with tempfile.TemporaryDirectory() as td:
+        sweep_path = Path(td) / "sweep.kv"
+        mode = [f"sequential_update={int(sequential_update)}"]
+        blocks = ["\n".join(_kv_lines(e, p) + mode) for e, p in configs]
+        sweep_path.write_text("\n---\n".join(blocks) + "\n")
+        argv = [
+            str(host_main_path), "ekfq_sweep",
+            "--input", str(log_path),
+            "--config", str(config_path),
+            "--sweep", str(sweep_path),
+            "--loss-mode", loss_mode,
+            "--row-cache",
+        ]
+        if threads is not None:
+            argv += ["--threads", str(threads)]
+        proc = subprocess.run(argv, capture_output=True, text=True)
+        if proc.returncode != 0:
+            raise RuntimeError(
+                f"host_main ekfq_sweep exited {proc.returncode}: "
+                f"{proc.stderr[-1000:]}"
+            )
+        return pd.read_csv(io.StringIO(proc.stdout))
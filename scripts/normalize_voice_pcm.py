@@ -1,5 +1,5 @@
 #!/usr/bin/env python3
-"""Normalize voice PCM headers to peak amplitude.
+"""Normalize voice PCM headers to peak amplitude, and encode them for flash.
 
 Each file in software/OnSpeed-Gen3-ESP32/Audio/PCM_*.h holds a header-less
 int16 LE PCM stream wrapped in a `const unsigned char xxx_pcm[]` array.
@@ -10,6 +10,22 @@ preserving the original 16-bytes-per-line array layout.
 Used as a one-shot when retiring VOICE_BOOST: after running this, every
 PCM file is mastered at the same loudness, and the runtime gain chain
 (fVolume * pan * envelope) can use a unity boost without clipping.
+
+`--encode` leaves the masters alone and writes Audio/VoiceAssets.h: each
+prompt with near-silent ends trimmed (the cut lengths are recorded and
+played back as zeros) and the rest IMA ADPCM coded in 240-sample blocks,
+the layout onspeed_core audio/VoiceCodec.h decodes. The firmware links
+only VoiceAssets.h. Encoding is deterministic, so an unchanged master
+regenerates a byte-identical header.
+
+PlatformIO usage (auto): registered as a `pre:` extra_script in
+platformio.ini's shared [env] block, where it runs `--encode` only when
+a master or this script is newer than VoiceAssets.h.
+
+Standalone usage:
+    python3 scripts/normalize_voice_pcm.py            # normalize masters
+    python3 scripts/normalize_voice_pcm.py --encode   # regenerate VoiceAssets.h
+    python3 scripts/normalize_voice_pcm.py --check    # exit 1 if it is stale
 """
 
 import glob
@@ -20,14 +36,47 @@ import sys
 
 PEAK_TARGET = int(0.99 * 32767)   # 32439
 
+# |sample| at or below this counts as silence when trimming (-54 dBFS).
+SILENCE_THRESHOLD = 64
+SAMPLE_RATE_HZ = 16000
+BLOCK_SAMPLES = 240               # audio/VoiceCodec.h kVoiceBlockSamples
+BLOCK_HEADER_BYTES = 4
+
+# See build_web_bundle.py: under PIO `__file__` is unset and the repo root
+# comes from the SCons environment.
+try:
+    Import("env")  # noqa: F821 — provided by SCons in PIO context
+    REPO_ROOT = env["PROJECT_DIR"]  # noqa: F821
+    RUN_FROM_PIO = True
+except (NameError, Exception):
+    REPO_ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    RUN_FROM_PIO = False
+
+SCRIPT_PATH = os.path.join(REPO_ROOT, "scripts", "normalize_voice_pcm.py")
+
 AUDIO_DIR = os.path.join(
-    os.path.dirname(os.path.abspath(__file__)),
-    "..",
+    REPO_ROOT,
     "software",
     "OnSpeed-Gen3-ESP32",
     "Audio",
 )
 
+OUTPUT_H = os.path.join(AUDIO_DIR, "VoiceAssets.h")
+
+# Standard IMA ADPCM tables, identical to onspeed_core audio/VoiceCodec.cpp.
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
 
 def parse(path):
     """Return (header, samples list[int], footer) where header ends at the
@@ -86,7 +135,172 @@ def normalize(samples):
     return out, scale
 
 
+def trim(samples):
+    """Return (lead, body, trail): the near-silent run at each end and the
+    samples between them. An all-silent clip is all lead."""
+    n = len(samples)
+    lead = 0
+    while lead < n and abs(samples[lead]) <= SILENCE_THRESHOLD:
+        lead += 1
+    trail = 0
+    while trail < n - lead and abs(samples[n - 1 - trail]) <= SILENCE_THRESHOLD:
+        trail += 1
+    return lead, samples[lead : n - trail], trail
+
+
+def _decode_step(code, predictor, index):
+    step = STEP_TABLE[index]
+    diff = step >> 3
+    if code & 4:
+        diff += step
+    if code & 2:
+        diff += step >> 1
+    if code & 1:
+        diff += step >> 2
+    predictor += -diff if code & 8 else diff
+    predictor = max(-32768, min(32767, predictor))
+    index = max(0, min(88, index + INDEX_TABLE[code]))
+    return predictor, index
+
+
+def ima_encode(samples):
+    """IMA ADPCM in BLOCK_SAMPLES-sample blocks. Each block header holds the
+    encoder state the decoder must start from; the tail block is padded
+    with zero codes. Returns (bytes, decoded samples) — the latter is what
+    the firmware will play, for the SNR report."""
+    out = bytearray()
+    decoded = []
+    predictor, index = 0, 0
+    for start in range(0, len(samples), BLOCK_SAMPLES):
+        block = samples[start : start + BLOCK_SAMPLES]
+        out += struct.pack("<hBB", predictor, index, 0)
+        codes = []
+        for s in block:
+            diff = s - predictor
+            code = 0
+            if diff < 0:
+                code = 8
+                diff = -diff
+            step = STEP_TABLE[index]
+            if diff >= step:
+                code |= 4
+                diff -= step
+            step >>= 1
+            if diff >= step:
+                code |= 2
+                diff -= step
+            step >>= 1
+            if diff >= step:
+                code |= 1
+            predictor, index = _decode_step(code, predictor, index)
+            codes.append(code)
+            decoded.append(predictor)
+        codes += [0] * (BLOCK_SAMPLES - len(codes))
+        for i in range(0, BLOCK_SAMPLES, 2):
+            out.append(codes[i] | (codes[i + 1] << 4))
+    return bytes(out), decoded
+
+
+def snr_db(ref, test):
+    import math
+    sig = sum(s * s for s in ref)
+    err = sum((a - b) * (a - b) for a, b in zip(ref, test))
+    if err == 0:
+        return float("inf")
+    return 10.0 * math.log10(sig / err) if sig else 0.0
+
+
+def asset_name(header, path):
+    m = re.search(r"(\w+)_pcm\s*\[\]", header)
+    if m is None:
+        raise RuntimeError(f"no `<name>_pcm[]` array in {path}")
+    return m.group(1)
+
+
+def render_assets(files):
+    """Return (header text, report rows) for the encoded masters."""
+    parts = [
+        "// VoiceAssets.h — GENERATED by scripts/normalize_voice_pcm.py --encode.",
+        "// Do not edit: change the Audio/PCM_*.h masters and re-run.",
+        "//",
+        "// IMA ADPCM voice prompts for onspeed_core audio/VoiceCodec.h.",
+        "",
+        "#ifndef ONSPEED_AUDIO_VOICE_ASSETS_H",
+        "#define ONSPEED_AUDIO_VOICE_ASSETS_H",
+        "",
+        "#include <cstdint>",
+        "",
+        "#include <audio/VoiceCodec.h>",
+        "",
+    ]
+    report = []
+    for path in files:
+        header, samples, _footer = parse(path)
+        name = asset_name(header, path)
+        lead, body, trail = trim(samples)
+        data, decoded = ima_encode(body)
+        report.append((os.path.basename(path), 2 * len(samples), len(data),
+                       lead, trail, snr_db(body, decoded)))
+
+        parts.append(f"// {os.path.basename(path)}: {2 * len(samples)} -> {len(data)} bytes")
+        parts.append(f"static const std::uint8_t {name}_adpcm[] = {{")
+        for i in range(0, len(data), 16):
+            parts.append("  " + ", ".join(f"0x{b:02x}" for b in data[i : i + 16]) + ",")
+        parts.append("};")
+        parts.append(f"static const onspeed::audio::VoiceAsset {name}_voice = {{")
+        parts.append(f"    {name}_adpcm, sizeof({name}_adpcm), "
+                     f"{len(body)}, {lead}, {trail}, {SAMPLE_RATE_HZ},")
+        parts.append("};")
+        parts.append("")
+    parts.append("#endif   // ONSPEED_AUDIO_VOICE_ASSETS_H")
+    return "\n".join(parts) + "\n", report
+
+
+def needs_encode():
+    if not os.path.exists(OUTPUT_H):
+        return True
+    out_mtime = os.path.getmtime(OUTPUT_H)
+    inputs = [SCRIPT_PATH] + glob.glob(os.path.join(AUDIO_DIR, "PCM_*.h"))
+    return any(os.path.getmtime(p) > out_mtime for p in inputs if os.path.exists(p))
+
+
+def encode(check=False):
+    files = sorted(glob.glob(os.path.join(AUDIO_DIR, "PCM_*.h")))
+    if not files:
+        print(f"no PCM_*.h files found in {AUDIO_DIR}", file=sys.stderr)
+        return 1
+    text, report = render_assets(files)
+
+    old = None
+    if os.path.exists(OUTPUT_H):
+        with open(OUTPUT_H) as f:
+            old = f.read()
+    if check:
+        if old != text:
+            print(f"{OUTPUT_H} is stale; run scripts/normalize_voice_pcm.py --encode",
+                  file=sys.stderr)
+            return 1
+        return 0
+    if old != text:
+        with open(OUTPUT_H, "w") as f:
+            f.write(text)
+
+    print(f"{'file':28s}  {'raw':>7s}  {'adpcm':>6s}  {'lead_ms':>7s}  {'trail_ms':>8s}  {'snr_db':>6s}")
+    for base, raw, enc, lead, trail, snr in report:
+        print(f"{base:28s}  {raw:7d}  {enc:6d}  {lead * 1000 // SAMPLE_RATE_HZ:7d}  "
+              f"{trail * 1000 // SAMPLE_RATE_HZ:8d}  {snr:6.1f}")
+    total_raw = sum(r[1] for r in report)
+    total_enc = sum(r[2] for r in report)
+    print(f"normalize_voice_pcm: {total_raw:,} -> {total_enc:,} bytes")
+    return 0
+
+
 def main():
+    if "--encode" in sys.argv[1:]:
+        return encode()
+    if "--check" in sys.argv[1:]:
+        return encode(check=True)
+
     files = sorted(glob.glob(os.path.join(AUDIO_DIR, "PCM_*.h")))
     if not files:
         print(f"no PCM_*.h files found in {AUDIO_DIR}", file=sys.stderr)
@@ -106,5 +320,8 @@ def main():
     return 0
 
 
-if __name__ == "__main__":
+if RUN_FROM_PIO:
+    if needs_encode():
+        encode()
+elif __name__ == "__main__":
     sys.exit(main())
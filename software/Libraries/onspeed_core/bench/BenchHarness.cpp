@@ -0,0 +1,111 @@
+// BenchHarness.cpp — allocation counting, flag parsing and report output
+// for bench_core. See BenchHarness.h.
+
+#include "BenchHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// Single-threaded bench: plain counters are enough.
+uint64_t g_allocs = 0;
+uint64_t g_bytes  = 0;
+
+void* CountedAlloc(std::size_t size)
+{
+    ++g_allocs;
+    g_bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+// Replaced global allocation functions. Every heap allocation in the
+// process, core library included, goes through these.
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace onspeed::bench {
+
+AllocCounts CurrentAllocCounts()
+{
+    AllocCounts c;
+    c.allocs = g_allocs;
+    c.bytes  = g_bytes;
+    return c;
+}
+
+BenchRunner::BenchRunner(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(a, "--json") == 0 && hasValue) {
+            jsonPath_ = argv[++i];
+        } else if (std::strcmp(a, "--filter") == 0 && hasValue) {
+            filter_ = argv[++i];
+        } else if (std::strcmp(a, "--min-time-ms") == 0 && hasValue) {
+            minTimeNs_ = std::atof(argv[++i]) * 1e6;
+        } else if (std::strcmp(a, "--reps") == 0 && hasValue) {
+            reps_ = std::atoi(argv[++i]);
+        } else {
+            badArgs_ = true;
+        }
+    }
+    if (minTimeNs_ <= 0.0 || reps_ < 1) badArgs_ = true;
+    if (badArgs_) {
+        std::fprintf(stderr,
+            "usage: %s [--json PATH] [--filter SUBSTR] [--min-time-ms N] [--reps N]\n",
+            argc > 0 ? argv[0] : "bench_core");
+    }
+}
+
+bool BenchRunner::Selected(const char* name) const
+{
+    return filter_.empty() || std::strstr(name, filter_.c_str()) != nullptr;
+}
+
+int BenchRunner::Finish()
+{
+    if (badArgs_) return 2;
+
+    std::printf("%-36s %12s %12s %10s %10s\n",
+                "benchmark", "iterations", "ns/op", "allocs/op", "bytes/op");
+    for (const BenchResult& r : results_) {
+        std::printf("%-36s %12llu %12.1f %10.2f %10.1f\n", r.name.c_str(),
+                    static_cast<unsigned long long>(r.iterations),
+                    r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+    }
+
+    if (jsonPath_.empty()) return 0;
+    FILE* f = std::fopen(jsonPath_.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "bench_core: cannot write %s\n", jsonPath_.c_str());
+        return 1;
+    }
+    // Names are fixed ASCII identifiers chosen in bench_core.cpp; no
+    // escaping needed.
+    std::fprintf(f, "{\n  \"schema\": 1,\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const BenchResult& r = results_[i];
+        std::fprintf(f,
+            "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, "
+            "\"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f}%s\n",
+            r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+            r.nsPerOp, r.allocsPerOp, r.bytesPerOp,
+            (i + 1 < results_.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    std::fclose(f);
+    return 0;
+}
+
+}  // namespace onspeed::bench
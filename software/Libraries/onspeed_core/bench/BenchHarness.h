@@ -0,0 +1,126 @@
+// BenchHarness.h — minimal host micro-benchmark runner for bench_core.
+//
+// Each case is a callable that performs one operation. BenchRunner::Run
+// warms it up, picks an iteration count that fills --min-time-ms, times
+// the best of several repetitions, and counts heap allocations over one
+// repetition through a replaced global operator new (BenchHarness.cpp).
+// Finish() prints a table and, with --json PATH, writes the results for
+// tools/bench/compare_host_bench.py to diff against bench/baseline.json.
+//
+// Host-only, single-threaded. Not part of the onspeed_core library.
+
+#ifndef ONSPEED_CORE_BENCH_BENCH_HARNESS_H
+#define ONSPEED_CORE_BENCH_BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace onspeed::bench {
+
+/// Keep `value` (and everything it depends on) from being optimised away.
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/// Running totals from the replaced operator new, since process start.
+struct AllocCounts {
+    uint64_t allocs = 0;
+    uint64_t bytes  = 0;
+};
+AllocCounts CurrentAllocCounts();
+
+struct BenchResult {
+    std::string name;
+    uint64_t    iterations  = 0;   // per timed repetition
+    double      nsPerOp     = 0.0; // best repetition
+    double      allocsPerOp = 0.0;
+    double      bytesPerOp  = 0.0;
+};
+
+class BenchRunner {
+public:
+    // Flags: --json PATH, --filter SUBSTR, --min-time-ms N, --reps N.
+    // Unknown flags print usage and set exit code 2 (see Finish()).
+    BenchRunner(int argc, char** argv);
+
+    /// Time `op` under `name` unless --filter excludes it.
+    template <typename Op>
+    void Run(const char* name, Op&& op);
+
+    /// Print the table, write --json if requested. Returns the process
+    /// exit code.
+    int Finish();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool   Selected(const char* name) const;
+
+    template <typename Op>
+    static double TimeNs(Op& op, uint64_t iterations);
+
+    std::vector<BenchResult> results_;
+    std::string jsonPath_;
+    std::string filter_;
+    double      minTimeNs_ = 200e6;
+    int         reps_      = 5;
+    bool        badArgs_   = false;
+};
+
+template <typename Op>
+double BenchRunner::TimeNs(Op& op, uint64_t iterations)
+{
+    const auto t0 = Clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) op();
+    const auto t1 = Clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+template <typename Op>
+void BenchRunner::Run(const char* name, Op&& op)
+{
+    if (badArgs_ || !Selected(name)) return;
+
+    // Warm-up: first-use statics, caches, branch predictors.
+    for (int i = 0; i < 16; ++i) op();
+
+    // Grow the iteration count until one repetition fills minTimeNs_/reps_.
+    const double target = minTimeNs_ / reps_;
+    uint64_t n = 1;
+    double   elapsed = TimeNs(op, n);
+    while (elapsed < target) {
+        const double scale = (elapsed > 0.0) ? 1.2 * target / elapsed : 10.0;
+        n = static_cast<uint64_t>(static_cast<double>(n) *
+                                  (scale < 2.0 ? 2.0 : (scale > 10.0 ? 10.0 : scale)));
+        elapsed = TimeNs(op, n);
+    }
+
+    BenchResult r;
+    r.name       = name;
+    r.iterations = n;
+    r.nsPerOp    = elapsed / static_cast<double>(n);
+    for (int rep = 0; rep < reps_; ++rep) {
+        const AllocCounts before = CurrentAllocCounts();
+        const double ns = TimeNs(op, n) / static_cast<double>(n);
+        const AllocCounts after = CurrentAllocCounts();
+        if (ns < r.nsPerOp) r.nsPerOp = ns;
+        if (rep == 0) {
+            r.allocsPerOp = static_cast<double>(after.allocs - before.allocs) / n;
+            r.bytesPerOp  = static_cast<double>(after.bytes - before.bytes) / n;
+        }
+    }
+    results_.push_back(r);
+}
+
+}  // namespace onspeed::bench
+
+#endif  // ONSPEED_CORE_BENCH_BENCH_HARNESS_H
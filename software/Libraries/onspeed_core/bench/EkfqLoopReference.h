@@ -0,0 +1,55 @@
+// EkfqLoopReference.h — the pre-FixedMatrix EKFQ update, frozen as a
+// benchmark baseline.
+//
+// Same state, config and algebra as onspeed::EKFQ, with the covariance
+// held as a full 11×11 array and the correct step looping over a
+// runtime measurement count. bench_ekfq_kernels runs it side by side
+// with EKFQ to time the kernels and bound the numerical divergence.
+
+#ifndef ONSPEED_CORE_BENCH_EKFQ_LOOP_REFERENCE_H
+#define ONSPEED_CORE_BENCH_EKFQ_LOOP_REFERENCE_H
+
+#include <ahrs/EKFQ.h>
+
+namespace onspeed::bench {
+
+class EkfqLoopReference {
+public:
+    static constexpr int N_STATES = EKFQ::N_STATES;
+
+    enum {
+        Q0 = EKFQ::Q0, Q1 = EKFQ::Q1, Q2 = EKFQ::Q2, Q3 = EKFQ::Q3,
+        BP_IDX = EKFQ::BP_IDX, BQ_IDX = EKFQ::BQ_IDX, BR_IDX = EKFQ::BR_IDX,
+        Z = EKFQ::Z, VZ = EKFQ::VZ, B_AZ = EKFQ::B_AZ,
+        BETA = EKFQ::BETA
+    };
+
+    explicit EkfqLoopReference(const EKFQ::Config& cfg) : config_(cfg) {}
+
+    /// EKFQ::init() for a level start (roll = pitch = 0).
+    void init(float initial_z);
+
+    void predict(float p, float q, float r,
+                 float ax, float ay, float az,
+                 float tas, float dt);
+    void correct(float ax, float ay, float az,
+                 float tas, float tasDot,
+                 float pitchRate, float yawRate,
+                 float baroZ, bool updateBaro);
+
+    EKFQ::State getState() const;
+    float getP(int i, int j) const { return P_[i][j]; }
+
+private:
+    EKFQ::Config config_;
+    float x_[N_STATES];
+    float P_[N_STATES][N_STATES];
+
+    static constexpr float GRAVITY = 9.80665f;
+
+    void renormaliseQuaternion();
+};
+
+}  // namespace onspeed::bench
+
+#endif  // ONSPEED_CORE_BENCH_EKFQ_LOOP_REFERENCE_H
@@ -0,0 +1,499 @@
+// bench_core.cpp — host micro-benchmarks for the onspeed_core hot paths.
+//
+// One case per per-sample or per-byte call the firmware makes at rate:
+//
+//   ahrs_step/{madgwick,ekfq}      Ahrs::Step at 208 Hz
+//   ekfq_update/scalar_x8          EKFQ::update on 8 filters (8 configs)
+//   ekfq_update/batch_x8           EKFQBatch::update, the same 8 as lanes;
+//                                  the ekfq_sweep host tool's inner loop
+//   log_replay_engine/step         LogReplayEngine::step, one log row
+//   log_csv/format_row             FormatRow, VN-300 row (the widest)
+//   log_csv/parse_row_by_index     ParseRowByIndex on that same line
+//   efis_feed_byte/<protocol>      EfisParser::FeedByte + TryTakeFrame,
+//                                  per byte of a valid frame stream
+//   display/build_frame            BuildDisplayFrame
+//   live_data/build_bin_frame      BuildLiveDataBinFrame, one WebSocket tick
+//   tone_synth/synthesize_240      Synthesize, one 240-sample I2S block
+//   oscillator/render_240          Oscillator::Render, the same block
+//   audio_mixer/mix_240            Mix with a pulsing envelope, one block
+//   audio_mixer/mix_oscillator_240 Mix rendering the carrier from an Oscillator
+//
+// Inputs are synthetic and deterministic (no fixture files), so the
+// numbers depend only on the code and the machine. Reports ns/op and
+// heap allocations per op; --json writes them for
+// tools/bench/compare_host_bench.py to check against bench/baseline.json.
+//
+//   cmake -S . -B build -DONSPEED_CORE_BUILD_BENCH=ON -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build --target bench_core
+//   build/bench_core --json bench.json
+
+#include "BenchHarness.h"
+
+#include <ahrs/Ahrs.h>
+#include <ahrs/EKFQ.h>
+#include <ahrs/EKFQBatch.h>
+#include <audio/AudioMixer.h>
+#include <audio/Envelope.h>
+#include <audio/Oscillator.h>
+#include <audio/ToneSynth.h>
+#include <config/OnSpeedConfig.h>
+#include <efis/EfisParser.h>
+#include <proto/DisplaySerial.h>
+#include <proto/LiveDataBin.h>
+#include <proto/LogCsv.h>
+#include <proto/LogCsvHeaderIndex.h>
+#include <replay/LogReplayEngine.h>
+#include <test_frames/SynthFrames.h>
+#include <types/EfisFrame.h>
+#include <types/LogRow.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using onspeed::bench::BenchRunner;
+using onspeed::bench::DoNotOptimize;
+
+namespace {
+
+constexpr int      kImuRateHz   = 208;
+constexpr uint32_t kImuPeriodUs = 1000000u / kImuRateHz;
+constexpr int      kFlightLen   = 2048;      // samples cycled by the AHRS / replay cases
+constexpr size_t   kAudioBlock  = 240;       // Audio.cpp kFramesPerWrite
+constexpr int      kAudioRateHz = 16000;
+
+// ---------------------------------------------------------------------------
+// Synthetic flight: gentle turns and pull-ups with sensor noise.
+// ---------------------------------------------------------------------------
+
+struct FlightSample {
+    float ax, ay, az;      // g
+    float p, q, r;         // deg/s
+    float iasKt, paltFt;
+    float pitchDeg, rollDeg;
+};
+
+std::vector<FlightSample> MakeFlight()
+{
+    std::vector<FlightSample> out(kFlightLen);
+    uint32_t seed = 1;
+    auto noise = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    };
+    for (int k = 0; k < kFlightLen; ++k) {
+        const float t = static_cast<float>(k) / kImuRateHz;
+        FlightSample& s = out[k];
+        s.ax = 0.05f * std::sin(t) + 0.02f * noise();
+        s.ay = 0.02f * noise();
+        s.az = 1.0f + 0.2f * std::sin(0.5f * t) + 0.02f * noise();
+        s.p  = 10.0f * std::sin(0.7f * t) + 0.5f * noise();
+        s.q  = 3.0f * std::cos(0.5f * t) + 0.5f * noise();
+        s.r  = 5.0f * std::sin(0.3f * t) + 0.5f * noise();
+        s.iasKt    = 110.0f + 10.0f * std::sin(0.05f * t);
+        s.paltFt   = 4500.0f + 50.0f * std::sin(0.02f * t) + noise();
+        s.pitchDeg = 3.0f * std::sin(0.5f * t);
+        s.rollDeg  = 20.0f * std::sin(0.7f * t);
+    }
+    return out;
+}
+
+onspeed::AhrsInputs ToAhrsInputs(const FlightSample& s, uint32_t tUs)
+{
+    onspeed::AhrsInputs in;
+    in.imu.accelXG      = s.ax;
+    in.imu.accelYG      = s.ay;
+    in.imu.accelZG      = s.az;
+    in.imu.gyroRollDps  = s.p;
+    in.imu.gyroPitchDps = s.q;
+    in.imu.gyroYawDps   = s.r;
+    in.imu.tempCelsius  = 25.0f;
+    in.imu.timestampUs  = tUs;
+    in.sensors.iasKt       = s.iasKt;
+    in.sensors.paltFt      = s.paltFt;
+    in.sensors.oatCelsius  = 10.0f;
+    in.sensors.timestampUs = tUs;
+    in.iasUpdateTimestampUs = tUs;
+    return in;
+}
+
+onspeed::LogRow ToLogRow(const FlightSample& s, uint64_t tUs)
+{
+    onspeed::LogRow row;
+    row.timeStampMs     = static_cast<uint32_t>(tUs / 1000u);
+    row.timeStampUs     = tUs;
+    row.pfwdCounts      = 8200;
+    row.pfwdSmoothed    = 8200.5f;
+    row.p45Counts       = 1400;
+    row.p45Smoothed     = 1400.25f;
+    row.pStaticMbar     = 860.0f;
+    row.paltFt          = s.paltFt;
+    row.iasKt           = s.iasKt;
+    row.angleOfAttackDeg = 4.5f;
+    row.oatCelsius      = 10.0f;
+    row.tasKt           = s.iasKt * 1.07f;
+    row.imuTempCelsius  = 25.0f;
+    row.imuVerticalG    = s.az;
+    row.imuLateralG     = s.ay;
+    row.imuForwardG     = s.ax;
+    row.imuRollRateDps  = s.p;
+    row.imuPitchRateDps = s.q;
+    row.imuYawRateDps   = s.r;
+    row.pitchDeg        = s.pitchDeg;
+    row.rollDeg         = s.rollDeg;
+    return row;
+}
+
+// ---------------------------------------------------------------------------
+// EFIS wire streams. VN-300 and SkyView come from test_frames; the other
+// protocols use minimal valid frames built like test_efis_dispatcher's.
+// ---------------------------------------------------------------------------
+
+void PutField(std::string& buf, size_t pos, const char* s)
+{
+    buf.replace(pos, std::strlen(s), s);
+}
+
+void AppendAsciiChecksum(std::string& buf, size_t lastSummed)
+{
+    unsigned sum = 0;
+    for (size_t i = 0; i <= lastSummed; ++i) sum += static_cast<unsigned char>(buf[i]);
+    char hex[3];
+    std::snprintf(hex, sizeof(hex), "%02X", sum & 0xFFu);
+    PutField(buf, lastSummed + 1, hex);
+}
+
+std::vector<uint8_t> Bytes(const std::string& s)
+{
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+std::vector<uint8_t> D10Stream()
+{
+    std::string f(51, ' ');
+    PutField(f, 0, "12345678");
+    PutField(f, 8, "+020");     // pitch ×10
+    PutField(f, 12, "+0050");   // roll ×10
+    PutField(f, 20, "0500");    // IAS m/s ×10
+    PutField(f, 24, "01500");   // alt m
+    PutField(f, 29, "0000");    // vsi
+    PutField(f, 33, "000");     // lateral G ×100
+    PutField(f, 36, "010");     // vertical G ×10
+    PutField(f, 39, "00");      // percent lift
+    PutField(f, 46, "0");       // status
+    AppendAsciiChecksum(f, 48);
+    // Leading '\n' arms the parser's line-start detection.
+    return Bytes("\n" + f + "\r\n");
+}
+
+std::string GarminAttitudeFrame()
+{
+    std::string f(57, ' ');
+    PutField(f, 0, "=1112345678");
+    PutField(f, 11, "+020");
+    PutField(f, 15, "+0050");
+    PutField(f, 20, "270");
+    PutField(f, 23, "1200");
+    PutField(f, 27, "005500");
+    PutField(f, 37, "000");
+    PutField(f, 40, "010");
+    PutField(f, 43, "00");
+    PutField(f, 45, "0000");
+    PutField(f, 49, "+15");
+    AppendAsciiChecksum(f, 54);
+    return f + "\r\n";
+}
+
+std::vector<uint8_t> MglStream()
+{
+    std::vector<uint8_t> f(44, 0);
+    f[0] = 0x05; f[1] = 0x02;
+    f[2] = 24; f[3] = 0xFF ^ 24;   // length, length XOR
+    f[4] = 1;                      // primary message
+    f[5] = 5;
+    f[7] = 1;
+    const int32_t  palt = 5500;  std::memcpy(&f[8],  &palt, 4);
+    const uint16_t ias  = 2000;  std::memcpy(&f[16], &ias,  2);
+    return f;
+}
+
+std::vector<uint8_t> FramesStream(const onspeed::test_frames::Frame* frames, size_t n)
+{
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i < n; ++i) out.insert(out.end(), frames[i].bytes, frames[i].bytes + frames[i].len);
+    return out;
+}
+
+struct EfisCase {
+    const char*                 name;
+    onspeed::efis::EfisType     type;
+    std::vector<uint8_t>        stream;
+};
+
+// Feeds `stream` cyclically, one byte per op. Aborts the case when a full
+// pass yields no frame: the bench would otherwise time the resync path.
+void RunEfisCase(BenchRunner& runner, const EfisCase& c)
+{
+    {
+        onspeed::efis::EfisParser probe(c.type);
+        onspeed::EfisFrame frame;
+        int frames = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (uint8_t b : c.stream) {
+                probe.FeedByte(b);
+                if (probe.TryTakeFrame(frame)) ++frames;
+            }
+        }
+        if (frames == 0) {
+            std::fprintf(stderr, "bench_core: %s stream decodes no frames; skipped\n", c.name);
+            return;
+        }
+    }
+
+    onspeed::efis::EfisParser parser(c.type);
+    onspeed::EfisFrame frame;
+    const uint8_t* bytes = c.stream.data();
+    const size_t   len   = c.stream.size();
+    size_t i = 0;
+    runner.Run(c.name, [&] {
+        parser.FeedByte(bytes[i]);
+        DoNotOptimize(parser.TryTakeFrame(frame));
+        if (++i == len) i = 0;
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    BenchRunner runner(argc, argv);
+    const std::vector<FlightSample> flight = MakeFlight();
+
+    // --- Ahrs::Step -------------------------------------------------------
+    const struct { const char* name; onspeed::ahrs::Algorithm algo; } ahrsCases[] = {
+        {"ahrs_step/madgwick", onspeed::ahrs::Algorithm::Madgwick},
+        {"ahrs_step/ekfq",     onspeed::ahrs::Algorithm::Ekfq},
+    };
+    for (const auto& c : ahrsCases) {
+        onspeed::ahrs::AhrsConfig cfg;
+        cfg.algorithm = c.algo;
+        onspeed::ahrs::Ahrs ahrs(cfg);
+        ahrs.Init(ToAhrsInputs(flight[0], 0), flight[0].paltFt);
+        uint32_t k = 0;
+        runner.Run(c.name, [&] {
+            ++k;
+            const onspeed::AhrsInputs in = ToAhrsInputs(flight[k % kFlightLen], k * kImuPeriodUs);
+            DoNotOptimize(ahrs.Step(in, 1.0f / kImuRateHz));
+        });
+    }
+
+    // --- EKFQ × 8: scalar filters vs one EKFQBatch ------------------------
+    {
+        constexpr int kLanes = onspeed::EKFQBatch::LANES;
+        constexpr float kG   = 9.80665f;
+        constexpr float kDt  = 1.0f / kImuRateHz;
+        std::vector<onspeed::EKFQ::Measurements> meas(kFlightLen);
+        for (int k = 0; k < kFlightLen; ++k) {
+            const FlightSample& s = flight[k];
+            onspeed::EKFQ::Measurements& m = meas[k];
+            m.ax = s.ax * kG;  m.ay = s.ay * kG;  m.az = -s.az * kG;
+            m.p  = -s.p * (3.14159265f / 180.0f);
+            m.q  = -s.q * (3.14159265f / 180.0f);
+            m.r  =  s.r * (3.14159265f / 180.0f);
+            m.baroAltMeters = s.paltFt * 0.3048f;
+            m.tasMps        = s.iasKt * 0.5144f;
+            m.tasDotMps2    = 0.0f;
+            m.updateBaro    = true;
+        }
+        // A sweep's lanes differ in tuning, not input.
+        onspeed::EKFQ scalar[kLanes];
+        auto batch = std::make_unique<onspeed::EKFQBatch>();
+        for (int l = 0; l < kLanes; ++l) {
+            onspeed::EKFQ::Config c = onspeed::EKFQ::Config::defaults();
+            c.q_quat *= 1.0f + 0.25f * static_cast<float>(l);
+            c.r_ax   *= 1.0f + 0.25f * static_cast<float>(l);
+            scalar[l].setConfig(c);
+            scalar[l].init(0.0f, 0.0f, meas[0].baroAltMeters);
+            batch->setLane(l, scalar[l]);
+        }
+        uint32_t k = 0;
+        runner.Run("ekfq_update/scalar_x8", [&] {
+            const onspeed::EKFQ::Measurements& m = meas[++k % kFlightLen];
+            for (onspeed::EKFQ& f : scalar) f.update(m, kDt);
+            DoNotOptimize(scalar[kLanes - 1].getState().q0);
+        });
+        onspeed::EKFQ::Measurements lanes[kLanes];
+        k = 0;
+        runner.Run("ekfq_update/batch_x8", [&] {
+            for (onspeed::EKFQ::Measurements& m : lanes) m = meas[++k % kFlightLen];
+            batch->update(lanes, kDt);
+            DoNotOptimize(batch->getState(kLanes - 1).q0);
+        });
+    }
+
+    // --- LogReplayEngine::step -------------------------------------------
+    {
+        const onspeed::config::OnSpeedConfig cfg;
+        onspeed::replay::LogReplayEngine engine(cfg, kImuRateHz, /*flapsRawAdcAvailable=*/true);
+        uint64_t k = 0;
+        runner.Run("log_replay_engine/step", [&] {
+            ++k;
+            onspeed::LogRow row = ToLogRow(flight[k % kFlightLen], k * kImuPeriodUs);
+            row.flapsRawAdcPresent = true;
+            row.flapsRawAdc = 1200;
+            DoNotOptimize(engine.step(row));
+        });
+    }
+
+    // --- FormatRow / ParseRowByIndex --------------------------------------
+    {
+        namespace log_csv = onspeed::proto::log_csv;
+        onspeed::LogRow row = ToLogRow(flight[100], 123456789);
+        row.efisEnabled = true;
+        row.efisIsVn300 = true;
+        row.vnYawDeg    = 271.5f;
+        row.vnPitchDeg  = 2.25f;
+        row.vnRollDeg   = -12.5f;
+        row.vnGnssLat   = 44.123456;
+        row.vnGnssLon   = -93.654321;
+
+        static char line[log_csv::kRowMaxBytes];
+        static char header[log_csv::kHeaderMaxBytes];
+        runner.Run("log_csv/format_row", [&] {
+            DoNotOptimize(log_csv::FormatRow(row, line, sizeof(line)));
+        });
+
+        const size_t headerLen = log_csv::WriteHeader(row, header, sizeof(header));
+        const size_t lineLen   = log_csv::FormatRow(row, line, sizeof(line));
+        log_csv::HeaderIndex idx;
+        if (headerLen > 0 && lineLen > 0 &&
+            log_csv::BuildHeaderIndex(std::string_view(header, headerLen), idx)) {
+            const std::string_view lineView(line, lineLen);
+            onspeed::LogRow parsed;
+            runner.Run("log_csv/parse_row_by_index", [&] {
+                DoNotOptimize(log_csv::ParseRowByIndex(lineView, idx, parsed));
+            });
+        } else {
+            std::fprintf(stderr, "bench_core: header index build failed; parse case skipped\n");
+        }
+    }
+
+    // --- EfisParser::FeedByte ---------------------------------------------
+    {
+        using onspeed::efis::EfisType;
+        namespace tf = onspeed::test_frames;
+        const std::string garmin = GarminAttitudeFrame();
+        const EfisCase efisCases[] = {
+            {"efis_feed_byte/vn300",         EfisType::Vn300,        FramesStream(&tf::Vn300Frame(), 1)},
+            {"efis_feed_byte/dynon_skyview", EfisType::DynonSkyview, FramesStream(tf::SkyviewFrames(), tf::kSkyviewFrameCount)},
+            {"efis_feed_byte/dynon_d10",     EfisType::DynonD10,     D10Stream()},
+            {"efis_feed_byte/garmin_g5",     EfisType::GarminG5,     Bytes(garmin)},
+            {"efis_feed_byte/garmin_g3x",    EfisType::GarminG3X,    Bytes(garmin)},
+            {"efis_feed_byte/mgl_binary",    EfisType::MglBinary,    MglStream()},
+        };
+        for (const EfisCase& c : efisCases) RunEfisCase(runner, c);
+    }
+
+    // --- BuildDisplayFrame -------------------------------------------------
+    {
+        onspeed::proto::DisplayBuildInputs in;
+        in.pitchDeg = 3.2f;
+        in.rollDeg = -15.4f;
+        in.iasKt = 92.3f;
+        in.paltFt = 4512.0f;
+        in.turnRateDps = 3.1f;
+        in.lateralG = 0.02f;
+        in.verticalGScaled10 = 11.0f;
+        in.percentLiftPct = 54.0f;
+        in.vsiFpm10 = -35;
+        in.oatC = 12;
+        in.flightPathDeg = -1.5f;
+        in.flapsDeg = 10;
+        in.tonesOnPctLift = 40;
+        in.onSpeedFastPctLift = 55;
+        in.onSpeedSlowPctLift = 62;
+        in.stallWarnPctLift = 80;
+        in.flapsMaxDeg = 40;
+        in.gOnsetRate = 0.3f;
+        in.pipPctLift = 50;
+        uint8_t out[128];
+        runner.Run("display/build_frame", [&] {
+            ++in.dataMark;
+            if (in.dataMark == 100) in.dataMark = 0;
+            DoNotOptimize(onspeed::proto::BuildDisplayFrame(in, out, sizeof(out)));
+        });
+    }
+
+    // --- BuildLiveDataBinFrame ---------------------------------------------
+    {
+        onspeed::proto::LiveDataFrame in;
+        in.aoaDeg = 6.5f;
+        in.pitchDeg = 2.0f;
+        in.rollDeg = -5.0f;
+        in.iasKt = 92.0f;
+        in.paltFt = 4500.0f;
+        in.verticalG = 1.1f;
+        in.percentLift = 54.0f;
+        in.decelRate = -0.3f;
+        in.derivedAoaDeg = 6.4f;
+        in.flapsMaxDeg = 40;
+        in.pipPctLift = 50;
+        uint8_t out[onspeed::proto::kLiveDataBinFrameSizeBytes];
+        runner.Run("live_data/build_bin_frame", [&] {
+            ++in.dataMark;
+            DoNotOptimize(onspeed::proto::BuildLiveDataBinFrame(in, out, sizeof(out)));
+        });
+    }
+
+    // --- ToneSynth::Synthesize / Oscillator / AudioMixer::Mix -------------
+    {
+        static int16_t mono[kAudioBlock];
+        static int16_t stereo[kAudioBlock * 2];
+        float phase = 0.0f;
+        runner.Run("tone_synth/synthesize_240", [&] {
+            phase = onspeed::audio::Synthesize(400.0f, 25000, kAudioRateHz, mono, kAudioBlock, phase);
+            DoNotOptimize(mono[0]);
+        });
+
+        onspeed::audio::Oscillator osc;
+        osc.SetFrequency(400.0f, kAudioRateHz);
+        runner.Run("oscillator/render_240", [&] {
+            osc.Render(mono, kAudioBlock);
+            DoNotOptimize(mono[0]);
+        });
+
+        onspeed::audio::Envelope env;
+        onspeed::audio::EnvelopeSpec spec;   // ~6 pps pulse, Audio.cpp-like shape
+        spec.delaySamples  = 16.0f;
+        spec.attackSamples = 32.0f;
+        spec.holdSamples   = 800.0f;
+        spec.decaySamples  = 160.0f;
+        spec.releaseSamples = 240.0f;
+        spec.gapSamples    = 300.0f;
+        env.NoteOn(spec);
+        onspeed::audio::MixerInputs mix;
+        mix.in         = mono;
+        mix.leftScale  = 0.8f;
+        mix.rightScale = 0.6f;
+        mix.envelope   = &env;
+        onspeed::audio::MixerState state;
+        runner.Run("audio_mixer/mix_240", [&] {
+            onspeed::audio::Mix(mix, stereo, kAudioBlock, state);
+            DoNotOptimize(stereo[0]);
+        });
+
+        onspeed::audio::MixerInputs live = mix;
+        live.oscillator = &osc;
+        runner.Run("audio_mixer/mix_oscillator_240", [&] {
+            onspeed::audio::Mix(live, stereo, kAudioBlock, state);
+            DoNotOptimize(stereo[0]);
+        });
+    }
+
+    return runner.Finish();
+}
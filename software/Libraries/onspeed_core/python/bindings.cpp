@@ -0,0 +1,793 @@
+// bindings.cpp — CPython extension (_onspeed_core) for onspeed_core.
+//
+// The Python tooling (tools/onspeed_py, ekfq_pipeline) used to reach the
+// C++ algorithms only by spawning host_main and parsing its text output
+// back.  For notebook work that round trip — one process per call, every
+// float printed and re-parsed — dominates the runtime.  This module links
+// the same onspeed_core sources in-process:
+//
+//   compute_percent_lift  aoa::ComputePercentLift; `aoa` may be a float or
+//                         any 1-D float32/float64 buffer (NumPy array).
+//   parse_config          V1/V2 config file -> dict, same keys as
+//                         `host_main parse_config`.
+//   replay_log            LogReplayEngine over an SD log, like
+//                         `host_main replay`.
+//   run_ahrs              Ahrs (Madgwick or EKFQ, EkfqConfigKv tuning)
+//                         over an SD log, like `host_main ahrs_tone
+//                         --input-format sdlog`.
+//
+// Bulk results come back as a Table: one C-contiguous float64 block that
+// exports the buffer protocol, so numpy.asarray(table) is a zero-copy
+// (rows, columns) view; table.columns names the columns.  Array inputs
+// are read in place through the buffer protocol as well.  The log loops
+// run with the GIL released.
+//
+// SD logs are read through tools/regression/LogRowSource.h, so the
+// mapped-file parse and the "<log>.rowcache" sidecar behave exactly as
+// in host_main.
+//
+// Build: python/build_python.sh (the counterpart of wasm/build_wasm.sh).
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ahrs/Ahrs.h>
+#include <ahrs/EkfqConfigKv.h>
+#include <aoa/PercentLift.h>
+#include <audio/ToneCalc.h>
+#include <config/ConfigV1Parse.h>
+#include <config/ConfigXmlParse.h>
+#include <config/OnSpeedConfig.h>
+#include <replay/LogReplayEngine.h>
+#include <replay/LogRowToAhrsInputs.h>
+#include <types/AhrsOutputs.h>
+#include <types/LogRow.h>
+
+#include "LogRowSource.h"
+
+using onspeed::config::OnSpeedConfig;
+
+namespace {
+
+// Same constants host_main's ahrs_tone uses, so run_ahrs matches it row
+// for row.
+constexpr onspeed::ToneThresholds kCleanThresholds {
+    /* fLDMAXAOA      */ 3.0f,
+    /* fONSPEEDFASTAOA*/ 6.5f,
+    /* fONSPEEDSLOWAOA*/ 9.5f,
+    /* fSTALLWARNAOA  */ 12.5f,
+};
+
+constexpr float kImuRateHz      = 208.0f;
+constexpr float kPressureRateHz = 50.0f;
+
+// float -> double through the float's shortest decimal form, so a
+// logged 73.1 reads back as 73.1 rather than 73.0999984741211 — the
+// value host_main's text output parses back to.
+double Widen(float f)
+{
+    double d = f;
+    if (!std::isfinite(f)) return d;
+    char buf[32];
+    const auto res = std::to_chars(buf, buf + sizeof buf, f);
+    if (res.ec == std::errc()) std::from_chars(buf, res.ptr, d);
+    return d;
+}
+
+const char* const kReplayColumns[] = {
+    "timestamp_ms",
+    "ias_kt", "palt_ft", "ias_valid",
+    "aoa_deg", "coeff_p",
+    "flaps_pos", "flaps_index", "flaps_raw_adc", "flaps_raw_adc_present",
+    "pitch_deg", "roll_deg", "flight_path_deg", "vsi_mps",
+    "imu_fwd_g", "imu_lat_g", "imu_vert_g",
+    "imu_roll_dps", "imu_pitch_dps", "imu_yaw_dps",
+    "accel_lat_smoothed", "accel_vert_smoothed", "accel_fwd_smoothed",
+    "data_mark",
+};
+constexpr int kReplayColumnCount = sizeof(kReplayColumns) / sizeof(kReplayColumns[0]);
+
+const char* const kAhrsColumns[] = {
+    "ias_kt", "palt_ft", "oat_c",
+    "pitch_deg", "roll_deg", "flight_path_deg", "derived_aoa_deg",
+    "tas_mps", "alt_ft", "vsi_fpm", "earth_vert_g",
+    "tone_freq_hz", "tone_level",
+};
+constexpr int kAhrsColumnCount = sizeof(kAhrsColumns) / sizeof(kAhrsColumns[0]);
+
+// ============================================================================
+// Table — owned float64 block exported through the buffer protocol
+// ============================================================================
+
+struct TableObject {
+    PyObject_HEAD
+    std::vector<double>* data;
+    int                  ndim;
+    Py_ssize_t           shape[2];
+    Py_ssize_t           strides[2];
+    PyObject*            columns;     // tuple of str, or None for 1-D
+};
+
+PyTypeObject* g_TableType = nullptr;
+
+void TableDealloc(PyObject* self)
+{
+    TableObject* t = reinterpret_cast<TableObject*>(self);
+    delete t->data;
+    Py_XDECREF(t->columns);
+    PyTypeObject* tp = Py_TYPE(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+int TableGetBuffer(PyObject* self, Py_buffer* view, int /*flags*/)
+{
+    TableObject* t = reinterpret_cast<TableObject*>(self);
+    view->buf        = t->data->data();
+    view->obj        = Py_NewRef(self);
+    view->len        = static_cast<Py_ssize_t>(t->data->size() * sizeof(double));
+    view->readonly   = 0;
+    view->itemsize   = sizeof(double);
+    view->format     = const_cast<char*>("d");
+    view->ndim       = t->ndim;
+    view->shape      = t->shape;
+    view->strides    = t->strides;
+    view->suboffsets = nullptr;
+    view->internal   = nullptr;
+    return 0;
+}
+
+Py_ssize_t TableLength(PyObject* self)
+{
+    return reinterpret_cast<TableObject*>(self)->shape[0];
+}
+
+PyObject* TableColumns(PyObject* self, void*)
+{
+    return Py_NewRef(reinterpret_cast<TableObject*>(self)->columns);
+}
+
+PyGetSetDef g_TableGetSet[] = {
+    {"columns", TableColumns, nullptr,
+     "Column names (tuple of str), or None for a 1-D table.", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr},
+};
+
+PyType_Slot g_TableSlots[] = {
+    {Py_tp_dealloc,       reinterpret_cast<void*>(TableDealloc)},
+    {Py_tp_getset,        g_TableGetSet},
+    {Py_bf_getbuffer,     reinterpret_cast<void*>(TableGetBuffer)},
+    {Py_sq_length,        reinterpret_cast<void*>(TableLength)},
+    {Py_tp_doc,           const_cast<char*>(
+        "Float64 result block. numpy.asarray(t) is a zero-copy view of "
+        "shape (rows, len(t.columns)).")},
+    {0, nullptr},
+};
+
+PyType_Spec g_TableSpec = {
+    "_onspeed_core.Table",
+    sizeof(TableObject),
+    0,
+    Py_TPFLAGS_DEFAULT,
+    g_TableSlots,
+};
+
+// Takes ownership of `data`.  `names` (may be empty for 1-D) become the
+// columns tuple; cols == names.size() for 2-D tables.
+PyObject* NewTable(std::vector<double>* data, Py_ssize_t rows,
+                   const std::vector<std::string>& names, bool oneDim)
+{
+    TableObject* t = PyObject_New(TableObject, g_TableType);
+    if (t == nullptr) {
+        delete data;
+        return nullptr;
+    }
+    t->data    = data;
+    t->columns = nullptr;
+    if (oneDim) {
+        t->ndim       = 1;
+        t->shape[0]   = rows;
+        t->shape[1]   = 0;
+        t->strides[0] = sizeof(double);
+        t->strides[1] = 0;
+        t->columns    = Py_NewRef(Py_None);
+        return reinterpret_cast<PyObject*>(t);
+    }
+
+    const Py_ssize_t cols = static_cast<Py_ssize_t>(names.size());
+    t->ndim       = 2;
+    t->shape[0]   = rows;
+    t->shape[1]   = cols;
+    t->strides[0] = cols * static_cast<Py_ssize_t>(sizeof(double));
+    t->strides[1] = sizeof(double);
+    t->columns    = PyTuple_New(cols);
+    if (t->columns == nullptr) {
+        Py_DECREF(t);
+        return nullptr;
+    }
+    for (Py_ssize_t c = 0; c < cols; ++c) {
+        PyObject* s = PyUnicode_FromString(names[static_cast<size_t>(c)].c_str());
+        if (s == nullptr) {
+            Py_DECREF(t);
+            return nullptr;
+        }
+        PyTuple_SET_ITEM(t->columns, c, s);
+    }
+    return reinterpret_cast<PyObject*>(t);
+}
+
+// ============================================================================
+// Shared helpers
+// ============================================================================
+
+// LoadConfig from host_main, reporting through `err` instead of stderr.
+// Returns 0 on success, or the Python exception type to raise.
+PyObject* LoadConfigFile(const char* path, OnSpeedConfig& cfg, std::string& err)
+{
+    std::ifstream f(path);
+    if (!f.is_open()) {
+        err = std::string("cannot open config '") + path + "'";
+        return PyExc_OSError;
+    }
+    const std::string xml{std::istreambuf_iterator<char>(f),
+                          std::istreambuf_iterator<char>()};
+
+    cfg.LoadDefaults();
+    if (onspeed::config::IsV1Format(xml)) {
+        const auto st = onspeed::config::ParseV1(xml, cfg);
+        if (st != onspeed::config::V1ParseStatus::Ok) {
+            err = std::string("V1 parse error: ") + onspeed::config::V1ParseStatusToString(st);
+            return PyExc_ValueError;
+        }
+    } else {
+        const auto st = onspeed::config::ParseXml(xml, cfg);
+        if (st != onspeed::config::XmlParseStatus::Ok) {
+            err = std::string("V2 parse error: ") + onspeed::config::XmlParseStatusToString(st);
+            return PyExc_ValueError;
+        }
+    }
+    return nullptr;
+}
+
+void HeaderWarning(const char* col)
+{
+    std::fprintf(stderr, "_onspeed_core: header missing column '%s'\n", col);
+}
+
+// Open an SD log; sets a Python exception and returns false on failure.
+bool OpenLog(LogRowSource& src, const char* path, bool rowCache)
+{
+    switch (src.Open(path, rowCache, "_onspeed_core", HeaderWarning)) {
+    case LogRowSource::OpenStatus::Ok:
+        return true;
+    case LogRowSource::OpenStatus::CannotOpen:
+        PyErr_Format(PyExc_OSError, "cannot open log '%s'", path);
+        return false;
+    case LogRowSource::OpenStatus::Empty:
+        PyErr_Format(PyExc_ValueError, "log '%s' is empty (no header line)", path);
+        return false;
+    case LogRowSource::OpenStatus::BadHeader:
+        PyErr_Format(PyExc_ValueError,
+            "log '%s': header index build failed "
+            "(too many columns or no recognized OnSpeed columns)", path);
+        return false;
+    }
+    return false;
+}
+
+void PrepareRow(const LogRowSource& src, onspeed::LogRow& row)
+{
+    const onspeed::proto::log_csv::HeaderIndex& idx = src.Index();
+    row.flapsRawAdcPresent = (idx.idxFlapsRawAdc >= 0);
+    row.boomEnabled        = idx.boomEnabled;
+    row.efisEnabled        = idx.efisEnabled;
+    row.efisIsVn300        = idx.efisIsVn300;
+}
+
+// Split a CSV line into views (same rule as host_main's passthrough).
+void SplitCsv(std::string_view line, std::vector<std::string_view>& toks)
+{
+    toks.clear();
+    size_t p = 0;
+    while (p <= line.size()) {
+        const size_t c = line.find(',', p);
+        toks.push_back(line.substr(
+            p, (c == std::string_view::npos) ? line.size() - p : c - p));
+        if (c == std::string_view::npos) break;
+        p = c + 1;
+    }
+}
+
+// Parse one CSV cell; NaN when empty or not a number.
+double CellToDouble(std::string_view cell)
+{
+    if (cell.empty()) return NAN;
+    const std::string s(cell);
+    char* end = nullptr;
+    const double v = std::strtod(s.c_str(), &end);
+    return (end == s.c_str()) ? NAN : v;
+}
+
+// ============================================================================
+// compute_percent_lift
+// ============================================================================
+
+// Accept a C-contiguous 0-D or 1-D float64/float32 buffer (NumPy arrays
+// and scalars).  Sets an exception and returns false for anything else.
+bool GetFloatBuffer(PyObject* obj, Py_buffer& view, bool& isDouble)
+{
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) return false;
+    const char* fmt = view.format ? view.format : "B";
+    if (*fmt == '@' || *fmt == '=') ++fmt;
+    if (view.ndim > 1 || (std::strcmp(fmt, "d") != 0 && std::strcmp(fmt, "f") != 0)) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(PyExc_TypeError,
+            "aoa must be a float or a 1-D float64/float32 array");
+        return false;
+    }
+    isDouble = (*fmt == 'd');
+    return true;
+}
+
+PyObject* PyComputePercentLift(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* kw[] = {"aoa", "alpha_0", "alpha_stall", "stallwarn", "ias_valid", nullptr};
+    PyObject* aoaObj = nullptr;
+    float alpha0 = 0.0f, alphaStall = 0.0f, stallWarn = 0.0f;
+    int   iasValid = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Offf|p", const_cast<char**>(kw),
+                                     &aoaObj, &alpha0, &alphaStall, &stallWarn, &iasValid)) {
+        return nullptr;
+    }
+
+    OnSpeedConfig::SuFlaps flap;
+    flap.fAlpha0       = alpha0;
+    flap.fAlphaStall   = alphaStall;
+    flap.fSTALLWARNAOA = stallWarn;
+
+    if (PyFloat_Check(aoaObj) || !PyObject_CheckBuffer(aoaObj)) {
+        const double aoa = PyFloat_AsDouble(aoaObj);
+        if (aoa == -1.0 && PyErr_Occurred()) return nullptr;
+        return PyFloat_FromDouble(onspeed::aoa::ComputePercentLift(
+            static_cast<float>(aoa), flap, iasValid != 0));
+    }
+
+    Py_buffer view;
+    bool      isDouble = false;
+    if (!GetFloatBuffer(aoaObj, view, isDouble)) return nullptr;
+    if (view.ndim == 0) {
+        const float aoa = isDouble ? static_cast<float>(*static_cast<const double*>(view.buf))
+                                   : *static_cast<const float*>(view.buf);
+        PyBuffer_Release(&view);
+        return PyFloat_FromDouble(onspeed::aoa::ComputePercentLift(aoa, flap, iasValid != 0));
+    }
+    const Py_ssize_t n = view.shape[0];
+    auto* out = new std::vector<double>(static_cast<size_t>(n));
+    for (Py_ssize_t i = 0; i < n; ++i) {
+        const float aoa = isDouble ? static_cast<float>(static_cast<const double*>(view.buf)[i])
+                                   : static_cast<const float*>(view.buf)[i];
+        (*out)[static_cast<size_t>(i)] = onspeed::aoa::ComputePercentLift(aoa, flap, iasValid != 0);
+    }
+    PyBuffer_Release(&view);
+    return NewTable(out, n, {}, /*oneDim=*/true);
+}
+
+// ============================================================================
+// parse_config
+// ============================================================================
+
+// Set d[key] = value and drop the value reference.  False on error.
+bool SetItem(PyObject* d, const char* key, PyObject* value)
+{
+    if (value == nullptr) return false;
+    const int rc = PyDict_SetItemString(d, key, value);
+    Py_DECREF(value);
+    return rc == 0;
+}
+
+PyObject* PyParseConfig(PyObject*, PyObject* args)
+{
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path)) return nullptr;
+
+    OnSpeedConfig cfg;
+    std::string   err;
+    if (PyObject* exc = LoadConfigFile(path, cfg, err)) {
+        PyErr_SetString(exc, err.c_str());
+        return nullptr;
+    }
+
+    PyObject* d = PyDict_New();
+    if (d == nullptr) return nullptr;
+    const bool ok =
+        SetItem(d, "aoaSmoothing",      PyLong_FromLong(cfg.iAoaSmoothing)) &&
+        SetItem(d, "pressureSmoothing", PyLong_FromLong(cfg.iPressureSmoothing)) &&
+        SetItem(d, "muteUnderIas",      PyLong_FromLong(cfg.iMuteAudioUnderIAS)) &&
+        SetItem(d, "dataSource",        PyUnicode_FromString(cfg.suDataSrc.toCStr())) &&
+        SetItem(d, "volumeControl",     PyBool_FromLong(cfg.bVolumeControl)) &&
+        SetItem(d, "defaultVolume",     PyLong_FromLong(cfg.iDefaultVolume)) &&
+        SetItem(d, "audio3D",           PyBool_FromLong(cfg.bAudio3D)) &&
+        SetItem(d, "overGWarning",      PyBool_FromLong(cfg.bOverGWarning)) &&
+        SetItem(d, "efisType",          PyUnicode_FromString(cfg.sEfisType.c_str())) &&
+        SetItem(d, "serialOutFormat",   PyUnicode_FromString(cfg.sSerialOutFormat.c_str())) &&
+        SetItem(d, "pitchBias",         PyFloat_FromDouble(cfg.fPitchBias)) &&
+        SetItem(d, "rollBias",          PyFloat_FromDouble(cfg.fRollBias)) &&
+        SetItem(d, "gxBias",            PyFloat_FromDouble(cfg.fGxBias)) &&
+        SetItem(d, "gyBias",            PyFloat_FromDouble(cfg.fGyBias)) &&
+        SetItem(d, "gzBias",            PyFloat_FromDouble(cfg.fGzBias)) &&
+        SetItem(d, "pstaticBias",       PyFloat_FromDouble(cfg.fPStaticBias)) &&
+        SetItem(d, "loadLimitPositive", PyFloat_FromDouble(cfg.fLoadLimitPositive)) &&
+        SetItem(d, "loadLimitNegative", PyFloat_FromDouble(cfg.fLoadLimitNegative)) &&
+        SetItem(d, "iAhrsAlgorithm",    PyLong_FromLong(cfg.iAhrsAlgorithm)) &&
+        SetItem(d, "sdLogging",         PyBool_FromLong(cfg.bSdLogging)) &&
+        SetItem(d, "boomConvertData",   PyBool_FromLong(cfg.bBoomConvertData)) &&
+        SetItem(d, "logRate",           PyLong_FromLong(cfg.iLogRate)) &&
+        SetItem(d, "vno",               PyLong_FromLong(cfg.iVno));
+    if (!ok) {
+        Py_DECREF(d);
+        return nullptr;
+    }
+
+    // flapsByDeg keyed by integer degrees (host_main's JSON keys are the
+    // same numbers as strings).
+    PyObject* flaps = PyDict_New();
+    if (flaps == nullptr || PyDict_SetItemString(d, "flapsByDeg", flaps) != 0) {
+        Py_XDECREF(flaps);
+        Py_DECREF(d);
+        return nullptr;
+    }
+    Py_DECREF(flaps);
+    for (const auto& f : cfg.aFlaps) {
+        PyObject* fd = PyDict_New();
+        if (fd == nullptr) {
+            Py_DECREF(d);
+            return nullptr;
+        }
+        const bool fok =
+            SetItem(fd, "degrees",        PyLong_FromLong(f.iDegrees)) &&
+            SetItem(fd, "potPosition",    PyLong_FromLong(f.iPotPosition)) &&
+            SetItem(fd, "ldmaxAoa",       PyFloat_FromDouble(f.fLDMAXAOA)) &&
+            SetItem(fd, "onSpeedFastAoa", PyFloat_FromDouble(f.fONSPEEDFASTAOA)) &&
+            SetItem(fd, "onSpeedSlowAoa", PyFloat_FromDouble(f.fONSPEEDSLOWAOA)) &&
+            SetItem(fd, "stallWarnAoa",   PyFloat_FromDouble(f.fSTALLWARNAOA)) &&
+            SetItem(fd, "stallAoa",       PyFloat_FromDouble(f.fSTALLAOA)) &&
+            SetItem(fd, "alpha0",         PyFloat_FromDouble(f.fAlpha0)) &&
+            SetItem(fd, "alphaStall",     PyFloat_FromDouble(f.fAlphaStall)) &&
+            SetItem(fd, "kFit",           PyFloat_FromDouble(f.fKFit));
+        PyObject* key = fok ? PyLong_FromLong(f.iDegrees) : nullptr;
+        const bool stored = key != nullptr && PyDict_SetItem(flaps, key, fd) == 0;
+        Py_XDECREF(key);
+        Py_DECREF(fd);
+        if (!stored) {
+            Py_DECREF(d);
+            return nullptr;
+        }
+    }
+    return d;
+}
+
+// ============================================================================
+// replay_log
+// ============================================================================
+
+void AppendReplayRow(std::vector<double>& out, double timestampMs,
+                     const onspeed::replay::ReplayStepResult& r)
+{
+    const double row[kReplayColumnCount] = {
+        timestampMs,
+        Widen(r.iasKt), Widen(r.paltFt), r.iasValid ? 1.0 : 0.0,
+        Widen(r.aoa), Widen(r.coeffP),
+        static_cast<double>(r.flapsPos), static_cast<double>(r.flapsIndex),
+        static_cast<double>(r.flapsRawAdc), r.flapsRawAdcPresent ? 1.0 : 0.0,
+        Widen(r.pitchDeg), Widen(r.rollDeg), Widen(r.flightPathDeg), Widen(r.vsiMps),
+        Widen(r.imuForwardG), Widen(r.imuLateralG), Widen(r.imuVerticalG),
+        Widen(r.imuRollRateDps), Widen(r.imuPitchRateDps), Widen(r.imuYawRateDps),
+        Widen(r.accelLatSmoothed), Widen(r.accelVertSmoothed), Widen(r.accelFwdSmoothed),
+        static_cast<double>(r.dataMark),
+    };
+    out.insert(out.end(), row, row + kReplayColumnCount);
+}
+
+PyObject* PyReplayLog(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* kw[] = {"log_path", "config_path", "log_rate", "row_cache", nullptr};
+    const char* logPath = nullptr;
+    const char* cfgPath = nullptr;
+    int         logRate = 50;
+    int         rowCache = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|zip", const_cast<char**>(kw),
+                                     &logPath, &cfgPath, &logRate, &rowCache)) {
+        return nullptr;
+    }
+    if (logRate != 50 && logRate != 208) {
+        PyErr_Format(PyExc_ValueError, "log_rate must be 50 or 208 (got %d)", logRate);
+        return nullptr;
+    }
+
+    OnSpeedConfig cfg;
+    if (cfgPath != nullptr) {
+        std::string err;
+        if (PyObject* exc = LoadConfigFile(cfgPath, cfg, err)) {
+            PyErr_SetString(exc, err.c_str());
+            return nullptr;
+        }
+    } else {
+        cfg.LoadDefaults();
+    }
+
+    LogRowSource src;
+    if (!OpenLog(src, logPath, rowCache != 0)) return nullptr;
+
+    auto*  out      = new std::vector<double>();
+    size_t badRow   = 0;
+    bool   parseOk  = true;
+    Py_BEGIN_ALLOW_THREADS
+    const size_t n = src.RowCount();
+    out->reserve(n * kReplayColumnCount);
+
+    onspeed::replay::LogReplayEngine engine(cfg, logRate, src.Index().idxFlapsRawAdc >= 0);
+
+    // The synth path emits rows in input order, lagged; every input row
+    // comes out exactly once after flush(), so output k is input row k.
+    std::vector<double> stampsMs;
+    stampsMs.reserve(n);
+    size_t emitted = 0;
+    onspeed::LogRow row;
+    PrepareRow(src, row);
+    for (size_t li = 0; li < n; ++li) {
+        if (!src.Read(li, row)) {
+            parseOk = false;
+            badRow  = li;
+            break;
+        }
+        stampsMs.push_back(static_cast<double>(row.timeStampMs));
+        if (const auto r = engine.step(row)) {
+            AppendReplayRow(*out, stampsMs[emitted++], *r);
+        }
+    }
+    if (parseOk) {
+        for (const auto& r : engine.flush()) {
+            AppendReplayRow(*out, emitted < stampsMs.size() ? stampsMs[emitted] : NAN, r);
+            ++emitted;
+        }
+        src.Finish();
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!parseOk) {
+        delete out;
+        PyErr_Format(PyExc_ValueError, "log '%s': parse error at row %zu", logPath, badRow);
+        return nullptr;
+    }
+    const Py_ssize_t rows = static_cast<Py_ssize_t>(out->size() / kReplayColumnCount);
+    return NewTable(out, rows,
+                    std::vector<std::string>(kReplayColumns, kReplayColumns + kReplayColumnCount),
+                    /*oneDim=*/false);
+}
+
+// ============================================================================
+// run_ahrs
+// ============================================================================
+
+PyObject* PyRunAhrs(PyObject*, PyObject* args, PyObject* kwargs)
+{
+    static const char* kw[] = {"log_path", "config_path", "algorithm", "ekfq_config",
+                               "passthrough", "row_cache", nullptr};
+    const char* logPath   = nullptr;
+    const char* cfgPath   = nullptr;
+    const char* algoName  = "madgwick";
+    const char* kvText    = nullptr;
+    PyObject*   passObj   = nullptr;
+    int         rowCache  = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ss|szOp", const_cast<char**>(kw),
+                                     &logPath, &cfgPath, &algoName, &kvText,
+                                     &passObj, &rowCache)) {
+        return nullptr;
+    }
+
+    onspeed::ahrs::Algorithm algo;
+    if (std::strcmp(algoName, "madgwick") == 0) {
+        algo = onspeed::ahrs::Algorithm::Madgwick;
+    } else if (std::strcmp(algoName, "ekfq") == 0) {
+        algo = onspeed::ahrs::Algorithm::Ekfq;
+    } else {
+        PyErr_Format(PyExc_ValueError, "unknown algorithm '%s' (madgwick|ekfq)", algoName);
+        return nullptr;
+    }
+
+    std::vector<std::string> passthrough;
+    if (passObj != nullptr && passObj != Py_None) {
+        PyObject* seq = PySequence_Fast(passObj, "passthrough must be a sequence of str");
+        if (seq == nullptr) return nullptr;
+        for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); ++i) {
+            const char* s = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(seq, i));
+            if (s == nullptr) {
+                Py_DECREF(seq);
+                return nullptr;
+            }
+            passthrough.emplace_back(s);
+        }
+        Py_DECREF(seq);
+    }
+
+    OnSpeedConfig pilotCfg;
+    {
+        std::string err;
+        if (PyObject* exc = LoadConfigFile(cfgPath, pilotCfg, err)) {
+            PyErr_SetString(exc, err.c_str());
+            return nullptr;
+        }
+    }
+
+    onspeed::EKFQ::Config                       ekfqCfg = onspeed::EKFQ::Config::defaults();
+    onspeed::ahrs::EkfqPipeline::PipelineConfig pipeCfg =
+        onspeed::ahrs::EkfqPipeline::PipelineConfig::defaults();
+    if (kvText != nullptr) {
+        // Missing-key warnings only follow a successful parse, so on
+        // failure the last message is the error.
+        std::string err;
+        auto sink = [&err](const char* m) { err = m; };
+        if (!onspeed::ahrs::ParseEkfqConfigKv(kvText, ekfqCfg, pipeCfg, sink)) {
+            PyErr_Format(PyExc_ValueError, "ekfq_config: %s", err.c_str());
+            return nullptr;
+        }
+    }
+
+    LogRowSource src;
+    if (!OpenLog(src, logPath, rowCache != 0)) return nullptr;
+
+    // Resolve passthrough columns by name in the raw header.
+    std::vector<int> passIdx(passthrough.size(), -1);
+    if (!passthrough.empty()) {
+        std::vector<std::string_view> header;
+        SplitCsv(src.HeaderLine(), header);
+        for (size_t i = 0; i < passthrough.size(); ++i) {
+            for (size_t j = 0; j < header.size(); ++j) {
+                if (header[j] == passthrough[i]) {
+                    passIdx[i] = static_cast<int>(j);
+                    break;
+                }
+            }
+            if (passIdx[i] < 0) {
+                PyErr_Format(PyExc_ValueError,
+                    "passthrough column '%s' not in log header", passthrough[i].c_str());
+                return nullptr;
+            }
+        }
+    }
+
+    const size_t cols    = kAhrsColumnCount + passthrough.size();
+    auto*        out     = new std::vector<double>();
+    size_t       badRow  = 0;
+    bool         parseOk = true;
+    Py_BEGIN_ALLOW_THREADS
+    out->reserve(src.RowCount() * cols);
+
+    onspeed::ahrs::AhrsConfig ahrsCfg;
+    ahrsCfg.pitchBiasDeg         = pilotCfg.fPitchBias;
+    ahrsCfg.rollBiasDeg          = pilotCfg.fRollBias;
+    ahrsCfg.algorithm            = algo;
+    ahrsCfg.gyroSmoothingWindow  = 30;
+    ahrsCfg.imuSampleRateHz      = kImuRateHz;
+    ahrsCfg.pressureSampleRateHz = kPressureRateHz;
+    onspeed::ahrs::Ahrs ahrs(ahrsCfg);
+    ahrs.SetEkfqConfig(ekfqCfg, pipeCfg);
+
+    onspeed::replay::LogRowToAhrsInputs bridge;
+    onspeed::LogRow                     row;
+    PrepareRow(src, row);
+    std::vector<std::string_view> toks;
+    for (size_t li = 0; li < src.RowCount(); ++li) {
+        if (!src.Read(li, row)) {
+            parseOk = false;
+            badRow  = li;
+            break;
+        }
+        const auto br = bridge.translate(row);
+        if (br.isSeedFrame) {
+            ahrs.Init(br.inputs, row.paltFt);
+            continue;
+        }
+
+        const onspeed::AhrsOutputs o = ahrs.Step(br.inputs, br.dtSec);
+        const onspeed::ToneResult  tone =
+            onspeed::calculateTone(o.derivedAoaDeg, kCleanThresholds);
+        const bool toneOn = tone.enTone != onspeed::EnToneType::None;
+        const double toneLevel = tone.enTone == onspeed::EnToneType::Low  ? 1.0
+                               : tone.enTone == onspeed::EnToneType::High ? 2.0 : 0.0;
+
+        const double vals[kAhrsColumnCount] = {
+            Widen(br.inputs.sensors.iasKt), Widen(br.inputs.sensors.paltFt),
+            Widen(br.inputs.sensors.oatCelsius),
+            Widen(o.pitchDeg), Widen(o.rollDeg), Widen(o.flightPathDeg), Widen(o.derivedAoaDeg),
+            Widen(o.tasMps), Widen(o.altFt), Widen(o.vsiFpm), Widen(o.earthVertG),
+            toneOn ? Widen(tone.fPulseFreq) : 0.0, toneLevel,
+        };
+        out->insert(out->end(), vals, vals + kAhrsColumnCount);
+
+        if (!passIdx.empty()) {
+            SplitCsv(src.Line(li), toks);
+            for (int idx : passIdx) {
+                out->push_back(idx < static_cast<int>(toks.size())
+                                   ? CellToDouble(toks[static_cast<size_t>(idx)]) : NAN);
+            }
+        }
+    }
+    if (parseOk) src.Finish();
+    Py_END_ALLOW_THREADS
+
+    if (!parseOk) {
+        delete out;
+        PyErr_Format(PyExc_ValueError, "log '%s': parse error at row %zu", logPath, badRow);
+        return nullptr;
+    }
+
+    std::vector<std::string> names(kAhrsColumns, kAhrsColumns + kAhrsColumnCount);
+    for (const std::string& p : passthrough) names.push_back("passthrough_" + p);
+    return NewTable(out, static_cast<Py_ssize_t>(out->size() / cols), names, /*oneDim=*/false);
+}
+
+// ============================================================================
+// Module
+// ============================================================================
+
+PyMethodDef g_Methods[] = {
+    {"compute_percent_lift", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(PyComputePercentLift)),
+     METH_VARARGS | METH_KEYWORDS,
+     "compute_percent_lift(aoa, alpha_0, alpha_stall, stallwarn, ias_valid=True)\n"
+     "Percent-of-stall lift in [0, 99.9]. `aoa` may be a float (returns float)\n"
+     "or a 1-D float64/float32 array (returns a 1-D Table)."},
+    {"parse_config", PyParseConfig, METH_VARARGS,
+     "parse_config(path) -> dict\n"
+     "Parse a V1 or V2 OnSpeed config; keys match `host_main parse_config`,\n"
+     "with flapsByDeg keyed by int degrees."},
+    {"replay_log", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(PyReplayLog)),
+     METH_VARARGS | METH_KEYWORDS,
+     "replay_log(log_path, config_path=None, log_rate=50, row_cache=False) -> Table\n"
+     "LogReplayEngine over an SD log; one row per input row, the\n"
+     "`host_main replay` columns preceded by timestamp_ms."},
+    {"run_ahrs", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(PyRunAhrs)),
+     METH_VARARGS | METH_KEYWORDS,
+     "run_ahrs(log_path, config_path, algorithm='madgwick', ekfq_config=None,\n"
+     "         passthrough=(), row_cache=False) -> Table\n"
+     "Ahrs over an SD log, like `host_main ahrs_tone --input-format sdlog`.\n"
+     "ekfq_config is EkfqConfigKv text; passthrough columns are parsed as\n"
+     "float (NaN when empty) and named passthrough_<col>."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef g_Module = {
+    PyModuleDef_HEAD_INIT,
+    "_onspeed_core",
+    "In-process bindings for onspeed_core (see python/bindings.cpp).",
+    -1,
+    g_Methods,
+    nullptr, nullptr, nullptr, nullptr,
+};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit__onspeed_core(void)
+{
+    PyObject* m = PyModule_Create(&g_Module);
+    if (m == nullptr) return nullptr;
+
+    g_TableType = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&g_TableSpec));
+    if (g_TableType == nullptr || PyModule_AddObjectRef(m, "Table",
+            reinterpret_cast<PyObject*>(g_TableType)) != 0) {
+        Py_DECREF(m);
+        return nullptr;
+    }
+    return m;
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env bash
+# build_python.sh — compile onspeed_core into the _onspeed_core CPython extension.
+#
+# Produces:
+#   dist/_onspeed_core<EXT_SUFFIX>   (e.g. _onspeed_core.cpython-311-x86_64-linux-gnu.so)
+#
+# Usage:
+#   bash software/Libraries/onspeed_core/python/build_python.sh [python3]
+#
+# Prerequisites:
+#   - a C++17 compiler (c++ / $CXX)
+#   - CPython >= 3.10 development headers for the interpreter that will
+#     import the module (the optional argument, default python3)
+#
+# No pybind11 / NumPy build dependency: bindings.cpp uses the CPython C
+# API and the buffer protocol directly.  tools/onspeed_py/_native.py
+# finds the module in dist/ (or via $ONSPEED_CORE_PY).
+#
+# Same source set as wasm/build_wasm.sh (all of onspeed_core + tinyxml2),
+# plus tools/regression for the host-only LogRowSource / MappedFile headers.
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_ROOT="$(cd "${SCRIPT_DIR}/../../../.." && pwd)"
+
+PYTHON="${1:-python3}"
+CXX="${CXX:-c++}"
+
+ONSPEED_CORE_DIR="${REPO_ROOT}/software/Libraries/onspeed_core/src"
+TINYXML2_DIR="${REPO_ROOT}/software/Libraries/tinyxml2"
+REGRESSION_DIR="${REPO_ROOT}/tools/regression"
+OUT_DIR="${SCRIPT_DIR}/dist"
+OBJ_DIR="${OUT_DIR}/obj"
+mkdir -p "${OBJ_DIR}"
+
+PY_INCLUDE="$("${PYTHON}" -c 'import sysconfig; print(sysconfig.get_paths()["include"])')"
+EXT_SUFFIX="$("${PYTHON}" -c 'import sysconfig; print(sysconfig.get_config_var("EXT_SUFFIX"))')"
+
+SOURCES=()
+while IFS= read -r -d '' f; do SOURCES+=("$f"); done < <(
+    find "${ONSPEED_CORE_DIR}" -name '*.cpp' -print0 | sort -z)
+SOURCES+=("${TINYXML2_DIR}/tinyxml2.cpp")
+SOURCES+=("${SCRIPT_DIR}/bindings.cpp")
+
+# -O2 -fPIC       — shared object; matches the host_main native build's optimisation.
+# -std=gnu++17    — matches the firmware build (platformio.ini build_src_flags).
+CXXFLAGS=(-O2 -fPIC -std=gnu++17
+          -I"${ONSPEED_CORE_DIR}" -I"${TINYXML2_DIR}" -I"${REGRESSION_DIR}"
+          -I"${PY_INCLUDE}")
+
+LDFLAGS=(-shared)
+if [[ "$(uname -s)" == "Darwin" ]]; then
+    # Resolve Python symbols from the importing interpreter.
+    LDFLAGS+=(-undefined dynamic_lookup)
+fi
+
+echo "[python] Compiling ${#SOURCES[@]} sources (onspeed_core + tinyxml2 + bindings)..."
+
+# One object per source, in parallel; each name is made unique by its
+# path relative to the repo root.
+JOBS="$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)"
+OBJECTS=()
+for src in "${SOURCES[@]}"; do
+    rel="${src#"${REPO_ROOT}/"}"
+    OBJECTS+=("${OBJ_DIR}/${rel//\//_}.o")
+done
+printf '%s\n' "${SOURCES[@]}" | xargs -P "${JOBS}" -I{} sh -c '
+    src="$1"; shift
+    rel="${src#'"${REPO_ROOT}"'/}"
+    obj="'"${OBJ_DIR}"'/$(printf "%s" "${rel}" | tr / _).o"
+    if [ ! -f "${obj}" ] || [ "${src}" -nt "${obj}" ]; then
+        exec "$@" -c "${src}" -o "${obj}"
+    fi
+' sh {} "${CXX}" "${CXXFLAGS[@]}"
+
+OUT="${OUT_DIR}/_onspeed_core${EXT_SUFFIX}"
+"${CXX}" "${LDFLAGS[@]}" "${OBJECTS[@]}" -o "${OUT}"
+
+echo ""
+echo "[python] Build complete."
+echo "  Output: ${OUT}"
@@ -216,7 +216,7 @@ void Ahrs::updateTas_(const AhrsInputs& in)
 
 // ----------------------------------------------------------------------------
 
-AhrsOutputs Ahrs::Step(const AhrsInputs& in, float dtSec)
+EkfqPipeline::Inputs Ahrs::SensorStage(const AhrsInputs& in, float dtSec)
 {
     // Use measured dt when available; fall back to the nominal sample
     // period when dt is invalid (NaN/inf/non-positive) or implausibly
@@ -228,10 +228,6 @@ AhrsOutputs Ahrs::Step(const AhrsInputs& in, float dtSec)
         dtSec = imuDeltaTime_;
     }
 
-    // ================================================================
-    // Stage 1 — Sensor.
-    // ================================================================
-
     // 1a. TAS update (density correction + EMA-smoothed derivative) at
     //     pressure-sensor cadence (~50 Hz).
     updateTas_(in);
@@ -259,6 +255,34 @@ AhrsOutputs Ahrs::Step(const AhrsInputs& in, float dtSec)
                       in.imu.accelYG * (sr * sp) +
                       in.imu.accelZG * (cr * sp);
 
+    return EkfqPipeline::Inputs{
+        /* accelFwdCorrG    */ accelFwdCorr_,
+        /* accelLatCorrG    */ accelLatCorr_,
+        /* accelVertCorrG   */ accelVertCorr_,
+        /* rollRateCorrDps  */ RollRateCorr,
+        /* pitchRateCorrDps */ PitchRateCorr,
+        /* yawRateCorrDps   */ YawRateCorr,
+        /* tasMps           */ tas_,
+        /* iasKt            */ in.sensors.iasKt,
+        /* baroAltMeters    */ onspeed::ft2m(in.sensors.paltFt),
+        /* dtSec            */ dtSec,
+    };
+}
+
+// ----------------------------------------------------------------------------
+
+AhrsOutputs Ahrs::Step(const AhrsInputs& in, float dtSec)
+{
+    // ================================================================
+    // Stage 1 — Sensor.
+    // ================================================================
+
+    const EkfqPipeline::Inputs sensed = SensorStage(in, dtSec);
+    const float RollRateCorr  = sensed.rollRateCorrDps;
+    const float PitchRateCorr = sensed.pitchRateCorrDps;
+    const float YawRateCorr   = sensed.yawRateCorrDps;
+    dtSec = sensed.dtSec;
+
     // ================================================================
     // Stage 2 — AHRS algorithm.
     //
@@ -284,19 +308,7 @@ AhrsOutputs Ahrs::Step(const AhrsInputs& in, float dtSec)
         // match the Python pipeline's signal chain (Optuna tuned
         // against that EMA, not the sensor-stage `tasDotSmoothed_`
         // which runs at pressure cadence with α=kIasSmoothing).
-        const EkfqPipeline::Inputs ekfqIn = {
-            /* accelFwdCorrG    */ accelFwdCorr_,
-            /* accelLatCorrG    */ accelLatCorr_,
-            /* accelVertCorrG   */ accelVertCorr_,
-            /* rollRateCorrDps  */ RollRateCorr,
-            /* pitchRateCorrDps */ PitchRateCorr,
-            /* yawRateCorrDps   */ YawRateCorr,
-            /* tasMps           */ tas_,
-            /* iasKt            */ in.sensors.iasKt,
-            /* baroAltMeters    */ onspeed::ft2m(in.sensors.paltFt),
-            /* dtSec            */ dtSec,
-        };
-        const EkfqPipeline::Outputs ekfqOut = ekfq_.Step(ekfqIn);
+        const EkfqPipeline::Outputs ekfqOut = ekfq_.Step(sensed);
         SmoothedPitch          = ekfqOut.pitchDeg;
         SmoothedRoll           = ekfqOut.rollDeg;
         DerivedAOA             = ekfqOut.derivedAoaDeg;
@@ -111,6 +111,13 @@ public:
     // Step (typically 1/208 s).  Returns the latest AhrsOutputs snapshot.
     AhrsOutputs Step(const AhrsInputs& in, float dtSec);
 
+    // Stage 1 of Step() on its own: sanitise dt, update TAS, apply the
+    // installation bias. Returns the frame Step() hands the EKFQ
+    // pipeline. The result does not depend on the EKFQ tuning, so a
+    // tuning sweep runs this once per frame and fans it out to
+    // EkfqPipelineBatch lanes.
+    EkfqPipeline::Inputs SensorStage(const AhrsInputs& in, float dtSec);
+
     // ---- Sensor-stage accessors (raw-corrected, pre-smoothing) ----
 
     // Latest installation-corrected (unsmoothed) accel components, in g.
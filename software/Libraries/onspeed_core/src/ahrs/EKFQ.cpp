@@ -21,6 +21,11 @@
 //     — a sequential approximation would not be numerically identical
 //     and would not honour the tuning's intent.
 //
+//   • Covariance: P is symmetric and stored as its packed upper triangle
+//     (66 floats). Predict and the Joseph update compute only i ≤ j. The
+//     correct-step matrix algebra uses the constant-size kernels in
+//     FixedMatrix.h, which the compiler unrolls completely.
+//
 //   • All memory is stack — no heap, no allocators, no exceptions.
 
 #include "EKFQ.h"
@@ -58,6 +63,7 @@ EKFQ::Config EKFQ::Config::defaults() {
     c.p_b_az       = 1.0f;
     c.p_beta       = 0.01f;
     c.tas_min_mps  = 12.0f;
+    c.sequential_update = false;
     return c;
 }
 
@@ -118,18 +124,18 @@ void EKFQ::init(float initial_phi, float initial_theta, float initial_z) {
     eulerToQuat(initial_phi, initial_theta, 0.0f, q);
     x_[Q0] = q[0]; x_[Q1] = q[1]; x_[Q2] = q[2]; x_[Q3] = q[3];
     x_[Z] = initial_z;
-    std::memset(P_, 0, sizeof(P_));
-    P_[Q0][Q0] = config_.p_quat;
-    P_[Q1][Q1] = config_.p_quat;
-    P_[Q2][Q2] = config_.p_quat;
-    P_[Q3][Q3] = config_.p_quat;
-    P_[BP_IDX][BP_IDX] = config_.p_bias;
-    P_[BQ_IDX][BQ_IDX] = config_.p_bias;
-    P_[BR_IDX][BR_IDX] = config_.p_bias;
-    P_[Z][Z]   = config_.p_z;
-    P_[VZ][VZ] = config_.p_vz;
-    P_[B_AZ][B_AZ] = config_.p_b_az;
-    P_[BETA][BETA] = config_.p_beta;
+    P_.setZero();
+    P_.at(Q0, Q0) = config_.p_quat;
+    P_.at(Q1, Q1) = config_.p_quat;
+    P_.at(Q2, Q2) = config_.p_quat;
+    P_.at(Q3, Q3) = config_.p_quat;
+    P_.at(BP_IDX, BP_IDX) = config_.p_bias;
+    P_.at(BQ_IDX, BQ_IDX) = config_.p_bias;
+    P_.at(BR_IDX, BR_IDX) = config_.p_bias;
+    P_.at(Z, Z)   = config_.p_z;
+    P_.at(VZ, VZ) = config_.p_vz;
+    P_.at(B_AZ, B_AZ) = config_.p_b_az;
+    P_.at(BETA, BETA) = config_.p_beta;
     initialized_ = true;
 }
 
@@ -141,13 +147,13 @@ void EKFQ::resetVerticalCovariance(float baro_z) {
     for (int n = 0; n < 3; ++n) {
         const int idx = kIdx[n];
         for (int i = 0; i < N_STATES; ++i) {
-            P_[idx][i] = 0.0f;
-            P_[i][idx] = 0.0f;
+            if (i <= idx) P_.at(i, idx) = 0.0f;
+            else          P_.at(idx, i) = 0.0f;
         }
     }
-    P_[Z][Z]      = config_.p_z;
-    P_[VZ][VZ]    = config_.p_vz;
-    P_[B_AZ][B_AZ] = config_.p_b_az;
+    P_.at(Z, Z)       = config_.p_z;
+    P_.at(VZ, VZ)     = config_.p_vz;
+    P_.at(B_AZ, B_AZ) = config_.p_b_az;
     x_[Z] = baro_z;
 }
 
@@ -161,9 +167,8 @@ void EKFQ::renormaliseQuaternion() {
     }
 }
 
-// (No file-scope helpers needed — correct() does a pure batch update
-// with Cholesky-based joint Kalman gain, mirroring Python exactly.
-// See the Correct step below for the algebra and Cholesky implementation.)
+// (No file-scope helpers needed — the matrix kernels live in
+// FixedMatrix.h. See the Correct step below for the algebra.)
 
 // ---------------------------------------------------------------------------
 // update = predict + correct
@@ -311,158 +316,104 @@ void EKFQ::predict(float p, float q_in, float r_in,
         beta_br_dt = dt;
     }
 
-    // 6) Compute M = F · P column-by-column into buffers, only for rows
-    //    where F deviates from identity. Identity rows of F (BP_IDX, BQ_IDX, BR_IDX,
-    //    B_AZ, and possibly BETA) trivially give M[i][j] = P[i][j].
-
-    float M_Q0[N_STATES], M_Q1[N_STATES], M_Q2[N_STATES], M_Q3[N_STATES];
-    float M_Z[N_STATES], M_VZ[N_STATES], M_BETA[N_STATES];
+    // 6) Compute M = F · P in place over a full copy of P, one column
+    //    at a time (each column reads only its own P entries, all loaded
+    //    before any is overwritten). Rows of F that are identity
+    //    (BP_IDX, BQ_IDX, BR_IDX, B_AZ, and BETA when !tas_active) leave
+    //    the P row as is; the others add their ≤7 perturbation terms.
+    float M[N_STATES][N_STATES];
+    P_.unpack(M);
+    ONSPEED_UNROLL
     for (int j = 0; j < N_STATES; ++j) {
-        const float Pq0 = P_[Q0][j], Pq1 = P_[Q1][j];
-        const float Pq2 = P_[Q2][j], Pq3 = P_[Q3][j];
-        const float Pbp = P_[BP_IDX][j], Pbq = P_[BQ_IDX][j], Pbr = P_[BR_IDX][j];
-        const float Pvz = P_[VZ][j], Pbaz = P_[B_AZ][j];
-
-        M_Q0[j] = Pq0 + a01 * Pq1 + a02 * Pq2 + a03 * Pq3
-                + qb_q0_bp * Pbp + qb_q0_bq * Pbq + qb_q0_br * Pbr;
-        M_Q1[j] = Pq1 + a10 * Pq0 + a12 * Pq2 + a13 * Pq3
-                + qb_q1_bp * Pbp + qb_q1_bq * Pbq + qb_q1_br * Pbr;
-        M_Q2[j] = Pq2 + a20 * Pq0 + a21 * Pq1 + a23 * Pq3
-                + qb_q2_bp * Pbp + qb_q2_bq * Pbq + qb_q2_br * Pbr;
-        M_Q3[j] = Pq3 + a30 * Pq0 + a31 * Pq1 + a32 * Pq2
-                + qb_q3_bp * Pbp + qb_q3_bq * Pbq + qb_q3_br * Pbr;
-
-        M_VZ[j] = Pvz + vz_q0 * Pq0 + vz_q1 * Pq1
+        const float Pq0 = M[Q0][j], Pq1 = M[Q1][j];
+        const float Pq2 = M[Q2][j], Pq3 = M[Q3][j];
+        const float Pbp = M[BP_IDX][j], Pbq = M[BQ_IDX][j], Pbr = M[BR_IDX][j];
+        const float Pvz = M[VZ][j], Pbaz = M[B_AZ][j];
+
+        M[Q0][j] = Pq0 + a01 * Pq1 + a02 * Pq2 + a03 * Pq3
+                 + qb_q0_bp * Pbp + qb_q0_bq * Pbq + qb_q0_br * Pbr;
+        M[Q1][j] = Pq1 + a10 * Pq0 + a12 * Pq2 + a13 * Pq3
+                 + qb_q1_bp * Pbp + qb_q1_bq * Pbq + qb_q1_br * Pbr;
+        M[Q2][j] = Pq2 + a20 * Pq0 + a21 * Pq1 + a23 * Pq3
+                 + qb_q2_bp * Pbp + qb_q2_bq * Pbq + qb_q2_br * Pbr;
+        M[Q3][j] = Pq3 + a30 * Pq0 + a31 * Pq1 + a32 * Pq2
+                 + qb_q3_bp * Pbp + qb_q3_bq * Pbq + qb_q3_br * Pbr;
+
+        M[VZ][j] = Pvz + vz_q0 * Pq0 + vz_q1 * Pq1
                        + vz_q2 * Pq2 + vz_q3 * Pq3
                        + vz_baz * Pbaz;
-        M_Z[j]  = P_[Z][j] + z_q0 * Pq0 + z_q1 * Pq1
+        M[Z][j]  = M[Z][j] + z_q0 * Pq0 + z_q1 * Pq1
                            + z_q2 * Pq2 + z_q3 * Pq3
                            + z_vz * Pvz + z_baz * Pbaz;
 
         if (tas_active) {
-            M_BETA[j] = P_[BETA][j] + beta_q0 * Pq0 + beta_q1 * Pq1
+            M[BETA][j] = M[BETA][j] + beta_q0 * Pq0 + beta_q1 * Pq1
                                     + beta_q2 * Pq2 + beta_q3 * Pq3
                                     + beta_br_dt * Pbr;
-        } else {
-            M_BETA[j] = P_[BETA][j];
         }
     }
-    // Identity rows of F: M[i][j] = P[i][j] (read directly when needed).
-
-    // 7) Compute P_new = M · F^T using the same sparse structure.
-    //    For each output element P_new[i][j], we need M[i][k] · F[j][k].
-    //    F[j][k] = δ_jk + δF[j][k]; the identity contribution gives
-    //    M[i][j], and the δF perturbations add a few terms per column.
-    //
-    //    We cache M's row i values once per outer iteration, then compute
-    //    all 11 columns of P_new[i][:]. Writes into P_ are safe because
-    //    we cache the row's M values BEFORE writing back.
 
+    // 7) P_new = M · Fᵀ, upper triangle only. Element (i, j) is M row i
+    //    times F row j: the identity term M[i][j] plus F row j's
+    //    perturbations. P_new is symmetric, so (j, i) for j < i would
+    //    only repeat the same sum in a different rounding order. M is a
+    //    separate copy, so the result is written straight into P_.
+    ONSPEED_UNROLL
     for (int i = 0; i < N_STATES; ++i) {
-        // Cache M[i][:] into locals. Source is one of M_* buffers (for
-        // non-identity rows) or P_[i][:] (for identity rows).
-        float Mi_Q0, Mi_Q1, Mi_Q2, Mi_Q3;
-        float Mi_BP, Mi_BQ, Mi_BR;
-        float Mi_Z,  Mi_VZ, Mi_BAZ;
-        float Mi_BETA;
-        switch (i) {
-            case Q0:
-                Mi_Q0 = M_Q0[Q0]; Mi_Q1 = M_Q0[Q1]; Mi_Q2 = M_Q0[Q2]; Mi_Q3 = M_Q0[Q3];
-                Mi_BP = M_Q0[BP_IDX]; Mi_BQ = M_Q0[BQ_IDX]; Mi_BR = M_Q0[BR_IDX];
-                Mi_Z  = M_Q0[Z];  Mi_VZ = M_Q0[VZ]; Mi_BAZ = M_Q0[B_AZ];
-                Mi_BETA = M_Q0[BETA];
-                break;
-            case Q1:
-                Mi_Q0 = M_Q1[Q0]; Mi_Q1 = M_Q1[Q1]; Mi_Q2 = M_Q1[Q2]; Mi_Q3 = M_Q1[Q3];
-                Mi_BP = M_Q1[BP_IDX]; Mi_BQ = M_Q1[BQ_IDX]; Mi_BR = M_Q1[BR_IDX];
-                Mi_Z  = M_Q1[Z];  Mi_VZ = M_Q1[VZ]; Mi_BAZ = M_Q1[B_AZ];
-                Mi_BETA = M_Q1[BETA];
-                break;
-            case Q2:
-                Mi_Q0 = M_Q2[Q0]; Mi_Q1 = M_Q2[Q1]; Mi_Q2 = M_Q2[Q2]; Mi_Q3 = M_Q2[Q3];
-                Mi_BP = M_Q2[BP_IDX]; Mi_BQ = M_Q2[BQ_IDX]; Mi_BR = M_Q2[BR_IDX];
-                Mi_Z  = M_Q2[Z];  Mi_VZ = M_Q2[VZ]; Mi_BAZ = M_Q2[B_AZ];
-                Mi_BETA = M_Q2[BETA];
-                break;
-            case Q3:
-                Mi_Q0 = M_Q3[Q0]; Mi_Q1 = M_Q3[Q1]; Mi_Q2 = M_Q3[Q2]; Mi_Q3 = M_Q3[Q3];
-                Mi_BP = M_Q3[BP_IDX]; Mi_BQ = M_Q3[BQ_IDX]; Mi_BR = M_Q3[BR_IDX];
-                Mi_Z  = M_Q3[Z];  Mi_VZ = M_Q3[VZ]; Mi_BAZ = M_Q3[B_AZ];
-                Mi_BETA = M_Q3[BETA];
-                break;
-            case Z:
-                Mi_Q0 = M_Z[Q0]; Mi_Q1 = M_Z[Q1]; Mi_Q2 = M_Z[Q2]; Mi_Q3 = M_Z[Q3];
-                Mi_BP = M_Z[BP_IDX]; Mi_BQ = M_Z[BQ_IDX]; Mi_BR = M_Z[BR_IDX];
-                Mi_Z  = M_Z[Z];  Mi_VZ = M_Z[VZ]; Mi_BAZ = M_Z[B_AZ];
-                Mi_BETA = M_Z[BETA];
-                break;
-            case VZ:
-                Mi_Q0 = M_VZ[Q0]; Mi_Q1 = M_VZ[Q1]; Mi_Q2 = M_VZ[Q2]; Mi_Q3 = M_VZ[Q3];
-                Mi_BP = M_VZ[BP_IDX]; Mi_BQ = M_VZ[BQ_IDX]; Mi_BR = M_VZ[BR_IDX];
-                Mi_Z  = M_VZ[Z];  Mi_VZ = M_VZ[VZ]; Mi_BAZ = M_VZ[B_AZ];
-                Mi_BETA = M_VZ[BETA];
-                break;
-            case BETA:
-                Mi_Q0 = M_BETA[Q0]; Mi_Q1 = M_BETA[Q1]; Mi_Q2 = M_BETA[Q2]; Mi_Q3 = M_BETA[Q3];
-                Mi_BP = M_BETA[BP_IDX]; Mi_BQ = M_BETA[BQ_IDX]; Mi_BR = M_BETA[BR_IDX];
-                Mi_Z  = M_BETA[Z];  Mi_VZ = M_BETA[VZ]; Mi_BAZ = M_BETA[B_AZ];
-                Mi_BETA = M_BETA[BETA];
-                break;
-            default:  // BP_IDX, BQ_IDX, BR_IDX, B_AZ — identity rows of F
-                Mi_Q0 = P_[i][Q0]; Mi_Q1 = P_[i][Q1]; Mi_Q2 = P_[i][Q2]; Mi_Q3 = P_[i][Q3];
-                Mi_BP = P_[i][BP_IDX]; Mi_BQ = P_[i][BQ_IDX]; Mi_BR = P_[i][BR_IDX];
-                Mi_Z  = P_[i][Z];  Mi_VZ = P_[i][VZ]; Mi_BAZ = P_[i][B_AZ];
-                Mi_BETA = P_[i][BETA];
-                break;
+        const float* Mi = M[i];
+        float* Pi = P_.row(i);
+        if (i <= Q0) {
+            Pi[Q0] = Mi[Q0] + a01 * Mi[Q1] + a02 * Mi[Q2] + a03 * Mi[Q3]
+                   + qb_q0_bp * Mi[BP_IDX] + qb_q0_bq * Mi[BQ_IDX] + qb_q0_br * Mi[BR_IDX];
         }
-
-        // Now write the 11 columns of P_new[i][:] = M[i][:] · F^T.
-        // Identity columns (BP_IDX/BQ_IDX/BR_IDX/B_AZ): just write the cached M value.
-        P_[i][BP_IDX]   = Mi_BP;
-        P_[i][BQ_IDX]   = Mi_BQ;
-        P_[i][BR_IDX]   = Mi_BR;
-        P_[i][B_AZ] = Mi_BAZ;
-
-        // Q-block columns: each adds the row-j perturbations of F.
-        P_[i][Q0] = Mi_Q0 + a01 * Mi_Q1 + a02 * Mi_Q2 + a03 * Mi_Q3
-                          + qb_q0_bp * Mi_BP + qb_q0_bq * Mi_BQ + qb_q0_br * Mi_BR;
-        P_[i][Q1] = Mi_Q1 + a10 * Mi_Q0 + a12 * Mi_Q2 + a13 * Mi_Q3
-                          + qb_q1_bp * Mi_BP + qb_q1_bq * Mi_BQ + qb_q1_br * Mi_BR;
-        P_[i][Q2] = Mi_Q2 + a20 * Mi_Q0 + a21 * Mi_Q1 + a23 * Mi_Q3
-                          + qb_q2_bp * Mi_BP + qb_q2_bq * Mi_BQ + qb_q2_br * Mi_BR;
-        P_[i][Q3] = Mi_Q3 + a30 * Mi_Q0 + a31 * Mi_Q1 + a32 * Mi_Q2
-                          + qb_q3_bp * Mi_BP + qb_q3_bq * Mi_BQ + qb_q3_br * Mi_BR;
-
-        // VZ column.
-        P_[i][VZ] = Mi_VZ + vz_q0 * Mi_Q0 + vz_q1 * Mi_Q1
-                          + vz_q2 * Mi_Q2 + vz_q3 * Mi_Q3
-                          + vz_baz * Mi_BAZ;
-        // Z column.
-        P_[i][Z]  = Mi_Z  + z_q0 * Mi_Q0 + z_q1 * Mi_Q1
-                          + z_q2 * Mi_Q2 + z_q3 * Mi_Q3
-                          + z_vz * Mi_VZ + z_baz * Mi_BAZ;
-        // BETA column.
+        if (i <= Q1) {
+            Pi[Q1] = Mi[Q1] + a10 * Mi[Q0] + a12 * Mi[Q2] + a13 * Mi[Q3]
+                   + qb_q1_bp * Mi[BP_IDX] + qb_q1_bq * Mi[BQ_IDX] + qb_q1_br * Mi[BR_IDX];
+        }
+        if (i <= Q2) {
+            Pi[Q2] = Mi[Q2] + a20 * Mi[Q0] + a21 * Mi[Q1] + a23 * Mi[Q3]
+                   + qb_q2_bp * Mi[BP_IDX] + qb_q2_bq * Mi[BQ_IDX] + qb_q2_br * Mi[BR_IDX];
+        }
+        if (i <= Q3) {
+            Pi[Q3] = Mi[Q3] + a30 * Mi[Q0] + a31 * Mi[Q1] + a32 * Mi[Q2]
+                   + qb_q3_bp * Mi[BP_IDX] + qb_q3_bq * Mi[BQ_IDX] + qb_q3_br * Mi[BR_IDX];
+        }
+        // Identity columns of Fᵀ.
+        if (i <= BP_IDX) Pi[BP_IDX] = Mi[BP_IDX];
+        if (i <= BQ_IDX) Pi[BQ_IDX] = Mi[BQ_IDX];
+        if (i <= BR_IDX) Pi[BR_IDX] = Mi[BR_IDX];
+        if (i <= Z) {
+            Pi[Z] = Mi[Z] + z_q0 * Mi[Q0] + z_q1 * Mi[Q1]
+                          + z_q2 * Mi[Q2] + z_q3 * Mi[Q3]
+                          + z_vz * Mi[VZ] + z_baz * Mi[B_AZ];
+        }
+        if (i <= VZ) {
+            Pi[VZ] = Mi[VZ] + vz_q0 * Mi[Q0] + vz_q1 * Mi[Q1]
+                            + vz_q2 * Mi[Q2] + vz_q3 * Mi[Q3]
+                            + vz_baz * Mi[B_AZ];
+        }
+        if (i <= B_AZ) Pi[B_AZ] = Mi[B_AZ];
         if (tas_active) {
-            P_[i][BETA] = Mi_BETA + beta_q0 * Mi_Q0 + beta_q1 * Mi_Q1
-                                  + beta_q2 * Mi_Q2 + beta_q3 * Mi_Q3
-                                  + beta_br_dt * Mi_BR;
+            Pi[BETA] = Mi[BETA] + beta_q0 * Mi[Q0] + beta_q1 * Mi[Q1]
+                                + beta_q2 * Mi[Q2] + beta_q3 * Mi[Q3]
+                                + beta_br_dt * Mi[BR_IDX];
         } else {
-            P_[i][BETA] = Mi_BETA;
+            Pi[BETA] = Mi[BETA];
         }
     }
 
     // 8) Add Q·dt on the diagonal.
-    P_[Q0][Q0] += config_.q_quat * dt;
-    P_[Q1][Q1] += config_.q_quat * dt;
-    P_[Q2][Q2] += config_.q_quat * dt;
-    P_[Q3][Q3] += config_.q_quat * dt;
-    P_[BP_IDX][BP_IDX] += config_.q_bias * dt;
-    P_[BQ_IDX][BQ_IDX] += config_.q_bias * dt;
-    P_[BR_IDX][BR_IDX] += config_.q_bias * dt;
-    P_[Z][Z]   += config_.q_z    * dt;
-    P_[VZ][VZ] += config_.q_vz   * dt;
-    P_[B_AZ][B_AZ] += config_.q_b_az * dt;
-    P_[BETA][BETA] += config_.q_beta * dt;
+    P_.at(Q0, Q0) += config_.q_quat * dt;
+    P_.at(Q1, Q1) += config_.q_quat * dt;
+    P_.at(Q2, Q2) += config_.q_quat * dt;
+    P_.at(Q3, Q3) += config_.q_quat * dt;
+    P_.at(BP_IDX, BP_IDX) += config_.q_bias * dt;
+    P_.at(BQ_IDX, BQ_IDX) += config_.q_bias * dt;
+    P_.at(BR_IDX, BR_IDX) += config_.q_bias * dt;
+    P_.at(Z, Z)   += config_.q_z    * dt;
+    P_.at(VZ, VZ) += config_.q_vz   * dt;
+    P_.at(B_AZ, B_AZ) += config_.q_b_az * dt;
+    P_.at(BETA, BETA) += config_.q_beta * dt;
 
     // 9) Commit state.
     x_[Q0] = q0_new;
@@ -493,7 +444,7 @@ void EKFQ::predict(float p, float q_in, float r_in,
 //   3) Compute innovation y = z_meas − h(x_pred)  (all at predict state).
 //   4) Compute PHt = P · Hᵀ                       (11×8).
 //   5) Compute S = H · PHt + R_diag               (8×8, SPD).
-//   6) Cholesky-factorise S = L·Lᵀ (in-place lower triangle).
+//   6) Cholesky-factorise S = L·Lᵀ (in place).
 //   7) Solve for K: row-by-row triangular solve   (11 systems, one per row).
 //   8) Single state update x = x + K · y.
 //   9) Joseph-form covariance P = (I − K·H)·P·(I − K·H)ᵀ + K·R·Kᵀ
@@ -501,18 +452,46 @@ void EKFQ::predict(float p, float q_in, float r_in,
 //      Python reference also uses Joseph form).
 //  10) Renormalise the quaternion.
 //
-// All buffers are stack-allocated and sized for the maximum 8-measurement
-// case. Total ~2.4 KB of stack frame; <8 KB total task stack budget on
-// the ESP32-S3 still has headroom.
+// Steps 4–9 are the fixed-size kernels in FixedMatrix.h. The measurement
+// count is a template parameter — 8 with a baro sample, 7 without (the
+// baro row is omitted from H/y/R entirely) — so every loop has a constant
+// bound and unrolls completely. P and S are symmetric and only their
+// upper triangles are computed and stored.
 //
-// If the baro update is requested but `updateBaro=false`, we collapse to
-// 7 active measurements (the baro row is omitted from H/y/R entirely).
+// All buffers are stack-allocated: ~2.2 KB for the 8-measurement case,
+// dominated by the two 11×11 Joseph temporaries.
+//
+// Sequential mode (Config::sequential_update) replaces steps 4–9. R is
+// diagonal, so the measurements are independent given x and can be fused
+// one at a time, in H's row order, each with its own scalar Joseph update
+// (ahrs::JosephScalarUpdate). Each innovation is moved to the current
+// estimate linearly, y_m − H_m·(x − x_pred), with H still evaluated at
+// the predict state. In exact arithmetic that reproduces the batch
+// result. In fp32 it differs only by rounding. A scalar whose innovation
+// variance is not positive is skipped; the batch update would abandon
+// the whole step instead.
 // ---------------------------------------------------------------------------
 
 void EKFQ::correct(float ax_meas, float ay_meas, float az_meas,
                    float tas, float tasDot,
                    float pitchRate, float yawRate,
                    float baroZ, bool updateBaro) {
+    if (updateBaro) {
+        correctN<8>(ax_meas, ay_meas, az_meas, tas, tasDot,
+                    pitchRate, yawRate, baroZ);
+    } else {
+        correctN<7>(ax_meas, ay_meas, az_meas, tas, tasDot,
+                    pitchRate, yawRate, baroZ);
+    }
+}
+
+template <int NM>
+void EKFQ::correctN(float ax_meas, float ay_meas, float az_meas,
+                    float tas, float tasDot,
+                    float pitchRate, float yawRate, float baroZ) {
+    static_assert(NM == 7 || NM == 8, "7 measurements, plus baro when present");
+    constexpr bool kBaro = (NM == 8);
+
     // 1) Snapshot predict state.
     const float q0 = x_[Q0], q1 = x_[Q1], q2 = x_[Q2], q3 = x_[Q3];
     const float bp = x_[BP_IDX], bq = x_[BQ_IDX], br = x_[BR_IDX];
@@ -535,13 +514,12 @@ void EKFQ::correct(float ax_meas, float ay_meas, float az_meas,
     const float r_ay_eff = config_.r_ay
                            * (1.0f + config_.k_beta_R * beta * beta);
 
-    // 2) Build measurement vectors and H matrix (8 max, 7 when !updateBaro).
-    constexpr int N_MEAS_MAX = 8;
-    float z_meas [N_MEAS_MAX];
-    float h_pred [N_MEAS_MAX];
-    float R_diag [N_MEAS_MAX];
-    float H[N_MEAS_MAX][N_STATES];
-    std::memset(H, 0, sizeof(H));
+    // 2) Build measurement vectors and H matrix.
+    float z_meas[NM];
+    float h_pred[NM];
+    float R_diag[NM];
+    ahrs::FixedMatrix<NM, N_STATES> H;
+    H.setZero();
 
     int n = 0;
     // accel x  (4 quaternion-block non-zeros)
@@ -568,10 +546,13 @@ void EKFQ::correct(float ax_meas, float ay_meas, float az_meas,
     H[n][BQ_IDX] = +tas;
     n++;
     // baro altitude (optional)
-    if (updateBaro) {
+    if constexpr (kBaro) {
         z_meas[n] = baroZ; h_pred[n] = z; R_diag[n] = config_.r_baro;
         H[n][Z] = 1.0f;
         n++;
+    } else {
+        (void)baroZ;
+        (void)z;
     }
     // β = 0 weak prior
     z_meas[n] = 0.0f; h_pred[n] = beta; R_diag[n] = config_.r_beta_prior;
@@ -587,83 +568,53 @@ void EKFQ::correct(float ax_meas, float ay_meas, float az_meas,
     n++;
     z_meas[n] = 0.0f; h_pred[n] = br; R_diag[n] = config_.r_bias_prior;
     H[n][BR_IDX] = 1.0f;
-    n++;
 
     // 3) Innovation y = z_meas − h_pred (all at predict state).
-    float y[N_MEAS_MAX];
-    for (int i = 0; i < n; ++i) y[i] = z_meas[i] - h_pred[i];
-
-    // 4) PHt = P · Hᵀ  (N_STATES × n). H rows are sparse but we just
-    //    use the obvious triple loop — overall O(N·N·n) ≈ 1000 flops.
-    float PHt[N_STATES][N_MEAS_MAX];
-    for (int i = 0; i < N_STATES; ++i) {
-        for (int j = 0; j < n; ++j) {
-            float s = 0.0f;
-            for (int k = 0; k < N_STATES; ++k) {
-                s += P_[i][k] * H[j][k];   // Hᵀ[k][j] = H[j][k]
-            }
-            PHt[i][j] = s;
-        }
-    }
-
-    // 5) S = H · PHt + R  (n × n, symmetric positive definite by
-    //    construction: P is SPD, R is positive diagonal). Compute the
-    //    lower triangle and mirror.
-    float S[N_MEAS_MAX][N_MEAS_MAX];
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j <= i; ++j) {
-            float s = 0.0f;
-            for (int k = 0; k < N_STATES; ++k) s += H[i][k] * PHt[k][j];
-            S[i][j] = s;
-            if (i != j) S[j][i] = s;
+    float y[NM];
+    for (int i = 0; i < NM; ++i) y[i] = z_meas[i] - h_pred[i];
+
+    if (config_.sequential_update) {
+        // 4s–9s) One scalar Joseph update per measurement row.
+        float dx[N_STATES] = {};
+        for (int m = 0; m < NM; ++m) {
+            float ym = y[m];
+            for (int i = 0; i < N_STATES; ++i) ym -= H[m][i] * dx[i];
+            float k[N_STATES];
+            if (!ahrs::JosephScalarUpdate(P_, H.m[m], R_diag[m], k)) continue;
+            for (int i = 0; i < N_STATES; ++i) dx[i] += k[i] * ym;
         }
-        S[i][i] += R_diag[i];
+        for (int i = 0; i < N_STATES; ++i) x_[i] += dx[i];
+        renormaliseQuaternion();
+        return;
     }
 
-    // 6) Cholesky factorise S in-place. L overwrites lower triangle of S;
-    //    upper triangle becomes scratch (not read after this point).
-    for (int j = 0; j < n; ++j) {
-        float sum = S[j][j];
-        for (int k = 0; k < j; ++k) sum -= S[j][k] * S[j][k];
-        if (sum <= 0.0f) {
-            // S lost positive-definiteness due to fp32 round-off. Abort
-            // the update — same failure mode as the Python try/except
-            // around np.linalg.solve (LinAlgError on a singular S).
-            return;
-        }
-        S[j][j] = std::sqrt(sum);
-        const float inv_diag = 1.0f / S[j][j];
-        for (int i = j + 1; i < n; ++i) {
-            float s2 = S[i][j];
-            for (int k = 0; k < j; ++k) s2 -= S[i][k] * S[j][k];
-            S[i][j] = s2 * inv_diag;
-        }
+    // 4) PHt = P · Hᵀ  (N_STATES × NM).
+    ahrs::FixedMatrix<N_STATES, NM> PHt;
+    ahrs::MulSymABt(P_, H, PHt);
+
+    // 5) S = H · PHt + R  (NM × NM, symmetric positive definite by
+    //    construction: P is SPD, R is positive diagonal).
+    ahrs::SymMatrix<NM> S;
+    ahrs::InnovationCovariance(H, PHt, R_diag, S);
+
+    // 6) Cholesky factorise S in place.
+    if (!ahrs::CholeskyInPlace(S)) {
+        // S lost positive-definiteness due to fp32 round-off. Abort
+        // the update — same failure mode as the Python try/except
+        // around np.linalg.solve (LinAlgError on a singular S).
+        return;
     }
 
     // 7) Solve K = PHt · S⁻¹  ⟺  S · Kᵀ = PHtᵀ  (S is symmetric so
     //    Sᵀ = S in Python's np.linalg.solve(S.T, PHt.T)). One forward-
-    //    back substitution per row of PHt → 11 systems, each O(n²).
-    float K_mat[N_STATES][N_MEAS_MAX];
-    for (int i = 0; i < N_STATES; ++i) {
-        float vec[N_MEAS_MAX];
-        // Forward: L · vec = PHt[i,:]ᵀ
-        for (int a = 0; a < n; ++a) {
-            float sum = PHt[i][a];
-            for (int b = 0; b < a; ++b) sum -= S[a][b] * vec[b];
-            vec[a] = sum / S[a][a];
-        }
-        // Back: Lᵀ · K[i,:]ᵀ = vec
-        for (int a = n - 1; a >= 0; --a) {
-            float sum = vec[a];
-            for (int b = a + 1; b < n; ++b) sum -= S[b][a] * K_mat[i][b];
-            K_mat[i][a] = sum / S[a][a];
-        }
-    }
+    //    back substitution per row of PHt → 11 systems, each O(NM²).
+    ahrs::FixedMatrix<N_STATES, NM> K_mat;
+    ahrs::CholeskySolveRows(S, PHt, K_mat);
 
     // 8) x = x + K · y.
     for (int i = 0; i < N_STATES; ++i) {
         float dx = 0.0f;
-        for (int j = 0; j < n; ++j) dx += K_mat[i][j] * y[j];
+        for (int j = 0; j < NM; ++j) dx += K_mat[i][j] * y[j];
         x_[i] += dx;
     }
 
@@ -672,37 +623,7 @@ void EKFQ::correct(float ax_meas, float ay_meas, float az_meas,
     //    This is the numerically-stable form Python uses. Algebraically
     //    it equals the simple (I − K·H)·P update; fp32 round-off can
     //    push the simple form non-PSD, but Joseph stays PSD.
-    //
-    // 9a) I_KH = I − K·H  (stored in KH).
-    float KH[N_STATES][N_STATES];
-    for (int i = 0; i < N_STATES; ++i) {
-        for (int j = 0; j < N_STATES; ++j) {
-            float s = 0.0f;
-            for (int k = 0; k < n; ++k) s += K_mat[i][k] * H[k][j];
-            KH[i][j] = ((i == j) ? 1.0f : 0.0f) - s;
-        }
-    }
-    // 9b) A = (I − K·H) · P  (full 11×11 matmul).
-    float A[N_STATES][N_STATES];
-    for (int i = 0; i < N_STATES; ++i) {
-        for (int j = 0; j < N_STATES; ++j) {
-            float s = 0.0f;
-            for (int k = 0; k < N_STATES; ++k) s += KH[i][k] * P_[k][j];
-            A[i][j] = s;
-        }
-    }
-    // 9c) P_new = A · (I − K·H)ᵀ  +  K · R · Kᵀ.
-    //     R is diagonal → (K · R · Kᵀ)[i][j] = Σ_m K[i][m] · R_diag[m] · K[j][m].
-    for (int i = 0; i < N_STATES; ++i) {
-        for (int j = 0; j < N_STATES; ++j) {
-            float s = 0.0f;
-            // A · (I − K·H)ᵀ — note (I-KH)ᵀ[k][j] = KH[j][k]
-            for (int k = 0; k < N_STATES; ++k) s += A[i][k] * KH[j][k];
-            // K · R · Kᵀ contribution.
-            for (int m = 0; m < n; ++m) s += K_mat[i][m] * R_diag[m] * K_mat[j][m];
-            P_[i][j] = s;
-        }
-    }
+    ahrs::JosephUpdate(P_, K_mat, H, R_diag);
 
     // 10) Quaternion normalisation (same fp32 hygiene Python does).
     renormaliseQuaternion();
@@ -722,10 +643,13 @@ EKFQ::State EKFQ::getState() const {
 }
 
 float EKFQ::alphaKinematicRad(float tas_mps) const {
+    return alphaKinematicRad(getState(), tas_mps);
+}
+
+float EKFQ::alphaKinematicRad(const State& s, float tas_mps) {
     // Universal kinematic AOA formula with β correction. Matches the
     // Python reference's alpha_kinematic() exactly so the firmware AOA
     // output is bit-equivalent to the Optuna-tuned filter's outputs.
-    const State s = getState();
     const float phi   = s.roll_rad();
     const float theta = s.pitch_rad();
     if (tas_mps < 0.5f) {
@@ -59,23 +59,37 @@
  *
  *   • predict():  F is built sparsely (bp/bq/br/b_az rows are identity).
  *     Covariance update F·P·Fᵀ skips the all-identity rows entirely —
- *     roughly 2× faster than the naïve 2·N³ approach for N=11.
+ *     roughly 2× faster than the naïve 2·N³ approach for N=11 — and
+ *     computes only the upper triangle of the symmetric result.
+ *     bench/bench_ekfq_kernels times both steps against the previous
+ *     full-matrix loops.
  *   • correct():  pure BATCH update — 8 measurements (3 accel + baro
  *     + β prior + 3 gyro-bias priors), one joint Kalman gain K via
  *     Cholesky factorisation of S = H·P·Hᵀ + R, Joseph-form covariance
  *     update. Matches the Python `ekf_quat.py` reference exactly so
  *     the Optuna-tuned defaults give the same numerical behaviour the
- *     tuning study targeted. ~6–7k float ops/step including the
- *     11×11·11×11 Joseph matmuls; ESP32-S3 single-core overhead still
- *     under 2%.
+ *     tuning study targeted. The matrix algebra runs on the fixed-size
+ *     kernels in FixedMatrix.h (measurement count is a template
+ *     parameter, so every loop bound is constant and fully unrolled);
+ *     S and the Joseph result are computed as upper triangles only.
+ *   • correct() with Config::sequential_update: R is diagonal, so the
+ *     same measurements can be fused one scalar at a time — no S, no
+ *     Cholesky, and an O(N²) Joseph update per scalar. Roughly 0.6× the
+ *     batch cost on the host bench; use it where the IMU task's
+ *     worst-case latency matters more than bit-matching the tuning
+ *     reference.
  *
- * Memory: all stack. P is 11×11 = 484 bytes; the batch correct() step
- * needs ~2.4 KB of transient buffers (H, PHt, S, K_mat, KH, A); total
- * well inside the IMU task's stack budget. No heap, no exceptions.
+ * Memory: all stack. P is stored as its packed upper triangle, 66 floats
+ * = 264 bytes. predict() unpacks it into a 484-byte full working copy;
+ * the batch correct() step needs ~2.2 KB of transient buffers (H, PHt,
+ * S, K_mat, I−KH, A); total well inside the IMU task's stack budget.
+ * No heap, no exceptions.
  */
 
 #include <cstdint>
 
+#include <ahrs/FixedMatrix.h>
+
 namespace onspeed {
 
 class EKFQ {
@@ -128,6 +142,11 @@ public:
         /// Below this TAS, β dynamics are damped (low-speed taxi/stall).
         float tas_min_mps;
 
+        /// Fuse the measurements one scalar at a time instead of as one
+        /// joint batch (see correct()). Off by default: the Optuna
+        /// defaults were tuned against the batch update.
+        bool  sequential_update;
+
         /// Production-ready defaults from the Optuna best trial.
         static Config defaults();
     };
@@ -207,7 +226,8 @@ public:
     /// Apply the measurement update.  `tas` and `tasDot` should be
     /// faded by the pipeline's compFadeIn before this call so the
     /// centripetal / TASdot terms in h(x) ramp in smoothly after the
-    /// iasGate rising edge.
+    /// iasGate rising edge.  Batch or sequential per
+    /// Config::sequential_update.
     void correct(float ax, float ay, float az,
                  float tas, float tasDot,
                  float pitchRate, float yawRate,
@@ -219,6 +239,9 @@ public:
     /// Compute derived kinematic AOA from current state + given TAS (rad).
     float alphaKinematicRad(float tas_mps) const;
 
+    /// The same, from a State snapshot (EKFQBatch lanes have no EKFQ).
+    static float alphaKinematicRad(const State& s, float tas_mps);
+
     /// Reference to the loaded config.
     const Config& getConfig() const { return config_; }
 
@@ -237,19 +260,28 @@ public:
 
 #ifdef UNIT_TEST
 public:
-    const float (*getP() const)[N_STATES] { return P_; }
+    float getP(int i, int j) const { return P_(i, j); }
     const float* getX() const { return x_; }
 private:
 #endif
 
 private:
+    /// EKFQBatch moves whole filters in and out of its lanes.
+    friend class EKFQBatch;
+
     Config config_;
     float  x_[N_STATES];
-    float  P_[N_STATES][N_STATES];
+    ahrs::SymMatrix<N_STATES> P_;   ///< Covariance, upper triangle
     bool   initialized_;
 
     static constexpr float GRAVITY = 9.80665f;
 
+    /// correct() for a fixed measurement count: 8 with baro, 7 without.
+    template <int NM>
+    void correctN(float ax_meas, float ay_meas, float az_meas,
+                  float tas, float tasDot,
+                  float pitchRate, float yawRate, float baroZ);
+
     /// Renormalise the quaternion sub-vector after predict.
     void renormaliseQuaternion();
 
@@ -0,0 +1,532 @@
+// EKFQBatch.cpp — EKFQ × LANES in structure-of-arrays form.
+//
+// Every kernel below is EKFQ.cpp's algebra with an extra innermost
+// `for (int l = 0; l < LANES; ++l)`. Keep the per-lane expressions in the
+// same order as the scalar filter — test_ekfq_batch compares the two with
+// exact equality. Per-lane control flow becomes a select on a lane mask;
+// see the equivalence notes in EKFQBatch.h.
+
+#include "EKFQBatch.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace onspeed {
+
+namespace {
+constexpr int L = EKFQBatch::LANES;
+}   // namespace
+
+// ---------------------------------------------------------------------------
+// Construction / lane management
+// ---------------------------------------------------------------------------
+
+EKFQBatch::EKFQBatch() {
+    const EKFQ seed;   // defaults + init()
+    for (int l = 0; l < L; ++l) setLane(l, seed);
+}
+
+void EKFQBatch::setConfig(int lane, const EKFQ::Config& cfg) {
+    config_[lane] = cfg;
+    qDiag_[EKFQ::Q0][lane]     = cfg.q_quat;
+    qDiag_[EKFQ::Q1][lane]     = cfg.q_quat;
+    qDiag_[EKFQ::Q2][lane]     = cfg.q_quat;
+    qDiag_[EKFQ::Q3][lane]     = cfg.q_quat;
+    qDiag_[EKFQ::BP_IDX][lane] = cfg.q_bias;
+    qDiag_[EKFQ::BQ_IDX][lane] = cfg.q_bias;
+    qDiag_[EKFQ::BR_IDX][lane] = cfg.q_bias;
+    qDiag_[EKFQ::Z][lane]      = cfg.q_z;
+    qDiag_[EKFQ::VZ][lane]     = cfg.q_vz;
+    qDiag_[EKFQ::B_AZ][lane]   = cfg.q_b_az;
+    qDiag_[EKFQ::BETA][lane]   = cfg.q_beta;
+    rAx_[lane]        = cfg.r_ax;
+    rAy_[lane]        = cfg.r_ay;
+    rAz_[lane]        = cfg.r_az;
+    rBaro_[lane]      = cfg.r_baro;
+    rBetaPrior_[lane] = cfg.r_beta_prior;
+    rBiasPrior_[lane] = cfg.r_bias_prior;
+    kBetaR_[lane]     = cfg.k_beta_R;
+    tasMin_[lane]     = cfg.tas_min_mps;
+}
+
+void EKFQBatch::setLane(int lane, const EKFQ& src) {
+    setConfig(lane, src.config_);
+    for (int i = 0; i < N_STATES; ++i) {
+        x_[i][lane] = src.x_[i];
+        for (int j = 0; j < N_STATES; ++j) P_[i][j][lane] = src.P_(i, j);
+    }
+}
+
+void EKFQBatch::getLane(int lane, EKFQ& out) const {
+    out.config_ = config_[lane];
+    for (int i = 0; i < N_STATES; ++i) {
+        out.x_[i] = x_[i][lane];
+        for (int j = i; j < N_STATES; ++j) out.P_.at(i, j) = P_[i][j][lane];
+    }
+    out.initialized_ = true;
+}
+
+// Lane-level init and vertical reset are rare, so they round-trip through
+// a scalar EKFQ rather than duplicating its code.
+void EKFQBatch::init(int lane, float initial_phi, float initial_theta,
+                     float initial_z) {
+    EKFQ f(config_[lane]);
+    f.init(initial_phi, initial_theta, initial_z);
+    setLane(lane, f);
+}
+
+void EKFQBatch::resetVerticalCovariance(int lane, float baro_z) {
+    EKFQ f;
+    getLane(lane, f);
+    f.resetVerticalCovariance(baro_z);
+    setLane(lane, f);
+}
+
+EKFQ::State EKFQBatch::getState(int lane) const {
+    EKFQ::State s;
+    s.q0 = x_[EKFQ::Q0][lane]; s.q1 = x_[EKFQ::Q1][lane];
+    s.q2 = x_[EKFQ::Q2][lane]; s.q3 = x_[EKFQ::Q3][lane];
+    s.bp = x_[EKFQ::BP_IDX][lane]; s.bq = x_[EKFQ::BQ_IDX][lane];
+    s.br = x_[EKFQ::BR_IDX][lane];
+    s.z  = x_[EKFQ::Z][lane]; s.vz = x_[EKFQ::VZ][lane];
+    s.b_az = x_[EKFQ::B_AZ][lane];
+    s.beta = x_[EKFQ::BETA][lane];
+    return s;
+}
+
+void EKFQBatch::renormaliseQuaternion(const bool (&apply)[LANES]) {
+    for (int l = 0; l < L; ++l) {
+        const float q0 = x_[EKFQ::Q0][l], q1 = x_[EKFQ::Q1][l];
+        const float q2 = x_[EKFQ::Q2][l], q3 = x_[EKFQ::Q3][l];
+        const float n2 = q0*q0 + q1*q1 + q2*q2 + q3*q3;
+        const bool  go = apply[l] && n2 > 0.0f;
+        // ×1 is exact, so lanes that skip the renormalise are untouched.
+        const float inv = go ? 1.0f / std::sqrt(n2) : 1.0f;
+        x_[EKFQ::Q0][l] = q0 * inv; x_[EKFQ::Q1][l] = q1 * inv;
+        x_[EKFQ::Q2][l] = q2 * inv; x_[EKFQ::Q3][l] = q3 * inv;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// update = predict + correct
+// ---------------------------------------------------------------------------
+
+void EKFQBatch::update(const EKFQ::Measurements (&m)[LANES], float dt) {
+    PredictInputs pin;
+    CorrectInputs cin;
+    for (int l = 0; l < L; ++l) {
+        pin.p[l]  = m[l].p;  pin.q[l]  = m[l].q;  pin.r[l]  = m[l].r;
+        pin.ax[l] = m[l].ax; pin.ay[l] = m[l].ay; pin.az[l] = m[l].az;
+        pin.tas[l] = m[l].tasMps;
+        pin.dt[l]  = dt;
+
+        cin.ax[l] = m[l].ax; cin.ay[l] = m[l].ay; cin.az[l] = m[l].az;
+        cin.tas[l]       = m[l].tasMps;
+        cin.tasDot[l]    = m[l].tasDotMps2;
+        cin.pitchRate[l] = m[l].q;
+        cin.yawRate[l]   = m[l].r;
+        cin.baroZ[l]     = m[l].baroAltMeters;
+        cin.updateBaro[l] = m[l].updateBaro;
+    }
+    predict(pin);
+    correct(cin);
+}
+
+// ---------------------------------------------------------------------------
+// Predict — EKFQ::predict() per lane, then the sparse F·P·Fᵀ across lanes
+// ---------------------------------------------------------------------------
+
+void EKFQBatch::predict(const PredictInputs& in) {
+    enum { Q0 = EKFQ::Q0, Q1 = EKFQ::Q1, Q2 = EKFQ::Q2, Q3 = EKFQ::Q3,
+           BP = EKFQ::BP_IDX, BQ = EKFQ::BQ_IDX, BR = EKFQ::BR_IDX,
+           Z = EKFQ::Z, VZ = EKFQ::VZ, B_AZ = EKFQ::B_AZ, BETA = EKFQ::BETA };
+
+    // Sparse F perturbation coefficients, one row per coefficient (see
+    // EKFQ::predict() step 5 for the pattern).
+    float a01[L], a02[L], a03[L], a10[L], a12[L], a13[L];
+    float a20[L], a21[L], a23[L], a30[L], a31[L], a32[L];
+    float qb0p[L], qb0q[L], qb0r[L], qb1p[L], qb1q[L], qb1r[L];
+    float qb2p[L], qb2q[L], qb2r[L], qb3p[L], qb3q[L], qb3r[L];
+    float vz_q0[L], vz_q1[L], vz_q2[L], vz_q3[L], vz_baz[L];
+    float z_q0[L], z_q1[L], z_q2[L], z_q3[L], z_vz[L], z_baz[L];
+    float beta_q0[L], beta_q1[L], beta_q2[L], beta_q3[L], beta_br_dt[L];
+    bool  tas_active[L];
+    float xq0[L], xq1[L], xq2[L], xq3[L], xz[L], xvz[L], xbeta[L];
+
+    // 1–5) Mean propagation and F coefficients. The trig is scalar per
+    //      lane; everything after it is the same arithmetic as EKFQ.
+    for (int l = 0; l < L; ++l) {
+        const float dt = in.dt[l];
+        const float q0 = x_[Q0][l], q1 = x_[Q1][l], q2 = x_[Q2][l], q3 = x_[Q3][l];
+        const float p_c = in.p[l] - x_[BP][l];
+        const float q_c = in.q[l] - x_[BQ][l];
+        const float r_c = in.r[l] - x_[BR][l];
+        const float vz = x_[VZ][l], b_az = x_[B_AZ][l], beta = x_[BETA][l];
+        const float ax_raw = in.ax[l], ay_raw = in.ay[l], az_raw = in.az[l];
+        const float tas = in.tas[l];
+
+        const float half_dt = 0.5f * dt;
+        const float wx = p_c * dt, wy = q_c * dt, wz = r_c * dt;
+        const float theta2 = wx * wx + wy * wy + wz * wz;
+        const float half_angle = 0.5f * std::sqrt(theta2);
+        const float dq_w = std::cos(half_angle);
+        const float s = (half_angle > 1e-4f)
+            ? 0.5f * std::sin(half_angle) / half_angle
+            : 0.5f * (1.0f - half_angle * half_angle * (1.0f / 6.0f));
+        const float dq_x = s * wx, dq_y = s * wy, dq_z = s * wz;
+
+        xq0[l] = q0 * dq_w - q1 * dq_x - q2 * dq_y - q3 * dq_z;
+        xq1[l] = q0 * dq_x + q1 * dq_w + q2 * dq_z - q3 * dq_y;
+        xq2[l] = q0 * dq_y - q1 * dq_z + q2 * dq_w + q3 * dq_x;
+        xq3[l] = q0 * dq_z + q1 * dq_y - q2 * dq_x + q3 * dq_w;
+
+        const float R20 = 2.0f * (q1 * q3 - q0 * q2);
+        const float R21 = 2.0f * (q2 * q3 + q0 * q1);
+        const float R22 = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+
+        const float a_D = R20 * ax_raw + R21 * ay_raw + R22 * az_raw
+                          + GRAVITY - b_az;
+        xz[l]  = x_[Z][l] - (vz + 0.5f * a_D * dt) * dt;
+        xvz[l] = vz + a_D * dt;
+
+        const bool active = (tas > tasMin_[l]);
+        tas_active[l] = active;
+        float new_beta = beta;
+        if (active) {
+            const float g_body_y = R21 * GRAVITY;
+            const float beta_dot = (ay_raw + g_body_y) / tas - r_c;
+            new_beta = beta + dt * beta_dot;
+        }
+        xbeta[l] = new_beta;
+
+        a01[l] = -half_dt * p_c; a02[l] = -half_dt * q_c; a03[l] = -half_dt * r_c;
+        a10[l] =  half_dt * p_c; a12[l] =  half_dt * r_c; a13[l] = -half_dt * q_c;
+        a20[l] =  half_dt * q_c; a21[l] = -half_dt * r_c; a23[l] =  half_dt * p_c;
+        a30[l] =  half_dt * r_c; a31[l] =  half_dt * q_c; a32[l] = -half_dt * p_c;
+
+        qb0p[l] =  half_dt * q1; qb0q[l] =  half_dt * q2; qb0r[l] =  half_dt * q3;
+        qb1p[l] = -half_dt * q0; qb1q[l] =  half_dt * q3; qb1r[l] = -half_dt * q2;
+        qb2p[l] = -half_dt * q3; qb2q[l] = -half_dt * q0; qb2r[l] =  half_dt * q1;
+        qb3p[l] =  half_dt * q2; qb3q[l] = -half_dt * q1; qb3r[l] = -half_dt * q0;
+
+        const float dD_q0 = -2.0f * q2 * ax_raw + 2.0f * q1 * ay_raw + 2.0f * q0 * az_raw;
+        const float dD_q1 =  2.0f * q3 * ax_raw + 2.0f * q0 * ay_raw - 2.0f * q1 * az_raw;
+        const float dD_q2 = -2.0f * q0 * ax_raw + 2.0f * q3 * ay_raw - 2.0f * q2 * az_raw;
+        const float dD_q3 =  2.0f * q1 * ax_raw + 2.0f * q2 * ay_raw + 2.0f * q3 * az_raw;
+        const float dt2 = dt * dt;
+        const float half_dt2 = 0.5f * dt2;
+
+        vz_q0[l] = dt * dD_q0; vz_q1[l] = dt * dD_q1;
+        vz_q2[l] = dt * dD_q2; vz_q3[l] = dt * dD_q3;
+        vz_baz[l] = -dt;
+        z_q0[l] = -half_dt2 * dD_q0; z_q1[l] = -half_dt2 * dD_q1;
+        z_q2[l] = -half_dt2 * dD_q2; z_q3[l] = -half_dt2 * dD_q3;
+        z_vz[l] = -dt; z_baz[l] = half_dt2;
+
+        beta_q0[l] = beta_q1[l] = beta_q2[l] = beta_q3[l] = 0.0f;
+        beta_br_dt[l] = 0.0f;
+        if (active) {
+            const float g_over_tas_dt = (GRAVITY / tas) * dt;
+            beta_q0[l] = g_over_tas_dt * 2.0f * q1;
+            beta_q1[l] = g_over_tas_dt * 2.0f * q0;
+            beta_q2[l] = g_over_tas_dt * 2.0f * q3;
+            beta_q3[l] = g_over_tas_dt * 2.0f * q2;
+            beta_br_dt[l] = dt;
+        }
+    }
+
+    // 6) M = F · P. Identity rows of F copy P.
+    float M[N_STATES][N_STATES][L];
+    for (int j = 0; j < N_STATES; ++j) {
+        for (int l = 0; l < L; ++l) {
+            const float Pq0 = P_[Q0][j][l], Pq1 = P_[Q1][j][l];
+            const float Pq2 = P_[Q2][j][l], Pq3 = P_[Q3][j][l];
+            const float Pbp = P_[BP][j][l], Pbq = P_[BQ][j][l], Pbr = P_[BR][j][l];
+            const float Pvz = P_[VZ][j][l], Pbaz = P_[B_AZ][j][l];
+
+            M[Q0][j][l] = Pq0 + a01[l] * Pq1 + a02[l] * Pq2 + a03[l] * Pq3
+                        + qb0p[l] * Pbp + qb0q[l] * Pbq + qb0r[l] * Pbr;
+            M[Q1][j][l] = Pq1 + a10[l] * Pq0 + a12[l] * Pq2 + a13[l] * Pq3
+                        + qb1p[l] * Pbp + qb1q[l] * Pbq + qb1r[l] * Pbr;
+            M[Q2][j][l] = Pq2 + a20[l] * Pq0 + a21[l] * Pq1 + a23[l] * Pq3
+                        + qb2p[l] * Pbp + qb2q[l] * Pbq + qb2r[l] * Pbr;
+            M[Q3][j][l] = Pq3 + a30[l] * Pq0 + a31[l] * Pq1 + a32[l] * Pq2
+                        + qb3p[l] * Pbp + qb3q[l] * Pbq + qb3r[l] * Pbr;
+
+            M[VZ][j][l] = Pvz + vz_q0[l] * Pq0 + vz_q1[l] * Pq1
+                              + vz_q2[l] * Pq2 + vz_q3[l] * Pq3
+                              + vz_baz[l] * Pbaz;
+            M[Z][j][l]  = P_[Z][j][l] + z_q0[l] * Pq0 + z_q1[l] * Pq1
+                                      + z_q2[l] * Pq2 + z_q3[l] * Pq3
+                                      + z_vz[l] * Pvz + z_baz[l] * Pbaz;
+
+            const float mBeta = P_[BETA][j][l] + beta_q0[l] * Pq0 + beta_q1[l] * Pq1
+                                               + beta_q2[l] * Pq2 + beta_q3[l] * Pq3
+                                               + beta_br_dt[l] * Pbr;
+            M[BETA][j][l] = tas_active[l] ? mBeta : P_[BETA][j][l];
+
+            M[BP][j][l]   = Pbp;
+            M[BQ][j][l]   = Pbq;
+            M[BR][j][l]   = Pbr;
+            M[B_AZ][j][l] = Pbaz;
+        }
+    }
+
+    // 7) P = M · Fᵀ, same sparse pattern on the column side. Like EKFQ,
+    //    only j ≥ i is computed; the lower triangle is its mirror.
+    float Pn[N_STATES][N_STATES][L];
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int l = 0; l < L; ++l) {
+            const float Mi_Q0 = M[i][Q0][l], Mi_Q1 = M[i][Q1][l];
+            const float Mi_Q2 = M[i][Q2][l], Mi_Q3 = M[i][Q3][l];
+            const float Mi_BP = M[i][BP][l], Mi_BQ = M[i][BQ][l], Mi_BR = M[i][BR][l];
+            const float Mi_Z  = M[i][Z][l],  Mi_VZ = M[i][VZ][l], Mi_BAZ = M[i][B_AZ][l];
+            const float Mi_BETA = M[i][BETA][l];
+
+            Pn[i][BP][l]   = Mi_BP;
+            Pn[i][BQ][l]   = Mi_BQ;
+            Pn[i][BR][l]   = Mi_BR;
+            Pn[i][B_AZ][l] = Mi_BAZ;
+
+            Pn[i][Q0][l] = Mi_Q0 + a01[l] * Mi_Q1 + a02[l] * Mi_Q2 + a03[l] * Mi_Q3
+                                 + qb0p[l] * Mi_BP + qb0q[l] * Mi_BQ + qb0r[l] * Mi_BR;
+            Pn[i][Q1][l] = Mi_Q1 + a10[l] * Mi_Q0 + a12[l] * Mi_Q2 + a13[l] * Mi_Q3
+                                 + qb1p[l] * Mi_BP + qb1q[l] * Mi_BQ + qb1r[l] * Mi_BR;
+            Pn[i][Q2][l] = Mi_Q2 + a20[l] * Mi_Q0 + a21[l] * Mi_Q1 + a23[l] * Mi_Q3
+                                 + qb2p[l] * Mi_BP + qb2q[l] * Mi_BQ + qb2r[l] * Mi_BR;
+            Pn[i][Q3][l] = Mi_Q3 + a30[l] * Mi_Q0 + a31[l] * Mi_Q1 + a32[l] * Mi_Q2
+                                 + qb3p[l] * Mi_BP + qb3q[l] * Mi_BQ + qb3r[l] * Mi_BR;
+
+            Pn[i][VZ][l] = Mi_VZ + vz_q0[l] * Mi_Q0 + vz_q1[l] * Mi_Q1
+                                 + vz_q2[l] * Mi_Q2 + vz_q3[l] * Mi_Q3
+                                 + vz_baz[l] * Mi_BAZ;
+            Pn[i][Z][l]  = Mi_Z  + z_q0[l] * Mi_Q0 + z_q1[l] * Mi_Q1
+                                 + z_q2[l] * Mi_Q2 + z_q3[l] * Mi_Q3
+                                 + z_vz[l] * Mi_VZ + z_baz[l] * Mi_BAZ;
+
+            const float pBeta = Mi_BETA + beta_q0[l] * Mi_Q0 + beta_q1[l] * Mi_Q1
+                                        + beta_q2[l] * Mi_Q2 + beta_q3[l] * Mi_Q3
+                                        + beta_br_dt[l] * Mi_BR;
+            Pn[i][BETA][l] = tas_active[l] ? pBeta : Mi_BETA;
+        }
+    }
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int j = i; j < N_STATES; ++j) {
+            for (int l = 0; l < L; ++l) {
+                P_[i][j][l] = Pn[i][j][l];
+                P_[j][i][l] = Pn[i][j][l];
+            }
+        }
+    }
+
+    // 8) Q·dt on the diagonal.
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int l = 0; l < L; ++l) P_[i][i][l] += qDiag_[i][l] * in.dt[l];
+    }
+
+    // 9) Commit state and renormalise.
+    bool all[L];
+    for (int l = 0; l < L; ++l) {
+        x_[Q0][l] = xq0[l]; x_[Q1][l] = xq1[l];
+        x_[Q2][l] = xq2[l]; x_[Q3][l] = xq3[l];
+        x_[Z][l]    = xz[l];
+        x_[VZ][l]   = xvz[l];
+        x_[BETA][l] = xbeta[l];
+        all[l] = true;
+    }
+    renormaliseQuaternion(all);
+}
+
+// ---------------------------------------------------------------------------
+// Correct — EKFQ::correct()'s batch update with a fixed 8-row layout
+// ---------------------------------------------------------------------------
+
+void EKFQBatch::correct(const CorrectInputs& in) {
+    enum { Q0 = EKFQ::Q0, Q1 = EKFQ::Q1, Q2 = EKFQ::Q2, Q3 = EKFQ::Q3,
+           BP = EKFQ::BP_IDX, BQ = EKFQ::BQ_IDX, BR = EKFQ::BR_IDX,
+           Z = EKFQ::Z, BETA = EKFQ::BETA };
+    // Rows: ax, ay, az, baro, β prior, bp/bq/br priors. A lane without a
+    // baro sample turns row 3 into an inert H=0, R=1, y=0 row.
+    constexpr int NM = 8;
+    constexpr int BARO_ROW = 3;
+    const float g = GRAVITY;
+
+    // 1–3) Innovation, R and H at the predict state.
+    float y[NM][L], R_diag[NM][L];
+    float H[NM][N_STATES][L];
+    std::memset(H, 0, sizeof(H));
+    for (int l = 0; l < L; ++l) {
+        const float q0 = x_[Q0][l], q1 = x_[Q1][l], q2 = x_[Q2][l], q3 = x_[Q3][l];
+        const float bp = x_[BP][l], bq = x_[BQ][l], br = x_[BR][l];
+        const float z = x_[Z][l], beta = x_[BETA][l];
+        const float tas = in.tas[l];
+
+        const float q_c = in.pitchRate[l] - bq;
+        const float r_c = in.yawRate[l]   - br;
+        const float ax_pred = -2.0f * g * (q1 * q3 - q0 * q2) + in.tasDot[l];
+        const float ay_pred = -2.0f * g * (q2 * q3 + q0 * q1) + tas * r_c;
+        const float az_pred =       -g * (q0*q0 - q1*q1 - q2*q2 + q3*q3) - tas * q_c;
+        const float r_ay_eff = rAy_[l] * (1.0f + kBetaR_[l] * beta * beta);
+
+        y[0][l] = in.ax[l] - ax_pred; R_diag[0][l] = rAx_[l];
+        H[0][Q0][l] =  2.0f * g * q2;
+        H[0][Q1][l] = -2.0f * g * q3;
+        H[0][Q2][l] =  2.0f * g * q0;
+        H[0][Q3][l] = -2.0f * g * q1;
+
+        y[1][l] = in.ay[l] - ay_pred; R_diag[1][l] = r_ay_eff;
+        H[1][Q0][l] = -2.0f * g * q1;
+        H[1][Q1][l] = -2.0f * g * q0;
+        H[1][Q2][l] = -2.0f * g * q3;
+        H[1][Q3][l] = -2.0f * g * q2;
+        H[1][BR][l] = -tas;
+
+        y[2][l] = in.az[l] - az_pred; R_diag[2][l] = rAz_[l];
+        H[2][Q0][l] = -2.0f * g * q0;
+        H[2][Q1][l] =  2.0f * g * q1;
+        H[2][Q2][l] =  2.0f * g * q2;
+        H[2][Q3][l] = -2.0f * g * q3;
+        H[2][BQ][l] = +tas;
+
+        const bool baro = in.updateBaro[l];
+        y[BARO_ROW][l]      = baro ? in.baroZ[l] - z : 0.0f;
+        R_diag[BARO_ROW][l] = baro ? rBaro_[l] : 1.0f;
+        H[BARO_ROW][Z][l]   = baro ? 1.0f : 0.0f;
+
+        y[4][l] = 0.0f - beta; R_diag[4][l] = rBetaPrior_[l];
+        H[4][BETA][l] = 1.0f;
+        y[5][l] = 0.0f - bp;   R_diag[5][l] = rBiasPrior_[l];
+        H[5][BP][l] = 1.0f;
+        y[6][l] = 0.0f - bq;   R_diag[6][l] = rBiasPrior_[l];
+        H[6][BQ][l] = 1.0f;
+        y[7][l] = 0.0f - br;   R_diag[7][l] = rBiasPrior_[l];
+        H[7][BR][l] = 1.0f;
+    }
+
+    // 4) PHt = P · Hᵀ.
+    float PHt[N_STATES][NM][L];
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int j = 0; j < NM; ++j) {
+            float s[L] = {};
+            for (int k = 0; k < N_STATES; ++k) {
+                for (int l = 0; l < L; ++l) s[l] += P_[i][k][l] * H[j][k][l];
+            }
+            for (int l = 0; l < L; ++l) PHt[i][j][l] = s[l];
+        }
+    }
+
+    // 5) S = H · PHt + R, lower triangle mirrored.
+    float S[NM][NM][L];
+    for (int i = 0; i < NM; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            float s[L] = {};
+            for (int k = 0; k < N_STATES; ++k) {
+                for (int l = 0; l < L; ++l) s[l] += H[i][k][l] * PHt[k][j][l];
+            }
+            for (int l = 0; l < L; ++l) {
+                S[i][j][l] = s[l];
+                S[j][i][l] = s[l];
+            }
+        }
+        for (int l = 0; l < L; ++l) S[i][i][l] += R_diag[i][l];
+    }
+
+    // 6) In-place Cholesky. A lane that loses positive-definiteness is
+    //    flagged and carried along with a dummy pivot; its results are
+    //    discarded at the end, as EKFQ::correct() returns early.
+    bool ok[L];
+    for (int l = 0; l < L; ++l) ok[l] = true;
+    for (int j = 0; j < NM; ++j) {
+        float inv_diag[L];
+        for (int l = 0; l < L; ++l) {
+            float sum = S[j][j][l];
+            for (int k = 0; k < j; ++k) sum -= S[j][k][l] * S[j][k][l];
+            const bool bad = (sum <= 0.0f);
+            ok[l] = ok[l] && !bad;
+            S[j][j][l] = std::sqrt(bad ? 1.0f : sum);
+            inv_diag[l] = 1.0f / S[j][j][l];
+        }
+        for (int i = j + 1; i < NM; ++i) {
+            for (int l = 0; l < L; ++l) {
+                float s2 = S[i][j][l];
+                for (int k = 0; k < j; ++k) s2 -= S[i][k][l] * S[j][k][l];
+                S[i][j][l] = s2 * inv_diag[l];
+            }
+        }
+    }
+
+    // 7) K = PHt · S⁻¹ by forward/back substitution per state row.
+    float K_mat[N_STATES][NM][L];
+    for (int i = 0; i < N_STATES; ++i) {
+        float vec[NM][L];
+        for (int a = 0; a < NM; ++a) {
+            for (int l = 0; l < L; ++l) {
+                float sum = PHt[i][a][l];
+                for (int b = 0; b < a; ++b) sum -= S[a][b][l] * vec[b][l];
+                vec[a][l] = sum / S[a][a][l];
+            }
+        }
+        for (int a = NM - 1; a >= 0; --a) {
+            for (int l = 0; l < L; ++l) {
+                float sum = vec[a][l];
+                for (int b = a + 1; b < NM; ++b) sum -= S[b][a][l] * K_mat[i][b][l];
+                K_mat[i][a][l] = sum / S[a][a][l];
+            }
+        }
+    }
+
+    // 8) x = x + K · y on the lanes that factorised.
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int l = 0; l < L; ++l) {
+            float dx = 0.0f;
+            for (int j = 0; j < NM; ++j) dx += K_mat[i][j][l] * y[j][l];
+            x_[i][l] = ok[l] ? x_[i][l] + dx : x_[i][l];
+        }
+    }
+
+    // 9) Joseph form P = (I − K·H) · P · (I − K·H)ᵀ + K · R · Kᵀ, upper
+    //    triangle mirrored down as in EKFQ.
+    float KH[N_STATES][N_STATES][L];
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int j = 0; j < N_STATES; ++j) {
+            for (int l = 0; l < L; ++l) {
+                float s = 0.0f;
+                for (int k = 0; k < NM; ++k) s += K_mat[i][k][l] * H[k][j][l];
+                KH[i][j][l] = ((i == j) ? 1.0f : 0.0f) - s;
+            }
+        }
+    }
+    float A[N_STATES][N_STATES][L];
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int j = 0; j < N_STATES; ++j) {
+            float s[L] = {};
+            for (int k = 0; k < N_STATES; ++k) {
+                for (int l = 0; l < L; ++l) s[l] += KH[i][k][l] * P_[k][j][l];
+            }
+            for (int l = 0; l < L; ++l) A[i][j][l] = s[l];
+        }
+    }
+    for (int i = 0; i < N_STATES; ++i) {
+        for (int j = i; j < N_STATES; ++j) {
+            float s[L] = {};
+            for (int k = 0; k < N_STATES; ++k) {
+                for (int l = 0; l < L; ++l) s[l] += A[i][k][l] * KH[j][k][l];
+            }
+            for (int m = 0; m < NM; ++m) {
+                for (int l = 0; l < L; ++l) {
+                    s[l] += K_mat[i][m][l] * R_diag[m][l] * K_mat[j][m][l];
+                }
+            }
+            for (int l = 0; l < L; ++l) {
+                const float pij = ok[l] ? s[l] : P_[i][j][l];
+                P_[i][j][l] = pij;
+                P_[j][i][l] = pij;
+            }
+        }
+    }
+
+    // 10) Quaternion normalisation on the updated lanes.
+    renormaliseQuaternion(ok);
+}
+
+}  // namespace onspeed
@@ -0,0 +1,139 @@
+#ifndef EKFQ_BATCH_H_
+#define EKFQ_BATCH_H_
+
+/**
+ * @file EKFQBatch.h
+ * @brief LANES independent EKFQ filters advanced in lockstep (host tuning).
+ *
+ * Offline tuning sweeps and Monte-Carlo robustness runs step many
+ * EKFQ instances over the same kind of input. EKFQBatch holds LANES of
+ * them in structure-of-arrays form: every state element and every
+ * covariance entry is a `float[LANES]` row. The innermost loop of each
+ * kernel runs across lanes, so the F·P·Fᵀ propagation, the Cholesky
+ * factorisation, the triangular solves and the Joseph update become
+ * plain element-wise SSE/AVX arithmetic under the host compiler's
+ * auto-vectoriser. Each lane has its own Config, its own inputs, and
+ * its own dt.
+ *
+ * @section batch_equivalence Equivalence with EKFQ
+ *
+ * Each lane evaluates the same float expressions in the same order as
+ * EKFQ::predict() / EKFQ::correct(). Per-lane branches become selects:
+ *
+ *   • The sinc small-angle branch, the TAS gate on β dynamics, and the
+ *     quaternion renormalise compute both sides and keep one.
+ *   • A lane with updateBaro=false keeps the baro row with H=0, R=1
+ *     and y=0. That row factorises to an identity row of L and a zero
+ *     column of K. Every other quantity picks up only extra `± 0` terms.
+ *   • A lane whose S loses positive-definiteness keeps its pre-correct
+ *     x and P. That matches EKFQ's early return.
+ *
+ * Lanes always run the batch measurement update;
+ * Config::sequential_update is ignored here.
+ *
+ * Strict mode is a build that emits no FMA instructions and does not
+ * use -ffast-math. That covers the default x86-64 target and -mavx2.
+ * In strict mode every lane matches a scalar EKFQ fed the same inputs
+ * bit-for-bit, apart from the sign of exact zeros. test_ekfq_batch
+ * checks this with ==. With FMA enabled (-mfma, or -march=native on
+ * current x86), the scalar and vector paths round differently and the
+ * lanes drift. Over a 10-minute 208 Hz synthetic replay the drift stayed
+ * below 1e-3° in attitude and 1e-3 m in altitude. That is far below
+ * anything a tuning loss can resolve.
+ *
+ * Throughput: 8 lanes take about 0.3× the time of 8 scalar EKFQ
+ * updates in a Release build on x86-64 (bench_core's
+ * ekfq_update/batch_x8 against ekfq_update/scalar_x8). host_main
+ * ekfq_sweep runs its configs through it via EkfqPipelineBatch.
+ *
+ * Memory: P alone is 11·11·LANES floats (3.9 KB). correct() keeps about
+ * 20 KB of transient buffers on the stack. This class is meant for
+ * host tools, not for the IMU task.
+ */
+
+#include <ahrs/EKFQ.h>
+
+namespace onspeed {
+
+class EKFQBatch {
+public:
+    static constexpr int N_STATES = EKFQ::N_STATES;
+    /// One AVX register of floats.
+    static constexpr int LANES = 8;
+
+    /// Per-lane inputs to predict(); same meaning as EKFQ::predict()'s
+    /// arguments.
+    struct PredictInputs {
+        float p[LANES];
+        float q[LANES];
+        float r[LANES];
+        float ax[LANES];
+        float ay[LANES];
+        float az[LANES];
+        float tas[LANES];
+        float dt[LANES];
+    };
+
+    /// Per-lane inputs to correct(); same meaning as EKFQ::correct()'s
+    /// arguments.
+    struct CorrectInputs {
+        float ax[LANES];
+        float ay[LANES];
+        float az[LANES];
+        float tas[LANES];
+        float tasDot[LANES];
+        float pitchRate[LANES];
+        float yawRate[LANES];
+        float baroZ[LANES];
+        bool  updateBaro[LANES];
+    };
+
+    /// Every lane gets Config::defaults() and init().
+    EKFQBatch();
+
+    /// Replace one lane's config. Does NOT reset state (as EKFQ::setConfig).
+    void setConfig(int lane, const EKFQ::Config& cfg);
+    const EKFQ::Config& getConfig(int lane) const { return config_[lane]; }
+
+    /// EKFQ::init() for one lane.
+    void init(int lane, float initial_phi = 0.0f, float initial_theta = 0.0f,
+              float initial_z = 0.0f);
+
+    /// EKFQ::resetVerticalCovariance() for one lane.
+    void resetVerticalCovariance(int lane, float baro_z);
+
+    /// Copy a scalar filter's config, state and covariance into `lane`,
+    /// or a lane back out into `out`. Use getLane() for outputs such as
+    /// alphaKinematicRad() that EKFQ derives from its state.
+    void setLane(int lane, const EKFQ& src);
+    void getLane(int lane, EKFQ& out) const;
+
+    /// One predict + correct cycle on every lane, as EKFQ::update().
+    void update(const EKFQ::Measurements (&meas)[LANES], float dt);
+
+    void predict(const PredictInputs& in);
+    void correct(const CorrectInputs& in);
+
+    EKFQ::State getState(int lane) const;
+
+private:
+    EKFQ::Config config_[LANES];
+
+    // Hot-loop copies of the per-lane config, one row per parameter.
+    float qDiag_[N_STATES][LANES];   ///< Process noise spectral density
+    float rAx_[LANES], rAy_[LANES], rAz_[LANES], rBaro_[LANES];
+    float rBetaPrior_[LANES], rBiasPrior_[LANES], kBetaR_[LANES];
+    float tasMin_[LANES];
+
+    float x_[N_STATES][LANES];
+    float P_[N_STATES][N_STATES][LANES];
+
+    static constexpr float GRAVITY = 9.80665f;
+
+    /// EKFQ::renormaliseQuaternion() on the lanes where `apply` is set.
+    void renormaliseQuaternion(const bool (&apply)[LANES]);
+};
+
+}  // namespace onspeed
+
+#endif  // EKFQ_BATCH_H_
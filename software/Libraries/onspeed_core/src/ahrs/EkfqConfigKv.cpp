@@ -77,15 +77,24 @@ bool ParseEkfqConfigKv(std::string_view text,
         {"p_b_az",       [](float v, auto& e, auto&){ e.p_b_az = v; return true; }},
         {"p_beta",       [](float v, auto& e, auto&){ e.p_beta = v; return true; }},
         {"tas_min_mps",  [](float v, auto& e, auto&){ e.tas_min_mps = v; return true; }},
+        {"sequential_update", [](float v, auto& e, auto&){
+            if (v != 0.0f && v != 1.0f) return false;
+            e.sequential_update = (v == 1.0f);
+            return true;
+        }},
         {"accel_ema_alpha",     [](float v, auto&, auto& p){ p.accelEmaAlpha   = v; return true; }},
         {"comp_fade_tau_sec",   [](float v, auto&, auto& p){ p.compFadeTauSec  = v; return true; }},
         {"ias_gate_rising_kt",  [](float v, auto&, auto& p){ p.iasGateRisingKt = v; return true; }},
         {"tasdot_ema_alpha",    [](float v, auto&, auto& p){ p.tasdotEmaAlpha  = v; return true; }},
     };
 
-    // Track which keys were seen so we can warn on the rest.
+    // Track which keys were seen so we can warn on the rest. Mode
+    // switches are not tuning parameters; leaving one out is not worth
+    // a warning.
+    static constexpr const char* kOptionalKeys[] = { "sequential_update" };
     std::unordered_map<std::string, bool> seen;
     for (const auto& [k, _] : writers) seen[k] = false;
+    for (const char* k : kOptionalKeys) seen.erase(k);
 
     // Walk lines.
     size_t lineNum = 0;
@@ -131,8 +140,15 @@ bool ParseEkfqConfigKv(std::string_view text,
             warn(buf);
             return false;
         }
-        (void)it->second(v, outEkfqCfg, outPipeCfg);
-        seen[key] = true;
+        if (!it->second(v, outEkfqCfg, outPipeCfg)) {
+            char buf[160];
+            std::snprintf(buf, sizeof(buf),
+                "EkfqConfigKv: line %zu value out of range for key '%s'",
+                lineNum, key.c_str());
+            warn(buf);
+            return false;
+        }
+        if (seen.count(key) != 0) seen[key] = true;
     }
 
     // Warn on missing keys (defaults already applied).
@@ -13,6 +13,8 @@
 //     tas_min_mps
 //   PipelineConfig (4):
 //     accel_ema_alpha, comp_fade_tau_sec, ias_gate_rising_kt, tasdot_ema_alpha
+//   Optional mode switch (0 or 1; never warned as missing):
+//     sequential_update
 //
 // Unknown keys cause the parser to return false (typo guard for tuner
 // scripts). Missing keys are warned (via warnSink) and left at defaults
@@ -34,7 +36,8 @@ namespace onspeed::ahrs {
 /// On success: returns true, outEkfqCfg + outPipeCfg are populated.
 ///   Unset keys are filled from EKFQ::Config::defaults() and
 ///   PipelineConfig::defaults(); warnSink is called per missing key.
-/// On failure (unknown key, malformed line, parse error):
+/// On failure (unknown key, malformed line, parse error, out-of-range
+/// value):
 ///   returns false, calls warnSink with a descriptive message.
 ///
 /// warnSink may be null; if so, warnings are silently dropped.
@@ -75,10 +75,8 @@ void EkfqPipeline::Init(float seedPitchDeg, float seedRollDeg, float seedAltMete
     // once at boot.
 }
 
-EkfqPipeline::Outputs EkfqPipeline::Step(const Inputs& in)
+EkfqPipeline::FilterFrame EkfqPipeline::Prepare(const Inputs& in, Outputs& out)
 {
-    Outputs out;
-
     const float fallingKt = pipeCfg_.iasGateRisingKt - PipelineConfig::kIasGateHysteresisKt;
 
     // 1) Hysteretic IAS gate.  Below pipeCfg_.iasGateRisingKt, pitot
@@ -127,23 +125,10 @@ EkfqPipeline::Outputs EkfqPipeline::Step(const Inputs& in)
     tasdotSmoothed_ += pipeCfg_.tasdotEmaAlpha * (tasdotRawMps2 - tasdotSmoothed_);
     prevTasMps_ = in.tasMps;
 
-    // 5) On the gate's rising edge, reset EKFQ's vertical-channel
-    //    covariance so z/vz/b_az re-open after a long gate-closed
-    //    taxi.  Without this, the filter trusts its possibly-stale
-    //    z/vz estimates and would lag the real altitude/VSI for tens
-    //    of seconds.
-    if (out.iasGateRisingEdge) {
-        ekfq_.resetVerticalCovariance(in.baroAltMeters);
-    }
+    out.compFadeIn = compFadeIn_;
+    out.iasGate    = iasGate_;
 
-    // 6) Run EKFQ predict + correct as separate calls so predict()
-    //    sees the un-faded TAS (needed for beta-dynamics gating via
-    //    `tas > tas_min_mps`) while correct() sees the faded TAS
-    //    (centripetal / TASdot terms in h(x) ramp in smoothly).
-    //    Mirrors `pipeline_quat.py` which calls predict and correct
-    //    with the same split.
-    //
-    //    Sign-convention plumbing:
+    // 5) Sign-convention plumbing into EKFQ's standard frame:
     //
     //      ax, ay : raw post-EMA g → m/s², no sign flip.
     //      az     : OnSpeed's +1g-level convention → NED -g-level.
@@ -151,59 +136,85 @@ EkfqPipeline::Outputs EkfqPipeline::Step(const Inputs& in)
     //      p, q   : OnSpeed's internal IMU sign → aerospace standard
     //               (+p right-wing-down, +q nose-up).  Negate on input.
     //      r      : no flip.
-    const float ax_raw =  emaFwdG  * kEkfGravityMps2;
-    const float ay_raw =  emaLatG  * kEkfGravityMps2;
-    const float az_raw = -emaVertG * kEkfGravityMps2;
-    const float p_rps  = -onspeed::deg2rad(in.rollRateCorrDps);
-    const float q_rps  = -onspeed::deg2rad(in.pitchRateCorrDps);
-    const float r_rps  =  onspeed::deg2rad(in.yawRateCorrDps);
+    //
+    //    predict() sees the un-faded TAS (needed for beta-dynamics
+    //    gating via `tas > tas_min_mps`) while correct() sees the faded
+    //    TAS (centripetal / TASdot terms in h(x) ramp in smoothly).
+    //    Mirrors `pipeline_quat.py` which calls predict and correct
+    //    with the same split.
+    FilterFrame f;
+    f.ax          =  emaFwdG  * kEkfGravityMps2;
+    f.ay          =  emaLatG  * kEkfGravityMps2;
+    f.az          = -emaVertG * kEkfGravityMps2;
+    f.p           = -onspeed::deg2rad(in.rollRateCorrDps);
+    f.q           = -onspeed::deg2rad(in.pitchRateCorrDps);
+    f.r           =  onspeed::deg2rad(in.yawRateCorrDps);
+    f.tas         = in.tasMps;
+    f.tasFaded    = in.tasMps      * compFadeIn_;
+    f.tasDotFaded = tasdotSmoothed_ * compFadeIn_;
+    return f;
+}
+
+void EkfqPipeline::Finish(const Inputs& in, const EKFQ::State& state,
+                          float alphaKinRad, Outputs& out)
+{
+    out.pitchDeg      = state.pitch_deg();
+    out.rollDeg       = state.roll_deg();
+    out.derivedAoaDeg = onspeed::rad2deg(alphaKinRad);
+
+    // Vertical channel published from EKFQ's z / vz states.  vz is
+    // NED-down internally; flip the sign here so consumers receive the
+    // firmware's +climb convention.
+    out.altMeters = state.z;
+    out.vsiMps    = -state.vz;
+
+    // EarthVertG via the filter's quaternion — body→earth rotation of
+    // the unsmoothed installation-corrected vertical accel, minus the
+    // +1g level reaction-force convention.  Same formula Madgwick uses;
+    // gives 0 at level flight.
+    out.earthVertG =
+        2.0f * (state.q1 * state.q3 - state.q0 * state.q2)                         * in.accelFwdCorrG +
+        2.0f * (state.q0 * state.q1 + state.q2 * state.q3)                         * in.accelLatCorrG +
+        (state.q0 * state.q0 - state.q1 * state.q1 - state.q2 * state.q2 + state.q3 * state.q3) * in.accelVertCorrG - 1.0f;
+}
+
+EkfqPipeline::Outputs EkfqPipeline::Step(const Inputs& in)
+{
+    Outputs out;
+    const FilterFrame f = Prepare(in, out);
+
+    // On the gate's rising edge, reset EKFQ's vertical-channel
+    // covariance so z/vz/b_az re-open after a long gate-closed taxi.
+    // Without this, the filter trusts its possibly-stale z/vz estimates
+    // and would lag the real altitude/VSI for tens of seconds.
+    if (out.iasGateRisingEdge) {
+        ekfq_.resetVerticalCovariance(in.baroAltMeters);
+    }
 
     {
         onspeed::util::perf::PerfScope guard(
             onspeed::util::perf::ScopeId::EkfqPredict);
-        ekfq_.predict(p_rps, q_rps, r_rps,
-                      ax_raw, ay_raw, az_raw,
-                      in.tasMps,                  // un-faded; beta-dynamics gate
-                      in.dtSec);
+        ekfq_.predict(f.p, f.q, f.r, f.ax, f.ay, f.az, f.tas, in.dtSec);
     }
 
     {
         onspeed::util::perf::PerfScope guard(
             onspeed::util::perf::ScopeId::EkfqCorrect);
-        ekfq_.correct(ax_raw, ay_raw, az_raw,
-                      in.tasMps      * compFadeIn_,
-                      tasdotSmoothed_ * compFadeIn_,
-                      q_rps, r_rps,
+        ekfq_.correct(f.ax, f.ay, f.az,
+                      f.tasFaded, f.tasDotFaded,
+                      f.q, f.r,
                       in.baroAltMeters,
                       /* updateBaro */ true);
     }
 
     const EKFQ::State state = ekfq_.getState();
-    out.pitchDeg      = state.pitch_deg();
-    out.rollDeg       = state.roll_deg();
+    float alphaKinRad;
     {
         onspeed::util::perf::PerfScope guard(
             onspeed::util::perf::ScopeId::EkfqAlpha);
-        out.derivedAoaDeg = onspeed::rad2deg(ekfq_.alphaKinematicRad(in.tasMps));
+        alphaKinRad = EKFQ::alphaKinematicRad(state, in.tasMps);
     }
-
-    // 7) Vertical channel published from EKFQ's z / vz states.  vz is
-    //    NED-down internally; flip the sign here so consumers receive
-    //    the firmware's +climb convention.
-    out.altMeters = state.z;
-    out.vsiMps    = -state.vz;
-
-    // 8) EarthVertG via the filter's quaternion — body→earth rotation
-    //    of the unsmoothed installation-corrected vertical accel,
-    //    minus the +1g level reaction-force convention.  Same formula
-    //    Madgwick uses; gives 0 at level flight.
-    out.earthVertG =
-        2.0f * (state.q1 * state.q3 - state.q0 * state.q2)                         * in.accelFwdCorrG +
-        2.0f * (state.q0 * state.q1 + state.q2 * state.q3)                         * in.accelLatCorrG +
-        (state.q0 * state.q0 - state.q1 * state.q1 - state.q2 * state.q2 + state.q3 * state.q3) * in.accelVertCorrG - 1.0f;
-
-    out.compFadeIn = compFadeIn_;
-    out.iasGate    = iasGate_;
+    Finish(in, state, alphaKinRad, out);
     return out;
 }
 
@@ -148,6 +148,25 @@ public:
     /// Run one AHRS-stage frame.
     Outputs Step(const Inputs& in);
 
+    /// The filter-facing values of one frame: post-EMA accels and body
+    /// rates in EKFQ's NED-aerospace frame (SI units), plus the TAS /
+    /// TASdot pair with and without the compFadeIn ramp.
+    struct FilterFrame {
+        float p, q, r;          ///< rad/s
+        float ax, ay, az;       ///< m/s²
+        float tas;              ///< un-faded; predict()'s beta-dynamics gate
+        float tasFaded;         ///< tas × compFadeIn; correct()
+        float tasDotFaded;      ///< smoothed TASdot × compFadeIn; correct()
+    };
+
+    /// Step() split around the filter, for callers that advance EKFQ
+    /// themselves (EkfqPipelineBatch runs LANES pipelines through one
+    /// EKFQBatch). Step() is Prepare(); resetVerticalCovariance() on
+    /// out.iasGateRisingEdge; predict(); correct(); Finish().
+    FilterFrame Prepare(const Inputs& in, Outputs& out);
+    static void Finish(const Inputs& in, const EKFQ::State& state,
+                       float alphaKinRad, Outputs& out);
+
 private:
     EKFQ ekfq_;
 
@@ -0,0 +1,59 @@
+// EkfqPipelineBatch.cpp — see EkfqPipelineBatch.h.
+
+#include <ahrs/EkfqPipelineBatch.h>
+
+namespace onspeed::ahrs {
+
+void EkfqPipelineBatch::SetConfig(int lane, const onspeed::EKFQ::Config& ekfqCfg,
+                                  const EkfqPipeline::PipelineConfig& pipeCfg)
+{
+    lanes_[lane].getEkfq().setConfig(ekfqCfg);
+    lanes_[lane].setPipelineConfig(pipeCfg);
+    ekfq_.setConfig(lane, ekfqCfg);
+}
+
+void EkfqPipelineBatch::Init(float seedPitchDeg, float seedRollDeg, float seedAltMeters)
+{
+    for (int l = 0; l < LANES; ++l) {
+        lanes_[l].Init(seedPitchDeg, seedRollDeg, seedAltMeters);
+        ekfq_.setLane(l, lanes_[l].getEkfq());
+    }
+}
+
+void EkfqPipelineBatch::Step(const EkfqPipeline::Inputs& in,
+                             EkfqPipeline::Outputs (&out)[LANES])
+{
+    // Same sequence as EkfqPipeline::Step, one stage across all lanes
+    // at a time.
+    EKFQBatch::PredictInputs pin;
+    EKFQBatch::CorrectInputs cin;
+    for (int l = 0; l < LANES; ++l) {
+        out[l] = EkfqPipeline::Outputs{};
+        const EkfqPipeline::FilterFrame f = lanes_[l].Prepare(in, out[l]);
+        if (out[l].iasGateRisingEdge) {
+            ekfq_.resetVerticalCovariance(l, in.baroAltMeters);
+        }
+        pin.p[l]  = f.p;   pin.q[l]  = f.q;   pin.r[l]  = f.r;
+        pin.ax[l] = f.ax;  pin.ay[l] = f.ay;  pin.az[l] = f.az;
+        pin.tas[l] = f.tas;
+        pin.dt[l]  = in.dtSec;
+        cin.ax[l] = f.ax;  cin.ay[l] = f.ay;  cin.az[l] = f.az;
+        cin.tas[l]        = f.tasFaded;
+        cin.tasDot[l]     = f.tasDotFaded;
+        cin.pitchRate[l]  = f.q;
+        cin.yawRate[l]    = f.r;
+        cin.baroZ[l]      = in.baroAltMeters;
+        cin.updateBaro[l] = true;
+    }
+
+    ekfq_.predict(pin);
+    ekfq_.correct(cin);
+
+    for (int l = 0; l < LANES; ++l) {
+        const onspeed::EKFQ::State state = ekfq_.getState(l);
+        EkfqPipeline::Finish(in, state,
+                             onspeed::EKFQ::alphaKinematicRad(state, in.tasMps), out[l]);
+    }
+}
+
+}   // namespace onspeed::ahrs
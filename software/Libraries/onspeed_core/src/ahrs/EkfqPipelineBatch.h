@@ -0,0 +1,55 @@
+// EkfqPipelineBatch.h — EKFQBatch::LANES EkfqPipelines fed one frame.
+//
+// A tuning sweep replays one log through many EKFQ configs. Everything
+// in Ahrs::Step ahead of the pipeline (TAS, installation bias) is
+// config-independent, so ekfq_sweep computes that once per frame with
+// Ahrs::SensorStage() and hands the same EkfqPipeline::Inputs to every
+// lane here.
+//
+// Each lane keeps its own EkfqPipeline for the gate / fade / accel EMA /
+// TASdot state (EkfqPipeline::Prepare / Finish), so that code exists
+// once. The filter itself runs as one EKFQBatch instead of the lanes'
+// scalar EKFQs, which only serve as the template for Init().
+//
+// EKFQBatch's equivalence notes apply: in a strict (no-FMA) build every
+// lane matches EkfqPipeline::Step bit-for-bit. Lanes always use the
+// batch measurement update, so a config with sequential_update set must
+// go through EkfqPipeline instead.
+//
+// Host tools only: about 9 KB of state (5.5 KB of it the EKFQBatch)
+// plus EKFQBatch::correct()'s stack use.
+
+#ifndef ONSPEED_CORE_AHRS_EKFQ_PIPELINE_BATCH_H
+#define ONSPEED_CORE_AHRS_EKFQ_PIPELINE_BATCH_H
+
+#include <ahrs/EKFQBatch.h>
+#include <ahrs/EkfqPipeline.h>
+
+namespace onspeed::ahrs {
+
+class EkfqPipelineBatch {
+public:
+    static constexpr int LANES = EKFQBatch::LANES;
+
+    /// Every lane gets EKFQ::Config::defaults() and
+    /// PipelineConfig::defaults(), as a default-constructed EkfqPipeline.
+    EkfqPipelineBatch() = default;
+
+    /// One lane's tuning, as Ahrs::SetEkfqConfig(). Call Init() after.
+    void SetConfig(int lane, const onspeed::EKFQ::Config& ekfqCfg,
+                   const EkfqPipeline::PipelineConfig& pipeCfg);
+
+    /// EkfqPipeline::Init() on every lane.
+    void Init(float seedPitchDeg, float seedRollDeg, float seedAltMeters);
+
+    /// EkfqPipeline::Step() on every lane, all fed `in`.
+    void Step(const EkfqPipeline::Inputs& in, EkfqPipeline::Outputs (&out)[LANES]);
+
+private:
+    EkfqPipeline lanes_[LANES];
+    EKFQBatch    ekfq_;
+};
+
+}   // namespace onspeed::ahrs
+
+#endif   // ONSPEED_CORE_AHRS_EKFQ_PIPELINE_BATCH_H
@@ -0,0 +1,302 @@
+// FixedMatrix.h — compile-time-sized matrix kernels for the EKFQ update.
+//
+// Every dimension is a template parameter and every loop bound is a
+// constant, so GCC (ESP32-S3 Xtensa, host) and Clang fully unroll the
+// kernels. Each index becomes an immediate offset and the loop
+// counters disappear. Covariances are symmetric, so SymMatrix stores
+// only the upper triangle, packed row-major, and the kernels that
+// produce one compute only i ≤ j.
+//
+// The kernels keep EKFQ.cpp's summation order: each stored element is
+// the same float expression the previous full-matrix loops evaluated
+// for it. Moving to these kernels changes results only where those
+// loops let P drift asymmetric. The lower triangle is now the mirror
+// of the upper triangle instead of its own rounding of the same sum.
+//
+// Header-only; no heap, no exceptions.
+
+#ifndef ONSPEED_CORE_AHRS_FIXED_MATRIX_H
+#define ONSPEED_CORE_AHRS_FIXED_MATRIX_H
+
+#include <cmath>
+
+#if defined(__clang__)
+#define ONSPEED_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define ONSPEED_UNROLL _Pragma("GCC unroll 16")
+#else
+#define ONSPEED_UNROLL
+#endif
+
+// The firmware builds with -Os, where GCC declines to inline even
+// one-line accessors called from an unrolled loop. Every element access
+// would become a call, so the accessors and the N×M kernels force
+// inlining. The Joseph updates, whose 11×11 products unroll to several
+// hundred instructions each, are left to the compiler: forcing them
+// into both correctN instantiations costs flash for no measured gain.
+#if defined(__GNUC__)
+#define ONSPEED_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define ONSPEED_FORCE_INLINE inline
+#endif
+
+namespace onspeed::ahrs {
+
+/// Dense R×C matrix, row-major.
+template <int R, int C>
+struct FixedMatrix {
+    static constexpr int kRows = R;
+    static constexpr int kCols = C;
+
+    float m[R][C];
+
+    ONSPEED_FORCE_INLINE float*       operator[](int i)       { return m[i]; }
+    ONSPEED_FORCE_INLINE const float* operator[](int i) const { return m[i]; }
+
+    void setZero()
+    {
+        ONSPEED_UNROLL
+        for (int i = 0; i < R; ++i) {
+            ONSPEED_UNROLL
+            for (int j = 0; j < C; ++j) m[i][j] = 0.0f;
+        }
+    }
+};
+
+/// Symmetric N×N matrix. Only the upper triangle is stored: N(N+1)/2
+/// floats, row-major (row i holds columns i..N-1).
+template <int N>
+struct SymMatrix {
+    static constexpr int kN    = N;
+    static constexpr int kSize = N * (N + 1) / 2;
+
+    float v[kSize];
+
+    /// Packed offset of (i, j), i ≤ j.
+    static constexpr int index(int i, int j)
+    {
+        return i * N - (i * (i - 1)) / 2 + (j - i);
+    }
+
+    /// Element (i, j) for any order of i and j.
+    ONSPEED_FORCE_INLINE float operator()(int i, int j) const
+    {
+        return (i <= j) ? v[index(i, j)] : v[index(j, i)];
+    }
+
+    /// Writable element (i, j); i ≤ j.
+    ONSPEED_FORCE_INLINE float& at(int i, int j) { return v[index(i, j)]; }
+
+    /// Row i of the upper triangle: row(i)[j] is element (i, j) for
+    /// j ≥ i. One offset per row instead of one per element when i is
+    /// not a compile-time constant.
+    ONSPEED_FORCE_INLINE float*       row(int i)       { return v + index(i, i) - i; }
+    ONSPEED_FORCE_INLINE const float* row(int i) const { return v + index(i, i) - i; }
+
+    void setZero()
+    {
+        ONSPEED_UNROLL
+        for (int k = 0; k < kSize; ++k) v[k] = 0.0f;
+    }
+
+    /// Expand to a full N×N array (both triangles), for kernels that
+    /// walk P by rows and columns with runtime indices.
+    void unpack(float (&out)[N][N]) const
+    {
+        ONSPEED_UNROLL
+        for (int i = 0; i < N; ++i) {
+            const float* r = row(i);
+            ONSPEED_UNROLL
+            for (int j = i; j < N; ++j) {
+                out[i][j] = r[j];
+                out[j][i] = r[j];
+            }
+        }
+    }
+};
+
+/// out = P · Hᵀ (N×M).
+template <int N, int M>
+ONSPEED_FORCE_INLINE void MulSymABt(const SymMatrix<N>& P, const FixedMatrix<M, N>& H,
+                      FixedMatrix<N, M>& out)
+{
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = 0; j < M; ++j) {
+            float s = 0.0f;
+            ONSPEED_UNROLL
+            for (int k = 0; k < N; ++k) s += P(i, k) * H[j][k];
+            out[i][j] = s;
+        }
+    }
+}
+
+/// S = H · PHt + diag(r) (M×M). Element (j, i), j ≤ i, is H row i
+/// times PHt column j.
+template <int N, int M>
+ONSPEED_FORCE_INLINE void InnovationCovariance(const FixedMatrix<M, N>& H,
+                                 const FixedMatrix<N, M>& PHt,
+                                 const float (&r)[M], SymMatrix<M>& S)
+{
+    ONSPEED_UNROLL
+    for (int i = 0; i < M; ++i) {
+        ONSPEED_UNROLL
+        for (int j = 0; j <= i; ++j) {
+            float s = 0.0f;
+            ONSPEED_UNROLL
+            for (int k = 0; k < N; ++k) s += H[i][k] * PHt[k][j];
+            S.at(j, i) = s;
+        }
+        S.at(i, i) += r[i];
+    }
+}
+
+/// In-place Cholesky S = L·Lᵀ. L(i, j), i ≥ j, is stored in S at
+/// (j, i). Returns false, leaving S partly factorised, when a pivot is
+/// not positive.
+template <int M>
+ONSPEED_FORCE_INLINE bool CholeskyInPlace(SymMatrix<M>& S)
+{
+    ONSPEED_UNROLL
+    for (int j = 0; j < M; ++j) {
+        float sum = S.at(j, j);
+        ONSPEED_UNROLL
+        for (int k = 0; k < j; ++k) sum -= S.at(k, j) * S.at(k, j);
+        if (sum <= 0.0f) return false;
+        S.at(j, j) = std::sqrt(sum);
+        const float inv_diag = 1.0f / S.at(j, j);
+        ONSPEED_UNROLL
+        for (int i = j + 1; i < M; ++i) {
+            float s2 = S.at(j, i);
+            ONSPEED_UNROLL
+            for (int k = 0; k < j; ++k) s2 -= S.at(k, i) * S.at(k, j);
+            S.at(j, i) = s2 * inv_diag;
+        }
+    }
+    return true;
+}
+
+/// Solve X · (L·Lᵀ) = B row by row (K = PHt · S⁻¹), given the factor
+/// from CholeskyInPlace.
+template <int N, int M>
+ONSPEED_FORCE_INLINE void CholeskySolveRows(const SymMatrix<M>& L, const FixedMatrix<N, M>& B,
+                              FixedMatrix<N, M>& X)
+{
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        float vec[M];
+        ONSPEED_UNROLL
+        for (int a = 0; a < M; ++a) {
+            float sum = B[i][a];
+            ONSPEED_UNROLL
+            for (int b = 0; b < a; ++b) sum -= L(b, a) * vec[b];
+            vec[a] = sum / L(a, a);
+        }
+        ONSPEED_UNROLL
+        for (int a = M - 1; a >= 0; --a) {
+            float sum = vec[a];
+            ONSPEED_UNROLL
+            for (int b = a + 1; b < M; ++b) sum -= L(a, b) * X[i][b];
+            X[i][a] = sum / L(a, a);
+        }
+    }
+}
+
+/// Joseph-form covariance update
+///   P ← (I − K·H) · P · (I − K·H)ᵀ + K · diag(r) · Kᵀ
+/// computing only the upper triangle of the (symmetric) result.
+template <int N, int M>
+inline void JosephUpdate(SymMatrix<N>& P, const FixedMatrix<N, M>& K,
+                         const FixedMatrix<M, N>& H, const float (&r)[M])
+{
+    FixedMatrix<N, N> IKH;   // I − K·H
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = 0; j < N; ++j) {
+            float s = 0.0f;
+            ONSPEED_UNROLL
+            for (int k = 0; k < M; ++k) s += K[i][k] * H[k][j];
+            IKH[i][j] = ((i == j) ? 1.0f : 0.0f) - s;
+        }
+    }
+    FixedMatrix<N, N> A;     // (I − K·H) · P
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = 0; j < N; ++j) {
+            float s = 0.0f;
+            ONSPEED_UNROLL
+            for (int k = 0; k < N; ++k) s += IKH[i][k] * P(k, j);
+            A[i][j] = s;
+        }
+    }
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = i; j < N; ++j) {
+            float s = 0.0f;
+            ONSPEED_UNROLL
+            for (int k = 0; k < N; ++k) s += A[i][k] * IKH[j][k];
+            ONSPEED_UNROLL
+            for (int m = 0; m < M; ++m) s += K[i][m] * r[m] * K[j][m];
+            P.at(i, j) = s;
+        }
+    }
+}
+
+/// Joseph-form update for one scalar measurement with row h and
+/// variance r:
+///   P ← (I − k·h) · P · (I − k·h)ᵀ + k · r · kᵀ,   k = P·hᵀ / (h·P·hᵀ + r).
+/// A = (I − k·h)·P is formed in full; multiplying it by (I − k·h)ᵀ is the
+/// rank-1 correction A − (A·hᵀ)·kᵀ, so the cost is O(N²) rather than the
+/// batch update's O(N³). Writes the gain to k. Returns false, leaving P
+/// untouched, when the innovation variance is not positive.
+template <int N>
+inline bool JosephScalarUpdate(SymMatrix<N>& P, const float (&h)[N],
+                               float r, float (&k)[N])
+{
+    float ph[N];   // P·hᵀ, and h·P transposed (P is symmetric)
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        float s = 0.0f;
+        ONSPEED_UNROLL
+        for (int j = 0; j < N; ++j) s += P(i, j) * h[j];
+        ph[i] = s;
+    }
+    float s = r;
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) s += h[i] * ph[i];
+    if (!(s > 0.0f)) return false;
+    const float inv_s = 1.0f / s;
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) k[i] = ph[i] * inv_s;
+
+    FixedMatrix<N, N> A;   // (I − k·h) · P
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = 0; j < N; ++j) A[i][j] = P(i, j) - k[i] * ph[j];
+    }
+    float Ah[N];           // A · hᵀ
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        float t = 0.0f;
+        ONSPEED_UNROLL
+        for (int j = 0; j < N; ++j) t += A[i][j] * h[j];
+        Ah[i] = t;
+    }
+    ONSPEED_UNROLL
+    for (int i = 0; i < N; ++i) {
+        ONSPEED_UNROLL
+        for (int j = i; j < N; ++j) {
+            P.at(i, j) = A[i][j] - Ah[i] * k[j] + k[i] * r * k[j];
+        }
+    }
+    return true;
+}
+
+}  // namespace onspeed::ahrs
+
+#endif  // ONSPEED_CORE_AHRS_FIXED_MATRIX_H
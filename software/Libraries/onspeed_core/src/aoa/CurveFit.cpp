@@ -0,0 +1,262 @@
+// CurveFit.cpp — streaming least-squares calibration curve fit.
+
+#include "CurveFit.h"
+
+#include <cmath>
+
+namespace onspeed::aoa {
+
+namespace {
+
+constexpr int kMaxTerms = kCurveFitMaxOrder + 1;
+
+// Relative pivot floor: below this fraction of the largest matrix entry
+// the system is treated as singular (too few distinct x values).
+constexpr double kPivotEpsilon = 1e-12;
+
+int ClampOrder(int order)
+{
+    return order < 1 ? 1 : order > kCurveFitMaxOrder ? kCurveFitMaxOrder : order;
+}
+
+// Solve the m x m system A·c = b in place (Gaussian elimination with
+// partial pivoting).  False when A is singular to working precision.
+bool SolveLinear(double a[kMaxTerms][kMaxTerms], double b[kMaxTerms], int m, double c[kMaxTerms])
+{
+    double scale = 0.0;
+    for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j)
+            scale = std::fmax(scale, std::fabs(a[i][j]));
+    if (!(scale > 0.0)) return false;
+
+    for (int col = 0; col < m; ++col)
+    {
+        int pivot = col;
+        for (int r = col + 1; r < m; ++r)
+            if (std::fabs(a[r][col]) > std::fabs(a[pivot][col])) pivot = r;
+        if (std::fabs(a[pivot][col]) <= kPivotEpsilon * scale) return false;
+
+        if (pivot != col)
+        {
+            for (int j = 0; j < m; ++j)
+            {
+                const double t = a[col][j]; a[col][j] = a[pivot][j]; a[pivot][j] = t;
+            }
+            const double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+        }
+
+        for (int r = col + 1; r < m; ++r)
+        {
+            const double f = a[r][col] / a[col][col];
+            for (int j = col; j < m; ++j) a[r][j] -= f * a[col][j];
+            b[r] -= f * b[col];
+        }
+    }
+
+    for (int i = m - 1; i >= 0; --i)
+    {
+        double s = b[i];
+        for (int j = i + 1; j < m; ++j) s -= a[i][j] * c[j];
+        c[i] = s / a[i][i];
+    }
+    return true;
+}
+
+}  // namespace
+
+// ============================================================================
+// PolyFitAccumulator
+// ============================================================================
+
+PolyFitAccumulator::PolyFitAccumulator(int order)
+    : order_(ClampOrder(order))
+{
+}
+
+void PolyFitAccumulator::Reset()
+{
+    *this = PolyFitAccumulator(order_);
+}
+
+void PolyFitAccumulator::Add(double x, double y)
+{
+    if (!std::isfinite(x) || !std::isfinite(y)) return;
+
+    if (n_ == 0)
+    {
+        x0_   = x;
+        xMin_ = xMax_ = x;
+    }
+    else
+    {
+        xMin_ = std::fmin(xMin_, x);
+        xMax_ = std::fmax(xMax_, x);
+    }
+    ++n_;
+
+    const double dx = x - x0_;
+    double p = 1.0;
+    for (int k = 0; k <= 2 * order_; ++k)
+    {
+        sxPow_[k] += p;
+        if (k <= order_) sxPowY_[k] += p * y;
+        p *= dx;
+    }
+    sy_  += y;
+    syy_ += y * y;
+}
+
+bool PolyFitAccumulator::Merge(const PolyFitAccumulator& other)
+{
+    if (other.order_ != order_) return false;
+    if (other.n_ == 0) return true;
+    if (n_ == 0)
+    {
+        *this = other;
+        return true;
+    }
+
+    // Binomial shift from origin b to a, d = b − a:
+    // Σ (x − a)^k = Σ_j C(k, j) · d^(k−j) · Σ (x − b)^j.
+    const double d = other.x0_ - x0_;
+    for (int k = 0; k <= 2 * order_; ++k)
+    {
+        double binom = 1.0;            // C(k, j), walked j = k .. 0
+        double shift = 1.0;            // d^(k−j)
+        double sx    = 0.0;
+        double sxy   = 0.0;
+        for (int j = k; j >= 0; --j)
+        {
+            sx += binom * shift * other.sxPow_[j];
+            if (k <= order_) sxy += binom * shift * other.sxPowY_[j];
+            binom = binom * j / (k - j + 1);
+            shift *= d;
+        }
+        sxPow_[k] += sx;
+        if (k <= order_) sxPowY_[k] += sxy;
+    }
+    n_   += other.n_;
+    sy_  += other.sy_;
+    syy_ += other.syy_;
+    xMin_ = std::fmin(xMin_, other.xMin_);
+    xMax_ = std::fmax(xMax_, other.xMax_);
+    return true;
+}
+
+bool PolyFitAccumulator::Solve(CurveFitResult& out) const
+{
+    const int m = order_ + 1;
+    if (n_ < static_cast<uint32_t>(m)) return false;
+
+    double a[kMaxTerms][kMaxTerms];
+    double b[kMaxTerms];
+    double c[kMaxTerms] = {};
+    for (int i = 0; i < m; ++i)
+    {
+        for (int j = 0; j < m; ++j) a[i][j] = sxPow_[i + j];
+        b[i] = sxPowY_[i];
+    }
+    if (!SolveLinear(a, b, m, c)) return false;
+
+    // Residuals from the sums: SSE = Σy² − Σ c_k Σ(dx^k y).
+    double cb = 0.0;
+    for (int k = 0; k < m; ++k) cb += c[k] * sxPowY_[k];
+    const double n   = static_cast<double>(n_);
+    double       sse = syy_ - cb;
+    double       sst = syy_ - sy_ * sy_ / n;
+    if (sse < 0.0) sse = 0.0;
+    if (sst < 0.0) sst = 0.0;
+
+    // Expand Σ c_k (x − x0)^k into plain powers of x:
+    // coeff(x^j) = Σ_{k≥j} c_k · C(k, j) · (−x0)^(k−j).
+    double plain[kMaxTerms] = {};
+    for (int k = 0; k < m; ++k)
+    {
+        double binom = 1.0;            // C(k, j), walked j = k .. 0
+        double shift = 1.0;            // (−x0)^(k−j)
+        for (int j = k; j >= 0; --j)
+        {
+            plain[j] += c[k] * binom * shift;
+            binom = binom * j / (k - j + 1);
+            shift *= -x0_;
+        }
+    }
+
+    CurveFitResult r;
+    r.curve.iCurveType = 1;
+    for (int j = 0; j < MAX_CURVE_COEFF; ++j)
+        r.curve.afCoeff[MAX_CURVE_COEFF - 1 - j] = j < m ? static_cast<float>(plain[j]) : 0.0f;
+    r.sampleCount = n_;
+    r.r2          = sst > 0.0 ? 1.0 - sse / sst : (sse == 0.0 ? 1.0 : 0.0);
+    r.rmse        = std::sqrt(sse / n);
+    r.stdError    = n_ > static_cast<uint32_t>(m) ? std::sqrt(sse / (n - m)) : 0.0;
+    r.xMin        = xMin_;
+    r.xMax        = xMax_;
+    out = r;
+    return true;
+}
+
+// ============================================================================
+// CurveFitBank
+// ============================================================================
+
+CurveFitBank::CurveFitBank(int order, FitWindow window)
+    : window_(window)
+{
+    for (Detent& d : detents_)
+    {
+        d.all    = PolyFitAccumulator(order);
+        d.atPeak = PolyFitAccumulator(order);
+    }
+}
+
+void CurveFitBank::Reset()
+{
+    for (int i = 0; i < MAX_AOA_CURVES; ++i) Reset(i);
+}
+
+void CurveFitBank::Reset(int flapIndex)
+{
+    if (flapIndex < 0 || flapIndex >= MAX_AOA_CURVES) return;
+    Detent& d = detents_[flapIndex];
+    d.all.Reset();
+    d.atPeak.Reset();
+    d.peakX   = 0.0;
+    d.hasPeak = false;
+}
+
+void CurveFitBank::Add(int flapIndex, float coeffP, float aoaDeg)
+{
+    if (flapIndex < 0 || flapIndex >= MAX_AOA_CURVES) return;
+    if (!std::isfinite(coeffP) || !std::isfinite(aoaDeg)) return;
+
+    Detent& d = detents_[flapIndex];
+    d.all.Add(coeffP, aoaDeg);
+    if (window_ == FitWindow::UpToPeakX && (!d.hasPeak || coeffP > d.peakX))
+    {
+        d.peakX   = coeffP;
+        d.hasPeak = true;
+        d.atPeak  = d.all;
+    }
+}
+
+const PolyFitAccumulator* CurveFitBank::Fit(int flapIndex) const
+{
+    if (flapIndex < 0 || flapIndex >= MAX_AOA_CURVES) return nullptr;
+    const Detent& d = detents_[flapIndex];
+    return window_ == FitWindow::UpToPeakX ? &d.atPeak : &d.all;
+}
+
+bool CurveFitBank::Solve(int flapIndex, CurveFitResult& out) const
+{
+    const PolyFitAccumulator* fit = Fit(flapIndex);
+    return fit != nullptr && fit->Solve(out);
+}
+
+double CurveFitBank::PeakX(int flapIndex) const
+{
+    if (flapIndex < 0 || flapIndex >= MAX_AOA_CURVES) return 0.0;
+    return detents_[flapIndex].peakX;
+}
+
+}   // namespace onspeed::aoa
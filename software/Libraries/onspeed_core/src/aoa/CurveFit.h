@@ -0,0 +1,144 @@
+// CurveFit.h — streaming least-squares fit of the CoeffP → AOA curve.
+//
+// The calibration wizard fits AOA = a2*CP^2 + a1*CP + a0 over one decel
+// run per flap detent.  Doing that in the browser means recording every
+// sample and shipping the array over WiFi first.  This module does the
+// fit incrementally: each sample folds into the normal-equation sums in
+// O(order) time and O(1) memory, so a fit is available at any moment at
+// sensor rate, without keeping the run.
+//
+// Consumers: host_main recalibrate (tools/regression), which refits
+// every detent over whole logs, and the cal wizard's decel run
+// (DecelRunFit.h), which the firmware fits as it is flown.  Both
+// truncate at the stall: CurveFitBank at the CP peak per detent,
+// DecelRunFit at the smoothed-CP peak of the run.
+//
+//   PolyFitAccumulator  normal-equation sums for one polynomial fit.
+//                       Solve() yields a SuCalibrationCurve (type 1,
+//                       [a3, a2, a1, a0] as CurveCalc evaluates it) plus
+//                       residual statistics.  Merge() combines fits
+//                       built separately (per log file, per thread).
+//   CurveFitBank        one accumulator per flap detent.  With
+//                       FitWindow::UpToPeakX it fits only the samples up
+//                       to the largest CP seen on that detent — the
+//                       wizard's "truncate at the stall" rule — by
+//                       snapshotting the sums each time CP sets a new
+//                       maximum.
+//
+// Conditioning: powers are accumulated about the first sample's x, so
+// the sums stay well scaled when CP sits far from zero; Solve() expands
+// the polynomial back to plain powers of x.  The (order+1)^2 system is
+// solved by Gaussian elimination with partial pivoting in double.
+//
+// Residual statistics come from the same sums (SSE = Σy² − cᵀb), so no
+// sample is ever stored.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_AOA_CURVE_FIT_H
+#define ONSPEED_CORE_AOA_CURVE_FIT_H
+
+#include <cstdint>
+
+#include <util/OnSpeedTypes.h>
+
+namespace onspeed::aoa {
+
+// Highest polynomial order SuCalibrationCurve can hold (cubic).
+inline constexpr int kCurveFitMaxOrder = MAX_CURVE_COEFF - 1;
+
+// Order the calibration wizard fits.
+inline constexpr int kCurveFitWizardOrder = 2;
+
+struct CurveFitResult {
+    SuCalibrationCurve curve{};        // iCurveType 1; unused high-order terms 0
+    uint32_t           sampleCount = 0;
+    double             r2          = 0.0;   // 1 − SSE/SST; 1 when SST is 0 and the fit is exact
+    double             rmse        = 0.0;   // sqrt(SSE / n), degrees
+    double             stdError    = 0.0;   // sqrt(SSE / (n − order − 1)); 0 when n == order + 1
+    double             xMin        = 0.0;   // fitted CP domain
+    double             xMax        = 0.0;
+};
+
+class PolyFitAccumulator
+{
+public:
+    // `order` is clamped to [1, kCurveFitMaxOrder].
+    explicit PolyFitAccumulator(int order = kCurveFitWizardOrder);
+
+    void Reset();
+
+    // Fold in one (x, y) sample.  Non-finite samples are ignored.
+    void Add(double x, double y);
+
+    // Fold in every sample `other` has seen, as if each had been Add()ed
+    // here.  Its sums are re-centred onto this accumulator's origin, so
+    // partial fits built on separate threads or log segments combine
+    // exactly.  False (nothing merged) when the orders differ.
+    bool Merge(const PolyFitAccumulator& other);
+
+    // Least-squares solve.  False (and `out` untouched) with fewer than
+    // order + 1 samples or when the x values cannot determine the
+    // polynomial (e.g. fewer distinct x values than coefficients).
+    bool Solve(CurveFitResult& out) const;
+
+    int      Order()       const { return order_; }
+    uint32_t SampleCount() const { return n_; }
+
+private:
+    static constexpr int kMaxPow = 2 * kCurveFitMaxOrder;
+
+    int      order_;
+    uint32_t n_ = 0;
+    double   x0_ = 0.0;                          // shift origin (first sample)
+    double   sxPow_[kMaxPow + 1] = {};           // Σ (x − x0)^k, k = 0 .. 2*order
+    double   sxPowY_[kCurveFitMaxOrder + 1] = {};// Σ (x − x0)^k · y
+    double   sy_  = 0.0;
+    double   syy_ = 0.0;
+    double   xMin_ = 0.0;
+    double   xMax_ = 0.0;
+};
+
+enum class FitWindow : uint8_t {
+    All,         // every sample
+    UpToPeakX,   // samples up to (and including) the largest x per detent
+};
+
+class CurveFitBank
+{
+public:
+    explicit CurveFitBank(int order = kCurveFitWizardOrder, FitWindow window = FitWindow::All);
+
+    void Reset();
+    void Reset(int flapIndex);
+
+    // Fold a (CoeffP, AOA) sample into detent `flapIndex`.  Samples with
+    // an out-of-range index or non-finite values are ignored.
+    void Add(int flapIndex, float coeffP, float aoaDeg);
+
+    bool Solve(int flapIndex, CurveFitResult& out) const;
+
+    // The accumulator Solve() uses for `flapIndex` (the peak snapshot
+    // under FitWindow::UpToPeakX); nullptr when out of range.
+    const PolyFitAccumulator* Fit(int flapIndex) const;
+
+    // Largest x seen on `flapIndex` (UpToPeakX only; 0 before any sample).
+    double PeakX(int flapIndex) const;
+
+    FitWindow Window() const { return window_; }
+
+private:
+    struct Detent {
+        PolyFitAccumulator all;
+        PolyFitAccumulator atPeak;
+        double             peakX   = 0.0;
+        bool               hasPeak = false;
+    };
+
+    Detent    detents_[MAX_AOA_CURVES];
+    FitWindow window_;
+};
+
+}   // namespace onspeed::aoa
+
+#endif  // ONSPEED_CORE_AOA_CURVE_FIT_H
@@ -0,0 +1,122 @@
+// DecelRunFit.cpp — the calibration wizard's decel-run fits, streamed.
+
+#include "DecelRunFit.h"
+
+#include <cmath>
+
+namespace onspeed::aoa {
+
+namespace {
+
+// The wizard's smoothing weights on the newest sample.
+constexpr double kIasWeight = 0.98;
+constexpr double kCpWeight  = 0.90;
+
+// A 1/IAS² fit with |K| below this, or fewer points, is degenerate.
+constexpr double   kMinAbsK        = 1e-6;
+constexpr uint32_t kMinIasAoaCount = 5;
+
+}  // namespace
+
+DecelRunFit::DecelRunFit()
+{
+    Reset();
+}
+
+void DecelRunFit::Reset()
+{
+    n_       = 0;
+    invalid_ = false;
+    sIas_    = 0.0;
+    sCp_     = 0.0;
+    all_     = Fits{};
+    atStall_ = Fits{};
+    stallIndex_     = 0;
+    stallCp_        = 0.0;
+    stallIas_       = 0.0;
+    stallFlapIndex_ = 0;
+    stallFlapsPos_  = 0;
+}
+
+void DecelRunFit::Add(const DecelRunSample& s)
+{
+    const uint32_t i = n_++;
+    if (!std::isfinite(s.iasKt) || !std::isfinite(s.coeffP))
+    {
+        invalid_ = true;
+        return;
+    }
+
+    if (i == 0)
+    {
+        sIas_ = s.iasKt;
+        sCp_  = s.coeffP;
+    }
+    else
+    {
+        sIas_ = s.iasKt  * kIasWeight + sIas_ * (1.0 - kIasWeight);
+        sCp_  = s.coeffP * kCpWeight  + sCp_  * (1.0 - kCpWeight);
+    }
+
+    all_.iasTrend.Add(static_cast<double>(i), s.iasKt);
+    all_.cpToAoa.Add(sCp_, s.derivedAoaDeg);
+    if (s.iasKt > 0.0f)
+    {
+        const double ias = s.iasKt;
+        all_.iasToAoa.Add(1.0 / (ias * ias), s.derivedAoaDeg);
+    }
+
+    // The first sample only seeds the EMAs; it cannot be the stall.
+    if (i > 0 && sCp_ > stallCp_)
+    {
+        stallIndex_     = i;
+        stallCp_        = sCp_;
+        stallIas_       = sIas_;
+        stallFlapIndex_ = s.flapIndex;
+        stallFlapsPos_  = s.flapsPosDeg;
+        atStall_        = all_;
+    }
+}
+
+DecelRunResult DecelRunFit::Result() const
+{
+    DecelRunResult r;
+    r.sampleCount = n_;
+
+    if (n_ < kDecelRunMinSamples) { r.status = DecelRunStatus::TooFewSamples;  return r; }
+    if (invalid_)                 { r.status = DecelRunStatus::InvalidAirData; return r; }
+    if (!(stallCp_ > 0.0))        { r.status = DecelRunStatus::NoStall;        return r; }
+
+    CurveFitResult trend;
+    if (!atStall_.iasTrend.Solve(trend) || !(trend.curve.afCoeff[2] < 0.0f))
+    {
+        r.status = DecelRunStatus::AirspeedIncreasing;
+        return r;
+    }
+
+    CurveFitResult physics;
+    CurveFitResult cp;
+    if (atStall_.iasToAoa.SampleCount() < kMinIasAoaCount
+        || !atStall_.iasToAoa.Solve(physics)
+        || std::fabs(physics.curve.afCoeff[2]) < kMinAbsK
+        || !atStall_.cpToAoa.Solve(cp))
+    {
+        r.status = DecelRunStatus::TooThin;
+        return r;
+    }
+
+    r.status        = DecelRunStatus::Ok;
+    r.stallIndex    = stallIndex_;
+    r.stallIasKt    = stallIas_;
+    r.stallCp       = stallCp_;
+    r.flapIndex     = stallFlapIndex_;
+    r.flapsPosDeg   = stallFlapsPos_;
+    r.kFit          = physics.curve.afCoeff[2];
+    r.alpha0Deg     = physics.curve.afCoeff[3];
+    r.alphaStallDeg = r.kFit / (stallIas_ * stallIas_) + r.alpha0Deg;
+    r.iasToAoaR2    = physics.r2;
+    r.cpToAoa       = cp;
+    return r;
+}
+
+}   // namespace onspeed::aoa
@@ -0,0 +1,121 @@
+// DecelRunFit.h — the calibration wizard's decel-run fits, streamed.
+//
+// The wizard records one decel run per flap detent, from cruise down
+// to the stall, and derives a detent's calibration from three fits:
+//
+//   IAS trend   IAS against sample index, linear.  A rising trend means
+//               the pilot flew the run backwards; the run is rejected.
+//   CP → AOA    DerivedAOA = a2·CP² + a1·CP + a0 over the smoothed CP;
+//               saved as the detent's curve (afCoeff[1..3]).
+//   1/IAS²      DerivedAOA = K/IAS² + alpha_0 (the lift equation); K and
+//               alpha_0 place the setpoints.
+//
+// All three stop at the stall: the sample where the smoothed CP peaks.
+// Recovery samples after it (IAS climbing, AOA falling) are not part of
+// the fit.  Smoothing is the wizard's: EMAs with weight 0.98 on IAS and
+// 0.90 on CP, per sample, so samples must arrive at the rate the
+// wizard's constants were chosen for (the 20 Hz live-data tick).
+//
+// Each sample folds into PolyFitAccumulators (CurveFit.h), and the
+// accumulators are snapshotted whenever the smoothed CP sets a new
+// peak, so a result is available at any moment without keeping the
+// run.  The firmware feeds this from the live-data tick while the
+// wizard is recording (web_server/CalwizRecorder.cpp) and returns
+// Result() from the calwiz API; CalWizardPage.js turns it into
+// setpoints.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_AOA_DECEL_RUN_FIT_H
+#define ONSPEED_CORE_AOA_DECEL_RUN_FIT_H
+
+#include <cstdint>
+
+#include <aoa/CurveFit.h>
+
+namespace onspeed::aoa {
+
+// Why Result() has no fit.  Checked in this order.
+enum class DecelRunStatus : uint8_t {
+    Ok,
+    TooFewSamples,        // fewer than kDecelRunMinSamples samples
+    InvalidAirData,       // a sample carried non-finite IAS or CP
+    NoStall,              // smoothed CP never rose above 0
+    AirspeedIncreasing,   // IAS trend up to the stall is not falling
+    TooThin,              // 1/IAS² fit degenerate (K ≈ 0 or < 5 points)
+};
+
+// Shortest run the wizard will fit.
+inline constexpr uint32_t kDecelRunMinSamples = 50;
+
+struct DecelRunSample {
+    float iasKt         = 0.0f;
+    float coeffP        = 0.0f;
+    float derivedAoaDeg = 0.0f;
+    int   flapsPosDeg   = 0;
+    int   flapIndex     = 0;
+};
+
+struct DecelRunResult {
+    DecelRunStatus status      = DecelRunStatus::TooFewSamples;
+    uint32_t       sampleCount = 0;
+
+    // The stall sample (zero-based index into the run) and its smoothed
+    // values, flap detent and flap angle.
+    uint32_t stallIndex  = 0;
+    double   stallIasKt  = 0.0;
+    double   stallCp     = 0.0;
+    int      flapIndex   = 0;
+    int      flapsPosDeg = 0;
+
+    // 1/IAS² fit.  alphaStallDeg = K/stallIas² + alpha_0.
+    double kFit          = 0.0;
+    double alpha0Deg     = 0.0;
+    double alphaStallDeg = 0.0;
+    double iasToAoaR2    = 0.0;
+
+    // CP → AOA fit (iCurveType 1, [0, a2, a1, a0]).
+    CurveFitResult cpToAoa{};
+};
+
+class DecelRunFit
+{
+public:
+    DecelRunFit();
+
+    // Start a new run.
+    void Reset();
+
+    // Fold in the next sample of the run.
+    void Add(const DecelRunSample& s);
+
+    // The fits up to the stall so far.  Every field but status and
+    // sampleCount is 0 unless status is Ok.
+    DecelRunResult Result() const;
+
+    uint32_t SampleCount() const { return n_; }
+
+private:
+    struct Fits {
+        PolyFitAccumulator iasTrend{1};   // IAS against sample index
+        PolyFitAccumulator cpToAoa{kCurveFitWizardOrder};
+        PolyFitAccumulator iasToAoa{1};   // AOA against 1/IAS²
+    };
+
+    uint32_t n_        = 0;
+    bool     invalid_  = false;
+    double   sIas_     = 0.0;   // EMAs
+    double   sCp_      = 0.0;
+
+    Fits     all_;
+    Fits     atStall_;          // all_ as of the stall sample
+    uint32_t stallIndex_  = 0;
+    double   stallCp_     = 0.0;   // 0 = no stall yet
+    double   stallIas_    = 0.0;
+    int      stallFlapIndex_ = 0;
+    int      stallFlapsPos_  = 0;
+};
+
+}   // namespace onspeed::aoa
+
+#endif  // ONSPEED_CORE_AOA_DECEL_RUN_FIT_H
@@ -0,0 +1,88 @@
+// CalwizFitJson.cpp — JSON serializer for the calwiz decel-run fit.
+
+#include "CalwizFitJson.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace onspeed::api {
+
+using onspeed::aoa::DecelRunResult;
+using onspeed::aoa::DecelRunStatus;
+
+namespace {
+
+void AppendDouble(std::string& out, double v) {
+    char buf[32];
+    if (!std::isfinite(v)) v = 0.0;
+    std::snprintf(buf, sizeof(buf), "%.9g", v);
+    out += buf;
+}
+
+void AppendUnsigned(std::string& out, unsigned long v) {
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%lu", v);
+    out += buf;
+}
+
+void AppendInt(std::string& out, int v) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%d", v);
+    out += buf;
+}
+
+}  // namespace
+
+const char* CalwizFitStatusName(DecelRunStatus status) {
+    switch (status) {
+        case DecelRunStatus::Ok:                 return "ok";
+        case DecelRunStatus::TooFewSamples:      return "tooFewSamples";
+        case DecelRunStatus::InvalidAirData:     return "invalidAirData";
+        case DecelRunStatus::NoStall:            return "noStall";
+        case DecelRunStatus::AirspeedIncreasing: return "airspeedIncreasing";
+        case DecelRunStatus::TooThin:            return "tooThin";
+    }
+    return "tooFewSamples";
+}
+
+std::string SerializeCalwizFit(const DecelRunResult& fit, bool recording) {
+    std::string out;
+    out.reserve(384);
+
+    out += "{\"recording\":";
+    out += recording ? "true" : "false";
+    out += ",\"sampleCount\":";
+    AppendUnsigned(out, fit.sampleCount);
+    out += ",\"status\":\"";
+    out += CalwizFitStatusName(fit.status);
+    out += "\",\"stallIndex\":";
+    AppendUnsigned(out, fit.stallIndex);
+    out += ",\"stallIasKt\":";
+    AppendDouble(out, fit.stallIasKt);
+    out += ",\"stallCp\":";
+    AppendDouble(out, fit.stallCp);
+    out += ",\"flapIndex\":";
+    AppendInt(out, fit.flapIndex);
+    out += ",\"flapsPosDeg\":";
+    AppendInt(out, fit.flapsPosDeg);
+    out += ",\"kFit\":";
+    AppendDouble(out, fit.kFit);
+    out += ",\"alpha0Deg\":";
+    AppendDouble(out, fit.alpha0Deg);
+    out += ",\"alphaStallDeg\":";
+    AppendDouble(out, fit.alphaStallDeg);
+    out += ",\"iasToAoaR2\":";
+    AppendDouble(out, fit.iasToAoaR2);
+    out += ",\"curve0\":";
+    AppendDouble(out, fit.cpToAoa.curve.afCoeff[1]);
+    out += ",\"curve1\":";
+    AppendDouble(out, fit.cpToAoa.curve.afCoeff[2]);
+    out += ",\"curve2\":";
+    AppendDouble(out, fit.cpToAoa.curve.afCoeff[3]);
+    out += ",\"cpToAoaR2\":";
+    AppendDouble(out, fit.cpToAoa.r2);
+    out += '}';
+    return out;
+}
+
+}  // namespace onspeed::api
@@ -0,0 +1,38 @@
+// CalwizFitJson.h
+//
+// JSON serializer for the calibration wizard's decel-run fit, returned
+// by POST /api/calwiz/record, POST /api/calwiz/record/stop and
+// GET /api/calwiz/fit:
+//
+//   recording, sampleCount, status
+//   stallIndex, stallIasKt, stallCp, flapIndex, flapsPosDeg
+//   kFit, alpha0Deg, alphaStallDeg, iasToAoaR2
+//   curve0, curve1, curve2, cpToAoaR2
+//
+// status is "ok" or the reason there is no fit (tooFewSamples,
+// invalidAirData, noStall, airspeedIncreasing, tooThin); every field
+// after it is 0 unless status is "ok".  curve0..2 are the CP → AOA
+// coefficients [a2, a1, a0], named as POST /api/calwiz/save takes them.
+//
+// Pure host-runnable helper; no Arduino, no globals.
+
+#ifndef ONSPEED_CORE_API_CALWIZ_FIT_JSON_H
+#define ONSPEED_CORE_API_CALWIZ_FIT_JSON_H
+
+#include <string>
+
+#include "../aoa/DecelRunFit.h"
+
+namespace onspeed::api {
+
+// The status string SerializeCalwizFit emits for `status`.
+const char* CalwizFitStatusName(onspeed::aoa::DecelRunStatus status);
+
+// Serialize the fit.  Floats use %.9g so K and the curve coefficients
+// round-trip to the float the save path stores; non-finite values are
+// emitted as 0.
+std::string SerializeCalwizFit(const onspeed::aoa::DecelRunResult& fit, bool recording);
+
+}  // namespace onspeed::api
+
+#endif  // ONSPEED_CORE_API_CALWIZ_FIT_JSON_H
@@ -45,8 +45,8 @@ struct CalwizSaveInput {
     float alphaStallDeg     = 0.0f;
     float kFit              = 0.0f;
 
-    // Polynomial coefficients of the legacy CP→AOA fit (regression.js
-    // `equation` array, order 2).  Stored into afCoeff[1..3]; afCoeff[0]
+    // Polynomial coefficients of the CP→AOA fit (aoa/DecelRunFit.h,
+    // order 2, highest power first).  Stored into afCoeff[1..3]; afCoeff[0]
     // is hardcoded 0 to match the legacy sequence.
     float curve0 = 0.0f;  ///< quadratic coefficient (a2)
     float curve1 = 0.0f;  ///< linear coefficient    (a1)
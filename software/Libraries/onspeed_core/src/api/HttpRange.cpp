@@ -0,0 +1,146 @@
+// HttpRange.cpp
+
+#include <api/HttpRange.h>
+
+#include <cstdio>
+#include <cstring>
+
+namespace onspeed::api {
+
+namespace {
+
+std::string_view Trim(std::string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back()  == ' ' || s.back()  == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+// Unsigned decimal with no sign, no whitespace and no overflow.
+bool ParseDecimal(std::string_view s, uint64_t* out)
+{
+    if (s.empty() || s.size() > 19) return false;   // 19 digits always fit
+    uint64_t v = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9') return false;
+        v = v * 10 + static_cast<uint64_t>(c - '0');
+    }
+    *out = v;
+    return true;
+}
+
+// 32-bit FNV-1a; enough to separate sessions that share a name and size.
+uint32_t Fnv1a(uint32_t h, const void* data, size_t len)
+{
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+uint32_t Fnv1aStr(uint32_t h, const char* s)
+{
+    // Include the terminator so ("ab","c") and ("a","bc") differ.
+    return Fnv1a(h, s, std::strlen(s) + 1);
+}
+
+size_t Finish(int n, char* buf, size_t bufLen)
+{
+    if (n < 0 || static_cast<size_t>(n) >= bufLen) {
+        buf[0] = '\0';
+        return 0;
+    }
+    return static_cast<size_t>(n);
+}
+
+} // namespace
+
+RangeRequest ParseRangeHeader(std::string_view header, uint64_t size, ByteRange* out)
+{
+    header = Trim(header);
+    constexpr std::string_view kUnit = "bytes=";
+    if (header.size() <= kUnit.size()) return RangeRequest::None;
+    for (size_t i = 0; i < kUnit.size(); ++i) {
+        char c = header[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != kUnit[i]) return RangeRequest::None;
+    }
+    std::string_view spec = Trim(header.substr(kUnit.size()));
+    if (spec.find(',') != std::string_view::npos) return RangeRequest::None;
+
+    const size_t dash = spec.find('-');
+    if (dash == std::string_view::npos) return RangeRequest::None;
+    const std::string_view firstStr = Trim(spec.substr(0, dash));
+    const std::string_view lastStr  = Trim(spec.substr(dash + 1));
+
+    ByteRange r;
+    if (firstStr.empty()) {
+        // Suffix range: the final n bytes.
+        uint64_t n = 0;
+        if (!ParseDecimal(lastStr, &n)) return RangeRequest::None;
+        if (n == 0 || size == 0) return RangeRequest::Unsatisfiable;
+        r.first = (n >= size) ? 0 : size - n;
+        r.last  = size - 1;
+    } else {
+        if (!ParseDecimal(firstStr, &r.first)) return RangeRequest::None;
+        if (lastStr.empty()) {
+            r.last = (size > 0) ? size - 1 : 0;
+        } else {
+            if (!ParseDecimal(lastStr, &r.last)) return RangeRequest::None;
+            if (r.last < r.first) return RangeRequest::None;
+            if (size > 0 && r.last >= size) r.last = size - 1;
+        }
+        if (r.first >= size) return RangeRequest::Unsatisfiable;
+    }
+
+    if (out) *out = r;
+    return RangeRequest::Partial;
+}
+
+bool IfRangeMatches(std::string_view ifRange, std::string_view etag)
+{
+    ifRange = Trim(ifRange);
+    if (ifRange.empty()) return true;
+    // Weak validators can't be used with If-Range (RFC 9110 13.1.5).
+    if (ifRange.size() >= 2 && ifRange[0] == 'W' && ifRange[1] == '/') return false;
+    return ifRange == etag;
+}
+
+size_t FormatDownloadETag(const char* name, uint64_t size,
+                          const onspeed::log::LogMeta* meta,
+                          char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    uint32_t h = 2166136261u;
+    h = Fnv1aStr(h, name ? name : "");
+    if (meta) {
+        h = Fnv1aStr(h, meta->utcStart);
+        h = Fnv1aStr(h, meta->timeOfDayStart);
+        h = Fnv1aStr(h, meta->firmwareSha);
+        h = Fnv1a(h, &meta->rowCount,   sizeof(meta->rowCount));
+        h = Fnv1a(h, &meta->durationMs, sizeof(meta->durationMs));
+    }
+    return Finish(std::snprintf(buf, bufLen, "\"%llx-%08lx\"",
+                                static_cast<unsigned long long>(size),
+                                static_cast<unsigned long>(h)),
+                  buf, bufLen);
+}
+
+size_t FormatContentRange(const ByteRange* range, uint64_t size,
+                          char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    if (range == nullptr)
+        return Finish(std::snprintf(buf, bufLen, "bytes */%llu",
+                                    static_cast<unsigned long long>(size)),
+                      buf, bufLen);
+    return Finish(std::snprintf(buf, bufLen, "bytes %llu-%llu/%llu",
+                                static_cast<unsigned long long>(range->first),
+                                static_cast<unsigned long long>(range->last),
+                                static_cast<unsigned long long>(size)),
+                  buf, bufLen);
+}
+
+} // namespace onspeed::api
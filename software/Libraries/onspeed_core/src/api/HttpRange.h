@@ -0,0 +1,71 @@
+// HttpRange.h
+//
+// Pure helpers for byte-range downloads from GET /download (RFC 9110
+// Range / 206 Partial Content / If-Range).  The firmware handler in
+// ConfigWebServer.cpp reads the request headers, calls these to decide
+// what to send, and streams the selected slice of the SD file; the web
+// UI's resumable downloader (tools/web/lib/shell/rangeDownload.js) is
+// the matching client.
+//
+// Scope is what a resuming downloader needs: a single range per request
+// (`bytes=a-b`, `bytes=a-`, `bytes=-n`).  A multi-range request is
+// answered with the whole file, which RFC 9110 permits.
+//
+// The validator is a strong ETag over the file name, size and the
+// session's LogMeta.  The box has no RTC, so FAT timestamps can't tell
+// two versions of a file apart; a log is append-only and its .meta
+// (start time, firmware SHA, row count) pins which session produced it,
+// so those are what change whenever the bytes change.
+
+#ifndef ONSPEED_CORE_API_HTTP_RANGE_H
+#define ONSPEED_CORE_API_HTTP_RANGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <log/LogMeta.h>
+
+namespace onspeed::api {
+
+/// Inclusive byte range [first, last] within a file.
+struct ByteRange {
+    uint64_t first = 0;
+    uint64_t last  = 0;
+
+    uint64_t Length() const { return last - first + 1; }
+};
+
+enum class RangeRequest {
+    None,           ///< no usable Range header: send the whole file (200)
+    Partial,        ///< send *out with 206
+    Unsatisfiable,  ///< send 416 with Content-Range: bytes */size
+};
+
+/// Interpret a Range header value against a file of `size` bytes.
+/// Absent (empty), malformed, non-"bytes" and multi-range values yield
+/// None.  `bytes=a-` and `bytes=-n` are clamped to the file; a range that
+/// starts at or past EOF (or any range on an empty file) is
+/// Unsatisfiable.
+RangeRequest ParseRangeHeader(std::string_view header, uint64_t size, ByteRange* out);
+
+/// True when an If-Range value lets a Range request proceed: absent
+/// (empty) or byte-equal to the current strong ETag.  HTTP-date values
+/// never match, since the box has no trustworthy clock.
+bool IfRangeMatches(std::string_view ifRange, std::string_view etag);
+
+/// Write the strong ETag (including its quotes) for `name` at `size`
+/// bytes, folding in `meta` when non-null.  Returns the length, or 0 if
+/// `bufLen` is too small (buf[0] = NUL).  32 bytes is always enough.
+size_t FormatDownloadETag(const char* name, uint64_t size,
+                          const onspeed::log::LogMeta* meta,
+                          char* buf, size_t bufLen);
+
+/// Content-Range value: "bytes first-last/size" for a 206, or
+/// "bytes */size" when `range` is null (416).  Same return convention.
+size_t FormatContentRange(const ByteRange* range, uint64_t size,
+                          char* buf, size_t bufLen);
+
+} // namespace onspeed::api
+
+#endif // ONSPEED_CORE_API_HTTP_RANGE_H
@@ -9,7 +9,9 @@
 // the same set of names.
 //
 // Adding or removing a key requires updating all three.  The native
-// test in test/test_data_server_json/ catches the mismatch.
+// test in test/test_data_server_json/ catches the mismatch.  The binary
+// frame (proto/LiveDataBin.h) carries the same fields and needs a version
+// bump too; tools/web/test/wsclient.mjs checks its decoded key set.
 
 #ifndef ONSPEED_CORE_API_LIVE_DATA_JSON_KEYS_H
 #define ONSPEED_CORE_API_LIVE_DATA_JSON_KEYS_H
@@ -20,6 +20,9 @@ inline std::int16_t ScaleAndClampI16(std::int16_t sample, float scale) {
     return ClampI32ToI16(scaled);
 }
 
+// Oscillator sources are rendered through a stack buffer this long.
+constexpr std::size_t kOscillatorChunk = 240;
+
 }   // namespace
 
 std::uint32_t PackStereoI16(std::int16_t left, std::int16_t right) {
@@ -31,7 +34,25 @@ void Mix(const MixerInputs& inputs,
          std::int16_t* outStereo,
          std::size_t frameCount,
          MixerState& state) {
-    if (inputs.in == nullptr || outStereo == nullptr || frameCount == 0)
+    if (outStereo == nullptr || frameCount == 0)
+        return;
+
+    if (inputs.oscillator != nullptr) {
+        std::int16_t carrier[kOscillatorChunk];
+        MixerInputs  chunk = inputs;
+        chunk.oscillator   = nullptr;
+        chunk.in           = carrier;
+        for (std::size_t done = 0; done < frameCount; ) {
+            const std::size_t n = frameCount - done < kOscillatorChunk
+                                    ? frameCount - done : kOscillatorChunk;
+            inputs.oscillator->Render(carrier, n);
+            Mix(chunk, outStereo + 2 * done, n, state);
+            done += n;
+        }
+        return;
+    }
+
+    if (inputs.in == nullptr)
         return;
 
     const bool useEnvelope = (inputs.envelope != nullptr);
@@ -1,9 +1,10 @@
 // AudioMixer.h — stereo PCM mixer with per-channel gain, pan, optional
 // pulse-gate modulation, and optional DAHDR envelope shaping.
 //
-// Takes a mono int16 PCM input (either a synthesized tone buffer from
-// ToneSynth or a voice-prompt PCM asset from WavDecode) and produces
-// stereo interleaved int16 output after applying:
+// Takes a mono int16 PCM input (a synthesized tone buffer, or a voice
+// prompt chunk from VoiceCodec) — or renders one on the fly from an
+// Oscillator — and produces stereo interleaved int16 output after
+// applying:
 //
 //   gate = envelope ? envelope.Tick()
 //                   : pulseGate(i)               // legacy fallback
@@ -37,15 +38,22 @@
 #include <cstdint>
 
 #include "Envelope.h"
+#include "Oscillator.h"
 #include "ToneSynth.h"   // PulseGateSpec / PulseGateState
 
 namespace onspeed::audio {
 
 // Per-call inputs to AudioMixer::Mix().
 struct MixerInputs {
-    // Mono PCM source samples.  Must be non-null if frameCount > 0.
+    // Mono PCM source samples.  Must be non-null if frameCount > 0,
+    // unless `oscillator` is set.
     const int16_t* in = nullptr;
 
+    // Live tone source.  When non-null, Mix() renders the carrier from
+    // it (advancing its phase and any glide) and ignores `in`, so a
+    // tone chunk needs no source buffer and no transcendental calls.
+    Oscillator* oscillator = nullptr;
+
     // Per-channel scale factors (0.0 = silent, 1.0 = unity).  Caller
     // composes from (masterVolume * stallVolMult * channelGain * panFactor)
     // and is responsible for clipping protection (cap each at 1.0).
@@ -72,8 +80,9 @@ struct MixerState {
 // Mix `frameCount` mono input samples into `outStereo` (2 * frameCount
 // int16 values, interleaved L,R).  Updates `state` for pulse continuity.
 //
-// If `in == nullptr` or `frameCount == 0`, the output is left untouched
-// and state is not advanced.
+// If there is no source (`in` and `oscillator` both null) or
+// `frameCount == 0`, the output is left untouched and state is not
+// advanced.
 void Mix(const MixerInputs& inputs,
          int16_t* outStereo,
          std::size_t frameCount,
@@ -0,0 +1,79 @@
+// Oscillator.cpp — fixed-point phase-accumulator oscillator implementation.
+
+#include "Oscillator.h"
+
+#include <cstdint>
+
+namespace onspeed::audio {
+
+namespace {
+
+// Phase bit layout: [31:30] quadrant, [29:22] table index, [21:7] the
+// 15-bit interpolation fraction, [6:0] dropped.
+constexpr int           kQuadrantShift = 30;
+constexpr std::uint32_t kQuadrantMask  = (1u << kQuadrantShift) - 1;
+constexpr int           kIndexShift    = kQuadrantShift - kSineQuarterBits;
+constexpr int           kFracShift     = kIndexShift - 15;
+
+// Largest increment: just under half a cycle per sample (Nyquist).
+constexpr std::uint32_t kMaxIncrement = 0x7FFFFFFFu;
+
+}   // namespace
+
+std::int16_t SineQ15(std::uint32_t phase) {
+    const std::uint32_t quadrant = phase >> kQuadrantShift;
+    std::uint32_t pos = phase & kQuadrantMask;
+    // Quadrants 1 and 3 run the table backwards.
+    if (quadrant & 1u)
+        pos = (1u << kQuadrantShift) - pos;
+
+    const std::uint32_t idx  = pos >> kIndexShift;   // 0..kSineQuarterSize
+    const std::int32_t  frac = static_cast<std::int32_t>((pos >> kFracShift) & 0x7FFFu);
+    const std::int32_t  a    = kSineQuarterTable[idx];
+    const std::int32_t  b    = idx < kSineQuarterSize ? kSineQuarterTable[idx + 1] : a;
+    const std::int32_t  v    = a + (((b - a) * frac + 0x4000) >> 15);
+
+    return static_cast<std::int16_t>(quadrant & 2u ? -v : v);
+}
+
+std::uint32_t PhaseIncrement(float frequencyHz, int sampleRateHz) {
+    if (!(frequencyHz > 0.0f) || sampleRateHz <= 0)
+        return 0;
+    const double inc = static_cast<double>(frequencyHz) * 4294967296.0 /
+                       static_cast<double>(sampleRateHz);
+    if (inc >= static_cast<double>(kMaxIncrement))
+        return kMaxIncrement;
+    return static_cast<std::uint32_t>(inc + 0.5);
+}
+
+void Oscillator::SetFrequency(float frequencyHz, int sampleRateHz, std::uint32_t glideSamples) {
+    m_target = PhaseIncrement(frequencyHz, sampleRateHz);
+    const std::int64_t targetQ16 = static_cast<std::int64_t>(m_target) << 16;
+    if (glideSamples == 0 || targetQ16 == m_incrementQ16) {
+        m_incrementQ16 = targetQ16;
+        m_glideStepQ16 = 0;
+        m_glideLeft    = 0;
+        return;
+    }
+    m_glideStepQ16 = (targetQ16 - m_incrementQ16) / static_cast<std::int64_t>(glideSamples);
+    m_glideLeft    = glideSamples;
+}
+
+void Oscillator::Render(std::int16_t* out, std::size_t sampleCount) {
+    if (out == nullptr)
+        return;
+    const std::int32_t amp = m_amplitude;
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        out[i] = static_cast<std::int16_t>((CosineQ15(m_phase) * amp) >> 15);
+        m_phase += static_cast<std::uint32_t>(m_incrementQ16 >> 16);
+
+        if (m_glideLeft > 0) {
+            // Land exactly on the target; the per-sample step truncates.
+            m_incrementQ16 = (--m_glideLeft == 0)
+                               ? static_cast<std::int64_t>(m_target) << 16
+                               : m_incrementQ16 + m_glideStepQ16;
+        }
+    }
+}
+
+}   // namespace onspeed::audio
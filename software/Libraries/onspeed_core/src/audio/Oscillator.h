@@ -0,0 +1,109 @@
+// Oscillator.h — fixed-point phase-accumulator tone oscillator.
+//
+// A 32-bit phase accumulator indexes one shared quarter-wave sine table
+// (kSineQuarterSize + 1 Q15 entries, built at compile time), with linear
+// interpolation between entries. Rendering is integer-only: no cosf, no
+// float per sample, no per-frequency tables. Output is within 1 LSB of
+// libm sin() at full scale.
+//
+// Phase is 2^32 per cycle, so the increment for `hz` at `rate` is
+// hz * 2^32 / rate and any frequency up to Nyquist is available with
+// 0.004 mHz resolution at 16 kHz. The phase only ever advances by the
+// increment, so frequency changes — stepped or glided — never reset it
+// and never click.
+//
+// Glides: SetFrequency(hz, rate, glideSamples) ramps the increment
+// linearly from wherever it is to the new target over `glideSamples`
+// samples (0 = step). A new SetFrequency mid-glide starts from the
+// current, partly glided increment.
+//
+// Output is cosine-phased (phase 0 = +amplitude), matching the legacy
+// precomputed 400/1600 Hz carrier tables it replaces.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_AUDIO_OSCILLATOR_H
+#define ONSPEED_CORE_AUDIO_OSCILLATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ToneSynth.h"   // kLegacyToneAmplitude
+
+namespace onspeed::audio {
+
+inline constexpr int         kSineQuarterBits = 8;
+inline constexpr std::size_t kSineQuarterSize = std::size_t{1} << kSineQuarterBits;
+
+namespace detail {
+
+// sin(x) for x in [0, pi/2] by Taylor series; constexpr so the table below
+// is computed by the compiler and lands in flash.
+constexpr double SinTaylor(double x) {
+    double term = x;
+    double sum  = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+        sum  += term;
+    }
+    return sum;
+}
+
+constexpr std::array<std::int16_t, kSineQuarterSize + 1> MakeSineQuarterTable() {
+    std::array<std::int16_t, kSineQuarterSize + 1> t{};
+    constexpr double kHalfPi = 1.57079632679489661923;
+    for (std::size_t i = 0; i <= kSineQuarterSize; ++i) {
+        const double v = 32767.0 * SinTaylor(kHalfPi * static_cast<double>(i) /
+                                             static_cast<double>(kSineQuarterSize));
+        t[i] = static_cast<std::int16_t>(v + 0.5);
+    }
+    return t;
+}
+
+}   // namespace detail
+
+// sin over [0, pi/2] in Q15, entry kSineQuarterSize == 32767.
+inline constexpr std::array<std::int16_t, kSineQuarterSize + 1> kSineQuarterTable =
+    detail::MakeSineQuarterTable();
+
+// Q15 sine / cosine of a 32-bit phase (2^32 == one cycle).
+std::int16_t SineQ15(std::uint32_t phase);
+inline std::int16_t CosineQ15(std::uint32_t phase) { return SineQ15(phase + 0x40000000u); }
+
+// Phase increment for `frequencyHz` at `sampleRateHz`; 0 when either is
+// non-positive, clamped to Nyquist.
+std::uint32_t PhaseIncrement(float frequencyHz, int sampleRateHz);
+
+class Oscillator {
+public:
+    // Retune. Takes effect on the next rendered sample; phase carries on.
+    void SetFrequency(float frequencyHz, int sampleRateHz, std::uint32_t glideSamples = 0);
+
+    // Peak amplitude in PCM counts (0..32767). Applies immediately.
+    void SetAmplitude(std::int16_t amplitude) { m_amplitude = amplitude; }
+
+    // Render `sampleCount` mono samples, advancing phase and any glide.
+    void Render(std::int16_t* out, std::size_t sampleCount);
+
+    void ResetPhase(std::uint32_t phase = 0) { m_phase = phase; }
+
+    std::uint32_t Phase()     const { return m_phase; }
+    std::uint32_t Increment() const { return static_cast<std::uint32_t>(m_incrementQ16 >> 16); }
+    std::uint32_t Target()    const { return m_target; }
+    bool          Gliding()   const { return m_glideLeft > 0; }
+
+private:
+    // The increment carries 16 fraction bits so slow glides still move
+    // every sample instead of rounding their step to zero.
+    std::uint32_t m_phase        = 0;
+    std::int64_t  m_incrementQ16 = 0;
+    std::int64_t  m_glideStepQ16 = 0;
+    std::uint32_t m_target       = 0;
+    std::uint32_t m_glideLeft    = 0;   // samples until increment == target
+    std::int16_t  m_amplitude    = kLegacyToneAmplitude;
+};
+
+}   // namespace onspeed::audio
+
+#endif   // ONSPEED_CORE_AUDIO_OSCILLATOR_H
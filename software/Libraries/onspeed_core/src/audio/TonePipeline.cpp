@@ -0,0 +1,93 @@
+// TonePipeline.cpp — render-ahead tone chunk queue implementation.
+
+#include "TonePipeline.h"
+
+#include <cstdint>
+
+namespace onspeed::audio {
+
+TonePipeline::TonePipeline(std::size_t lookahead)
+    : m_lookahead(lookahead < 1                 ? 1
+                  : lookahead > kToneMaxLookahead ? kToneMaxLookahead
+                                                  : lookahead) {}
+
+bool TonePipeline::Render(const ToneChunkParams& params) {
+    if (Full())
+        return false;
+
+    Slot& slot  = m_slots[(m_first + m_count) % kToneMaxLookahead];
+    slot.before = m_head;
+    slot.marked = m_pendingMark;
+    slot.markUs = m_pendingMarkUs;
+    m_pendingMark = false;
+
+    // Retune only on an actual change so an in-progress glide isn't
+    // restarted every chunk.
+    Oscillator& osc = m_head.oscillator;
+    if (PhaseIncrement(params.toneHz, params.sampleRateHz) != osc.Target())
+        osc.SetFrequency(params.toneHz, params.sampleRateHz, params.glideSamples);
+
+    MixerInputs inp;
+    inp.oscillator = &osc;
+    inp.envelope   = &m_head.envelope;
+    inp.leftScale  = params.leftScale;
+    inp.rightScale = params.rightScale;
+
+    std::int16_t stereo[kToneChunkFrames * 2];
+    Mix(inp, stereo, kToneChunkFrames, m_head.mixer);
+    for (std::size_t j = 0; j < kToneChunkFrames; ++j)
+        slot.frames[j] = PackStereoI16(stereo[2 * j], stereo[2 * j + 1]);
+
+    ++m_count;
+    return true;
+}
+
+const std::uint32_t* TonePipeline::Front() const {
+    return m_count > 0 ? m_slots[m_first].frames : nullptr;
+}
+
+bool TonePipeline::FrontMark(std::uint64_t& stampUs) const {
+    if (m_count == 0 || !m_slots[m_first].marked)
+        return false;
+    stampUs = m_slots[m_first].markUs;
+    return true;
+}
+
+void TonePipeline::Pop() {
+    if (m_count == 0)
+        return;
+    m_first = (m_first + 1) % kToneMaxLookahead;
+    --m_count;
+}
+
+std::size_t TonePipeline::Cancel() {
+    const std::size_t dropped = m_count;
+    if (dropped > 0)
+        m_head = m_slots[m_first].before;
+    m_count       = 0;
+    m_pendingMark = false;
+    return dropped;
+}
+
+void TonePipeline::MarkNextChunk(std::uint64_t stampUs) {
+    m_pendingMark   = true;
+    m_pendingMarkUs = stampUs;
+}
+
+bool IsStallWarning(const ToneResult& tone, const OrchestratorConfig& cfg) {
+    return tone.enTone == EnToneType::High && tone.fPulseFreq >= cfg.stallPpsThreshold;
+}
+
+bool ToneChangeNeedsRerender(const ToneResult& prev,
+                             const ToneResult& next,
+                             const OrchestratorConfig& cfg) {
+    if (prev.enTone != next.enTone)
+        return true;
+    if (next.enTone == EnToneType::None)
+        return false;
+    if ((prev.fPulseFreq > 0.0f) != (next.fPulseFreq > 0.0f))
+        return true;
+    return IsStallWarning(prev, cfg) != IsStallWarning(next, cfg);
+}
+
+}   // namespace onspeed::audio
@@ -0,0 +1,130 @@
+// TonePipeline.h — render-ahead queue of tone chunks for the I2S pump.
+//
+// The audio task used to render one 15 ms chunk and block in i2s.write()
+// until the DMA ring took it, so a SetTone() arriving just after a write
+// waited out everything already queued in the driver.  TonePipeline
+// splits that into a producer and a submitter:
+//
+//   Render()  renders the next chunk (oscillator → envelope → mixer →
+//             packed I2S frames) from the Head() state and queues it.
+//   Front()   is the oldest rendered chunk; the task hands it to DMA
+//             and Pop()s it.
+//   Cancel()  drops every chunk not yet handed to DMA and rewinds
+//             Head() to the state the oldest of them started from, so
+//             an urgent tone change is re-rendered from exactly where
+//             the audio that will actually play leaves off: no phase
+//             jump, no envelope discontinuity.
+//
+// Tone commands (DecideAndArm, retunes) apply to Head(), i.e. after the
+// newest queued chunk.  Commands that must be heard sooner Cancel()
+// first.  Anything applied to Head() after the dropped chunks were
+// rendered is dropped with them — re-apply the newest command after a
+// Cancel().
+//
+// MarkNextChunk() tags the next rendered chunk with a caller timestamp
+// (the latency probe: command time → chunk submission).  Cancel() drops
+// tags on discarded chunks and any pending tag.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_AUDIO_TONE_PIPELINE_H
+#define ONSPEED_CORE_AUDIO_TONE_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AudioMixer.h"
+#include "AudioOrchestrator.h"
+#include "Envelope.h"
+#include "Oscillator.h"
+
+namespace onspeed::audio {
+
+// 240 frames = 15 ms at 16 kHz; one I2S DMA descriptor.
+inline constexpr std::size_t kToneChunkFrames  = 240;
+inline constexpr std::size_t kToneMaxLookahead = 4;
+
+// Everything a tone chunk is rendered from.  Copyable so the pipeline
+// can snapshot it per chunk.
+struct ToneRenderState {
+    Envelope   envelope;
+    Oscillator oscillator;
+    MixerState mixer;
+};
+
+// Per-chunk render parameters.  `toneHz` retunes the oscillator only
+// when it differs from the current target, gliding over `glideSamples`.
+struct ToneChunkParams {
+    int           sampleRateHz = 16000;
+    float         toneHz       = 0.0f;
+    std::uint32_t glideSamples = 0;
+    float         leftScale    = 1.0f;
+    float         rightScale   = 1.0f;
+};
+
+class TonePipeline {
+public:
+    // `lookahead` chunks may be rendered but not yet popped; clamped to
+    // [1, kToneMaxLookahead].
+    explicit TonePipeline(std::size_t lookahead = 2);
+
+    // State after the newest queued chunk.  Commands apply here.
+    ToneRenderState&       Head()       { return m_head; }
+    const ToneRenderState& Head() const { return m_head; }
+
+    // Render one chunk from Head() and queue it.  False when full.
+    bool Render(const ToneChunkParams& params);
+
+    // Oldest queued chunk (kToneChunkFrames packed stereo frames, see
+    // PackStereoI16), or nullptr when empty.
+    const std::uint32_t* Front() const;
+
+    // True, with the stamp, when the oldest chunk carries a mark.
+    bool FrontMark(std::uint64_t& stampUs) const;
+
+    // Release the oldest chunk once it has been handed to DMA.
+    void Pop();
+
+    // Drop every queued chunk and rewind Head() to where the oldest one
+    // started.  Returns the number of chunks dropped.
+    std::size_t Cancel();
+
+    // Tag the next Render()ed chunk with `stampUs`.
+    void MarkNextChunk(std::uint64_t stampUs);
+
+    std::size_t Pending()   const { return m_count; }
+    std::size_t Lookahead() const { return m_lookahead; }
+    bool        Empty()     const { return m_count == 0; }
+    bool        Full()      const { return m_count >= m_lookahead; }
+
+private:
+    struct Slot {
+        std::uint32_t   frames[kToneChunkFrames];
+        ToneRenderState before;   // Head() as it was before this chunk
+        std::uint64_t   markUs = 0;
+        bool            marked = false;
+    };
+
+    Slot            m_slots[kToneMaxLookahead];
+    ToneRenderState m_head;
+    std::size_t     m_lookahead;
+    std::size_t     m_first = 0;   // index of the oldest queued slot
+    std::size_t     m_count = 0;
+    std::uint64_t   m_pendingMarkUs = 0;
+    bool            m_pendingMark   = false;
+};
+
+// Stall warning: the high tone pulsing at or above the stall threshold.
+bool IsStallWarning(const ToneResult& tone, const OrchestratorConfig& cfg);
+
+// True when going from `prev` to `next` should be heard now rather than
+// after the queued lookahead: tone on/off or low/high, solid/pulsed, or
+// crossing the stall threshold.  PPS drift within a band is not —
+// NoteOn() applies it at the next pulse boundary anyway.
+bool ToneChangeNeedsRerender(const ToneResult& prev,
+                             const ToneResult& next,
+                             const OrchestratorConfig& cfg);
+
+}   // namespace onspeed::audio
+
+#endif   // ONSPEED_CORE_AUDIO_TONE_PIPELINE_H
@@ -0,0 +1,101 @@
+// VoiceCodec.cpp — IMA ADPCM voice-asset decoder implementation.
+
+#include "VoiceCodec.h"
+
+#include <cstdint>
+
+namespace onspeed::audio {
+
+namespace {
+
+// Standard IMA ADPCM tables; scripts/normalize_voice_pcm.py carries the
+// same two tables for the encoder.
+constexpr std::int16_t kStepTable[89] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+constexpr std::int8_t kIndexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+constexpr int kMaxStepIndex = 88;
+
+std::size_t BlocksFor(std::size_t codedSamples) {
+    return (codedSamples + kVoiceBlockSamples - 1) / kVoiceBlockSamples;
+}
+
+}   // namespace
+
+bool IsValidVoiceAsset(const VoiceAsset& asset) {
+    if (asset.codedSamples == 0)
+        return asset.blockBytes == 0;
+    return asset.blocks != nullptr &&
+           asset.blockBytes == BlocksFor(asset.codedSamples) * kVoiceBlockBytes;
+}
+
+VoiceDecoder::VoiceDecoder(const VoiceAsset& asset)
+    : m_asset(asset) {
+    if (IsValidVoiceAsset(asset))
+        m_total = asset.TotalSamples();
+}
+
+void VoiceDecoder::StartBlock(std::size_t block) {
+    const std::uint8_t* p = m_asset.blocks + block * kVoiceBlockBytes;
+    m_predictor = static_cast<std::int16_t>(static_cast<std::uint16_t>(p[0]) |
+                                            (static_cast<std::uint16_t>(p[1]) << 8));
+    m_stepIndex = p[2] > kMaxStepIndex ? kMaxStepIndex : p[2];
+}
+
+std::size_t VoiceDecoder::Read(std::int16_t* out, std::size_t maxSamples) {
+    if (out == nullptr)
+        return 0;
+
+    const std::size_t lead     = m_asset.leadSilence;
+    const std::size_t codedEnd = lead + m_asset.codedSamples;
+
+    std::size_t n = 0;
+    while (n < maxSamples && m_pos < m_total) {
+        if (m_pos < lead || m_pos >= codedEnd) {
+            out[n++] = 0;
+            ++m_pos;
+            continue;
+        }
+
+        const std::size_t inBlock = m_coded % kVoiceBlockSamples;
+        if (inBlock == 0)
+            StartBlock(m_coded / kVoiceBlockSamples);
+
+        const std::uint8_t byte = m_asset.blocks[(m_coded / kVoiceBlockSamples) * kVoiceBlockBytes
+                                                 + kVoiceBlockHeaderSize + inBlock / 2];
+        const int code = (inBlock & 1) ? (byte >> 4) : (byte & 0x0F);
+
+        const std::int32_t step = kStepTable[m_stepIndex];
+        std::int32_t diff = step >> 3;
+        if (code & 4) diff += step;
+        if (code & 2) diff += step >> 1;
+        if (code & 1) diff += step >> 2;
+        m_predictor += (code & 8) ? -diff : diff;
+        if (m_predictor >  32767) m_predictor =  32767;
+        if (m_predictor < -32768) m_predictor = -32768;
+
+        m_stepIndex += kIndexTable[code];
+        if (m_stepIndex < 0)             m_stepIndex = 0;
+        if (m_stepIndex > kMaxStepIndex) m_stepIndex = kMaxStepIndex;
+
+        out[n++] = static_cast<std::int16_t>(m_predictor);
+        ++m_coded;
+        ++m_pos;
+    }
+    return n;
+}
+
+}   // namespace onspeed::audio
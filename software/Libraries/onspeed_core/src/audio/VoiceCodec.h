@@ -0,0 +1,87 @@
+// VoiceCodec.h — compressed voice-prompt assets and their streaming decoder.
+//
+// The voice prompts are mastered as raw 16 kHz int16 PCM (Audio/PCM_*.h)
+// and shipped as IMA ADPCM (Audio/VoiceAssets.h), generated from the
+// masters by `scripts/normalize_voice_pcm.py --encode`. ADPCM stores four
+// bits per sample, so the prompts take roughly a quarter of the flash and
+// of every OTA image.
+//
+// Silence trimming: near-silent runs at either end of a master are not
+// stored. The asset records how many samples were cut and the decoder
+// plays that many exact zeros, so a prompt starts and ends exactly when
+// the raw PCM did.
+//
+// Block layout (kVoiceBlockBytes each, kVoiceBlockSamples samples):
+//
+//   offset 0  int16 LE  predictor before the block's first sample
+//   offset 2  uint8     step index, 0..88
+//   offset 3  uint8     reserved, 0
+//   offset 4  120 bytes 4-bit codes, low nibble first
+//
+// Every block carries its own predictor state, so a corrupt block cannot
+// smear into the next one. The last block is zero-padded.
+//
+// VoiceDecoder is pull-based: each Read() decodes at most the samples
+// asked for, so the audio task decodes one I2S chunk at a time and never
+// holds a decoded prompt in RAM.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_AUDIO_VOICE_CODEC_H
+#define ONSPEED_CORE_AUDIO_VOICE_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace onspeed::audio {
+
+inline constexpr std::size_t kVoiceBlockSamples    = 240;  // one I2S DMA chunk
+inline constexpr std::size_t kVoiceBlockHeaderSize = 4;
+inline constexpr std::size_t kVoiceBlockBytes      = kVoiceBlockHeaderSize + kVoiceBlockSamples / 2;
+
+// Non-owning description of one encoded prompt; the generated header
+// defines one per voice over a `const` byte array in flash.
+struct VoiceAsset {
+    const std::uint8_t* blocks       = nullptr;
+    std::size_t         blockBytes   = 0;   // whole blocks, kVoiceBlockBytes each
+    std::uint32_t       codedSamples = 0;   // samples stored in `blocks`
+    std::uint32_t       leadSilence  = 0;   // zeros played before them
+    std::uint32_t       trailSilence = 0;   // zeros played after them
+    int                 sampleRateHz = 0;
+
+    // Samples Read() will produce in total: lead + coded + trail.
+    std::size_t TotalSamples() const {
+        return static_cast<std::size_t>(leadSilence) + codedSamples + trailSilence;
+    }
+};
+
+// True when `blockBytes` is exactly the whole blocks `codedSamples` needs
+// and `blocks` is non-null whenever there is anything to decode.
+bool IsValidVoiceAsset(const VoiceAsset& asset);
+
+class VoiceDecoder {
+public:
+    // An invalid asset (see IsValidVoiceAsset) decodes as empty.
+    explicit VoiceDecoder(const VoiceAsset& asset);
+
+    // Write up to `maxSamples` mono samples into `out`; returns how many.
+    // Returns 0 once the whole prompt, trailing silence included, is out.
+    std::size_t Read(std::int16_t* out, std::size_t maxSamples);
+
+    std::size_t Remaining() const { return m_total - m_pos; }
+    bool        Done()      const { return m_pos >= m_total; }
+
+private:
+    void StartBlock(std::size_t block);
+
+    VoiceAsset   m_asset;
+    std::size_t  m_total     = 0;
+    std::size_t  m_pos       = 0;   // samples emitted, silence included
+    std::size_t  m_coded     = 0;   // coded samples decoded so far
+    std::int32_t m_predictor = 0;
+    int          m_stepIndex = 0;
+};
+
+}   // namespace onspeed::audio
+
+#endif   // ONSPEED_CORE_AUDIO_VOICE_CODEC_H
@@ -172,6 +172,7 @@ std::string EmitXml(const OnSpeedConfig& cfg)
 
     AddBool(root, "SDLOGGING", cfg.bSdLogging);
     AddInt (root, "LOGRATE",   cfg.iLogRate);
+    AddInt (root, "LOGFORMAT", cfg.iLogFormat);
 
     // <AIRCRAFT>
     XMLElement* ac = AddElem(root, "AIRCRAFT");
@@ -302,6 +302,7 @@ XmlParseStatus ParseXml(std::string_view xml, OnSpeedConfig& cfg)
 
     GetBool(root, "SDLOGGING", cfg.bSdLogging);
     GetInt (root, "LOGRATE",   cfg.iLogRate);
+    GetInt (root, "LOGFORMAT", cfg.iLogFormat);
 
     // ---------------- <AIRCRAFT> -----------------------------------------
 
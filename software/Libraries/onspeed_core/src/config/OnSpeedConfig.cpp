@@ -164,6 +164,7 @@ bool OnSpeedConfig::LoadDefaults()
 
     // SD card logging
     bSdLogging          = false;
+    iLogFormat          = 0;
 
     // Aircraft parameters.  Defaults match the Utility category radio
     // (+4.4 G / -1.76 G) so a freshly defaulted config selects a sane,
@@ -137,12 +137,14 @@ public:
     enum EnSerialFmt {
         EnSerialFmtOther,
         EnSerialFmtG3X,
-        EnSerialFmtOnSpeed
+        EnSerialFmtOnSpeed,
+        EnSerialFmtOnSpeedBin
     };
 
     static EnSerialFmt ParseSerialFmt(const std::string& s) {
         if (s == "G3X")     return EnSerialFmtG3X;
         if (s == "ONSPEED") return EnSerialFmtOnSpeed;
+        if (s == "ONSPEED_BIN") return EnSerialFmtOnSpeedBin;
         return EnSerialFmtOther;
     }
 
@@ -233,6 +235,7 @@ public:
 
     // SD card logging
     bool    bSdLogging;
+    int     iLogFormat;             ///< 0 = CSV (default), 1 = binary columnar (.osl, proto/LogBin.h)
 
     // Aircraft parameters (used by calibration wizard)
     int     iAcGrossWeight;
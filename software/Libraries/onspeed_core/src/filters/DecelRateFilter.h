@@ -0,0 +1,92 @@
+// DecelRateFilter.h — IAS rate of change (kt/s) for the display's decel gauge
+//
+// The M5 display differentiates the IAS it receives on the display serial
+// wire: a window-15 Savitzky-Golay first derivative, divided by the sample
+// period, then an EMA with α = 0.04. Both were tuned on 20 Hz #1 text
+// frames, where the window spans 0.75 s and the EMA's τ is ~1.2 s.
+//
+// ONSPEED_BIN frames arrive at 100 Hz. Fed every frame, the same window
+// would span 0.15 s (five times the noise gain on the derivative) and the
+// EMA τ would shrink to ~0.25 s, so the gauge would read differently
+// depending on the wire format. This filter decimates instead: it takes
+// one IAS sample per kSamplePeriodSec of accumulated frame time and holds
+// its output between samples. At 20 Hz every frame is a sample; at
+// 100 Hz every fifth.
+//
+// Sample due test: a frame is taken once the time since the last due
+// point reaches 3/4 of the period, and the due point then advances by a
+// whole period. That tolerates frame jitter at 20 Hz without dropping
+// frames, and float round-off at 100 Hz without drifting to every sixth.
+// The derivative is divided by the measured time since the previous
+// sample, like the per-frame dt the display used before.
+//
+// This file is part of onspeed_core and must remain platform-free.
+//
+// Usage (per received frame):
+//
+//   static onspeed::filters::DecelRateFilter decel;
+//   decel.Update(iasKt, frameDtSec);
+//   DecelRate         = decel.Rate();
+//   SmoothedDecelRate = decel.Smoothed();
+
+#pragma once
+
+#include <filters/SavGolDerivative.h>
+
+namespace onspeed::filters {
+
+class DecelRateFilter {
+public:
+    static constexpr float kSamplePeriodSec = 0.05f;   // 20 Hz, the rate the constants below were tuned at
+    static constexpr int   kWindow          = 15;      // SavGol window, samples
+    static constexpr float kAlpha           = 0.04f;   // EMA on the rate; 1 = pass-through
+
+    DecelRateFilter() = default;
+    DecelRateFilter(const DecelRateFilter&)            = delete;   // derivative_ points at input_
+    DecelRateFilter& operator=(const DecelRateFilter&) = delete;
+
+    // Fold in one frame's IAS, `frameDtSec` after the previous frame.
+    // Returns true when it was taken as a sample (Rate() / Smoothed()
+    // updated), false when it was skipped by the decimation.
+    bool Update(float iasKt, float frameDtSec)
+    {
+        sinceSampleSec_ += frameDtSec;
+        dueSec_         += frameDtSec;
+        if (dueSec_ < 0.75f * kSamplePeriodSec)
+            return false;
+
+        // No credit for slow frames: a late sample does not make the
+        // next one early.
+        dueSec_ -= kSamplePeriodSec;
+        if (dueSec_ > 0.0f) dueSec_ = 0.0f;
+
+        input_     = iasKt;
+        rate_      = derivative_.Compute() / sinceSampleSec_;
+        smoothed_  = rate_ * kAlpha + smoothed_ * (1.0f - kAlpha);
+        sinceSampleSec_ = 0.0f;
+        return true;
+    }
+
+    // Drop the window and zero both outputs (serial gap, IAS validity edge).
+    void Reset()
+    {
+        derivative_.reset();
+        rate_           = 0.0f;
+        smoothed_       = 0.0f;
+        sinceSampleSec_ = 0.0f;
+        dueSec_         = 0.0f;
+    }
+
+    float Rate()     const { return rate_; }       // kt/s, unsmoothed
+    float Smoothed() const { return smoothed_; }   // kt/s, after the EMA
+
+private:
+    double           input_ = 0.0;
+    SavGolDerivative derivative_{&input_, kWindow};
+    float            rate_           = 0.0f;
+    float            smoothed_       = 0.0f;
+    float            sinceSampleSec_ = 0.0f;
+    float            dueSec_         = 0.0f;
+};
+
+} // namespace onspeed::filters
@@ -0,0 +1,182 @@
+// DirtyTiles.cpp — tile-grid change tracking implementation.
+
+#include "DirtyTiles.h"
+
+#include <cstring>
+
+namespace onspeed::gauges {
+
+namespace {
+
+constexpr uint32_t kFnvOffset = 2166136261u;
+constexpr uint32_t kFnvPrime  = 16777619u;
+
+inline int MinInt(int a, int b) { return a < b ? a : b; }
+inline int MaxInt(int a, int b) { return a > b ? a : b; }
+
+}  // namespace
+
+DirtyTileMap::DirtyTileMap()
+{
+    std::memset(hash_, 0, sizeof(hash_));
+    std::memset(dirty_, 0, sizeof(dirty_));
+}
+
+bool DirtyTileMap::Reset(int width, int height)
+{
+    std::memset(hash_, 0, sizeof(hash_));
+    std::memset(dirty_, 0, sizeof(dirty_));
+    width_ = height_ = cols_ = rows_ = 0;
+
+    if (width <= 0 || height <= 0 || width > kDirtyMaxWidth || height > kDirtyMaxHeight)
+        return false;
+
+    width_  = width;
+    height_ = height;
+    cols_   = (width  + kDirtyTileSize - 1) / kDirtyTileSize;
+    rows_   = (height + kDirtyTileSize - 1) / kDirtyTileSize;
+    MarkAll();
+    return true;
+}
+
+void DirtyTileMap::MarkAll()
+{
+    for (int r = 0; r < rows_; ++r)
+        for (int c = 0; c < cols_; ++c)
+            dirty_[r][c] = true;
+}
+
+void DirtyTileMap::MarkRect(int x, int y, int w, int h)
+{
+    if (w <= 0 || h <= 0) return;
+    const int x0 = MaxInt(x, 0);
+    const int y0 = MaxInt(y, 0);
+    const int x1 = MinInt(x + w, width_);    // exclusive
+    const int y1 = MinInt(y + h, height_);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int r = y0 / kDirtyTileSize; r <= (y1 - 1) / kDirtyTileSize; ++r)
+        for (int c = x0 / kDirtyTileSize; c <= (x1 - 1) / kDirtyTileSize; ++c)
+            dirty_[r][c] = true;
+}
+
+uint32_t DirtyTileMap::HashTile(const uint8_t* pixels, int bytesPerPixel,
+                                std::size_t strideBytes, int col, int row) const
+{
+    const int x0 = col * kDirtyTileSize;
+    const int y0 = row * kDirtyTileSize;
+    const std::size_t rowBytes =
+        static_cast<std::size_t>(MinInt(kDirtyTileSize, width_ - x0)) *
+        static_cast<std::size_t>(bytesPerPixel);
+    const int yEnd = MinInt(y0 + kDirtyTileSize, height_);
+
+    uint32_t h = kFnvOffset;
+    for (int y = y0; y < yEnd; ++y)
+    {
+        const uint8_t* p = pixels + static_cast<std::size_t>(y) * strideBytes +
+                           static_cast<std::size_t>(x0) * static_cast<std::size_t>(bytesPerPixel);
+        std::size_t i = 0;
+        for (; i + 4 <= rowBytes; i += 4)
+        {
+            uint32_t w;
+            std::memcpy(&w, p + i, sizeof(w));
+            h = (h ^ w) * kFnvPrime;
+        }
+        for (; i < rowBytes; ++i)
+            h = (h ^ p[i]) * kFnvPrime;
+    }
+    return h;
+}
+
+int DirtyTileMap::Scan(const uint8_t* pixels, int bytesPerPixel, std::size_t strideBytes)
+{
+    if (pixels != nullptr && bytesPerPixel > 0)
+    {
+        for (int r = 0; r < rows_; ++r)
+            for (int c = 0; c < cols_; ++c)
+            {
+                const uint32_t h = HashTile(pixels, bytesPerPixel, strideBytes, c, r);
+                if (h != hash_[r][c])
+                {
+                    hash_[r][c]  = h;
+                    dirty_[r][c] = true;
+                }
+            }
+    }
+    return DirtyTileCount();
+}
+
+int DirtyTileMap::DirtyTileCount() const
+{
+    int n = 0;
+    for (int r = 0; r < rows_; ++r)
+        for (int c = 0; c < cols_; ++c)
+            if (dirty_[r][c]) ++n;
+    return n;
+}
+
+int DirtyTileMap::TakeRects(DirtyRect* out, int outCapacity)
+{
+    if (out == nullptr || outCapacity <= 0) return 0;
+
+    int  count    = 0;
+    bool overflow = false;
+    int  minX = width_, minY = height_, maxX = 0, maxY = 0;   // bounding box, exclusive max
+
+    for (int r = 0; r < rows_; ++r)
+    {
+        const int y = r * kDirtyTileSize;
+        const int h = MinInt(kDirtyTileSize, height_ - y);
+
+        int c = 0;
+        while (c < cols_)
+        {
+            if (!dirty_[r][c]) { ++c; continue; }
+
+            const int c0 = c;
+            while (c < cols_ && dirty_[r][c])
+                dirty_[r][c++] = false;
+
+            const int x = c0 * kDirtyTileSize;
+            const int w = MinInt(c * kDirtyTileSize, width_) - x;
+            minX = MinInt(minX, x);
+            minY = MinInt(minY, y);
+            maxX = MaxInt(maxX, x + w);
+            maxY = MaxInt(maxY, y + h);
+            if (overflow) continue;
+
+            // Stack onto a rectangle from the row above with the same span.
+            bool merged = false;
+            for (int i = 0; i < count; ++i)
+            {
+                DirtyRect& rc = out[i];
+                if (rc.x == x && rc.w == w && rc.y + rc.h == y)
+                {
+                    rc.h = static_cast<int16_t>(rc.h + h);
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged) continue;
+
+            if (count == outCapacity) { overflow = true; continue; }
+            out[count].x = static_cast<int16_t>(x);
+            out[count].y = static_cast<int16_t>(y);
+            out[count].w = static_cast<int16_t>(w);
+            out[count].h = static_cast<int16_t>(h);
+            ++count;
+        }
+    }
+
+    if (overflow)
+    {
+        out[0].x = static_cast<int16_t>(minX);
+        out[0].y = static_cast<int16_t>(minY);
+        out[0].w = static_cast<int16_t>(maxX - minX);
+        out[0].h = static_cast<int16_t>(maxY - minY);
+        return 1;
+    }
+    return count;
+}
+
+}  // namespace onspeed::gauges
@@ -0,0 +1,105 @@
+// DirtyTiles.h — tile-grid change tracking for a persistent framebuffer.
+//
+// The M5 display redraws every gauge into one full-screen sprite each
+// frame. Between two frames almost everything is identical: only the
+// tiles under the moving needle, the tape digits and the slip ball
+// change. DirtyTileMap splits the frame into kDirtyTileSize-square tiles,
+// keeps a content hash per tile, and turns the tiles that changed since
+// the last push into a short list of rectangles, so the caller can push
+// just those to the panel.
+//
+//   Scan()      hashes every tile of the freshly drawn frame and marks
+//               the tiles whose hash differs from last time.
+//   MarkRect()  marks tiles explicitly (a widget that knows it moved, or
+//               a region something else drew over on the panel).
+//   MarkAll()   marks the whole frame (mode change, screen taken over by
+//               a menu or splash, first frame after (re)allocation).
+//   TakeRects() coalesces the marked tiles into rectangles — horizontal
+//               runs first, then runs of identical span stacked
+//               vertically — and clears the marks.
+//
+// The per-tile hash folds 32-bit words as h = (h ^ w) * FNV prime; each
+// step is a bijection in both h and w, so a frame that differs from the
+// previous one in a single word of a tile always changes that tile's
+// hash.
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_GAUGES_DIRTY_TILES_H
+#define ONSPEED_GAUGES_DIRTY_TILES_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace onspeed::gauges {
+
+/// Tile edge in pixels.
+inline constexpr int kDirtyTileSize = 16;
+
+/// Largest frame tracked: the 320x240 M5 / huVVer panel.
+inline constexpr int kDirtyMaxWidth  = 320;
+inline constexpr int kDirtyMaxHeight = 240;
+inline constexpr int kDirtyMaxCols   = (kDirtyMaxWidth  + kDirtyTileSize - 1) / kDirtyTileSize;
+inline constexpr int kDirtyMaxRows   = (kDirtyMaxHeight + kDirtyTileSize - 1) / kDirtyTileSize;
+
+/// Rectangle buffer size callers are expected to hand TakeRects().
+inline constexpr int kDirtyMaxRects = 32;
+
+/// A pixel rectangle, clipped to the frame.
+struct DirtyRect {
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t w = 0;
+    int16_t h = 0;
+};
+
+class DirtyTileMap
+{
+public:
+    DirtyTileMap();
+
+    /// Size the grid for a `width` x `height` frame, forget every hash
+    /// and mark the whole frame. Returns false (and tracks nothing) when
+    /// either dimension is non-positive or exceeds the kDirtyMax* limits.
+    bool Reset(int width, int height);
+
+    int Width()  const { return width_; }
+    int Height() const { return height_; }
+    int Cols()   const { return cols_; }
+    int Rows()   const { return rows_; }
+
+    /// Mark every tile.
+    void MarkAll();
+
+    /// Mark every tile overlapping the rectangle; clipped to the frame.
+    void MarkRect(int x, int y, int w, int h);
+
+    /// Hash every tile of `pixels` (Height() rows of `strideBytes`, each
+    /// Width() pixels of `bytesPerPixel`) and mark the tiles whose content
+    /// changed. Returns the number of marked tiles afterwards.
+    int Scan(const uint8_t* pixels, int bytesPerPixel, std::size_t strideBytes);
+
+    /// Number of tiles currently marked.
+    int DirtyTileCount() const;
+
+    /// Coalesce the marked tiles into at most `outCapacity` rectangles
+    /// and clear the marks. When the tiles need more rectangles than
+    /// that, writes their bounding box as a single rectangle instead.
+    /// Returns the number of rectangles written.
+    int TakeRects(DirtyRect* out, int outCapacity);
+
+private:
+    uint32_t HashTile(const uint8_t* pixels, int bytesPerPixel, std::size_t strideBytes,
+                      int col, int row) const;
+
+    uint32_t hash_[kDirtyMaxRows][kDirtyMaxCols];
+    bool     dirty_[kDirtyMaxRows][kDirtyMaxCols];
+    int      width_  = 0;
+    int      height_ = 0;
+    int      cols_   = 0;
+    int      rows_   = 0;
+};
+
+}  // namespace onspeed::gauges
+
+#endif  // ONSPEED_GAUGES_DIRTY_TILES_H
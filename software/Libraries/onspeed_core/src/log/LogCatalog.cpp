@@ -0,0 +1,377 @@
+// LogCatalog.cpp
+
+#include <log/LogCatalog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace onspeed::log {
+
+namespace {
+
+constexpr size_t kUpsertFieldCount = 15;   // '+' plus 14 values
+
+char LowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+int NameCompareNoCase(const char* a, const char* b)
+{
+    for (; *a != '\0' && *b != '\0'; ++a, ++b) {
+        const char la = LowerAscii(*a), lb = LowerAscii(*b);
+        if (la != lb) return (la < lb) ? -1 : 1;
+    }
+    return (*a == *b) ? 0 : (*a == '\0' ? -1 : 1);
+}
+
+bool EndsWithNoCase(const char* s, size_t len, const char* suffix)
+{
+    const size_t n = std::strlen(suffix);
+    if (len < n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (LowerAscii(s[len - n + i]) != LowerAscii(suffix[i])) return false;
+    return true;
+}
+
+// Copy `src` into `dst[dstLen]`, replacing the record separators.
+void CopySanitized(char* dst, size_t dstLen, const char* src)
+{
+    size_t i = 0;
+    for (; src[i] != '\0' && i + 1 < dstLen; ++i) {
+        const char c = src[i];
+        dst[i] = (c == '\t' || c == '\n' || c == '\r') ? '_' : c;
+    }
+    dst[i] = '\0';
+}
+
+void CopyField(char* dst, size_t dstLen, std::string_view v)
+{
+    const size_t n = (v.size() < dstLen - 1) ? v.size() : dstLen - 1;
+    std::memcpy(dst, v.data(), n);
+    dst[n] = '\0';
+}
+
+bool ParseU64(std::string_view v, uint64_t* out)
+{
+    char tmp[24];
+    if (v.empty() || v.size() >= sizeof(tmp)) return false;
+    if (v[0] < '0' || v[0] > '9') return false;
+    std::memcpy(tmp, v.data(), v.size());
+    tmp[v.size()] = '\0';
+    char* end = nullptr;
+    const unsigned long long n = std::strtoull(tmp, &end, 10);
+    if (*end != '\0') return false;
+    *out = static_cast<uint64_t>(n);
+    return true;
+}
+
+bool ParseU32(std::string_view v, uint32_t* out)
+{
+    uint64_t n = 0;
+    if (!ParseU64(v, &n) || n > UINT32_MAX) return false;
+    *out = static_cast<uint32_t>(n);
+    return true;
+}
+
+bool ParseFlag(std::string_view v, bool* out)
+{
+    if (v == "0") { *out = false; return true; }
+    if (v == "1") { *out = true;  return true; }
+    return false;
+}
+
+bool ParseF32(std::string_view v, float* out)
+{
+    char tmp[48];
+    if (v.empty() || v.size() >= sizeof(tmp)) return false;
+    std::memcpy(tmp, v.data(), v.size());
+    tmp[v.size()] = '\0';
+    char* end = nullptr;
+    const float f = std::strtof(tmp, &end);
+    if (*end != '\0') return false;
+    *out = f;
+    return true;
+}
+
+size_t Finish(int n, char* buf, size_t bufLen)
+{
+    if (n < 0 || static_cast<size_t>(n) >= bufLen) {
+        buf[0] = '\0';
+        return 0;
+    }
+    return static_cast<size_t>(n);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Names
+// ---------------------------------------------------------------------------
+
+bool IsLogCatalogHiddenName(const char* name)
+{
+    if (!name) return true;
+    const size_t len = std::strlen(name);
+    return EndsWithNoCase(name, len, ".meta")
+        || EndsWithNoCase(name, len, ".meta.tmp")
+        || EndsWithNoCase(name, len, ".dbg")
+        || EndsWithNoCase(name, len, ".pvw")
+        || LogCatalogNameEquals(name, kLogCatalogFileName)
+        || LogCatalogNameEquals(name, kLogCatalogTmpFileName);
+}
+
+bool LogCatalogNameEquals(const char* a, const char* b)
+{
+    if (!a || !b) return false;
+    for (; *a != '\0' && *b != '\0'; ++a, ++b)
+        if (LowerAscii(*a) != LowerAscii(*b)) return false;
+    return *a == *b;
+}
+
+// ---------------------------------------------------------------------------
+// Catalog
+// ---------------------------------------------------------------------------
+
+void LogCatalog::Reset()
+{
+    m_entries.clear();
+    m_uRecords    = 0;
+    m_bHeaderSeen = false;
+}
+
+bool LogCatalog::Load(std::string_view text)
+{
+    Reset();
+    size_t i = 0;
+    while (i < text.size()) {
+        const size_t j = text.find('\n', i);
+        if (j == std::string_view::npos) break;   // torn final line
+        const bool ok = ApplyLine(text.substr(i, j - i));
+        if (!ok && !m_bHeaderSeen) return false;
+        i = j + 1;
+    }
+    return m_bHeaderSeen;
+}
+
+bool LogCatalog::ApplyLine(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+    if (!m_bHeaderSeen) {
+        if (line != kLogCatalogHeader) {
+            Reset();
+            return false;
+        }
+        m_bHeaderSeen = true;
+        return true;
+    }
+
+    std::string_view fields[kUpsertFieldCount];
+    size_t nFields = 0;
+    size_t i = 0;
+    while (nFields < kUpsertFieldCount) {
+        const size_t j = line.find('\t', i);
+        if (j == std::string_view::npos) {
+            fields[nFields++] = line.substr(i);
+            i = line.size();
+            break;
+        }
+        fields[nFields++] = line.substr(i, j - i);
+        i = j + 1;
+    }
+    if (i < line.size()) return false;   // more fields than expected
+
+    if (nFields == 2 && fields[0] == "-") {
+        if (fields[1].empty() || fields[1].size() >= kLogCatalogNameLen) return false;
+        char name[kLogCatalogNameLen];
+        CopyField(name, sizeof(name), fields[1]);
+        Remove(name);
+        return true;
+    }
+
+    if (nFields != kUpsertFieldCount || fields[0] != "+") return false;
+    if (fields[1].empty() || fields[1].size() >= kLogCatalogNameLen) return false;
+
+    LogCatalogEntry e;
+    CopyField(e.name, sizeof(e.name), fields[1]);
+    if (!ParseU64(fields[2], &e.size))                return false;
+    if (!ParseFlag(fields[3], &e.hasDbg))             return false;
+    if (!ParseFlag(fields[4], &e.hasMeta))            return false;
+    if (!ParseU32(fields[5], &e.meta.durationMs))     return false;
+    if (!ParseU32(fields[6], &e.meta.rowCount))       return false;
+    if (!ParseF32(fields[7], &e.meta.maxIasKt))       return false;
+    if (!ParseF32(fields[8], &e.meta.maxPaltFt))      return false;
+    CopyField(e.meta.firmware,    sizeof(e.meta.firmware),    fields[9]);
+    CopyField(e.meta.firmwareSha, sizeof(e.meta.firmwareSha), fields[10]);
+    char efis[16];
+    CopyField(efis, sizeof(efis), fields[11]);
+    e.meta.efisType = EfisTypeFromString(efis);
+    if (!ParseFlag(fields[12], &e.meta.gpsFixSeen))   return false;
+    CopyField(e.meta.utcStart,       sizeof(e.meta.utcStart),       fields[13]);
+    CopyField(e.meta.timeOfDayStart, sizeof(e.meta.timeOfDayStart), fields[14]);
+
+    Upsert(e);
+    return true;
+}
+
+void LogCatalog::Upsert(const LogCatalogEntry& entry)
+{
+    ++m_uRecords;
+    for (LogCatalogEntry& e : m_entries) {
+        if (LogCatalogNameEquals(e.name, entry.name)) {
+            e = entry;
+            return;
+        }
+    }
+    m_entries.push_back(entry);
+}
+
+bool LogCatalog::Remove(const char* name)
+{
+    ++m_uRecords;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (LogCatalogNameEquals(m_entries[i].name, name)) {
+            m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(i));
+            return true;
+        }
+    }
+    return false;
+}
+
+const LogCatalogEntry* LogCatalog::Find(const char* name) const
+{
+    for (const LogCatalogEntry& e : m_entries)
+        if (LogCatalogNameEquals(e.name, name)) return &e;
+    return nullptr;
+}
+
+bool LogCatalog::Reconcile(const LogCatalogListedFile* files, size_t count,
+                           LogCatalogEntryReader read, void* ctx)
+{
+    // Case-insensitive order, matching LogCatalogNameEquals.
+    auto nameLess = [](const char* a, const char* b) { return NameCompareNoCase(a, b) < 0; };
+
+    std::vector<size_t> listed;
+    listed.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const char* name = files[i].name;
+        if (IsLogCatalogHiddenName(name) || std::strlen(name) >= kLogCatalogNameLen) continue;
+        listed.push_back(i);
+    }
+    std::sort(listed.begin(), listed.end(),
+              [&](size_t a, size_t b) { return nameLess(files[a].name, files[b].name); });
+
+    std::vector<size_t> cataloged(m_entries.size());
+    for (size_t i = 0; i < cataloged.size(); ++i) cataloged[i] = i;
+    std::sort(cataloged.begin(), cataloged.end(),
+              [&](size_t a, size_t b) { return nameLess(m_entries[a].name, m_entries[b].name); });
+
+    bool changed = false;
+    std::vector<bool> seen(m_entries.size(), false);
+    std::vector<LogCatalogEntry> added;
+    size_t c = 0;
+    for (size_t li : listed) {
+        const LogCatalogListedFile& f = files[li];
+        while (c < cataloged.size() && nameLess(m_entries[cataloged[c]].name, f.name)) ++c;
+        LogCatalogEntry* existing = nullptr;
+        if (c < cataloged.size() && LogCatalogNameEquals(m_entries[cataloged[c]].name, f.name)) {
+            existing = &m_entries[cataloged[c]];
+            seen[cataloged[c]] = true;
+            ++c;
+            if (existing->size == f.size) continue;
+        }
+        LogCatalogEntry e;
+        std::strncpy(e.name, f.name, sizeof(e.name) - 1);
+        e.size = f.size;
+        if (read != nullptr) read(ctx, e);
+        ++m_uRecords;
+        changed = true;
+        if (existing != nullptr) *existing = e;
+        else                     added.push_back(e);
+    }
+
+    // Drop the unseen entries in one pass, keeping the survivors' order.
+    size_t out = 0;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (!seen[i]) {
+            ++m_uRecords;
+            changed = true;
+            continue;
+        }
+        if (out != i) m_entries[out] = m_entries[i];
+        ++out;
+    }
+    m_entries.resize(out);
+    m_entries.insert(m_entries.end(), added.begin(), added.end());
+    return changed;
+}
+
+bool LogCatalog::NeedsCompaction() const
+{
+    // Slack of 32 keeps a fresh card from rewriting on every boot; the
+    // 2x factor bounds the journal at roughly twice the compacted size.
+    return m_uRecords > 2 * m_entries.size() + 32;
+}
+
+// ---------------------------------------------------------------------------
+// Formatters
+// ---------------------------------------------------------------------------
+
+size_t LogCatalog::FormatHeader(char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    return Finish(std::snprintf(buf, bufLen, "%s\n", kLogCatalogHeader), buf, bufLen);
+}
+
+size_t LogCatalog::FormatUpsert(const LogCatalogEntry& entry, char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+
+    char name[kLogCatalogNameLen];
+    char fw[kLogMetaFwLen];
+    char sha[kLogMetaShaLen];
+    char utc[kLogMetaUtcLen];
+    char tod[kLogMetaHmsLen];
+    CopySanitized(name, sizeof(name), entry.name);
+    CopySanitized(fw,   sizeof(fw),   entry.meta.firmware);
+    CopySanitized(sha,  sizeof(sha),  entry.meta.firmwareSha);
+    CopySanitized(utc,  sizeof(utc),  entry.meta.utcStart);
+    CopySanitized(tod,  sizeof(tod),  entry.meta.timeOfDayStart);
+    if (name[0] == '\0') {
+        buf[0] = '\0';
+        return 0;
+    }
+
+    const int n = std::snprintf(buf, bufLen,
+        "+\t%s\t%llu\t%d\t%d\t%lu\t%lu\t%.1f\t%.0f\t%s\t%s\t%s\t%d\t%s\t%s\n",
+        name,
+        static_cast<unsigned long long>(entry.size),
+        entry.hasDbg ? 1 : 0,
+        entry.hasMeta ? 1 : 0,
+        static_cast<unsigned long>(entry.meta.durationMs),
+        static_cast<unsigned long>(entry.meta.rowCount),
+        static_cast<double>(entry.meta.maxIasKt),
+        static_cast<double>(entry.meta.maxPaltFt),
+        fw, sha,
+        EfisTypeToString(entry.meta.efisType),
+        entry.meta.gpsFixSeen ? 1 : 0,
+        utc, tod);
+    return Finish(n, buf, bufLen);
+}
+
+size_t LogCatalog::FormatRemove(const char* name, char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    if (!name || name[0] == '\0') {
+        buf[0] = '\0';
+        return 0;
+    }
+    char clean[kLogCatalogNameLen];
+    CopySanitized(clean, sizeof(clean), name);
+    return Finish(std::snprintf(buf, bufLen, "-\t%s\n", clean), buf, bufLen);
+}
+
+} // namespace onspeed::log
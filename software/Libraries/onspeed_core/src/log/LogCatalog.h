@@ -0,0 +1,141 @@
+// LogCatalog.h
+//
+// Incrementally maintained index of the SD card's root-level files, so the
+// /logs page can be served from one sequential read instead of a directory
+// walk plus a .meta open per log.
+//
+// On-card form is an append-only text journal (`logcat.idx`):
+//
+//   onspeed-logcat 1
+//   +<TAB>name<TAB>size<TAB>hasDbg<TAB>hasMeta<TAB>durationMs<TAB>rowCount
+//    <TAB>maxIasKt<TAB>maxPaltFt<TAB>firmware<TAB>firmwareSha<TAB>efisType
+//    <TAB>gpsFixSeen<TAB>utcStart<TAB>timeOfDayStart
+//   -<TAB>name
+//
+// '+' lines insert or replace the entry for `name`; '-' lines drop it.
+// Replaying the journal in order yields the current listing.  The firmware
+// appends one line per change (sidecar refresh, close, rename, delete) and
+// periodically rewrites the file compacted to one '+' line per entry.
+//
+// Only the LogMeta fields /api/logs reports are carried.  A final line
+// without its '\n' (power lost mid-append) is ignored, as are malformed
+// lines, so a torn write loses at most that one update — the next
+// reconcile against the directory listing repairs it.
+//
+// No I/O here; the firmware side lives in
+// software/sketch_common/src/tasks/LogCatalogStore.cpp.
+
+#ifndef ONSPEED_CORE_LOG_LOG_CATALOG_H
+#define ONSPEED_CORE_LOG_LOG_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <log/LogMeta.h>
+
+namespace onspeed::log {
+
+// Root-level journal name and its compaction scratch file.  Both are
+// excluded from the listing like the .meta/.dbg sidecars.
+inline constexpr char kLogCatalogFileName[]    = "logcat.idx";
+inline constexpr char kLogCatalogTmpFileName[] = "logcat.idx.tmp";
+
+// First line of every journal.  Bump the number on any field change; a
+// journal with a different header is discarded and rebuilt.
+inline constexpr char kLogCatalogHeader[] = "onspeed-logcat 1";
+
+// Matches IsSafeLogFilename's 32-char cap plus NUL.
+inline constexpr size_t kLogCatalogNameLen = 33;
+
+// Longest line FormatUpsert can produce, including the '\n'.
+inline constexpr size_t kLogCatalogMaxLineLen = 256;
+
+struct LogCatalogEntry {
+    char     name[kLogCatalogNameLen] = {};
+    uint64_t size    = 0;
+    bool     hasMeta = false;   // .meta present and parsed
+    bool     hasDbg  = false;
+    LogMeta  meta;              // meaningful only when hasMeta
+};
+
+// True for root files that never get their own row: the .meta/.dbg
+// sidecars, the .pvw preview cache (log/LogPreview.h), an interrupted
+// .meta.tmp, and the catalog's own files.
+bool IsLogCatalogHiddenName(const char* name);
+
+// Case-insensitive ASCII name compare; FAT names are case-insensitive.
+bool LogCatalogNameEquals(const char* a, const char* b);
+
+// One root-level file from a directory listing, for LogCatalog::Reconcile.
+struct LogCatalogListedFile {
+    const char* name = nullptr;
+    uint64_t    size = 0;
+};
+
+// Fills `entry` (name and size already set) from the file's sidecars.
+using LogCatalogEntryReader = void (*)(void* ctx, LogCatalogEntry& entry);
+
+class LogCatalog {
+public:
+    // Drop every entry and forget the header; the next ApplyLine must be
+    // the header again.
+    void Reset();
+
+    // Reset, then replay every '\n'-terminated line of `text`.  Returns
+    // false (and leaves the catalog empty) when the first line is not
+    // kLogCatalogHeader.
+    bool Load(std::string_view text);
+
+    // Replay one line without its '\n'.  The first line applied after
+    // Reset() must be the header.  Returns false for a missing header or a
+    // malformed record; malformed records are otherwise ignored.
+    bool ApplyLine(std::string_view line);
+
+    // True once a valid header has been applied.
+    bool Valid() const { return m_bHeaderSeen; }
+
+    // Insert or replace by name (case-insensitive).
+    void Upsert(const LogCatalogEntry& entry);
+
+    // Returns true when `name` was present.
+    bool Remove(const char* name);
+
+    const LogCatalogEntry* Find(const char* name) const;
+
+    // Bring the entries in line with a directory listing: add new files,
+    // refresh resized ones through `read`, drop entries whose file is
+    // gone. Hidden names and names too long for an entry are skipped. A
+    // file whose size is unchanged keeps its entry — every writer that
+    // changes a log's .meta also changes (or journals) the log itself.
+    // Both sides are sorted once and merged, O((n + m) log), so a card
+    // with hundreds of logs is not an n x m name scan. Returns true when
+    // anything changed.
+    bool Reconcile(const LogCatalogListedFile* files, size_t count,
+                   LogCatalogEntryReader read, void* ctx);
+
+    const std::vector<LogCatalogEntry>& Entries() const { return m_entries; }
+
+    // Journal records replayed or applied since Reset().  Once the journal
+    // holds well over one record per live entry, the writer rewrites it.
+    size_t RecordCount() const { return m_uRecords; }
+    bool   NeedsCompaction() const;
+
+    // The three line formatters write one '\n'-terminated line into `buf`
+    // and return its length, or 0 (with buf[0] = NUL) if it did not fit.
+    // Tabs and line breaks inside names or meta strings are replaced with
+    // '_' so a record is always one line.
+    static size_t FormatHeader(char* buf, size_t bufLen);
+    static size_t FormatUpsert(const LogCatalogEntry& entry, char* buf, size_t bufLen);
+    static size_t FormatRemove(const char* name, char* buf, size_t bufLen);
+
+private:
+    std::vector<LogCatalogEntry> m_entries;
+    size_t                       m_uRecords    = 0;
+    bool                         m_bHeaderSeen = false;
+};
+
+} // namespace onspeed::log
+
+#endif
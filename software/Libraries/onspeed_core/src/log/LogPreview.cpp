@@ -0,0 +1,263 @@
+// LogPreview.cpp
+
+#include <log/LogPreview.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace onspeed::log {
+
+namespace {
+
+namespace csv = onspeed::proto::log_csv;
+
+struct ChannelSpec {
+    const char* name;
+    int         decimals;
+};
+
+// Precision matches what a plot can show; Palt and flapsPos are whole numbers.
+constexpr ChannelSpec kChannels[kPreviewChannelCount] = {
+    {"iasKt",     1},
+    {"aoaDeg",    2},
+    {"paltFt",    0},
+    {"verticalG", 3},
+    {"flapsPos",  0},
+};
+
+int ChannelColumn(const csv::HeaderIndex& idx, size_t channel)
+{
+    switch (channel) {
+    case 0:  return idx.idxIasKt;
+    case 1:  return idx.idxAoaDeg;
+    case 2:  return idx.idxPaltFt;
+    case 3:  return idx.idxVerticalG;
+    case 4:  return idx.idxFlapsPos;
+    default: return -1;
+    }
+}
+
+float ChannelValue(const onspeed::LogRow& row, size_t channel)
+{
+    switch (channel) {
+    case 0:  return row.iasKt;
+    case 1:  return row.angleOfAttackDeg;
+    case 2:  return row.paltFt;
+    case 3:  return row.imuVerticalG;
+    case 4:  return static_cast<float>(row.flapsPos);
+    default: return NAN;
+    }
+}
+
+size_t Finish(int n, char* buf, size_t bufLen)
+{
+    if (n < 0 || static_cast<size_t>(n) >= bufLen) {
+        buf[0] = '\0';
+        return 0;
+    }
+    return static_cast<size_t>(n);
+}
+
+// Advance *pos past an snprintf into buf + *pos; false on overflow.
+bool Advance(int n, size_t bufLen, size_t* pos)
+{
+    if (n < 0 || static_cast<size_t>(n) >= bufLen - *pos) return false;
+    *pos += static_cast<size_t>(n);
+    return true;
+}
+
+bool AppendValue(char* buf, size_t bufLen, size_t* pos, int decimals, float v)
+{
+    if (!std::isfinite(v))
+        return Advance(std::snprintf(buf + *pos, bufLen - *pos, ",null"), bufLen, pos);
+    return Advance(std::snprintf(buf + *pos, bufLen - *pos, ",%.*f", decimals,
+                                 static_cast<double>(v)),
+                   bufLen, pos);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+const char* PreviewChannelName(size_t channel)
+{
+    return channel < kPreviewChannelCount ? kChannels[channel].name : nullptr;
+}
+
+size_t ClampPreviewPoints(long requested)
+{
+    if (requested <= 0) return kPreviewDefaultPoints;
+    if (static_cast<unsigned long>(requested) < kPreviewMinPoints) return kPreviewMinPoints;
+    if (static_cast<unsigned long>(requested) > kPreviewMaxPoints) return kPreviewMaxPoints;
+    return static_cast<size_t>(requested);
+}
+
+// ---------------------------------------------------------------------------
+// Builder
+// ---------------------------------------------------------------------------
+
+LogPreviewBuilder::LogPreviewBuilder(size_t points, uint64_t sourceBytes)
+    : m_uSourceBytes(sourceBytes)
+{
+    PreviewBucket empty;
+    for (size_t c = 0; c < kPreviewChannelCount; ++c)
+        empty.min[c] = empty.max[c] = NAN;
+    m_buckets.assign(ClampPreviewPoints(static_cast<long>(points)), empty);
+}
+
+bool LogPreviewBuilder::Begin(std::string_view headerLine, csv::WarnSink warnSink)
+{
+    // Older firmware wrote "timeStamp, Pfwd, ..." with spaces.
+    std::string header;
+    header.reserve(headerLine.size());
+    for (const char c : headerLine)
+        if (c != ' ') header.push_back(c);
+
+    m_bBegun = false;
+    if (!csv::BuildHeaderIndex(header, m_index, warnSink)) return false;
+    for (size_t c = 0; c < kPreviewChannelCount; ++c)
+        if (ChannelColumn(m_index, c) >= 0) m_bBegun = true;
+    return m_bBegun;
+}
+
+void LogPreviewBuilder::OnLine(std::string_view line, uint64_t offset)
+{
+    if (!m_bBegun || offset >= m_uSourceBytes) return;
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+        line.remove_suffix(1);
+    if (line.empty()) return;
+
+    onspeed::LogRow row;
+    if (!csv::ParseRowByIndex(line, m_index, row)) {
+        ++m_uSkipped;
+        return;
+    }
+    OnRow(row, offset);
+}
+
+void LogPreviewBuilder::BeginRows()
+{
+    m_bBegun = true;
+    m_bRows  = true;
+}
+
+void LogPreviewBuilder::OnRow(const onspeed::LogRow& row, uint64_t offset)
+{
+    if (!m_bBegun || offset >= m_uSourceBytes) return;
+    ++m_uRows;
+
+    PreviewBucket& b = m_buckets[static_cast<size_t>(offset * m_buckets.size() / m_uSourceBytes)];
+    if (b.rows++ == 0) b.firstMs = row.timeStampMs;
+    for (size_t c = 0; c < kPreviewChannelCount; ++c) {
+        // Absent columns parse as 0; leave them null instead.
+        if (!m_bRows && ChannelColumn(m_index, c) < 0) continue;
+        const float v = ChannelValue(row, c);
+        if (!std::isfinite(v)) continue;
+        if (std::isnan(b.min[c]) || v < b.min[c]) b.min[c] = v;
+        if (std::isnan(b.max[c]) || v > b.max[c]) b.max[c] = v;
+    }
+}
+
+size_t FeedOslBlocks(LogPreviewBuilder& preview, const uint8_t* in, size_t len,
+                     uint64_t offset, onspeed::proto::log_bin::BlockStatus& status)
+{
+    namespace bin = onspeed::proto::log_bin;
+    size_t pos = 0;
+    for (;;) {
+        bin::BlockView block;
+        size_t consumed = 0;
+        status = bin::DecodeBlock(in + pos, len - pos, block, &consumed);
+        if (status == bin::BlockStatus::BadCrc) {
+            preview.CountSkipped(block.rowCount);
+            pos += consumed;
+            continue;
+        }
+        if (status != bin::BlockStatus::Ok) return pos;
+
+        for (int r = 0; r < block.rowCount; ++r) {
+            onspeed::LogRow row;
+            if (!bin::GetRow(block, r, row)) break;
+            preview.OnRow(row, offset + pos + consumed * static_cast<size_t>(r) / block.rowCount);
+        }
+        pos += consumed;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// JSON
+// ---------------------------------------------------------------------------
+
+size_t FormatPreviewJsonHead(const char* name, const LogPreviewBuilder& preview,
+                             char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    // Names are IsSafeLogFilename-validated by the caller; drop anything
+    // that would need escaping rather than escape it.
+    char clean[64];
+    size_t n = 0;
+    for (const char* p = name ? name : ""; *p != '\0' && n + 1 < sizeof(clean); ++p)
+        if (*p != '"' && *p != '\\' && static_cast<unsigned char>(*p) >= 0x20) clean[n++] = *p;
+    clean[n] = '\0';
+
+    size_t pos = 0;
+    bool ok = Advance(std::snprintf(buf, bufLen,
+        "{\"name\":\"%s\",\"size\":%llu,\"points\":%lu,\"rows\":%lu,\"columns\":[\"tMs\"",
+        clean,
+        static_cast<unsigned long long>(preview.SourceBytes()),
+        static_cast<unsigned long>(preview.Points()),
+        static_cast<unsigned long>(preview.Rows())), bufLen, &pos);
+    for (size_t c = 0; ok && c < kPreviewChannelCount; ++c)
+        ok = Advance(std::snprintf(buf + pos, bufLen - pos, ",\"%sMin\",\"%sMax\"",
+                                   kChannels[c].name, kChannels[c].name), bufLen, &pos);
+    ok = ok && Advance(std::snprintf(buf + pos, bufLen - pos, "],\"data\":["), bufLen, &pos);
+    return Finish(ok ? static_cast<int>(pos) : -1, buf, bufLen);
+}
+
+size_t FormatPreviewJsonBucket(const PreviewBucket& bucket, bool first,
+                               char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    if (bucket.rows == 0) {
+        buf[0] = '\0';
+        return 0;
+    }
+    size_t pos = 0;
+    bool ok = Advance(std::snprintf(buf, bufLen, "%s[%lu", first ? "" : ",",
+                                    static_cast<unsigned long>(bucket.firstMs)), bufLen, &pos);
+    for (size_t c = 0; ok && c < kPreviewChannelCount; ++c) {
+        ok = AppendValue(buf, bufLen, &pos, kChannels[c].decimals, bucket.min[c])
+          && AppendValue(buf, bufLen, &pos, kChannels[c].decimals, bucket.max[c]);
+    }
+    ok = ok && Advance(std::snprintf(buf + pos, bufLen - pos, "]"), bufLen, &pos);
+    return Finish(ok ? static_cast<int>(pos) : -1, buf, bufLen);
+}
+
+size_t FormatPreviewJsonTail(char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    return Finish(std::snprintf(buf, bufLen, "]}"), buf, bufLen);
+}
+
+// ---------------------------------------------------------------------------
+// Sidecar identity
+// ---------------------------------------------------------------------------
+
+size_t FormatPreviewSidecarHeader(const char* etag, size_t points, char* buf, size_t bufLen)
+{
+    if (bufLen == 0) return 0;
+    return Finish(std::snprintf(buf, bufLen, "%s\t%s\t%lu\n", kPreviewSidecarMagic,
+                                etag ? etag : "", static_cast<unsigned long>(points)),
+                  buf, bufLen);
+}
+
+size_t MatchPreviewSidecarHeader(std::string_view head, const char* etag, size_t points)
+{
+    char expect[kPreviewSidecarHeaderMaxLen];
+    const size_t n = FormatPreviewSidecarHeader(etag, points, expect, sizeof(expect));
+    if (n == 0 || head.size() < n) return 0;
+    return head.compare(0, n, std::string_view(expect, n)) == 0 ? n : 0;
+}
+
+} // namespace onspeed::log
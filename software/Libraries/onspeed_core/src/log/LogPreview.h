@@ -0,0 +1,146 @@
+// LogPreview.h
+//
+// Min/max-decimated summary of a flight log — CSV or binary columnar
+// (.osl, proto/LogBin.h) — for plotting a flight in the web UI without
+// downloading the whole file. Pure, no I/O — the firmware feeds lines or
+// blocks from the SD card and streams the formatted JSON; host tests
+// feed strings.
+//
+// Decimation is by byte offset, not row number: point i covers the rows
+// whose line starts in [i * size / points, (i + 1) * size / points).
+// Rows are near-constant width, so this is an even split in time, and it
+// needs neither a row count up front nor a second pass. In a .osl log a
+// block's rows are spread evenly over the block's bytes. Each point keeps
+// the first row's timestamp and, per channel, the min and max over its
+// rows, so spikes shorter than one point survive decimation.
+//
+// Channels: IAS (kt), AOA (deg), Palt (ft), VerticalG (g), flapsPos.
+//
+// JSON shape (one object, points in file order, empty points omitted):
+//
+//   {"name":"log_007.csv","size":123456,"points":1000,"rows":98765,
+//    "columns":["tMs","iasKtMin","iasKtMax",...,"flapsPosMax"],
+//    "data":[[t,min,max,...],...]}
+//
+// A value is null when no row in the point carried a finite reading.
+//
+// Sidecar: the formatted JSON is cached as "<base>.pvw" next to the
+// .meta, behind one identity line ("onspeed-preview 1\t<etag>\t<points>")
+// so a replaced log or a different point count misses the cache.
+
+#ifndef ONSPEED_CORE_LOG_LOG_PREVIEW_H
+#define ONSPEED_CORE_LOG_LOG_PREVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <proto/LogBin.h>
+#include <proto/LogCsvHeaderIndex.h>
+#include <types/LogRow.h>
+
+namespace onspeed::log {
+
+inline constexpr size_t kPreviewChannelCount  = 5;
+inline constexpr size_t kPreviewMinPoints     = 16;
+inline constexpr size_t kPreviewMaxPoints     = 4000;
+inline constexpr size_t kPreviewDefaultPoints = 1000;
+
+inline constexpr const char* kPreviewSidecarExt   = ".pvw";
+inline constexpr const char* kPreviewSidecarMagic = "onspeed-preview 1";
+
+// Longest identity line FormatPreviewSidecarHeader produces.
+inline constexpr size_t kPreviewSidecarHeaderMaxLen = 64;
+
+// Column-name stem of channel `i` ("iasKt", "aoaDeg", "paltFt",
+// "verticalG", "flapsPos"); nullptr past the end.
+const char* PreviewChannelName(size_t channel);
+
+// Map a ?points= argument onto [kPreviewMinPoints, kPreviewMaxPoints];
+// zero or negative means kPreviewDefaultPoints.
+size_t ClampPreviewPoints(long requested);
+
+struct PreviewBucket {
+    uint32_t firstMs = 0;
+    uint32_t rows    = 0;
+    float    min[kPreviewChannelCount];
+    float    max[kPreviewChannelCount];
+};
+
+class LogPreviewBuilder {
+public:
+    // `points` buckets spread over the first `sourceBytes` bytes of the file.
+    LogPreviewBuilder(size_t points, uint64_t sourceBytes);
+
+    // Index the header line. Spaces are ignored, as in replay. Returns
+    // false when BuildHeaderIndex rejects it or it lacks every channel.
+    bool Begin(std::string_view headerLine,
+               onspeed::proto::log_csv::WarnSink warnSink = nullptr);
+
+    // Fold in one data line that starts `offset` bytes into the file.
+    // Lines that fail to parse are counted in SkippedRows() and ignored.
+    void OnLine(std::string_view line, uint64_t offset);
+
+    // Already-decoded rows (.osl logs, see FeedOslBlocks): no header to
+    // index, every channel is a core column. Call BeginRows() instead of
+    // Begin(), then OnRow() per row.
+    void BeginRows();
+    void OnRow(const onspeed::LogRow& row, uint64_t offset);
+    void CountSkipped(uint32_t rows) { m_uSkipped += rows; }
+
+    size_t   Points()      const { return m_buckets.size(); }
+    uint64_t SourceBytes() const { return m_uSourceBytes; }
+    uint32_t Rows()        const { return m_uRows; }
+    uint32_t SkippedRows() const { return m_uSkipped; }
+
+    const std::vector<PreviewBucket>& Buckets() const { return m_buckets; }
+
+private:
+    onspeed::proto::log_csv::HeaderIndex m_index{};
+    std::vector<PreviewBucket>           m_buckets;
+    uint64_t                             m_uSourceBytes = 0;
+    uint32_t                             m_uRows        = 0;
+    uint32_t                             m_uSkipped     = 0;
+    bool                                 m_bBegun       = false;
+    bool                                 m_bRows        = false;   // BeginRows(): all channels present
+};
+
+// Fold every complete block in `in[0, len)` into `preview` (started with
+// BeginRows()). `offset` is the file offset of in[0], which must sit on
+// a block boundary — the caller reads and checks the file header
+// (log_bin::ReadFileHeader) itself. Blocks failing their CRC are skipped
+// and their rows counted as skipped. Returns the bytes consumed; `status`
+// is Truncated when the walk ran out of input (read more, keep the
+// unconsumed tail, call again) and the decode error otherwise.
+size_t FeedOslBlocks(LogPreviewBuilder& preview, const uint8_t* in, size_t len,
+                     uint64_t offset, onspeed::proto::log_bin::BlockStatus& status);
+
+// JSON in three kinds of piece, so the firmware can stream the body and
+// write the sidecar without holding it all in RAM. Each returns bytes
+// written, or 0 (buf[0] = '\0') when `bufLen` is too small. A bucket
+// needs at most kPreviewJsonBucketMaxLen bytes; the head needs the name
+// plus kPreviewJsonHeadMaxLen.
+inline constexpr size_t kPreviewJsonBucketMaxLen = 192;
+inline constexpr size_t kPreviewJsonHeadMaxLen   = 320;
+
+size_t FormatPreviewJsonHead(const char* name, const LogPreviewBuilder& preview,
+                             char* buf, size_t bufLen);
+// Empty buckets format to "" (returns 0 with buf[0] = '\0'). `first`
+// suppresses the leading comma; the caller tracks it across skipped buckets.
+size_t FormatPreviewJsonBucket(const PreviewBucket& bucket, bool first,
+                               char* buf, size_t bufLen);
+size_t FormatPreviewJsonTail(char* buf, size_t bufLen);
+
+// Sidecar identity line, '\n'-terminated. `etag` is the log's download
+// ETag (api/HttpRange.h), which already folds in size and .meta identity.
+size_t FormatPreviewSidecarHeader(const char* etag, size_t points,
+                                  char* buf, size_t bufLen);
+
+// If `head` starts with the identity line for (etag, points), return its
+// length including '\n' (the JSON starts there); otherwise 0.
+size_t MatchPreviewSidecarHeader(std::string_view head, const char* etag, size_t points);
+
+} // namespace onspeed::log
+
+#endif
@@ -0,0 +1,160 @@
+// LogRowCache.cpp
+
+#include <log/LogRowCache.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include <proto/LogCsv.h>
+
+namespace onspeed::log {
+
+namespace csv = onspeed::proto::log_csv;
+
+static_assert(std::is_trivially_copyable_v<onspeed::LogRow>,
+              "row cache stores LogRow bytes verbatim");
+static_assert(std::is_trivially_copyable_v<csv::HeaderIndex>,
+              "row cache stores HeaderIndex bytes verbatim");
+static_assert(alignof(onspeed::LogRow) <= kRowCacheAlign, "row array alignment");
+
+// Header field offsets within the first kRowCacheHeaderBytes.
+//
+//   u32 magic            u16 version          u16 csvFormatVersion
+//   u32 rowBytes         u32 indexBytes       u64 rowCount
+//   u64 srcSize          i64 srcMtimeNs       u64 headerLineOffset
+//   u32 headerLineLength u32 reserved (0), then zero padding to 64
+static constexpr size_t kOffMagic        = 0;
+static constexpr size_t kOffVersion      = 4;
+static constexpr size_t kOffCsvVersion   = 6;
+static constexpr size_t kOffRowBytes     = 8;
+static constexpr size_t kOffIndexBytes   = 12;
+static constexpr size_t kOffRowCount     = 16;
+static constexpr size_t kOffSrcSize      = 24;
+static constexpr size_t kOffSrcMtime     = 32;
+static constexpr size_t kOffHdrLineOff   = 40;
+static constexpr size_t kOffHdrLineLen   = 48;
+static_assert(kOffHdrLineLen + 8 <= kRowCacheHeaderBytes, "header overflow");
+
+namespace {
+
+constexpr size_t AlignUp(size_t n)
+{
+    return (n + kRowCacheAlign - 1) & ~(kRowCacheAlign - 1);
+}
+
+struct Sections {
+    size_t index;
+    size_t rows;
+    size_t lineOffsets;
+    size_t lineLengths;
+    size_t total;
+};
+
+Sections Layout(size_t rowCount)
+{
+    Sections s;
+    s.index       = kRowCacheHeaderBytes;
+    s.rows        = AlignUp(s.index + sizeof(csv::HeaderIndex));
+    s.lineOffsets = AlignUp(s.rows + rowCount * sizeof(onspeed::LogRow));
+    s.lineLengths = AlignUp(s.lineOffsets + rowCount * sizeof(uint64_t));
+    s.total       = AlignUp(s.lineLengths + rowCount * sizeof(uint32_t));
+    return s;
+}
+
+template <typename T>
+void Put(uint8_t* buf, size_t off, T v) { std::memcpy(buf + off, &v, sizeof(v)); }
+
+template <typename T>
+T Get(const uint8_t* buf, size_t off)
+{
+    T v;
+    std::memcpy(&v, buf + off, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+size_t RowCacheBytes(size_t rowCount)
+{
+    return Layout(rowCount).total;
+}
+
+size_t WriteRowCache(const RowCacheImage& image, uint8_t* buf, size_t bufLen)
+{
+    const Sections s = Layout(image.rowCount);
+    if (buf == nullptr || bufLen < s.total) return 0;
+
+    std::memset(buf, 0, s.total);
+    Put<uint32_t>(buf, kOffMagic,      kRowCacheMagic);
+    Put<uint16_t>(buf, kOffVersion,    kRowCacheVersion);
+    Put<uint16_t>(buf, kOffCsvVersion, static_cast<uint16_t>(csv::kFormatVersion));
+    Put<uint32_t>(buf, kOffRowBytes,   static_cast<uint32_t>(sizeof(onspeed::LogRow)));
+    Put<uint32_t>(buf, kOffIndexBytes, static_cast<uint32_t>(sizeof(csv::HeaderIndex)));
+    Put<uint64_t>(buf, kOffRowCount,   static_cast<uint64_t>(image.rowCount));
+    Put<uint64_t>(buf, kOffSrcSize,    image.source.sizeBytes);
+    Put<int64_t> (buf, kOffSrcMtime,   image.source.mtimeNs);
+    Put<uint64_t>(buf, kOffHdrLineOff, image.headerLineOffset);
+    Put<uint32_t>(buf, kOffHdrLineLen, image.headerLineLength);
+
+    std::memcpy(buf + s.index, &image.index, sizeof(csv::HeaderIndex));
+    if (image.rowCount > 0) {
+        std::memcpy(buf + s.rows, image.rows,
+                    image.rowCount * sizeof(onspeed::LogRow));
+        std::memcpy(buf + s.lineOffsets, image.lineOffsets,
+                    image.rowCount * sizeof(uint64_t));
+        std::memcpy(buf + s.lineLengths, image.lineLengths,
+                    image.rowCount * sizeof(uint32_t));
+    }
+    return s.total;
+}
+
+const char* RowCacheStatusName(RowCacheStatus s)
+{
+    switch (s) {
+        case RowCacheStatus::Ok:             return "ok";
+        case RowCacheStatus::Truncated:      return "truncated";
+        case RowCacheStatus::BadMagic:       return "bad magic";
+        case RowCacheStatus::LayoutMismatch: return "layout mismatch";
+        case RowCacheStatus::Stale:          return "stale";
+    }
+    return "unknown";
+}
+
+RowCacheStatus OpenRowCache(const uint8_t* data, size_t len,
+                            const RowCacheSource& expect,
+                            RowCacheImage& out)
+{
+    if (data == nullptr || len < kRowCacheHeaderBytes) return RowCacheStatus::Truncated;
+    if (Get<uint32_t>(data, kOffMagic) != kRowCacheMagic) return RowCacheStatus::BadMagic;
+
+    if (Get<uint16_t>(data, kOffVersion)    != kRowCacheVersion
+     || Get<uint16_t>(data, kOffCsvVersion) != csv::kFormatVersion
+     || Get<uint32_t>(data, kOffRowBytes)   != sizeof(onspeed::LogRow)
+     || Get<uint32_t>(data, kOffIndexBytes) != sizeof(csv::HeaderIndex)) {
+        return RowCacheStatus::LayoutMismatch;
+    }
+
+    // Check the row count against the image length before sizing the
+    // sections with it, so a corrupt count can't overflow Layout().
+    const uint64_t rowCount = Get<uint64_t>(data, kOffRowCount);
+    if (rowCount > len / sizeof(onspeed::LogRow)) return RowCacheStatus::Truncated;
+    const Sections s = Layout(static_cast<size_t>(rowCount));
+    if (len < s.total) return RowCacheStatus::Truncated;
+
+    if (Get<uint64_t>(data, kOffSrcSize)  != expect.sizeBytes
+     || Get<int64_t> (data, kOffSrcMtime) != expect.mtimeNs) {
+        return RowCacheStatus::Stale;
+    }
+
+    out.source           = expect;
+    std::memcpy(&out.index, data + s.index, sizeof(csv::HeaderIndex));
+    out.headerLineOffset = Get<uint64_t>(data, kOffHdrLineOff);
+    out.headerLineLength = Get<uint32_t>(data, kOffHdrLineLen);
+    out.rowCount         = static_cast<size_t>(rowCount);
+    out.rows        = reinterpret_cast<const onspeed::LogRow*>(data + s.rows);
+    out.lineOffsets = reinterpret_cast<const uint64_t*>(data + s.lineOffsets);
+    out.lineLengths = reinterpret_cast<const uint32_t*>(data + s.lineLengths);
+    return RowCacheStatus::Ok;
+}
+
+} // namespace onspeed::log
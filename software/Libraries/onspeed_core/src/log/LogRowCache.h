@@ -0,0 +1,97 @@
+// LogRowCache.h
+//
+// Pure serialization functions for the parsed-row cache sidecar
+// ("<log>.rowcache") that host tools keep next to a CSV log so repeated
+// replays (regression, EKFQ tuning trials, web replay) skip CSV parsing.
+// No I/O — like LogMetaFile, callers own the file handling and pass
+// whole images in and out.
+//
+// Unlike the .meta sidecar this is a binary, host-native image: rows are
+// stored as raw onspeed::LogRow structs so a reader can mmap the file and
+// use the row array in place.  It is a disposable cache, not an
+// interchange format — OpenRowCache rejects anything built by a different
+// layout (struct sizes, CSV format version, byte order) and callers just
+// re-parse the CSV and overwrite it.
+//
+// Image layout (native byte order; every section 64-byte aligned):
+//
+//   RowCacheHeader        (kRowCacheHeaderBytes)
+//   log_csv::HeaderIndex  (the column mask the rows were parsed with)
+//   LogRow[rowCount]      (exactly what ParseRowByIndex produced)
+//   u64 lineOffset[rowCount]   byte offset of each row's CSV line
+//   u32 lineLength[rowCount]   its length (CR trimmed)
+//
+// The line table lets a cache hit still hand out raw CSV text for the
+// few columns a caller wants verbatim (ahrs_tone --passthrough-cols)
+// without re-indexing the whole log.
+//
+// Invalidation: the header records the source CSV's size and mtime at
+// build time; OpenRowCache returns Stale when either differs from what
+// the caller observes now.
+
+#ifndef ONSPEED_CORE_LOG_LOG_ROW_CACHE_H
+#define ONSPEED_CORE_LOG_LOG_ROW_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <proto/LogCsvHeaderIndex.h>
+#include <types/LogRow.h>
+
+namespace onspeed::log {
+
+inline constexpr uint32_t kRowCacheMagic   = 0x4352534Fu;   // "OSRC" read little-endian
+// Bump when LogRow or HeaderIndex change in a way that keeps their size.
+inline constexpr uint16_t kRowCacheVersion = 1;
+
+inline constexpr size_t kRowCacheHeaderBytes = 64;
+inline constexpr size_t kRowCacheAlign       = 64;
+
+// Identity of the CSV the cache was built from.
+struct RowCacheSource {
+    uint64_t sizeBytes = 0;
+    int64_t  mtimeNs   = 0;
+};
+
+// Everything a cache image carries.  On write the pointers are read;
+// on OpenRowCache they alias the caller's image.
+struct RowCacheImage {
+    RowCacheSource                     source;
+    onspeed::proto::log_csv::HeaderIndex index;
+    uint64_t                           headerLineOffset = 0;
+    uint32_t                           headerLineLength = 0;
+    size_t                             rowCount         = 0;
+    const onspeed::LogRow*             rows             = nullptr;
+    const uint64_t*                    lineOffsets      = nullptr;
+    const uint32_t*                    lineLengths      = nullptr;
+};
+
+// Total image size for `rowCount` rows.  Size the write buffer with this.
+size_t RowCacheBytes(size_t rowCount);
+
+// Serialize `image` into `buf`.  Returns bytes written (RowCacheBytes),
+// or 0 when `bufLen` is too small.  `buf` should be 8-byte aligned so
+// the row array can be copied with plain stores; padding is zeroed.
+size_t WriteRowCache(const RowCacheImage& image, uint8_t* buf, size_t bufLen);
+
+enum class RowCacheStatus : uint8_t {
+    Ok,
+    Truncated,        // shorter than its header says
+    BadMagic,         // not a row cache, or foreign byte order
+    LayoutMismatch,   // different version, LogRow/HeaderIndex size, or CSV format
+    Stale,            // source CSV size or mtime changed since the build
+};
+
+const char* RowCacheStatusName(RowCacheStatus s);
+
+// Validate `data` against the source's current identity and, on Ok,
+// fill `out` with views into `data`.  `data` must stay alive (and be
+// at least 8-byte aligned — mmap and operator new both qualify) for as
+// long as `out` is used.
+RowCacheStatus OpenRowCache(const uint8_t* data, size_t len,
+                            const RowCacheSource& expect,
+                            RowCacheImage& out);
+
+} // namespace onspeed::log
+
+#endif
@@ -1,8 +1,9 @@
 // proto/DisplaySerial.cpp — OnSpeed `#1` display-serial protocol implementation.
 //
-// Wire format is documented in DisplaySerial.h. The BuildFrame and ParseFrame
-// functions share a single FieldDef table so offsets, widths, and scales can
-// only be defined in one place.
+// Wire format is documented in DisplaySerial.h. Scaling and clamping happen
+// once, in ComputeWireValues(); the ASCII and binary encoders only differ
+// in how they lay the resulting integers out, and both parsers go back to
+// engineering units through FrameFromWire().
 
 #include <proto/DisplaySerial.h>
 #include <util/Crc.h>
@@ -59,18 +60,28 @@ static unsigned ClampUInt(unsigned value, unsigned minVal, unsigned maxVal)
 }
 
 // ============================================================================
-// BuildDisplayFrame
+// Wire values
+//
+// The 22 clamped integers both encoders transmit, indexed in binary field
+// order (the bit numbers in DisplaySerial.h).
 // ============================================================================
 
-size_t BuildDisplayFrame(const DisplayBuildInputs& in,
-                         uint8_t*                  out,
-                         size_t                    out_capacity)
+enum WireField : size_t
 {
-    if (out == nullptr || out_capacity < kDisplayFrameSizeBytes)
-        return 0;
+    kWPitch10 = 0, kWRoll10, kWIas10, kWPaltFt, kWYaw10, kWLatG100, kWVertG10,
+    kWPctLift10, kWVsi10, kWOatC, kWFpa10, kWFlapsDeg, kWTonesOnPct, kWFastPct,
+    kWSlowPct, kWWarnPct, kWFlapsMin, kWFlapsMax, kWOnset100, kWSpinCue,
+    kWDataMark, kWPipPct, kWFieldCount
+};
 
-    // Compute the clamped integer wire values, exactly as the Gen3 firmware's
-    // DisplaySerial::Write() does, so the output is bit-identical.
+static_assert(kWFieldCount == kDisplayBinFieldCount, "field table out of sync");
+
+using WireValues = int32_t[kDisplayBinFieldCount];
+
+// Compute the clamped integer wire values, exactly as the Gen3 firmware's
+// DisplaySerial::Write() always has, so the ASCII output is bit-identical.
+static void ComputeWireValues(const DisplayBuildInputs& in, WireValues& v)
+{
     const int      iPitch10    = SafeScaledInt(in.pitchDeg,       10.0f,  -999,   999);
     const int      iRoll10     = SafeScaledInt(in.rollDeg,        10.0f, -9999,  9999);
 
@@ -128,6 +139,79 @@ size_t BuildDisplayFrame(const DisplayBuildInputs& in,
     const unsigned uPipPct     = ClampUInt(static_cast<unsigned>(
                                      ClampInt(in.pipPctLift, 0, 99)), 0, 99);
 
+    v[kWPitch10]    = iPitch10;
+    v[kWRoll10]     = iRoll10;
+    v[kWIas10]      = static_cast<int32_t>(uIas10);
+    v[kWPaltFt]     = iPaltFt;
+    v[kWYaw10]      = iYaw10;
+    v[kWLatG100]    = iLatG100;
+    v[kWVertG10]    = iVertG10;
+    v[kWPctLift10]  = static_cast<int32_t>(uPctLift);
+    v[kWVsi10]      = iVsi10;
+    v[kWOatC]       = iOatC;
+    v[kWFpa10]      = iFpa10;
+    v[kWFlapsDeg]   = iFlapsDeg;
+    v[kWTonesOnPct] = static_cast<int32_t>(uTonesOnPct);
+    v[kWFastPct]    = static_cast<int32_t>(uFastPct);
+    v[kWSlowPct]    = static_cast<int32_t>(uSlowPct);
+    v[kWWarnPct]    = static_cast<int32_t>(uWarnPct);
+    v[kWFlapsMin]   = iFlapsMin;
+    v[kWFlapsMax]   = iFlapsMax;
+    v[kWOnset100]   = iOnset100;
+    v[kWSpinCue]    = iSpinCue;
+    v[kWDataMark]   = static_cast<int32_t>(uDataMark2);
+    v[kWPipPct]     = static_cast<int32_t>(uPipPct);
+}
+
+// Reverse the wire scale factors.  Shared by the ASCII and binary parsers.
+static DisplayFrame FrameFromWire(const WireValues& v)
+{
+    DisplayFrame f;
+    f.pitchDeg           = static_cast<float>(v[kWPitch10])  / 10.0f;
+    f.rollDeg            = static_cast<float>(v[kWRoll10])   / 10.0f;
+    // iasKt: detect the kIasInvalidWireSentinel and surface it as
+    // iasIsValid=false rather than as a 999.9 kt reading.  The raw
+    // iasKt field is left set to whatever the wire carried so a
+    // diagnostic consumer can still see it; the contract is
+    // "consumers must check iasIsValid before trusting iasKt".
+    f.iasKt              = static_cast<float>(v[kWIas10])    / 10.0f;
+    f.iasIsValid         = (v[kWIas10] != kIasInvalidWireSentinel);
+    f.paltFt             = static_cast<float>(v[kWPaltFt]);
+    f.turnRateDps        = static_cast<float>(v[kWYaw10])    / 10.0f;
+    f.lateralG           = static_cast<float>(v[kWLatG100])  / 100.0f;
+    f.verticalG          = static_cast<float>(v[kWVertG10])  / 10.0f;
+    f.percentLiftPct     = static_cast<float>(v[kWPctLift10]) / 10.0f;
+    f.vsiFpm             = static_cast<float>(v[kWVsi10])    * 10.0f;
+    f.oatC               = v[kWOatC];
+    f.flightPathDeg      = static_cast<float>(v[kWFpa10])    / 10.0f;
+    f.flapsDeg           = v[kWFlapsDeg];
+    f.tonesOnPctLift     = v[kWTonesOnPct];
+    f.onSpeedFastPctLift = v[kWFastPct];
+    f.onSpeedSlowPctLift = v[kWSlowPct];
+    f.stallWarnPctLift   = v[kWWarnPct];
+    f.flapsMinDeg        = v[kWFlapsMin];
+    f.flapsMaxDeg        = v[kWFlapsMax];
+    f.gOnsetRate         = static_cast<float>(v[kWOnset100]) / 100.0f;
+    f.spinRecoveryCue    = v[kWSpinCue];
+    f.dataMark           = v[kWDataMark];
+    f.pipPctLift         = v[kWPipPct];
+    return f;
+}
+
+// ============================================================================
+// BuildDisplayFrame
+// ============================================================================
+
+size_t BuildDisplayFrame(const DisplayBuildInputs& in,
+                         uint8_t*                  out,
+                         size_t                    out_capacity)
+{
+    if (out == nullptr || out_capacity < kDisplayFrameSizeBytes)
+        return 0;
+
+    WireValues v;
+    ComputeWireValues(in, v);
+
     // Build the kDisplayFrameChecksumLen-byte ASCII payload into a local
     // staging buffer.  The staging buffer is generously sized so the
     // compiler cannot complain about theoretical truncation with
@@ -139,28 +223,28 @@ size_t BuildDisplayFrame(const DisplayBuildInputs& in,
         staging,
         sizeof(staging),
         "#1%+04i%+05i%04u%+06i%+05i%+03i%+03i%03u%+04i%+03i%+04i%+03i%02u%02u%02u%02u%+03i%+03i%+04i%+02i%02u%02u",
-        iPitch10,
-        iRoll10,
-        uIas10,
-        iPaltFt,
-        iYaw10,
-        iLatG100,
-        iVertG10,
-        uPctLift,
-        iVsi10,
-        iOatC,
-        iFpa10,
-        iFlapsDeg,
-        uTonesOnPct,
-        uFastPct,
-        uSlowPct,
-        uWarnPct,
-        iFlapsMin,
-        iFlapsMax,
-        iOnset100,
-        iSpinCue,
-        uDataMark2,
-        uPipPct);
+        static_cast<int>(v[kWPitch10]),
+        static_cast<int>(v[kWRoll10]),
+        static_cast<unsigned>(v[kWIas10]),
+        static_cast<int>(v[kWPaltFt]),
+        static_cast<int>(v[kWYaw10]),
+        static_cast<int>(v[kWLatG100]),
+        static_cast<int>(v[kWVertG10]),
+        static_cast<unsigned>(v[kWPctLift10]),
+        static_cast<int>(v[kWVsi10]),
+        static_cast<int>(v[kWOatC]),
+        static_cast<int>(v[kWFpa10]),
+        static_cast<int>(v[kWFlapsDeg]),
+        static_cast<unsigned>(v[kWTonesOnPct]),
+        static_cast<unsigned>(v[kWFastPct]),
+        static_cast<unsigned>(v[kWSlowPct]),
+        static_cast<unsigned>(v[kWWarnPct]),
+        static_cast<int>(v[kWFlapsMin]),
+        static_cast<int>(v[kWFlapsMax]),
+        static_cast<int>(v[kWOnset100]),
+        static_cast<int>(v[kWSpinCue]),
+        static_cast<unsigned>(v[kWDataMark]),
+        static_cast<unsigned>(v[kWPipPct]));
 
     if (iChars != static_cast<int>(kDisplayFrameChecksumLen))
         return 0;
@@ -291,37 +375,220 @@ std::optional<DisplayFrame> ParseDisplayFrame(const uint8_t* buf, size_t len)
     if (!extractUInt(69, 2, &uDataMark))    return std::nullopt;
     if (!extractUInt(71, 2, &uPipPct))      return std::nullopt;
 
-    DisplayFrame f;
-    f.pitchDeg           = static_cast<float>(iPitch10)  / 10.0f;
-    f.rollDeg            = static_cast<float>(iRoll10)   / 10.0f;
-    // iasKt: detect the kIasInvalidWireSentinel and surface it as
-    // iasIsValid=false rather than as a 999.9 kt reading.  The raw
-    // iasKt field is left set to whatever the wire carried so a
-    // diagnostic consumer can still see it; the contract is
-    // "consumers must check iasIsValid before trusting iasKt".
-    f.iasKt              = static_cast<float>(uIas10)    / 10.0f;
-    f.iasIsValid         = (uIas10 != kIasInvalidWireSentinel);
-    f.paltFt             = static_cast<float>(iPaltFt);
-    f.turnRateDps        = static_cast<float>(iYaw10)    / 10.0f;
-    f.lateralG           = static_cast<float>(iLatG100)  / 100.0f;
-    f.verticalG          = static_cast<float>(iVertG10)  / 10.0f;
-    f.percentLiftPct     = static_cast<float>(uPctLift) / 10.0f;
-    f.vsiFpm             = static_cast<float>(iVsi10)    * 10.0f;
-    f.oatC               = iOatC;
-    f.flightPathDeg      = static_cast<float>(iFpa10)    / 10.0f;
-    f.flapsDeg           = iFlapsDeg;
-    f.tonesOnPctLift     = static_cast<int>(uTonesOnPct);
-    f.onSpeedFastPctLift = static_cast<int>(uFastPct);
-    f.onSpeedSlowPctLift = static_cast<int>(uSlowPct);
-    f.stallWarnPctLift   = static_cast<int>(uWarnPct);
-    f.flapsMinDeg        = iFlapsMin;
-    f.flapsMaxDeg        = iFlapsMax;
-    f.gOnsetRate         = static_cast<float>(iOnset100)     / 100.0f;
-    f.spinRecoveryCue    = iSpinCue;
-    f.dataMark           = static_cast<int>(uDataMark);
-    f.pipPctLift         = static_cast<int>(uPipPct);
+    const WireValues v = {
+        iPitch10, iRoll10, static_cast<int32_t>(uIas10), iPaltFt, iYaw10,
+        iLatG100, iVertG10, static_cast<int32_t>(uPctLift), iVsi10, iOatC,
+        iFpa10, iFlapsDeg, static_cast<int32_t>(uTonesOnPct),
+        static_cast<int32_t>(uFastPct), static_cast<int32_t>(uSlowPct),
+        static_cast<int32_t>(uWarnPct), iFlapsMin, iFlapsMax, iOnset100,
+        iSpinCue, static_cast<int32_t>(uDataMark), static_cast<int32_t>(uPipPct)
+    };
+    return FrameFromWire(v);
+}
 
-    return f;
+// ============================================================================
+// Binary frame
+// ============================================================================
+
+// Bytes per field on the binary wire, and whether it sign-extends.  Ranges
+// follow the clamps in ComputeWireValues(); paltFt (±99999) is the only
+// field that needs more than 16 bits.
+static constexpr uint8_t kBinFieldBytes[kDisplayBinFieldCount] = {
+    2, 2, 2, 4, 2, 1, 1, 2, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 2, 1, 1, 1
+};
+static constexpr bool kBinFieldSigned[kDisplayBinFieldCount] = {
+    true,  true,  false, true,  true,  true,  true,  false, true,  true,  true,
+    true,  false, false, false, false, true,  true,  true,  true,  false, false
+};
+
+static constexpr size_t SumFieldBytes()
+{
+    size_t n = 0;
+    for (uint8_t b : kBinFieldBytes) n += b;
+    return n;
+}
+static_assert(SumFieldBytes() == kDisplayBinKeyPayloadBytes,
+              "kDisplayBinKeyPayloadBytes out of sync with the field table");
+
+static uint8_t* PutLE(uint8_t* p, uint32_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+        *p++ = static_cast<uint8_t>(value >> (8 * i));
+    return p;
+}
+
+static uint32_t GetLE(const uint8_t* p, size_t bytes)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes; ++i)
+        value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+static int32_t GetField(const uint8_t* p, size_t field)
+{
+    const size_t   bytes = kBinFieldBytes[field];
+    const uint32_t raw   = GetLE(p, bytes);
+    if (kBinFieldSigned[field] && bytes < 4) {
+        const uint32_t signBit = 1u << (8 * bytes - 1);
+        return static_cast<int32_t>((raw ^ signBit)) - static_cast<int32_t>(signBit);
+    }
+    return static_cast<int32_t>(raw);
+}
+
+// Validate sync, length and CRC.  On success `payload` / `payloadLen`
+// point into `buf`.
+static bool CheckBinaryFrame(const uint8_t* buf, size_t len,
+                             const uint8_t** payload, size_t* payloadLen)
+{
+    if (buf == nullptr || len < kDisplayBinHeaderBytes + kDisplayBinCrcBytes)
+        return false;
+    if (buf[0] != kDisplayBinSync0 || buf[1] != kDisplayBinSync1)
+        return false;
+    const size_t n = buf[4];
+    if (len != kDisplayBinHeaderBytes + n + kDisplayBinCrcBytes)
+        return false;
+    const uint16_t crc = util::Crc16Ccitt(buf + 2, kDisplayBinHeaderBytes - 2 + n);
+    if (GetLE(buf + kDisplayBinHeaderBytes + n, 2) != crc)
+        return false;
+    *payload    = buf + kDisplayBinHeaderBytes;
+    *payloadLen = n;
+    return true;
+}
+
+static bool DecodeKeyPayload(const uint8_t* p, size_t n, WireValues& v)
+{
+    if (n != kDisplayBinKeyPayloadBytes)
+        return false;
+    for (size_t i = 0; i < kDisplayBinFieldCount; ++i) {
+        v[i] = GetField(p, i);
+        p += kBinFieldBytes[i];
+    }
+    return true;
+}
+
+// Apply a delta payload to `v` in place; `v` is untouched on failure.
+static bool DecodeDeltaPayload(const uint8_t* p, size_t n, WireValues& v)
+{
+    if (n < kDisplayBinMaskBytes)
+        return false;
+    const uint32_t mask = GetLE(p, kDisplayBinMaskBytes);
+    if ((mask >> kDisplayBinFieldCount) != 0)
+        return false;
+
+    size_t need = kDisplayBinMaskBytes;
+    for (size_t i = 0; i < kDisplayBinFieldCount; ++i)
+        if (mask & (1u << i)) need += kBinFieldBytes[i];
+    if (n != need)
+        return false;
+
+    p += kDisplayBinMaskBytes;
+    for (size_t i = 0; i < kDisplayBinFieldCount; ++i) {
+        if (!(mask & (1u << i))) continue;
+        v[i] = GetField(p, i);
+        p += kBinFieldBytes[i];
+    }
+    return true;
+}
+
+DisplayBinaryEncoder::DisplayBinaryEncoder(unsigned keyframeInterval)
+    : last_{}
+    , interval_(keyframeInterval < 1 ? 1 : keyframeInterval)
+    , sinceKey_(0)
+    , seq_(0)
+{
+}
+
+size_t DisplayBinaryEncoder::Encode(const DisplayBuildInputs& in,
+                                    uint8_t*                  out,
+                                    size_t                    out_capacity)
+{
+    if (out == nullptr || out_capacity < kDisplayBinMaxFrameBytes)
+        return 0;
+
+    WireValues v;
+    ComputeWireValues(in, v);
+
+    const bool key = (sinceKey_ == 0);
+    uint8_t*   p   = out + kDisplayBinHeaderBytes;
+    if (key) {
+        for (size_t i = 0; i < kDisplayBinFieldCount; ++i)
+            p = PutLE(p, static_cast<uint32_t>(v[i]), kBinFieldBytes[i]);
+    }
+    else {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kDisplayBinFieldCount; ++i)
+            if (v[i] != last_[i]) mask |= 1u << i;
+        p = PutLE(p, mask, kDisplayBinMaskBytes);
+        for (size_t i = 0; i < kDisplayBinFieldCount; ++i)
+            if (mask & (1u << i))
+                p = PutLE(p, static_cast<uint32_t>(v[i]), kBinFieldBytes[i]);
+    }
+
+    const size_t payloadLen = static_cast<size_t>(p - (out + kDisplayBinHeaderBytes));
+    out[0] = kDisplayBinSync0;
+    out[1] = kDisplayBinSync1;
+    out[2] = key ? kDisplayBinTypeKey : kDisplayBinTypeDelta;
+    out[3] = seq_;
+    out[4] = static_cast<uint8_t>(payloadLen);
+    const uint16_t crc = util::Crc16Ccitt(out + 2, kDisplayBinHeaderBytes - 2 + payloadLen);
+    p = PutLE(p, crc, kDisplayBinCrcBytes);
+
+    std::memcpy(last_, v, sizeof(last_));
+    ++seq_;
+    sinceKey_ = (sinceKey_ + 1) % interval_;
+    return static_cast<size_t>(p - out);
+}
+
+DisplayBinaryDecoder::DisplayBinaryDecoder()
+    : base_{}
+    , lastSeq_(0)
+    , haveBase_(false)
+{
+}
+
+std::optional<DisplayFrame> DisplayBinaryDecoder::Decode(const uint8_t* buf, size_t len)
+{
+    const uint8_t* payload    = nullptr;
+    size_t         payloadLen = 0;
+    if (!CheckBinaryFrame(buf, len, &payload, &payloadLen))
+        return std::nullopt;
+
+    const uint8_t type = buf[2];
+    const uint8_t seq  = buf[3];
+    if (type == kDisplayBinTypeKey) {
+        if (!DecodeKeyPayload(payload, payloadLen, base_))
+            return std::nullopt;
+    }
+    else if (type == kDisplayBinTypeDelta) {
+        // A gap means the base no longer matches what the producer
+        // diffed against; hold off until the next keyframe.
+        if (!haveBase_ || seq != static_cast<uint8_t>(lastSeq_ + 1)) {
+            haveBase_ = false;
+            return std::nullopt;
+        }
+        if (!DecodeDeltaPayload(payload, payloadLen, base_))
+            return std::nullopt;
+    }
+    else {
+        return std::nullopt;
+    }
+
+    haveBase_ = true;
+    lastSeq_  = seq;
+    return FrameFromWire(base_);
+}
+
+std::optional<DisplayFrame> ParseDisplayFrameBinary(const uint8_t* buf, size_t len)
+{
+    const uint8_t* payload    = nullptr;
+    size_t         payloadLen = 0;
+    if (!CheckBinaryFrame(buf, len, &payload, &payloadLen) || buf[2] != kDisplayBinTypeKey)
+        return std::nullopt;
+    WireValues v;
+    if (!DecodeKeyPayload(payload, payloadLen, v))
+        return std::nullopt;
+    return FrameFromWire(v);
 }
 
 // ============================================================================
@@ -330,16 +597,52 @@ std::optional<DisplayFrame> ParseDisplayFrame(const uint8_t* buf, size_t len)
 
 DisplayFrameAccumulator::DisplayFrameAccumulator()
     : length_(0)
+    , binaryLength_(0)
+    , binary_(false)
 {
 }
 
 void DisplayFrameAccumulator::Reset()
 {
-    length_ = 0;
+    length_       = 0;
+    binaryLength_ = 0;
+    binary_       = false;
 }
 
 std::optional<DisplayFrame> DisplayFrameAccumulator::Inject(uint8_t byte)
 {
+    // Binary frame in progress: payload bytes are arbitrary, so neither
+    // '#' nor 0xA5 means anything until the declared length is in.
+    if (binary_) {
+        if (length_ == 1 && byte != kDisplayBinSync1) {
+            Reset();   // false sync; look at this byte afresh below
+        }
+        else {
+            buffer_[length_++] = byte;
+            if (length_ == kDisplayBinHeaderBytes) {
+                binaryLength_ = kDisplayBinHeaderBytes + byte + kDisplayBinCrcBytes;
+                if (binaryLength_ > kDisplayBinMaxFrameBytes) {
+                    Reset();
+                    return std::nullopt;
+                }
+            }
+            if (length_ < kDisplayBinHeaderBytes || length_ < binaryLength_)
+                return std::nullopt;
+
+            auto result = binDecoder_.Decode(buffer_, length_);
+            Reset();
+            return result;
+        }
+    }
+
+    // 0xA5 never occurs in an ASCII frame, so it always starts a binary one.
+    if (byte == kDisplayBinSync0) {
+        buffer_[0] = byte;
+        length_    = 1;
+        binary_    = true;
+        return std::nullopt;
+    }
+
     // Any '#' byte resets to start-of-frame. This catches the case
     // where a partial frame was abandoned mid-stream and the next
     // good frame starts arriving.
@@ -95,9 +95,20 @@
 // widths, scales, or clamp ranges is a protocol change and requires a
 // simultaneous flash of both firmwares.
 //
+// Binary variant (SERIALOUTFORMAT = ONSPEED_BIN):
+//   The same 22 clamped wire values, packed little-endian at 100 Hz
+//   instead of printed at 20 Hz, behind a sync word and a CRC-16.  A
+//   keyframe carries every field; the frames between keyframes carry
+//   only the fields whose wire value changed since the previous frame
+//   (an unchanged frame is an 11-byte heartbeat).  See the "Binary
+//   frame" section below.  The display link has no return path, so
+//   there is no handshake: the producer's config picks the format and
+//   DisplayFrameAccumulator recognises either one per frame.
+//
 // Used by:
 //   Gen3 firmware: software/sketch_common/src/io/DisplaySerial.cpp
 //   M5 firmware:   software/OnSpeed-M5-Display/src/SerialRead.cpp
+//   X-Plane:       software/OnSpeed-XPlane-Plugin/src/m5_indexer/IndexerWindow.cpp
 
 #ifndef ONSPEED_CORE_PROTO_DISPLAY_SERIAL_H
 #define ONSPEED_CORE_PROTO_DISPLAY_SERIAL_H
@@ -243,15 +254,138 @@ size_t BuildDisplayFrame(const DisplayBuildInputs& in,
 
 std::optional<DisplayFrame> ParseDisplayFrame(const uint8_t* buf, size_t len);
 
+// ============================================================================
+// Binary frame
+//
+//   Offset  Width  Field
+//   ------  -----  ----------------------------------------------------
+//    0       1     sync0    0xA5 (never appears in an ASCII #1 frame)
+//    1       1     sync1    0x5A
+//    2       1     type     0x01 keyframe, 0x02 delta
+//    3       1     seq      increments by one per frame, wraps at 255
+//    4       1     len      payload length in bytes
+//    5       len   payload
+//    5+len   2     crc      Crc16Ccitt over type..payload, little-endian
+//
+// Payload fields, in bit / field order (LE two's complement, same wire
+// scale and clamp as the ASCII column of the same name):
+//
+//   Bit  Field               Bytes      Bit  Field               Bytes
+//    0   pitchDeg ×10        i16        11   flapsDeg            i8
+//    1   rollDeg ×10         i16        12   tonesOnPctLift      u8
+//    2   iasKt ×10           u16        13   onSpeedFastPctLift  u8
+//    3   paltFt              i32        14   onSpeedSlowPctLift  u8
+//    4   turnRateDps ×10     i16        15   stallWarnPctLift    u8
+//    5   lateralG ×100       i8         16   flapsMinDeg         i8
+//    6   verticalG ×10       i8         17   flapsMaxDeg         i8
+//    7   percentLift ×10     u16        18   gOnsetRate ×100     i16
+//    8   vsiFpm10            i16        19   spinRecoveryCue     i8
+//    9   oatC                i8         20   dataMark            u8
+//   10   flightPathDeg ×10   i16        21   pipPctLift          u8
+//
+// A keyframe payload is all 22 fields in order (33 bytes).  A delta
+// payload is a u32 field mask followed by just the fields whose bit is
+// set, in order.  A delta only applies on top of the frame with the
+// previous seq; after a gap (a dropped or corrupt frame) the decoder
+// discards deltas until the next keyframe, which the encoder emits every
+// kDisplayBinKeyframeInterval frames.
+// ============================================================================
+
+inline constexpr uint8_t  kDisplayBinSync0           = 0xA5;
+inline constexpr uint8_t  kDisplayBinSync1           = 0x5A;
+inline constexpr uint8_t  kDisplayBinTypeKey         = 0x01;
+inline constexpr uint8_t  kDisplayBinTypeDelta       = 0x02;
+inline constexpr size_t   kDisplayBinHeaderBytes     = 5;
+inline constexpr size_t   kDisplayBinCrcBytes        = 2;
+inline constexpr size_t   kDisplayBinFieldCount      = 22;
+inline constexpr size_t   kDisplayBinKeyPayloadBytes = 33;
+inline constexpr size_t   kDisplayBinMaskBytes       = 4;
+
+/// Largest binary frame: a delta with every bit set.
+inline constexpr size_t kDisplayBinMaxFrameBytes =
+    kDisplayBinHeaderBytes + kDisplayBinMaskBytes + kDisplayBinKeyPayloadBytes +
+    kDisplayBinCrcBytes;
+
+/// Nominal binary frame period (milliseconds). Matches
+/// kDisplaySerialBinPeriodMs in the Gen3 firmware's HardwareMap.h.
+inline constexpr int kDisplayBinFramePeriodMs = 10;
+
+/// Frames per keyframe: one keyframe and nine deltas, i.e. a lost
+/// frame costs at most 100 ms of display updates at 100 Hz.
+inline constexpr unsigned kDisplayBinKeyframeInterval = 10;
+
+// ----------------------------------------------------------------------------
+// DisplayBinaryEncoder — producer side.  Remembers the previous frame's
+// wire values and sequence number; Encode() picks keyframe or delta.
+// ----------------------------------------------------------------------------
+
+class DisplayBinaryEncoder {
+public:
+    /// `keyframeInterval` is clamped to at least 1 (every frame a keyframe).
+    explicit DisplayBinaryEncoder(unsigned keyframeInterval = kDisplayBinKeyframeInterval);
+
+    /// Encode `in` into `out`.  Returns the frame length, or 0 when
+    /// `out` is null or smaller than kDisplayBinMaxFrameBytes.
+    size_t Encode(const DisplayBuildInputs& in, uint8_t* out, size_t out_capacity);
+
+    /// Make the next Encode() a keyframe (e.g. after a UART reopen).
+    void ForceKeyframe() { sinceKey_ = 0; }
+
+    /// Sequence number the next frame will carry.
+    uint8_t NextSeq() const { return seq_; }
+
+private:
+    int32_t  last_[kDisplayBinFieldCount];
+    unsigned interval_;
+    unsigned sinceKey_;
+    uint8_t  seq_;
+};
+
+// ----------------------------------------------------------------------------
+// DisplayBinaryDecoder — consumer side.  Holds the last decoded wire
+// values so deltas can be applied.
+// ----------------------------------------------------------------------------
+
+class DisplayBinaryDecoder {
+public:
+    DisplayBinaryDecoder();
+
+    /// Forget the base frame; deltas are dropped until the next keyframe.
+    void Reset() { haveBase_ = false; }
+
+    /// Decode one complete binary frame (sync through CRC).  Returns
+    /// std::nullopt on bad sync, type, length or CRC, on a mask bit
+    /// beyond the field table, and on a delta without a base frame or
+    /// whose seq does not follow the previous frame's.
+    std::optional<DisplayFrame> Decode(const uint8_t* buf, size_t len);
+
+    /// True once a keyframe has been decoded and no gap seen since.
+    bool HasBase() const { return haveBase_; }
+
+private:
+    int32_t base_[kDisplayBinFieldCount];
+    uint8_t lastSeq_;
+    bool    haveBase_;
+};
+
+/// Stateless decode of a single binary keyframe (deltas need a
+/// DisplayBinaryDecoder and return std::nullopt here).
+std::optional<DisplayFrame> ParseDisplayFrameBinary(const uint8_t* buf, size_t len);
+
 // ============================================================================
 // DisplayFrameAccumulator — byte-stream framing
 //
 // State machine that consumes the byte stream emitted by Gen3's
 // DisplaySerial::Write() one byte at a time, returning a parsed
-// DisplayFrame on the byte that completes a valid frame.
+// DisplayFrame on the byte that completes a valid frame.  Accepts ASCII
+// #1 frames and binary frames, interleaved freely.
 //
 // Logic:
-//   - Any '#' byte resets the accumulator to start-of-frame.
+//   - A 0xA5 byte outside a binary frame starts a binary frame; it is
+//     collected through its length byte and CRC, then handed to an
+//     internal DisplayBinaryDecoder.  Anything but 0x5A after the 0xA5
+//     abandons it.
+//   - Any other '#' byte resets the accumulator to ASCII start-of-frame.
 //   - After start-of-frame, bytes are accumulated until the buffer
 //     reaches kDisplayFrameSizeBytes.
 //   - On the final byte (LF), if the buffer starts with "#1" and ends
@@ -274,7 +408,7 @@ public:
     void Reset();
 
     /// Feed one byte. Returns a parsed frame on the byte that
-    /// completes a valid #1 frame; otherwise nullopt.
+    /// completes a valid #1 or binary frame; otherwise nullopt.
     std::optional<DisplayFrame> Inject(uint8_t byte);
 
     /// True if a partial frame is currently being accumulated.
@@ -283,9 +417,18 @@ public:
     /// Number of bytes currently in the buffer.
     size_t Length() const { return length_; }
 
+    /// True while the frame in progress is a binary one.
+    bool InBinaryFrame() const { return binary_; }
+
 private:
-    uint8_t buffer_[kDisplayFrameSizeBytes];
-    size_t  length_;
+    static_assert(kDisplayBinMaxFrameBytes <= kDisplayFrameSizeBytes,
+                  "binary frames share the ASCII frame buffer");
+
+    uint8_t              buffer_[kDisplayFrameSizeBytes];
+    size_t               length_;
+    size_t               binaryLength_;   // total bytes of the binary frame, once len is seen
+    bool                 binary_;
+    DisplayBinaryDecoder binDecoder_;
 };
 
 }   // namespace onspeed::proto
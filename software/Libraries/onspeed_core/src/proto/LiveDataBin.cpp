@@ -0,0 +1,152 @@
+// proto/LiveDataBin.cpp — binary LiveView WebSocket frame implementation.
+//
+// Wire format is documented in LiveDataBin.h.  The encoder and decoder walk
+// the same two member tables, so the field order is defined in one place;
+// offsets follow from the table order.
+
+#include <proto/LiveDataBin.h>
+
+#include <cstring>
+
+namespace onspeed::proto {
+
+namespace {
+
+constexpr size_t kHeaderBytes = 4;   // version, reserved, dataMark
+
+// f32 fields, in wire order starting at offset kHeaderBytes.
+constexpr float LiveDataFrame::* kFloatFields[] = {
+    &LiveDataFrame::aoaDeg,
+    &LiveDataFrame::pitchDeg,
+    &LiveDataFrame::rollDeg,
+    &LiveDataFrame::iasKt,
+    &LiveDataFrame::paltFt,
+    &LiveDataFrame::verticalG,
+    &LiveDataFrame::lateralG,
+    &LiveDataFrame::coeffP,
+    &LiveDataFrame::vsiFpm,
+    &LiveDataFrame::flightPathDeg,
+    &LiveDataFrame::pitchRateDps,
+    &LiveDataFrame::decelRate,
+    &LiveDataFrame::oatC,
+    &LiveDataFrame::derivedAoaDeg,
+    &LiveDataFrame::gOnsetRate,
+    &LiveDataFrame::percentLift,
+    &LiveDataFrame::ekfBpDps,
+    &LiveDataFrame::ekfBqDps,
+    &LiveDataFrame::ekfBrDps,
+    &LiveDataFrame::ekfBAzMps2,
+    &LiveDataFrame::ekfBetaDeg,
+    &LiveDataFrame::ekfYawDeg,
+};
+
+// i16 fields, in wire order after the floats.
+constexpr int LiveDataFrame::* kInt16Fields[] = {
+    &LiveDataFrame::flapsPos,
+    &LiveDataFrame::flapIndex,
+    &LiveDataFrame::flapsMinDeg,
+    &LiveDataFrame::flapsMaxDeg,
+    &LiveDataFrame::tonesOnPctLift,
+    &LiveDataFrame::onSpeedFastPctLift,
+    &LiveDataFrame::onSpeedSlowPctLift,
+    &LiveDataFrame::stallWarnPctLift,
+    &LiveDataFrame::pipPctLift,
+};
+
+constexpr size_t kFloatCount = sizeof(kFloatFields) / sizeof(kFloatFields[0]);
+constexpr size_t kInt16Count = sizeof(kInt16Fields) / sizeof(kInt16Fields[0]);
+
+static_assert(kHeaderBytes + 4 * kFloatCount + 2 * kInt16Count == kLiveDataBinFrameSizeBytes,
+              "LiveDataBin field tables disagree with kLiveDataBinFrameSizeBytes");
+
+void PutU16(uint8_t* p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+uint16_t GetU16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+void PutF32(uint8_t* p, float f)
+{
+    uint32_t v;
+    std::memcpy(&v, &f, sizeof(v));
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+float GetF32(const uint8_t* p)
+{
+    const uint32_t v = static_cast<uint32_t>(p[0])
+                     | (static_cast<uint32_t>(p[1]) << 8)
+                     | (static_cast<uint32_t>(p[2]) << 16)
+                     | (static_cast<uint32_t>(p[3]) << 24);
+    float f;
+    std::memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+int16_t SaturateInt16(int v)
+{
+    if (v < INT16_MIN) return INT16_MIN;
+    if (v > INT16_MAX) return INT16_MAX;
+    return static_cast<int16_t>(v);
+}
+
+} // namespace
+
+size_t BuildLiveDataBinFrame(const LiveDataFrame& in,
+                             uint8_t*             out,
+                             size_t               out_capacity)
+{
+    if (out == nullptr || out_capacity < kLiveDataBinFrameSizeBytes)
+        return 0;
+
+    out[0] = kLiveDataBinVersion;
+    out[1] = 0;
+    PutU16(out + 2, static_cast<uint16_t>(in.dataMark));
+
+    uint8_t* p = out + kHeaderBytes;
+    for (const auto field : kFloatFields)
+    {
+        PutF32(p, in.*field);
+        p += 4;
+    }
+    for (const auto field : kInt16Fields)
+    {
+        PutU16(p, static_cast<uint16_t>(SaturateInt16(in.*field)));
+        p += 2;
+    }
+    return kLiveDataBinFrameSizeBytes;
+}
+
+std::optional<LiveDataFrame> ParseLiveDataBinFrame(const uint8_t* buf, size_t len)
+{
+    if (buf == nullptr || len < kLiveDataBinFrameSizeBytes)
+        return std::nullopt;
+    if (buf[0] != kLiveDataBinVersion)
+        return std::nullopt;
+
+    LiveDataFrame f;
+    f.dataMark = GetU16(buf + 2);
+
+    const uint8_t* p = buf + kHeaderBytes;
+    for (const auto field : kFloatFields)
+    {
+        f.*field = GetF32(p);
+        p += 4;
+    }
+    for (const auto field : kInt16Fields)
+    {
+        f.*field = static_cast<int16_t>(GetU16(p));
+        p += 2;
+    }
+    return f;
+}
+
+} // namespace onspeed::proto
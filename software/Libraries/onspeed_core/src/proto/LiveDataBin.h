@@ -0,0 +1,160 @@
+// proto/LiveDataBin.h — binary LiveView WebSocket frame.
+//
+// The port-81 WebSocket (software/sketch_common/src/web_server/
+// DataServer.cpp) carries the same live-data record in one of two
+// encodings, chosen per client:
+//
+//   * JSON text frames — the default; see LiveDataJsonKeys.h.
+//   * This fixed-layout binary frame — sent only to a client that has
+//     opted in by sending the text message kLiveDataBinSelectMsg.  A
+//     firmware that does not know the message ignores it and keeps
+//     sending JSON, so a client must accept both frame types.
+//
+// The binary frame carries the JSON fields one-for-one (same names, same
+// units) without the ~30 snprintf conversions per tick, and is roughly a
+// quarter of the JSON's size on the air.
+//
+// Frame format (v1, 110 bytes, all multi-byte fields little-endian):
+//
+//   Offset  Type     Field                JSON key
+//   ------  -------  -------------------  -------------------
+//    0      u8       version              — (kLiveDataBinVersion)
+//    1      u8       reserved             — (0)
+//    2      u16      dataMark             dataMark (low 16 bits)
+//    4      f32      aoaDeg               AOA            *
+//    8      f32      pitchDeg             Pitch
+//   12      f32      rollDeg              Roll
+//   16      f32      iasKt                IAS            *
+//   20      f32      paltFt               PAlt
+//   24      f32      verticalG            verticalGLoad
+//   28      f32      lateralG             lateralGLoad
+//   32      f32      coeffP               coeffP
+//   36      f32      vsiFpm               vsiFpm
+//   40      f32      flightPathDeg        flightPath
+//   44      f32      pitchRateDps         PitchRate
+//   48      f32      decelRate            DecelRate      *
+//   52      f32      oatC                 OAT
+//   56      f32      derivedAoaDeg        DerivedAOA     *
+//   60      f32      gOnsetRate           gOnsetRate
+//   64      f32      percentLift          percentLift    *
+//   68      f32      ekfBpDps             ekfBpDps       *
+//   72      f32      ekfBqDps             ekfBqDps       *
+//   76      f32      ekfBrDps             ekfBrDps       *
+//   80      f32      ekfBAzMps2           ekfBAzMps2     *
+//   84      f32      ekfBetaDeg           ekfBetaDeg     *
+//   88      f32      ekfYawDeg            ekfYawDeg      *
+//   92      i16      flapsPos             flapsPos
+//   94      i16      flapIndex            flapIndex
+//   96      i16      flapsMinDeg          flapsMinDeg
+//   98      i16      flapsMaxDeg          flapsMaxDeg
+//  100      i16      tonesOnPctLift       tonesOnPctLift
+//  102      i16      onSpeedFastPctLift   onSpeedFastPctLift
+//  104      i16      onSpeedSlowPctLift   onSpeedSlowPctLift
+//  106      i16      stallWarnPctLift     stallWarnPctLift
+//  108      i16      pipPctLift           pipPctLift
+//
+//   * = nullable.  NaN on the wire is the binary spelling of JSON `null`
+//   (air data invalid, or the EKFQ-only states under Madgwick).  The
+//   producer zeroes the non-nullable floats on NaN exactly as the JSON
+//   path does, so a decoder can map every NaN to null.
+//
+// Versioning: any change to offsets, types or the field set bumps
+// kLiveDataBinVersion and the select message together.  A decoder drops
+// frames whose version byte it does not know; the server keeps a client
+// on JSON when it asks for a version the firmware does not speak.
+//
+// Used by:
+//   Gen3 firmware: software/sketch_common/src/web_server/DataServer.cpp
+//   Web UI:        tools/web/lib/ws/wsClient.js (decodeLiveDataBin)
+
+#ifndef ONSPEED_CORE_PROTO_LIVE_DATA_BIN_H
+#define ONSPEED_CORE_PROTO_LIVE_DATA_BIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace onspeed::proto {
+
+/// Schema version carried in byte 0 of every binary frame.
+inline constexpr uint8_t kLiveDataBinVersion = 1;
+
+/// Total length of a v1 frame in bytes.
+inline constexpr size_t kLiveDataBinFrameSizeBytes = 110;
+
+/// Text message a client sends to switch its connection to v1 binary
+/// frames, and the one that switches it back to JSON.
+inline constexpr char kLiveDataBinSelectMsg[]  = "fmt:bin1";
+inline constexpr char kLiveDataJsonSelectMsg[] = "fmt:json";
+
+// ============================================================================
+// LiveDataFrame — one tick of LiveView data in engineering units.
+//
+// DataServer fills this once per tick from the published snapshots and
+// hands it to both encoders.  Nullable fields hold NaN when the JSON
+// emits `null`; the defaults are the "nothing known" frame.
+// ============================================================================
+
+struct LiveDataFrame {
+    static constexpr float kNull = std::numeric_limits<float>::quiet_NaN();
+
+    float aoaDeg             = kNull;  // body-angle AOA (deg); NaN when !bIasAlive
+    float pitchDeg           = 0.0f;
+    float rollDeg            = 0.0f;
+    float iasKt              = kNull;  // NaN when !bIasAlive
+    float paltFt             = 0.0f;
+    float verticalG          = 0.0f;   // EMA-smoothed body-vertical G
+    float lateralG           = 0.0f;   // body-frame, positive = rightward
+    float coeffP             = 0.0f;
+    float vsiFpm             = 0.0f;
+    float flightPathDeg      = 0.0f;
+    float pitchRateDps       = 0.0f;
+    float decelRate          = kNull;  // kt/s; NaN when !bIasAlive
+    float oatC               = 0.0f;
+    float derivedAoaDeg      = kNull;  // NaN when !bIasAlive
+    float gOnsetRate         = 0.0f;
+    float percentLift        = kNull;  // whole percent; NaN when !bIasAlive
+    float ekfBpDps           = kNull;  // EKFQ states; NaN under Madgwick
+    float ekfBqDps           = kNull;
+    float ekfBrDps           = kNull;
+    float ekfBAzMps2         = kNull;
+    float ekfBetaDeg         = kNull;
+    float ekfYawDeg          = kNull;
+    int   flapsPos           = 0;
+    int   flapIndex          = 0;
+    int   flapsMinDeg        = 0;
+    int   flapsMaxDeg        = 33;
+    int   tonesOnPctLift     = 0;
+    int   onSpeedFastPctLift = 0;
+    int   onSpeedSlowPctLift = 0;
+    int   stallWarnPctLift   = 0;
+    int   pipPctLift         = 0;
+    int   dataMark           = 0;
+};
+
+// ============================================================================
+// BuildLiveDataBinFrame
+//
+// Encodes `in` into `out`.  Integer fields saturate to the int16 range;
+// dataMark keeps its low 16 bits.  Returns kLiveDataBinFrameSizeBytes, or
+// 0 if `out_capacity` is too small.
+// ============================================================================
+
+size_t BuildLiveDataBinFrame(const LiveDataFrame& in,
+                             uint8_t*             out,
+                             size_t               out_capacity);
+
+// ============================================================================
+// ParseLiveDataBinFrame
+//
+// Decodes a frame produced by BuildLiveDataBinFrame.  Returns std::nullopt
+// if len < kLiveDataBinFrameSizeBytes or the version byte is not
+// kLiveDataBinVersion.
+// ============================================================================
+
+std::optional<LiveDataFrame> ParseLiveDataBinFrame(const uint8_t* buf, size_t len);
+
+} // namespace onspeed::proto
+
+#endif // ONSPEED_CORE_PROTO_LIVE_DATA_BIN_H
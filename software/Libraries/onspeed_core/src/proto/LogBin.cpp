@@ -0,0 +1,513 @@
+// proto/LogBin.cpp — binary columnar SD log format
+//
+// See proto/LogBin.h for the file layout and compatibility rules.  The
+// column table below is append-only: a column's index is its bit in the
+// block presence bitmap.
+
+#include <proto/LogBin.h>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <proto/LogCsv.h>
+#include <util/Crc.h>
+
+namespace onspeed::proto::log_bin {
+
+// LogRow must stay standard-layout for offsetof() on its members.
+static_assert(std::is_standard_layout_v<onspeed::LogRow>,
+              "LogRow must remain standard-layout; LogBin addresses its "
+              "members by offsetof().");
+
+#define LB_COL(name, type, group, member) \
+    { name, ColType::type, ColGroup::group, \
+      static_cast<uint16_t>(offsetof(onspeed::LogRow, member)) }
+
+constexpr ColumnDesc kColumns[kColumnCount] = {
+    // --- Core (always present) ---
+    LB_COL("timeStamp",          U32, Core, timeStampMs),
+    LB_COL("timeStampUs",        U64, Core, timeStampUs),
+    LB_COL("Pfwd",               I32, Core, pfwdCounts),
+    LB_COL("PfwdSmoothed",       F32, Core, pfwdSmoothed),
+    LB_COL("P45",                I32, Core, p45Counts),
+    LB_COL("P45Smoothed",        F32, Core, p45Smoothed),
+    LB_COL("PStatic",            F32, Core, pStaticMbar),
+    LB_COL("Palt",               F32, Core, paltFt),
+    LB_COL("IAS",                F32, Core, iasKt),
+    LB_COL("AngleofAttack",      F32, Core, angleOfAttackDeg),
+    LB_COL("flapsPos",           I32, Core, flapsPos),
+    LB_COL("DataMark",           I32, Core, dataMark),
+    LB_COL("OAT",                F32, Core, oatCelsius),
+    LB_COL("TAS",                F32, Core, tasKt),
+    LB_COL("imuTemp",            F32, Core, imuTempCelsius),
+    LB_COL("VerticalG",          F32, Core, imuVerticalG),
+    LB_COL("LateralG",           F32, Core, imuLateralG),
+    LB_COL("ForwardG",           F32, Core, imuForwardG),
+    LB_COL("RollRate",           F32, Core, imuRollRateDps),
+    // Raw (un-negated) gyro value; FormatRow applies the PitchRate flip.
+    LB_COL("PitchRate",          F32, Core, imuPitchRateDps),
+    LB_COL("YawRate",            F32, Core, imuYawRateDps),
+    LB_COL("Pitch",              F32, Core, pitchDeg),
+    LB_COL("Roll",               F32, Core, rollDeg),
+
+    // --- Boom ---
+    LB_COL("boomStatic",         F32, Boom, boomStatic),
+    LB_COL("boomDynamic",        F32, Boom, boomDynamic),
+    LB_COL("boomAlpha",          F32, Boom, boomAlpha),
+    LB_COL("boomBeta",           F32, Boom, boomBeta),
+    LB_COL("boomIAS",            F32, Boom, boomIasKt),
+    LB_COL("boomAge",            I32, Boom, boomAgeMs),
+
+    // --- EFIS (non-VN-300) ---
+    LB_COL("efisIAS",            F32, Efis, efisIasKt),
+    LB_COL("efisPitch",          F32, Efis, efisPitchDeg),
+    LB_COL("efisRoll",           F32, Efis, efisRollDeg),
+    LB_COL("efisLateralG",       F32, Efis, efisLateralG),
+    LB_COL("efisVerticalG",      F32, Efis, efisVerticalG),
+    LB_COL("efisPercentLift",    I32, Efis, efisPercentLift),
+    LB_COL("efisPalt",           I32, Efis, efisPaltFt),
+    LB_COL("efisVSI",            I32, Efis, efisVsiFpm),
+    LB_COL("efisTAS",            F32, Efis, efisTasKt),
+    LB_COL("efisOAT",            F32, Efis, efisOatCelsius),
+    LB_COL("efisFuelRemaining",  F32, Efis, efisFuelRemaining),
+    LB_COL("efisFuelFlow",       F32, Efis, efisFuelFlow),
+    LB_COL("efisMAP",            F32, Efis, efisMap),
+    LB_COL("efisRPM",            I32, Efis, efisRpm),
+    LB_COL("efisPercentPower",   I32, Efis, efisPercentPower),
+    LB_COL("efisMagHeading",     I32, Efis, efisMagHeading),
+    LB_COL("efisAge",            I32, Efis, efisAgeMs),
+    LB_COL("efisTime",           U32, Efis, efisTimestampMs),
+
+    // --- VN-300 ---
+    LB_COL("vnAngularRateRoll",  F32, Vn300, vnAngularRateRoll),
+    LB_COL("vnAngularRatePitch", F32, Vn300, vnAngularRatePitch),
+    LB_COL("vnAngularRateYaw",   F32, Vn300, vnAngularRateYaw),
+    LB_COL("vnVelNedNorth",      F32, Vn300, vnVelNedNorth),
+    LB_COL("vnVelNedEast",       F32, Vn300, vnVelNedEast),
+    LB_COL("vnVelNedDown",       F32, Vn300, vnVelNedDown),
+    LB_COL("vnAccelFwd",         F32, Vn300, vnAccelFwd),
+    LB_COL("vnAccelLat",         F32, Vn300, vnAccelLat),
+    LB_COL("vnAccelVert",        F32, Vn300, vnAccelVert),
+    LB_COL("vnYaw",              F32, Vn300, vnYawDeg),
+    LB_COL("vnPitch",            F32, Vn300, vnPitchDeg),
+    LB_COL("vnRoll",             F32, Vn300, vnRollDeg),
+    LB_COL("vnLinAccFwd",        F32, Vn300, vnLinAccFwd),
+    LB_COL("vnLinAccLat",        F32, Vn300, vnLinAccLat),
+    LB_COL("vnLinAccVert",       F32, Vn300, vnLinAccVert),
+    LB_COL("vnYawSigma",         F32, Vn300, vnYawSigma),
+    LB_COL("vnRollSigma",        F32, Vn300, vnRollSigma),
+    LB_COL("vnPitchSigma",       F32, Vn300, vnPitchSigma),
+    LB_COL("vnGnssVelNedNorth",  F32, Vn300, vnGnssVelNedNorth),
+    LB_COL("vnGnssVelNedEast",   F32, Vn300, vnGnssVelNedEast),
+    LB_COL("vnGnssVelNedDown",   F32, Vn300, vnGnssVelNedDown),
+    LB_COL("vnWindSpd",          F32, Vn300, vnWindSpd),
+    LB_COL("vnWindDir",          F32, Vn300, vnWindDir),
+    LB_COL("vnWindVertical",     F32, Vn300, vnWindVertical),
+    LB_COL("vnGnssLat",          F64, Vn300, vnGnssLat),
+    LB_COL("vnGnssLon",          F64, Vn300, vnGnssLon),
+    LB_COL("vnEstAltFt",         F32, Vn300, vnEstAltFt),
+    LB_COL("vnGPSFix",           I32, Vn300, vnGpsFix),
+    LB_COL("vnDataAge",          I32, Vn300, vnDataAgeMs),
+    LB_COL("vnTimeStartupNs",    U64, Vn300, vnTimeStartupNs),
+    LB_COL("vnTimeGpsNs",        U64, Vn300, vnTimeGpsNs),
+    LB_COL("vnTimeStatus",       U8,  Vn300, vnTimeStatus),
+
+    // --- Post-EFIS derived (always present) ---
+    LB_COL("EarthVerticalG",     F32, Derived, earthVerticalG),
+    LB_COL("FlightPath",         F32, Derived, flightPathDeg),
+    LB_COL("VSI",                F32, Derived, vsiFpm),
+    LB_COL("Altitude",           F32, Derived, altitudeFt),
+    LB_COL("DerivedAOA",         F32, Derived, derivedAoaDeg),
+    LB_COL("CoeffP",             F32, Derived, coeffP),
+
+    // --- EKFQ diagnostics (always present) ---
+    LB_COL("ekfBpDps",           F32, Ekf, ekfBpDps),
+    LB_COL("ekfBqDps",           F32, Ekf, ekfBqDps),
+    LB_COL("ekfBrDps",           F32, Ekf, ekfBrDps),
+    LB_COL("ekfBAzMps2",         F32, Ekf, ekfBAzMps2),
+    LB_COL("ekfBetaDeg",         F32, Ekf, ekfBetaDeg),
+    LB_COL("ekfYawDeg",          F32, Ekf, ekfYawDeg),
+
+    // --- Tail-optional raw flap-pot ADC ---
+    LB_COL("flapsRawADC",        U16, FlapsRawAdc, flapsRawAdc),
+
+    // --- Per-row validity bits (not CSV columns; FormatRow reads them) ---
+    LB_COL("iasValid",             Bool, Flags, iasValid),
+    LB_COL("efisPercentLiftValid", Bool, Flags, efisPercentLiftValid),
+};
+
+#undef LB_COL
+
+namespace {
+
+constexpr size_t TypeBytes(ColType t)
+{
+    switch (t) {
+        case ColType::Bool: return 1;
+        case ColType::U8:   return 1;
+        case ColType::U16:  return 2;
+        case ColType::I32:  return 4;
+        case ColType::U32:  return 4;
+        case ColType::U64:  return 8;
+        case ColType::F32:  return 4;
+        case ColType::F64:  return 8;
+    }
+    return 0;
+}
+
+constexpr size_t GroupBytes(ColGroup g)
+{
+    size_t n = 0;
+    for (const ColumnDesc& c : kColumns)
+        if (c.group == g) n += TypeBytes(c.type);
+    return n;
+}
+
+// EFIS and VN-300 never share a row, so the widest row carries the
+// larger of the two.
+constexpr size_t kWidestRowBytes =
+    GroupBytes(ColGroup::Core) + GroupBytes(ColGroup::Boom) +
+    (GroupBytes(ColGroup::Vn300) > GroupBytes(ColGroup::Efis)
+         ? GroupBytes(ColGroup::Vn300) : GroupBytes(ColGroup::Efis)) +
+    GroupBytes(ColGroup::Derived) + GroupBytes(ColGroup::Ekf) +
+    GroupBytes(ColGroup::FlapsRawAdc) + GroupBytes(ColGroup::Flags);
+static_assert(kWidestRowBytes <= kMaxRowBytes,
+              "kMaxRowBytes too small for the column table");
+
+// Whether `row`'s feature flags select group `g`.
+inline bool GroupPresent(const onspeed::LogRow& row, ColGroup g)
+{
+    switch (g) {
+        case ColGroup::Boom:        return row.boomEnabled;
+        case ColGroup::Efis:        return row.efisEnabled && !row.efisIsVn300;
+        case ColGroup::Vn300:       return row.efisEnabled && row.efisIsVn300;
+        case ColGroup::FlapsRawAdc: return row.flapsRawAdcPresent;
+        case ColGroup::Core:
+        case ColGroup::Derived:
+        case ColGroup::Ekf:
+        case ColGroup::Flags:       return true;
+    }
+    return false;
+}
+
+inline bool BitSet(const uint64_t presence[2], int i)
+{
+    return (presence[i >> 6] >> (i & 63)) & 1u;
+}
+
+void PresenceFor(const onspeed::LogRow& row, uint64_t presence[2])
+{
+    presence[0] = presence[1] = 0;
+    for (int i = 0; i < kColumnCount; ++i)
+        if (GroupPresent(row, kColumns[i].group))
+            presence[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+// Little-endian integer store / load.  Both targets are little-endian,
+// and these compile to a plain store there; spelling them out keeps the
+// on-disk format defined independently of the host.
+inline void PutU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+inline void PutU32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+inline void PutU64(uint8_t* p, uint64_t v) { for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i)); }
+inline uint16_t GetU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t GetU32(const uint8_t* p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+inline uint64_t GetU64(const uint8_t* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+// Copy one LogRow member to its little-endian on-disk bytes.  Floats go
+// through their bit pattern so NaN payloads survive the round trip.
+void StoreValue(const ColumnDesc& c, const onspeed::LogRow& row, uint8_t* dst)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(&row) + c.offset;
+    switch (c.type) {
+        case ColType::Bool: { bool b;     std::memcpy(&b, src, 1); dst[0] = b ? 1 : 0; break; }
+        case ColType::U8:   dst[0] = src[0]; break;
+        case ColType::U16:  { uint16_t v; std::memcpy(&v, src, 2); PutU16(dst, v); break; }
+        case ColType::I32:
+        case ColType::U32:
+        case ColType::F32:  { uint32_t v; std::memcpy(&v, src, 4); PutU32(dst, v); break; }
+        case ColType::U64:
+        case ColType::F64:  { uint64_t v; std::memcpy(&v, src, 8); PutU64(dst, v); break; }
+    }
+}
+
+void LoadValue(const ColumnDesc& c, const uint8_t* src, onspeed::LogRow& row)
+{
+    uint8_t* dst = reinterpret_cast<uint8_t*>(&row) + c.offset;
+    switch (c.type) {
+        case ColType::Bool: { const bool b = src[0] != 0; std::memcpy(dst, &b, 1); break; }
+        case ColType::U8:   dst[0] = src[0]; break;
+        case ColType::U16:  { const uint16_t v = GetU16(src); std::memcpy(dst, &v, 2); break; }
+        case ColType::I32:
+        case ColType::U32:
+        case ColType::F32:  { const uint32_t v = GetU32(src); std::memcpy(dst, &v, 4); break; }
+        case ColType::U64:
+        case ColType::F64:  { const uint64_t v = GetU64(src); std::memcpy(dst, &v, 8); break; }
+    }
+}
+
+}   // anonymous namespace
+
+size_t ColTypeBytes(ColType t)
+{
+    return TypeBytes(t);
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+size_t WriteFileHeader(const onspeed::LogRow& sessionRow,
+                       uint8_t* out, size_t outCapacity)
+{
+    if (out == nullptr || outCapacity < kFileHeaderBytes)
+        return 0;
+
+    uint32_t flags = 0;
+    if (sessionRow.boomEnabled)        flags |= kSessionBoom;
+    if (sessionRow.efisEnabled)        flags |= kSessionEfis;
+    if (sessionRow.efisIsVn300)        flags |= kSessionVn300;
+    if (sessionRow.flapsRawAdcPresent) flags |= kSessionFlapsRawAdc;
+
+    PutU32(out + 0,  kFileMagic);
+    PutU16(out + 4,  kBinVersion);
+    PutU16(out + 6,  static_cast<uint16_t>(log_csv::kFormatVersion));
+    PutU32(out + 8,  flags);
+    PutU32(out + 12, 0);
+    return kFileHeaderBytes;
+}
+
+void BlockEncoder::Reset()
+{
+    m_presence[0] = m_presence[1] = 0;
+    m_rowBytes = 0;
+    m_rowCount = 0;
+}
+
+bool BlockEncoder::Append(const onspeed::LogRow& row)
+{
+    if (Full())
+        return false;
+
+    uint64_t presence[2];
+    PresenceFor(row, presence);
+
+    if (m_rowCount == 0) {
+        // First row fixes the block's column set and per-column offsets.
+        m_presence[0] = presence[0];
+        m_presence[1] = presence[1];
+        size_t start = 0;
+        for (int i = 0; i < kColumnCount; ++i) {
+            if (!BitSet(m_presence, i)) continue;
+            m_colStart[i] = static_cast<uint16_t>(start);
+            start += TypeBytes(kColumns[i].type);
+        }
+        m_rowBytes = start;
+    } else if (presence[0] != m_presence[0] || presence[1] != m_presence[1]) {
+        return false;
+    }
+
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (!BitSet(m_presence, i)) continue;
+        const size_t w = TypeBytes(kColumns[i].type);
+        StoreValue(kColumns[i], row,
+                   m_data + (size_t)m_colStart[i] * kRowsPerBlock +
+                            (size_t)m_rowCount * w);
+    }
+    ++m_rowCount;
+    return true;
+}
+
+size_t BlockEncoder::EncodedBytes() const
+{
+    return m_rowCount == 0
+        ? 0
+        : kBlockHeaderBytes + m_rowBytes * (size_t)m_rowCount;
+}
+
+size_t BlockEncoder::Finish(uint8_t* out, size_t outCapacity)
+{
+    const size_t total = EncodedBytes();
+    if (total == 0 || out == nullptr || outCapacity < total)
+        return 0;
+
+    // Pack each column's first m_rowCount values back to back.
+    uint8_t* payload = out + kBlockHeaderBytes;
+    size_t pos = 0;
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (!BitSet(m_presence, i)) continue;
+        const size_t n = TypeBytes(kColumns[i].type) * (size_t)m_rowCount;
+        std::memcpy(payload + pos,
+                    m_data + (size_t)m_colStart[i] * kRowsPerBlock, n);
+        pos += n;
+    }
+
+    PutU32(out + 0,  kBlockMagic);
+    PutU16(out + 4,  kBinVersion);
+    PutU16(out + 6,  static_cast<uint16_t>(m_rowCount));
+    PutU64(out + 8,  m_presence[0]);
+    PutU64(out + 16, m_presence[1]);
+    PutU32(out + 24, static_cast<uint32_t>(pos));
+    PutU32(out + 28, util::Crc32(payload, pos));
+
+    Reset();
+    return total;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+bool ReadFileHeader(const uint8_t* in, size_t len, FileInfo& out)
+{
+    if (in == nullptr || len < kFileHeaderBytes)
+        return false;
+    if (GetU32(in) != kFileMagic)
+        return false;
+    out.binVersion       = GetU16(in + 4);
+    out.csvFormatVersion = GetU16(in + 6);
+    out.sessionFlags     = GetU32(in + 8);
+    return out.binVersion >= 1 && out.binVersion <= kBinVersion;
+}
+
+onspeed::LogRow SessionRow(const FileInfo& info)
+{
+    onspeed::LogRow row;
+    row.boomEnabled        = (info.sessionFlags & kSessionBoom) != 0;
+    row.efisEnabled        = (info.sessionFlags & kSessionEfis) != 0;
+    row.efisIsVn300        = (info.sessionFlags & kSessionVn300) != 0;
+    row.flapsRawAdcPresent = (info.sessionFlags & kSessionFlapsRawAdc) != 0;
+    return row;
+}
+
+BlockStatus DecodeBlock(const uint8_t* in, size_t len,
+                        BlockView& out, size_t* consumed)
+{
+    if (consumed != nullptr) *consumed = 0;
+    if (in == nullptr || len < kBlockHeaderBytes)
+        return BlockStatus::Truncated;
+    if (GetU32(in) != kBlockMagic)
+        return BlockStatus::BadMagic;
+    const uint16_t version = GetU16(in + 4);
+    if (version < 1 || version > kBinVersion)
+        return BlockStatus::BadVersion;
+
+    out.rowCount     = GetU16(in + 6);
+    out.presence[0]  = GetU64(in + 8);
+    out.presence[1]  = GetU64(in + 16);
+    out.payloadBytes = GetU32(in + 24);
+    const uint32_t crc = GetU32(in + 28);
+
+    // Bits past the table are columns a newer writer added.
+    for (int i = kColumnCount; i < 128; ++i)
+        if (BitSet(out.presence, i))
+            return BlockStatus::UnknownColumn;
+
+    size_t rowBytes = 0;
+    for (int i = 0; i < kColumnCount; ++i)
+        if (BitSet(out.presence, i))
+            rowBytes += TypeBytes(kColumns[i].type);
+    if (out.rowCount == 0 || out.rowCount > kRowsPerBlock ||
+        rowBytes * out.rowCount != out.payloadBytes)
+        return BlockStatus::BadLength;
+
+    if (len - kBlockHeaderBytes < out.payloadBytes)
+        return BlockStatus::Truncated;
+
+    // The header is self-consistent from here on, so report the block's
+    // extent even when the payload fails its CRC — the caller may skip it.
+    if (consumed != nullptr) *consumed = kBlockHeaderBytes + out.payloadBytes;
+
+    out.payload = in + kBlockHeaderBytes;
+    if (util::Crc32(out.payload, out.payloadBytes) != crc)
+        return BlockStatus::BadCrc;
+    return BlockStatus::Ok;
+}
+
+bool GetRow(const BlockView& block, int rowIdx, onspeed::LogRow& row)
+{
+    if (rowIdx < 0 || rowIdx >= block.rowCount || block.payload == nullptr)
+        return false;
+
+    const uint8_t* col = block.payload;
+    bool group[8] = {};
+    for (int i = 0; i < kColumnCount; ++i) {
+        if (!BitSet(block.presence, i)) continue;
+        const size_t w = TypeBytes(kColumns[i].type);
+        LoadValue(kColumns[i], col + (size_t)rowIdx * w, row);
+        group[static_cast<int>(kColumns[i].group)] = true;
+        col += w * block.rowCount;
+    }
+
+    row.boomEnabled        = group[static_cast<int>(ColGroup::Boom)];
+    row.efisIsVn300        = group[static_cast<int>(ColGroup::Vn300)];
+    row.efisEnabled        = group[static_cast<int>(ColGroup::Efis)] || row.efisIsVn300;
+    row.flapsRawAdcPresent = group[static_cast<int>(ColGroup::FlapsRawAdc)];
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// CSV export
+// ---------------------------------------------------------------------------
+
+bool ExportCsv(const uint8_t* in, size_t len,
+               LineSink sink, void* ctx, ExportResult* result)
+{
+    ExportResult local;
+    ExportResult& r = (result != nullptr) ? *result : local;
+    r = ExportResult{};
+
+    FileInfo info;
+    if (sink == nullptr || !ReadFileHeader(in, len, info))
+        return false;
+
+    char line[log_csv::kRowMaxBytes];
+    size_t n = log_csv::WriteHeader(SessionRow(info), line, sizeof(line));
+    if (n == 0 || !sink(ctx, line, n))
+        return false;
+
+    size_t pos = kFileHeaderBytes;
+    while (pos < len) {
+        BlockView block;
+        size_t used = 0;
+        const BlockStatus st = DecodeBlock(in + pos, len - pos, block, &used);
+        if (st == BlockStatus::BadCrc) {
+            // Corrupt payload behind an intact header: drop the block's
+            // rows (at most kRowsPerBlock) and resync on the next one.
+            if (r.status == BlockStatus::Ok) r.status = st;
+            ++r.skippedBlocks;
+            pos += used;
+            continue;
+        }
+        if (st != BlockStatus::Ok) {
+            if (r.status == BlockStatus::Ok) r.status = st;
+            break;
+        }
+        for (int i = 0; i < block.rowCount; ++i) {
+            onspeed::LogRow row;
+            GetRow(block, i, row);
+            n = log_csv::FormatRow(row, line, sizeof(line));
+            if (n == 0 || !sink(ctx, line, n)) {
+                r.bytesConsumed = pos;
+                return false;
+            }
+            ++r.rows;
+        }
+        ++r.blocks;
+        pos += used;
+    }
+    r.bytesConsumed = pos;
+    return true;
+}
+
+}   // namespace onspeed::proto::log_bin
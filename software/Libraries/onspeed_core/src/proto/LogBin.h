@@ -0,0 +1,238 @@
+// proto/LogBin.h — binary columnar SD log format (".osl")
+//
+// Alternative on-card encoding of the same LogRow stream that LogCsv.h
+// formats as text.  At 208 Hz the CSV path spends most of the commit
+// task's CPU in FormatRow and writes ~600-1000 bytes per row; the binary
+// path copies each logged LogRow field verbatim (at most 313 bytes, for
+// a VN-300 + boom row) and defers CSV formatting to the host, where
+// ExportCsv regenerates byte-identical CSV through the unchanged
+// WriteHeader/FormatRow pair.
+//
+// File layout (all integers little-endian):
+//
+//   FileHeader  (16 bytes)
+//     u32  magic              'O','S','L','B'
+//     u16  binVersion         kBinVersion
+//     u16  csvFormatVersion   log_csv::kFormatVersion of the writer
+//     u32  sessionFlags       kSession* bits (column groups at Open())
+//     u32  reserved           0
+//
+//   Block  (repeated until EOF)
+//     BlockHeader  (32 bytes)
+//       u32  magic            'O','S','B','K'
+//       u16  binVersion       kBinVersion
+//       u16  rowCount         1..kRowsPerBlock
+//       u64  presence[2]      bit i set = kColumns[i] stored in this block
+//       u32  payloadBytes     rowCount * (sum of present column widths)
+//       u32  payloadCrc32     util::Crc32 over the payload
+//     payload
+//       column-major: every row's value for the first present column,
+//       then every row's value for the next, in kColumns order.
+//
+// Column-major blocks keep each column's bytes contiguous so a reader
+// that only needs a few columns (IAS, AOA, Palt) touches a fraction of
+// the payload, and so future compression sees runs of like values.
+//
+// Compatibility rules:
+//   - kColumns is APPEND-ONLY.  A column's bit index is its position in
+//     the table; reordering would silently re-map old files.
+//   - A decoder rejects a block whose presence bitmap names a column it
+//     does not know (bit index >= kColumnCount).  New columns therefore
+//     need a kBinVersion bump only if older readers must keep working.
+//   - Bump kBinVersion when the header layouts or the meaning of an
+//     existing column change.
+//
+// A power-yank mid-block leaves a truncated final block; DecodeBlock
+// reports it as Truncated and ExportCsv stops cleanly after the last
+// complete block.
+
+#ifndef ONSPEED_CORE_PROTO_LOG_BIN_H
+#define ONSPEED_CORE_PROTO_LOG_BIN_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <types/LogRow.h>
+
+namespace onspeed::proto::log_bin {
+
+inline constexpr uint32_t kFileMagic  = 0x424C534Fu;   // "OSLB"
+inline constexpr uint32_t kBlockMagic = 0x4B42534Fu;   // "OSBK"
+inline constexpr uint16_t kBinVersion = 1;
+
+inline constexpr size_t kFileHeaderBytes  = 16;
+inline constexpr size_t kBlockHeaderBytes = 32;
+
+// Rows per block.  32 rows is ~150 ms at 208 Hz and ~10 KB of payload
+// for the widest (VN-300) row — one SD flush worth of data, and small
+// enough that a power-yank loses no more than the CSV staging buffer
+// would.
+inline constexpr int kRowsPerBlock = 32;
+
+// sessionFlags bits — mirror the LogRow feature flags WriteHeader reads.
+inline constexpr uint32_t kSessionBoom        = 1u << 0;
+inline constexpr uint32_t kSessionEfis        = 1u << 1;
+inline constexpr uint32_t kSessionVn300       = 1u << 2;
+inline constexpr uint32_t kSessionFlapsRawAdc = 1u << 3;
+
+// On-disk value types.  Widths match the LogRow members exactly so the
+// round trip is bit-for-bit.
+enum class ColType : uint8_t { Bool, U8, U16, I32, U32, U64, F32, F64 };
+
+// Column groups.  A block stores all columns of each group whose LogRow
+// feature flag is set for its rows; Core / Derived / Ekf / Flags are
+// always present.
+enum class ColGroup : uint8_t { Core, Boom, Efis, Vn300, Derived, Ekf, FlapsRawAdc, Flags };
+
+struct ColumnDesc {
+    const char* name;     // CSV column name where one exists
+    ColType     type;
+    ColGroup    group;
+    uint16_t    offset;   // offsetof(LogRow, member)
+};
+
+// Number of entries in kColumns.  Fits in the 128-bit presence bitmap.
+inline constexpr int kColumnCount = 94;
+static_assert(kColumnCount <= 128, "presence bitmap is 128 bits");
+
+extern const ColumnDesc kColumns[kColumnCount];
+
+// Widest row a block can hold (EFIS and VN-300 groups are mutually
+// exclusive, so the bound is core + boom + VN-300 + derived + EKF + tail
+// = 313 bytes; LogBin.cpp static_asserts it).
+inline constexpr size_t kMaxRowBytes = 320;
+
+// Upper bound on one serialized block (header + full payload).  Size
+// the writer's output buffer with this.
+inline constexpr size_t kMaxBlockBytes =
+    kBlockHeaderBytes + kRowsPerBlock * kMaxRowBytes;
+
+// Byte width of one value of `t`.
+size_t ColTypeBytes(ColType t);
+
+// ---------------------------------------------------------------------------
+// Writer side
+// ---------------------------------------------------------------------------
+
+// Writes the 16-byte file header for a session whose column groups are
+// described by `sessionRow`'s feature flags (the same sentinel row
+// LogSensor::Open() hands to log_csv::WriteHeader).  Returns bytes
+// written, or 0 if `outCapacity` < kFileHeaderBytes.
+size_t WriteFileHeader(const onspeed::LogRow& sessionRow,
+                       uint8_t* out, size_t outCapacity);
+
+// Accumulates up to kRowsPerBlock rows column-major and serializes them
+// as one block.  No heap; the staging area is a member array sized for
+// the widest row, so instances are ~10 KB — firmware allocates one in
+// PSRAM rather than on a task stack.
+class BlockEncoder {
+public:
+    BlockEncoder() { Reset(); }
+
+    // Discard any buffered rows.
+    void Reset();
+
+    // Append one row.  Returns false (row not consumed) when the block is
+    // full or the row's column set differs from the rows already
+    // buffered; the caller should Finish() the current block and retry.
+    bool Append(const onspeed::LogRow& row);
+
+    int  RowCount() const { return m_rowCount; }
+    bool Empty()    const { return m_rowCount == 0; }
+    bool Full()     const { return m_rowCount >= kRowsPerBlock; }
+
+    // Size Finish() would write for the rows buffered so far.
+    size_t EncodedBytes() const;
+
+    // Serialize the buffered rows as one block into `out` and Reset().
+    // Returns bytes written; 0 when empty or `outCapacity` is too small
+    // (rows are kept in that case).
+    size_t Finish(uint8_t* out, size_t outCapacity);
+
+private:
+    uint64_t m_presence[2];
+    size_t   m_rowBytes;
+    int      m_rowCount;
+    // Column c of row r lives at m_colStart[c] * kRowsPerBlock + r * width;
+    // Finish() packs the columns down to m_rowCount rows.
+    uint16_t m_colStart[kColumnCount];
+    uint8_t  m_data[kRowsPerBlock * kMaxRowBytes];
+};
+
+// ---------------------------------------------------------------------------
+// Reader side
+// ---------------------------------------------------------------------------
+
+struct FileInfo {
+    uint16_t binVersion       = 0;
+    uint16_t csvFormatVersion = 0;
+    uint32_t sessionFlags     = 0;
+};
+
+// Parse the file header.  Returns false on short input, bad magic, or a
+// binVersion newer than this reader understands.
+bool ReadFileHeader(const uint8_t* in, size_t len, FileInfo& out);
+
+// LogRow with only the feature flags set from `info` — pass to
+// log_csv::WriteHeader to regenerate the CSV header line.
+onspeed::LogRow SessionRow(const FileInfo& info);
+
+enum class BlockStatus : uint8_t {
+    Ok,
+    Truncated,      // fewer bytes than the header promises (end of a yanked log)
+    BadMagic,
+    BadVersion,
+    UnknownColumn,  // presence bit beyond kColumnCount
+    BadLength,      // payloadBytes disagrees with rowCount x presence widths
+    BadCrc,
+};
+
+// A decoded block header plus a view of its payload.  The payload
+// pointer aliases the caller's buffer.
+struct BlockView {
+    uint16_t       rowCount     = 0;
+    uint64_t       presence[2]  = {0, 0};
+    uint32_t       payloadBytes = 0;
+    const uint8_t* payload      = nullptr;
+};
+
+// Decode the block starting at `in`.  On Ok, fills `out` and sets
+// `*consumed` to header + payload bytes.  BadCrc also sets `*consumed`
+// (the header was intact, so the next block's offset is known); on any
+// other status `out` is unspecified and `*consumed` is 0.
+BlockStatus DecodeBlock(const uint8_t* in, size_t len,
+                        BlockView& out, size_t* consumed);
+
+// Extract row `rowIdx` from a decoded block.  Columns absent from the
+// block keep `row`'s existing values; feature flags (boomEnabled,
+// efisEnabled, efisIsVn300, flapsRawAdcPresent) are set from the
+// presence bitmap.  Returns false when rowIdx is out of range.
+bool GetRow(const BlockView& block, int rowIdx, onspeed::LogRow& row);
+
+// ---------------------------------------------------------------------------
+// CSV export
+// ---------------------------------------------------------------------------
+
+// Sink for ExportCsv output: one call per line, without the trailing
+// newline.  Return false to abort the export.
+using LineSink = bool (*)(void* ctx, const char* line, size_t len);
+
+struct ExportResult {
+    uint32_t    rows          = 0;
+    uint32_t    blocks        = 0;
+    uint32_t    skippedBlocks = 0;                 // BadCrc blocks dropped
+    BlockStatus status        = BlockStatus::Ok;   // first non-Ok status seen
+    size_t      bytesConsumed = 0;                 // offset where decoding stopped
+};
+
+// Regenerate the CSV (header line, then one line per row) for an entire
+// in-memory .osl image.  Blocks failing their CRC are skipped; any other
+// decode failure stops the export there.  A Truncated tail is the normal
+// end of a power-yanked log and still counts as a successful export.
+// Returns false only for a bad file header or when `sink` aborts.
+bool ExportCsv(const uint8_t* in, size_t len,
+               LineSink sink, void* ctx, ExportResult* result = nullptr);
+
+}   // namespace onspeed::proto::log_bin
+
+#endif  // ONSPEED_CORE_PROTO_LOG_BIN_H
@@ -0,0 +1,58 @@
+// proto/LogCsvLineIndex.cpp — see LogCsvLineIndex.h.
+
+#include <proto/LogCsvLineIndex.h>
+
+#include <cstring>
+
+namespace onspeed::proto::log_csv {
+
+namespace {
+
+// Trim one trailing CR, matching the getline + pop_back('\r') loops.
+inline size_t TrimmedLength(const char* p, size_t n)
+{
+    return (n > 0 && p[n - 1] == '\r') ? n - 1 : n;
+}
+
+}  // namespace
+
+bool LineIndex::Build(std::string_view text)
+{
+    m_text   = text;
+    m_header = std::string_view();
+    m_rows.clear();
+
+    const char* const base = text.data();
+    const size_t      len  = text.size();
+
+    // Reserve from a cheap estimate so a 350 MB log doesn't regrow the
+    // vector ~20 times.  SD rows run 250-1000 bytes; 256 overshoots the
+    // row count slightly, which is the cheaper direction to be wrong.
+    m_rows.reserve(len / 256 + 1);
+
+    bool   haveHeader = false;
+    size_t pos        = 0;
+    while (pos < len) {
+        const void* nl  = std::memchr(base + pos, '\n', len - pos);
+        const size_t end = nl ? static_cast<size_t>(static_cast<const char*>(nl) - base) : len;
+        const size_t n   = TrimmedLength(base + pos, end - pos);
+
+        if (n > 0) {
+            if (!haveHeader) {
+                m_header   = std::string_view(base + pos, n);
+                haveHeader = true;
+            } else {
+                m_rows.push_back(Span{pos, static_cast<uint32_t>(n)});
+            }
+        }
+        pos = end + 1;
+    }
+
+    if (!haveHeader) {
+        m_text = std::string_view();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace onspeed::proto::log_csv
@@ -0,0 +1,63 @@
+// proto/LogCsvLineIndex.h — line-offset index over an in-memory CSV log.
+//
+// The host tools replay the same multi-hundred-MB SD log many times (the
+// regression harness, EKFQ tuning trials).  Reading it through
+// std::getline costs a std::string per row before ParseRowByIndex even
+// runs.  This index makes one pass over a contiguous image of the file
+// (typically an mmap) and records where each data row starts and ends;
+// Row(i) then hands back a std::string_view into the caller's buffer, so
+// the replay loop never allocates per row and can revisit any row by
+// ordinal.
+//
+// Line handling matches the getline loops it replaces: a trailing CR is
+// trimmed ("\r\n" SD writes), empty lines are skipped, and a final line
+// without a newline still counts.  Line 0 is the header and is exposed
+// separately; Row(0) is the first data row.
+//
+// The index stores offsets only — the buffer must outlive it.
+
+#ifndef ONSPEED_CORE_PROTO_LOG_CSV_LINE_INDEX_H
+#define ONSPEED_CORE_PROTO_LOG_CSV_LINE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace onspeed::proto::log_csv {
+
+class LineIndex {
+public:
+    // Index every line of `text`.  Returns false when `text` has no header
+    // line (empty or whitespace-only input); the index is left empty.
+    bool Build(std::string_view text);
+
+    // Header line (CR trimmed).  Empty before a successful Build().
+    std::string_view Header() const { return m_header; }
+
+    // Number of non-empty data lines after the header.
+    size_t RowCount() const { return m_rows.size(); }
+
+    // Data row `i` (CR trimmed, no newline).  `i` must be < RowCount().
+    std::string_view Row(size_t i) const
+    {
+        return std::string_view(m_text.data() + m_rows[i].offset, m_rows[i].length);
+    }
+
+    // Byte offset of data row `i` within the indexed text.
+    uint64_t RowOffset(size_t i) const { return m_rows[i].offset; }
+
+private:
+    struct Span {
+        uint64_t offset;
+        uint32_t length;
+    };
+
+    std::string_view  m_text;
+    std::string_view  m_header;
+    std::vector<Span> m_rows;
+};
+
+}  // namespace onspeed::proto::log_csv
+
+#endif  // ONSPEED_CORE_PROTO_LOG_CSV_LINE_INDEX_H
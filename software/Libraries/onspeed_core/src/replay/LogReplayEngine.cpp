@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <filters/RateAdjustedAccelEma.h>
 
@@ -97,6 +98,49 @@ void LogReplayEngine::reset()
     numTransitions_ = 0;
 }
 
+// ============================================================================
+// Checkpoints
+// ============================================================================
+
+LogReplayEngine::State LogReplayEngine::saveState() const
+{
+    State st{aoaCalc_, accelLatEma_, accelVertEma_, accelFwdEma_, gOnsetFilter_,
+             {}, rowsFed_, lastFlapPosDeg_, {}, numTransitions_};
+
+    // Unroll the ring oldest-first so restoreState() can lay it back down
+    // from slot 0; emission depends only on order and absolute ticks.
+    const int capacity = static_cast<int>(circBuf_.size());
+    st.pending.reserve(static_cast<size_t>(bufSize_));
+    for (int i = 0; i < bufSize_; i++)
+        st.pending.push_back(circBuf_[(bufHead_ + i) % capacity]);
+
+    std::copy(transitions_, transitions_ + numTransitions_, st.transitions);
+    return st;
+}
+
+void LogReplayEngine::restoreState(const State& st)
+{
+    aoaCalc_      = st.aoaCalc;
+    accelLatEma_  = st.accelLatEma;
+    accelVertEma_ = st.accelVertEma;
+    accelFwdEma_  = st.accelFwdEma;
+    gOnsetFilter_ = st.gOnsetFilter;
+
+    // A State from a mismatched engine could carry more rows than the ring
+    // holds; keep the newest rather than overrun it.
+    const size_t keep  = std::min(st.pending.size(), circBuf_.size());
+    const size_t first = st.pending.size() - keep;
+    std::copy(st.pending.begin() + static_cast<std::ptrdiff_t>(first),
+              st.pending.end(), circBuf_.begin());
+    bufHead_ = 0;
+    bufSize_ = static_cast<int>(keep);
+
+    rowsFed_        = st.rowsFed;
+    lastFlapPosDeg_ = st.lastFlapPosDeg;
+    numTransitions_ = std::clamp(st.numTransitions, 0, kMaxTransitions);
+    std::copy(st.transitions, st.transitions + numTransitions_, transitions_);
+}
+
 // ============================================================================
 // Private helpers
 // ============================================================================
@@ -299,6 +299,43 @@ public:
     // Useful for tests that verify the lag contract.
     int rowsFed() const { return rowsFed_; }
 
+    // Per-transition record: the rowsFed_ value when the transition occurred,
+    // the pot value before the snap, and the pot value after. Up to 8
+    // simultaneous transitions can sit in the ±synthHalfWindowTicks_ window
+    // (in practice ≤1 at any time for typical flight).
+    struct TransitionRecord {
+        int      snapTick   = 0;   // rowsFed_ value AT the transition row
+        uint16_t prevPot    = 0;
+        uint16_t nextPot    = 0;
+    };
+    static constexpr int kMaxTransitions = 8;
+
+    // Everything step() carries from one row to the next: the AOA EMA, the
+    // three accel EMAs, the G-onset filter, and (synth path) the buffered
+    // rows and transition table.  saveState() / restoreState() let a
+    // seekable replay (LogReplaySeeker) checkpoint a session and resume it
+    // later with output bit-identical to stepping every row in between.
+    //
+    // A State only fits an engine built with the same cfg, log rate and
+    // flapsRawAdcAvailable.  `pending` holds the buffered synth rows oldest
+    // first — at most synthHalfWindowTicks_ + 1 entries, so a checkpoint
+    // costs ~10 KB on a 50 Hz old-format log and nothing on the fast path.
+    struct State {
+        onspeed::AOACalculator                 aoaCalc;
+        onspeed::filters::RateAdjustedAccelEma accelLatEma;
+        onspeed::filters::RateAdjustedAccelEma accelVertEma;
+        onspeed::filters::RateAdjustedAccelEma accelFwdEma;
+        onspeed::GOnsetFilter                  gOnsetFilter;
+        std::vector<ReplayStepResult>          pending;
+        int                                    rowsFed        = 0;
+        int                                    lastFlapPosDeg = -1;
+        TransitionRecord                       transitions[kMaxTransitions];
+        int                                    numTransitions = 0;
+    };
+
+    State saveState() const;
+    void  restoreState(const State& state);
+
     // Test-only: expose internal buffer capacity for memory-bound regression
     // tests. Lets tests verify that circBuf_ never grows past its construction-
     // time allocation without reaching into private members.
@@ -387,16 +424,7 @@ private:
     // flapsPos of the last row seen (for transition detection).
     int lastFlapPosDeg_ = -1;
 
-    // Per-transition record: the rowsFed_ value when the transition occurred,
-    // the pot value before the snap, and the pot value after. Up to 8
-    // simultaneous transitions can sit in the ±synthHalfWindowTicks_ window
-    // (in practice ≤1 at any time for typical flight).
-    struct TransitionRecord {
-        int      snapTick   = 0;   // rowsFed_ value AT the transition row
-        uint16_t prevPot    = 0;
-        uint16_t nextPot    = 0;
-    };
-    static constexpr int kMaxTransitions = 8;
+    // Detent transitions still inside the synth window (see TransitionRecord).
     TransitionRecord transitions_[kMaxTransitions];
     int numTransitions_ = 0;
 
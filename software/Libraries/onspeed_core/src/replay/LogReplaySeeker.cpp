@@ -0,0 +1,190 @@
+// LogReplaySeeker.cpp — see LogReplaySeeker.h for design rationale.
+
+#include <replay/LogReplaySeeker.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace onspeed::replay {
+
+LogReplaySeeker::LogReplaySeeker(const ::onspeed::config::OnSpeedConfig& cfg,
+                                 int                                     logSampleRateHz,
+                                 bool                                    flapsRawAdcAvailable,
+                                 float                                   checkpointIntervalSec)
+  : task_(cfg, logSampleRateHz, flapsRawAdcAvailable)
+{
+    if (!(checkpointIntervalSec > 0.0f)) checkpointIntervalSec = kDefaultCheckpointIntervalSec;
+    const long rows = std::lround(checkpointIntervalSec * static_cast<float>(logSampleRateHz));
+    rowsPerCheckpoint_ = static_cast<size_t>(std::max(1L, rows));
+}
+
+bool LogReplaySeeker::appendRow(const LogRow& row)
+{
+    // Once flushed, the engine has already emitted the tail assuming
+    // the log ended there.
+    if (flushed_) return false;
+    rows_.push_back(Pack_(row));
+    return true;
+}
+
+LogReplaySeeker::ReplayRow LogReplaySeeker::Pack_(const LogRow& row)
+{
+    ReplayRow p{};
+    p.pfwdSmoothed       = row.pfwdSmoothed;
+    p.p45Smoothed        = row.p45Smoothed;
+    p.paltFt             = row.paltFt;
+    p.iasKt              = row.iasKt;
+    p.vsiFpm             = row.vsiFpm;
+    p.oatCelsius         = row.oatCelsius;
+    p.imuVerticalG       = row.imuVerticalG;
+    p.imuLateralG        = row.imuLateralG;
+    p.imuForwardG        = row.imuForwardG;
+    p.imuRollRateDps     = row.imuRollRateDps;
+    p.imuPitchRateDps    = row.imuPitchRateDps;
+    p.imuYawRateDps      = row.imuYawRateDps;
+    p.pitchDeg           = row.pitchDeg;
+    p.rollDeg            = row.rollDeg;
+    p.flightPathDeg      = row.flightPathDeg;
+    p.flapsPos           = row.flapsPos;
+    p.dataMark           = row.dataMark;
+    p.flapsRawAdc        = row.flapsRawAdc;
+    p.flapsRawAdcPresent = row.flapsRawAdcPresent;
+    p.iasValid           = row.iasValid;
+    return p;
+}
+
+const LogRow& LogReplaySeeker::Unpack_(const ReplayRow& p)
+{
+    // Every other field of rowScratch_ stays at its default.
+    LogRow& row = rowScratch_;
+    row.pfwdSmoothed       = p.pfwdSmoothed;
+    row.p45Smoothed        = p.p45Smoothed;
+    row.paltFt             = p.paltFt;
+    row.iasKt              = p.iasKt;
+    row.vsiFpm             = p.vsiFpm;
+    row.oatCelsius         = p.oatCelsius;
+    row.imuVerticalG       = p.imuVerticalG;
+    row.imuLateralG        = p.imuLateralG;
+    row.imuForwardG        = p.imuForwardG;
+    row.imuRollRateDps     = p.imuRollRateDps;
+    row.imuPitchRateDps    = p.imuPitchRateDps;
+    row.imuYawRateDps      = p.imuYawRateDps;
+    row.pitchDeg           = p.pitchDeg;
+    row.rollDeg            = p.rollDeg;
+    row.flightPathDeg      = p.flightPathDeg;
+    row.flapsPos           = p.flapsPos;
+    row.dataMark           = p.dataMark;
+    row.flapsRawAdc        = p.flapsRawAdc;
+    row.flapsRawAdcPresent = p.flapsRawAdcPresent;
+    row.iasValid           = p.iasValid;
+    return row;
+}
+
+void LogReplaySeeker::buildCheckpoints()
+{
+    const size_t resumeAt = outputPos_;
+    while (NextResult_().has_value()) {}
+    seek(resumeAt);
+}
+
+bool LogReplaySeeker::seek(size_t rowIdx)
+{
+    if (rowIdx > rows_.size()) return false;
+
+    // Latest checkpoint that has not yet handed out row rowIdx. Skip it
+    // when the current position lies between it and the target.
+    const auto after = std::upper_bound(
+        checkpoints_.begin(), checkpoints_.end(), rowIdx,
+        [](size_t idx, const Checkpoint& cp) { return idx < cp.outputPos; });
+
+    if (after == checkpoints_.begin()) {
+        if (outputPos_ > rowIdx) Rewind_();
+    } else {
+        const Checkpoint& cp = *(after - 1);
+        if (outputPos_ > rowIdx || outputPos_ < cp.outputPos) Restore_(cp);
+    }
+
+    while (outputPos_ < rowIdx) {
+        const std::optional<ReplayStepResult> r = NextResult_();
+        if (!r.has_value()) break;
+        lastStep_ = *r;
+    }
+    return true;
+}
+
+std::vector<uint8_t> LogReplaySeeker::next()
+{
+    const std::optional<ReplayStepResult> r = NextResult_();
+    if (!r.has_value()) return {};
+    lastStep_ = *r;
+    return task_.encodeFrame(lastStep_);
+}
+
+std::vector<uint8_t> LogReplaySeeker::advance(size_t rows)
+{
+    if (rows == 0) return {};
+    for (size_t i = 1; i < rows; i++) {
+        const std::optional<ReplayStepResult> r = NextResult_();
+        if (!r.has_value()) return {};
+        lastStep_ = *r;
+    }
+    return next();
+}
+
+std::optional<ReplayStepResult> LogReplaySeeker::NextResult_()
+{
+    for (;;) {
+        if (tailIdx_ < tail_.size()) {
+            outputPos_++;
+            return tail_[tailIdx_++];
+        }
+        if (inputPos_ < rows_.size()) {
+            MaybeCheckpoint_();
+            std::optional<ReplayStepResult> r = task_.advanceRow(Unpack_(rows_[inputPos_++]));
+            if (r.has_value()) {
+                outputPos_++;
+                return r;
+            }
+            continue;                       // synth-path lag
+        }
+        if (flushed_) return std::nullopt;
+        tail_    = task_.flushSteps();
+        tailIdx_ = 0;
+        flushed_ = true;
+    }
+}
+
+void LogReplaySeeker::MaybeCheckpoint_()
+{
+    // Checkpoints are recorded in order, the first time playback reaches
+    // each interval boundary; replays after a seek find them present.
+    if (inputPos_ % rowsPerCheckpoint_ != 0) return;
+    if (inputPos_ / rowsPerCheckpoint_ != checkpoints_.size()) return;
+    checkpoints_.push_back(Checkpoint{task_.saveState(), inputPos_, outputPos_});
+}
+
+void LogReplaySeeker::Restore_(const Checkpoint& cp)
+{
+    task_.restoreState(cp.task);
+    inputPos_  = cp.inputPos;
+    outputPos_ = cp.outputPos;
+    flushed_   = false;
+    tail_.clear();
+    tailIdx_   = 0;
+}
+
+void LogReplaySeeker::Rewind_()
+{
+    task_.reset();
+    inputPos_  = 0;
+    outputPos_ = 0;
+    flushed_   = false;
+    tail_.clear();
+    tailIdx_   = 0;
+}
+
+} // namespace onspeed::replay
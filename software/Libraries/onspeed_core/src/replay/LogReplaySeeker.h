@@ -0,0 +1,162 @@
+// LogReplaySeeker — random access and fast-forward over a LogReplayTask.
+//
+// LogReplayTask is a strictly sequential pipeline: every wire frame
+// depends on the AOA EMA, the accel EMAs, the G-onset filter and (old
+// logs) the synth buffer as left by every earlier row. Showing minute 40
+// of a flight therefore used to mean replaying minutes 0..40, and the web
+// replay page pre-encoded a 77-byte frame for every row up front so the
+// scrubber could jump anywhere.
+//
+// The seeker keeps the log's rows and snapshots the task's state
+// (LogReplayTask::State) every checkpointIntervalSec of log time, the
+// first time playback passes that row. seek(i) restores the nearest
+// checkpoint at or before row i — or keeps going from where it is, if
+// that is closer — and steps the rows in between through
+// LogReplayTask::advanceRow() without encoding them. The filters see
+// exactly the rows they would have seen in a straight replay, so the
+// frame next() returns after a seek is byte-identical to the one a
+// sequential processRow()/flush() pass produces for that row.
+//
+// Cost of a seek: at most one checkpoint interval of engine steps (10 s
+// at 208 Hz is ~2k rows, well under a millisecond natively). Memory per
+// checkpoint is one LogReplayTask::State: a few hundred bytes on the
+// flapsRawADC path, ~10 KB on the 50 Hz synth path (the buffered rows).
+//
+// Rows are stored packed (ReplayRow, 72 bytes): only the LogRow fields
+// LogReplayTask::advanceRow and LogReplayEngine::step read. A full
+// LogRow is ~400 bytes — ~600 MB for a 2 h log at 208 Hz, against
+// ~110 MB packed. A field the engine starts reading must be added to
+// ReplayRow, or it replays as LogRow's default.
+//
+// Row / frame alignment: output position i is always the frame for input
+// row i. On the synth path the engine emits with a lag and drains the
+// tail in flush(); the seeker hides that, so callers never see the lag.
+//
+//   seeker.appendRow(row) ...        // whole log, in order
+//   seeker.buildCheckpoints();       // optional: one pass up front
+//   seeker.seek(rowIdx);             // scrub
+//   frame = seeker.next();           // frame for rowIdx, then rowIdx + 1
+//   frame = seeker.advance(10);      // 10x fast-forward: skip 9, show 1
+//
+// Threading: not thread-safe, like LogReplayTask.
+//
+// Testing: test/test_log_replay_seeker/. Embind surface:
+// wasm/bindings.cpp (LogReplaySeeker).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <config/OnSpeedConfig.h>
+#include <replay/LogReplayEngine.h>
+#include <replay/LogReplayTask.h>
+#include <types/LogRow.h>
+
+namespace onspeed::replay {
+
+// Log time between checkpoints.
+inline constexpr float kDefaultCheckpointIntervalSec = 10.0f;
+
+class LogReplaySeeker {
+public:
+    // cfg / logSampleRateHz / flapsRawAdcAvailable are forwarded to the
+    // LogReplayTask. checkpointIntervalSec <= 0 (or NaN) selects the
+    // default; the interval is rounded to whole rows, minimum one.
+    LogReplaySeeker(const ::onspeed::config::OnSpeedConfig& cfg,
+                    int                                     logSampleRateHz,
+                    bool                                    flapsRawAdcAvailable,
+                    float checkpointIntervalSec = kDefaultCheckpointIntervalSec);
+
+    // Append the next parsed log row. Rows may be appended while
+    // playing (a log still being read); false (row dropped) once
+    // playback has reached the end and drained the engine.
+    bool appendRow(const LogRow& row);
+    void reserveRows(size_t count) { rows_.reserve(count); }
+
+    // Play the whole log once, recording every checkpoint, then return
+    // to the current position. Optional — checkpoints are otherwise
+    // recorded as playback first passes them — but after this every
+    // seek costs at most one interval.
+    void buildCheckpoints();
+
+    // Position the next next() at row `rowIdx`. rowIdx == rowCount() is
+    // the end (next() returns empty). False, position unchanged, past
+    // the end.
+    bool seek(size_t rowIdx);
+
+    // Wire frame (77 bytes) for row position(), then step forward.
+    // Empty at the end of the log.
+    std::vector<uint8_t> next();
+
+    // Step `rows` rows forward and return the frame of the last one:
+    // advance(1) == next(); advance(50) is one 50x fast-forward tick,
+    // with the 49 skipped rows stepped but not encoded. Empty when
+    // rows == 0 or the log ends first.
+    std::vector<uint8_t> advance(size_t rows);
+
+    // Engine result behind the frame next()/advance() last returned.
+    const ReplayStepResult& lastStep() const { return lastStep_; }
+
+    size_t position()        const { return outputPos_; }
+    size_t rowCount()        const { return rows_.size(); }
+    size_t checkpointCount() const { return checkpoints_.size(); }
+    size_t rowsPerCheckpoint() const { return rowsPerCheckpoint_; }
+
+private:
+    // The LogRow fields the replay pipeline reads; see the file comment.
+    struct ReplayRow {
+        float    pfwdSmoothed;
+        float    p45Smoothed;
+        float    paltFt;
+        float    iasKt;
+        float    vsiFpm;
+        float    oatCelsius;
+        float    imuVerticalG;
+        float    imuLateralG;
+        float    imuForwardG;
+        float    imuRollRateDps;
+        float    imuPitchRateDps;
+        float    imuYawRateDps;
+        float    pitchDeg;
+        float    rollDeg;
+        float    flightPathDeg;
+        int32_t  flapsPos;
+        int32_t  dataMark;
+        uint16_t flapsRawAdc;
+        bool     flapsRawAdcPresent;
+        bool     iasValid;
+    };
+
+    struct Checkpoint {
+        LogReplayTask::State task;
+        size_t               inputPos  = 0;   // rows fed to the task
+        size_t               outputPos = 0;   // results handed out
+    };
+
+    LogReplayTask                 task_;
+    std::vector<ReplayRow>        rows_;
+    LogRow                        rowScratch_{};        // rows_[i] unpacked for advanceRow()
+    size_t                        rowsPerCheckpoint_;
+    std::vector<Checkpoint>       checkpoints_;
+
+    size_t                        inputPos_  = 0;
+    size_t                        outputPos_ = 0;
+    bool                          flushed_   = false;   // task drained at end of rows_
+    std::vector<ReplayStepResult> tail_;                // flushSteps() output not yet handed out
+    size_t                        tailIdx_   = 0;
+    ReplayStepResult              lastStep_{};
+
+    static ReplayRow Pack_(const LogRow& row);
+    const LogRow&    Unpack_(const ReplayRow& packed);
+
+    // Result for row outputPos_, advancing one row; nullopt at the end.
+    std::optional<ReplayStepResult> NextResult_();
+    void MaybeCheckpoint_();
+    void Restore_(const Checkpoint& cp);
+    void Rewind_();
+};
+
+} // namespace onspeed::replay
@@ -79,6 +79,13 @@ LogReplayTask::LogReplayTask(const ::onspeed::config::OnSpeedConfig& cfg,
 }
 
 std::vector<uint8_t> LogReplayTask::processRow(const LogRow& row)
+{
+    const std::optional<ReplayStepResult> opt = advanceRow(row);
+    if (!opt.has_value()) return {};        // synth-path lag period
+    return EncodeFrame_(opt.value());
+}
+
+std::optional<ReplayStepResult> LogReplayTask::advanceRow(const LogRow& row)
 {
     // Apply the firmware's hysteretic IAS-alive gate before stepping
     // the engine. The CSV parser sets row.iasValid based on whether
@@ -96,27 +103,40 @@ std::vector<uint8_t> LogReplayTask::processRow(const LogRow& row)
     LogRow gatedRow      = row;
     gatedRow.iasValid    = iasAlive_;
 
-    const std::optional<ReplayStepResult> opt = engine_.step(gatedRow);
-    if (!opt.has_value()) return {};        // synth-path lag period
-    lastStep_ = opt.value();
-    return EncodeFrame_(lastStep_);
+    std::optional<ReplayStepResult> opt = engine_.step(gatedRow);
+    if (opt.has_value()) lastStep_ = *opt;
+    return opt;
 }
 
 std::vector<std::vector<uint8_t>> LogReplayTask::flush()
 {
     std::vector<std::vector<uint8_t>> out;
-    for (const ReplayStepResult& r : engine_.flush()) {
+    for (const ReplayStepResult& r : flushSteps()) {
         out.push_back(EncodeFrame_(r));
     }
     return out;
 }
 
+std::vector<ReplayStepResult> LogReplayTask::flushSteps()
+{
+    std::vector<ReplayStepResult> out = engine_.flush();
+    if (!out.empty()) lastStep_ = out.back();
+    return out;
+}
+
 void LogReplayTask::reset()
 {
     engine_.reset();
     iasAlive_ = false;
 }
 
+void LogReplayTask::restoreState(const State& st)
+{
+    engine_.restoreState(st.engine);
+    iasAlive_ = st.iasAlive;
+    lastStep_ = st.lastStep;
+}
+
 std::vector<uint8_t> LogReplayTask::EncodeFrame_(
     const ReplayStepResult& r) const
 {
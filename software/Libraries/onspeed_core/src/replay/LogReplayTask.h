@@ -68,6 +68,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 #include <config/OnSpeedConfig.h>
@@ -119,6 +120,32 @@ public:
     // scrub or replay re-init.
     void reset();
 
+    // processRow / flush without the wire encoding: same IAS gate, same
+    // engine step, same lastStep() update, but the ReplayStepResult is
+    // returned as-is. Fast-forward and seek (LogReplaySeeker) run the
+    // rows they skip through these — filter state stays exact while the
+    // percent-lift / anchors / BuildDisplayFrame work is only paid for
+    // frames that get shown. encodeFrame() turns a result into the same
+    // 77 bytes processRow would have returned for it.
+    std::optional<ReplayStepResult> advanceRow(const LogRow& row);
+    std::vector<ReplayStepResult>   flushSteps();
+    std::vector<uint8_t> encodeFrame(const ReplayStepResult& result) const {
+        return EncodeFrame_(result);
+    }
+
+    // Session checkpoint: engine state (see LogReplayEngine::State) plus
+    // the task's iasAlive_ and lastStep_. restoreState() on a task built
+    // with the same (cfg, rate, flapsRawAdcAvailable) resumes exactly
+    // where saveState() was taken.
+    struct State {
+        LogReplayEngine::State engine;
+        bool                   iasAlive = false;
+        ReplayStepResult       lastStep{};
+    };
+
+    State saveState() const { return State{engine_.saveState(), iasAlive_, lastStep_}; }
+    void  restoreState(const State& state);
+
     // Read-only access to the most recent ReplayStepResult emitted by
     // the engine, useful for diagnostics that want to compare the C++
     // engine output against the wire frame the same processRow call
@@ -0,0 +1,216 @@
+#include <replay/VnTruthLoss.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace onspeed::replay {
+
+namespace {
+constexpr double kKtToMps      = 0.514444;
+constexpr double kFpmToMps     = 0.00508;    // 0.3048 / 60
+constexpr double kIndexDtSec   = 1.0 / 208.0;
+constexpr double kRadToDeg     = 57.29577951308232;
+// composite_loss reports the pressure-α diagnostic with a fixed knee.
+constexpr double kAlphaPressureHuberDeg = 3.0;
+
+double Huber(double r, double delta)
+{
+    const double a = std::fabs(r);
+    return (a <= delta) ? 0.5 * r * r : delta * (a - 0.5 * delta);
+}
+
+// numpy's (x + 180) % 360 - 180 — result in [-180, 180).
+double WrapDeg(double x)
+{
+    double m = std::fmod(x + 180.0, 360.0);
+    if (m < 0.0) m += 360.0;
+    return m - 180.0;
+}
+
+double KinematicAlphaDeg(double pitchDeg, double vzMps, double tasMps)
+{
+    const double ratio = std::clamp(vzMps / tasMps, -0.999, 0.999);
+    return pitchDeg - std::asin(ratio) * kRadToDeg;
+}
+}   // namespace
+
+// ---------------------------------------------------------------------------
+// Profiles — keep in lockstep with tune_ekf.py _LOSS_PROFILES.
+// ---------------------------------------------------------------------------
+
+VnTruthLossProfile VnTruthLossProfile::Default()
+{
+    return VnTruthLossProfile{};
+}
+
+VnTruthLossProfile VnTruthLossProfile::CruisePitch()
+{
+    VnTruthLossProfile p;
+    p.huberPitchDeg = 0.5f;  p.huberRollDeg = 2.0f;  p.huberVzMps = 0.5f;
+    p.wPitch = 4.0f;  p.wRoll = 0.5f;  p.wVz = 0.5f;
+    p.wPitchRate = 0.3f;  p.wRollRate = 0.3f;  p.wVzRate = 0.3f;
+    p.aeroWeight = 0.0f;  p.superCruiseWeight = 2.0f;
+    return p;
+}
+
+VnTruthLossProfile VnTruthLossProfile::CruiseAoa()
+{
+    VnTruthLossProfile p;
+    p.huberPitchDeg = 0.5f;  p.huberRollDeg = 2.0f;  p.huberVzMps = 0.3f;
+    p.huberAlphaDeg = 0.5f;
+    p.wPitch = 4.0f;  p.wRoll = 0.5f;  p.wVz = 4.0f;
+    p.wPitchRate = 0.3f;  p.wRollRate = 0.3f;  p.wVzRate = 0.3f;
+    p.wAlpha = 4.0f;
+    p.aeroWeight = 0.0f;  p.superCruiseWeight = 2.0f;
+    return p;
+}
+
+bool VnTruthLossProfile::FromName(const char* name, VnTruthLossProfile& out)
+{
+    if (name == nullptr) return false;
+    if (std::strcmp(name, "default") == 0)      { out = Default();     return true; }
+    if (std::strcmp(name, "cruise-pitch") == 0) { out = CruisePitch(); return true; }
+    if (std::strcmp(name, "cruise-aoa") == 0)   { out = CruiseAoa();   return true; }
+    return false;
+}
+
+VnTruthSample VnTruthSample::FromLogRow(const onspeed::LogRow& row)
+{
+    VnTruthSample s;
+    s.pitchDeg    = row.vnPitchDeg;
+    s.rollDeg     = row.vnRollDeg;
+    s.vzMps       = row.vnVelNedDown;
+    s.tasKt       = row.tasKt;
+    s.aoaDeg      = row.angleOfAttackDeg;
+    s.vnDataAgeMs = static_cast<float>(row.vnDataAgeMs);
+    return s;
+}
+
+// ---------------------------------------------------------------------------
+// Accumulator
+// ---------------------------------------------------------------------------
+
+void VnTruthLoss::Channel::add(double residual, double weight, double delta)
+{
+    wHuber += weight * Huber(residual, delta);
+    w      += weight;
+}
+
+float VnTruthLoss::Channel::rms() const
+{
+    // All-zero weights (e.g. aeroWeight 0 and no cruise rows) score 0,
+    // as _weighted_huber_rms does.
+    if (w <= 0.0) return 0.0f;
+    return static_cast<float>(std::sqrt(wHuber / w));
+}
+
+VnTruthLoss::VnTruthLoss(const VnTruthLossProfile& profile)
+    : profile_(profile)
+{
+}
+
+void VnTruthLoss::reset()
+{
+    *this = VnTruthLoss(profile_);
+}
+
+void VnTruthLoss::seed(const VnTruthSample& truth)
+{
+    haveSeed_  = true;
+    prevAgeMs_ = truth.vnDataAgeMs;
+}
+
+void VnTruthLoss::add(const VnTruthSample& truth, const onspeed::AhrsOutputs& out)
+{
+    const size_t idx = rows_++;
+
+    const double ekfPitch = out.pitchDeg;
+    const double ekfRoll  = out.rollDeg;
+    const double ekfVz    = -out.vsiFpm * kFpmToMps;   // +climb fpm → +down m/s
+    if (!std::isfinite(out.pitchDeg) || !std::isfinite(out.rollDeg)
+        || !std::isfinite(out.vsiFpm) || !std::isfinite(out.altFt)) {
+        finite_ = false;
+    }
+
+    // A VN-300 frame is fresh when its age counter went backwards.
+    const bool fresh = haveSeed_ ? (truth.vnDataAgeMs < prevAgeMs_) : (idx == 0);
+    prevAgeMs_ = truth.vnDataAgeMs;
+
+    // Pressure-α diagnostic runs on every row with a finite AOA.
+    if (std::isfinite(truth.aoaDeg)) {
+        alphaPressureSum_ += Huber((double)out.derivedAoaDeg - truth.aoaDeg,
+                                   kAlphaPressureHuberDeg);
+        ++alphaPressureN_;
+    }
+
+    if (!fresh) return;
+    ++freshVnRows_;
+
+    const double absP = std::fabs(truth.pitchDeg);
+    const double absR = std::fabs(truth.rollDeg);
+    double w;
+    if (absP <= 10.0 && absR <= 15.0) {
+        w = (double)profile_.cruiseWeight * profile_.superCruiseWeight;
+    } else if (absP <= 20.0 && absR <= 30.0) {
+        w = profile_.cruiseWeight;
+    } else {
+        w = profile_.aeroWeight;
+    }
+
+    pitch_.add(WrapDeg(ekfPitch - truth.pitchDeg), w, profile_.huberPitchDeg);
+    roll_.add (WrapDeg(ekfRoll  - truth.rollDeg),  w, profile_.huberRollDeg);
+    vz_.add   (ekfVz - truth.vzMps,                w, profile_.huberVzMps);
+
+    if (havePrevFresh_) {
+        double dt = (double)(idx - prevFreshIdx_) * kIndexDtSec;
+        if (!(dt > 1e-6)) dt = kIndexDtSec;
+        pitchRate_.add(((ekfPitch - prevEkfPitch_) - (truth.pitchDeg - prevVnPitch_)) / dt,
+                       w, profile_.huberPitchRateDps);
+        rollRate_.add((WrapDeg(ekfRoll - prevEkfRoll_)
+                       - WrapDeg((double)truth.rollDeg - prevVnRoll_)) / dt,
+                      w, profile_.huberRollRateDps);
+        vzRate_.add(((ekfVz - prevEkfVz_) - (truth.vzMps - prevVnVz_)) / dt,
+                    w, profile_.huberVzRateMps2);
+    }
+    havePrevFresh_ = true;
+    prevFreshIdx_  = idx;
+    prevEkfPitch_ = (float)ekfPitch;  prevEkfRoll_ = (float)ekfRoll;  prevEkfVz_ = (float)ekfVz;
+    prevVnPitch_  = truth.pitchDeg;   prevVnRoll_  = truth.rollDeg;   prevVnVz_  = truth.vzMps;
+
+    const double tasMps = truth.tasKt * kKtToMps;
+    if (tasMps > profile_.alphaMinTasMps) {
+        alphaKin_.add(KinematicAlphaDeg(ekfPitch, ekfVz, tasMps)
+                      - KinematicAlphaDeg(truth.pitchDeg, truth.vzMps, tasMps),
+                      w, profile_.huberAlphaDeg);
+    }
+}
+
+VnTruthLossResult VnTruthLoss::finish() const
+{
+    VnTruthLossResult r;
+    r.pitchRms     = pitch_.rms();
+    r.rollRms      = roll_.rms();
+    r.vzRms        = vz_.rms();
+    r.pitchRateRms = pitchRate_.rms();
+    r.rollRateRms  = rollRate_.rms();
+    r.vzRateRms    = vzRate_.rms();
+    r.alphaKinRms  = alphaKin_.rms();
+    r.alphaPressureDiag = alphaPressureN_ > 0
+        ? static_cast<float>(std::sqrt(alphaPressureSum_ / (double)alphaPressureN_))
+        : 0.0f;
+    r.rows        = rows_;
+    r.freshVnRows = freshVnRows_;
+    r.finite      = finite_;
+
+    const VnTruthLossProfile& p = profile_;
+    r.total = r.finite
+        ? p.wPitch * r.pitchRms + p.wRoll * r.rollRms + p.wVz * r.vzRms
+          + p.wPitchRate * r.pitchRateRms + p.wRollRate * r.rollRateRms
+          + p.wVzRate * r.vzRateRms + p.wAlpha * r.alphaKinRms
+        : std::numeric_limits<float>::infinity();
+    return r;
+}
+
+}   // namespace onspeed::replay
@@ -0,0 +1,152 @@
+// VnTruthLoss.h
+//
+// Streaming scorer for an AHRS replay against the VN-300 truth columns
+// of the same SD log. It is the C++ port of the value, rate and
+// kinematic-α terms of ekfq_pipeline/tune_ekf.py's composite_loss, so
+// that host_main ekfq_sweep can score many EKFQ configs in one process
+// without round-tripping every output row through Python.
+//
+// Feed it one sample per replayed row (after the seed row), in log
+// order. finish() returns the same breakdown composite_loss reports:
+// per-channel weighted Huber RMS over fresh-VN rows, rate residuals
+// between consecutive fresh-VN rows on the 208 Hz index time base, and
+// the kinematic-α residual α = θ − asin(vz / TAS) for EKF vs VN-300.
+//
+// Differences from the Python reference:
+//   - There is no train/validation split. Every row fed in is scored.
+//   - alphaKinRms is always computed. composite_loss reports 0 when
+//     the profile's alpha weight is 0. The weight still gates `total`.
+//   - Sums are accumulated in double, so results agree with numpy's
+//     float32 arrays to about 1e-5 relative.
+
+#ifndef ONSPEED_CORE_REPLAY_VN_TRUTH_LOSS_H
+#define ONSPEED_CORE_REPLAY_VN_TRUTH_LOSS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <types/AhrsOutputs.h>
+#include <types/LogRow.h>
+
+namespace onspeed::replay {
+
+/// Huber knees, channel weights and regime weights. The named
+/// constructors mirror tune_ekf.py's _LOSS_PROFILES entries.
+struct VnTruthLossProfile {
+    float huberPitchDeg      = 2.0f;
+    float huberRollDeg       = 3.0f;
+    float huberVzMps         = 2.0f;
+    float huberPitchRateDps  = 10.0f;
+    float huberRollRateDps   = 20.0f;
+    float huberVzRateMps2    = 2.0f;
+    float huberAlphaDeg      = 10.0f;
+
+    float wPitch     = 1.0f;
+    float wRoll      = 1.0f;
+    float wVz        = 1.0f;
+    float wPitchRate = 1.5f;
+    float wRollRate  = 1.5f;
+    float wVzRate    = 1.5f;
+    float wAlpha     = 0.0f;
+
+    /// Regime tiers on truth attitude: super-cruise |θ|≤10° and |φ|≤15°;
+    /// cruise |θ|≤20° and |φ|≤30°; everything else is aerobatic.
+    float cruiseWeight      = 1.0f;
+    float aeroWeight        = 0.1f;
+    float superCruiseWeight = 1.0f;
+
+    /// Kinematic α is skipped below this TAS (vz/TAS goes singular).
+    float alphaMinTasMps = 12.0f;
+
+    static VnTruthLossProfile Default();
+    static VnTruthLossProfile CruisePitch();
+    static VnTruthLossProfile CruiseAoa();
+
+    /// Look up a profile by its tune_ekf.py --loss-mode name
+    /// ("default", "cruise-pitch", "cruise-aoa"). Returns false when
+    /// the name is unknown.
+    static bool FromName(const char* name, VnTruthLossProfile& out);
+};
+
+/// The per-row truth values the scorer reads from a LogRow. Keeping
+/// only these lets a sweep hold one compact truth track shared by all
+/// configs instead of the full rows.
+struct VnTruthSample {
+    float pitchDeg    = 0.0f;   // vnPitch
+    float rollDeg     = 0.0f;   // vnRoll
+    float vzMps       = 0.0f;   // vnVelNedDown (+down)
+    float tasKt       = 0.0f;   // TAS
+    float aoaDeg      = 0.0f;   // AngleofAttack (pressure-derived)
+    /// vnDataAge. Float because cleaned/interpolated tuning logs carry
+    /// fractional ages; a fresh frame is any decrease.
+    float vnDataAgeMs = 0.0f;
+
+    static VnTruthSample FromLogRow(const onspeed::LogRow& row);
+};
+
+struct VnTruthLossResult {
+    float  total             = 0.0f;
+    float  pitchRms          = 0.0f;
+    float  rollRms           = 0.0f;
+    float  vzRms             = 0.0f;
+    float  pitchRateRms      = 0.0f;
+    float  rollRateRms       = 0.0f;
+    float  vzRateRms         = 0.0f;
+    float  alphaKinRms       = 0.0f;
+    float  alphaPressureDiag = 0.0f;
+    size_t rows              = 0;
+    size_t freshVnRows       = 0;
+    /// False when any EKF pitch/roll/vz/alt output was NaN or Inf. That
+    /// is the same check as tune_ekf.py's _sanity_penalty. `total` is
+    /// +inf in that case.
+    bool   finite            = true;
+};
+
+class VnTruthLoss {
+public:
+    explicit VnTruthLoss(const VnTruthLossProfile& profile = VnTruthLossProfile::Default());
+
+    /// Record the seed row (the one passed to Ahrs::Init). Its VN age is
+    /// the reference for the first scored row's fresh-frame test. Without
+    /// a seed, the first scored row counts as fresh.
+    void seed(const VnTruthSample& truth);
+
+    /// Score one replayed row.
+    void add(const VnTruthSample& truth, const onspeed::AhrsOutputs& out);
+
+    VnTruthLossResult finish() const;
+
+    void reset();
+
+private:
+    struct Channel {
+        double wHuber = 0.0;   // Σ w·huber(residual)
+        double w      = 0.0;   // Σ w
+        void   add(double residual, double weight, double delta);
+        float  rms() const;
+    };
+
+    VnTruthLossProfile profile_;
+
+    Channel pitch_, roll_, vz_;
+    Channel pitchRate_, rollRate_, vzRate_;
+    Channel alphaKin_;
+    double  alphaPressureSum_ = 0.0;   // unweighted Σ huber(α_ekf − α_press, 3°)
+    size_t  alphaPressureN_   = 0;
+
+    size_t rows_        = 0;
+    size_t freshVnRows_ = 0;
+    bool   finite_      = true;
+
+    bool  haveSeed_  = false;
+    float prevAgeMs_ = 0.0f;
+    /// Index and values at the previous fresh-VN row, for rate residuals.
+    bool   havePrevFresh_ = false;
+    size_t prevFreshIdx_  = 0;
+    float  prevEkfPitch_ = 0.0f, prevEkfRoll_ = 0.0f, prevEkfVz_ = 0.0f;
+    float  prevVnPitch_  = 0.0f, prevVnRoll_  = 0.0f, prevVnVz_  = 0.0f;
+};
+
+}   // namespace onspeed::replay
+
+#endif   // ONSPEED_CORE_REPLAY_VN_TRUTH_LOSS_H
@@ -0,0 +1,154 @@
+// Ism330Fifo.cpp — ISM330DHCX FIFO word decoding. See Ism330Fifo.h.
+
+#include <sensors/Ism330Fifo.h>
+
+namespace onspeed::sensors {
+
+namespace {
+
+// Lowest rate of each ODR code, codes 1 .. 10 (12.5 Hz listed as 12).
+constexpr int kOdrRatesHz[] = {12, 26, 52, 104, 208, 416, 833, 1666, 3332, 6667};
+
+int16_t Le16(const uint8_t* p)
+{
+    return static_cast<int16_t>(static_cast<uint16_t>(p[0]) | (static_cast<uint16_t>(p[1]) << 8));
+}
+
+uint32_t Le32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0])         | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t ToQ16(float tickUs)
+{
+    if (!(tickUs > 0.0f)) tickUs = kIsm330TimestampTickUs;
+    return static_cast<uint32_t>(tickUs * 65536.0f + 0.5f);
+}
+
+}   // namespace
+
+uint8_t Ism330OdrCode(int rateHz)
+{
+    uint8_t code = 0;
+    for (int i = 0; i < static_cast<int>(sizeof(kOdrRatesHz) / sizeof(kOdrRatesHz[0])); ++i)
+    {
+        if (rateHz >= kOdrRatesHz[i]) code = static_cast<uint8_t>(i + 1);
+    }
+    return code;
+}
+
+float Ism330TickUsForFreqFine(int8_t freqFine)
+{
+    return 1.0e6f / (40000.0f * (1.0f + 0.0015f * static_cast<float>(freqFine)));
+}
+
+Ism330FifoStatus Ism330DecodeFifoStatus(uint8_t status1, uint8_t status2)
+{
+    Ism330FifoStatus s;
+    s.words   = static_cast<uint16_t>(status1 | ((status2 & 0x03u) << 8));
+    s.overrun = (status2 & 0x48u) != 0;   // FIFO_OVR_IA | FIFO_OVR_LATCHED
+    return s;
+}
+
+// ============================================================================
+
+Ism330FifoDecoder::Ism330FifoDecoder(float tickUs)
+    : tickQ16_(ToQ16(tickUs))
+{
+}
+
+void Ism330FifoDecoder::Reset()
+{
+    haveTick_     = false;
+    lastTick_     = 0;
+    nowUs_        = 0;
+    fracQ16_      = 0;
+    haveSample_   = false;
+    lastSampleUs_ = 0;
+    haveAccel_    = false;
+    haveGyro_     = false;
+}
+
+void Ism330FifoDecoder::SetTickUs(float tickUs)
+{
+    tickQ16_ = ToQ16(tickUs);
+}
+
+int Ism330FifoDecoder::Decode(const uint8_t* words, int wordCount, Ism330FifoSample* out, int outCap)
+{
+    int n = 0;
+    for (int w = 0; w < wordCount; ++w)
+    {
+        const uint8_t* word = words + w * kIsm330FifoWordBytes;
+        const uint8_t* data = word + 1;
+        ++stats_.words;
+
+        switch (word[0] >> 3)
+        {
+        case kIsm330TagTimestamp:
+        {
+            const uint32_t tick = Le32(data);
+            if (haveTick_)
+            {
+                // Ticks -> microseconds in Q16 so a 25.0x us tick does not
+                // drift the timeline by truncation.
+                const uint64_t q = static_cast<uint64_t>(tick - lastTick_) * tickQ16_ + fracQ16_;
+                nowUs_  += static_cast<uint32_t>(q >> 16);
+                fracQ16_ = static_cast<uint32_t>(q & 0xFFFFu);
+            }
+            lastTick_ = tick;
+            haveTick_ = true;
+            break;
+        }
+        case kIsm330TagAccel:
+            if (haveAccel_) ++stats_.unpaired;
+            for (int k = 0; k < 3; ++k) accel_[k] = Le16(data + 2 * k);
+            haveAccel_ = true;
+            break;
+        case kIsm330TagGyro:
+            if (haveGyro_) ++stats_.unpaired;
+            for (int k = 0; k < 3; ++k) gyro_[k] = Le16(data + 2 * k);
+            haveGyro_ = true;
+            break;
+        case kIsm330TagTemperature:
+            tempRaw_  = Le16(data);
+            haveTemp_ = true;
+            ++stats_.temps;
+            break;
+        default:
+            ++stats_.otherTags;
+            break;
+        }
+
+        if (!(haveAccel_ && haveGyro_)) continue;
+        haveAccel_ = false;
+        haveGyro_  = false;
+
+        if (!haveTick_)
+        {
+            ++stats_.untimed;
+            continue;
+        }
+        if (n >= outCap)
+        {
+            ++stats_.dropped;
+            continue;
+        }
+
+        Ism330FifoSample& s = out[n++];
+        for (int k = 0; k < 3; ++k)
+        {
+            s.accel[k] = accel_[k];
+            s.gyro[k]  = gyro_[k];
+        }
+        s.timestampUs = nowUs_;
+        s.dtUs        = haveSample_ ? nowUs_ - lastSampleUs_ : 0;
+        lastSampleUs_ = nowUs_;
+        haveSample_   = true;
+        ++stats_.samples;
+    }
+    return n;
+}
+
+}   // namespace onspeed::sensors
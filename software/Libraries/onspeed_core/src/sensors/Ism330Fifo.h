@@ -0,0 +1,133 @@
+// Ism330Fifo.h — pure decoding of the ISM330DHCX / LSM6DSO FIFO stream.
+//
+// Split out of the hardware-facing IMU330 driver so it is natively
+// testable without the SPI bus. In FIFO (continuous) mode the sensor
+// queues one 7-byte word per batched datum:
+//
+//   byte 0      FIFO_DATA_OUT_TAG: TAG_SENSOR[7:3] TAG_CNT[2:1] PARITY[0]
+//   bytes 1..6  FIFO_DATA_OUT_X_L .. Z_H, little-endian int16 x / y / z
+//
+// and the driver burst-reads many words in one SPI transaction (the
+// output address rolls back from 0x7E to 0x78). With TIMESTAMP_EN and
+// DEC_TS_BATCH = 1 every accel/gyro batch event is preceded by a
+// timestamp word carrying the sensor's 32-bit tick counter (25 us
+// nominal, trimmed by INTERNAL_FREQ_FINE).
+//
+// Ism330FifoDecoder pairs each accel word with its gyro word and stamps
+// the pair with the last timestamp seen, converted to microseconds on a
+// wrapping uint32 timeline. dtUs is the exact spacing to the previous
+// sample, so the AHRS integrates sensor time rather than task wake time.
+// Temperature words (ODR_T_BATCH) update LastTempRaw().
+//
+// No dynamic allocation. No platform dependencies.
+
+#ifndef ONSPEED_CORE_SENSORS_ISM330_FIFO_H
+#define ONSPEED_CORE_SENSORS_ISM330_FIFO_H
+
+#include <cstdint>
+
+namespace onspeed::sensors {
+
+// Bytes per FIFO word (tag + 6 data bytes).
+inline constexpr int kIsm330FifoWordBytes = 7;
+
+// TAG_SENSOR values the decoder acts on (datasheet table "FIFO tag").
+inline constexpr uint8_t kIsm330TagGyro        = 0x01;
+inline constexpr uint8_t kIsm330TagAccel       = 0x02;
+inline constexpr uint8_t kIsm330TagTemperature = 0x03;
+inline constexpr uint8_t kIsm330TagTimestamp   = 0x04;
+
+// Nominal timestamp resolution, microseconds per tick.
+inline constexpr float kIsm330TimestampTickUs = 25.0f;
+
+// ODR_XL / ODR_G / BDR_XL / BDR_GY 4-bit code for a sample rate in Hz
+// (12.5 .. 6667 Hz share one encoding). Rates between codes round down;
+// 0 for anything below 12 Hz (power-down / not batched).
+uint8_t Ism330OdrCode(int rateHz);
+
+// Timestamp resolution in microseconds for an INTERNAL_FREQ_FINE (63h)
+// reading: 1 / (40 kHz * (1 + 0.0015 * freqFine)).
+float Ism330TickUsForFreqFine(int8_t freqFine);
+
+// FIFO_STATUS1/2 decoded: unread words and the sticky overrun flag.
+struct Ism330FifoStatus {
+    uint16_t words   = 0;
+    bool     overrun = false;
+};
+
+Ism330FifoStatus Ism330DecodeFifoStatus(uint8_t status1, uint8_t status2);
+
+// One accel + gyro pair in sensor axes, raw counts.
+struct Ism330FifoSample {
+    int16_t  accel[3]    = {0, 0, 0};
+    int16_t  gyro[3]     = {0, 0, 0};
+    uint32_t timestampUs = 0;   // sensor timeline; wraps like micros()
+    uint32_t dtUs        = 0;   // spacing to the previous sample; 0 for the first
+};
+
+// Host-clock time of a sample from a FIFO read taken at `readUs`. The
+// newest sample of the read (sensor time `newestUs`) is taken as just
+// before the read; `sampleUs` sits the sensor-timeline distance earlier.
+// `readUs` may be the 64-bit esp_timer clock or the wrapping micros()
+// one; the sensor timeline only ever contributes a difference.
+inline uint64_t Ism330FifoSampleHostUs(uint64_t readUs, uint32_t newestUs, uint32_t sampleUs)
+{
+    return readUs - static_cast<uint32_t>(newestUs - sampleUs);
+}
+
+struct Ism330FifoStats {
+    uint32_t words       = 0;   // words decoded
+    uint32_t samples     = 0;   // accel + gyro pairs emitted
+    uint32_t unpaired    = 0;   // accel or gyro words replaced before their partner arrived
+    uint32_t untimed     = 0;   // pairs dropped because no timestamp had been seen yet
+    uint32_t dropped     = 0;   // pairs that did not fit the caller's output array
+    uint32_t temps       = 0;   // temperature words
+    uint32_t otherTags   = 0;   // words with a tag the decoder ignores
+};
+
+class Ism330FifoDecoder
+{
+public:
+    explicit Ism330FifoDecoder(float tickUs = kIsm330TimestampTickUs);
+
+    // Forget the pairing state and the timeline (after a FIFO flush or an
+    // overrun). The tick period and the statistics are kept.
+    void Reset();
+
+    void SetTickUs(float tickUs);
+
+    // Decode `wordCount` consecutive 7-byte words. Completed samples are
+    // written to `out` (at most `outCap`); returns how many. A pair that
+    // does not fit is dropped and counted in stats.dropped.
+    int Decode(const uint8_t* words, int wordCount, Ism330FifoSample* out, int outCap);
+
+    bool    HasTemp()     const { return haveTemp_; }
+    int16_t LastTempRaw() const { return tempRaw_; }
+
+    const Ism330FifoStats& Stats() const { return stats_; }
+
+private:
+    uint32_t tickQ16_;               // microseconds per tick, Q16.16
+
+    bool     haveTick_   = false;    // a timestamp word has been seen
+    uint32_t lastTick_   = 0;
+    uint32_t nowUs_      = 0;        // timeline position of lastTick_
+    uint32_t fracQ16_    = 0;        // sub-microsecond carry
+
+    bool     haveSample_ = false;    // a sample has been emitted on this timeline
+    uint32_t lastSampleUs_ = 0;
+
+    bool     haveAccel_  = false;
+    bool     haveGyro_   = false;
+    int16_t  accel_[3]   = {0, 0, 0};
+    int16_t  gyro_[3]    = {0, 0, 0};
+
+    bool     haveTemp_   = false;
+    int16_t  tempRaw_    = 0;
+
+    Ism330FifoStats stats_;
+};
+
+}  // namespace onspeed::sensors
+
+#endif  // ONSPEED_CORE_SENSORS_ISM330_FIFO_H
@@ -7,6 +7,15 @@
 // Both the Gen3 firmware builder (DisplaySerial.cpp) and the M5 display
 // parser (SerialRead.cpp) implement this. This header is the single source
 // of truth for the algorithm so the two sides cannot drift.
+//
+// Crc32 is the standard reflected CRC-32 (IEEE 802.3, poly 0xEDB88320,
+// the zlib / PNG variant) used by the binary SD log blocks in
+// proto/LogBin.h.  Nibble-table implementation: 16-entry table, two
+// lookups per byte — small enough for flash, ~4x faster than bitwise.
+//
+// Crc16Ccitt is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no
+// reflection) guarding the binary display-serial frame in
+// proto/DisplaySerial.h.  Same nibble-table approach, MSB first.
 
 #ifndef ONSPEED_CORE_UTIL_CRC_H
 #define ONSPEED_CORE_UTIL_CRC_H
@@ -27,6 +36,42 @@ inline uint8_t Checksum8(const uint8_t* data, size_t len)
     return static_cast<uint8_t>(sum & 0xFFu);
 }
 
+/// Standard CRC-32 (reflected, poly 0xEDB88320, init/xorout 0xFFFFFFFF).
+/// Crc32("123456789") == 0xCBF43926.  Pass the previous return value as
+/// `crc` to continue a running checksum across split buffers.
+inline uint32_t Crc32(const uint8_t* data, size_t len, uint32_t crc = 0)
+{
+    static constexpr uint32_t kNibble[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ kNibble[crc & 0x0Fu];
+        crc = (crc >> 4) ^ kNibble[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
+/// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no
+/// xorout).  Crc16Ccitt("123456789") == 0x29B1.  Pass the previous
+/// return value as `crc` to continue across split buffers.
+inline uint16_t Crc16Ccitt(const uint8_t* data, size_t len, uint16_t crc = 0xFFFFu)
+{
+    static constexpr uint16_t kNibble[16] = {
+        0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+        0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu,
+    };
+    for (size_t i = 0; i < len; ++i) {
+        crc = static_cast<uint16_t>((crc << 4) ^ kNibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = static_cast<uint16_t>((crc << 4) ^ kNibble[(crc >> 12) ^ (data[i] & 0x0Fu)]);
+    }
+    return crc;
+}
+
 }   // namespace onspeed::util
 
 #endif  // ONSPEED_CORE_UTIL_CRC_H
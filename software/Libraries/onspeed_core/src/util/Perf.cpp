@@ -10,6 +10,8 @@
 //   task_hist_[kTaskCount]   — consumer accumulator, task loop periods.
 //   task_stack_min_[kTaskCount] — min stack-words-remaining in interval.
 //   spi_counters_[kScopeCount]  — bytes/xfers/max for SPI scopes only.
+//   trace_events_[kTraceCapacity] — shared trace-capture window, filled
+//                              only while a capture is armed.
 //
 // Producer cost: one relaxed-load + one acquire-load + one store +
 // one release-store on the ring. No fetch_add, no CAS loop.
@@ -105,6 +107,7 @@ constexpr const char* kScopeNames[] = {
     "efis_read",
     "boom_read",
     "synth_build",
+    "stall_onset",
     "spare0", "spare1", "spare2", "spare3",
 };
 static_assert(sizeof(kScopeNames) / sizeof(kScopeNames[0]) == kScopeCount,
@@ -344,6 +347,17 @@ void setPerfEnabled(bool e) {
     g_perfEnabled.store(e, std::memory_order_release);
 }
 
+void recordScopeEvent(ScopeId scopeId, uint64_t startUs, uint32_t durationUs) {
+    if (!perfEnabled()) return;
+    Ring* r = getTlsRing();
+    if (r == nullptr) return;
+    const uint8_t id = static_cast<uint8_t>(scopeId);
+    pushEvent(r, PerfEvent{durationUs, id, /*flags=*/0u, 0u});
+    if (traceCaptureArmed()) {
+        recordTraceEvent(r, startUs, durationUs, id, 0u, 0u);
+    }
+}
+
 void recordSpiTransfer(ScopeId scopeId, uint32_t bytes, uint32_t durationUs) {
     if (!perfEnabled()) return;
     const auto i = static_cast<size_t>(scopeId);
@@ -364,6 +378,150 @@ void recordSpiTransfer(ScopeId scopeId, uint32_t bytes, uint32_t durationUs) {
     }
 }
 
+// ===========================================================================
+// Trace capture.
+// ===========================================================================
+
+namespace detail {
+std::atomic<bool> g_traceArmed{false};
+}  // namespace detail
+
+namespace {
+
+ONSPEED_PSRAM_BSS_ATTR TraceEvent g_trace_events[kTraceCapacity];
+
+// Claimed counts slot reservations (it overshoots kTraceCapacity by the
+// events that raced the window filling); published counts slots whose
+// contents are written. The window is readable once published catches
+// up with min(claimed, capacity).
+//
+// Both counters carry the capture's generation in their top 16 bits. A
+// producer that passed the armed check for one capture can reach its
+// claim or publish after that window was released and another started;
+// the generation mismatch makes its compare-exchange fail instead of
+// adding a count the new window will never see a matching publish for
+// (which would leave traceWindowReady() false for good).
+constexpr uint32_t kTraceGenShift = 16;
+constexpr uint32_t kTraceCountMask = (1u << kTraceGenShift) - 1u;
+static_assert(kTraceCapacity < kTraceCountMask,
+              "trace count field must hold the capacity plus overshoot");
+
+std::atomic<uint32_t> g_traceClaimed{0};
+std::atomic<uint32_t> g_tracePublished{0};
+std::atomic<uint32_t> g_traceGen{0};
+
+inline uint32_t traceGenOf(uint32_t packed)   { return packed >> kTraceGenShift; }
+inline uint32_t traceCountOf(uint32_t packed) { return packed & kTraceCountMask; }
+
+// Add one to a packed counter if it still belongs to `gen`; returns
+// false (counter untouched) once another capture has reset it, or when
+// the count field is saturated. `before` receives the pre-increment value.
+inline bool traceCountAdd(std::atomic<uint32_t>& counter, uint32_t gen,
+                          std::memory_order order, uint32_t& before) {
+    before = counter.load(std::memory_order_relaxed);
+    do {
+        if (traceGenOf(before) != gen) return false;
+        if (traceCountOf(before) == kTraceCountMask) return false;
+    } while (!counter.compare_exchange_weak(before, before + 1u, order,
+                                            std::memory_order_relaxed));
+    return true;
+}
+// Armed, or holding a window nobody has released yet.
+std::atomic<bool>     g_traceInUse{false};
+// Written before the release-store that arms; producers read it after
+// an acquire-load of the armed flag.
+uint64_t              g_traceOriginUs = 0;
+
+inline uint8_t currentCoreId() {
+#ifdef ARDUINO_ARCH_ESP32
+    return static_cast<uint8_t>(xPortGetCoreID());
+#else
+    return 0;
+#endif
+}
+
+}  // namespace
+
+bool startTraceCapture() {
+    bool expected = false;
+    if (!g_traceInUse.compare_exchange_strong(expected, true,
+                                              std::memory_order_acq_rel)) {
+        return false;
+    }
+    const uint32_t gen =
+        (g_traceGen.load(std::memory_order_relaxed) + 1u) & kTraceCountMask;
+    g_traceClaimed.store(gen << kTraceGenShift, std::memory_order_relaxed);
+    g_tracePublished.store(gen << kTraceGenShift, std::memory_order_relaxed);
+    g_traceGen.store(gen, std::memory_order_relaxed);
+    g_traceOriginUs = nowUs();
+    detail::g_traceArmed.store(true, std::memory_order_release);
+    return true;
+}
+
+void stopTraceCapture() {
+    detail::g_traceArmed.store(false, std::memory_order_release);
+}
+
+bool traceWindowReady(TraceWindow& out) {
+    if (!g_traceInUse.load(std::memory_order_acquire)) return false;
+    if (detail::g_traceArmed.load(std::memory_order_acquire)) return false;
+    const uint32_t gen     = g_traceGen.load(std::memory_order_relaxed);
+    const uint32_t packed  = g_traceClaimed.load(std::memory_order_acquire);
+    const uint32_t pub     = g_tracePublished.load(std::memory_order_acquire);
+    if (traceGenOf(packed) != gen || traceGenOf(pub) != gen) return false;
+    const uint32_t claimed = traceCountOf(packed);
+    const uint32_t count = std::min<uint32_t>(claimed, kTraceCapacity);
+    if (traceCountOf(pub) != count) return false;
+    out.events   = g_trace_events;
+    out.count    = count;
+    out.dropped  = claimed - count;
+    out.originUs = g_traceOriginUs;
+    return true;
+}
+
+void releaseTraceWindow() {
+    stopTraceCapture();
+    g_traceInUse.store(false, std::memory_order_release);
+}
+
+void recordTraceEvent(Ring* r, uint64_t startUs, uint32_t durationUs,
+                      uint8_t scopeId, uint8_t flags,
+                      uint16_t stackHighWaterWords) {
+    if (!detail::g_traceArmed.load(std::memory_order_acquire)) return;
+    // Generation and origin are written before the release-store that
+    // arms, so they belong to the capture this event was admitted to.
+    const uint32_t gen = g_traceGen.load(std::memory_order_relaxed);
+    // A loop or scope that began before the capture was armed would
+    // start before the window's origin; leave it out.
+    if (startUs < g_traceOriginUs) return;
+
+    uint32_t packed;
+    if (!traceCountAdd(g_traceClaimed, gen, std::memory_order_relaxed, packed)) return;
+    const uint32_t i = traceCountOf(packed);
+    if (i >= kTraceCapacity) return;
+
+    TraceEvent& ev = g_trace_events[i];
+    ev.startUs    = static_cast<uint32_t>(startUs - g_traceOriginUs);
+    ev.durationUs = durationUs;
+    ev.scopeId    = scopeId;
+    ev.flags      = flags;
+    ev.taskId     = (r >= g_rings && r < g_rings + kTaskCount)
+                        ? static_cast<uint8_t>(r - g_rings)
+                        : kTraceNoTask;
+    ev.coreId     = currentCoreId();
+    ev.stackHighWaterWords = stackHighWaterWords;
+    ev.reserved   = 0;
+    // The consumer only releases a ready window, and this claim holds
+    // readiness off until the publish lands. An early releaseTraceWindow()
+    // can still restart capture under us: the generation check then
+    // drops the publish, keeping the new window's counts exact (the slot
+    // write above may still clobber one of its events).
+    traceCountAdd(g_tracePublished, gen, std::memory_order_release, packed);
+
+    // Last slot: disarm so every later event skips the RMWs.
+    if (i + 1 == kTraceCapacity) stopTraceCapture();
+}
+
 // ===========================================================================
 // Histogram.
 // ===========================================================================
@@ -69,6 +69,14 @@
 //     ExponentialBucketHistogram) preserve dynamic range — necessary
 //     here because IMU scopes are ~1–10 μs and task loops are 5–60 ms.
 //
+//   Trace capture (opt-in, bounded):
+//     Histograms lose ordering, so cross-task interference is invisible
+//     in them. startTraceCapture() additionally copies every scope and
+//     loop event, with start time, task and core, into one shared
+//     kTraceCapacity-slot window until it fills. PerfDump prints the
+//     window; tools/perf-report/perf_trace.py turns it into a Chrome /
+//     Perfetto trace.
+//
 // Time source:
 //   esp_timer_get_time() on ESP-IDF (1 μs monotonic). On native
 //   builds, std::chrono::steady_clock. Hidden behind nowUs().
@@ -77,6 +85,8 @@
 //   12 producer rings × 8 KB = 96 KB internal RAM. Histograms in the
 //   consumer's static buffer: 32 buckets × scope+task count × 4 B ≈
 //   8 KB. All in .bss, no heap.
+//   Trace window: kTraceCapacity × 16 B = 64 KB, same placement as the
+//   ring buffers.
 
 #ifndef ONSPEED_CORE_UTIL_PERF_H
 #define ONSPEED_CORE_UTIL_PERF_H
@@ -112,6 +122,7 @@ enum class ScopeId : uint8_t {
     EfisRead,    ///< g_EfisSerial.Read() — UART drain + parser + CRC + apply.
     BoomRead,    ///< g_BoomSerial.Read() — UART drain + ASCII parse.
     SynthBuild,  ///< Synthetic-sensor frame construction (perf-synth env only).
+    StallOnset,  ///< Stall-warning SetTone() → first stall sample queued to DMA (estimated).
     Spare0, Spare1, Spare2, Spare3,
     Count,
 };
@@ -272,6 +283,75 @@ inline void pushEvent(Ring* r, const PerfEvent& ev) {
     r->head.store(h + 1, std::memory_order_release);
 }
 
+// ===========================================================================
+// Trace capture — ordered, timestamped events for one bounded window.
+//
+// While armed, every PerfScope / PerfLoop event is ALSO written into a
+// single shared window of kTraceCapacity TraceEvents, tagged with its
+// start time, task and core. The window is multi-producer: an event
+// claims a slot with one compare-exchange and publishes with a second,
+// both tagged with the capture's generation so a straggler from a
+// released window cannot count against the next one. Those RMWs are
+// paid only while a capture is armed; disarmed, producers add one
+// relaxed load. Capture disarms itself when the window fills
+// (or on stopTraceCapture()); the window is then read out whole and
+// released before the next capture can start.
+//
+// kTraceCapacity sizing: the IMU task alone emits ~832 events/s at
+// 208 Hz and the remaining tasks a few hundred more, so 4096 slots hold
+// ~2.5 s — a dozen LogSync periods (~200 ms) against IMU jitter.
+// ===========================================================================
+struct TraceEvent {
+    uint32_t startUs;              ///< Start, µs since startTraceCapture().
+    uint32_t durationUs;
+    uint8_t  scopeId;              ///< As PerfEvent::scopeId.
+    uint8_t  flags;                ///< As PerfEvent::flags.
+    uint8_t  taskId;               ///< Producing ring's TaskId; kTraceNoTask if unknown.
+    uint8_t  coreId;               ///< CPU core the event ended on.
+    uint16_t stackHighWaterWords;  ///< Loop events only.
+    uint16_t reserved;
+};
+static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay 16 bytes");
+
+constexpr size_t  kTraceCapacity = 4096;
+constexpr uint8_t kTraceNoTask   = 0xFF;
+
+namespace detail {
+extern std::atomic<bool> g_traceArmed;
+}  // namespace detail
+
+/// Hot-path check; true between startTraceCapture() and the window filling.
+inline bool traceCaptureArmed() {
+    return detail::g_traceArmed.load(std::memory_order_relaxed);
+}
+
+/// Arm a new capture. Returns false (and does nothing) while a previous
+/// window is still armed or has not been released.
+bool startTraceCapture();
+
+/// Disarm early. The window becomes readable once in-flight events land.
+void stopTraceCapture();
+
+/// A stopped, fully published capture window.
+struct TraceWindow {
+    const TraceEvent* events;
+    uint32_t          count;     ///< Events in the window, ≤ kTraceCapacity.
+    uint32_t          dropped;   ///< Events that arrived after it filled.
+    uint64_t          originUs;  ///< nowUs() at startTraceCapture().
+};
+
+/// Fill `out` and return true once a capture has stopped and every
+/// claimed slot is published. Returns false while idle or armed.
+bool traceWindowReady(TraceWindow& out);
+
+/// Discard the window so startTraceCapture() may run again.
+void releaseTraceWindow();
+
+/// Producer side, called by PerfScope / PerfLoop only when armed.
+void recordTraceEvent(Ring* r, uint64_t startUs, uint32_t durationUs,
+                      uint8_t scopeId, uint8_t flags,
+                      uint16_t stackHighWaterWords);
+
 // ===========================================================================
 // PerfScope — RAII timer for a code region. Emits one scope event.
 // ===========================================================================
@@ -287,6 +367,9 @@ public:
             const uint64_t end = nowUs();
             const uint32_t dur = static_cast<uint32_t>(end - startUs_);
             pushEvent(ring_, PerfEvent{dur, scopeId_, /*flags=*/0u, 0u});
+            if (traceCaptureArmed()) {
+                recordTraceEvent(ring_, startUs_, dur, scopeId_, 0u, 0u);
+            }
         }
     }
 
@@ -320,6 +403,10 @@ public:
             const uint32_t dur = static_cast<uint32_t>(end - startUs_);
             pushEvent(ring_, PerfEvent{
                 dur, kLoopSentinelScopeId, kFlagLoop, stackHigh_});
+            if (traceCaptureArmed()) {
+                recordTraceEvent(ring_, startUs_, dur, kLoopSentinelScopeId,
+                                 kFlagLoop, stackHigh_);
+            }
         }
     }
 
@@ -333,6 +420,13 @@ private:
     uint64_t startUs_;
 };
 
+// ===========================================================================
+// Explicit scope event for an interval that can't be one C++ scope —
+// e.g. it starts on another task, or ends in the future (queued audio).
+// Lands in the calling task's ring like a PerfScope event would.
+// ===========================================================================
+void recordScopeEvent(ScopeId scopeId, uint64_t startUs, uint32_t durationUs);
+
 // ===========================================================================
 // SPI transfer recording — explicit (no RAII; called from driver post-xfer).
 // scopeId must be one of SpiImu / SpiAoa / SpiPitot / SpiStatic / SpiSd.
@@ -413,6 +507,7 @@ public:
     PerfLoop(TaskId, uint32_t) noexcept {}
 };
 inline void recordSpiTransfer(ScopeId, uint32_t, uint32_t) {}
+inline void recordScopeEvent(ScopeId, uint64_t, uint32_t) {}
 inline bool perfEnabled() { return false; }
 inline void setPerfEnabled(bool) {}
 inline void bindCurrentTaskToRing(TaskId) {}
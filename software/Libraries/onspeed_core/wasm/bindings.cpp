@@ -29,6 +29,7 @@
 #include <config/OnSpeedConfig.h>
 #include <proto/DisplaySerial.h>
 #include <replay/LogReplayEngine.h>
+#include <replay/LogReplaySeeker.h>
 #include <replay/LogReplayTask.h>
 #include <types/LogRow.h>
 
@@ -629,6 +630,58 @@ private:
     onspeed::replay::LogReplayTask task_;
 };
 
+// ---------------------------------------------------------------------------
+// LogReplaySeeker: LogReplayTask with checkpointed seek and fast-forward.
+//
+// The replay page appends every parsed row once, then asks for frames by
+// row index. A scrub restores the nearest checkpoint (every
+// checkpointIntervalSec of log time) and steps the rows in between
+// without encoding them, so jumping anywhere in a long log costs one
+// interval of engine steps instead of a full pre-encoded frame array.
+//
+//   new Module.LogReplaySeeker(cfgVal, logSampleRateHz,
+//                              flapsRawAdcAvailable, checkpointIntervalSec)
+//   seeker.appendRow(rowVal)   -> bool
+//   seeker.buildCheckpoints()
+//   seeker.seek(rowIdx)        -> bool
+//   seeker.next()              -> Uint8Array (77 bytes), zero-length at end
+//   seeker.advance(rows)       -> same; frame for the last of `rows` rows
+//   seeker.lastStep()          -> engine result behind the last frame
+//   seeker.position() / rowCount() / checkpointCount()
+//   seeker.delete()
+// ---------------------------------------------------------------------------
+class LogReplaySeekerHandle {
+public:
+    LogReplaySeekerHandle(val cfgVal, int logSampleRateHz, bool flapsRawAdcAvailable,
+                          float checkpointIntervalSec)
+        : seeker_(ConfigFromVal(cfgVal), logSampleRateHz, flapsRawAdcAvailable,
+                  checkpointIntervalSec)
+    {}
+
+    bool appendRow(val rowVal)          { return seeker_.appendRow(LogRowFromVal(rowVal)); }
+    void reserveRows(unsigned count)    { seeker_.reserveRows(count); }
+    void buildCheckpoints()             { seeker_.buildCheckpoints(); }
+    bool seek(unsigned rowIdx)          { return seeker_.seek(rowIdx); }
+    val  next()                         { return FrameToVal(seeker_.next()); }
+    val  advance(unsigned rows)         { return FrameToVal(seeker_.advance(rows)); }
+    val  lastStep() const               { return StepResultToVal(seeker_.lastStep()); }
+    unsigned position() const           { return static_cast<unsigned>(seeker_.position()); }
+    unsigned rowCount() const           { return static_cast<unsigned>(seeker_.rowCount()); }
+    unsigned checkpointCount() const    { return static_cast<unsigned>(seeker_.checkpointCount()); }
+
+private:
+    onspeed::replay::LogReplaySeeker seeker_;
+
+    // Copies out of the temporary vector; a typed_memory_view alone
+    // would dangle once it is destroyed.
+    static val FrameToVal(const std::vector<uint8_t>& bytes)
+    {
+        val Uint8Array = val::global("Uint8Array");
+        if (bytes.empty()) return Uint8Array.new_(0);
+        return Uint8Array.new_(typed_memory_view(bytes.size(), bytes.data()));
+    }
+};
+
 // ---------------------------------------------------------------------------
 // build_display_frame
 //
@@ -840,6 +893,21 @@ EMSCRIPTEN_BINDINGS(onspeed_core_module) {
         .function("lastStep",          &LogReplayTaskHandle::lastStep)
         .function("cfgFlapsDegrees",   &LogReplayTaskHandle::cfgFlapsDegrees);
 
+    // Seekable replay: checkpointed scrub and fast-forward over the same
+    // task pipeline.
+    class_<LogReplaySeekerHandle>("LogReplaySeeker")
+        .constructor<val, int, bool, float>()
+        .function("appendRow",         &LogReplaySeekerHandle::appendRow)
+        .function("reserveRows",       &LogReplaySeekerHandle::reserveRows)
+        .function("buildCheckpoints",  &LogReplaySeekerHandle::buildCheckpoints)
+        .function("seek",              &LogReplaySeekerHandle::seek)
+        .function("next",              &LogReplaySeekerHandle::next)
+        .function("advance",           &LogReplaySeekerHandle::advance)
+        .function("lastStep",          &LogReplaySeekerHandle::lastStep)
+        .function("position",          &LogReplaySeekerHandle::position)
+        .function("rowCount",          &LogReplaySeekerHandle::rowCount)
+        .function("checkpointCount",   &LogReplaySeekerHandle::checkpointCount);
+
     // Bulldog round-1 fix C1: expose the canonical wire-frame builder so
     // the M5-replay-WASM Node test can drive frames without a JS hand-port.
     function("build_display_frame", &build_display_frame);
@@ -311,6 +311,21 @@ constexpr int kBaudConsole = 921600;
 constexpr int kImuSampleRateDefault       = 208;
 constexpr int kImuSampleRateExperimental  = 416;
 
+// IMU FIFO batching. 0 keeps today's register polling: ImuReadTask wakes
+// once per sample and takes xSensorMutex for two SPI reads each time.
+// N > 1 runs the ISM330 FIFO in continuous mode with its timestamp
+// counter on; ImuReadTask wakes once per N samples, reads them all in
+// one burst under one mutex take, and steps the AHRS once per sample
+// with the dt between the sensor's own timestamps. A late wake no longer
+// loses samples (the FIFO holds ~3 KB, over 100 samples), which is what
+// makes 833 Hz practical under WiFi load.
+//
+// EXPERIMENTAL — off until flight-validated alongside 416 Hz.
+constexpr int kImuFifoBatchSamples     = 0;
+// Most samples one wake drains; a backlog left after a stall is read
+// on the following (immediate) wakes.
+constexpr int kImuFifoMaxSamplesPerRead = 16;
+
 // Pressure sensors (pitot, AOA, static) are polled at 50 Hz.
 constexpr int kPressureSampleRateHz = 50;
 constexpr int kPressureIntervalMs   = 1000 / kPressureSampleRateHz;
@@ -321,6 +336,12 @@ constexpr int kPressureIntervalMs   = 1000 / kPressureSampleRateHz;
 // assume this value — they measure their own frame dt.
 constexpr int kDisplaySerialPeriodMs = 50;
 
+// Display serial cadence when SERIALOUTFORMAT is ONSPEED_BIN.  The binary
+// frame is 11-40 bytes, so 100 Hz still uses under half the 115200 baud
+// link. Only the UART task runs at this rate; DataServer stays on
+// kDisplaySerialPeriodMs.
+constexpr int kDisplaySerialBinPeriodMs = 10;
+
 // Gyro running-average window length (samples).
 constexpr int kGyroSmoothing = 30;
 
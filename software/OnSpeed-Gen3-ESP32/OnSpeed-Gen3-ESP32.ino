@@ -297,7 +297,7 @@ void setup()
     // --------------------
     g_pIMU = new IMU330(g_pSensorSPI, kCsImu);
     delay(100);
-    g_pIMU->Init();
+    g_pIMU->Init(kImuFifoBatchSamples > 1);
 
     // Configure accelerometer axes
     g_pIMU->ConfigAxes();
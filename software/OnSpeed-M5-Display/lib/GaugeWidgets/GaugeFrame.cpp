@@ -0,0 +1,57 @@
+// software/OnSpeed-M5-Display/lib/GaugeWidgets/GaugeFrame.cpp
+//
+// Persistent framebuffer + dirty-tile push. See GaugeFrame.h.
+
+#include "GaugeFrame.h"
+
+using onspeed::gauges::DirtyRect;
+using onspeed::gauges::kDirtyMaxRects;
+
+bool GaugeFrame::begin(uint8_t colorDepth, int16_t width, int16_t height)
+{
+    if (buffer_ != nullptr && canvas_.getBuffer() == buffer_ && depth_ == colorDepth &&
+        canvas_.width() == width && canvas_.height() == height)
+        return true;
+
+    // Free first: holding an 8-bit and a 16-bit full-screen canvas at
+    // once does not fit the M5 Basic's heap.
+    canvas_.deleteSprite();
+    canvas_.setColorDepth(colorDepth);
+    buffer_ = canvas_.createSprite(width, height);
+    depth_  = colorDepth;
+    tiles_.Reset(width, height);   // marks everything
+    return buffer_ != nullptr;
+}
+
+uint32_t GaugeFrame::present(lgfx::LovyanGFX& dst)
+{
+    if (buffer_ == nullptr || canvas_.getBuffer() != buffer_)
+        return 0;
+
+    const int bytesPerPixel = depth_ / 8;
+    tiles_.Scan(static_cast<const uint8_t*>(buffer_), bytesPerPixel,
+                static_cast<std::size_t>(canvas_.width()) * bytesPerPixel);
+
+    DirtyRect rects[kDirtyMaxRects];
+    const int n = tiles_.TakeRects(rects, kDirtyMaxRects);
+    ++frames_;
+    if (n == 0)
+        return 0;
+
+    // One transaction; the panel's clip rect limits each full-canvas
+    // push to the dirty rectangle.
+    uint32_t pushed = 0;
+    dst.startWrite();
+    for (int i = 0; i < n; ++i)
+    {
+        dst.setClipRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+        canvas_.pushSprite(&dst, 0, 0);
+        pushed += static_cast<uint32_t>(rects[i].w) * static_cast<uint32_t>(rects[i].h);
+    }
+    dst.clearClipRect();
+    dst.endWrite();
+
+    pixels_ += pushed;
+    rects_  += static_cast<uint32_t>(n);
+    return pushed;
+}
@@ -0,0 +1,66 @@
+// software/OnSpeed-M5-Display/lib/GaugeWidgets/GaugeFrame.h
+//
+// Persistent off-screen framebuffer for the gauge renderer.
+//
+// Every screen used to createSprite() a full 320x240 canvas, draw into
+// it, pushSprite() all of it and deleteSprite() — a heap alloc/free and a
+// full-panel SPI transfer per frame, even though between two frames only
+// the needle, the tape digits and the slip ball move. GaugeFrame keeps
+// the canvas allocated across frames and pushes only the tiles whose
+// pixels changed since the last push (onspeed::gauges::DirtyTileMap).
+//
+// Usage, per frame:
+//
+//     gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, WIDTH, HEIGHT);
+//     gdraw.fillSprite(TFT_BLACK);
+//     ... draw the whole screen into gdraw as before ...
+//     gaugeFrame.present(M5.Display);
+//
+// begin() only allocates when the canvas is missing or its size / depth
+// differs (e.g. after the 16-bit splash), and then forces a full push.
+// Call invalidate() when something other than present() drew on the
+// panel, so the next present() repaints it all.
+
+#ifndef _GAUGEFRAME_H_
+#define _GAUGEFRAME_H_
+
+#include <cstdint>
+
+#include "GaugeWidgets.h"
+
+#include <gauges/DirtyTiles.h>
+
+class GaugeFrame {
+public:
+    explicit GaugeFrame(M5Canvas& canvas) : canvas_(canvas) {}
+
+    // Make sure the canvas is a `width` x `height` sprite at `colorDepth`
+    // bits per pixel (8, 16 or 24). False if the allocation failed.
+    bool begin(uint8_t colorDepth, int16_t width, int16_t height);
+
+    // Push the whole frame on the next present().
+    void invalidate() { tiles_.MarkAll(); }
+
+    // Push this region on the next present() even if its pixels match.
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h) { tiles_.MarkRect(x, y, w, h); }
+
+    // Push the changed regions of the canvas to `dst` at (0, 0). Returns
+    // the number of pixels sent.
+    uint32_t present(lgfx::LovyanGFX& dst);
+
+    // Running totals since boot, for the SDL sim's push statistics.
+    uint32_t framesPresented() const { return frames_; }
+    uint64_t pixelsPushed()    const { return pixels_; }
+    uint32_t rectsPushed()     const { return rects_; }
+
+private:
+    M5Canvas&                       canvas_;
+    onspeed::gauges::DirtyTileMap   tiles_;
+    void*                           buffer_ = nullptr;   // what begin() allocated
+    uint8_t                         depth_  = 0;
+    uint32_t                        frames_ = 0;
+    uint64_t                        pixels_ = 0;
+    uint32_t                        rects_  = 0;
+};
+
+#endif
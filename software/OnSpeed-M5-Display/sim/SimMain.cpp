@@ -15,6 +15,10 @@
 //   Down   -> GPIO 38 = M5.BtnB (cycles display mode)
 //   Right  -> GPIO 37 = M5.BtnC (brightness up)
 //   Up     -> GPIO 36 = M5.BtnPWR (unused by the OnSpeed display)
+//
+// ONSPEED_SIM_FRAME_STATS=1 (desktop only) prints, every 5 s, how much of
+// each frame GaugeFrame actually pushed to the panel — the number the
+// dirty-tile renderer exists to keep small.
 
 #include <M5GFX.h>
 
@@ -28,10 +32,13 @@
 #endif
 
 #include "ArduinoShim.h"
+#include <GaugeFrame.h>
 
 void setup(void);
 void loop(void);
 
+extern GaugeFrame gaugeFrame;
+
 #if defined(SIM_LIVE)
 // Live-data WASM target: JS bridge calls this once per byte received
 // over the firmware's WebSocket binary channel. The C++ symbol is
@@ -87,12 +94,47 @@ int main(int /*argc*/, char** /*argv*/)
 
 #else
 
+static void print_frame_stats(void)
+{
+    constexpr int kFramePixels = 320 * 240;
+    static uint32_t lastMs     = 0;
+    static uint32_t lastFrames = 0;
+    static uint64_t lastPixels = 0;
+    static uint32_t lastRects  = 0;
+
+    const uint32_t now = millis();
+    if (now - lastMs < 5000)
+        return;
+
+    const uint32_t frames = gaugeFrame.framesPresented() - lastFrames;
+    const uint64_t pixels = gaugeFrame.pixelsPushed() - lastPixels;
+    const uint32_t rects  = gaugeFrame.rectsPushed() - lastRects;
+    if (frames > 0)
+        {
+        const double perFrame = static_cast<double>(pixels) / frames;
+        std::fprintf(stderr,
+                     "[sim] %u frames: %.0f px/frame pushed (%.1f%% of %d), %.1f rects/frame\n",
+                     static_cast<unsigned>(frames), perFrame,
+                     100.0 * perFrame / kFramePixels, kFramePixels,
+                     static_cast<double>(rects) / frames);
+        }
+    lastMs     = now;
+    lastFrames = gaugeFrame.framesPresented();
+    lastPixels = gaugeFrame.pixelsPushed();
+    lastRects  = gaugeFrame.rectsPushed();
+}
+
 static int user_func(bool* running)
 {
+    const char* stats = std::getenv("ONSPEED_SIM_FRAME_STATS");
+    const bool  bStats = stats != nullptr && stats[0] == '1';
+
     setup();
     do
         {
         loop();
+        if (bStats)
+            print_frame_stats();
         }
     while (*running);
     return 0;
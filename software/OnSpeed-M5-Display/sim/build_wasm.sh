@@ -165,6 +165,7 @@ FW_SOURCES=(
     "${PROJECT_DIR}/src/SettingsMenu.cpp"
     "${PROJECT_DIR}/lib/MenuModel/MenuModel.cpp"
     "${PROJECT_DIR}/lib/GaugeWidgets/GaugeWidgets.cpp"
+    "${PROJECT_DIR}/lib/GaugeWidgets/GaugeFrame.cpp"
     "${VERSION_DIR}/buildinfo.cpp"
 )
 if [[ "${TARGET}" == "replay" ]]; then
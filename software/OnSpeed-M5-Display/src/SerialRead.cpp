@@ -13,7 +13,8 @@
 #include <M5Unified.h>
 #endif
 #include <Free_Fonts.h>
-#include <filters/SavGolDerivative.h>
+#include <GaugeFrame.h>
+#include <filters/DecelRateFilter.h>
 #include <proto/DisplaySerial.h>
 #include "SerialRead.h"
 #ifndef XPLANE_PLUGIN_BUILD
@@ -24,17 +25,15 @@ using onspeed::proto::ParseDisplayFrame;
 using onspeed::proto::kDisplayFrameSizeBytes;
 using onspeed::proto::DisplayFrame;
 
-// Decel-rate EMA on the locally-computed IAS derivative. AOA and LateralG
-// are used as-received — the main firmware already smooths them at the
-// sensor layer (iAoaSmoothing, AccelLatFilter), so the display matches
-// what the audio tones react to.
-static const float decelSmoothingAlpha = 0.04f;  // 0 = max smoothing, 1 = no smoothing (pass-through).
-
-// IAS derivative filter (Savitzky-Golay first derivative, window=15)
-static double iasDerivativeInput;
-static onspeed::SavGolDerivative iasDerivative(&iasDerivativeInput, 15);
+// Decel rate from the locally-differentiated IAS (SavGol window 15, then
+// an EMA), decimated to 20 Hz so #1 text and 100 Hz ONSPEED_BIN frames
+// read the same. AOA and LateralG are used as-received — the main
+// firmware already smooths them at the sensor layer (iAoaSmoothing,
+// AccelLatFilter), so the display matches what the audio tones react to.
+static onspeed::filters::DecelRateFilter decelFilter;
 
 extern M5Canvas gdraw;
+extern GaugeFrame gaugeFrame;
 
 #if defined(ESP_PLATFORM)
 static const uint16_t WIDTH  = 320;
@@ -86,6 +85,8 @@ bool serialDataFresh()
 // thing this function depends on, and that's pinned by
 // kDisplayFrameSizeBytes — adding fields to the wire only requires
 // updating proto/DisplaySerial.{h,cpp}; this function is unchanged.
+// The accumulator takes ASCII #1 and binary (ONSPEED_BIN) frames alike,
+// so the display follows whichever format the OnSpeed box is set to.
 // -----------------------------------------------
 
 static onspeed::proto::DisplayFrameAccumulator g_frameAccum;
@@ -113,18 +114,18 @@ void InjectSerialByte(char inChar)
         // iasIsValid false→true (taxi → takeoff roll, IAS rising through
         // the Gen3's bIasAlive deadband): while invalid the wire encodes
         // iasKt = 9999 (the sentinel), which this parser surfaces as
-        // IAS = 999.9.  The local SavGol window therefore accumulates ~15
-        // frames of 999.9 during ground roll.  At the transition the wire
-        // shifts to a real ~20 kt value and Compute() sees a step from
+        // IAS = 999.9.  The local SavGol window therefore accumulates 15
+        // samples of 999.9 during ground roll.  At the transition the wire
+        // shifts to a real ~20 kt value and the filter sees a step from
         // ~999.9 down to ~20, producing a massive negative DecelRate spike
         // for ~750 ms while the window flushes.  Reset the filter and zero
-        // the EMA at the edge so the first 15 post-transition frames read
+        // the EMA at the edge so the first 15 post-transition samples read
         // 0 (filling) instead of garbage.  Closes #483.  Companion to the
         // firmware-side reset on the Gen3 (PR #482) and the gap-triggered
         // reset below (finding 036).
         if (IasIsValid && !bWasIasValid)
         {
-            iasDerivative.reset();
+            decelFilter.Reset();
             DecelRate         = 0.0f;
             SmoothedDecelRate = 0.0f;
         }
@@ -169,13 +170,13 @@ void InjectSerialByte(char inChar)
     // Finding 036: on a long serial gap (OnSpeed box reboot, cable reconnect),
     // the SavGol window still holds 15 stale pre-gap IAS samples. Against a
     // single fresh sample those produce a huge bogus derivative for the first
-    // ~15 post-gap frames. Reset the filter (and drain the EMAs) whenever we
+    // 15 post-gap samples. Reset the filter (and drain the EMAs) whenever we
     // see > 500 ms between frames. This must run BEFORE the dt clamp below,
     // since a genuine outage produces dt >> 0.2 s and the clamp would
     // otherwise hide it.
     if (lastFrameMicros != 0 && frameDtSec > 0.5f)
     {
-        iasDerivative.reset();
+        decelFilter.Reset();
         DecelRate         = 0.0f;
         SmoothedDecelRate = 0.0f;
     }
@@ -183,16 +184,17 @@ void InjectSerialByte(char inChar)
     lastFrameMicros = nowMicros;
 
     // Soft warning if frame cadence drifts outside expected band — real
-    // firmware targets 50 ms; bench replay tools may be slightly off.
-    if (frameDtSec < 0.020f || frameDtSec > 0.200f)
+    // firmware targets 50 ms (ASCII #1) or 10 ms (ONSPEED_BIN); bench
+    // replay tools may be slightly off.
+    if (frameDtSec < 0.005f || frameDtSec > 0.200f)
         Serial.printf("WARN: unexpected frame dt=%.3fs\n", frameDtSec);
 
     // Finding 035: clamp to a sane band before dividing the SavGol derivative
-    // by it. Lower bound is half the nominal 20 ms frame period — well below
-    // the protocol rate but far enough from zero to avoid div-by-tiny-number
+    // by it. Lower bound is half the 10 ms binary frame period — below
+    // either protocol rate but far enough from zero to avoid div-by-tiny-number
     // explosion when two frames arrive back-to-back (replay bursts, post-stall
     // buffer drain). Upper bound matches the warn band.
-    frameDtSec = constrain(frameDtSec, 0.010f, 0.200f);
+    frameDtSec = constrain(frameDtSec, 0.005f, 0.200f);
 
     SerialProcess(frameDtSec);
 
@@ -332,13 +334,11 @@ void SerialProcess(float frameDtSec)
     Slip               = int(-LateralG * 34 / 0.04);
     Slip               = constrain(Slip,-99,99);
 
-    // Compute IAS derivative (deceleration) in knots/sec.
-    // SavGolDerivative returns d(IAS)/d(sample); dividing by the measured
-    // frame period converts per-sample to per-second. Sign is already
-    // correct (positive for increasing IAS, negative for deceleration).
-    iasDerivativeInput =  IAS;
-    DecelRate          =  iasDerivative.Compute() / frameDtSec;
-    SmoothedDecelRate  =  DecelRate * decelSmoothingAlpha + SmoothedDecelRate * (1-decelSmoothingAlpha);
+    // IAS derivative (deceleration) in knots/sec, positive for increasing
+    // IAS. Frames the filter skips to hold 20 Hz leave both values as-is.
+    decelFilter.Update(IAS, frameDtSec);
+    DecelRate          =  decelFilter.Rate();
+    SmoothedDecelRate  =  decelFilter.Smoothed();
 } // end SerialProcess()
 
 
@@ -399,16 +399,14 @@ static unsigned int checkSerialUart()
 
 unsigned int checkSerial()
 {
-    gdraw.setColorDepth(8);
-    gdraw.createSprite(WIDTH, HEIGHT);
+    gaugeFrame.begin(8, WIDTH, HEIGHT);
     gdraw.fillSprite (TFT_BLACK);
     gdraw.setFont(FSS12);
     gdraw.setTextDatum(MC_DATUM);
     gdraw.setTextColor (TFT_WHITE);
     gdraw.drawString("Looking for Serial data",160,120);
     gdraw.drawString("Please wait...",160,190);
-    gdraw.pushSprite (0, 0);
-    gdraw.deleteSprite();
+    gaugeFrame.present(M5.Display);
 
     unsigned int r = checkSerialUsb();
     return r ? r : checkSerialUart();
@@ -476,16 +474,14 @@ void serialSetup()
                 // no UI; the splash is normally rendered by the
                 // checkSerial() wrapper, so render it inline here to
                 // give the UART-only path the same boot UI as AUTO.
-                gdraw.setColorDepth(8);
-                gdraw.createSprite(WIDTH, HEIGHT);
+                gaugeFrame.begin(8, WIDTH, HEIGHT);
                 gdraw.fillSprite (TFT_BLACK);
                 gdraw.setFont(FSS12);
                 gdraw.setTextDatum(MC_DATUM);
                 gdraw.setTextColor (TFT_WHITE);
                 gdraw.drawString("Looking for Serial data",160,120);
                 gdraw.drawString("Please wait...",160,190);
-                gdraw.pushSprite (0, 0);
-                gdraw.deleteSprite();
+                gaugeFrame.present(M5.Display);
                 selectedPort=checkSerialUart();
             } else {
                 selectedPort=checkSerial();
@@ -535,8 +531,7 @@ void serialSetup()
             break;
             }
         case 0: {
-            gdraw.setColorDepth(8);
-            gdraw.createSprite(WIDTH, HEIGHT);
+            gaugeFrame.begin(8, WIDTH, HEIGHT);
             gdraw.fillSprite (TFT_BLACK);
             gdraw.setFont(FSS12);
             gdraw.setTextDatum(MC_DATUM);
@@ -544,8 +539,7 @@ void serialSetup()
             gdraw.drawString("No Serial Stream Detected",160,120);
             gdraw.setTextColor (TFT_WHITE);
             gdraw.drawString("Is OnSpeed running?",160,160);
-            gdraw.pushSprite (0, 0);
-            gdraw.deleteSprite();
+            gaugeFrame.present(M5.Display);
             delay(3000);
             break;
             }
@@ -11,6 +11,7 @@
 // Mirror main.cpp's include pattern: GaugeWidgets pulls in <M5GFX.h>
 // (where M5Canvas / fonts come from) regardless of target.
 #include <GaugeWidgets.h>
+#include <GaugeFrame.h>
 #if defined(HUVVER)
 #include "../sim/HuvverShim.h"
 #else
@@ -33,8 +34,10 @@ using m5menu::MenuModel;
 using m5menu::MenuItem;
 using m5menu::ItemType;
 
-// Off-screen sprite shared with main.cpp. Defined in main.cpp at top scope.
-extern M5Canvas gdraw;
+// Off-screen sprite shared with main.cpp, and the presenter that keeps it
+// allocated. Both defined in main.cpp at top scope.
+extern M5Canvas   gdraw;
+extern GaugeFrame gaugeFrame;
 
 // Public global — read by main.cpp's IAS render block. Default false
 // (KTS) — pilots flip via the settings menu and the choice persists in
@@ -133,8 +136,7 @@ const char* toggleValueLabel(const MenuItem& item) {
 }
 
 void renderMenu() {
-    gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-    gdraw.createSprite(320, 240);
+    gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, 320, 240);
     gdraw.fillSprite(TFT_BLACK);
     gdraw.setTextDatum(textdatum_t::baseline_left);
 
@@ -291,8 +293,7 @@ void renderMenu() {
         x += chunkW[i] + gap;
     }
 
-    gdraw.pushSprite(0, 0);
-    gdraw.deleteSprite();
+    gaugeFrame.present(M5.Display);
 }
 
 // ---------------------------------------------------------------------------
@@ -364,8 +365,9 @@ void tickSettingsMenu() {
 
     if (g_model.wantsExit()) {
         g_active = false;
-        // Sprite was already pushed and deleted by renderMenu().
-        // Next loop() iteration will fall through to live-mode rendering.
+        // renderMenu() already pushed the last menu frame. Next loop()
+        // iteration falls through to live-mode rendering, whose first
+        // present() diffs against that frame and repaints what changed.
     }
 }
 
@@ -47,6 +47,7 @@ OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 
 #include <GaugeWidgets.h>
+#include <GaugeFrame.h>
 #if defined(HUVVER)
 #include "../sim/HuvverShim.h"
 #else
@@ -93,6 +94,7 @@ bool        fwUpdateMode = false;
 #include "RenderConfig.h"
 
 M5Canvas        gdraw(&M5.Display);
+GaugeFrame      gaugeFrame(gdraw);   // keeps gdraw allocated, pushes changed tiles only
 Gauges          myGauges;
 
 // Percent-lift anchors, populated from the wire fields each frame and
@@ -326,8 +328,7 @@ void setup()
 #endif
 #endif // !REPLAY_TARGET
 
-    gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-    gdraw.createSprite(WIDTH, HEIGHT);
+    gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, WIDTH, HEIGHT);
     gdraw.fillSprite (TFT_BLACK);
 
     // prefill gHistory buffer
@@ -352,8 +353,7 @@ void setup()
         if (M5.BtnB.isPressed())
         {
             fwUpdateMode=true;
-            gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-            gdraw.createSprite(WIDTH, HEIGHT);
+            gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, WIDTH, HEIGHT);
             gdraw.fillSprite (TFT_BLACK);
             gdraw.setFont(FSSB12);
             gdraw.setTextColor (TFT_WHITE);
@@ -374,8 +374,7 @@ void setup()
             gdraw.setTextDatum(MR_DATUM);
             gdraw.drawString("EXIT",280,215);
 
-            gdraw.pushSprite (0, 0);
-            gdraw.deleteSprite();
+            gaugeFrame.present(M5.Display);
 
             WiFi.softAP(ssid, password);
             delay(100); // wait to init softAP
@@ -415,8 +414,7 @@ void setup()
                         if (!Update.begin(UPDATE_SIZE_UNKNOWN))
                         { //start with max available size
                         }
-                        gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-                        gdraw.createSprite(WIDTH, HEIGHT);
+                        gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, WIDTH, HEIGHT);
                         gdraw.fillSprite (TFT_BLACK);
                         gdraw.setFont(FSSB12);
                         gdraw.setTextColor (TFT_WHITE);
@@ -427,8 +425,7 @@ void setup()
                         gdraw.setFont(FSS12);
                         gdraw.drawString("Please wait...",160,150);
 
-                        gdraw.pushSprite (0, 0);
-                        gdraw.deleteSprite();
+                        gaugeFrame.present(M5.Display);
                     }
 
                     else if (upload.status == UPLOAD_FILE_WRITE)
@@ -613,9 +610,9 @@ void loop()
 
     if (M5.BtnB.wasClicked())
     {
-        gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-        gdraw.createSprite(WIDTH, HEIGHT);
-        gdraw.fillSprite (TFT_BLACK);
+        // New layout: repaint the whole panel rather than diffing
+        // against the old mode's frame.
+        gaugeFrame.invalidate();
         displayType ++;
         if (displayType > 4) displayType = 0; // type of display
 
@@ -648,8 +645,10 @@ void loop()
     {
         loopTime = millis();
 
-        gdraw.setColorDepth(XPLANE_PLUGIN_DEPTH);
-        gdraw.createSprite(WIDTH, HEIGHT);
+        // The canvas persists across frames (allocated once, reallocated
+        // only after the 16-bit splash); redraw it from black and let
+        // present() push just the tiles that changed.
+        gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, WIDTH, HEIGHT);
         gdraw.fillSprite (TFT_BLACK);
         // Reset text anchoring for this frame. M5GFX's print()/setCursor()
         // honors the current datum; the old M5Stack/TFT_eSPI fork always
@@ -905,11 +904,11 @@ void loop()
             gdraw.fillRect(100,100,120,40,TFT_BLACK);
             gdraw.drawString("NO DATA",160,120);
 
-            gdraw.pushSprite (0, 0);
-            gdraw.deleteSprite();
+            gaugeFrame.present(M5.Display);
             return;
         } // end if serial data timeout
 
+        gaugeFrame.present(M5.Display);
     } // end if time to update graphics
 
     if (millis()-flashTime>=flashRate)
@@ -917,9 +916,6 @@ void loop()
         flashFlag = !flashFlag;
         flashTime=millis();
         }
-
-    gdraw.pushSprite (0, 0);
-    gdraw.deleteSprite();
 } // end loop()
 
 
@@ -2039,17 +2035,14 @@ void handleIndex()
 
 void displaySplashScreen()
 {
-    // The splash uses a 16-bit RGB565 sprite (one-shot, freed at the
-    // bottom of the function) so the anti-aliased gauge bitmap renders
-    // with full grayscale fidelity. The live display reverts to the
-    // 8-bit palette sprite via setColorDepth(XPLANE_PLUGIN_DEPTH) on
-    // its next createSprite call. The bundled logo bitmap is the gauge
+    // The splash uses a 16-bit RGB565 canvas so the anti-aliased gauge
+    // bitmap renders with full grayscale fidelity. The live display's
+    // next gaugeFrame.begin(XPLANE_PLUGIN_DEPTH, ...) reallocates the
+    // 8-bit canvas and pushes it in full. The bundled logo bitmap is the gauge
     // mark only — the "FlyOnSpeed / ANGLE OF ATTACK" wordmark is drawn
     // below it with M5GFX fonts (sharper than rasterizing the SVG
     // glyphs at this size).
-    gdraw.deleteSprite();
-    gdraw.setColorDepth(16);
-    gdraw.createSprite(WIDTH, HEIGHT);
+    gaugeFrame.begin(16, WIDTH, HEIGHT);
     gdraw.fillSprite(TFT_BLACK);
 
     constexpr int kLogoTopY = 0;
@@ -2080,8 +2073,7 @@ void displaySplashScreen()
     gdraw.drawString(versionLine.c_str(), WIDTH / 2, 205);
     gdraw.drawString("To upgrade press Center button", WIDTH / 2, 228);
     gdraw.setTextDatum(textdatum_t::baseline_left);
-    gdraw.pushSprite(0, 0);
-    gdraw.deleteSprite();
+    gaugeFrame.present(M5.Display);
 #if !defined(REPLAY_TARGET)
     M5.update();
 #endif
@@ -57,7 +57,6 @@
 #include <cstring>
 #include <cstdio>
 #include <thread>
-#include <mutex>
 #include <atomic>
 #include <optional>
 #include <memory>
@@ -99,6 +98,7 @@
 #include "m5_indexer/AutoSetpoints.h"
 #include <filters/RunningMedian.h>
 #include <util/OnSpeedTypes.h>
+#include <util/SnapshotPublisher.h>
 
 // Function declarations
 void cleanupAudio();
@@ -1398,16 +1398,53 @@ static void OnAircraftLoaded() {
     }
 }
 
-// Audio render thread.  Owns the OpenAL queue pump; reads g_Engine
-// state under g_EngineMutex once per chunk, then renders sample-
-// accurate PCM via Synthesize + Envelope + Mix.
+// Audio render thread.  Owns the OpenAL queue pump and the audio
+// engine; picks up the flight loop's latest EngineInputs once per
+// chunk, then renders sample-accurate PCM via Synthesize + Envelope +
+// Mix.
 std::optional<std::thread> audioThread;
 std::atomic<bool>          threadRunning{false};
 
-// Engine state shared between the X-Plane flight loop (writer) and
-// the audio render thread (reader).  Guarded by g_EngineMutex; the
-// crit-sec is microseconds — just an Envelope spec swap and a couple
-// of float assignments — so contention is irrelevant.
+// Per-tick engine inputs, handed from the X-Plane flight loop (single
+// writer, PlayAOATone) to the render thread through a seqlock.  The
+// render thread never waits on the flight loop: when X-Plane's main
+// thread stalls (scenery load, heavy frame) it keeps rendering from
+// the last inputs it saw, and the flight loop never waits on a chunk
+// render in progress.  Plain values only — the render thread applies
+// `tone` to its own envelope, so no engine state crosses threads.
+struct EngineInputs
+{
+    uint32_t            seq = 0;           // bumped on every publish
+    onspeed::ToneResult tone{onspeed::EnToneType::None, 0.0f, 0.0f};
+    float               volumeMult   = onspeed::STALL_VOL_MIN;
+    bool                muted        = true;   // IAS/audio-toggle gate
+    float               leftPanGain  = 1.0f;
+    float               rightPanGain = 1.0f;
+};
+onspeed::util::SnapshotPublisher<EngineInputs> g_EngineInputs;
+
+// Flight-loop side of the handoff.  Only PlayAOATone's thread calls it.
+static void PublishEngineInputs(EngineInputs in)
+{
+    static uint32_t s_seq = 0;
+    in.seq = ++s_seq;
+    g_EngineInputs.publish(in);
+}
+
+// Render-thread health, written by AudioRenderThread and reported from
+// the 1 Hz persist tick.  Relaxed atomics — these are counters, not
+// synchronization.
+struct AudioRenderStats
+{
+    std::atomic<uint32_t> chunks{0};       // buffers rendered and queued
+    std::atomic<uint32_t> starved{0};      // wakeups that found every queued buffer consumed
+    std::atomic<uint32_t> underruns{0};    // source stopped for lack of data and was restarted
+    std::atomic<uint32_t> staleInputs{0};  // chunks rendered on old inputs after a tryRead bailout
+};
+AudioRenderStats g_AudioStats;
+
+// Engine state owned by the audio render thread.  The flight loop
+// reaches it only through g_EngineInputs.
 struct AudioEngine
 {
     onspeed::audio::Envelope    envelope;
@@ -1431,24 +1468,15 @@ struct AudioEngine
     // Mirrors the firmware's s_LastEnvTone / enTone split.
     onspeed::EnToneType         activeCarrier  = onspeed::EnToneType::None;
     onspeed::EnToneType         pendingCarrier = onspeed::EnToneType::None;
-    float                       volumeMult = onspeed::STALL_VOL_MIN;
-    bool                        muted = true;              // IAS/audio-toggle gate
-
-    // Stereo pan from lateral G (slip-skid centripetal cue).  Computed
-    // each flight loop from sim/flightmodel/forces/g_side via
-    // onspeed::audio::Apply3DPan; consumed in the render thread as the
-    // L/R scale into AudioMixer.  Headphone-stereo only, never OpenAL
-    // 3D positioning — the firmware uses the same approach.
-    float                       leftPanGain  = 1.0f;
-    float                       rightPanGain = 1.0f;
+
+    // Inputs the current chunk renders with; `inputs.seq` is the last
+    // publish applied to the envelope.
+    EngineInputs                inputs;
 };
-AudioEngine g_Engine;
-std::mutex  g_EngineMutex;
 
-// Persistent state for the panning IIR.  Lives outside g_Engine because
-// it's only touched from the X-Plane flight-loop thread (writer) and
-// never read from the audio thread — the smoothed result is pushed
-// into g_Engine.{leftPanGain,rightPanGain} under the mutex.
+// Persistent state for the panning IIR.  Only touched from the X-Plane
+// flight-loop thread; the smoothed result is published to the render
+// thread in EngineInputs.{leftPanGain,rightPanGain}.
 onspeed::audio::PanState  g_PanState;
 const onspeed::audio::PanConfig g_PanCfg;   // defaults match firmware
 
@@ -2070,6 +2098,92 @@ static onspeed::ToneThresholds buildThresholds() {
     return { fLDMAXAOA, fONSPEEDFASTAOA, fONSPEEDSLOWAOA, fSTALLWARNAOA };
 }
 
+// Pick up the flight loop's newest inputs and apply a fresh publish to
+// the envelope.  DecideAndArm is idempotent for an unchanged tone
+// (Envelope::NoteOn debounces a same-spec re-arm), so only the latest
+// of several publishes between two chunks matters.  A tryRead bailout
+// keeps the previous chunk's inputs rather than spinning on a deadline.
+static void ApplyEngineInputs(AudioEngine& engine)
+{
+    EngineInputs in;
+    if (!g_EngineInputs.tryRead(in)) {
+        g_AudioStats.staleInputs.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (in.seq == engine.inputs.seq) return;
+    engine.inputs = in;
+
+    // Queue the new carrier without disturbing what's currently
+    // synthesizing; RenderChunk promotes pendingCarrier →
+    // activeCarrier once the envelope is silent, so a Low → High
+    // switch can never bleed onto the prior tone's release ramp.
+    if (in.tone.enTone != onspeed::EnToneType::None) {
+        engine.pendingCarrier = in.tone.enTone;
+    }
+    // DecideAndArm dispatches NoteOn/NoteOff (None → NoteOff, which
+    // also covers every mute path) and applies the shortened
+    // first-pulse delay on solid->pulsed transitions.
+    onspeed::audio::DecideAndArm(in.tone, engine.envelope, g_OrchCfg);
+}
+
+// Synthesize the carrier (phase-continuous across chunks so the cosine
+// never has a discontinuity) and mix it through the envelope.  Pan +
+// master volume compose into the per-channel scales: gain × pan, capped
+// at 1.0 by Apply3DPan's max-gain normalization so the mixer never has
+// to hard-clip.
+static void RenderChunk(AudioEngine& engine, int16_t* mono, int16_t* stereo)
+{
+    // Promote a pending carrier change only when the envelope is
+    // currently silent (level == 0).  That covers every transition
+    // window the spec relies on:
+    //
+    //   Idle    — no tone playing
+    //   Delay   — silent first half of every fresh pulse, AND the
+    //             silent first delay after a solid->pulsed re-arm (the
+    //             moment the prior Release tail finishes and the
+    //             queued spec fires)
+    //   Release — only the very last sample
+    //
+    // Switching carriers under any of these is inaudible — the cosine
+    // times zero is zero either way.  Resetting carrierPhase here means
+    // the new frequency starts from a known sample, so the
+    // discontinuity (different freq at the same time t) sits inside
+    // silence and never leaks into the audible attack ramp.
+    //
+    // IsIdle() alone is too strict for the solid->pulsed case:
+    // Envelope::Tick fires the queued NoteOn the same sample it reaches
+    // Idle, so the render thread never observes the Idle phase between
+    // Release and the new spec's Delay.  Checking Level == 0 catches
+    // both the Idle moment AND the Delay phase that immediately
+    // follows.
+    if (engine.envelope.Level() == 0.0f &&
+        engine.activeCarrier != engine.pendingCarrier) {
+        engine.activeCarrier = engine.pendingCarrier;
+        engine.carrierPhase  = 0.0f;
+    }
+
+    const float carrierHz =
+        (engine.activeCarrier == onspeed::EnToneType::High)
+          ? static_cast<float>(onspeed::HIGH_TONE_HZ)
+          : static_cast<float>(onspeed::LOW_TONE_HZ);
+
+    engine.carrierPhase = onspeed::audio::Synthesize(
+        carrierHz,
+        onspeed::audio::kLegacyToneAmplitude,
+        kAudioSampleRateHz,
+        mono, kFramesPerChunk,
+        engine.carrierPhase);
+
+    const EngineInputs& in = engine.inputs;
+    const float gain = in.muted ? 0.0f : in.volumeMult;
+    onspeed::audio::MixerInputs mix;
+    mix.in         = mono;
+    mix.leftScale  = gain * in.leftPanGain;
+    mix.rightScale = gain * in.rightPanGain;
+    mix.envelope   = &engine.envelope;
+    onspeed::audio::Mix(mix, stereo, kFramesPerChunk, engine.mixerState);
+}
+
 // Audio render thread: pumps OpenAL's queued-buffer pipeline.  Each
 // iteration unqueues any consumed buffer, fills it with the next
 // chunk of synth+envelope+mix output, and re-queues it.  The
@@ -2079,6 +2193,7 @@ static onspeed::ToneThresholds buildThresholds() {
 void AudioRenderThread() {
     int16_t mono[kFramesPerChunk];
     int16_t stereo[kFramesPerChunk * 2];
+    AudioEngine engine;
 
     while (threadRunning) {
         ALint processed = 0;
@@ -2091,76 +2206,23 @@ void AudioRenderThread() {
             continue;
         }
 
+        // Every queued buffer already played out: the source is at (or
+        // past) the edge of an audible gap.
+        if (processed >= kStreamBufferCount) {
+            g_AudioStats.starved.fetch_add(1, std::memory_order_relaxed);
+        }
+
         while (processed-- > 0 && threadRunning) {
             ALuint buf = 0;
             alSourceUnqueueBuffers(audioSource, 1, &buf);
 
-            // Synthesize the carrier (phase-continuous across chunks
-            // so the cosine never has a discontinuity) and mix through
-            // the envelope under the mutex.  Pan + master volume
-            // compose into the per-channel scales: gain × pan, capped
-            // at 1.0 by Apply3DPan's max-gain normalization so the
-            // mixer never has to hard-clip.
-            {
-                std::lock_guard<std::mutex> lock(g_EngineMutex);
-
-                // Promote a pending carrier change only when the
-                // envelope is currently silent (level == 0).  That
-                // covers every transition window the spec relies on:
-                //
-                //   Idle    — no tone playing
-                //   Delay   — silent first half of every fresh pulse,
-                //             AND the silent first delay after a
-                //             solid->pulsed re-arm (the moment the
-                //             prior Release tail finishes and the
-                //             queued spec fires)
-                //   Release — only the very last sample
-                //
-                // Switching carriers under any of these is inaudible —
-                // the cosine times zero is zero either way.  Resetting
-                // carrierPhase here means the new frequency starts from
-                // a known sample, so the discontinuity (different freq
-                // at the same time t) sits inside silence and never
-                // leaks into the audible attack ramp.
-                //
-                // IsIdle() alone is too strict for the solid->pulsed
-                // case: Envelope::Tick fires the queued NoteOn the
-                // same sample it reaches Idle, so the render thread
-                // never observes the Idle phase between Release and
-                // the new spec's Delay.  Checking Level == 0 catches
-                // both the Idle moment AND the Delay phase that
-                // immediately follows.
-                if (g_Engine.envelope.Level() == 0.0f &&
-                    g_Engine.activeCarrier != g_Engine.pendingCarrier) {
-                    g_Engine.activeCarrier = g_Engine.pendingCarrier;
-                    g_Engine.carrierPhase  = 0.0f;
-                }
-
-                const float carrierHz =
-                    (g_Engine.activeCarrier == onspeed::EnToneType::High)
-                      ? static_cast<float>(onspeed::HIGH_TONE_HZ)
-                      : static_cast<float>(onspeed::LOW_TONE_HZ);
-
-                g_Engine.carrierPhase = onspeed::audio::Synthesize(
-                    carrierHz,
-                    onspeed::audio::kLegacyToneAmplitude,
-                    kAudioSampleRateHz,
-                    mono, kFramesPerChunk,
-                    g_Engine.carrierPhase);
-
-                const float gain = g_Engine.muted ? 0.0f : g_Engine.volumeMult;
-                onspeed::audio::MixerInputs in;
-                in.in         = mono;
-                in.leftScale  = gain * g_Engine.leftPanGain;
-                in.rightScale = gain * g_Engine.rightPanGain;
-                in.envelope   = &g_Engine.envelope;
-                onspeed::audio::Mix(in, stereo, kFramesPerChunk,
-                                    g_Engine.mixerState);
-            }
+            ApplyEngineInputs(engine);
+            RenderChunk(engine, mono, stereo);
 
             alBufferData(buf, AL_FORMAT_STEREO16, stereo, sizeof(stereo),
                          kAudioSampleRateHz);
             alSourceQueueBuffers(audioSource, 1, &buf);
+            g_AudioStats.chunks.fetch_add(1, std::memory_order_relaxed);
         }
 
         // If the source under-ran (processed == queued), kick it back
@@ -2169,11 +2231,36 @@ void AudioRenderThread() {
         ALint state = 0;
         alGetSourcei(audioSource, AL_SOURCE_STATE, &state);
         if (state != AL_PLAYING) {
+            g_AudioStats.underruns.fetch_add(1, std::memory_order_relaxed);
             alSourcePlay(audioSource);
         }
     }
 }
 
+// Log render-thread trouble since the last call.  Runs on the 1 Hz
+// persist tick, so a bad stretch costs at most one line per second.
+static void ReportAudioRenderStats()
+{
+    static uint32_t s_starved = 0, s_underruns = 0, s_stale = 0;
+    const uint32_t starved   = g_AudioStats.starved.load(std::memory_order_relaxed);
+    const uint32_t underruns = g_AudioStats.underruns.load(std::memory_order_relaxed);
+    const uint32_t stale     = g_AudioStats.staleInputs.load(std::memory_order_relaxed);
+    if (starved == s_starved && underruns == s_underruns && stale == s_stale) return;
+
+    char msg[160];
+    snprintf(msg, sizeof(msg),
+             "FlyOnSpeed: audio render: %u underrun(s), %u starved wakeup(s), "
+             "%u stale-input chunk(s) in the last interval (%u chunks total)\n",
+             static_cast<unsigned>(underruns - s_underruns),
+             static_cast<unsigned>(starved - s_starved),
+             static_cast<unsigned>(stale - s_stale),
+             static_cast<unsigned>(g_AudioStats.chunks.load(std::memory_order_relaxed)));
+    XPLMDebugString(msg);
+    s_starved   = starved;
+    s_underruns = underruns;
+    s_stale     = stale;
+}
+
 // Hysteretic IAS gate state.  Mirrors the firmware:
 // unmute at iMuteAudioUnderIAS + kIasMuteHysteresisKt, re-mute
 // back at iMuteAudioUnderIAS.  iMuteAudioUnderIAS == 0 disables
@@ -2181,10 +2268,10 @@ void AudioRenderThread() {
 static bool s_iasGateOpen = false;
 
 // Per-flight-loop AOA decision: smooth the raw AOA, run it through
-// onspeed_core's ToneCalc, and update the engine's envelope and
-// volume to match.  All audio shaping (per-pulse DAHD, click-free
+// onspeed_core's ToneCalc, and publish the result, volume and pan to
+// the render thread.  All audio shaping (per-pulse DAHD, click-free
 // transitions, solid->pulsed shortened-delay) lives in the envelope
-// — this function just hands it the next spec.
+// — this function just hands it the next decision.
 void PlayAOATone(float fAoa, float /* fElapsedTime */) {
     // Plugin-only AOA smoothing; see iAoaMedianWindow / iAoaMeanWindow.
     aoaMedian->add(fAoa);
@@ -2211,10 +2298,8 @@ void PlayAOATone(float fAoa, float /* fElapsedTime */) {
     const bool simCrashed = crashedDataRef
                              && XPLMGetDatai(crashedDataRef) != 0;
     if (simPaused || simCrashed) {
-        std::lock_guard<std::mutex> lock(g_EngineMutex);
-        g_Engine.envelope.NoteOff();
-        g_Engine.muted = true;
-        s_iasGateOpen  = false;
+        PublishEngineInputs(EngineInputs{});
+        s_iasGateOpen = false;
         setStatusOrIfSticky(simCrashed ? "Audio: Crashed"
                                        : "Audio: Paused (sim)");
         return;
@@ -2223,10 +2308,8 @@ void PlayAOATone(float fAoa, float /* fElapsedTime */) {
     // Master toggle: drains the envelope's release ramp cleanly via
     // NoteOff (never a hard stop on a running waveform).
     if (!audioEnabled) {
-        std::lock_guard<std::mutex> lock(g_EngineMutex);
-        g_Engine.envelope.NoteOff();
-        g_Engine.muted = true;
-        s_iasGateOpen  = false;
+        PublishEngineInputs(EngineInputs{});
+        s_iasGateOpen = false;
         setStatusOrIfSticky("");
         return;
     }
@@ -2243,11 +2326,7 @@ void PlayAOATone(float fAoa, float /* fElapsedTime */) {
         }
     }
     if (!s_iasGateOpen) {
-        {
-            std::lock_guard<std::mutex> lock(g_EngineMutex);
-            g_Engine.envelope.NoteOff();
-            g_Engine.muted = true;
-        }
+        PublishEngineInputs(EngineInputs{});
         char gateMsg[64];
         snprintf(gateMsg, sizeof(gateMsg),
                  "Audio: None - below %d kt", iMuteAudioUnderIAS);
@@ -2277,24 +2356,15 @@ void PlayAOATone(float fAoa, float /* fElapsedTime */) {
     const float fMasterScale  = iMasterVolumePct / 100.0f;
     const float fScaledVolMult = result.fVolumeMult * fMasterScale;
 
-    {
-        std::lock_guard<std::mutex> lock(g_EngineMutex);
-        g_Engine.muted        = false;
-        g_Engine.volumeMult   = fScaledVolMult;
-        g_Engine.leftPanGain  = pan.leftGain;
-        g_Engine.rightPanGain = pan.rightGain;
-        // Queue the new carrier without disturbing what's currently
-        // synthesizing.  The render thread promotes pendingCarrier
-        // → activeCarrier when the envelope reaches Idle, so a
-        // Low → High switch can never bleed onto the prior tone's
-        // release ramp.
-        if (result.enTone != onspeed::EnToneType::None) {
-            g_Engine.pendingCarrier = result.enTone;
-        }
-        // DecideAndArm dispatches NoteOn/NoteOff and applies the
-        // shortened first-pulse delay on solid->pulsed transitions.
-        onspeed::audio::DecideAndArm(result, g_Engine.envelope, g_OrchCfg);
-    }
+    // Hand the decision to the render thread, which arms its envelope
+    // and queues the carrier change at the next chunk boundary.
+    EngineInputs in;
+    in.tone         = result;
+    in.muted        = false;
+    in.volumeMult   = fScaledVolMult;
+    in.leftPanGain  = pan.leftGain;
+    in.rightPanGain = pan.rightGain;
+    PublishEngineInputs(in);
 
     char audioStatusText[80];
     if (result.enTone == onspeed::EnToneType::None) {
@@ -2488,7 +2558,10 @@ static float SavePersistedStatePeriodic(
     }
 #endif
 
-    // 3) Audio control window dirty-poll.  SaveSettings handles its
+    // 3) Audio render-thread underrun report.
+    ReportAudioRenderStats();
+
+    // 4) Audio control window dirty-poll.  SaveSettings handles its
     //    own load-gate and writes the whole .prf in one fwrite, so
     //    we don't need to coordinate with the indexer save above.
     if (s_settingsLoaded) {
@@ -34,6 +34,7 @@
 
 // M5GFX
 #include <M5Unified.h>
+#include <GaugeFrame.h>
 
 // onspeed_core — wire-frame builder.
 #include <proto/DisplaySerial.h>
@@ -72,6 +73,7 @@ extern const char* const kModeNames[5]; // canonical page names (mirrors
 // before the first loop() call.  We replicate the minimal subset of
 // setup() that's safe in the X-Plane plugin context.
 extern M5Canvas gdraw;
+extern GaugeFrame gaugeFrame;
 extern float gHistory[300];
 extern int   gHistoryIndex;
 
@@ -117,6 +119,11 @@ serial::SerialPort            s_serialOut;
 std::string                   s_serialOutPath;
 std::uint64_t                 s_serialErrCount = 0;
 
+// Binary display-frame encoder, used when FLYONSPEED_INDEXER_BINARY is
+// set.  It diffs against the previous frame, so a (re)opened port gets
+// a keyframe next.
+onspeed::proto::DisplayBinaryEncoder s_binEncoder;
+
 
 // X-Plane window dimensions.  Native M5 panel is 320×240 — render
 // 1:1 by default; could pixel-double in a follow-up.
@@ -470,9 +477,8 @@ bool InstallPanelAndRunSetup()
     // and pokes ESP-only peripherals (dacWrite, button polling).  All
     // we need for the renderer to produce a frame is gdraw sprite +
     // gHistory ring buffer + displayType seed.
-    gdraw.setColorDepth(16);
-    gdraw.createSprite(Panel_PluginCanvas::kWidth,
-                       Panel_PluginCanvas::kHeight);
+    gaugeFrame.begin(16, Panel_PluginCanvas::kWidth,
+                     Panel_PluginCanvas::kHeight);
     gdraw.fillSprite(0x0000);
     for (int i = 0; i < 300; ++i) gHistory[i] = 1.0f;
     gHistoryIndex = 0;
@@ -575,11 +581,19 @@ void Tick()
     if (!s_initOk) return;
     if (!s_visible && !s_serialOut.IsOpen() && s_serialOutPath.empty()) return;
 
-    // Throttle to 20 Hz to match the OnSpeed display-serial cadence.
-    // X-Plane's flight loop fires at frame rate (60–80 Hz typical),
-    // which would feed the M5 firmware's per-frame parser at 4× the
-    // wire rate it expects, tripping its dt-out-of-band warning loop.
-    static const std::uint32_t kTickPeriodMs = 50;   // 20 Hz
+    // Throttle to the OnSpeed display-serial cadence: 20 Hz for the
+    // ASCII #1 frame.  X-Plane's flight loop fires at frame rate (60–80
+    // Hz typical), which would feed the M5 firmware's per-frame parser
+    // at 4× the wire rate it expects, tripping its dt-out-of-band
+    // warning loop.  FLYONSPEED_INDEXER_BINARY=1 sends the binary frame
+    // (SERIALOUTFORMAT=ONSPEED_BIN) at its 100 Hz cadence instead —
+    // in practice every flight-loop frame.  Both the embedded parser and
+    // a USB-attached M5 recognise either format; leave it off for an M5
+    // flashed before the binary format existed.
+    static const bool kBinary = EnvFlag("FLYONSPEED_INDEXER_BINARY");
+    static const std::uint32_t kTickPeriodMs = static_cast<std::uint32_t>(
+        kBinary ? onspeed::proto::kDisplayBinFramePeriodMs
+                : onspeed::proto::kDisplayFramePeriodMs);
     static std::uint32_t s_lastTickMs = 0;
     const std::uint32_t now = static_cast<std::uint32_t>(SDL_GetTicks());
     if (s_lastTickMs != 0 && (now - s_lastTickMs) < kTickPeriodMs) return;
@@ -612,9 +626,13 @@ void Tick()
         onspeed_xplane::indexer::BuildInputsFromDatarefs();
 
     if (verbose) XPLMDebugString("FlyOnSpeed: Tick B: BuildDisplayFrame\n");
+    static_assert(onspeed::proto::kDisplayBinMaxFrameBytes <=
+                      onspeed::proto::kDisplayFrameSizeBytes,
+                  "frameBytes holds either format");
     std::uint8_t frameBytes[onspeed::proto::kDisplayFrameSizeBytes] = {0};
-    const std::size_t emitted = onspeed::proto::BuildDisplayFrame(
-        in, frameBytes, sizeof(frameBytes));
+    const std::size_t emitted = kBinary
+        ? s_binEncoder.Encode(in, frameBytes, sizeof(frameBytes))
+        : onspeed::proto::BuildDisplayFrame(in, frameBytes, sizeof(frameBytes));
     if (emitted == 0) {
         if (verbose) XPLMDebugString("FlyOnSpeed: Tick: BuildDisplayFrame returned 0\n");
         return;
@@ -683,7 +701,7 @@ void Tick()
     //     close the port and let the retry loop re-establish.
     // Without distinguishing these, every transient hiccup throws the
     // M5 into a 2-second blackout.  Use consecutive-failure counting:
-    // single failure drops the frame, three in a row (150 ms) closes
+    // single failure drops the frame, three in a row (150 ms at 20 Hz) closes
     // the port.  A truly disconnected device fails every frame so this
     // converges to "close" within 150 ms; transient buffer pressure
     // recovers on the next frame without loss of connection.
@@ -718,6 +736,7 @@ void Tick()
                 XPLMDebugString(("FlyOnSpeed: serial reopen OK on "
                                 + s_serialOutPath + "\n").c_str());
                 s_serialErrCount = 0;
+                s_binEncoder.ForceKeyframe();
             }
             // Open failure: silent, will retry in 2s.
         }
@@ -1034,6 +1053,7 @@ bool OpenSerialOut(const std::string& portPath)
     }
     XPLMDebugString(("FlyOnSpeed: serial open OK on " + portPath
                     + "\n").c_str());
+    s_binEncoder.ForceKeyframe();
     return true;
 }
 
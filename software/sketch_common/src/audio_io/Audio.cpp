@@ -13,19 +13,29 @@
     Be sure to add "const" to the array holding the PCM data in the header file.
         const unsigned char overg_pcm[] ....
 
+    The PCM_*.h files are masters only; the firmware plays Audio/VoiceAssets.h,
+    which scripts/normalize_voice_pcm.py --encode generates from them (IMA
+    ADPCM with silent ends trimmed, ~4:1).  It runs as a PIO pre-build step,
+    so adding a new PCM_*.h master and a PlayVoice() case is all a new prompt
+    needs.
+
     ------------------------------------------------------------------------
 
     PR 3.3 split:
 
       Pure PCM math now lives in onspeed_core/audio/:
         - ToneSynth   : cosine synthesis + pulse gate
+        - Oscillator  : fixed-point phase-accumulator carrier (tones)
         - WavDecode   : PCM byte array / WAV header → PcmAsset view
+        - VoiceCodec  : ADPCM voice prompt → PCM, one chunk at a time
         - AudioMixer  : mono PCM → stereo int16 with gain/pan/pulse
+        - TonePipeline: tone chunks rendered ahead of DMA, cancellable
 
       This file is now a thin I2S driver / task wrapper that feeds the
       core modules.  Buffer arithmetic, clamping, pan, and pulse shaping
       are validated by native unit tests (test_tone_synth,
-      test_wav_decode, test_audio_mixer) — on-device we only have to
+      test_wav_decode, test_voice_codec, test_oscillator,
+      test_audio_mixer, test_tone_pipeline) — on-device we only have to
       trust the i2s.write pump.
 
  */
@@ -38,6 +48,7 @@
 
 #include <Arduino.h>
 #include <ESP_I2S.h>
+#include <esp_timer.h>
 
 #include "src/Globals.h"
 #include "src/util/Helpers.h"
@@ -47,21 +58,13 @@
 #include <audio/AudioOrchestrator.h>
 #include <audio/AudioTestSweep.h>
 #include <audio/Envelope.h>
+#include <audio/Oscillator.h>
 #include <audio/ToneCalc.h>
+#include <audio/TonePipeline.h>
 #include <audio/ToneSynth.h>
-#include <audio/WavDecode.h>
+#include <audio/VoiceCodec.h>
 
-#include "Audio/PCM_cal_canceled.h"
-#include "Audio/PCM_cal_mode.h"
-#include "Audio/PCM_cal_saved.h"
-#include "Audio/PCM_datamark.h"
-#include "Audio/PCM_disabled.h"
-#include "Audio/PCM_enabled.h"
-#include "Audio/PCM_glimit.h"
-#include "Audio/PCM_overg.h"
-#include "Audio/PCM_VnoChime.h"
-#include "Audio/PCM_left_speaker.h"
-#include "Audio/PCM_right_speaker.h"
+#include "Audio/VoiceAssets.h"
 
 
 //i2s_data_bit_width_t  bps  = I2S_DATA_BIT_WIDTH_32BIT;  //
@@ -73,34 +76,55 @@ i2s_mode_t            mode = I2S_MODE_STD;  // Works
 i2s_slot_mode_t       slot = I2S_SLOT_MODE_STEREO;    // Works better
 //i2s_slot_mode_t       slot = I2S_SLOT_MODE_MONO;    // Works
 
-static int16_t     aTone_400Hz[TONE_BUFFER_LEN];
-static int16_t     aTone_1600Hz[TONE_BUFFER_LEN];
-
-// Tone source phase index — advanced modulo TONE_BUFFER_LEN as we pump
-// frames out.  Keeping this monotonic across pump calls preserves the
-// continuous-sine carrier behaviour of Gen2 (sinewave1 was free-running;
-// only its amplitude was modulated by the envelope).
-static size_t s_ToneSrcIdx = 0;
-
-// Mixer state retained for the legacy pulse-gate path.  Tones now use the
-// DAHDR envelope below as their primary gate; pulseSpec is left zero.
-static onspeed::audio::MixerState s_ToneMixerState;
-
-// DAHDR envelope owned by AudioPlay's tone path.  All amplitude shaping
-// (per-pulse onset, release on stop, smooth re-trigger on tone/PPS change)
-// flows through this single state machine — the Gen2 perceptual model.
-static onspeed::audio::Envelope   s_ToneEnvelope;
+// Tone chunks rendered ahead of the DMA ring.  The pipeline's head state
+// holds the tone carrier (free-running across chunks and low/high
+// switches, as Gen2's sinewave1 was), the DAHDR envelope that does all
+// amplitude shaping (per-pulse onset, release on stop, smooth re-trigger
+// on tone/PPS change), and the mixer state.  Only AudioPlayTask touches
+// it; SetTone() posts commands through s_xToneCmdQueue.
+static constexpr size_t kToneLookaheadChunks = 3;
+static onspeed::audio::TonePipeline s_TonePipe(kToneLookaheadChunks);
+static_assert(TONE_PUMP_FRAMES == onspeed::audio::kToneChunkFrames,
+              "Tone pump chunk must match the pipeline chunk");
+
+// Tone chunks allowed in the I2S DMA ring at once.  Audio handed to DMA
+// can't be cancelled, so this — not the driver's descriptor count — is
+// the floor on SetTone()→DAC latency: 2 × 15 ms.  The audio task runs at
+// the top priority on its core, so one chunk of slack is plenty.
+static constexpr int kToneDmaChunks = 2;
+
+// Tone chunks submitted to I2S and not yet sent, decremented by the
+// channel's on_sent ISR.  s_bDmaSentCbOk is false if the callback couldn't
+// be registered; tones then fall back to blocking writes into the full
+// driver ring, as before.
+static std::atomic<int> s_iDmaChunksInFlight{0};
+static bool             s_bDmaSentCbOk = false;
+
+static constexpr uint32_t kToneChunkUs = 1000000u * TONE_PUMP_FRAMES / SAMPLE_RATE;
+
+// Glide length for SetToneFreq() pitch changes: one pump chunk.  Low/high
+// tone switches stay a step change, as in Gen2.
+static constexpr uint32_t kToneGlideSamples = TONE_PUMP_FRAMES;
+
+// Tone command from SetTone() to AudioPlayTask.  A single-slot mailbox:
+// only the newest state matters, except that an urgent change (see
+// ToneChangeNeedsRerender) stays urgent until the audio task takes it.
+struct ToneCommand
+{
+    onspeed::ToneResult tone;
+    EnAudioTone         enTone;
+    uint64_t            uStampUs;   // when the urgent change was posted
+    bool                bUrgent;
+};
+static QueueHandle_t       s_xToneCmdQueue = nullptr;
+static onspeed::ToneResult s_LastPostedTone{onspeed::EnToneType::None, 0.0f, 0.0f};
 
 // Carrier identity of the currently-armed (or releasing) tone.  Sketch-
 // side state because the envelope core knows nothing about Low vs High
-// 16 kHz cosine tables.  Two consumers:
-//   1. PlayTone() during Release: keep feeding the released tone's
-//      source PCM so the envelope tail decays on the correct carrier.
-//   2. SetTone() solid→pulsed transition: lets us notice when the
-//      previous *carrier* was the high tone (Gen2's high→solid
-//      shortened-delay trick, Tones.ino:63).
-// Spec-shape debouncing and solid/pulsed detection live in the
-// Envelope class itself — this is the only sketch-side state needed.
+// carrier frequencies.  PlayTone() keeps rendering the released tone's
+// carrier during Release so the envelope tail decays on the correct
+// pitch.  Spec-shape debouncing and solid/pulsed detection live in the
+// Envelope class itself.  Audio task only.
 static EnAudioTone s_LastEnvTone = enToneNone;
 
 // I2S pins are defined in HardwareMap.h as kI2sBck, kI2sDout, kI2sLrck.
@@ -158,6 +182,46 @@ static void NotifyAudioTask()
         xTaskNotifyGive(xTaskAudioPlay);
     }
 
+// I2S on_sent ISR: one DMA descriptor (= one tone chunk) went out.  Also
+// fires for the driver's auto-cleared silence, so clamp at zero.
+static bool IRAM_ATTR OnI2sSent(i2s_chan_handle_t, i2s_event_data_t *, void *)
+    {
+    int iInFlight = s_iDmaChunksInFlight.load(std::memory_order_relaxed);
+    while (iInFlight > 0 &&
+           !s_iDmaChunksInFlight.compare_exchange_weak(iInFlight, iInFlight - 1,
+                                                       std::memory_order_relaxed))
+        {
+        }
+    if (iInFlight <= 0 || xTaskAudioPlay == NULL)
+        return false;
+
+    BaseType_t bWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(xTaskAudioPlay, &bWoken);
+    return bWoken == pdTRUE;
+    }
+
+// Take the newest tone command, if any, and apply it to the pipeline
+// head.  An urgent change first drops the queued lookahead so it is
+// rendered right behind the audio already in DMA.
+static void ApplyToneCommand()
+    {
+    ToneCommand cmd;
+    if (s_xToneCmdQueue == nullptr || xQueueReceive(s_xToneCmdQueue, &cmd, 0) != pdTRUE)
+        return;
+
+    if (cmd.bUrgent)
+        s_TonePipe.Cancel();
+
+    onspeed::audio::DecideAndArm(cmd.tone, s_TonePipe.Head().envelope, kOrchestratorCfg);
+
+    // Don't touch the carrier on stop — the release tail still needs it.
+    if (cmd.enTone != enToneNone)
+        s_LastEnvTone = cmd.enTone;
+
+    if (cmd.bUrgent && onspeed::audio::IsStallWarning(cmd.tone, kOrchestratorCfg))
+        s_TonePipe.MarkNextChunk(cmd.uStampUs);
+    }
+
 static void AudioTestTask(void * pvParams)
     {
     (void)pvParams;
@@ -170,12 +234,17 @@ static void AudioTestTask(void * pvParams)
 
 /*
 FreeRTOS task to play the appropriate noise at the appropriate time.
-Each PlayTone() call writes one 15 ms (240-frame) chunk to I2S, so this
-task wakes ~67 times per second when a tone is active.  The short pump
-bounds the SetTone()→audible-attack latency at ~15 ms, which keeps Gen2's
-61 ms solid→pulsed transition timing inside one half-period at 6.2 PPS
-(80 ms half-period).  Make sure no higher-priority task takes longer
-than the pump period or audio will gap.
+Tones are pipelined: PlayTone() renders up to kToneLookaheadChunks 15 ms
+(240-frame) chunks ahead and hands them to I2S only while fewer than
+kToneDmaChunks are in the DMA ring.  The on_sent ISR wakes the task as
+each chunk goes out (~67 times per second while a tone is active), and
+SetTone() wakes it immediately on an urgent change, which cancels and
+re-renders the lookahead.  That bounds SetTone()→DAC latency at the
+~15-30 ms already in DMA, which keeps Gen2's 61 ms solid→pulsed
+transition timing inside one half-period at 6.2 PPS (80 ms half-period).
+Stall-warning onset latency is reported as the stall_onset perf scope.
+Make sure no higher-priority task takes longer than one chunk period or
+audio will gap.
 */
 
 void AudioPlayTask(void * psuParams)
@@ -191,27 +260,44 @@ void AudioPlayTask(void * psuParams)
             }
 
         // Sleep when nothing is playing AND the envelope has fully drained.
-        // The release ramp on SetTone(None) needs a few more pump calls to
-        // reach zero — keep pumping until s_ToneEnvelope is idle so the
-        // tone fades out cleanly instead of cutting off mid-cycle.
-        if (g_AudioPlay.enTone == enToneNone &&
-            g_AudioPlay.enVoice == enVoiceNone &&
-            s_ToneEnvelope.IsIdle())
+        // The release ramp on SetTone(None) needs a few more chunks to
+        // reach zero — keep pumping until the head envelope is idle and
+        // the lookahead is empty so the tone fades out cleanly instead of
+        // cutting off mid-cycle.  While a tone plays, sleep until the DMA
+        // ring has room (on_sent) or an urgent SetTone() arrives.
+        const bool bToneIdle = g_AudioPlay.enTone == enToneNone &&
+                               s_TonePipe.Head().envelope.IsIdle() &&
+                               s_TonePipe.Empty() &&
+                               (s_xToneCmdQueue == nullptr ||
+                                uxQueueMessagesWaiting(s_xToneCmdQueue) == 0);
+        if (bToneIdle && g_AudioPlay.enVoice == enVoiceNone)
             ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        else if (s_bDmaSentCbOk && g_AudioPlay.enVoice == enVoiceNone &&
+                 s_iDmaChunksInFlight.load() >= kToneDmaChunks)
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(2 * kToneChunkUs / 1000));
 
         // PERF: time only the work after any sleep / notify-wait.
         onspeed::util::perf::PerfLoop perfGuard(
             onspeed::util::perf::TaskId::Audio,
             uxTaskGetStackHighWaterMark(nullptr));
 
-        // Voice clip plays once and resets.  Blocks until done.
+        ApplyToneCommand();
+
+        // Voice clip plays once and resets.  Blocks until done.  The tone
+        // lookahead is dropped so the tone resumes, continuous, after it.
         if (g_AudioPlay.enVoice != enVoiceNone)
+            {
+            s_TonePipe.Cancel();
             g_AudioPlay.PlayVoice();
+            }
 
-        // Tone path: pump while a tone is selected OR the envelope is
-        // still releasing.  The envelope's idle state is the canonical
-        // "tone fully stopped" signal.
-        if (g_AudioPlay.enTone != enToneNone || !s_ToneEnvelope.IsIdle())
+        // Tone path: pump while a tone is selected, the envelope is
+        // still releasing, or rendered chunks are waiting for DMA.  The
+        // envelope's idle state is the canonical "tone fully stopped"
+        // signal.
+        if (g_AudioPlay.enTone != enToneNone ||
+            !s_TonePipe.Head().envelope.IsIdle() ||
+            !s_TonePipe.Empty())
             g_AudioPlay.PlayTone();
 
     } // end while forever
@@ -225,6 +311,7 @@ AudioPlay::AudioPlay()
 {
     enVoice              = enVoiceNone;
     enTone               = enToneNone;
+    uToneFreq            = 0;
     fVolume              = 0.5f;
     fLeftGain            = 1.0f;
     fRightGain           = 1.0f;
@@ -263,20 +350,28 @@ void AudioPlay::Init()
     {
         g_Log.println(MsgLog::EnAudio, MsgLog::EnError, "Failed to initialize I2S after 3 attempts!");
     }
+    else
+    {
+        // Count tone chunks out of DMA.  Callbacks can only be registered
+        // on a stopped channel, so briefly disable the one begin() started.
+        i2s_chan_handle_t     hTx  = i2s.txChan();
+        i2s_event_callbacks_t cbs  = {};
+        cbs.on_sent = OnI2sSent;
+        s_bDmaSentCbOk = hTx != nullptr &&
+                         i2s_channel_disable(hTx) == ESP_OK &&
+                         i2s_channel_register_event_callback(hTx, &cbs, nullptr) == ESP_OK;
+        if (hTx != nullptr && i2s_channel_enable(hTx) != ESP_OK)
+            s_bI2sOk = false;
+        if (!s_bDmaSentCbOk)
+            g_Log.println(MsgLog::EnAudio, MsgLog::EnWarning, "I2S on_sent callback unavailable; tones use blocking writes");
+    }
+
+    s_xToneCmdQueue = xQueueCreate(1, sizeof(ToneCommand));
 
-    // Precompute the low- and high-tone cosine carrier tables.  PlayTone()
-    // pumps these through the envelope-driven mixer; phase continuity
-    // across pump calls comes from s_ToneSrcIdx, not from the synth.
-    onspeed::audio::SynthesizeLegacyCosine(
-        onspeed::LOW_TONE_HZ, SAMPLE_RATE,
-        aTone_400Hz, TONE_BUFFER_LEN);
-    onspeed::audio::SynthesizeLegacyCosine(
-        onspeed::HIGH_TONE_HZ, SAMPLE_RATE,
-        aTone_1600Hz, TONE_BUFFER_LEN);
-
-    // Length of the data in the buffer. This may be different for tones that
-    // don't fit exactly in the allocated buffer.
-    iDataLen = TONE_BUFFER_LEN;
+    // Same carrier amplitude as the legacy precomputed cosine tables.
+    onspeed::audio::Oscillator & osc = s_TonePipe.Head().oscillator;
+    osc.SetAmplitude(onspeed::audio::kLegacyToneAmplitude);
+    osc.SetFrequency(onspeed::LOW_TONE_HZ, SAMPLE_RATE);
 }
 
 // ----------------------------------------------------------------------------
@@ -317,8 +412,12 @@ void AudioPlay::SetVoice(EnVoice enVoiceIn)
 // ----------------------------------------------------------------------------
 
 // Select a tone to play.  Single funnel for tone-state changes:
-// assembles a ToneResult and delegates to DecideAndArm, which builds
-// the envelope spec and invokes NoteOn/NoteOff on s_ToneEnvelope.
+// assembles a ToneResult and posts it to AudioPlayTask, which hands it
+// to DecideAndArm to build the envelope spec and invoke NoteOn/NoteOff
+// on the pipeline's head envelope.  Changes that must be heard now
+// (tone on/off, low/high, solid/pulsed, stall threshold) are flagged
+// urgent and wake the task to cancel and re-render its lookahead;
+// anything else just rides the next chunk.
 
 void AudioPlay::SetTone(EnAudioTone enAudioTone)
 {
@@ -344,34 +443,45 @@ void AudioPlay::SetTone(EnAudioTone enAudioTone)
                                   // amplitude is composed from
                                   // fStallVolumeMult in PlayTone().
 
-    onspeed::audio::DecideAndArm(tr, s_ToneEnvelope, kOrchestratorCfg);
+    ToneCommand cmd;
+    cmd.tone     = tr;
+    cmd.enTone   = enAudioTone;
+    cmd.uStampUs = static_cast<uint64_t>(esp_timer_get_time());
+    cmd.bUrgent  = onspeed::audio::ToneChangeNeedsRerender(s_LastPostedTone, tr, kOrchestratorCfg);
+    s_LastPostedTone = tr;
+
+    // Don't let a follow-up drift update downgrade an urgent change the
+    // audio task hasn't taken yet; keep its original stamp too.
+    ToneCommand pending;
+    if (!cmd.bUrgent && s_xToneCmdQueue != nullptr &&
+        xQueuePeek(s_xToneCmdQueue, &pending, 0) == pdTRUE && pending.bUrgent)
+    {
+        cmd.bUrgent  = true;
+        cmd.uStampUs = pending.uStampUs;
+    }
+
+    if (s_xToneCmdQueue != nullptr)
+        xQueueOverwrite(s_xToneCmdQueue, &cmd);
 
     this->enTone = enAudioTone;
 
-    if (enAudioTone != enToneNone)
-    {
-        // s_LastEnvTone tracks the active carrier so PlayTone() can
-        // keep sourcing the right cosine table while the envelope's
-        // release ramp is still draining after a future NoteOff.
-        // Don't touch it on stop — the release tail still needs it.
-        //
-        // NotifyAudioTask wakes a sleeping AudioPlayTask.  Skipped on
-        // stop because the just-issued NoteOff leaves the envelope
-        // non-idle, so AudioPlayTask's sleep guard
-        // (enTone==None && enVoice==None && IsIdle()) is false and
-        // the task is already running to pump the release tail.
-        s_LastEnvTone = enAudioTone;
+    // Wake AudioPlayTask for urgent changes (which include every start
+    // and stop).  Drift updates at the UpdateTones() rate are picked up
+    // at the next on_sent wake instead of waking the task 208 times/s.
+    if (cmd.bUrgent)
         NotifyAudioTask();
-    }
 }
 
 // ----------------------------------------------------------------------------
 
-// Maybe someday.
+// Override the carrier pitch of whichever tone is playing, in Hz; 0
+// returns to the LOW_TONE_HZ / HIGH_TONE_HZ carriers.  The oscillator
+// glides to the new pitch over kToneGlideSamples without a phase reset,
+// so this can be driven continuously (e.g. from AOA) without clicks.
 
 void AudioPlay::SetToneFreq(unsigned uToneFreqIn)
 {
-    (void)uToneFreqIn;
+    uToneFreq = uToneFreqIn;
 }
 
 // ----------------------------------------------------------------------------
@@ -400,24 +510,24 @@ void AudioPlay::SetPulseFreq(float fPulseFreq)
 
 // ----------------------------------------------------------------------------
 
-// Play converted PCM audio buffer (voice clip).  Composes pan/gain via
-// onspeed_core AudioMixer into a local stereo frame buffer, then hands
-// the packed frames to the I2S driver in 240-frame DMA chunks.
-void AudioPlay::PlayPcmBuffer(const unsigned char * pData, int iNumBytes, float fLeftVolume, float fRightVolume)
+// Play one compressed voice prompt.  The ADPCM asset is decoded one
+// 240-frame DMA chunk at a time straight into the mixer input, so a
+// prompt never costs more RAM than a chunk, whatever its length.  Pan and
+// gain are composed via onspeed_core AudioMixer as for tones.
+void AudioPlay::PlayVoiceAsset(const onspeed::audio::VoiceAsset & asset, float fLeftVolume, float fRightVolume)
 {
     if (!s_bI2sOk)
         return;
 
-    constexpr size_t kFramesPerWrite = 240; // Match default I2S DMA frame count.
+    constexpr size_t kFramesPerWrite = onspeed::audio::kVoiceBlockSamples; // Match default I2S DMA frame count.
+    int16_t          aMono[kFramesPerWrite];
     int16_t          aStereo[kFramesPerWrite * 2];  // interleaved L,R
     uint32_t         aFrames[kFramesPerWrite];
 
-    onspeed::audio::PcmAsset asset = onspeed::audio::FromRawPcm(
-        pData, static_cast<size_t>(iNumBytes), SAMPLE_RATE, 1);
-    if (asset.empty())
-        return;
+    onspeed::audio::VoiceDecoder decoder(asset);
 
     onspeed::audio::MixerInputs inp;
+    inp.in         = aMono;
     inp.leftScale  = fLeftVolume;
     inp.rightScale = fRightVolume;
     // Voice playback: no pulse gating.
@@ -425,13 +535,9 @@ void AudioPlay::PlayPcmBuffer(const unsigned char * pData, int iNumBytes, float
 
     onspeed::audio::MixerState voiceState;   // local, voice has no persistent pulse
 
-    size_t remaining = asset.sampleCount;
-    const int16_t* src = asset.samples;
-
-    while (remaining > 0)
+    size_t n;
+    while ((n = decoder.Read(aMono, kFramesPerWrite)) > 0)
     {
-        const size_t n = remaining < kFramesPerWrite ? remaining : kFramesPerWrite;
-        inp.in = src;
         onspeed::audio::Mix(inp, aStereo, n, voiceState);
 
         for (size_t j = 0; j < n; ++j)
@@ -440,59 +546,65 @@ void AudioPlay::PlayPcmBuffer(const unsigned char * pData, int iNumBytes, float
                                                         aStereo[2 * j + 1]);
         }
         i2s.write(reinterpret_cast<const uint8_t *>(aFrames), n * sizeof(aFrames[0]));
-
-        src       += n;
-        remaining -= n;
     }
 }
 
 // ----------------------------------------------------------------------------
 
-// Play one pump-sized chunk of the source PCM tone buffer through the
-// envelope-driven mixer to I2S.  Source PCM is read with a wrap-around
-// index so the cosine carrier stays phase-continuous across pump calls
-// (Gen2 model: continuous sine, envelope-shaped amplitude).
+// Render the tone pipeline ahead and hand chunks to I2S while the DMA
+// ring has room.  Chunks are rendered from the pipeline head: the
+// carrier is the mixer's oscillator source, so phase stays continuous
+// across chunks, pitch changes and cancels (Gen2 model: continuous sine,
+// envelope-shaped amplitude).
 //
-// `pData` is the precomputed cosine table; `iNumSamples` is its length
-// (TONE_BUFFER_LEN).  Per-channel gain (`fLeftVolume`, `fRightVolume`)
-// is the master*stallVol*pan composition computed by PlayTone().
-void AudioPlay::PlayToneBuffer(const int16_t * pData, int iNumSamples, float fLeftVolume, float fRightVolume)
+// `fToneHz` is the carrier pitch; a change glides over `uGlideSamples`.
+// Per-channel gain (`fLeftVolume`, `fRightVolume`) is the
+// master*stallVol*pan composition computed by PlayTone(); it applies to
+// chunks rendered from now on.
+void AudioPlay::PlayToneChunk(float fToneHz, uint32_t uGlideSamples, float fLeftVolume, float fRightVolume)
 {
     if (!s_bI2sOk)
         return;
 
-    constexpr size_t kFramesPerWrite = TONE_PUMP_FRAMES;  // 240 samples = 15 ms
-    int16_t          aSource[kFramesPerWrite];
-    int16_t          aStereo[kFramesPerWrite * 2];
-    uint32_t         aFrames[kFramesPerWrite];
-
-    const size_t srcLen = static_cast<size_t>(iNumSamples);
-
-    // Copy one pump chunk from the source table with phase-continuous
-    // wrap-around.  Cheaper than mod-indexing per sample inside the mixer
-    // and lets the mixer remain agnostic to source layout.
-    for (size_t i = 0; i < kFramesPerWrite; ++i)
+    onspeed::audio::ToneChunkParams params;
+    params.sampleRateHz = SAMPLE_RATE;
+    params.toneHz       = fToneHz;
+    params.glideSamples = uGlideSamples;
+    params.leftScale    = fLeftVolume;
+    params.rightScale   = fRightVolume;
+
+    // Stop rendering once a released envelope is idle; what's queued
+    // still drains below.
+    while (!s_TonePipe.Full() &&
+           (enTone != enToneNone || !s_TonePipe.Head().envelope.IsIdle()))
+        s_TonePipe.Render(params);
+
+    // Without the on_sent count, write one chunk and let i2s.write()
+    // block on the driver ring, as the synchronous pump did.
+    for (int iWritten = 0; !s_TonePipe.Empty(); ++iWritten)
     {
-        aSource[i] = pData[(s_ToneSrcIdx + i) % srcLen];
-    }
-    s_ToneSrcIdx = (s_ToneSrcIdx + kFramesPerWrite) % srcLen;
-
-    onspeed::audio::MixerInputs inp;
-    inp.in         = aSource;
-    inp.leftScale  = fLeftVolume;
-    inp.rightScale = fRightVolume;
-    inp.envelope   = &s_ToneEnvelope;
-    // Envelope path supersedes the legacy pulse-gate; halfPeriodSamples
-    // stays 0 so the mixer ignores it.
+        if (s_bDmaSentCbOk ? s_iDmaChunksInFlight.load() >= kToneDmaChunks
+                           : iWritten > 0)
+            break;
 
-    onspeed::audio::Mix(inp, aStereo, kFramesPerWrite, s_ToneMixerState);
+        // Stall onset: time since SetTone() plus the chunks still ahead
+        // of this one in DMA.
+        uint64_t uStampUs;
+        if (s_TonePipe.FrontMark(uStampUs))
+        {
+            const uint64_t uNowUs = static_cast<uint64_t>(esp_timer_get_time());
+            const uint64_t uQueuedUs = static_cast<uint64_t>(s_iDmaChunksInFlight.load()) * kToneChunkUs;
+            onspeed::util::perf::recordScopeEvent(onspeed::util::perf::ScopeId::StallOnset,
+                                                  uStampUs,
+                                                  static_cast<uint32_t>(uNowUs - uStampUs + uQueuedUs));
+        }
 
-    for (size_t j = 0; j < kFramesPerWrite; ++j)
-    {
-        aFrames[j] = onspeed::audio::PackStereoI16(aStereo[2 * j + 0],
-                                                    aStereo[2 * j + 1]);
+        if (s_bDmaSentCbOk)
+            s_iDmaChunksInFlight.fetch_add(1);
+        i2s.write(reinterpret_cast<const uint8_t *>(s_TonePipe.Front()),
+                  onspeed::audio::kToneChunkFrames * sizeof(uint32_t));
+        s_TonePipe.Pop();
     }
-    i2s.write(reinterpret_cast<const uint8_t *>(aFrames), sizeof(aFrames));
 }
 
 // ----------------------------------------------------------------------------
@@ -527,17 +639,17 @@ void AudioPlay::PlayVoice(EnVoice enVoiceIn)
 
     switch (enVoiceIn)
     {
-        case enVoiceDatamark  : PlayPcmBuffer(datamark_pcm,      datamark_pcm_len,      fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceDisabled  : PlayPcmBuffer(disabled_pcm,      disabled_pcm_len,      fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceEnabled   : PlayPcmBuffer(enabled_pcm,       enabled_pcm_len,       fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceGLimit    : PlayPcmBuffer(glimit_pcm,        glimit_pcm_len,        fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceCalCancel : PlayPcmBuffer(cal_canceled_pcm,  cal_canceled_pcm_len,  fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceCalMode   : PlayPcmBuffer(cal_mode_pcm,      cal_mode_pcm_len,      fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceCalSaved  : PlayPcmBuffer(cal_saved_pcm,     cal_saved_pcm_len,     fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceOverG     : PlayPcmBuffer(overg_pcm,         overg_pcm_len,         fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceVnoChime  : PlayPcmBuffer(VnoChime_pcm,      VnoChime_pcm_len,      fLeftVoiceVolume, fRightVoiceVolume); break;
-        case enVoiceLeft      : PlayPcmBuffer(left_speaker_pcm,  left_speaker_pcm_len,  fLeftVoiceVolume, fRightVoiceVolume*.25f); break;
-        case enVoiceRight     : PlayPcmBuffer(right_speaker_pcm, right_speaker_pcm_len, fLeftVoiceVolume*.25f, fRightVoiceVolume); break;
+        case enVoiceDatamark  : PlayVoiceAsset(datamark_voice,      fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceDisabled  : PlayVoiceAsset(disabled_voice,      fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceEnabled   : PlayVoiceAsset(enabled_voice,       fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceGLimit    : PlayVoiceAsset(glimit_voice,        fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceCalCancel : PlayVoiceAsset(cal_canceled_voice,  fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceCalMode   : PlayVoiceAsset(cal_mode_voice,      fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceCalSaved  : PlayVoiceAsset(cal_saved_voice,     fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceOverG     : PlayVoiceAsset(overg_voice,         fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceVnoChime  : PlayVoiceAsset(VnoChime_voice,      fLeftVoiceVolume, fRightVoiceVolume); break;
+        case enVoiceLeft      : PlayVoiceAsset(left_speaker_voice,  fLeftVoiceVolume, fRightVoiceVolume*.25f); break;
+        case enVoiceRight     : PlayVoiceAsset(right_speaker_voice, fLeftVoiceVolume*.25f, fRightVoiceVolume); break;
         default               : break;
     }
 
@@ -554,12 +666,12 @@ void AudioPlay::PlayTone()
 
 // ----------------------------------------------------------------------------
 
-// Play one pump-sized chunk of the currently-selected tone.
+// Pump the currently-selected tone through the pipeline (PlayToneChunk).
 //
 // During envelope release (after SetTone(None)), enTone has been cleared
-// but s_ToneEnvelope is still ramping down — we use s_LastEnvTone to
-// keep feeding the same source table so the release ramp lands on a
-// continuous carrier instead of a sudden source switch.
+// but the head envelope is still ramping down — we use s_LastEnvTone to
+// keep the same carrier pitch so the release ramp lands on a continuous
+// carrier instead of a sudden pitch switch.
 //
 // Per-channel scaling composes Gen2's four amplitude layers in one
 // expression, in the order (from inside out):
@@ -592,19 +704,18 @@ void AudioPlay::PlayTone(EnAudioTone enAudioTone)
     if (fL > 1.0f) fL = 1.0f;
     if (fR > 1.0f) fR = 1.0f;
 
+    float fToneHz;
     switch (effectiveTone)
     {
-        case enToneLow :
-            PlayToneBuffer(aTone_400Hz, iDataLen, fL, fR);
-            break;
-
-        case enToneHigh :
-            PlayToneBuffer(aTone_1600Hz, iDataLen, fL, fR);
-            break;
-
-        default :
-            break;
+        case enToneLow  : fToneHz = onspeed::LOW_TONE_HZ;  break;
+        case enToneHigh : fToneHz = onspeed::HIGH_TONE_HZ; break;
+        default         : return;
     }
+
+    if (uToneFreq != 0)
+        PlayToneChunk(static_cast<float>(uToneFreq), kToneGlideSamples, fL, fR);
+    else
+        PlayToneChunk(fToneHz, 0, fL, fR);
 }
 
 
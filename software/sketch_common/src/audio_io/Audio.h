@@ -8,6 +8,8 @@
 
 #include "src/drivers/SensorIO.h"
 
+namespace onspeed::audio { struct VoiceAsset; }
+
 
 enum EnVoice
     {
@@ -28,18 +30,12 @@ void AudioPlayTask(void * psuParams);
 
 //#define SAMPLE_RATE         44100
 #define SAMPLE_RATE         16000
-// Source PCM tone buffer (precomputed cosine).  Size is sample-rate / 20 so
-// the index wraps every 50 ms — phase-continuous across pump calls because
-// the buffer length is exactly 1/20 of a second of full cycles for both
-// 400 Hz and 1600 Hz (both periods divide evenly).
-#define TONE_BUFFER_LEN     SAMPLE_RATE / 20
-
 // Audio buffer pump size: 240 samples = 15 ms at 16 kHz.  Matches the
-// I2S DMA chunk size.  Keeping the pump short (vs the historical 50 ms)
-// bounds the latency between SetTone() and the next audible attack at
-// ~15 ms, so Gen2's 61 ms solid→high transition timing still lands
-// inside one half-period at 6.2 PPS (80 ms).  See Tones.ino design notes
-// in Envelope.h.
+// I2S DMA chunk size and onspeed::audio::kToneChunkFrames.  Tone chunks
+// are rendered ahead but at most two are committed to DMA, so the latency
+// between an urgent SetTone() and the DAC stays at ~15-30 ms and Gen2's
+// 61 ms solid→high transition timing still lands inside one half-period
+// at 6.2 PPS (80 ms).  See Tones.ino design notes in Envelope.h.
 #define TONE_PUMP_FRAMES    240
 
 class AudioPlay
@@ -52,7 +48,7 @@ public:
 public:
     EnVoice         enVoice;
     EnAudioTone     enTone;
-    unsigned        uToneFreq;
+    unsigned        uToneFreq;          // Carrier override in Hz, 0 = tone default. See SetToneFreq().
     float           fVolume;            // Audio output volume,from 0.0 to 1.0
     float           fLeftGain;          // Gain control, mostly for 3D audio, nominally 1.0 but
     float           fRightGain;         // can be higher or lower.
@@ -68,7 +64,6 @@ public:
     float           fTonePulseCounter;
 
     I2SClass        i2s;
-    int             iDataLen;           // Number of data points in the audio tone buffer. Not necessarily the buffer length!
 
     bool            bAudioTest;
 
@@ -90,8 +85,8 @@ public:
     void AudioTest();
 
 private:
-    void PlayPcmBuffer(const unsigned char * pData, int iNumBytes, float fLeftVolume, float fRightVolume);
-    void PlayToneBuffer(const int16_t * pData, int iNumSamples, float fLeftVolume, float fRightVolume);
+    void PlayVoiceAsset(const onspeed::audio::VoiceAsset & asset, float fLeftVolume, float fRightVolume);
+    void PlayToneChunk(float fToneHz, uint32_t uGlideSamples, float fLeftVolume, float fRightVolume);
     void PlayVoice();
     void PlayVoice(EnVoice enVoiceIn);
     void PlayTone();
@@ -15,6 +15,7 @@
 #include <config/ConfigXmlParse.h>
 
 #include "src/io/EfisSerialPort.h"
+#include "src/tasks/LogCatalogStore.h"
 
 
 // ============================================================================
@@ -248,7 +249,10 @@ bool FOSConfig::SaveConfigurationToFile(char* szFilename)
             if (hConfigFile)
                 {
                 hConfigFile.print(sConfig);
+                const uint64_t uConfigSize = hConfigFile.fileSize();
                 hConfigFile.close();
+                // Config lives in the SD root, so /logs lists it too.
+                LogCatalogUpsertLocked(szFilename, uConfigSize);
                 bStatus = true;
                 xSemaphoreGive(xWriteMutex);
                 }
@@ -64,10 +64,12 @@ public:
     static constexpr EnSerialFmt EnSerialFmtOther   = onspeed::config::OnSpeedConfig::EnSerialFmtOther;
     static constexpr EnSerialFmt EnSerialFmtG3X     = onspeed::config::OnSpeedConfig::EnSerialFmtG3X;
     static constexpr EnSerialFmt EnSerialFmtOnSpeed = onspeed::config::OnSpeedConfig::EnSerialFmtOnSpeed;
+    static constexpr EnSerialFmt EnSerialFmtOnSpeedBin = onspeed::config::OnSpeedConfig::EnSerialFmtOnSpeedBin;
 
     static EnSerialFmt ParseSerialFmt(const String& s) {
         if (s == "G3X")     return EnSerialFmtG3X;
         if (s == "ONSPEED") return EnSerialFmtOnSpeed;
+        if (s == "ONSPEED_BIN") return EnSerialFmtOnSpeedBin;
         return EnSerialFmtOther;
     }
 
@@ -69,24 +69,27 @@ HscPressureSensor::HscPressureSensor(SpiIO * pSensorSPI, int CsPort, EnPressureS
 
 uint16_t  HscPressureSensor::ReadPressureCounts()
 {
-    UnHSC   uStatusCounts;
+    return AcceptStatusCounts(ReadStatusCounts());
+}
 
-    uStatusCounts = ReadStatusCounts();
+// ----------------------------------------------------------------------------
 
+uint16_t  HscPressureSensor::AcceptStatusCounts(UnHSC unStatusCounts)
+{
     // Honeywell HSC sensors include a 2-bit status field. Only accept samples
     // with normal status; otherwise, reuse the last good sample to avoid
     // injecting spikes/glitches into downstream filters.
-    if (uStatusCounts.suHSC.uStatus == 0)
+    if (unStatusCounts.suHSC.uStatus == 0)
         {
-        uLastGoodCounts    = uStatusCounts.suHSC.uCounts;
+        uLastGoodCounts    = unStatusCounts.suHSC.uCounts;
         bHasLastGoodCounts = true;
-        return uStatusCounts.suHSC.uCounts;
+        return unStatusCounts.suHSC.uCounts;
         }
 
     if (bHasLastGoodCounts)
         return uLastGoodCounts;
 
-    return uStatusCounts.suHSC.uCounts;
+    return unStatusCounts.suHSC.uCounts;
 }
 
 // ----------------------------------------------------------------------------
@@ -97,21 +100,7 @@ float HscPressureSensor::ReadPressurePSI()
     uint16_t uCounts;
 
     uStatusCounts = ReadStatusCounts();
-
-    if (uStatusCounts.suHSC.uStatus == 0)
-        {
-        uCounts            = uStatusCounts.suHSC.uCounts;
-        uLastGoodCounts    = uCounts;
-        bHasLastGoodCounts = true;
-        }
-    else if (bHasLastGoodCounts)
-        {
-        uCounts = uLastGoodCounts;
-        }
-    else
-        {
-        uCounts = uStatusCounts.suHSC.uCounts;
-        }
+    uCounts       = AcceptStatusCounts(uStatusCounts);
 
     g_Log.printf(MsgLog::EnPressure, MsgLog::EnDebug, "Status 0x%2.2x  Counts %5u\n",
         uStatusCounts.suHSC.uStatus, (unsigned)uCounts);
@@ -162,13 +151,24 @@ HscPressureSensor::UnHSC HscPressureSensor::ReadStatusCounts()
 
     uint8_t     aiData[2];
     SensorSPI->ReadBytes(uChipSel, aiData, 2);
-    unData.uStatusCounts = (aiData[0] << 8) | aiData[1];
+    unData = StatusCountsFromBytes(aiData);
 
     return unData;
   } // end ReadCounts
 
 // ----------------------------------------------------------------------------
 
+HscPressureSensor::UnHSC HscPressureSensor::StatusCountsFromBytes(const uint8_t aiData[2])
+  {
+    HscPressureSensor::UnHSC  unData;
+
+    unData.uStatusCounts = (aiData[0] << 8) | aiData[1];
+
+    return unData;
+  }
+
+// ----------------------------------------------------------------------------
+
 HscPressureSensor::RawPressureSnapshot HscPressureSensor::Snapshot() const
   {
     RawPressureSnapshot out;
@@ -64,6 +64,16 @@ public:
 
   UnHSC    ReadStatusCounts();
 
+  // Sweep support: SensorIO queues one 2-byte SpiXfer per sensor on
+  // ChipSel(), runs them with SpiIO::RunSweep under a single mutex hold,
+  // then decodes each frame here after releasing the bus.
+  unsigned ChipSel() const { return uChipSel; }
+  static UnHSC StatusCountsFromBytes(const uint8_t aiData[2]);
+
+  // Apply the status filter to a raw frame: normal status updates and
+  // returns the counts, anything else returns the last good counts.
+  uint16_t AcceptStatusCounts(UnHSC unStatusCounts);
+
   // Returns the last-good pressure reading as a typed snapshot.
   // Does NOT trigger a new SPI read — uses the cached last-good counts.
   RawPressureSnapshot Snapshot() const;
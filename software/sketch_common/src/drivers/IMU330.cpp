@@ -2,12 +2,16 @@
 #include <Arduino.h>
 #include <SPI.h>
 
+#include <algorithm>
+
 #include "src/Globals.h"
 
 using onspeed::accelPitch;
 using onspeed::accelRoll;
+using onspeed::sensors::Ism330FifoSample;
 
 // define ISM330 registers
+#define FIFO_CTRL3          0x09  // accel / gyro batch data rates
 #define FIFO_CTRL4          0x0A
 #define WHO_AM_I            0x0F  // Who Am I value = 0x6B
 #define CTRL1_XL            0x10  // accelerometer control register
@@ -17,10 +21,14 @@ using onspeed::accelRoll;
 #define CTRL6_C             0x15
 #define CTRL7_G             0x16
 #define CTRL9_XL            0x18
+#define CTRL10_C            0x19  // TIMESTAMP_EN
 #define ISM330_OUT_TEMP_L   0x20  // temp output register
 #define ISM330_OUT_TEMP_H   0x21
 #define OUTX_L_G            0x22  // start of gyro output address
 #define OUTX_L_A            0x28  // start of accelerometer output address
+#define FIFO_STATUS1        0x3A  // unread FIFO words [7:0]
+#define INTERNAL_FREQ_FINE  0x63  // timestamp clock trim
+#define FIFO_DATA_OUT_TAG   0x78  // FIFO word: tag + 6 data bytes, burst rolls back here
 
 #define IMU_WRITE_ADDR(addr)  (uint8_t)(0x7F & addr)
 #define IMU_READ_ADDR(addr)   (uint8_t)(0x80 | addr)
@@ -31,6 +39,11 @@ using onspeed::accelRoll;
 #define ISM330_TEMP_SCALE   256.0f
 #define ISM330_TEMP_BIAS     25.0f
 
+// Largest burst ReadFifo() issues: a timestamp, gyro and accel word per
+// sample plus a temperature word now and then. Bounded so the word buffer
+// (7 bytes each) stays a small stack array in ImuReadTask.
+#define FIFO_MAX_BURST_WORDS  64
+
 // ============================================================================
 
 IMU330::IMU330(SpiIO * pSensorSPI, int CsPort)
@@ -39,6 +52,10 @@ IMU330::IMU330(SpiIO * pSensorSPI, int CsPort)
     SensorSPI = pSensorSPI;
 //    Config    = pConfig;
 
+    bFifoMode      = false;
+    uFifoTempCount = 0;
+    uFifoOverruns  = 0;
+
     lLastImuTempUpdate = millis();
 
     // Set up chip select pins as outputs
@@ -64,9 +81,10 @@ IMU330::IMU330(SpiIO * pSensorSPI, int CsPort)
 
 // ----------------------------------------------------------------------------
 
-void IMU330::Init()
+void IMU330::Init(bool bUseFifo)
 {
   Reset();
+  bFifoMode = bUseFifo;
 
   // SPI interface: I2C_disable = 1 in CTRL4_C (13h) and DEVICE_CONF = 1 in CTRL9_XL (18h).
 
@@ -77,13 +95,11 @@ void IMU330::Init()
   // from g_Config.iLogRate; see HardwareMap.h for the policy).
   //   208 Hz: ODR_XL[3:0] = 0101, ODR_G[3:0] = 0101
   //   416 Hz: ODR_XL[3:0] = 0110, ODR_G[3:0] = 0110
+  //   833 Hz: ODR_XL[3:0] = 0111, ODR_G[3:0] = 0111
   // Range / LPF / full-scale bits unchanged across rates.
-  const uint8_t uCtrl1Xl = (g_imuSampleRateHz == kImuSampleRateExperimental)
-                              ? 0b01101100   // 416 Hz, +/-8G, LPF2 disabled
-                              : 0b01011100;  // 208 Hz, +/-8G, LPF2 disabled
-  const uint8_t uCtrl2G  = (g_imuSampleRateHz == kImuSampleRateExperimental)
-                              ? 0b01100000   // 416 Hz, 250 dps
-                              : 0b01010000;  // 208 Hz, 250 dps
+  const uint8_t uOdr     = onspeed::sensors::Ism330OdrCode(g_imuSampleRateHz);
+  const uint8_t uCtrl1Xl = (uint8_t)((uOdr << 4) | 0b1100);   // +/-8G, LPF2 disabled
+  const uint8_t uCtrl2G  = (uint8_t)(uOdr << 4);              // 250 dps
 
   // enable accelerometer
   SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(CTRL1_XL), uCtrl1Xl);
@@ -102,13 +118,36 @@ void IMU330::Init()
   delay(50);
 
   // set fifo
-  SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL4), 0b00010000); // bypass mode, fifo disabled
-  delay(50);
+  if (bFifoMode)
+  {
+    // Timestamp counter on, with its tick trimmed by the factory
+    // INTERNAL_FREQ_FINE value so per-sample dt is in real microseconds.
+    const int8_t iFreqFine = (int8_t)SensorSPI->ReadRegByte(uChipSel, IMU_READ_ADDR(INTERNAL_FREQ_FINE));
+    FifoDecoder.SetTickUs(onspeed::sensors::Ism330TickUsForFreqFine(iFreqFine));
+    FifoDecoder.Reset();
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(CTRL10_C), 0b00100000); // TIMESTAMP_EN
+    delay(50);
+
+    // Batch accel and gyro at the ODR
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL3), (uint8_t)((uOdr << 4) | uOdr));
+    delay(50);
+
+    // continuous mode, timestamp with every batch, temperature at 12.5 Hz
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL4), 0b01100110);
+    delay(50);
+  }
+  else
+  {
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL4), 0b00010000); // bypass mode, fifo disabled
+    delay(50);
+  }
 
   SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(CTRL9_XL), 0b11100000);
   delay(50);
 
   g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug, "IMU Who Am I : 0x%2.2X\n", g_pIMU->WhoAmI());
+  g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug, "IMU %d Hz, %s\n", g_imuSampleRateHz,
+               bFifoMode ? "FIFO batching" : "register polling");
 
 }
 
@@ -140,14 +179,6 @@ void IMU330::Read()
 
     ReadAccelGyro(bTempUpdate); // read accelerometers
 
-    // Get IMU values in aircraft orientation
-    Ax = *pfAx * fAxSign;
-    Ay = *pfAy * fAySign;
-    Az = *pfAz * fAzSign;
-    Gx = *pfGx * fGxSign;
-    Gy = *pfGy * fGySign;
-    Gz = *pfGz * fGzSign;
-
     g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug,
         "Ax %.3f, Ay %.3f, Az %.3f, Gx %.4f, Gy %.4f, Gz %.4f, Temp %.2fC\n",
         Ax, Ay, Az, Gx, Gy, Gz, fTempC);
@@ -174,6 +205,34 @@ void IMU330::ReadAccelGyro(bool bTempUpdate)
     gyRaw = (aGyroData[3] << 8) | aGyroData[2]; // Store y-axis values into gy
     gzRaw = (aGyroData[5] << 8) | aGyroData[4]; // Store z-axis values into gz
 
+    const int16_t aiAccel[3] = { axRaw, ayRaw, azRaw };
+    const int16_t aiGyro[3]  = { gxRaw, gyRaw, gzRaw };
+    ApplyRaw(aiAccel, aiGyro);
+
+#if 1
+    // read IMU temperature output
+    if (bTempUpdate)
+        {
+        ReadTempC();
+
+        pTempAvg->addValue(fTempC);
+        fTempC = pTempAvg->getFastAverage();
+        //imuTempDerivativeInput=imuTempRaw;
+        //imuTempRateAvg.addValue(-imuTempDerivative.Compute()*10.0); //10Hz sample rate on imuTemp, SavGolay derivative filter takes 20-25uSec
+        //imuTempRate=imuTempRateAvg.getFastAverage();
+
+//        g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug, "Temp: %.1fC\n",fTempC);
+        }
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+void IMU330::ApplyRaw(const int16_t aiAccel[3], const int16_t aiGyro[3])
+{
+    axRaw = aiAccel[0];  ayRaw = aiAccel[1];  azRaw = aiAccel[2];
+    gxRaw = aiGyro[0];   gyRaw = aiGyro[1];   gzRaw = aiGyro[2];
+
     fAccelX     = axRaw * ACCEL_RES;
     fAccelY     = ayRaw * ACCEL_RES;
     fAccelZ     = azRaw * ACCEL_RES;
@@ -188,21 +247,75 @@ void IMU330::ReadAccelGyro(bool bTempUpdate)
         g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug, "fAccelX %.3f, fAccelY %.3f, fAccelZ %.3f, fGyroX %.4f, fGyroY %.4f, fGyroZ %.4f\n",
             fAccelX, fAccelY, fAccelZ, fGyroX, fGyroY, fGyroZ);
 
-#if 1
-    // read IMU temperature output
-    if (bTempUpdate)
-        {
-        ReadTempC();
+    // Get IMU values in aircraft orientation
+    Ax = *pfAx * fAxSign;
+    Ay = *pfAy * fAySign;
+    Az = *pfAz * fAzSign;
+    Gx = *pfGx * fGxSign;
+    Gy = *pfGy * fGySign;
+    Gz = *pfGz * fGzSign;
+}
 
-        pTempAvg->addValue(fTempC);
+// ----------------------------------------------------------------------------
+
+// Burst-read the FIFO. Two SPI transactions however many samples are
+// queued: FIFO_STATUS1/2, then every unread word from FIFO_DATA_OUT_TAG
+// (the address rolls back from 0x7E to 0x78, so one read spans words).
+
+int IMU330::ReadFifo(Ism330FifoSample * pSamples, int iMaxSamples)
+{
+    uint8_t aStatus[2];
+    SensorSPI->ReadRegBytes(uChipSel, IMU_READ_ADDR(FIFO_STATUS1), aStatus, 2);
+    const onspeed::sensors::Ism330FifoStatus status =
+        onspeed::sensors::Ism330DecodeFifoStatus(aStatus[0], aStatus[1]);
+
+    // Samples were overwritten. The timestamps keep dt exact across the
+    // gap, so just count it.
+    if (status.overrun)
+        uFifoOverruns++;
+
+    // A timestamp, gyro and accel word per sample. No more: a burst that
+    // starts mid-triple (the decoder holds the half pair from last wake)
+    // would otherwise complete iMaxSamples + 1 pairs and drop the last.
+    // Words left behind, a temperature word included, are read next wake.
+    const int iWords = std::min<int>(status.words, std::min(iMaxSamples * 3, FIFO_MAX_BURST_WORDS));
+    if (iWords <= 0)
+        return 0;
+
+    uint8_t aWords[FIFO_MAX_BURST_WORDS * onspeed::sensors::kIsm330FifoWordBytes];
+    SensorSPI->ReadRegBytes(uChipSel, IMU_READ_ADDR(FIFO_DATA_OUT_TAG), aWords,
+                            iWords * onspeed::sensors::kIsm330FifoWordBytes);
+    const int iSamples = FifoDecoder.Decode(aWords, iWords, pSamples, iMaxSamples);
+
+    // Temperature rides in the FIFO at 12.5 Hz; average it like the
+    // 10 Hz register read in Read().
+    const uint32_t uTemps = FifoDecoder.Stats().temps;
+    if (uTemps != uFifoTempCount)
+    {
+        uFifoTempCount = uTemps;
+        pTempAvg->addValue(FifoDecoder.LastTempRaw() / ISM330_TEMP_SCALE + ISM330_TEMP_BIAS);
         fTempC = pTempAvg->getFastAverage();
-        //imuTempDerivativeInput=imuTempRaw;
-        //imuTempRateAvg.addValue(-imuTempDerivative.Compute()*10.0); //10Hz sample rate on imuTemp, SavGolay derivative filter takes 20-25uSec
-        //imuTempRate=imuTempRateAvg.getFastAverage();
+    }
+    return iSamples;
+}
 
-//        g_Log.printf(MsgLog::EnIMU, MsgLog::EnDebug, "Temp: %.1fC\n",fTempC);
-        }
-#endif
+// ----------------------------------------------------------------------------
+
+// Empty the FIFO (a pass through bypass mode clears it) and restart the
+// decoder's timeline.
+
+void IMU330::FlushFifo()
+{
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL4), 0b01100000); // bypass, same TS / temp batching
+    SensorSPI->WriteRegByte(uChipSel, IMU_WRITE_ADDR(FIFO_CTRL4), 0b01100110); // continuous
+    FifoDecoder.Reset();
+}
+
+// ----------------------------------------------------------------------------
+
+void IMU330::ApplyFifoSample(const Ism330FifoSample & sample)
+{
+    ApplyRaw(sample.accel, sample.gyro);
 }
 
 // ----------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #include <filters/RunningMean.h>
 
 #include "src/drivers/SPI_IO.h"
+#include <sensors/Ism330Fifo.h>
 #include <types/ImuSample.h>
 
 // IMU functions
@@ -20,6 +21,11 @@ protected:
     SpiIO     * SensorSPI;
     unsigned    uChipSel;
 
+    // FIFO batching state (Init(true) only)
+    bool        bFifoMode;
+    onspeed::sensors::Ism330FifoDecoder FifoDecoder;
+    uint32_t    uFifoTempCount;         // FifoDecoder temperature words already averaged
+
 public:
     // Axis definitions (e.g. "X", "-Y", "Z")
     const char* sVerticalGloadAxis;
@@ -59,14 +65,33 @@ public:
 
     onspeed::RunningMean * pTempAvg;
 
+    // FIFO overruns seen by ReadFifo() (samples lost to a late reader)
+    uint32_t    uFifoOverruns;
+
   // Methods
 protected:
+    // Scale raw counts, apply gyro bias and map to aircraft axes. Shared
+    // by the register (Read) and FIFO (ApplyFifoSample) paths.
+    void        ApplyRaw(const int16_t aiAccel[3], const int16_t aiGyro[3]);
 
 public:
-    void        Init();
+    // bUseFifo: queue accel/gyro/timestamp in the sensor FIFO
+    // (continuous mode) instead of polling the output registers.
+    void        Init(bool bUseFifo = false);
     void        Reset();
     void        ReadAccelGyro(bool bTempUpdate);
     void        Read();
+
+    // FIFO mode. ReadFifo() reads FIFO_STATUS and then burst-reads the
+    // queued words in one SPI transaction, decoding up to iMaxSamples
+    // accel/gyro pairs stamped with the sensor's own timestamps. Call it
+    // with xSensorMutex held, as FlushFifo(), which discards whatever
+    // queued up before the reader started. ApplyFifoSample() loads one
+    // pair into the public fields (as Read() does) without touching the bus.
+    bool        FifoEnabled() const { return bFifoMode; }
+    void        FlushFifo();
+    int         ReadFifo(onspeed::sensors::Ism330FifoSample * pSamples, int iMaxSamples);
+    void        ApplyFifoSample(const onspeed::sensors::Ism330FifoSample & sample);
     float       ReadTempC();
     uint8_t     WhoAmI();
     void        ConfigAxes();
@@ -85,7 +110,8 @@ public:
     // Returns the current IMU reading as a core POD struct. Composition
     // point for the future Ahrs::Step call in PR 3.2 — this method bridges
     // the hardware driver side and the board-agnostic core.
-    // Note: IMU330 does not maintain a read timestamp; timestampUs is 0.
+    // Note: IMU330 does not maintain a read timestamp; timestampUs is 0
+    // (ImuReadTask stamps it).
     onspeed::ImuSample Snapshot() const;
 };
 
@@ -169,3 +169,41 @@ void SpiIO::ReadRegBytes(unsigned uChipSel, uint8_t iAddr, uint8_t * paiData, in
     pSPI->endTransaction();
     }
 
+
+// ----------------------------------------------------------------------------
+
+// A sweep replaces N begin/endTransaction pairs with one per clock change
+// and keeps the CS toggles back-to-back, so the xSensorMutex hold is just
+// the wire time plus a few GPIO writes. Each transfer is still timed into
+// its own perf scope.
+//
+// The Arduino SPIClass pushes these through the 64-byte hardware FIFO
+// rather than DMA; for 2..3 byte sensor frames the FIFO path is the
+// faster one (a DMA descriptor setup costs more than the transfer).
+
+void SpiIO::RunSweep(const SpiXfer * paXfers, int iCount)
+{
+    uint32_t    uClock = 0;
+
+    for (int iXfer = 0; iXfer < iCount; iXfer++)
+        {
+        const SpiXfer & xfer       = paXfers[iXfer];
+        const uint32_t  uXferClock = SpiClockForCs(xfer.uChipSel);
+        SpiPerfTimer    perfT(xfer.uChipSel, xfer.uBytes);
+
+        if (uXferClock != uClock)
+            {
+            if (uClock != 0)
+                pSPI->endTransaction();
+            pSPI->beginTransaction(SPISettings(uXferClock, MSBFIRST, SPI_MODE));
+            uClock = uXferClock;
+            }
+
+        digitalWrite(xfer.uChipSel, LOW);
+        pSPI->transferBytes(xfer.pTx, xfer.pRx, xfer.uBytes);
+        digitalWrite(xfer.uChipSel, HIGH);
+        }
+
+    if (uClock != 0)
+        pSPI->endTransaction();
+}
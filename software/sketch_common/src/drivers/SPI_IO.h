@@ -5,6 +5,17 @@
 #ifndef SPI_IO_H
 #define SPI_IO_H
 
+// One pre-built transfer in a sensor sweep. pTx may be nullptr (clock out
+// dummy bytes); pRx receives uBytes bytes. The clock and the perf scope
+// follow from uChipSel, as for the single-transfer calls below.
+struct SpiXfer
+{
+    unsigned        uChipSel;
+    const uint8_t * pTx;
+    uint8_t       * pRx;
+    uint16_t        uBytes;
+};
+
 class SpiIO
 {
 public:
@@ -26,6 +37,12 @@ public:
 
     void      ReadRegBytes( unsigned uChipSel, uint8_t bAddr, uint8_t * paiData, int iBytes);
 
+    // Run a queue of transfers back-to-back. The caller holds xSensorMutex
+    // for the whole sweep; the bus is reconfigured only when the clock
+    // changes between neighbouring transfers. Returns once every pRx is
+    // filled.
+    void      RunSweep(const SpiXfer * paXfers, int iCount);
+
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <math.h>
 #include <type_traits>
+#include <esp_timer.h>          // esp_timer_get_time() — 64-bit µs since boot
 
 #include "src/Globals.h"
 #include "src/ahrs/AhrsSnapshot.h"
@@ -223,6 +224,153 @@ volatile uint32_t g_uImuMaxLateUs  = 0;     // worst lateness observed in window
 // perspective; only `perf reset` (issue #N) zeroes it.
 volatile uint32_t g_uImuMaxLateUsAllTime = 0;
 
+// Record one wake's lateness in the PERF counters above. True when it is
+// over iResyncUs: the caller then re-syncs its schedule to now instead of
+// trying to catch up (counted in g_uImuLateResets, logged at most 1/s).
+
+static bool NoteImuLateness(int32_t iLateUs, int32_t iResyncUs, unsigned long & uLastLateLogMs)
+{
+    // Track lateness on every iteration so the noise floor is
+    // visible in PERF, not just the >1ms outliers. uImuMaxLateUs
+    // captures the worst sub-iteration delay since last emit,
+    // regardless of whether it tripped the reset threshold.
+    if (iLateUs > 0)
+    {
+        const uint32_t uLate = (uint32_t)iLateUs;
+        uint32_t uPrev = __atomic_load_n(&g_uImuMaxLateUs, __ATOMIC_RELAXED);
+        while (uLate > uPrev &&
+               !__atomic_compare_exchange_n(&g_uImuMaxLateUs, &uPrev, uLate,
+                                            false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {}
+
+        // All-time worst — never reset by the per-window PERF emit.
+        // A multi-ms stall that lands between heartbeats was getting
+        // wiped by the next emit, so single-event spikes (like the
+        // 613us blocked-on-xAhrsMutex case in the 416Hz stress) were
+        // invisible. This counter preserves them.
+        uint32_t uPrevAT = __atomic_load_n(&g_uImuMaxLateUsAllTime, __ATOMIC_RELAXED);
+        while (uLate > uPrevAT &&
+               !__atomic_compare_exchange_n(&g_uImuMaxLateUsAllTime, &uPrevAT, uLate,
+                                            false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {}
+    }
+
+    // g_uImuLateResets counts schedule-resets (matching its name); the
+    // sub-threshold noise floor is captured by g_uImuMaxLateUs /
+    // g_uImuMaxLateUsAT (peak metrics, no count) so a noisy floor doesn't
+    // trip the PERF heartbeat on every iteration.
+    if (iLateUs <= iResyncUs)
+        return false;
+
+    __atomic_fetch_add(&g_uImuLateResets, 1u, __ATOMIC_RELAXED);
+
+    const unsigned long uNowMs = millis();
+    if ((uNowMs - uLastLateLogMs) > 1000)
+    {
+        g_Log.println(MsgLog::EnIMU, MsgLog::EnWarning, "ImuReadTask Late");
+        uLastLateLogMs = uNowMs;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+
+// FIFO-batched IMU loop (IMU330 in FIFO mode, kImuFifoBatchSamples > 1).
+// Wakes once per batch, drains the FIFO in one burst under one
+// xSensorMutex take, then replays the samples through the AHRS in order
+// with the sensor-timestamp dt. Per sample it does exactly what the
+// polling loop does per wake: publish the IMU frame, Process(), and the
+// IMU-rate log write.
+
+static void ImuFifoReadLoop(const int iSampleRateHz)
+{
+    const uint32_t uPeriodUs      = uint32_t((1000000ULL * kImuFifoBatchSamples) / iSampleRateHz);
+    const float    fNominalDt     = 1.0f / iSampleRateHz;
+    uint32_t       uNextWakeUs    = micros();
+    unsigned long  uLastLateLogMs = 0;
+    unsigned long  uLastOvrLogMs  = 0;
+    uint32_t       uOverruns      = 0;
+
+    onspeed::sensors::Ism330FifoSample aSamples[kImuFifoMaxSamplesPerRead];
+
+    // Drop what queued up between IMU330::Init() and now.
+    xSemaphoreTake(xSensorMutex, portMAX_DELAY);
+    g_pIMU->FlushFifo();
+    xSemaphoreGive(xSensorMutex);
+
+    while (true)
+    {
+        uNextWakeUs += uPeriodUs;
+
+        int32_t iWaitUs = int32_t(uNextWakeUs - micros());
+        if (iWaitUs > 2000)
+            vTaskDelay(pdMS_TO_TICKS((iWaitUs - 1000) / 1000));
+
+        iWaitUs = int32_t(uNextWakeUs - micros());
+        if (iWaitUs > 0)
+            delayMicroseconds(uint32_t(iWaitUs));
+
+        onspeed::util::perf::PerfLoop perfGuard(
+            onspeed::util::perf::TaskId::Imu,
+            uxTaskGetStackHighWaterMark(nullptr));
+
+        // Lateness costs no samples here until the FIFO fills, so only a
+        // whole missed batch re-syncs the schedule.
+        if (NoteImuLateness(int32_t(micros() - uNextWakeUs), int32_t(uPeriodUs), uLastLateLogMs))
+            uNextWakeUs = micros();
+
+        xSemaphoreTake(xSensorMutex, portMAX_DELAY);
+        const uint64_t uImuReadUs = static_cast<uint64_t>(esp_timer_get_time());
+        const int      iSamples   = g_pIMU->ReadFifo(aSamples, kImuFifoMaxSamplesPerRead);
+        xSemaphoreGive(xSensorMutex);
+
+        if (g_pIMU->uFifoOverruns != uOverruns)
+        {
+            uOverruns = g_pIMU->uFifoOverruns;
+            const unsigned long uNowMs = millis();
+            if ((uNowMs - uLastOvrLogMs) > 1000)
+            {
+                g_Log.println(MsgLog::EnIMU, MsgLog::EnWarning, "ImuReadTask FIFO overrun");
+                uLastOvrLogMs = uNowMs;
+            }
+        }
+
+        // A full read means a backlog is still queued; come straight back.
+        if (iSamples == kImuFifoMaxSamplesPerRead)
+            uNextWakeUs = micros() - uPeriodUs;
+
+        for (int i = 0; i < iSamples; i++)
+        {
+            const onspeed::sensors::Ism330FifoSample & sample = aSamples[i];
+            g_pIMU->ApplyFifoSample(sample);
+
+            // Place each sample on the esp_timer clock relative to the
+            // newest one, which was taken just before this read. The
+            // snapshot keeps the low 32 bits, which is what micros() reads.
+            const uint64_t uSampleUs = onspeed::sensors::Ism330FifoSampleHostUs(
+                uImuReadUs, aSamples[iSamples - 1].timestampUs, sample.timestampUs);
+            {
+                onspeed::ImuSample imuFrame = g_pIMU->Snapshot();
+                imuFrame.timestampUs = static_cast<uint32_t>(uSampleUs);
+                onspeed::ahrs::g_ImuSnapshot.publish(imuFrame);
+            }
+
+            const float fDtSeconds = (sample.dtUs > 0) ? (float(sample.dtUs) * 1.0e-6f) : fNominalDt;
+
+            xSemaphoreTake(xAhrsMutex, portMAX_DELAY);
+            g_AHRS.Process(fDtSeconds);
+            xSemaphoreGive(xAhrsMutex);
+
+            // Stamp the row with the sample's own time: a batch is written
+            // in a burst, and replay derives dt from timeStampUs deltas.
+            if (g_Config.iLogRate >= 208)
+                g_LogSensor.Write(uSampleUs);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
 // FreeRTOS task for reading IMU + updating AHRS at g_imuSampleRateHz
 
 void ImuReadTask(void *pvParams)
@@ -235,6 +383,9 @@ void ImuReadTask(void *pvParams)
     // implicit assumption about that ever changing.
     const int      iSampleRateHz   = g_imuSampleRateHz;
 
+    if (g_pIMU->FifoEnabled())
+        ImuFifoReadLoop(iSampleRateHz);     // never returns
+
     // 1 second = 1,000,000us. Use a fractional accumulator so the average period is exact
     // for rates that don't divide 1,000,000 evenly.
     const uint32_t uBasePeriodUs   = 1000000UL / iSampleRateHz; // 4807us @ 208Hz, 2403us @ 416Hz
@@ -270,50 +421,11 @@ void ImuReadTask(void *pvParams)
             onspeed::util::perf::TaskId::Imu,
             uxTaskGetStackHighWaterMark(nullptr));
 
-        // Track lateness on every iteration so the noise floor is
-        // visible in PERF, not just the >1ms outliers. uImuMaxLateUs
-        // captures the worst sub-iteration delay since last emit,
-        // regardless of whether it tripped the reset threshold.
-        const int32_t iLateUs = int32_t(micros() - uNextWakeUs);
-        if (iLateUs > 0)
-        {
-            const uint32_t uLate = (uint32_t)iLateUs;
-            uint32_t uPrev = __atomic_load_n(&g_uImuMaxLateUs, __ATOMIC_RELAXED);
-            while (uLate > uPrev &&
-                   !__atomic_compare_exchange_n(&g_uImuMaxLateUs, &uPrev, uLate,
-                                                false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
-                {}
-
-            // All-time worst — never reset by the per-window PERF emit.
-            // A multi-ms stall that lands between heartbeats was getting
-            // wiped by the next emit, so single-event spikes (like the
-            // 613us blocked-on-xAhrsMutex case in the 416Hz stress) were
-            // invisible. This counter preserves them.
-            uint32_t uPrevAT = __atomic_load_n(&g_uImuMaxLateUsAllTime, __ATOMIC_RELAXED);
-            while (uLate > uPrevAT &&
-                   !__atomic_compare_exchange_n(&g_uImuMaxLateUsAllTime, &uPrevAT, uLate,
-                                                false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
-                {}
-        }
-
         // Schedule-reset on real lateness (>1 ms). Smaller hiccups let
         // the task naturally catch up via the iWaitUs > 0 check above —
-        // next iteration just fires immediately. g_uImuLateResets counts
-        // these schedule-resets (matching its name); the sub-ms
-        // noise floor is captured by g_uImuMaxLateUs / g_uImuMaxLateUsAT
-        // (peak metrics, no count) so a noisy floor doesn't trip the
-        // PERF heartbeat on every iteration.
-        if (iLateUs > 1000)
+        // next iteration just fires immediately.
+        if (NoteImuLateness(int32_t(micros() - uNextWakeUs), 1000, uLastLateLogMs))
         {
-            __atomic_fetch_add(&g_uImuLateResets, 1u, __ATOMIC_RELAXED);
-
-            const unsigned long uNowMs = millis();
-            if ((uNowMs - uLastLateLogMs) > 1000)
-            {
-                g_Log.println(MsgLog::EnIMU, MsgLog::EnWarning, "ImuReadTask Late");
-                uLastLateLogMs = uNowMs;
-            }
-
             // Don't try to "catch up" forever; re-sync to now.
             uNextWakeUs = micros();
             uRemainderAcc = 0;
@@ -411,12 +523,26 @@ void SensorIO::Read()
     // read inside ImuReadTask's mutex hold, which at IMU rates >208 Hz
     // caused mutex contention with this task's pressure reads (see
     // #627 item 1). Static pressure changes slowly; 50 Hz is plenty.
+    //
+    // The three frames go out as one queued sweep so the bus is held only
+    // for the wire time; status filtering and the PSI / millibar math run
+    // after the mutex is released, where they can't delay ImuReadTask.
+    uint8_t aiPitot[2], aiAoa[2], aiStatic[2];
+    const SpiXfer aSweep[] = {
+        { g_pPitot ->ChipSel(), nullptr, aiPitot,  sizeof(aiPitot)  },
+        { g_pAOA   ->ChipSel(), nullptr, aiAoa,    sizeof(aiAoa)    },
+        { g_pStatic->ChipSel(), nullptr, aiStatic, sizeof(aiStatic) },
+    };
+
     xSemaphoreTake(xSensorMutex, portMAX_DELAY);
-    iPfwd                   = g_pPitot ->ReadPressureCounts()   - g_Config.iPFwdBias;
-    iP45                    = g_pAOA   ->ReadPressureCounts()   - g_Config.iP45Bias;
-    const float fStaticMbar = g_pStatic->ReadPressureMillibars();
+    g_pSensorSPI->RunSweep(aSweep, sizeof(aSweep) / sizeof(aSweep[0]));
     xSemaphoreGive(xSensorMutex);
 
+    iPfwd = g_pPitot->AcceptStatusCounts(HscPressureSensor::StatusCountsFromBytes(aiPitot)) - g_Config.iPFwdBias;
+    iP45  = g_pAOA  ->AcceptStatusCounts(HscPressureSensor::StatusCountsFromBytes(aiAoa))   - g_Config.iP45Bias;
+    const float fStaticMbar = g_pStatic->ReadPressureMillibars(
+        g_pStatic->AcceptStatusCounts(HscPressureSensor::StatusCountsFromBytes(aiStatic)));
+
     PStatic = fStaticMbar;
     Palt    = PressureAltitudeFeetFromMbar(fStaticMbar);
 
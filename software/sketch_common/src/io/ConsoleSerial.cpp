@@ -17,6 +17,7 @@
 #include "src/util/Helpers.h"
 
 #include "src/web_server/ApiHandlers.h"
+#include "src/tasks/LogCatalogStore.h"
 #include "src/tasks/PerfDump.h"
 
 #ifdef ONSPEED_SYNTH_SENSORS
@@ -220,7 +221,10 @@ void ConsoleSerialIO::Read()
                         {
                         g_Log.printf("\nDelete '%s' ", szCmdToken);
                         if (g_SdFileSys.remove(szCmdToken))
+                            {
+                            LogCatalogRemoveLocked(szCmdToken);
                             g_Log.println("SUCCESS");
+                            }
                         else
                             g_Log.println("FAIL");
                         }
@@ -644,9 +648,44 @@ void ConsoleSerialIO::Read()
                     onspeed::perf_dump::EmitOneShot();
                     g_Log.println("perf: one-shot snapshot queued");
                     }
+                else if (strncasecmp(szCmdToken, "TRACE", 5) == 0)
+                    {
+                    // perf trace [ms|stop] — capture until the window
+                    // fills or `ms` elapses (default 5000).
+                    szCmdToken = strtok(NULL, " ");
+                    if (szCmdToken != NULL &&
+                        strncasecmp(szCmdToken, "STOP", 4) == 0)
+                        {
+                        onspeed::perf_dump::StopTrace();
+                        g_Log.println("perf: trace stopped");
+                        }
+                    else
+                        {
+                        // Reject anything but a whole positive number:
+                        // strtoul would turn "5s" or "abc" into a 5 or
+                        // 0 ms capture without complaint.
+                        uint32_t uMs    = 5000u;
+                        bool     bValid = true;
+                        if (szCmdToken != NULL)
+                            {
+                            char* szEnd = NULL;
+                            const unsigned long ulMs = strtoul(szCmdToken, &szEnd, 10);
+                            bValid = (szEnd != szCmdToken && *szEnd == '\0' && ulMs > 0);
+                            uMs    = static_cast<uint32_t>(ulMs);
+                            }
+                        if (!bValid)
+                            g_Log.printf("perf: bad trace duration '%s' (want ms > 0, or stop)\n",
+                                         szCmdToken);
+                        else if (onspeed::perf_dump::StartTrace(uMs))
+                            g_Log.printf("perf: trace armed (%lu ms max)\n",
+                                         static_cast<unsigned long>(uMs));
+                        else
+                            g_Log.println("perf: trace busy (previous window not printed yet)");
+                        }
+                    }
                 else
                     {
-                    g_Log.println("perf: usage: perf [on|off|dump|status]");
+                    g_Log.println("perf: usage: perf [on|off|dump|status|trace [ms|stop]]");
                     }
 #else
                 g_Log.println("perf: not compiled in (build env: esp32s3-v4p-perf)");
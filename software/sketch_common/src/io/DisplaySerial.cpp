@@ -21,6 +21,8 @@ using onspeed::aoa::ComputePercentLift;
 using onspeed::aoa::DisplayPctAnchors;
 using onspeed::proto::DisplayBuildInputs;
 using onspeed::proto::BuildDisplayFrame;
+using onspeed::proto::DisplayBinaryEncoder;
+using onspeed::proto::kDisplayBinMaxFrameBytes;
 using onspeed::proto::kDisplayFrameSizeBytes;
 
 
@@ -67,6 +69,12 @@ static inline unsigned SafeScaledUInt(float value, float scale, unsigned minValu
     return (unsigned)scaled;
 }
 
+// Binary-format encoder.  It diffs against the previous frame it sent, so
+// like the snapshot holds in Write() it relies on Write() having a single
+// caller (WriteDisplayDataTask).
+static DisplayBinaryEncoder s_BinEncoder;
+static bool                 s_bBinActive = false;
+
 // ----------------------------------------------------------------------------
 
 // FreeRTOS task for writing display data
@@ -79,8 +87,14 @@ void WriteDisplayDataTask(void * pvParams)
 
     while (true)
         {
+        // The binary format runs at 100 Hz, the ASCII formats at 20 Hz.
+        // Re-read every tick so a config save switches cadence with it.
+        const int iPeriodMs = (g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtOnSpeedBin)
+                                  ? kDisplaySerialBinPeriodMs
+                                  : kDisplaySerialPeriodMs;
+
         // No delay happening is a design error so flag it if it happens
-        xWasDelayed = xTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(kDisplaySerialPeriodMs));
+        xWasDelayed = xTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(iPeriodMs));
 
         // PERF: time only the work after the wait.
         onspeed::util::perf::PerfLoop perfGuard(
@@ -91,7 +105,7 @@ void WriteDisplayDataTask(void * pvParams)
             // If this task runs late, don't "catch up" by running back-to-back and
             // bursting serial data at the display. Re-align to the current tick
             // period instead.
-            xLastWakeTime = xLAST_TICK_TIME(kDisplaySerialPeriodMs);
+            xLastWakeTime = xLAST_TICK_TIME(iPeriodMs);
             unsigned long uNow = millis();
             if ((uNow - uLastLateLogMs) > 1000)
                 {
@@ -333,6 +347,9 @@ void DisplaySerial::Write()
 
     // Output the data in the appropriate format
 
+    if (g_Config.enSerialOutFormat != FOSConfig::EnSerialFmtOnSpeedBin)
+        s_bBinActive = false;
+
     if (g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtG3X)
         {
         // Clamp to fixed-width protocol fields to prevent buffer overruns and
@@ -383,10 +400,12 @@ void DisplaySerial::Write()
         pSerial->println();
         } // end if G3X
 
-    else if (g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtOnSpeed)
+    else if (g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtOnSpeed ||
+             g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtOnSpeedBin)
         {
-        // Build the #1 frame via the shared core module so the layout
-        // is defined in exactly one place (onspeed_core/proto/DisplaySerial.h).
+        // Build the #1 frame (or its binary twin) via the shared core
+        // module so the layout is defined in exactly one place
+        // (onspeed_core/proto/DisplaySerial.h).
         //
         // The per-field scale factors, clamps, and sign conventions are
         // documented there.
@@ -471,6 +490,23 @@ void DisplaySerial::Write()
         inputs.spinRecoveryCue    = 0;
         inputs.dataMark           = (int)((unsigned)g_iDataMark % 100u);
 
+        if (g_Config.enSerialOutFormat == FOSConfig::EnSerialFmtOnSpeedBin)
+            {
+            // Start over with a keyframe whenever the format is switched
+            // back to binary so the display never applies a delta to a
+            // stale base.
+            if (!s_bBinActive)
+                s_BinEncoder.ForceKeyframe();
+            s_bBinActive = true;
+
+            uint8_t binBuf[kDisplayBinMaxFrameBytes];
+            const size_t nBytes = s_BinEncoder.Encode(inputs, binBuf, sizeof(binBuf));
+            if (nBytes == 0)
+                return;
+            pSerial->write(binBuf, nBytes);
+            return;
+            }
+
         uint8_t frameBuf[kDisplayFrameSizeBytes];
         const size_t nBytes = BuildDisplayFrame(inputs, frameBuf, sizeof(frameBuf));
 
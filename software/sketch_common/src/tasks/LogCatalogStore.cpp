@@ -0,0 +1,254 @@
+
+#ifndef DISABLE_FS_H_WARNING
+#define DISABLE_FS_H_WARNING
+#endif
+#include "SdFat.h"
+
+#include "src/Globals.h"
+#include "src/tasks/LogCatalogStore.h"
+
+#include <log/LogMetaFile.h>
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+using onspeed::log::LogCatalog;
+using onspeed::log::LogCatalogEntry;
+using onspeed::log::kLogCatalogFileName;
+using onspeed::log::kLogCatalogTmpFileName;
+using onspeed::log::kLogCatalogMaxLineLen;
+using onspeed::log::kLogCatalogNameLen;
+
+// Set by the first reconcile after boot; /api/logs forces one until then.
+static bool s_bVerifiedThisBoot = false;
+
+// ---------------------------------------------------------------------------
+
+// Append one formatted line. Opens without O_CREAT: a journal that does not
+// exist yet is created only by LogCatalogSaveLocked() from a full listing.
+static void AppendLineLocked(const char *szLine, size_t uLen)
+{
+    if (uLen == 0 || !g_SdFileSys.bSdAvailable)
+        return;
+
+    FsFile f = g_SdFileSys.open(kLogCatalogFileName, O_WRONLY | O_APPEND);
+    if (!f.isOpen())
+        return;
+    const size_t uActual = f.write(szLine, uLen);
+    f.close();
+    if (uActual != uLen)
+        g_Log.printf(MsgLog::EnDisk, MsgLog::EnWarning,
+            "Log catalog short append (requested=%u actual=%u)\n",
+            (unsigned)uLen, (unsigned)uActual);
+}
+
+// ---------------------------------------------------------------------------
+
+bool LogCatalogLoadLocked(LogCatalog *pCatalog)
+{
+    pCatalog->Reset();
+
+    FsFile f = g_SdFileSys.open(kLogCatalogFileName, O_RDONLY);
+    if (!f.isOpen())
+        return false;
+
+    // Two lines' worth: every record fits in one kLogCatalogMaxLineLen,
+    // so a full buffer with no '\n' in it means the file is not ours.
+    char   buf[kLogCatalogMaxLineLen * 2];
+    size_t uUsed = 0;
+    bool   bOk   = true;
+    while (bOk)
+        {
+        const int n = f.read(buf + uUsed, sizeof(buf) - uUsed);
+        if (n <= 0)
+            break;
+        uUsed += static_cast<size_t>(n);
+
+        size_t uStart = 0;
+        while (uStart < uUsed)
+            {
+            const char *pNl = static_cast<const char *>(memchr(buf + uStart, '\n', uUsed - uStart));
+            if (pNl == nullptr)
+                break;
+            const size_t uEnd = static_cast<size_t>(pNl - buf);
+            if (!pCatalog->ApplyLine(std::string_view(buf + uStart, uEnd - uStart)) &&
+                !pCatalog->Valid())
+                {
+                bOk = false;
+                break;
+                }
+            uStart = uEnd + 1;
+            }
+        memmove(buf, buf + uStart, uUsed - uStart);
+        uUsed -= uStart;
+        if (uUsed == sizeof(buf))
+            bOk = false;
+        }
+    f.close();
+
+    // Any bytes left in buf are a torn final line; LogCatalog ignores it
+    // the same way.
+    if (!bOk || !pCatalog->Valid())
+        {
+        pCatalog->Reset();
+        return false;
+        }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+bool LogCatalogSaveLocked(const LogCatalog &catalog)
+{
+    if (!g_SdFileSys.bSdAvailable)
+        return false;
+
+    FsFile f = g_SdFileSys.open(kLogCatalogTmpFileName, O_RDWR | O_CREAT | O_TRUNC);
+    if (!f.isOpen())
+        {
+        g_Log.println(MsgLog::EnDisk, MsgLog::EnWarning, "Log catalog tmp open failed");
+        return false;
+        }
+
+    // Stage whole records into a 2 KB buffer so a few hundred entries go
+    // out as a handful of sector-sized writes.
+    static const size_t kStageSize = 2048;
+    char   szStage[kStageSize];
+    size_t uStaged = LogCatalog::FormatHeader(szStage, kStageSize);
+    bool   bOk     = true;
+    for (const LogCatalogEntry &e : catalog.Entries())
+        {
+        if (kStageSize - uStaged < kLogCatalogMaxLineLen)
+            {
+            bOk &= (f.write(szStage, uStaged) == uStaged);
+            uStaged = 0;
+            }
+        uStaged += LogCatalog::FormatUpsert(e, szStage + uStaged, kStageSize - uStaged);
+        }
+    if (uStaged > 0)
+        bOk &= (f.write(szStage, uStaged) == uStaged);
+    f.sync();
+    f.close();
+
+    if (!bOk)
+        {
+        g_Log.println(MsgLog::EnDisk, MsgLog::EnWarning,
+                      "Log catalog short write; keeping previous journal");
+        g_SdFileSys.remove(kLogCatalogTmpFileName);
+        return false;
+        }
+
+    // Same remove-then-rename as the .meta sidecar: some FAT
+    // implementations refuse rename-onto-existing.
+    if (g_SdFileSys.exists(kLogCatalogFileName))
+        g_SdFileSys.remove(kLogCatalogFileName);
+    if (!g_SdFileSys.rename(kLogCatalogTmpFileName, kLogCatalogFileName))
+        {
+        g_Log.println(MsgLog::EnDisk, MsgLog::EnWarning, "Log catalog rename failed");
+        g_SdFileSys.remove(kLogCatalogTmpFileName);
+        return false;
+        }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+void LogCatalogReconcileLocked(const SdFileSys::SuFileInfoList &suFileList,
+                               LogCatalog                      *pCatalog)
+{
+    bool bChanged = false;
+    if (!pCatalog->Valid())
+        {
+        pCatalog->ApplyLine(onspeed::log::kLogCatalogHeader);
+        bChanged = true;
+        }
+
+    // One sorted merge against the listing (LogCatalog::Reconcile); new
+    // and resized files have their sidecars read here.
+    std::vector<onspeed::log::LogCatalogListedFile> listed(suFileList.size());
+    for (size_t i = 0; i < suFileList.size(); ++i)
+        {
+        listed[i].name = suFileList[i].szFileName;
+        listed[i].size = suFileList[i].uFileSize;
+        }
+    auto read = [](void * /*ctx*/, LogCatalogEntry &e)
+        {
+        char szName[kLogCatalogNameLen];        // ReadEntry clears e first
+        memcpy(szName, e.name, sizeof(szName));
+        LogCatalogReadEntryLocked(szName, e.size, &e);
+        };
+    bChanged |= pCatalog->Reconcile(listed.data(), listed.size(), read, nullptr);
+
+    if (bChanged || pCatalog->NeedsCompaction())
+        LogCatalogSaveLocked(*pCatalog);
+    s_bVerifiedThisBoot = true;
+}
+
+// ---------------------------------------------------------------------------
+
+bool LogCatalogVerifiedThisBoot()
+{
+    return s_bVerifiedThisBoot;
+}
+
+// ---------------------------------------------------------------------------
+
+void LogCatalogReadEntryLocked(const char *szName, uint64_t uSize, LogCatalogEntry *pEntry)
+{
+    *pEntry = LogCatalogEntry{};
+    strncpy(pEntry->name, szName, sizeof(pEntry->name) - 1);
+    pEntry->size = uSize;
+
+    // <base>.meta / <base>.dbg, where <base> is the name up to its last dot.
+    char szSidecar[kLogCatalogNameLen + 8];
+    const char *pDot = strrchr(szName, '.');
+    if (pDot == nullptr || pDot == szName)
+        return;
+    const size_t uBaseLen = static_cast<size_t>(pDot - szName);
+    if (uBaseLen + sizeof(".meta") > sizeof(szSidecar))
+        return;
+    memcpy(szSidecar, szName, uBaseLen);
+
+    strcpy(szSidecar + uBaseLen, ".dbg");
+    pEntry->hasDbg = g_SdFileSys.exists(szSidecar);
+
+    strcpy(szSidecar + uBaseLen, ".meta");
+    FsFile f = g_SdFileSys.open(szSidecar, O_RDONLY);
+    if (!f.isOpen())
+        return;
+    char buf[512];
+    const int n = f.read(buf, sizeof(buf) - 1);
+    f.close();
+    if (n <= 0)
+        return;
+    pEntry->hasMeta = onspeed::log::ParseMetaFile(
+        std::string_view(buf, static_cast<size_t>(n)), &pEntry->meta);
+}
+
+// ---------------------------------------------------------------------------
+
+void LogCatalogUpsertLocked(const char *szName, uint64_t uSize)
+{
+    if (szName == nullptr || strlen(szName) >= kLogCatalogNameLen)
+        return;
+
+    LogCatalogEntry e;
+    LogCatalogReadEntryLocked(szName, uSize, &e);
+
+    char szLine[kLogCatalogMaxLineLen];
+    AppendLineLocked(szLine, LogCatalog::FormatUpsert(e, szLine, sizeof(szLine)));
+}
+
+// ---------------------------------------------------------------------------
+
+void LogCatalogRemoveLocked(const char *szName)
+{
+    if (szName == nullptr)
+        return;
+    if (szName[0] == '/')
+        szName++;
+
+    char szLine[kLogCatalogNameLen + 4];
+    AppendLineLocked(szLine, LogCatalog::FormatRemove(szName, szLine, sizeof(szLine)));
+}
@@ -0,0 +1,54 @@
+
+#pragma once
+
+#include "src/Globals.h"
+#include <log/LogCatalog.h>
+
+// ============================================================================
+
+// SD-card side of onspeed::log::LogCatalog: the /logcat.idx journal that
+// lets /api/logs list the card with one sequential read instead of a
+// directory walk plus a .meta open per log.
+//
+// Writers append one line per change while they already hold xWriteMutex:
+//   LogSensor::WriteSidecarLocked()   active log size + meta, every 30 s
+//   LogSensor::Close()                final size, dated rename
+//   delete handlers / console DELETE  removal
+//   FOSConfig::SaveConfigurationToFile  config file size
+// Appends are skipped while no journal exists, so a card that was never
+// reconciled can't end up with a partial catalog that looks complete.
+//
+// LogCatalogReconcileLocked() rebuilds it against a FileList() — from
+// LogSensor::Open() (which already walks the directory to pick the next
+// log number) and from the first /api/logs of each boot, which catches
+// files copied or deleted while the card was in a PC.
+//
+// Every function requires the caller to hold xWriteMutex.
+
+// Replay /logcat.idx into *pCatalog. Returns false (catalog Reset) when the
+// file is missing or its header doesn't match.
+bool LogCatalogLoadLocked(onspeed::log::LogCatalog *pCatalog);
+
+// Rewrite the journal compacted to one record per entry (tmp + rename).
+bool LogCatalogSaveLocked(const onspeed::log::LogCatalog &catalog);
+
+// Bring *pCatalog in line with a root FileList(): add new or resized files
+// (re-reading their .meta), drop vanished ones, and save when anything
+// changed or the journal has grown past its compaction threshold. An
+// invalid (unloaded) catalog is treated as empty.
+void LogCatalogReconcileLocked(const SdFileSys::SuFileInfoList &suFileList,
+                               onspeed::log::LogCatalog        *pCatalog);
+
+// True once a reconcile has run since boot.
+bool LogCatalogVerifiedThisBoot();
+
+// Fill *pEntry for root file szName of uSize bytes: parse <base>.meta if
+// present and note whether <base>.dbg exists.
+void LogCatalogReadEntryLocked(const char *szName, uint64_t uSize,
+                               onspeed::log::LogCatalogEntry *pEntry);
+
+// Journal szName (re-reading its sidecars) at uSize bytes.
+void LogCatalogUpsertLocked(const char *szName, uint64_t uSize);
+
+// Journal removal of szName. A leading '/' is ignored.
+void LogCatalogRemoveLocked(const char *szName);
@@ -9,14 +9,17 @@
 #include "src/ahrs/AhrsSnapshot.h"
 #include "src/ahrs/SensorSnapshot.h"
 #include "src/ahrs/ImuSnapshot.h"
+#include "src/tasks/LogCatalogStore.h"
 #include <buildinfo.h>
 #include <log/ConsumeAlignedWrite.h>
 #include <log/LogMetaBuilder.h>
 #include <log/LogMetaFile.h>
+#include <proto/LogBin.h>
 #include <proto/LogCsv.h>
 #include <types/LogRow.h>
 #include <util/Perf.h>
 
+#include <new>
 #include <type_traits>
 
 // PR #608: LogRow is sent through the logging ring buffer as raw bytes
@@ -180,6 +183,61 @@ static uint32_t       uLastWriteMs                = 0;
 static char          szCarryoverBuf[onspeed::proto::log_csv::kRowMaxBytes];
 static size_t        uCarryoverLen  = 0;
 
+// Binary columnar (.osl) session state — see proto/LogBin.h.  When
+// g_Config.iLogFormat selects it at Open(), the writer appends each
+// received LogRow to a BlockEncoder instead of running FormatRow, and
+// serializes a block straight into szWriteBuf when the encoder fills,
+// the age gate fires, or the file is synced / closed.  The encoder is
+// ~10 KB, so it lives in PSRAM next to the staging buffer.
+//
+// s_binCarryRow is the binary analogue of szCarryoverBuf: a row the
+// encoder refused (block full or column set changed) while the staging
+// buffer had no room for the finished block.  Guarded by xWriteMutex,
+// like everything else the writer touches.
+namespace logbin = onspeed::proto::log_bin;
+static logbin::BlockEncoder* s_pBlockEncoder = nullptr;   // PSRAM-allocated
+static bool                  s_bBinaryLog    = false;
+static onspeed::LogRow       s_binCarryRow;
+static bool                  s_bBinCarry     = false;
+static uint32_t              s_uBlockStartMs = 0;      // first row of the open block
+
+static bool EnsureBlockEncoderAllocated()
+{
+    if (s_pBlockEncoder != nullptr) return true;
+    void* pMem = heap_caps_malloc(sizeof(logbin::BlockEncoder),
+                                  MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (pMem == nullptr) return false;
+    s_pBlockEncoder = new (pMem) logbin::BlockEncoder();
+    return true;
+}
+
+// Append one row to the open block, noting when the block started so
+// the age gate can bound how long its rows wait.  Returns false when
+// the encoder refuses the row (see BlockEncoder::Append).
+static bool AppendBinaryRowLocked(const onspeed::LogRow& row)
+{
+    const bool bWasEmpty = s_pBlockEncoder->Empty();
+    if (!s_pBlockEncoder->Append(row)) return false;
+    if (bWasEmpty) s_uBlockStartMs = millis();
+    return true;
+}
+
+// Serialize the encoder's buffered rows as one block at the tail of the
+// staging buffer.  Returns false (rows kept) when the block doesn't fit
+// yet; the caller writes staged sectors out and retries.  Caller must
+// hold xWriteMutex.
+static bool FinishBlockLocked()
+{
+    if (s_pBlockEncoder == nullptr || s_pBlockEncoder->Empty()) return true;
+    if (szWriteBuf == nullptr) return false;
+    const size_t uNeed = s_pBlockEncoder->EncodedBytes();
+    if (uBufUsed + uNeed > WRITE_BUF_SIZE) return false;
+    uBufUsed += s_pBlockEncoder->Finish(
+        reinterpret_cast<uint8_t*>(szWriteBuf) + uBufUsed,
+        WRITE_BUF_SIZE - uBufUsed);
+    return true;
+}
+
 // Rate-limited warning for short writes: emits at most once per 2 s
 // so a sustained problem doesn't flood the dbg ring. Returns the
 // previous-window count if a warning should fire this call (0 if not).
@@ -358,6 +416,12 @@ void LogSensorCommitTask(void *pvParams)
             uCarryoverLen = 0;
             bGotData = true;
             }
+        if (s_bBinCarry && FinishBlockLocked())
+            {
+            AppendBinaryRowLocked(s_binCarryRow);
+            s_bBinCarry = false;
+            bGotData = true;
+            }
 
         // Scratch buffer for formatting one row at a time on this
         // (consumer) task.  PR #608: FormatRow moved here from the
@@ -369,7 +433,7 @@ void LogSensorCommitTask(void *pvParams)
             {
             // If we already have carryover, don't receive more — first
             // write out what's staged so the carryover has room next round.
-            if (uCarryoverLen > 0) break;
+            if (uCarryoverLen > 0 || s_bBinCarry) break;
 
             pchIn = (char *)xRingbufferReceive(xLoggingRingBuffer, &iPrintLen, xWait);
             xWait = 0;     // subsequent receives are non-blocking
@@ -390,7 +454,32 @@ void LogSensorCommitTask(void *pvParams)
             // regression), skip with a rate-limited warning rather
             // than reinterpreting a surprise byte shape.
             size_t lineLen = 0;
-            if (iPrintLen == sizeof(onspeed::LogRow)) {
+            if (iPrintLen == sizeof(onspeed::LogRow) && s_bBinaryLog) {
+                // Binary session: no formatting at all, just a column
+                // copy into the encoder.  A refused row means the block
+                // is full (or the column set changed); serialize it into
+                // staging and retry, or park the row if staging is full.
+                onspeed::LogRow row;
+                memcpy(&row, pchIn, sizeof(row));
+                if (!AppendBinaryRowLocked(row)) {
+                    if (FinishBlockLocked()) {
+                        AppendBinaryRowLocked(row);
+                    } else {
+                        __atomic_fetch_add(&s_uDrainOverflowCount, 1u, __ATOMIC_RELAXED);
+                        __atomic_fetch_add(&s_uDrainOverflowBytes,
+                                           (uint32_t)s_pBlockEncoder->EncodedBytes(),
+                                           __ATOMIC_RELAXED);
+                        s_binCarryRow = row;
+                        s_bBinCarry   = true;
+                        vRingbufferReturnItem(xLoggingRingBuffer, pchIn);
+                        pchIn = NULL;
+                        break;
+                    }
+                }
+                if (s_pBlockEncoder->Full())
+                    FinishBlockLocked();
+                bGotData = true;
+            } else if (iPrintLen == sizeof(onspeed::LogRow)) {
                 onspeed::LogRow row;
                 memcpy(&row, pchIn, sizeof(row));
                 lineLen = onspeed::proto::log_csv::FormatRow(
@@ -476,7 +565,8 @@ void LogSensorCommitTask(void *pvParams)
         // mount error) sees one Open-error log on boot and then only
         // generic ring-buffer-full drops once the staging buffer
         // saturates ~1 s later. This warning names the actual cause.
-        if (uBufUsed > 0 && !m_hLogFile.isOpen())
+        if ((uBufUsed > 0 || (s_pBlockEncoder != nullptr && !s_pBlockEncoder->Empty()))
+            && !m_hLogFile.isOpen())
             {
             static unsigned long uLastNoFileWarnMs = 0;
             unsigned long uNow = millis();
@@ -489,8 +579,18 @@ void LogSensorCommitTask(void *pvParams)
             // full and the drain loop above can keep recycling ring
             // slots (preventing producer-side ring overflow drops).
             uBufUsed = 0;
+            if (s_pBlockEncoder != nullptr) s_pBlockEncoder->Reset();
+            s_bBinCarry = false;
             }
 
+        // Binary sessions buffer up to kRowsPerBlock rows in the encoder
+        // before anything reaches szWriteBuf.  Apply the same age gate the
+        // staging buffer uses so low log rates don't hold a partial block
+        // (and its rows) in PSRAM indefinitely.
+        if (s_bBinaryLog && m_hLogFile.isOpen() && !s_pBlockEncoder->Empty() &&
+            (millis() - s_uBlockStartMs) >= WRITE_BUF_MAX_AGE_MS)
+            FinishBlockLocked();
+
         // Write 512-byte-aligned chunks to disk
         bool bDidSync = false;
         if (uBufUsed > 0 && m_hLogFile.isOpen())
@@ -537,6 +637,7 @@ void LogSensorCommitTask(void *pvParams)
             // Flush any remaining partial sector before sync so the data is on disk.
             if ((xTaskGetTickCount() - xLastSyncTime) > pdMS_TO_TICKS(SYNC_INTERVAL_MS))
             {
+                FinishBlockLocked();
                 FlushStagingBufferLocked();
                 uSyncStart = micros();
                 {
@@ -748,11 +849,33 @@ void LogSensor::Open()
                     }
                 if (iFileNum > iMaxFileNum) iMaxFileNum = iFileNum;
                 } // end for all files
+
+            // Same listing keeps the /logs catalog honest: picks up files
+            // copied or deleted on a PC and sessions cut off by power loss.
+            onspeed::log::LogCatalog catalog;
+            LogCatalogLoadLocked(&catalog);
+            LogCatalogReconcileLocked(suFileList, &catalog);
             }
         else
             g_Log.print(MsgLog::EnDisk, MsgLog::EnError, "LOGSENSOR FileList() fail");
 
-        snprintf(szSensorLogFilename, sizeof(szSensorLogFilename), "log_%03d.csv", iMaxFileNum + 1);
+        // Pick the row-stream encoding for this session.  Binary needs
+        // the PSRAM block encoder; fall back to CSV rather than not
+        // logging if that allocation fails.
+        s_bBinaryLog = false;
+        if (g_Config.iLogFormat == 1)
+            {
+            if (EnsureBlockEncoderAllocated())
+                s_bBinaryLog = true;
+            else
+                g_Log.println(MsgLog::EnDisk, MsgLog::EnWarning,
+                              "LogSensor: PSRAM alloc for block encoder failed; logging CSV");
+            }
+        m_szDataExt = s_bBinaryLog ? "osl" : "csv";
+        if (s_pBlockEncoder != nullptr) s_pBlockEncoder->Reset();
+        s_bBinCarry = false;
+
+        snprintf(szSensorLogFilename, sizeof(szSensorLogFilename), "log_%03d.%s", iMaxFileNum + 1, m_szDataExt);
         snprintf(m_szBaseName, sizeof(m_szBaseName), "log_%03d", iMaxFileNum + 1);
 
         g_Log.print("Sensor log file:"); g_Log.println(szSensorLogFilename);
@@ -772,21 +895,38 @@ void LogSensor::Open()
             // need it to reproduce the L/Dmax pip slide between detents.
             headerRow.flapsRawAdcPresent = true;
 
-            static char szHeader[onspeed::proto::log_csv::kHeaderMaxBytes];
-            size_t hdrLen = onspeed::proto::log_csv::WriteHeader(headerRow, szHeader, sizeof(szHeader));
-            if (hdrLen > 0)
+            if (s_bBinaryLog)
                 {
-                const size_t uActual = m_hLogFile.write(szHeader, hdrLen);
+                // Binary file header records the same feature flags the
+                // CSV header line would; ExportCsv regenerates that line.
+                uint8_t abyHeader[onspeed::proto::log_bin::kFileHeaderBytes];
+                const size_t hdrLen = onspeed::proto::log_bin::WriteFileHeader(
+                    headerRow, abyHeader, sizeof(abyHeader));
+                const size_t uActual = m_hLogFile.write(abyHeader, hdrLen);
                 if (uActual != hdrLen)
                     g_Log.printf(MsgLog::EnDisk, MsgLog::EnError,
                         "SD header short write (requested=%u actual=%u)\n",
                         (unsigned)hdrLen, (unsigned)uActual);
                 }
-            if (m_hLogFile.write("\n", 1) != 1)
-                g_Log.println(MsgLog::EnDisk, MsgLog::EnError,
-                    "SD header newline short write");
+            else
+                {
+                static char szHeader[onspeed::proto::log_csv::kHeaderMaxBytes];
+                size_t hdrLen = onspeed::proto::log_csv::WriteHeader(headerRow, szHeader, sizeof(szHeader));
+                if (hdrLen > 0)
+                    {
+                    const size_t uActual = m_hLogFile.write(szHeader, hdrLen);
+                    if (uActual != hdrLen)
+                        g_Log.printf(MsgLog::EnDisk, MsgLog::EnError,
+                            "SD header short write (requested=%u actual=%u)\n",
+                            (unsigned)hdrLen, (unsigned)uActual);
+                    }
+                if (m_hLogFile.write("\n", 1) != 1)
+                    g_Log.println(MsgLog::EnDisk, MsgLog::EnError,
+                        "SD header newline short write");
+                }
 
             m_hLogFile.sync();
+            LogCatalogUpsertLocked(szSensorLogFilename, m_hLogFile.fileSize());
 
             // Initialise sidecar accumulator for this session.
             onspeed::log::EfisType etype = onspeed::log::EfisType::None;
@@ -911,6 +1051,24 @@ void LogSensor::WriteSidecarLocked()
         // accumulate across many failed refreshes.
         g_SdFileSys.remove(tmpPath);
     }
+
+    // Journal the new size + meta so /api/logs never opens this sidecar
+    // itself. Close() calls us after the data file is closed and
+    // journals the final (possibly renamed) name on its own.
+    if (m_hLogFile.isOpen()) {
+        char dataPath[32];
+        snprintf(dataPath, sizeof(dataPath), "%s.%s", m_szBaseName, m_szDataExt);
+        LogCatalogUpsertLocked(dataPath, m_hLogFile.fileSize());
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+// Size of the row-stream file including everything flushed so far; 0 when
+// no session is open. Caller must hold xWriteMutex.
+uint64_t LogSensor::ActiveFileSizeLocked() const
+{
+    return m_hLogFile.isOpen() ? m_hLogFile.fileSize() : 0;
 }
 
 // ----------------------------------------------------------------------------
@@ -947,6 +1105,23 @@ void LogSensor::Close()
         uCarryoverLen = 0;
         }
     FlushStagingBufferLocked();
+
+    // Binary session: serialize the partial block, then any row parked
+    // by the drain loop, behind whatever the flush above left staged.
+    if (s_bBinaryLog)
+        {
+        if (!FinishBlockLocked())
+            {
+            FlushStagingBufferLocked();
+            FinishBlockLocked();
+            }
+        if (s_bBinCarry && AppendBinaryRowLocked(s_binCarryRow))
+            FinishBlockLocked();
+        s_bBinCarry = false;
+        FlushStagingBufferLocked();
+        s_pBlockEncoder->Reset();
+        }
+    const uint64_t uFinalSize = m_hLogFile.fileSize();
     m_hLogFile.close();
 
     // Close the paired .dbg file. Caller already holds xWriteMutex,
@@ -963,6 +1138,11 @@ void LogSensor::Close()
     // it again is cheap and yields the same data.
     onspeed::log::LogMeta meta = m_metaBuilder.Finalize();
 
+    // Name the catalog records the session under; replaced below if the
+    // dated rename goes through.
+    char finalDataName[32];
+    snprintf(finalDataName, sizeof(finalDataName), "%s.%s", m_szBaseName, m_szDataExt);
+
     // Optional rename: only when we captured an actual ISO-8601 UTC date
     // (format "YYYY-MM-DDTHH:MM:SSZ", at least 11 chars — we only use the
     // first 10 for the filename prefix). The VN-300 serial parser currently
@@ -992,12 +1172,12 @@ void LogSensor::Close()
 
         char newCsvName[32];
         char newMetaName[32];
-        snprintf(newCsvName,  sizeof(newCsvName),  "%s_%s.csv",  datePrefix, nnn);
+        snprintf(newCsvName,  sizeof(newCsvName),  "%s_%s.%s",   datePrefix, nnn, m_szDataExt);
         snprintf(newMetaName, sizeof(newMetaName), "%s_%s.meta", datePrefix, nnn);
 
         char oldCsvName[32];
         char oldMetaName[32];
-        snprintf(oldCsvName,  sizeof(oldCsvName),  "%s.csv",  m_szBaseName);
+        snprintf(oldCsvName,  sizeof(oldCsvName),  "%s.%s",   m_szBaseName, m_szDataExt);
         snprintf(oldMetaName, sizeof(oldMetaName), "%s.meta", m_szBaseName);
 
         // Rename the .meta first — it's smaller and fails earlier on
@@ -1028,10 +1208,16 @@ void LogSensor::Close()
         // succeeded. Otherwise we'd leave a dated .dbg next to an
         // undated .csv/.meta pair, which is worse than no rename.
         // Caller already holds xWriteMutex for SD serialisation.
-        if (bRenamedTrio)
+        if (bRenamedTrio) {
             g_DebugLog.RenameWithPrefix(datePrefix);
+            LogCatalogRemoveLocked(oldCsvName);
+            strncpy(finalDataName, newCsvName, sizeof(finalDataName) - 1);
+            finalDataName[sizeof(finalDataName) - 1] = '\0';
+        }
     }
 
+    LogCatalogUpsertLocked(finalDataName, uFinalSize);
+
     m_szBaseName[0] = '\0';
 }
 
@@ -1040,6 +1226,17 @@ void LogSensor::Close()
 // Generate a formatted line of sensor data and send it to the ring queue
 
 void LogSensor::Write()
+{
+    // esp_timer_get_time() returns int64_t but is monotonic-from-boot
+    // (always non-negative); cast to uint64_t is safe and matches the
+    // CSV column type. No rollover at flight timescales (vs micros()
+    // which wraps every ~71 min).
+    Write(static_cast<uint64_t>(esp_timer_get_time()));
+}
+
+// ----------------------------------------------------------------------------
+
+void LogSensor::Write(uint64_t uSampleUs)
 {
     // g_bPause is held by HandleDownload and the bulk-delete handlers,
     // which sit on xWriteMutex for many seconds; pausing the producer
@@ -1056,15 +1253,11 @@ void LogSensor::Write()
         return;
 
     // --- Snapshot sensor state into a LogRow ---
-    // Snapshot both timestamps back-to-back so they refer to the same
-    // sample instant (offset is a few ns). esp_timer_get_time() returns
-    // 64-bit µs since boot — no rollover at flight timescales (vs
-    // micros() which wraps every ~71 min).
-    unsigned long uTimeStamp   = millis();
-    // esp_timer_get_time() returns int64_t but is monotonic-from-boot
-    // (always non-negative); cast to uint64_t is safe and matches the
-    // CSV column type.
-    uint64_t      uTimeStampUs = static_cast<uint64_t>(esp_timer_get_time());
+    // Both timestamps come from the sample instant. millis() is
+    // esp_timer_get_time() / 1000 on the ESP32, so deriving the ms column
+    // keeps it on the same clock as the µs one.
+    const uint64_t uTimeStampUs = uSampleUs;
+    const uint32_t uTimeStamp   = static_cast<uint32_t>(uSampleUs / 1000u);
 
     // Read the AHRS output fields as one coherent frame from the
     // lock-free snapshot (published once per AHRS::Process() iteration).
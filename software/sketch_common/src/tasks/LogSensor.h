@@ -21,6 +21,11 @@ public:
     void Close();
     void Write();
 
+    // Write a row stamped `uSampleUs` (esp_timer µs) instead of now. The
+    // FIFO IMU path writes a batch of samples back to back; each row
+    // carries its own sample time so replay sees ODR-spaced timeStampUs.
+    void Write(uint64_t uSampleUs);
+
     // Snapshot the in-progress metadata accumulator and write it to
     // <basename>.meta atomically (write tmp + rename). Used from Open()
     // for the initial empty sidecar and from LogSensorCommitTask every
@@ -35,12 +40,26 @@ public:
     // Used by the /logs web handler to flag the active row as non-deletable.
     const char* ActiveBaseName() const { return m_szBaseName; }
 
+    // Extension (without the dot) of the row-stream file for the current
+    // session: "csv", or "osl" when g_Config.iLogFormat selected the
+    // binary columnar format at Open().
+    const char* ActiveDataExtension() const { return m_szDataExt; }
+
+    // Current size of the row-stream file, so /api/logs can show the
+    // active row live between the 30 s catalog refreshes. 0 when no file
+    // is open. Caller must hold xWriteMutex.
+    uint64_t ActiveFileSizeLocked() const;
+
     // Data
 private:
     // Base filename WITHOUT extension, e.g. "log_042". Used at Close()
     // to write the sidecar and conditionally rename both files.
     char                         m_szBaseName[16] = {};
 
+    // "csv" or "osl"; fixed at Open() so a mid-session config change
+    // can't mix encodings inside one file.
+    const char*                  m_szDataExt = "csv";
+
     // Accumulates sidecar metadata across the session. Reset in Open(),
     // fed in Write(), finalised in Close().
     onspeed::log::LogMetaBuilder m_metaBuilder;
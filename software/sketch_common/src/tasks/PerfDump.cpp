@@ -29,6 +29,12 @@ std::atomic<bool>     g_streaming{false};
 std::atomic<bool>     g_oneShotPending{false};
 TaskHandle_t          g_taskHandle = nullptr;
 
+// Trace capture deadline in millis(); 0 = no capture pending.
+std::atomic<uint32_t> g_traceDeadlineMs{0};
+// perfEnabled() before StartTrace() turned it on; put back once the
+// window has been printed.
+std::atomic<bool>     g_traceRestoreEnabled{false};
+
 // Permanent consumer instance. Its histograms live in Perf.cpp's
 // file-static arrays, so we just reuse it across calls.
 Consumer g_consumer;
@@ -115,6 +121,63 @@ void emitSnapshot()
     Serial.println(buf);
 }
 
+// One line per event, in completion order. ts/dur are µs from capture
+// start. Names rather than ids so the host converter needs no tables.
+void emitTrace(const TraceWindow& w)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf),
+        "==== PERF TRACE ==== events=%lu dropped=%lu capacity=%u origin_us=%llu",
+        (unsigned long)w.count, (unsigned long)w.dropped,
+        (unsigned)kTraceCapacity, (unsigned long long)w.originUs);
+    Serial.println(buf);
+
+    for (uint32_t i = 0; i < w.count; ++i) {
+        const TraceEvent& ev = w.events[i];
+        const char* task = (ev.taskId < kTaskCount)
+            ? taskName(static_cast<TaskId>(ev.taskId)) : "?";
+        if (ev.flags & kFlagLoop) {
+            std::snprintf(buf, sizeof(buf),
+                "trace ts=%lu dur=%lu core=%u task=%s scope=loop stack_free=%uw",
+                (unsigned long)ev.startUs, (unsigned long)ev.durationUs,
+                (unsigned)ev.coreId, task, (unsigned)ev.stackHighWaterWords);
+        } else {
+            std::snprintf(buf, sizeof(buf),
+                "trace ts=%lu dur=%lu core=%u task=%s scope=%s",
+                (unsigned long)ev.startUs, (unsigned long)ev.durationUs,
+                (unsigned)ev.coreId, task,
+                scopeName(static_cast<ScopeId>(ev.scopeId)));
+        }
+        Serial.println(buf);
+        // Yield every few hundred lines so a full window (4096 lines)
+        // doesn't hold Core 0 for the whole print.
+        if ((i & 0xFF) == 0xFF) vTaskDelay(1);
+    }
+    Serial.println(F("==== PERF TRACE END ===="));
+}
+
+void serviceTrace()
+{
+    const uint32_t deadline = g_traceDeadlineMs.load(std::memory_order_acquire);
+    if (deadline == 0) return;
+    if (traceCaptureArmed() &&
+        static_cast<int32_t>(millis() - deadline) >= 0) {
+        stopTraceCapture();
+    }
+    TraceWindow w;
+    if (traceWindowReady(w)) {
+        emitTrace(w);
+        releaseTraceWindow();
+        g_traceDeadlineMs.store(0, std::memory_order_release);
+        // Streaming may have been switched on meanwhile; it owns the
+        // enable flag then.
+        if (!g_traceRestoreEnabled.load(std::memory_order_acquire) &&
+            !g_streaming.load(std::memory_order_acquire)) {
+            setPerfEnabled(false);
+        }
+    }
+}
+
 void DumpTask(void* /*pv*/)
 {
     TickType_t xLastWakeTime = xTaskGetTickCount();
@@ -134,6 +197,8 @@ void DumpTask(void* /*pv*/)
             emitSnapshot();
         }
 
+        serviceTrace();
+
         // Reset histograms for the next interval.
         g_consumer.reset();
     }
@@ -189,6 +254,29 @@ bool IsStreaming()
     return g_streaming.load(std::memory_order_acquire);
 }
 
+bool StartTrace(uint32_t maxDurationMs)
+{
+    // Events only flow while the registry is enabled; serviceTrace()
+    // restores the previous state after printing the window.
+    const bool wasEnabled = perfEnabled();
+    setPerfEnabled(true);
+    StartTask();
+    if (!startTraceCapture()) {
+        if (!wasEnabled) setPerfEnabled(false);
+        return false;
+    }
+    g_traceRestoreEnabled.store(wasEnabled, std::memory_order_release);
+    uint32_t deadline = millis() + maxDurationMs;
+    if (deadline == 0) deadline = 1;   // 0 means "no capture pending"
+    g_traceDeadlineMs.store(deadline, std::memory_order_release);
+    return true;
+}
+
+void StopTrace()
+{
+    stopTraceCapture();
+}
+
 void EmitOneShot()
 {
     // Ensure registry is collecting; one-shot only makes sense if
@@ -1,5 +1,6 @@
 // PerfDump.h — 1 Hz task that drains the Perf rings and emits a
-// human-readable summary to USB serial.
+// human-readable summary to USB serial. Also prints trace-capture
+// windows.
 //
 // Only built when ONSPEED_PERF_ENABLED is defined. The console
 // command `perf on|off|dump` calls the symbols below.
@@ -27,6 +28,16 @@ void EmitOneShot();
 void SetStreaming(bool on);
 bool IsStreaming();
 
+// Arm a trace capture (see util/Perf.h). It ends when the window fills
+// or `maxDurationMs` elapses, whichever comes first; the dump task then
+// prints the events between "==== PERF TRACE ====" markers for
+// tools/perf-report/perf_trace.py. Perf collection is switched on for
+// the capture and back off afterwards if it was off before. Returns
+// false if a previous capture has not been printed yet.
+bool StartTrace(uint32_t maxDurationMs);
+// End the current capture early; it is printed on the next dump tick.
+void StopTrace();
+
 }  // namespace onspeed::perf_dump
 
 #endif  // ONSPEED_PERF_ENABLED
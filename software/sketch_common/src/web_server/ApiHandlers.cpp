@@ -34,14 +34,21 @@
 #include "src/ahrs/AhrsSnapshot.h"
 #include "src/ahrs/FlapSnapshot.h"
 #include "src/ahrs/SensorSnapshot.h"
+#include "src/tasks/LogCatalogStore.h"
+#include "src/web_server/CalwizRecorder.h"
 
+#include <api/CalwizFitJson.h>
 #include <api/CalwizSave.h>
+#include <api/HttpRange.h>
 #include <util/OnSpeedTypes.h>
 #include <api/CalwizSaveParse.h>
 #include <api/CalwizStateJson.h>
 #include <api/SensorBiasesJson.h>
+#include <log/LogCatalog.h>
 #include <log/LogMeta.h>
-#include <log/LogMetaFile.h>
+#include <log/LogPreview.h>
+#include <proto/LogBin.h>
+#include <proto/LogCsv.h>
 
 extern WebServer CfgServer;
 
@@ -131,9 +138,17 @@ bool IsSafeLogFilename(const String& s) {
     return true;
 }
 
-// The active log session writes three paired files: <base>.csv (the row
-// stream), <base>.dbg (PERF + warning/error log from the writer task),
-// and <base>.meta (column schema + cadence JSON). Deleting any of them
+// Case-insensitive extension test (".csv", ".osl"); FAT names are
+// case-insensitive, as IsActiveLogFile and LogCatalogNameEquals treat them.
+bool HasLogExtension(const String& s, const char* szExt) {
+    const size_t uExt = strlen(szExt);
+    return s.length() > uExt && s.substring(s.length() - uExt).equalsIgnoreCase(szExt);
+}
+
+// The active log session writes three paired files: <base>.csv or
+// <base>.osl (the row stream, CSV or binary per LOGFORMAT), <base>.dbg
+// (PERF + warning/error log from the writer task), and <base>.meta
+// (column schema + cadence JSON). Deleting any of them
 // while LogSensor still has the session open orphans the matching file
 // handles and silently loses the forensic record paired with the CSV.
 // The .dbg in particular is the only post-flight signal for ring drops,
@@ -144,47 +159,11 @@ bool IsActiveLogFile(const String& sFilename) {
     if (!szActiveBase || szActiveBase[0] == '\0') return false;
     const String sBase = String(szActiveBase);
     return sFilename.equalsIgnoreCase(sBase + ".csv")
+        || sFilename.equalsIgnoreCase(sBase + ".osl")
         || sFilename.equalsIgnoreCase(sBase + ".dbg")
         || sFilename.equalsIgnoreCase(sBase + ".meta");
 }
 
-bool TryReadLogMeta(const char* sCsvName, ::onspeed::log::LogMeta* out) {
-    char sMeta[32];
-    // Maximum input length that snprintf can safely transform into a
-    // ".meta" name within sMeta. Worst case: dot at the last position
-    // of sCsvName (e.g. a name ending in "."), so dotIdx == len - 1.
-    // snprintf writes ".meta\0" (6 bytes including NUL) starting at
-    // dotIdx, which must fit: dotIdx + 6 <= sizeof(sMeta), i.e.
-    // len <= sizeof(sMeta) - 5. Pinning the bound to the buffer size
-    // (not a magic 27) closes the bulldog #583 finding — bump sMeta and
-    // the cap follows.
-    //
-    // sizeof(".meta") == 6 (5 chars + NUL), so:
-    //   kMaxCsvNameLen = sizeof(sMeta) - sizeof(".meta") + 1
-    //                  = 32 - 6 + 1 = 27.
-    constexpr size_t kMaxCsvNameLen = sizeof(sMeta) - sizeof(".meta") + 1;
-    static_assert(kMaxCsvNameLen == 27,
-                  "kMaxCsvNameLen drifted; bump sMeta if real log names grow");
-    size_t len = std::strlen(sCsvName);
-    if (len < 5 || len > kMaxCsvNameLen) return false;
-    std::memcpy(sMeta, sCsvName, len);
-    sMeta[len] = '\0';
-    const char* dot = std::strrchr(sMeta, '.');
-    if (!dot) return false;
-    size_t dotIdx = static_cast<size_t>(dot - sMeta);
-    std::snprintf(sMeta + dotIdx, sizeof(sMeta) - dotIdx, ".meta");
-
-    FsFile f = g_SdFileSys.open(sMeta, O_RDONLY);
-    if (!f.isOpen()) return false;
-
-    char buf[512];
-    int n = f.read(buf, sizeof(buf) - 1);
-    f.close();
-    if (n <= 0) return false;
-    buf[n] = '\0';
-    return ::onspeed::log::ParseMetaFile(std::string_view(buf, static_cast<size_t>(n)), out);
-}
-
 // JSON-escape a small subset.  Filenames are constrained by
 // IsSafeLogFilename to characters that need no escaping; the meta
 // firmware/SHA strings are ASCII-safe.  Belt-and-suspenders:
@@ -611,21 +590,15 @@ void HandleApiLogs() {
     // ~10-25 ms CSV gaps. Download / bulk-delete handlers keep their
     // guards (multi-second mutex holds would overflow the ring).
 
-    SdFileSys::SuFileInfoList suFileList;
+    // ?rescan=1 forces a directory walk, for when the card was edited
+    // behind the firmware's back mid-boot.
+    const bool bRescan = CfgServer.hasArg("rescan") && CfgServer.arg("rescan") == "1";
+
+    ::onspeed::log::LogCatalog catalog;
     String sActiveCsvName;
     bool   bListStatus  = false;
     uint64_t uTotalSize = 0;
 
-    struct Entry {
-        String   sName;
-        uint64_t uSize = 0;
-        bool     bHaveMeta = false;
-        bool     bHaveDbg  = false;
-        ::onspeed::log::LogMeta meta;
-    };
-    std::vector<Entry> entries;
-    entries.reserve(32);
-
     // Parsed coredump fields, surfaced as a separate JSON array so the
     // UI can render a Diagnostics section distinct from the flight list.
     struct CoredumpEntry {
@@ -648,55 +621,39 @@ void HandleApiLogs() {
         const char* szActiveBase = g_LogSensor.ActiveBaseName();
         if (szActiveBase && szActiveBase[0] != '\0') {
             sActiveCsvName  = szActiveBase;
-            sActiveCsvName += ".csv";
+            sActiveCsvName += ".";
+            sActiveCsvName += g_LogSensor.ActiveDataExtension();
         }
-        bListStatus = g_SdFileSys.FileList(&suFileList);
-        if (bListStatus) {
-            // Pass 1: collect sidecar base names so each surviving entry
-            // can declare hasMeta/hasDbg without re-scanning.
-            std::vector<String> metaNames, dbgNames;
-            metaNames.reserve(suFileList.size());
-            dbgNames.reserve(suFileList.size());
-            for (size_t i = 0; i < suFileList.size(); ++i) {
-                const char* name = suFileList[i].szFileName;
-                size_t nlen = strlen(name);
-                if (nlen >= 5 && strcasecmp(name + nlen - 5, ".meta") == 0)
-                    metaNames.emplace_back(name);
-                else if (nlen >= 4 && strcasecmp(name + nlen - 4, ".dbg") == 0)
-                    dbgNames.emplace_back(name);
+        // Normal path: replay the catalog journal (one sequential read;
+        // see LogCatalogStore.h). The first listing of each boot, a
+        // missing or unreadable journal, or ?rescan=1 falls back to the
+        // directory walk and rebuilds the journal from it.
+        if (!bRescan && LogCatalogVerifiedThisBoot() && LogCatalogLoadLocked(&catalog)) {
+            bListStatus = true;
+            if (catalog.NeedsCompaction())
+                LogCatalogSaveLocked(catalog);
+        } else {
+            SdFileSys::SuFileInfoList suFileList;
+            bListStatus = g_SdFileSys.FileList(&suFileList);
+            if (bListStatus) {
+                LogCatalogLoadLocked(&catalog);
+                LogCatalogReconcileLocked(suFileList, &catalog);
             }
-            // Pass 2: emit non-sidecar entries. Sidecars (.meta, .dbg,
-            // .meta.tmp) belong to their parent CSV and are surfaced via
-            // hasMeta/hasDbg flags + paired download links in the UI;
-            // they never appear as standalone rows.
-            for (size_t i = 0; i < suFileList.size(); ++i) {
-                const char* name = suFileList[i].szFileName;
-                size_t nlen = strlen(name);
-                if (nlen >= 5 && strcasecmp(name + nlen - 5, ".meta") == 0)
-                    continue;
-                if (nlen >= 9 && strcasecmp(name + nlen - 9, ".meta.tmp") == 0)
-                    continue;
-                if (nlen >= 4 && strcasecmp(name + nlen - 4, ".dbg") == 0)
-                    continue;
-
-                Entry e;
-                e.sName = name;
-                e.uSize = suFileList[i].uFileSize;
-                String sBase = e.sName;
-                int iDot = sBase.lastIndexOf('.');
-                if (iDot > 0) sBase = sBase.substring(0, iDot);
-                String sExpectedMeta = sBase + ".meta";
-                String sExpectedDbg  = sBase + ".dbg";
-                for (const String& mn : metaNames)
-                    if (mn.equalsIgnoreCase(sExpectedMeta)) { e.bHaveMeta = true; break; }
-                for (const String& dn : dbgNames)
-                    if (dn.equalsIgnoreCase(sExpectedDbg))  { e.bHaveDbg  = true; break; }
-                if (e.bHaveMeta)
-                    e.bHaveMeta = TryReadLogMeta(name, &e.meta);
-
-                uTotalSize += e.uSize;
-                entries.push_back(std::move(e));
+        }
+        if (bListStatus) {
+            // The journal carries the active log's size as of its last
+            // 30 s sidecar refresh; report what has been written so far.
+            if (sActiveCsvName.length() > 0) {
+                const ::onspeed::log::LogCatalogEntry* pActive =
+                    catalog.Find(sActiveCsvName.c_str());
+                if (pActive != nullptr) {
+                    ::onspeed::log::LogCatalogEntry e = *pActive;
+                    e.size = g_LogSensor.ActiveFileSizeLocked();
+                    catalog.Upsert(e);
+                }
             }
+            for (const auto& e : catalog.Entries())
+                uTotalSize += e.size;
 
             // Enumerate /coredumps/. Empty (or absent) directory yields
             // an empty array, which the UI renders as "No crash dumps."
@@ -754,7 +711,7 @@ void HandleApiLogs() {
     // Estimate up front to avoid 3-4 String reallocations during assembly:
     // each flight entry runs ~300 bytes (size + meta block); each coredump
     // ~160 bytes. Wrong estimate just costs a single resize at the end.
-    body.reserve(64 + entries.size() * 300 + coredumps.size() * 160);
+    body.reserve(64 + catalog.Entries().size() * 300 + coredumps.size() * 160);
     body += F("{\"activeLog\":\"");
     body += JsonEscape(sActiveCsvName.c_str());
     body += F("\",\"totalSize\":");
@@ -762,18 +719,18 @@ void HandleApiLogs() {
     body += F(",\"files\":[");
 
     bool first = true;
-    for (const Entry& e : entries) {
+    for (const ::onspeed::log::LogCatalogEntry& e : catalog.Entries()) {
         if (!first) body += ',';
         first = false;
         body += F("{\"name\":\"");
-        body += JsonEscape(e.sName.c_str());
+        body += JsonEscape(e.name);
         body += F("\",\"size\":");
-        body += JsonInt(static_cast<long>(e.uSize));
+        body += JsonInt(static_cast<long>(e.size));
         body += F(",\"hasMeta\":");
-        body += e.bHaveMeta ? F("true") : F("false");
+        body += e.hasMeta ? F("true") : F("false");
         body += F(",\"hasDbg\":");
-        body += e.bHaveDbg ? F("true") : F("false");
-        if (e.bHaveMeta) {
+        body += e.hasDbg ? F("true") : F("false");
+        if (e.hasMeta) {
             body += F(",\"meta\":{");
             body += F("\"durationMs\":");
             body += JsonInt(static_cast<long>(e.meta.durationMs));
@@ -894,16 +851,19 @@ void HandleApiLogsDeleteBulk() {
                 continue;
             }
             g_SdFileSys.remove(f.c_str());
-            // Paired sidecars (.meta schema, .dbg writer log) share the
-            // base name. Remove unconditionally — SdFat's remove() on a
-            // missing file is a near no-op.
+            LogCatalogRemoveLocked(f.c_str());
+            // Paired sidecars (.meta schema, .dbg writer log, .pvw
+            // preview cache) share the base name. Remove unconditionally
+            // — SdFat's remove() on a missing file is a near no-op.
             int iDot = f.lastIndexOf('.');
             if (iDot > 0) {
                 String sBase = f.substring(0, iDot);
                 String sMeta = sBase + ".meta";
                 String sDbg  = sBase + ".dbg";
+                String sPvw  = sBase + ::onspeed::log::kPreviewSidecarExt;
                 g_SdFileSys.remove(sMeta.c_str());
                 g_SdFileSys.remove(sDbg.c_str());
+                g_SdFileSys.remove(sPvw.c_str());
             }
             xSemaphoreGive(xWriteMutex);
             appendItem(deleted, firstDeleted, f);
@@ -923,6 +883,340 @@ void HandleApiLogsDeleteBulk() {
     SendJson(200, response);
 }
 
+// ============================================================================
+// Log preview
+// ============================================================================
+
+namespace {
+
+// SD read size for the preview pass. Large enough that SdFat issues
+// multi-sector reads (the pass is SD-bound), small enough that each
+// xWriteMutex hold stays a few ms so the log writer interleaves.
+constexpr size_t kPreviewReadChunk = 8192;
+
+// JSON staging; flushed to the client (and the sidecar) when nearly full.
+constexpr size_t kPreviewStageSize = 2048;
+
+String PreviewSidecarPath(const String& sName) {
+    const int iDot = sName.lastIndexOf('.');
+    return "/" + (iDot > 0 ? sName.substring(0, iDot) : sName)
+         + ::onspeed::log::kPreviewSidecarExt;
+}
+
+// Stream an already-validated sidecar body (file positioned just past
+// its identity line) with a known Content-Length.
+void SendPreviewSidecar(FsFile& pvw, uint64_t uLen) {
+    CfgServer.sendHeader("Cache-Control", "no-store");
+    CfgServer.setContentLength(static_cast<size_t>(uLen));
+    CfgServer.sendHeader("Content-Type", "application/json");
+    CfgServer.send(200);
+
+    char buf[1460];
+    while (uLen > 0) {
+        const size_t uWant = (uLen < sizeof(buf)) ? static_cast<size_t>(uLen) : sizeof(buf);
+        int n = 0;
+        if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+            n = pvw.read(buf, uWant);
+            xSemaphoreGive(xWriteMutex);
+        }
+        if (n <= 0 || !CfgServer.client().connected())
+            break;
+        CfgServer.sendContent(buf, static_cast<size_t>(n));
+        uLen -= static_cast<uint64_t>(n);
+    }
+}
+
+// One sequential pass over `file` (uSize bytes) into `preview`. Returns
+// false when the header isn't an OnSpeed CSV header.
+bool ScanLogForPreview(FsFile& file, uint64_t uSize, ::onspeed::log::LogPreviewBuilder& preview) {
+    // Room for one read plus the partial line carried over from the last.
+    const size_t uBufSize = kPreviewReadChunk + ::onspeed::proto::log_csv::kRowMaxBytes;
+    char* pBuf = static_cast<char*>(malloc(uBufSize));
+    if (!pBuf) return false;
+
+    uint64_t uBase   = 0;      // file offset of pBuf[0]
+    size_t   uUsed   = 0;
+    bool     bHeader = false;
+    bool     bOk     = true;
+    while (bOk && uBase + uUsed < uSize) {
+        const uint64_t uLeft = uSize - (uBase + uUsed);
+        const size_t   uWant = (uLeft < kPreviewReadChunk) ? static_cast<size_t>(uLeft) : kPreviewReadChunk;
+        int n = 0;
+        if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+            n = file.read(pBuf + uUsed, uWant);
+            xSemaphoreGive(xWriteMutex);
+        } else {
+            if (!CfgServer.client().connected()) { bOk = false; break; }
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        if (n <= 0) break;
+        uUsed += static_cast<size_t>(n);
+
+        size_t uStart = 0;
+        for (;;) {
+            const char* pNl = static_cast<const char*>(memchr(pBuf + uStart, '\n', uUsed - uStart));
+            if (!pNl) break;
+            const size_t uEnd = static_cast<size_t>(pNl - pBuf) + 1;
+            const std::string_view line(pBuf + uStart, uEnd - uStart);
+            if (!bHeader) {
+                bHeader = true;
+                if (!preview.Begin(line)) { bOk = false; break; }
+            } else {
+                preview.OnLine(line, uBase + uStart);
+            }
+            uStart = uEnd;
+        }
+        memmove(pBuf, pBuf + uStart, uUsed - uStart);
+        uBase += uStart;
+        uUsed -= uStart;
+        // A "line" longer than any row is not one; drop it.
+        if (uUsed >= ::onspeed::proto::log_csv::kRowMaxBytes) {
+            uBase += uUsed;
+            uUsed  = 0;
+        }
+        // Yield so WiFi/core-0 stay responsive during a long pass.
+        delay(0);
+    }
+    // Final line without '\n' (the active log's row in progress parses
+    // short and is skipped).
+    if (bOk && bHeader && uUsed > 0)
+        preview.OnLine(std::string_view(pBuf, uUsed), uBase);
+
+    free(pBuf);
+    return bOk && bHeader;
+}
+
+// Same pass over a binary .osl log (proto/LogBin.h), decoding whole
+// blocks as they arrive. Returns false when the file header isn't an
+// OnSpeed .osl header. A truncated final block (the active log's block
+// in progress, or a power-yank) ends the pass like EOF; a corrupt block
+// header ends it early with the rows before it.
+bool ScanOslForPreview(FsFile& file, uint64_t uSize, ::onspeed::log::LogPreviewBuilder& preview) {
+    namespace bin = ::onspeed::proto::log_bin;
+    // Room for one read plus a partial block carried over from the last.
+    const size_t uBufSize = kPreviewReadChunk + bin::kMaxBlockBytes;
+    uint8_t* pBuf = static_cast<uint8_t*>(malloc(uBufSize));
+    if (!pBuf) return false;
+
+    uint64_t uBase   = 0;      // file offset of pBuf[0]
+    size_t   uUsed   = 0;
+    bool     bHeader = false;
+    bool     bOk     = true;
+    while (bOk && uBase + uUsed < uSize) {
+        const uint64_t uLeft = uSize - (uBase + uUsed);
+        const size_t   uWant = (uLeft < kPreviewReadChunk) ? static_cast<size_t>(uLeft) : kPreviewReadChunk;
+        int n = 0;
+        if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+            n = file.read(pBuf + uUsed, uWant);
+            xSemaphoreGive(xWriteMutex);
+        } else {
+            if (!CfgServer.client().connected()) { bOk = false; break; }
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        if (n <= 0) break;
+        uUsed += static_cast<size_t>(n);
+
+        size_t uStart = 0;
+        if (!bHeader) {
+            if (uUsed < bin::kFileHeaderBytes) continue;
+            bin::FileInfo info;
+            if (!bin::ReadFileHeader(pBuf, uUsed, info)) { bOk = false; break; }
+            bHeader = true;
+            preview.BeginRows();
+            uStart = bin::kFileHeaderBytes;
+        }
+        bin::BlockStatus status = bin::BlockStatus::Ok;
+        uStart += ::onspeed::log::FeedOslBlocks(preview, pBuf + uStart, uUsed - uStart,
+                                                uBase + uStart, status);
+        memmove(pBuf, pBuf + uStart, uUsed - uStart);
+        uBase += uStart;
+        uUsed -= uStart;
+        if (status != bin::BlockStatus::Truncated) {
+            g_Log.printf(MsgLog::EnWebServer, MsgLog::EnWarning,
+                         "/api/logs/preview: block decode stopped at offset %llu (status %d)\n",
+                         (unsigned long long)uBase, (int)status);
+            break;
+        }
+        // Yield so WiFi/core-0 stay responsive during a long pass.
+        delay(0);
+    }
+
+    free(pBuf);
+    return bOk && bHeader;
+}
+
+}  // namespace
+
+// GET /api/logs/preview?file=<log.csv|log.osl>[&points=N]
+//
+// Min/max-decimated IAS/AOA/Palt/VerticalG/flapsPos summary for plotting
+// a flight without downloading it (shape in onspeed_core
+// log/LogPreview.h). Computed in one sequential pass over the log — CSV
+// lines, or .osl blocks decoded through proto/LogBin.h — and
+// cached as <base>.pvw keyed on the log's download ETag and the point
+// count, so repeat views of a closed log are a single small read. The
+// active log is never cached — it changes under every request.
+//
+// No PauseGuard: the pass takes xWriteMutex per 8 KB read, so the writer
+// gets the card between reads, the same way /api/logs coexists with it.
+void HandleApiLogsPreview() {
+    const String sName = CfgServer.arg("file");
+    const bool bOsl = HasLogExtension(sName, ".osl");
+    if (!IsSafeLogFilename(sName) || !(bOsl || HasLogExtension(sName, ".csv"))) {
+        SendError(400, "file", "expected a .csv or .osl log file name");
+        return;
+    }
+    const size_t uPoints = ::onspeed::log::ClampPreviewPoints(
+        CfgServer.hasArg("points") ? CfgServer.arg("points").toInt() : 0);
+    const String sPath    = "/" + sName;
+    const String sSidecar = PreviewSidecarPath(sName);
+
+    FsFile   file;
+    FsFile   pvw;
+    uint64_t uSize      = 0;
+    uint64_t uCachedLen = 0;
+    bool     bActive    = false;
+    char     szETag[32] = "";
+    if (!xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+        CfgServer.sendHeader("Retry-After", "1");
+        SendError(503, "logs", "SD busy, retry shortly");
+        return;
+    }
+    file = g_SdFileSys.open(sPath.c_str(), O_RDONLY);
+    if (file) {
+        uSize   = file.size();
+        bActive = IsActiveLogFile(sName);
+        ::onspeed::log::LogCatalogEntry entry;
+        LogCatalogReadEntryLocked(sName.c_str(), uSize, &entry);
+        FormatDownloadETag(sName.c_str(), uSize, entry.hasMeta ? &entry.meta : nullptr,
+                           szETag, sizeof(szETag));
+        if (!bActive) {
+            pvw = g_SdFileSys.open(sSidecar.c_str(), O_RDONLY);
+            if (pvw) {
+                char szHead[::onspeed::log::kPreviewSidecarHeaderMaxLen];
+                const int n = pvw.read(szHead, sizeof(szHead));
+                const size_t uBody = (n > 0)
+                    ? ::onspeed::log::MatchPreviewSidecarHeader(
+                          std::string_view(szHead, static_cast<size_t>(n)), szETag, uPoints)
+                    : 0;
+                if (uBody > 0 && pvw.seekSet(uBody)) {
+                    uCachedLen = pvw.size() - uBody;
+                } else {
+                    pvw.close();
+                }
+            }
+        }
+    }
+    xSemaphoreGive(xWriteMutex);
+
+    if (!file) {
+        SendError(404, "file", "no such log");
+        return;
+    }
+
+    auto closeLocked = [](FsFile& f) {
+        if (!f) return;
+        if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(5000))) {
+            f.close();
+            xSemaphoreGive(xWriteMutex);
+        } else {
+            g_Log.println(MsgLog::EnWebServer, MsgLog::EnError,
+                          "/api/logs/preview close: xWriteMutex timeout; fd may leak");
+        }
+    };
+
+    if (uCachedLen > 0) {
+        closeLocked(file);
+        SendPreviewSidecar(pvw, uCachedLen);
+        closeLocked(pvw);
+        return;
+    }
+
+    const uint32_t uStartMs = millis();
+    ::onspeed::log::LogPreviewBuilder preview(uPoints, uSize);
+    const bool bScanned = bOsl ? ScanOslForPreview(file, uSize, preview)
+                               : ScanLogForPreview(file, uSize, preview);
+    closeLocked(file);
+    if (!bScanned) {
+        SendError(422, "file", bOsl ? "not an OnSpeed binary log" : "not an OnSpeed CSV log");
+        return;
+    }
+
+    // Sidecar write: body first behind a placeholder identity line, then
+    // the real line over it at the end, so a pass cut short (client gone,
+    // power pulled) leaves a file that never matches.
+    char   szIdent[::onspeed::log::kPreviewSidecarHeaderMaxLen];
+    const size_t uIdentLen = ::onspeed::log::FormatPreviewSidecarHeader(
+        szETag, uPoints, szIdent, sizeof(szIdent));
+    if (!bActive && uIdentLen > 0 && xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+        pvw = g_SdFileSys.open(sSidecar.c_str(), O_RDWR | O_CREAT | O_TRUNC);
+        if (pvw) {
+            char szBlank[sizeof(szIdent)];
+            memset(szBlank, '#', uIdentLen - 1);
+            szBlank[uIdentLen - 1] = '\n';
+            if (pvw.write(szBlank, uIdentLen) != uIdentLen)
+                pvw.close();
+        }
+        xSemaphoreGive(xWriteMutex);
+    }
+    bool bSidecarOk = static_cast<bool>(pvw);
+
+    CfgServer.sendHeader("Cache-Control", "no-store");
+    CfgServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    CfgServer.sendHeader("Content-Type", "application/json");
+    CfgServer.send(200);
+
+    char   szStage[kPreviewStageSize];
+    size_t uStaged = 0;
+    auto flush = [&]() {
+        if (uStaged == 0) return;
+        CfgServer.sendContent(szStage, uStaged);
+        if (bSidecarOk && xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000))) {
+            bSidecarOk = (pvw.write(szStage, uStaged) == uStaged);
+            xSemaphoreGive(xWriteMutex);
+        } else {
+            bSidecarOk = false;
+        }
+        uStaged = 0;
+    };
+
+    uStaged = ::onspeed::log::FormatPreviewJsonHead(sName.c_str(), preview, szStage, sizeof(szStage));
+    bool bFirst = true;
+    for (const ::onspeed::log::PreviewBucket& b : preview.Buckets()) {
+        if (sizeof(szStage) - uStaged < ::onspeed::log::kPreviewJsonBucketMaxLen)
+            flush();
+        const size_t n = ::onspeed::log::FormatPreviewJsonBucket(
+            b, bFirst, szStage + uStaged, sizeof(szStage) - uStaged);
+        if (n > 0) bFirst = false;
+        uStaged += n;
+    }
+    if (sizeof(szStage) - uStaged < 8)
+        flush();
+    uStaged += ::onspeed::log::FormatPreviewJsonTail(szStage + uStaged, sizeof(szStage) - uStaged);
+    flush();
+    // Empty sendContent emits the chunked terminator.
+    CfgServer.sendContent("");
+
+    if (pvw && xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(5000))) {
+        if (bSidecarOk && CfgServer.client().connected()) {
+            bSidecarOk = pvw.seekSet(0) && pvw.write(szIdent, uIdentLen) == uIdentLen;
+            pvw.sync();
+        }
+        pvw.close();
+        if (!bSidecarOk)
+            g_SdFileSys.remove(sSidecar.c_str());
+        xSemaphoreGive(xWriteMutex);
+    }
+
+    g_Log.printf(MsgLog::EnWebServer, MsgLog::EnDebug,
+                 "/api/logs/preview %s: %lu rows (%lu skipped) -> %u points in %lu ms\n",
+                 sName.c_str(),
+                 (unsigned long)preview.Rows(), (unsigned long)preview.SkippedRows(),
+                 (unsigned)uPoints, (unsigned long)(millis() - uStartMs));
+}
+
 // ============================================================================
 // Triggers
 // ============================================================================
@@ -1047,6 +1341,38 @@ void HandleApiCalwizState() {
     SendJson(200, String(json.c_str()));
 }
 
+// ============================================================================
+// Cal wizard decel-run recording
+// ============================================================================
+//
+// The run is fitted on the firmware as it is flown (CalwizRecorder.cpp);
+// all three endpoints answer with the fit so far.
+
+namespace {
+
+void SendCalwizFit() {
+    ::onspeed::aoa::DecelRunResult fit;
+    const bool recording = CalwizRecordResult(fit);
+    std::string json = ::onspeed::api::SerializeCalwizFit(fit, recording);
+    SendJson(200, String(json.c_str()));
+}
+
+}  // namespace
+
+void HandleApiCalwizRecordStart() {
+    CalwizRecordStart();
+    SendCalwizFit();
+}
+
+void HandleApiCalwizRecordStop() {
+    CalwizRecordStop();
+    SendCalwizFit();
+}
+
+void HandleApiCalwizFit() {
+    SendCalwizFit();
+}
+
 // ============================================================================
 // Cal wizard save (write side).
 // ============================================================================
@@ -76,6 +76,10 @@ void HandleApiVnoChimeTest();
 void HandleApiLogs();
 void HandleApiLogsDeleteBulk();
 
+// Min/max-decimated preview of one CSV or .osl log for plotting, cached as a
+// <base>.pvw sidecar (see onspeed_core log/LogPreview.h).
+void HandleApiLogsPreview();
+
 // Trigger endpoints.  HandleApiFormat returns immediately with a
 // taskId; the format itself runs on the same SD-write path the
 // legacy /format handler uses.  HandleApiFormatStatus returns the
@@ -95,6 +99,13 @@ void HandleApiReboot();
 void HandleApiCalwizState();
 void HandleApiCalwizSave();
 
+// Cal wizard decel run.  Start resets and arms the firmware-side fit
+// (CalwizRecorder.h), stop disarms it, and all three return the fit so
+// far as the CalwizFitJson document.
+void HandleApiCalwizRecordStart();
+void HandleApiCalwizRecordStop();
+void HandleApiCalwizFit();
+
 // Sensor calibration snapshot.  Backs the Preact /sensorconfig page.
 // Returns current bias values, live IMU + AHRS pitch/roll, and EFIS
 // source metadata so the page knows whether to seed PAlt from the EFIS
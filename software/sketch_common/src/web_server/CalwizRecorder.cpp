@@ -0,0 +1,76 @@
+// CalwizRecorder.cpp — the calibration wizard's decel-run recording.
+
+#include "CalwizRecorder.h"
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <atomic>
+#include <cmath>
+
+using onspeed::aoa::DecelRunFit;
+using onspeed::aoa::DecelRunResult;
+using onspeed::aoa::DecelRunSample;
+using onspeed::proto::LiveDataFrame;
+
+namespace {
+
+DecelRunFit       g_CalwizFit;
+std::atomic<bool> g_bCalwizRecording{false};
+
+// Static storage so the mutex exists before any task runs (same pattern
+// as ApiHandlers.cpp's g_FormatJobMutex).
+StaticSemaphore_t g_CalwizFitMutexBuf;
+SemaphoreHandle_t g_CalwizFitMutex = xSemaphoreCreateMutexStatic(&g_CalwizFitMutexBuf);
+
+// Held for one Add() or one Result(), a few microseconds either way.
+constexpr TickType_t kMutexWait = pdMS_TO_TICKS(50);
+
+}  // namespace
+
+void CalwizRecordStart() {
+    if (xSemaphoreTake(g_CalwizFitMutex, kMutexWait) != pdTRUE)
+        return;
+    g_CalwizFit.Reset();
+    g_bCalwizRecording = true;
+    xSemaphoreGive(g_CalwizFitMutex);
+}
+
+void CalwizRecordStop() {
+    g_bCalwizRecording = false;
+}
+
+void CalwizRecordFeed(const LiveDataFrame & frame) {
+    if (!g_bCalwizRecording)
+        return;
+
+    // The wizard recorded a frame when its AOA was a number above -20
+    // (null when air data is invalid).
+    if (!std::isfinite(frame.aoaDeg) || !(frame.aoaDeg > -20.0f))
+        return;
+
+    DecelRunSample s;
+    s.iasKt         = frame.iasKt;
+    s.coeffP        = frame.coeffP;
+    s.derivedAoaDeg = std::isfinite(frame.derivedAoaDeg) ? frame.derivedAoaDeg : 0.0f;
+    s.flapsPosDeg   = frame.flapsPos;
+    s.flapIndex     = frame.flapIndex;
+
+    if (xSemaphoreTake(g_CalwizFitMutex, kMutexWait) != pdTRUE)
+        return;
+    if (g_bCalwizRecording)
+        g_CalwizFit.Add(s);
+    xSemaphoreGive(g_CalwizFitMutex);
+}
+
+bool CalwizRecordResult(DecelRunResult & fit) {
+    const bool bRecording = g_bCalwizRecording;
+    if (xSemaphoreTake(g_CalwizFitMutex, kMutexWait) != pdTRUE) {
+        fit = DecelRunResult{};
+        return bRecording;
+    }
+    fit = g_CalwizFit.Result();
+    xSemaphoreGive(g_CalwizFitMutex);
+    return bRecording;
+}
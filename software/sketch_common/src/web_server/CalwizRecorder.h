@@ -0,0 +1,29 @@
+// CalwizRecorder.h — the calibration wizard's decel-run recording.
+//
+// While the wizard records a run, DataServerPoll() feeds every live-data
+// frame it builds (the 20 Hz frames the wizard's own WebSocket sees)
+// into an onspeed::aoa::DecelRunFit.  The calwiz API arms, stops and
+// reads it (POST /api/calwiz/record, POST /api/calwiz/record/stop,
+// GET /api/calwiz/fit), so the wizard page gets the fit coefficients
+// from the firmware instead of fitting recorded samples itself.
+//
+// Feed runs on the DataServer task and the API handlers on the web
+// server task; a mutex serialises them.
+
+#pragma once
+
+#include <aoa/DecelRunFit.h>
+#include <proto/LiveDataBin.h>
+
+// Reset the fit and start feeding it.
+void CalwizRecordStart();
+
+// Stop feeding; the fit is kept until the next start.
+void CalwizRecordStop();
+
+// Fold one live-data frame into the fit when recording.  Frames without
+// valid air data are skipped, as the wizard skipped them.
+void CalwizRecordFeed(const onspeed::proto::LiveDataFrame & frame);
+
+// The fit so far; returns whether a run is being recorded.
+bool CalwizRecordResult(onspeed::aoa::DecelRunResult & fit);
@@ -11,8 +11,10 @@
 #include <cstring>
 #include <vector>
 
+#include <api/HttpRange.h>
 #include <log/LogMeta.h>
 #include <log/LogMetaFile.h>
+#include <log/LogPreview.h>
 
 #include <Arduino.h>
 #include <buildinfo.h>
@@ -42,6 +44,7 @@ extern "C" {
 #include "src/ahrs/FlapSnapshot.h"
 
 #include "src/web_server/ApiHandlers.h"
+#include "src/tasks/LogCatalogStore.h"
 
 using onspeed::accelPitch;
 using onspeed::accelRoll;
@@ -178,7 +181,7 @@ static bool IsSafeCoredumpBasename(const String& s)
     }
 
 // Returns true if `sFilename` is part of the currently-active log
-// session — the .csv row stream, the paired .dbg writer log, or the
+// session — the .csv (or binary .osl) row stream, the paired .dbg writer log, or the
 // .meta schema sidecar. Deleting any of the three while LogSensor still
 // has the session open orphans the file handles and silently loses the
 // matching forensic record. See ApiHandlers.cpp IsActiveLogFile() for
@@ -189,6 +192,7 @@ static bool IsActiveLogFile(const String& sFilename)
     if (!szActiveBase || szActiveBase[0] == '\0') return false;
     const String sBase = String(szActiveBase);
     return sFilename.equalsIgnoreCase(sBase + ".csv")
+        || sFilename.equalsIgnoreCase(sBase + ".osl")
         || sFilename.equalsIgnoreCase(sBase + ".dbg")
         || sFilename.equalsIgnoreCase(sBase + ".meta");
     }
@@ -284,6 +288,7 @@ void CfgWebServerInit()
 
     CfgServer.on("/api/logs",              HTTP_GET,  onspeed::api::HandleApiLogs);
     CfgServer.on("/api/logs/delete-bulk",  HTTP_POST, onspeed::api::HandleApiLogsDeleteBulk);
+    CfgServer.on("/api/logs/preview",      HTTP_GET,  onspeed::api::HandleApiLogsPreview);
 
     CfgServer.on("/api/format",            HTTP_POST, onspeed::api::HandleApiFormat);
     CfgServer.on("/api/format/status",     HTTP_GET,  onspeed::api::HandleApiFormatStatus);
@@ -291,6 +296,9 @@ void CfgWebServerInit()
 
     CfgServer.on("/api/calwiz/state",      HTTP_GET,  onspeed::api::HandleApiCalwizState);
     CfgServer.on("/api/calwiz/save",       HTTP_POST, onspeed::api::HandleApiCalwizSave);
+    CfgServer.on("/api/calwiz/record",     HTTP_POST, onspeed::api::HandleApiCalwizRecordStart);
+    CfgServer.on("/api/calwiz/record/stop", HTTP_POST, onspeed::api::HandleApiCalwizRecordStop);
+    CfgServer.on("/api/calwiz/fit",        HTTP_GET,  onspeed::api::HandleApiCalwizFit);
 
     CfgServer.on("/api/sensors/biases",    HTTP_GET,  onspeed::api::HandleApiSensorsBiases);
 
@@ -365,9 +373,10 @@ void CfgWebServerInit()
             }
         );
     // Register request headers we need to inspect (ESP32 WebServer discards them by default).
-    // Accept-Encoding is read by StreamFileDownload to decide between the raw and gzip paths.
-    const char* headersToCollect[] = { "If-None-Match", "Accept-Encoding" };
-    CfgServer.collectHeaders(headersToCollect, 2);
+    // Accept-Encoding is read by StreamFileDownload to decide between the raw and gzip paths;
+    // Range / If-Range select a byte slice for resumed downloads.
+    const char* headersToCollect[] = { "If-None-Match", "Accept-Encoding", "Range", "If-Range" };
+    CfgServer.collectHeaders(headersToCollect, sizeof(headersToCollect) / sizeof(headersToCollect[0]));
 
     // Start server
     CfgServer.begin();
@@ -507,8 +516,9 @@ void HandleIndexer()
     }
 
 // /calwiz GET serves the Preact wizard's page stub.  The wizard's
-// write side targets POST /api/calwiz/save and read side targets
-// GET /api/calwiz/state — both implemented in ApiHandlers.cpp.
+// write side targets POST /api/calwiz/save, its read side GET
+// /api/calwiz/state, and its decel run POST /api/calwiz/record[/stop]
+// — all implemented in ApiHandlers.cpp.
 void HandleCalWizardPage()
     {
     ServePageStub(htmlStub_calwiz);
@@ -1032,6 +1042,8 @@ void HandleConfig()
     sBody.replace("{{serialOutOnspeedSel}}",
                   sel(g_Config.sSerialOutFormat == "ONSPEED" ||
                       g_Config.sSerialOutFormat == ""));
+    sBody.replace("{{serialOutOnspeedBinSel}}",
+                  sel(g_Config.sSerialOutFormat == "ONSPEED_BIN"));
 
     sBody.replace("{{acGrossWeight}}",  String(g_Config.iAcGrossWeight));
     sBody.replace("{{acBestGlideIAS}}", String(g_Config.fAcBestGlideIAS));
@@ -2176,18 +2188,23 @@ void HandleDelete()
             else
                 {
                 g_SdFileSys.remove(sFilename.c_str());
+                LogCatalogRemoveLocked(sFilename.c_str());
                 // Also remove matching sidecars (.meta schema, .dbg
-                // writer log). Best-effort: absent sidecar is fine.
+                // writer log, .pvw preview cache). Best-effort: absent
+                // sidecar is fine.
                 int iDot = sFilename.lastIndexOf('.');
                 if (iDot > 0)
                     {
                     String sBase = sFilename.substring(0, iDot);
                     String sMeta = sBase + ".meta";
                     String sDbg  = sBase + ".dbg";
+                    String sPvw  = sBase + onspeed::log::kPreviewSidecarExt;
                     if (g_SdFileSys.exists(sMeta.c_str()))
                         g_SdFileSys.remove(sMeta.c_str());
                     if (g_SdFileSys.exists(sDbg.c_str()))
                         g_SdFileSys.remove(sDbg.c_str());
+                    if (g_SdFileSys.exists(sPvw.c_str()))
+                        g_SdFileSys.remove(sPvw.c_str());
                     }
                 }
             xSemaphoreGive(xWriteMutex);
@@ -2310,6 +2327,7 @@ void HandleDeleteBulk()
             if (!IsActiveLogFile(f))
                 {
                 g_SdFileSys.remove(f.c_str());
+                LogCatalogRemoveLocked(f.c_str());
 
                 int iDot = f.lastIndexOf('.');
                 if (iDot > 0)
@@ -2317,8 +2335,10 @@ void HandleDeleteBulk()
                     String sBase = f.substring(0, iDot);
                     String sMeta = sBase + ".meta";
                     String sDbg  = sBase + ".dbg";
+                    String sPvw  = sBase + onspeed::log::kPreviewSidecarExt;
                     g_SdFileSys.remove(sMeta.c_str());
                     g_SdFileSys.remove(sDbg.c_str());
+                    g_SdFileSys.remove(sPvw.c_str());
                     }
                 }
             xSemaphoreGive(xWriteMutex);
@@ -2352,6 +2372,13 @@ static void* AllocDownloadBuffer(size_t bytes)
 // + caller-supplied basename); `sDisplayName` is what to surface in
 // Content-Disposition so the browser saves with the original basename
 // even when the in-server path differs.
+//
+// Honors a single-range Range header (206 Partial Content, or 416 past
+// EOF) so a download cut off by marginal WiFi resumes where it stopped,
+// and an active log's growth can be fetched as a tail. Every response
+// carries Accept-Ranges and a strong ETag; an If-Range that no longer
+// matches it gets the whole file as a 200, per RFC 9110. See
+// onspeed_core api/HttpRange.h.
 static void StreamFileDownloadRaw(const String& sFilename, const String& sDisplayName)
     {
     FsFile file;
@@ -2365,12 +2392,24 @@ static void StreamFileDownloadRaw(const String& sFilename, const String& sDispla
         ~PauseGuard() { g_bPause = bPrevPause; }
         } pauseGuard;
 
-    size_t fileSize = 0;
+    uint64_t fileSize = 0;
+    char     szETag[32] = "";
     if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000)))
         {
         file = g_SdFileSys.open(sFilename.c_str(), O_READ);
         if (file)
+            {
             fileSize = file.size();
+            // Root-level files fold their session's .meta into the
+            // validator; coredumps (no sidecar) use name + size only.
+            onspeed::log::LogCatalogEntry entry;
+            const bool bRoot = (sFilename.lastIndexOf('/') == 0);
+            if (bRoot)
+                LogCatalogReadEntryLocked(sDisplayName.c_str(), fileSize, &entry);
+            onspeed::api::FormatDownloadETag(sDisplayName.c_str(), fileSize,
+                                             (bRoot && entry.hasMeta) ? &entry.meta : nullptr,
+                                             szETag, sizeof(szETag));
+            }
         xSemaphoreGive(xWriteMutex);
         }
     else
@@ -2385,27 +2424,88 @@ static void StreamFileDownloadRaw(const String& sFilename, const String& sDispla
         return;
         }
 
-    // Send headers to trigger download
-    CfgServer.setContentLength(fileSize);
-    CfgServer.sendHeader("Content-Type", "application/octet-stream");
-    // Use the validated display name so Content-Disposition reflects the
-    // caller-validated basename even when the on-disk path differs.
-    CfgServer.sendHeader("Content-Disposition", "attachment; filename=" + sDisplayName);
-    CfgServer.sendHeader("Connection", "close");
-    CfgServer.send(200);
-//      CfgServer.send(200, "application/octet-stream", "");
+    // Pick the slice to send. A stale If-Range (the file changed since
+    // the client's partial copy) downgrades to a full 200.
+    const String sRange   = CfgServer.hasHeader("Range")    ? CfgServer.header("Range")    : String();
+    const String sIfRange = CfgServer.hasHeader("If-Range") ? CfgServer.header("If-Range") : String();
+    onspeed::api::ByteRange range;
+    onspeed::api::RangeRequest enRange = onspeed::api::ParseRangeHeader(
+        std::string_view(sRange.c_str(), sRange.length()), fileSize, &range);
+    if (enRange != onspeed::api::RangeRequest::None &&
+        !onspeed::api::IfRangeMatches(std::string_view(sIfRange.c_str(), sIfRange.length()), szETag))
+        enRange = onspeed::api::RangeRequest::None;
+
+    // Bytes to send. Capped at the size snapshotted above even for a full
+    // response: the active log keeps growing while we stream it, and
+    // sending past Content-Length would corrupt the response.
+    uint64_t uRemaining = fileSize;
+    char     szContentRange[64];
+
+    CfgServer.sendHeader("Accept-Ranges", "bytes");
+    CfgServer.sendHeader("ETag", szETag);
+    if (enRange == onspeed::api::RangeRequest::Unsatisfiable)
+        {
+        onspeed::api::FormatContentRange(nullptr, fileSize, szContentRange, sizeof(szContentRange));
+        CfgServer.sendHeader("Content-Range", szContentRange);
+        CfgServer.send(416, "text/plain", "Range not satisfiable");
+        uRemaining = 0;
+        }
+    else
+        {
+        bool bSeekOk = true;
+        if (enRange == onspeed::api::RangeRequest::Partial)
+            {
+            uRemaining = range.Length();
+            // Same 2 s budget as the open; a miss here is treated like
+            // a failed seek so we never send bytes from the wrong offset.
+            bSeekOk = false;
+            if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000)))
+                {
+                bSeekOk = file.seekSet(range.first);
+                xSemaphoreGive(xWriteMutex);
+                }
+            }
+
+        if (!bSeekOk)
+            {
+            CfgServer.send(503, "text/plain", "SD busy");
+            uRemaining = 0;
+            }
+        else
+            {
+            // Send headers to trigger download
+            CfgServer.setContentLength(static_cast<size_t>(uRemaining));
+            CfgServer.sendHeader("Content-Type", "application/octet-stream");
+            // Use the validated display name so Content-Disposition reflects the
+            // caller-validated basename even when the on-disk path differs.
+            CfgServer.sendHeader("Content-Disposition", "attachment; filename=" + sDisplayName);
+            CfgServer.sendHeader("Connection", "close");
+            if (enRange == onspeed::api::RangeRequest::Partial)
+                {
+                onspeed::api::FormatContentRange(&range, fileSize, szContentRange, sizeof(szContentRange));
+                CfgServer.sendHeader("Content-Range", szContentRange);
+                CfgServer.send(206);
+                }
+            else
+                {
+                CfgServer.send(200);
+                }
+            }
+        }
 
     WiFiClient client = CfgServer.client();
     uint8_t achBuffer[1460];
-    while (true)
+    while (uRemaining > 0)
         {
         size_t iLen = 0;
+        const size_t iWant = (uRemaining < sizeof(achBuffer))
+                           ? static_cast<size_t>(uRemaining) : sizeof(achBuffer);
         // Getting and giving the semaphore is a bit slow
         // but wrapping this in one take / give doesn't speed
         // things that much and not having the sepaphore messes up logging.
         if (xSemaphoreTake(xWriteMutex, pdMS_TO_TICKS(2000)))
             {
-            iLen = file.read(achBuffer, sizeof(achBuffer));
+            iLen = file.read(achBuffer, iWant);
             xSemaphoreGive(xWriteMutex);
             }
         else
@@ -2442,6 +2542,7 @@ static void StreamFileDownloadRaw(const String& sFilename, const String& sDispla
 
         if (iWritten != iLen)
             break;
+        uRemaining -= iLen;
         }
 
     // 5s timeout on the close — if it fails the FsFile destructor will
@@ -2740,11 +2841,15 @@ static void StreamFileDownloadGzip(const String& sFilename, const String& sDispl
 // "gzip" (typically alongside others, e.g. "gzip, deflate, br" or with
 // q-values like "gzip;q=1.0, deflate;q=0.5"); substring-match catches all
 // of them. Clients that omit Accept-Encoding or don't list gzip get the
-// bit-identical raw stream.
+// bit-identical raw stream. A Range request always takes the raw path:
+// byte offsets into an on-the-fly gzip stream aren't stable across
+// requests, so they can't be resumed.
 static void StreamFileDownload(const String& sFilename, const String& sDisplayName)
     {
     bool bWantsGzip = false;
-    if (CfgServer.hasHeader("Accept-Encoding"))
+    if (CfgServer.hasHeader("Range") && CfgServer.header("Range").length() > 0)
+        bWantsGzip = false;
+    else if (CfgServer.hasHeader("Accept-Encoding"))
         {
         String sEnc = CfgServer.header("Accept-Encoding");
         if (sEnc.indexOf("gzip") >= 0)
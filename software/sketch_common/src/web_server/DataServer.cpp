@@ -14,10 +14,12 @@
 #include "src/ahrs/AhrsSnapshot.h"
 #include "src/ahrs/FlapSnapshot.h"
 #include "src/ahrs/SensorSnapshot.h"
+#include "src/web_server/CalwizRecorder.h"
 
 #include <aoa/DisplayPctAnchors.h>
 #include <aoa/PercentLift.h>
 #include <efis/OatSelect.h>
+#include <proto/LiveDataBin.h>
 
 using onspeed::rad2deg;
 using onspeed::kts2mps;
@@ -28,6 +30,11 @@ using onspeed::aoa::ComputePercentLift;
 using onspeed::aoa::DisplayPctAnchors;
 using onspeed::fpm2mps;
 using onspeed::safeAsin;
+using onspeed::proto::BuildLiveDataBinFrame;
+using onspeed::proto::kLiveDataBinFrameSizeBytes;
+using onspeed::proto::kLiveDataBinSelectMsg;
+using onspeed::proto::kLiveDataJsonSelectMsg;
+using onspeed::proto::LiveDataFrame;
 
 // wifi data variables
 //char crc_buffer[250];
@@ -49,10 +56,27 @@ WebSocketsServer    DataServer = WebSocketsServer(81);
 // Function prototypes
 // -------------------
 void    DataServerEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length);
-size_t  UpdateLiveDataJson(char * pOut, size_t uOutSize);
+void    GatherLiveData(LiveDataFrame & frame);
+size_t  UpdateLiveDataJson(const LiveDataFrame & frame, char * pOut, size_t uOutSize);
 
 unsigned long   lNextMillis = 0;
 
+// Per-client frame format.  Bit `num` of uClientMask is set while client
+// `num` is connected; the same bit in uBinaryClientMask is set once that
+// client has asked for binary frames (kLiveDataBinSelectMsg).  Clients
+// start on JSON.  Both masks are only touched from DataServer.loop()'s
+// event callback and DataServerPoll(), i.e. on this one task, so they
+// need no locking — unlike the removed #1 mirror, which broadcast from
+// Core 1 into the same client array.
+static_assert(WEBSOCKETS_SERVER_CLIENT_MAX <= 32, "client masks are 32 bits wide");
+static uint32_t uClientMask       = 0;
+static uint32_t uBinaryClientMask = 0;
+
+static inline uint32_t ClientBit(uint8_t num)
+    {
+    return (num < 32) ? (1UL << num) : 0;
+    }
+
 // ----------------------------------------------------------------------------
 
 void DataServerPoll()
@@ -65,6 +89,7 @@ void DataServerPoll()
     // keeps us from emitting `{}` on edge-case ticks.  See websocket-
     // protocol.md for the per-field width breakdown.
     char            szLiveDataJson[1024];
+    uint8_t         aLiveDataBin[kLiveDataBinFrameSizeBytes];
 
     DataServer.loop();
 
@@ -73,9 +98,33 @@ void DataServerPoll()
         {
         if (DataServer.connectedClients(false) > 0)
             {
-            size_t uLen = UpdateLiveDataJson(szLiveDataJson, sizeof(szLiveDataJson));
-            if (uLen > 0)
-                DataServer.broadcastTXT(szLiveDataJson, uLen);
+            // Read the snapshots once, then run only the encoders some
+            // client actually wants.  The binary frame skips the ~30
+            // snprintf conversions and is about a quarter of the airtime.
+            LiveDataFrame frame;
+            GatherLiveData(frame);
+
+            // The calibration wizard's run is fitted from these same
+            // frames, at this same rate.
+            CalwizRecordFeed(frame);
+
+            const uint32_t uBinMask  = uClientMask & uBinaryClientMask;
+            const uint32_t uJsonMask = uClientMask & ~uBinaryClientMask;
+            size_t uJsonLen = 0;
+            size_t uBinLen  = 0;
+            if (uJsonMask != 0)
+                uJsonLen = UpdateLiveDataJson(frame, szLiveDataJson, sizeof(szLiveDataJson));
+            if (uBinMask != 0)
+                uBinLen = BuildLiveDataBinFrame(frame, aLiveDataBin, sizeof(aLiveDataBin));
+
+            for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++)
+                {
+                const uint32_t uBit = ClientBit(num);
+                if ((uBinMask & uBit) && uBinLen > 0)
+                    DataServer.sendBIN(num, aLiveDataBin, uBinLen);
+                else if ((uJsonMask & uBit) && uJsonLen > 0)
+                    DataServer.sendTXT(num, szLiveDataJson, uJsonLen);
+                }
             }
         lNextMillis = millis() + kDisplaySerialPeriodMs;
         }
@@ -86,7 +135,9 @@ void DataServerPoll()
 
 void DataServerInit()
     {
-    lNextMillis = 0;
+    lNextMillis       = 0;
+    uClientMask       = 0;
+    uBinaryClientMask = 0;
 
     // Start websockets (live data display)
     DataServer.begin();
@@ -111,8 +162,18 @@ void DataServerInit()
 
 // ----------------------------------------------------------------------------
 
-// There really isn't much to do on events. There is some debug code but in production
-// it should all be commented out.
+// Events track which clients are connected and which frame format each
+// one asked for.  There is some debug code but in production it should
+// all be commented out.
+
+// True when a text frame is exactly `szMsg` (payloads are not
+// NUL-terminated on the wire, so compare by length).
+static bool TextMessageIs(const uint8_t * payload, size_t length, const char * szMsg)
+    {
+    return payload != nullptr &&
+           length == std::strlen(szMsg) &&
+           std::memcmp(payload, szMsg, length) == 0;
+    }
 
 void DataServerEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t length)
     {
@@ -121,6 +182,8 @@ void DataServerEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t lengt
         {
         case WStype_DISCONNECTED:
             g_Log.printf(MsgLog::EnDataServer, MsgLog::EnDebug, "[%u] Disconnected!\n", num);
+            uClientMask       &= ~ClientBit(num);
+            uBinaryClientMask &= ~ClientBit(num);
             break;
         case WStype_CONNECTED:
             {
@@ -129,11 +192,23 @@ void DataServerEvent(uint8_t num, WStype_t type, uint8_t * payload, size_t lengt
 
 		    // send message to client
 		    // DataServer.sendTXT(num, "Connected");
+
+            // A new connection (or a reused slot) starts on JSON.
+            uClientMask       |=  ClientBit(num);
+            uBinaryClientMask &= ~ClientBit(num);
             }
             break;
         case WStype_TEXT:
             g_Log.printf(MsgLog::EnDataServer, MsgLog::EnDebug, "[%u] Got Text: %s\n", num, payload);
 
+            // Frame-format selection (proto/LiveDataBin.h).  A request for a
+            // binary version this firmware doesn't speak matches neither
+            // message, so that client stays on JSON.
+            if (TextMessageIs(payload, length, kLiveDataBinSelectMsg))
+                uBinaryClientMask |= ClientBit(num);
+            else if (TextMessageIs(payload, length, kLiveDataJsonSelectMsg))
+                uBinaryClientMask &= ~ClientBit(num);
+
             // send message to client
             // DataServer.sendTXT(num, "message here");
 
@@ -165,11 +240,13 @@ static inline float SafeJsonFloat(float v, float fallback)
     return IsFiniteFloat(v) ? v : fallback;
     }
 
-size_t UpdateLiveDataJson(char * pOut, size_t uOutSize)
-    {
-    if (pOut == nullptr || uOutSize == 0)
-        return 0;
+// Read the published snapshots once and fill `frame` with this tick's
+// values.  Both encoders (UpdateLiveDataJson and the binary
+// BuildLiveDataBinFrame) format from the result, so a tick with JSON and
+// binary clients connected reads the snapshots once.
 
+void GatherLiveData(LiveDataFrame & frame)
+    {
 #if 1
     float fWifiAOA;
     float fWifiPitch;
@@ -338,35 +415,9 @@ size_t UpdateLiveDataJson(char * pOut, size_t uOutSize)
 
 #endif
 
-    // Build a compact JSON payload into a fixed-size buffer to avoid heap churn
-    // and prevent buffer overruns on unexpected values.
-    // WebSocket schema mirrors the display-serial wire's percent-anchor
-    // contract, so a future shared indexer renderer can run identically
-    // off either transport.  Body-angle AOA / DerivedAOA stay because
-    // the LiveView shows them numerically (and a debugging consumer
-    // wanting to compare body angle to percent gets both); the per-flap
-    // body-angle setpoints (LDmax, OnSpeedFast/Slow/Warn, alpha_0,
-    // alpha_stall) are gone — every consumer renders against the
-    // percent anchors instead.
-    // AOA, DerivedAOA, IAS, percentLift, and DecelRate use %s placeholders
-    // (rather than %.2f / %.1f) so the producer can emit JSON `null` for
-    // those fields when air data is not valid (bIasAlive=false).  Consumer's
-    // fmt() helper collapses null/undefined/NaN to '—'; the wsClient's
-    // aoaIsValid check rejects null via `typeof === 'number'`.
-    const char * szFormat =
-        "{\"AOA\":%s,\"Pitch\":%.2f,\"Roll\":%.2f,\"IAS\":%s,\"PAlt\":%.2f,"
-        "\"verticalGLoad\":%.2f,\"lateralGLoad\":%.2f,"
-        "\"flapsPos\":%i,\"flapIndex\":%i,"
-        "\"flapsMinDeg\":%i,\"flapsMaxDeg\":%i,"
-        "\"coeffP\":%.2f,\"dataMark\":%i,\"vsiFpm\":%.2f,\"flightPath\":%.2f,"
-        "\"PitchRate\":%.2f,\"DecelRate\":%s,\"OAT\":%.2f,\"DerivedAOA\":%s,"
-        "\"gOnsetRate\":%.2f,"
-        "\"percentLift\":%s,\"tonesOnPctLift\":%i,\"onSpeedFastPctLift\":%i,"
-        "\"onSpeedSlowPctLift\":%i,\"stallWarnPctLift\":%i,\"pipPctLift\":%i,"
-        "\"ekfBpDps\":%s,\"ekfBqDps\":%s,\"ekfBrDps\":%s,"
-        "\"ekfBAzMps2\":%s,\"ekfBetaDeg\":%s,\"ekfYawDeg\":%s}";
-
     // Ensure JSON never contains invalid numeric tokens like "nan"/"inf".
+    // The binary frame reserves NaN for `null`, so the same fallbacks
+    // apply to both encodings.
     fWifiPitch      = SafeJsonFloat(fWifiPitch, 0.0f);
     fWifiRoll       = SafeJsonFloat(fWifiRoll, 0.0f);
     fWifiIAS        = SafeJsonFloat(fWifiIAS, 0.0f);
@@ -531,61 +582,122 @@ size_t UpdateLiveDataJson(char * pOut, size_t uOutSize)
     // LiveView's right-edge tape stay in lockstep.
     const float fGOnsetRate = SafeJsonFloat(ahrsSnap.gOnsetRate, 0.0f);
 
-    // Format the AOA / DerivedAOA / IAS / percentLift values as strings
-    // — JSON `null` when air data is invalid (so the consumer's fmt()
-    // helper dashes them) or the formatted float otherwise.  AOA and
-    // DerivedAOA also dash on a NaN source value (e.g. uninitialized
-    // AHRS).  16-byte staging buffers hold the longest expected output.
-    char szAoa[16];
-    char szDerivedAoa[16];
-    char szIas[16];
-    char szPctLift[16];
-    char szDecelRate[16];
-    if (bIasValidForOutput && IsFiniteFloat(fWifiAOA))
-        snprintf(szAoa, sizeof(szAoa), "%.2f", fWifiAOA);
-    else
-        std::strcpy(szAoa, "null");
-    // Single read so the IsFiniteFloat check and the snprintf format the same value (TOCTOU-free).
+    // Nullable fields — NaN here is JSON `null` and binary NaN.  AOA,
+    // DerivedAOA, IAS, percentLift and DecelRate go null when air data is
+    // invalid (so the consumer's fmt() helper dashes them); AOA and
+    // DerivedAOA also go null on a NaN source value (e.g. uninitialized
+    // AHRS).
+    // Single read so the finite check and the encoders see the same value (TOCTOU-free).
     const float fDerivedAoaSnap = ahrsSnap.derivedAoaDeg;
-    if (bIasValidForOutput && IsFiniteFloat(fDerivedAoaSnap))
-        snprintf(szDerivedAoa, sizeof(szDerivedAoa), "%.2f", fDerivedAoaSnap);
-    else
-        std::strcpy(szDerivedAoa, "null");
-    if (bIasValidForOutput)
-        {
-        snprintf(szIas,     sizeof(szIas),     "%.2f", fWifiIAS);
-        snprintf(szPctLift, sizeof(szPctLift), "%.1f", fJsonPercentLiftPct);
-        snprintf(szDecelRate, sizeof(szDecelRate), "%.2f", fDecelRate);
-        }
-    else
-        {
-        std::strcpy(szIas,        "null");
-        std::strcpy(szPctLift,    "null");
-        std::strcpy(szDecelRate,  "null");
-        }
+    constexpr float kNull = LiveDataFrame::kNull;
+
+    frame.aoaDeg        = (bIasValidForOutput && IsFiniteFloat(fWifiAOA)) ? fWifiAOA : kNull;
+    frame.derivedAoaDeg = (bIasValidForOutput && IsFiniteFloat(fDerivedAoaSnap)) ? fDerivedAoaSnap : kNull;
+    frame.iasKt         = bIasValidForOutput ? fWifiIAS : kNull;
+    frame.percentLift   = bIasValidForOutput ? fJsonPercentLiftPct : kNull;
+    frame.decelRate     = bIasValidForOutput ? fDecelRate : kNull;
+
+    // EKFQ-diagnostic fields are null when the source value is non-finite
+    // (Madgwick path: AHRS::PublishSnapshot leaves these at NaN since
+    // Madgwick doesn't estimate gyro biases / b_az / β / yaw).
+    auto finiteOrNull = [](float v) { return IsFiniteFloat(v) ? v : LiveDataFrame::kNull; };
+    frame.ekfBpDps   = finiteOrNull(ahrsSnap.ekfBpDps);
+    frame.ekfBqDps   = finiteOrNull(ahrsSnap.ekfBqDps);
+    frame.ekfBrDps   = finiteOrNull(ahrsSnap.ekfBrDps);
+    frame.ekfBAzMps2 = finiteOrNull(ahrsSnap.ekfBAzMps2);
+    frame.ekfBetaDeg = finiteOrNull(ahrsSnap.ekfBetaDeg);
+    frame.ekfYawDeg  = finiteOrNull(ahrsSnap.ekfYawDeg);
+
+    frame.pitchDeg           = fWifiPitch;
+    frame.rollDeg            = fWifiRoll;
+    frame.paltFt             = fPAltFt;
+    frame.verticalG          = fVerticalGload;
+    frame.lateralG           = fLatG;
+    frame.coeffP             = fCoeffP;
+    frame.vsiFpm             = fWifiVSI;
+    frame.flightPathDeg      = fWifiFlightpath;
+    frame.pitchRateDps       = fPitchRate;
+    frame.oatC               = fWifiOAT;
+    frame.gOnsetRate         = fGOnsetRate;
+    frame.flapsPos           = iJsonFlapsPos;
+    frame.flapIndex          = iSnapFlapIdx;
+    frame.flapsMinDeg        = iJsonFlapsMinDeg;
+    frame.flapsMaxDeg        = iJsonFlapsMaxDeg;
+    frame.tonesOnPctLift     = iJsonTonesOnPct;
+    frame.onSpeedFastPctLift = iJsonFastPct;
+    frame.onSpeedSlowPctLift = iJsonSlowPct;
+    frame.stallWarnPctLift   = iJsonStallWarnPct;
+    frame.pipPctLift         = iJsonPipPct;
+    frame.dataMark           = g_iDataMark;
+    }
+
+// ----------------------------------------------------------------------------
+
+size_t UpdateLiveDataJson(const LiveDataFrame & frame, char * pOut, size_t uOutSize)
+    {
+    if (pOut == nullptr || uOutSize == 0)
+        return 0;
+
+    // Build a compact JSON payload into a fixed-size buffer to avoid heap churn
+    // and prevent buffer overruns on unexpected values.
+    // WebSocket schema mirrors the display-serial wire's percent-anchor
+    // contract, so a future shared indexer renderer can run identically
+    // off either transport.  Body-angle AOA / DerivedAOA stay because
+    // the LiveView shows them numerically (and a debugging consumer
+    // wanting to compare body angle to percent gets both); the per-flap
+    // body-angle setpoints (LDmax, OnSpeedFast/Slow/Warn, alpha_0,
+    // alpha_stall) are gone — every consumer renders against the
+    // percent anchors instead.
+    // AOA, DerivedAOA, IAS, percentLift, and DecelRate use %s placeholders
+    // (rather than %.2f / %.1f) so the producer can emit JSON `null` for
+    // those fields when air data is not valid (bIasAlive=false).  Consumer's
+    // fmt() helper collapses null/undefined/NaN to '—'; the wsClient's
+    // aoaIsValid check rejects null via `typeof === 'number'`.
+    const char * szFormat =
+        "{\"AOA\":%s,\"Pitch\":%.2f,\"Roll\":%.2f,\"IAS\":%s,\"PAlt\":%.2f,"
+        "\"verticalGLoad\":%.2f,\"lateralGLoad\":%.2f,"
+        "\"flapsPos\":%i,\"flapIndex\":%i,"
+        "\"flapsMinDeg\":%i,\"flapsMaxDeg\":%i,"
+        "\"coeffP\":%.2f,\"dataMark\":%i,\"vsiFpm\":%.2f,\"flightPath\":%.2f,"
+        "\"PitchRate\":%.2f,\"DecelRate\":%s,\"OAT\":%.2f,\"DerivedAOA\":%s,"
+        "\"gOnsetRate\":%.2f,"
+        "\"percentLift\":%s,\"tonesOnPctLift\":%i,\"onSpeedFastPctLift\":%i,"
+        "\"onSpeedSlowPctLift\":%i,\"stallWarnPctLift\":%i,\"pipPctLift\":%i,"
+        "\"ekfBpDps\":%s,\"ekfBqDps\":%s,\"ekfBrDps\":%s,"
+        "\"ekfBAzMps2\":%s,\"ekfBetaDeg\":%s,\"ekfYawDeg\":%s}";
 
-    // EKFQ-diagnostic fields.  Emit JSON `null` when the source value is
-    // non-finite (Madgwick path: AHRS::PublishSnapshot leaves these at
-    // NaN since Madgwick doesn't estimate gyro biases / b_az / β / yaw).
-    // Matches the AOA / DerivedAOA / IAS null convention above.
+    // Nullable fields render as JSON `null` when GatherLiveData left them
+    // NaN, or as the formatted float otherwise.  16-byte staging buffers
+    // hold the longest expected output.
     auto fmtFiniteOrNull = [](char* dst, size_t cap, float v, const char* fmt) {
         if (IsFiniteFloat(v))
             snprintf(dst, cap, fmt, v);
         else
             std::strcpy(dst, "null");
     };
+    char szAoa[16];
+    char szDerivedAoa[16];
+    char szIas[16];
+    char szPctLift[16];
+    char szDecelRate[16];
+    fmtFiniteOrNull(szAoa,        sizeof(szAoa),        frame.aoaDeg,        "%.2f");
+    fmtFiniteOrNull(szDerivedAoa, sizeof(szDerivedAoa), frame.derivedAoaDeg, "%.2f");
+    fmtFiniteOrNull(szIas,        sizeof(szIas),        frame.iasKt,         "%.2f");
+    fmtFiniteOrNull(szPctLift,    sizeof(szPctLift),    frame.percentLift,   "%.1f");
+    fmtFiniteOrNull(szDecelRate,  sizeof(szDecelRate),  frame.decelRate,     "%.2f");
+
     char szEkfBp[16];
     char szEkfBq[16];
     char szEkfBr[16];
     char szEkfBAz[16];
     char szEkfBeta[16];
     char szEkfYaw[16];
-    fmtFiniteOrNull(szEkfBp,   sizeof(szEkfBp),   ahrsSnap.ekfBpDps,   "%.4f");
-    fmtFiniteOrNull(szEkfBq,   sizeof(szEkfBq),   ahrsSnap.ekfBqDps,   "%.4f");
-    fmtFiniteOrNull(szEkfBr,   sizeof(szEkfBr),   ahrsSnap.ekfBrDps,   "%.4f");
-    fmtFiniteOrNull(szEkfBAz,  sizeof(szEkfBAz),  ahrsSnap.ekfBAzMps2, "%.4f");
-    fmtFiniteOrNull(szEkfBeta, sizeof(szEkfBeta), ahrsSnap.ekfBetaDeg, "%.2f");
-    fmtFiniteOrNull(szEkfYaw,  sizeof(szEkfYaw),  ahrsSnap.ekfYawDeg,  "%.2f");
+    fmtFiniteOrNull(szEkfBp,   sizeof(szEkfBp),   frame.ekfBpDps,   "%.4f");
+    fmtFiniteOrNull(szEkfBq,   sizeof(szEkfBq),   frame.ekfBqDps,   "%.4f");
+    fmtFiniteOrNull(szEkfBr,   sizeof(szEkfBr),   frame.ekfBrDps,   "%.4f");
+    fmtFiniteOrNull(szEkfBAz,  sizeof(szEkfBAz),  frame.ekfBAzMps2, "%.4f");
+    fmtFiniteOrNull(szEkfBeta, sizeof(szEkfBeta), frame.ekfBetaDeg, "%.2f");
+    fmtFiniteOrNull(szEkfYaw,  sizeof(szEkfYaw),  frame.ekfYawDeg,  "%.2f");
 
     // szFormat is a compile-time constant split across lines for readability.
 #pragma GCC diagnostic push
@@ -595,31 +707,31 @@ size_t UpdateLiveDataJson(char * pOut, size_t uOutSize)
         uOutSize,
         szFormat,
         szAoa,
-        fWifiPitch,
-        fWifiRoll,
+        frame.pitchDeg,
+        frame.rollDeg,
         szIas,
-        fPAltFt,
-        fVerticalGload,
-        fLatG,
-        iJsonFlapsPos,
-        iSnapFlapIdx,
-        iJsonFlapsMinDeg,
-        iJsonFlapsMaxDeg,
-        fCoeffP,
-        g_iDataMark,
-        fWifiVSI,
-        fWifiFlightpath,
-        fPitchRate,
+        frame.paltFt,
+        frame.verticalG,
+        frame.lateralG,
+        frame.flapsPos,
+        frame.flapIndex,
+        frame.flapsMinDeg,
+        frame.flapsMaxDeg,
+        frame.coeffP,
+        frame.dataMark,
+        frame.vsiFpm,
+        frame.flightPathDeg,
+        frame.pitchRateDps,
         szDecelRate,
-        fWifiOAT,
+        frame.oatC,
         szDerivedAoa,
-        fGOnsetRate,
+        frame.gOnsetRate,
         szPctLift,
-        iJsonTonesOnPct,
-        iJsonFastPct,
-        iJsonSlowPct,
-        iJsonStallWarnPct,
-        iJsonPipPct,
+        frame.tonesOnPctLift,
+        frame.onSpeedFastPctLift,
+        frame.onSpeedSlowPctLift,
+        frame.stallWarnPctLift,
+        frame.pipPctLift,
         szEkfBp,
         szEkfBq,
         szEkfBr,
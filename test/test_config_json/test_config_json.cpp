@@ -1,4 +1,5 @@
-// test_config_json.cpp — schema-pin tests for /api/calwiz/state.
+// test_config_json.cpp — schema-pin tests for /api/calwiz/state and the
+// /api/calwiz/record fit document.
 //
 // Covers the read-only side of the calwiz state endpoint added in PR 2:
 //   - Exact key set is emitted.
@@ -7,6 +8,7 @@
 //   - Non-finite floats sentinel to 0 (uncalibrated).
 //   - currentFlapIndex out-of-range clamps to 0.
 //   - Empty flaps vector emits "flaps":[].
+//   - The fit document's key set, status names, and curve0..2 order.
 //
 // The test uses string searches rather than a real JSON parser because
 // the native test environment doesn't pull in nlohmann or rapidjson.
@@ -17,13 +19,17 @@
 
 #include <unity.h>
 
+#include <api/CalwizFitJson.h>
 #include <api/CalwizStateJson.h>
 
 #include <cmath>
 #include <cstring>
 #include <string>
 
+using onspeed::aoa::DecelRunResult;
+using onspeed::aoa::DecelRunStatus;
 using onspeed::api::CalwizStateInputs;
+using onspeed::api::SerializeCalwizFit;
 using onspeed::api::SerializeCalwizState;
 using onspeed::config::OnSpeedConfig;
 
@@ -234,6 +240,57 @@ void test_braces_balance(void) {
     TEST_ASSERT_EQUAL_INT(0, bracketDepth);
 }
 
+// ----------------------------------------------------------------------------
+// /api/calwiz/record fit document
+// ----------------------------------------------------------------------------
+
+void test_fit_keys_and_curve_order(void) {
+    DecelRunResult fit;
+    fit.status        = DecelRunStatus::Ok;
+    fit.sampleCount   = 412;
+    fit.stallIndex    = 398;
+    fit.stallIasKt    = 47.25;
+    fit.stallCp       = 0.5625;
+    fit.flapIndex     = 1;
+    fit.flapsPosDeg   = 15;
+    fit.kFit          = 42783.75;
+    fit.alpha0Deg     = 0.5;
+    fit.alphaStallDeg = 19.625;
+    fit.iasToAoaR2    = 0.99;
+    fit.cpToAoa.curve.afCoeff[1] = 0.703125f;   // a2
+    fit.cpToAoa.curve.afCoeff[2] = 27.59375f;   // a1
+    fit.cpToAoa.curve.afCoeff[3] = 4.0625f;     // a0
+    fit.cpToAoa.r2    = 0.98;
+    auto json = SerializeCalwizFit(fit, false);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"recording\":false,\"sampleCount\":412,\"status\":\"ok\","
+        "\"stallIndex\":398,\"stallIasKt\":47.25,\"stallCp\":0.5625,"
+        "\"flapIndex\":1,\"flapsPosDeg\":15,\"kFit\":42783.75,"
+        "\"alpha0Deg\":0.5,\"alphaStallDeg\":19.625,\"iasToAoaR2\":0.99,"
+        "\"curve0\":0.703125,\"curve1\":27.59375,\"curve2\":4.0625,"
+        "\"cpToAoaR2\":0.98}",
+        json.c_str());
+}
+
+void test_fit_status_names(void) {
+    DecelRunResult fit;
+    fit.status = DecelRunStatus::TooFewSamples;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"recording\":true"));
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"status\":\"tooFewSamples\""));
+    fit.status = DecelRunStatus::InvalidAirData;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"status\":\"invalidAirData\""));
+    fit.status = DecelRunStatus::NoStall;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"status\":\"noStall\""));
+    fit.status = DecelRunStatus::AirspeedIncreasing;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"status\":\"airspeedIncreasing\""));
+    fit.status = DecelRunStatus::TooThin;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"status\":\"tooThin\""));
+
+    fit.kFit = NAN;
+    TEST_ASSERT_TRUE(Contains(SerializeCalwizFit(fit, true), "\"kFit\":0,"));
+}
+
 // ----------------------------------------------------------------------------
 // Main
 // ----------------------------------------------------------------------------
@@ -253,5 +310,8 @@ int main(void) {
 
     RUN_TEST(test_braces_balance);
 
+    RUN_TEST(test_fit_keys_and_curve_order);
+    RUN_TEST(test_fit_status_names);
+
     return UNITY_END();
 }
@@ -298,6 +298,7 @@ static bool ConfigsEqual(const OnSpeedConfig& a, const OnSpeedConfig& b)
     if (a.bVnoChimeEnabled   != b.bVnoChimeEnabled)   return false;
 
     if (a.bSdLogging         != b.bSdLogging)         return false;
+    if (a.iLogFormat         != b.iLogFormat)         return false;
 
     if (a.iAcGrossWeight     != b.iAcGrossWeight)     return false;
     if (std::fabs(a.fAcBestGlideIAS - b.fAcBestGlideIAS) > 1e-5f) return false;
@@ -569,6 +570,7 @@ void test_enum_parsing_serialoutformat(void)
 
     TEST_ASSERT_EQUAL(OnSpeedConfig::EnSerialFmtG3X,     parseFmt("G3X"));
     TEST_ASSERT_EQUAL(OnSpeedConfig::EnSerialFmtOnSpeed, parseFmt("ONSPEED"));
+    TEST_ASSERT_EQUAL(OnSpeedConfig::EnSerialFmtOnSpeedBin, parseFmt("ONSPEED_BIN"));
     TEST_ASSERT_EQUAL(OnSpeedConfig::EnSerialFmtOther,   parseFmt("SOMETHING_ELSE"));
 }
 
@@ -1025,6 +1027,23 @@ void test_ahrs_algorithm_parse(void)
     TEST_ASSERT_EQUAL_INT(1, cfg.iAhrsAlgorithm);
 }
 
+// ============================================================================
+// Log format scalar is parsed and defaults to CSV when absent.
+// ============================================================================
+
+void test_log_format_parse(void)
+{
+    static constexpr const char* kBin = R"XML(<CONFIG2>
+        <LOGFORMAT>1</LOGFORMAT>
+    </CONFIG2>)XML";
+
+    OnSpeedConfig cfg;
+    TEST_ASSERT_EQUAL_INT(0, cfg.iLogFormat);
+    TEST_ASSERT_EQUAL(static_cast<int>(XmlParseStatus::Ok),
+                      static_cast<int>(ParseXml(kBin, cfg)));
+    TEST_ASSERT_EQUAL_INT(1, cfg.iLogFormat);
+}
+
 // ============================================================================
 // Cal source -> bCalSourceEfis cache is derived, not stored — make sure it
 // tracks sCalSource on load.
@@ -1088,6 +1107,7 @@ int main(int argc, char** argv)
     RUN_TEST(test_empty_text_tag_preserves_prior_value);
     RUN_TEST(test_parse_exactly_max_flaps_ok);
     RUN_TEST(test_ahrs_algorithm_parse);
+    RUN_TEST(test_log_format_parse);
     RUN_TEST(test_cal_source_efis_cache);
 
     return UNITY_END();
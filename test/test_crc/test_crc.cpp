@@ -1,12 +1,15 @@
-// test_crc.cpp — unit tests for onspeed::util::Checksum8
+// test_crc.cpp — unit tests for onspeed::util::Checksum8, Crc32 and Crc16Ccitt
 //
 // Cross-checks the additive 8-bit checksum against hand-calculated values and
-// against a reference #1 frame captured from the Gen3 firmware.
+// against a reference #1 frame captured from the Gen3 firmware; Crc32 and
+// Crc16Ccitt against the standard "123456789" check values.
 
 #include <unity.h>
 #include <util/Crc.h>
 
 using onspeed::util::Checksum8;
+using onspeed::util::Crc16Ccitt;
+using onspeed::util::Crc32;
 
 void setUp(void) {}
 void tearDown(void) {}
@@ -75,6 +78,46 @@ void test_length_subset(void)
     TEST_ASSERT_EQUAL_UINT8(0x03u, Checksum8(buf, 2));
 }
 
+void test_crc32_check_value(void)
+{
+    // Standard CRC-32 check value for "123456789".
+    const uint8_t buf[] = {'1','2','3','4','5','6','7','8','9'};
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926u, Crc32(buf, sizeof(buf)));
+}
+
+void test_crc32_empty_is_zero(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0u, Crc32(nullptr, 0));
+}
+
+void test_crc32_running_matches_one_shot(void)
+{
+    // Chaining the previous result must match a single pass, so the
+    // binary log writer can checksum a block in pieces.
+    const uint8_t buf[] = {'1','2','3','4','5','6','7','8','9'};
+    const uint32_t head = Crc32(buf, 4);
+    TEST_ASSERT_EQUAL_UINT32(Crc32(buf, sizeof(buf)), Crc32(buf + 4, 5, head));
+}
+
+void test_crc16_check_value(void)
+{
+    // CRC-16/CCITT-FALSE check value for "123456789".
+    const uint8_t buf[] = {'1','2','3','4','5','6','7','8','9'};
+    TEST_ASSERT_EQUAL_UINT16(0x29B1u, Crc16Ccitt(buf, sizeof(buf)));
+}
+
+void test_crc16_empty_is_init(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(0xFFFFu, Crc16Ccitt(nullptr, 0));
+}
+
+void test_crc16_running_matches_one_shot(void)
+{
+    const uint8_t buf[] = {0xA5, 0x5A, 0x01, 0x00, 0x24, 0x23, 0x0D, 0x0A};
+    const uint16_t head = Crc16Ccitt(buf, 3);
+    TEST_ASSERT_EQUAL_UINT16(Crc16Ccitt(buf, sizeof(buf)), Crc16Ccitt(buf + 3, 5, head));
+}
+
 // ----------------------------------------------------------------------------
 
 int main(int, char**)
@@ -88,5 +131,11 @@ int main(int, char**)
     RUN_TEST(test_known_frame_prefix);
     RUN_TEST(test_all_ascii_digits);
     RUN_TEST(test_length_subset);
+    RUN_TEST(test_crc32_check_value);
+    RUN_TEST(test_crc32_empty_is_zero);
+    RUN_TEST(test_crc32_running_matches_one_shot);
+    RUN_TEST(test_crc16_check_value);
+    RUN_TEST(test_crc16_empty_is_init);
+    RUN_TEST(test_crc16_running_matches_one_shot);
     return UNITY_END();
 }
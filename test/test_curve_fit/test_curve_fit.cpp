@@ -0,0 +1,325 @@
+// test_curve_fit.cpp — Unit tests for the streaming calibration curve fit
+// (PolyFitAccumulator, CurveFitBank).
+//
+// Verifies:
+//   - Exact recovery of quadratic / cubic / linear polynomials, including
+//     CP ranges far from zero, in the [a3, a2, a1, a0] layout CurveCalc
+//     evaluates.
+//   - Residual statistics (R², RMSE, standard error) against a direct
+//     two-pass computation on noisy data.
+//   - Degenerate inputs: too few samples, one distinct x, non-finite.
+//   - Merge() of accumulators with different origins reproduces the
+//     single-pass fit, and rejects an order mismatch.
+//   - CurveFitBank keeps detents apart and, under UpToPeakX, fits only
+//     the samples up to the CP peak (the wizard's stall truncation).
+
+#include <unity.h>
+
+#include <aoa/CurveCalc.h>
+#include <aoa/CurveFit.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using onspeed::CurveCalc;
+using onspeed::SuCalibrationCurve;
+using onspeed::aoa::CurveFitBank;
+using onspeed::aoa::CurveFitResult;
+using onspeed::aoa::FitWindow;
+using onspeed::aoa::PolyFitAccumulator;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+// Deterministic noise in [-1, 1).
+struct Lcg {
+    uint32_t s = 12345u;
+    double Next()
+    {
+        s = s * 1664525u + 1013904223u;
+        return static_cast<double>(s >> 8) / 8388608.0 - 1.0;
+    }
+};
+
+double Quad(double x) { return -6.25 * x * x + 31.5 * x - 9.75; }
+
+}  // namespace
+
+// ============================================================================
+// Exact recovery
+// ============================================================================
+
+void test_quadratic_exact_recovery(void)
+{
+    PolyFitAccumulator acc(2);
+    for (int i = 0; i <= 100; ++i)
+    {
+        const double x = 0.3 + 0.012 * i;
+        acc.Add(x, Quad(x));
+    }
+    CurveFitResult r;
+    TEST_ASSERT_TRUE(acc.Solve(r));
+    TEST_ASSERT_EQUAL_UINT8(1, r.curve.iCurveType);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f,   0.0f,  r.curve.afCoeff[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f,  -6.25f, r.curve.afCoeff[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f,  31.5f,  r.curve.afCoeff[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f,  -9.75f, r.curve.afCoeff[3]);
+    TEST_ASSERT_EQUAL_UINT32(101, r.sampleCount);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.0, r.r2);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.0, r.rmse);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.3, r.xMin);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.5, r.xMax);
+
+    // The result plugs straight into the firmware evaluator.
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, static_cast<float>(Quad(0.9)), CurveCalc(0.9f, r.curve));
+}
+
+void test_cubic_far_from_zero(void)
+{
+    // CP well away from the origin: the shifted sums keep this solvable.
+    PolyFitAccumulator acc(3);
+    for (int i = 0; i < 200; ++i)
+    {
+        const double x = 40.0 + 0.01 * i;
+        const double d = x - 40.0;
+        acc.Add(x, 2.0 * d * d * d - 3.0 * d + 1.0);
+    }
+    CurveFitResult r;
+    TEST_ASSERT_TRUE(acc.Solve(r));
+    for (double x = 40.0; x < 42.0; x += 0.25)
+    {
+        const double d = x - 40.0;
+        TEST_ASSERT_FLOAT_WITHIN(2e-2f, static_cast<float>(2.0 * d * d * d - 3.0 * d + 1.0),
+                                 CurveCalc(static_cast<float>(x), r.curve));
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0, r.r2);
+}
+
+void test_linear_order_and_clamp(void)
+{
+    PolyFitAccumulator acc(0);                      // clamped to 1
+    TEST_ASSERT_EQUAL_INT(1, acc.Order());
+    TEST_ASSERT_EQUAL_INT(3, PolyFitAccumulator(9).Order());
+    acc.Add(1.0, 5.0);
+    acc.Add(3.0, 9.0);
+    CurveFitResult r;
+    TEST_ASSERT_TRUE(acc.Solve(r));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.0f, r.curve.afCoeff[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f, r.curve.afCoeff[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 3.0f, r.curve.afCoeff[3]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.0, r.stdError);   // n == order + 1
+}
+
+// ============================================================================
+// Residual statistics
+// ============================================================================
+
+void test_noisy_statistics_match_two_pass(void)
+{
+    Lcg noise;
+    std::vector<double> xs, ys;
+    PolyFitAccumulator  acc(2);
+    for (int i = 0; i < 500; ++i)
+    {
+        const double x = 0.4 + 0.002 * i;
+        const double y = Quad(x) + 0.3 * noise.Next();
+        xs.push_back(x);
+        ys.push_back(y);
+        acc.Add(x, y);
+    }
+    CurveFitResult r;
+    TEST_ASSERT_TRUE(acc.Solve(r));
+
+    double mean = 0.0;
+    for (double y : ys) mean += y;
+    mean /= static_cast<double>(ys.size());
+    double sse = 0.0, sst = 0.0;
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        const double e = ys[i] - CurveCalc(static_cast<float>(xs[i]), r.curve);
+        sse += e * e;
+        sst += (ys[i] - mean) * (ys[i] - mean);
+    }
+    const double n = static_cast<double>(xs.size());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, 1.0 - sse / sst, r.r2);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, std::sqrt(sse / n), r.rmse);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, std::sqrt(sse / (n - 3)), r.stdError);
+    // Uniform ±0.3 noise: RMSE ≈ 0.3/√3.
+    TEST_ASSERT_DOUBLE_WITHIN(0.02, 0.3 / std::sqrt(3.0), r.rmse);
+    TEST_ASSERT_TRUE(r.r2 < 1.0 && r.r2 > 0.9);
+}
+
+// ============================================================================
+// Degenerate input
+// ============================================================================
+
+void test_too_few_samples_fails(void)
+{
+    PolyFitAccumulator acc(2);
+    CurveFitResult r;
+    r.sampleCount = 77;
+    TEST_ASSERT_FALSE(acc.Solve(r));
+    acc.Add(1.0, 1.0);
+    acc.Add(2.0, 4.0);
+    TEST_ASSERT_FALSE(acc.Solve(r));
+    TEST_ASSERT_EQUAL_UINT32(77, r.sampleCount);    // untouched
+    acc.Add(3.0, 9.0);
+    TEST_ASSERT_TRUE(acc.Solve(r));
+}
+
+void test_single_distinct_x_fails(void)
+{
+    PolyFitAccumulator acc(2);
+    for (int i = 0; i < 50; ++i) acc.Add(0.8, 6.0 + 0.01 * i);
+    CurveFitResult r;
+    TEST_ASSERT_FALSE(acc.Solve(r));
+
+    PolyFitAccumulator two(2);                      // two distinct x, quadratic
+    for (int i = 0; i < 50; ++i) two.Add(i % 2 ? 0.8 : 0.9, 6.0);
+    TEST_ASSERT_FALSE(two.Solve(r));
+}
+
+void test_non_finite_ignored_and_reset(void)
+{
+    PolyFitAccumulator acc(1);
+    acc.Add(NAN, 1.0);
+    acc.Add(1.0, INFINITY);
+    TEST_ASSERT_EQUAL_UINT32(0, acc.SampleCount());
+    acc.Add(1.0, 1.0);
+    acc.Add(2.0, 2.0);
+    TEST_ASSERT_EQUAL_UINT32(2, acc.SampleCount());
+    acc.Reset();
+    TEST_ASSERT_EQUAL_UINT32(0, acc.SampleCount());
+    TEST_ASSERT_EQUAL_INT(1, acc.Order());
+}
+
+// ============================================================================
+// Merge
+// ============================================================================
+
+void test_merge_matches_single_pass(void)
+{
+    // Three partial fits with origins far apart (first samples 0.4, 1.3,
+    // 0.9) must combine to exactly what one accumulator sees.
+    Lcg noise;
+    PolyFitAccumulator whole(2), a(2), b(2), c(2), empty(2);
+    for (int i = 0; i < 600; ++i)
+    {
+        const double x = i < 200 ? 0.4 + 0.002 * i
+                       : i < 400 ? 1.3 - 0.002 * (i - 200)
+                                 : 0.9 + 0.001 * (i - 400);
+        const double y = Quad(x) + 0.2 * noise.Next();
+        whole.Add(x, y);
+        (i < 200 ? a : i < 400 ? b : c).Add(x, y);
+    }
+    TEST_ASSERT_TRUE(empty.Merge(a));               // empty adopts the other
+    TEST_ASSERT_TRUE(empty.Merge(b));
+    TEST_ASSERT_TRUE(empty.Merge(c));
+    TEST_ASSERT_TRUE(empty.Merge(PolyFitAccumulator(2)));
+    TEST_ASSERT_EQUAL_UINT32(600, empty.SampleCount());
+
+    CurveFitResult rw, rm;
+    TEST_ASSERT_TRUE(whole.Solve(rw));
+    TEST_ASSERT_TRUE(empty.Solve(rm));
+    for (int k = 0; k < 4; ++k)
+        TEST_ASSERT_FLOAT_WITHIN(1e-4f, rw.curve.afCoeff[k], rm.curve.afCoeff[k]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, rw.r2, rm.r2);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, rw.rmse, rm.rmse);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, rw.xMin, rm.xMin);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, rw.xMax, rm.xMax);
+}
+
+void test_merge_order_mismatch_rejected(void)
+{
+    PolyFitAccumulator quad(2), lin(1);
+    quad.Add(1.0, 1.0);
+    lin.Add(2.0, 2.0);
+    TEST_ASSERT_FALSE(quad.Merge(lin));
+    TEST_ASSERT_EQUAL_UINT32(1, quad.SampleCount());
+}
+
+// ============================================================================
+// CurveFitBank
+// ============================================================================
+
+void test_bank_keeps_detents_apart(void)
+{
+    CurveFitBank bank;
+    for (int i = 0; i < 60; ++i)
+    {
+        const float x = 0.5f + 0.01f * static_cast<float>(i);
+        bank.Add(0, x, 10.0f * x);
+        bank.Add(2, x, 4.0f * x * x + 1.0f);
+    }
+    bank.Add(-1, 1.0f, 1.0f);                       // ignored
+    bank.Add(onspeed::MAX_AOA_CURVES, 1.0f, 1.0f);
+
+    CurveFitResult r0, r2;
+    TEST_ASSERT_TRUE(bank.Solve(0, r0));
+    TEST_ASSERT_TRUE(bank.Solve(2, r2));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 10.0f, r0.curve.afCoeff[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 4.0f,  r2.curve.afCoeff[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.0f,  r2.curve.afCoeff[3]);
+
+    CurveFitResult r1;
+    TEST_ASSERT_FALSE(bank.Solve(1, r1));
+    TEST_ASSERT_NULL(bank.Fit(onspeed::MAX_AOA_CURVES));
+
+    bank.Reset(2);
+    TEST_ASSERT_FALSE(bank.Solve(2, r2));
+    TEST_ASSERT_TRUE(bank.Solve(0, r0));
+}
+
+void test_bank_truncates_at_cp_peak(void)
+{
+    // Decel run: CP climbs to the stall, then the recovery samples wander
+    // off the curve.  UpToPeakX must fit only the climb.
+    CurveFitBank peak(2, FitWindow::UpToPeakX);
+    CurveFitBank all(2, FitWindow::All);
+    for (int i = 0; i <= 120; ++i)
+    {
+        const float x = 0.4f + 0.01f * static_cast<float>(i);
+        const float y = static_cast<float>(Quad(x));
+        peak.Add(1, x, y);
+        all.Add(1, x, y);
+    }
+    for (int i = 1; i <= 40; ++i)
+    {
+        const float x = 1.6f - 0.02f * static_cast<float>(i);
+        peak.Add(1, x, 2.0f);                        // post-stall recovery
+        all.Add(1, x, 2.0f);
+    }
+
+    CurveFitResult rp, ra;
+    TEST_ASSERT_TRUE(peak.Solve(1, rp));
+    TEST_ASSERT_TRUE(all.Solve(1, ra));
+    TEST_ASSERT_EQUAL_UINT32(121, rp.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(161, ra.sampleCount);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 1.6, peak.PeakX(1));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -6.25f, rp.curve.afCoeff[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 31.5f,  rp.curve.afCoeff[2]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0, rp.r2);
+    TEST_ASSERT_TRUE(ra.r2 < 0.99);
+}
+
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_quadratic_exact_recovery);
+    RUN_TEST(test_cubic_far_from_zero);
+    RUN_TEST(test_linear_order_and_clamp);
+    RUN_TEST(test_noisy_statistics_match_two_pass);
+    RUN_TEST(test_too_few_samples_fails);
+    RUN_TEST(test_single_distinct_x_fails);
+    RUN_TEST(test_non_finite_ignored_and_reset);
+    RUN_TEST(test_merge_matches_single_pass);
+    RUN_TEST(test_merge_order_mismatch_rejected);
+    RUN_TEST(test_bank_keeps_detents_apart);
+    RUN_TEST(test_bank_truncates_at_cp_peak);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// test_decel_rate_filter.cpp - Unit tests for DecelRateFilter
+//
+// The display's decel gauge must read the same whether frames arrive as
+// 20 Hz #1 text or 100 Hz ONSPEED_BIN: the same constant-decel ramp fed
+// at both rates gives the same Smoothed() trajectory, not just the same
+// steady state.
+
+#include <unity.h>
+#include <filters/DecelRateFilter.h>
+#include <cmath>
+#include <initializer_list>
+
+using onspeed::filters::DecelRateFilter;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+constexpr float kDecelKtPerSec = -3.0f;
+
+// Feed a ramp from 120 kt at `rateHz` until `untilSec`; return Smoothed().
+float RunRamp(DecelRateFilter& f, float rateHz, float untilSec)
+{
+    const float dt = 1.0f / rateHz;
+    const int   n  = static_cast<int>(std::lround(untilSec * rateHz));
+    for (int i = 0; i < n; i++)
+        f.Update(120.0f + kDecelKtPerSec * dt * static_cast<float>(i), dt);
+    return f.Smoothed();
+}
+
+}  // namespace
+
+// ============================================================================
+// Rate independence
+// ============================================================================
+
+void test_ramp_agrees_at_20_and_100_hz()
+{
+    // Through the fill and well into the EMA's rise, where a per-frame
+    // EMA at 100 Hz (τ five times shorter) would be far ahead.
+    for (float t : { 1.5f, 2.0f, 3.0f, 5.0f, 10.0f }) {
+        DecelRateFilter slow;
+        DecelRateFilter fast;
+        const float s = RunRamp(slow, 20.0f, t);
+        const float f = RunRamp(fast, 100.0f, t);
+        TEST_ASSERT_TRUE(s < 0.0f);
+        TEST_ASSERT_FLOAT_WITHIN(0.02f * std::fabs(kDecelKtPerSec), s, f);
+    }
+}
+
+void test_ramp_converges_to_true_rate()
+{
+    DecelRateFilter slow;
+    DecelRateFilter fast;
+    RunRamp(slow, 20.0f, 120.0f);
+    RunRamp(fast, 100.0f, 120.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, kDecelKtPerSec, slow.Rate());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, kDecelKtPerSec, fast.Rate());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, kDecelKtPerSec, slow.Smoothed());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, kDecelKtPerSec, fast.Smoothed());
+}
+
+// ============================================================================
+// Decimation
+// ============================================================================
+
+void test_100_hz_takes_every_fifth_frame()
+{
+    DecelRateFilter f;
+    int taken = 0;
+    for (int i = 0; i < 1000; i++)
+        if (f.Update(100.0f, 0.01f)) taken++;
+    TEST_ASSERT_INT_WITHIN(1, 200, taken);
+}
+
+void test_jittered_20_hz_takes_every_frame()
+{
+    DecelRateFilter f;
+    for (int i = 0; i < 200; i++)
+        TEST_ASSERT_TRUE(f.Update(100.0f, (i % 2) ? 0.046f : 0.054f));
+}
+
+void test_slow_frames_are_all_taken_and_earn_no_credit()
+{
+    DecelRateFilter f;
+    TEST_ASSERT_TRUE(f.Update(100.0f, 0.1f));
+    TEST_ASSERT_TRUE(f.Update(100.0f, 0.1f));
+    // A late frame does not bank time: the next 100 Hz frame is skipped.
+    TEST_ASSERT_FALSE(f.Update(100.0f, 0.01f));
+}
+
+void test_reset_zeroes_and_refills()
+{
+    DecelRateFilter f;
+    RunRamp(f, 20.0f, 5.0f);
+    TEST_ASSERT_TRUE(f.Smoothed() < 0.0f);
+
+    f.Reset();
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, f.Rate());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, f.Smoothed());
+    // Window refilling: the first 15 samples read 0.
+    for (int i = 0; i < DecelRateFilter::kWindow; i++) {
+        f.Update(50.0f - static_cast<float>(i), 0.05f);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, f.Rate());
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ramp_agrees_at_20_and_100_hz);
+    RUN_TEST(test_ramp_converges_to_true_rate);
+    RUN_TEST(test_100_hz_takes_every_fifth_frame);
+    RUN_TEST(test_jittered_20_hz_takes_every_frame);
+    RUN_TEST(test_slow_frames_are_all_taken_and_earn_no_credit);
+    RUN_TEST(test_reset_zeroes_and_refills);
+
+    return UNITY_END();
+}
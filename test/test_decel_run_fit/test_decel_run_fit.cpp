@@ -0,0 +1,300 @@
+// test_decel_run_fit.cpp — Unit tests for DecelRunFit, the calibration
+// wizard's streamed decel-run fits.
+//
+// Verifies:
+//   - A clean lift-equation decel (AOA = K/IAS² + alpha_0, CP quadratic
+//     in AOA) recovers K, alpha_0 and a CP → AOA curve that agrees with
+//     alphaStall at the stall CP.
+//   - A stall-and-recovery run fits only up to the smoothed-CP peak.
+//   - The stall sample's flap detent and angle are reported.
+//   - Rejections: too few samples, non-finite air data, no stall, IAS
+//     rising, flat AOA (degenerate 1/IAS² fit), and Reset().
+//   - vac_decel_run.csv (a real V1 cal flight, CP rebuilt from Pfwd /
+//     P45) reproduces the values CalWizardPage.js's regression.js fit
+//     produced before the fit moved to the firmware, to that fit's
+//     printed precision.
+
+#include <unity.h>
+
+#include <aoa/DecelRunFit.h>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using onspeed::aoa::DecelRunFit;
+using onspeed::aoa::DecelRunResult;
+using onspeed::aoa::DecelRunSample;
+using onspeed::aoa::DecelRunStatus;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+// RV-class lift equation: stall near +12° body angle at 55 kt.
+constexpr double kK      = 46887.5;
+constexpr double kAlpha0 = -3.5;
+
+double Aoa(double ias)  { return kK / (ias * ias) + kAlpha0; }
+double Cp(double aoa)   { return 0.20 + 0.080 * aoa + 0.001 * aoa * aoa; }
+
+DecelRunSample Sample(double ias, int flapsPosDeg = 0, int flapIndex = 0)
+{
+    DecelRunSample s;
+    s.iasKt         = static_cast<float>(ias);
+    s.derivedAoaDeg = static_cast<float>(Aoa(ias));
+    s.coeffP        = static_cast<float>(Cp(Aoa(ias)));
+    s.flapsPosDeg   = flapsPosDeg;
+    s.flapIndex     = flapIndex;
+    return s;
+}
+
+// Linear IAS sweep over n samples.
+void Sweep(DecelRunFit& f, int n, double iasStart, double iasEnd)
+{
+    for (int i = 0; i < n; ++i)
+        f.Add(Sample(iasStart + (iasEnd - iasStart) * i / (n - 1)));
+}
+
+double EvalCurve(const DecelRunResult& r, double cp)
+{
+    const float* c = r.cpToAoa.curve.afCoeff;
+    return c[1] * cp * cp + c[2] * cp + c[3];
+}
+
+std::string FindRepoRoot()
+{
+#ifdef ONSPEED_REPO_ROOT
+    return std::string(ONSPEED_REPO_ROOT);
+#else
+    std::string cwd = ".";
+    for (int i = 0; i < 8; ++i) {
+        std::ifstream f(cwd + "/platformio.ini");
+        if (f.good()) return cwd;
+        cwd += "/..";
+    }
+    return ".";
+#endif
+}
+
+std::vector<std::string> SplitCsv(const std::string& line)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(line);
+    std::string cell;
+    while (std::getline(ss, cell, ',')) out.push_back(cell);
+    return out;
+}
+
+}  // namespace
+
+// ============================================================================
+// Synthetic runs
+// ============================================================================
+
+void test_clean_run_recovers_lift_equation(void)
+{
+    DecelRunFit f;
+    Sweep(f, 200, 80.0, 55.0);
+    const DecelRunResult r = f.Result();
+
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::Ok), static_cast<int>(r.status));
+    TEST_ASSERT_EQUAL_UINT32(200u, r.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(199u, r.stallIndex);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, kK, r.kFit);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-4, kAlpha0, r.alpha0Deg);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0, r.iasToAoaR2);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0, r.cpToAoa.r2);
+
+    // The smoothed IAS lags the last raw sample by a few thousandths.
+    TEST_ASSERT_DOUBLE_WITHIN(0.005, 55.0, r.stallIasKt);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, r.kFit / (r.stallIasKt * r.stallIasKt) + r.alpha0Deg,
+                              r.alphaStallDeg);
+
+    // Both fits give the same AOA at the stall.
+    TEST_ASSERT_DOUBLE_WITHIN(0.02, r.alphaStallDeg, EvalCurve(r, r.stallCp));
+}
+
+void test_fit_stops_at_cp_peak(void)
+{
+    // 80 → 55 kt over samples 0..130, then recovery to 70 kt.  Recovery
+    // samples would pull K well off the lift equation.
+    DecelRunFit f;
+    for (int i = 0; i < 200; ++i)
+    {
+        const double ias = i <= 130 ? 80.0 - 25.0 * i / 130.0
+                                    : 55.0 + 15.0 * (i - 130) / 69.0;
+        f.Add(Sample(ias));
+    }
+    const DecelRunResult r = f.Result();
+
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::Ok), static_cast<int>(r.status));
+    TEST_ASSERT_UINT32_WITHIN(3u, 130u, r.stallIndex);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, kK, r.kFit);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-4, kAlpha0, r.alpha0Deg);
+}
+
+void test_stall_sample_carries_flap_detent(void)
+{
+    DecelRunFit f;
+    for (int i = 0; i < 200; ++i)
+        f.Add(Sample(70.0 - 15.0 * i / 199.0, 15, 1));
+    const DecelRunResult r = f.Result();
+
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::Ok), static_cast<int>(r.status));
+    TEST_ASSERT_EQUAL_INT(1, r.flapIndex);
+    TEST_ASSERT_EQUAL_INT(15, r.flapsPosDeg);
+}
+
+// ============================================================================
+// Rejections
+// ============================================================================
+
+void test_too_few_samples(void)
+{
+    DecelRunFit f;
+    Sweep(f, 49, 80.0, 55.0);
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::TooFewSamples),
+                          static_cast<int>(f.Result().status));
+    TEST_ASSERT_EQUAL_UINT32(49u, f.Result().sampleCount);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, f.Result().kFit);
+}
+
+void test_non_finite_air_data_rejects_run(void)
+{
+    DecelRunFit f;
+    for (int i = 0; i < 200; ++i)
+    {
+        DecelRunSample s = Sample(80.0 - 25.0 * i / 199.0);
+        if (i == 50) s.iasKt = NAN;
+        f.Add(s);
+    }
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::InvalidAirData),
+                          static_cast<int>(f.Result().status));
+}
+
+void test_no_positive_cp_is_no_stall(void)
+{
+    DecelRunFit f;
+    for (int i = 0; i < 100; ++i)
+    {
+        DecelRunSample s = Sample(80.0 - 0.2 * i);
+        s.coeffP = -0.1f;
+        f.Add(s);
+    }
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::NoStall),
+                          static_cast<int>(f.Result().status));
+}
+
+void test_rising_airspeed_rejected(void)
+{
+    // Accelerating: CP falls, so the "stall" is early, and IAS is rising
+    // up to it.
+    DecelRunFit f;
+    Sweep(f, 200, 55.0, 80.0);
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::AirspeedIncreasing),
+                          static_cast<int>(f.Result().status));
+}
+
+void test_flat_aoa_is_too_thin(void)
+{
+    // IAS falls, CP rises, but AOA never moves: K fits to 0, and every
+    // setpoint would collapse onto alpha_0.
+    DecelRunFit f;
+    for (int i = 0; i < 100; ++i)
+    {
+        DecelRunSample s;
+        s.iasKt         = 80.0f - 0.1f * static_cast<float>(i);
+        s.coeffP        = 0.3f + 0.001f * static_cast<float>(i);
+        s.derivedAoaDeg = 5.0f;
+        f.Add(s);
+    }
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::TooThin),
+                          static_cast<int>(f.Result().status));
+}
+
+void test_reset_starts_a_new_run(void)
+{
+    DecelRunFit f;
+    Sweep(f, 200, 55.0, 80.0);
+    f.Reset();
+    TEST_ASSERT_EQUAL_UINT32(0u, f.SampleCount());
+    Sweep(f, 200, 80.0, 55.0);
+    const DecelRunResult r = f.Result();
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::Ok), static_cast<int>(r.status));
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, kK, r.kFit);
+}
+
+// ============================================================================
+// Real decel run
+// ============================================================================
+
+void test_vac_decel_run_matches_js_fit(void)
+{
+    std::ifstream in(FindRepoRoot() + "/tools/onspeed_py/tests/fixtures/vac_decel_run.csv");
+    TEST_ASSERT_TRUE_MESSAGE(in.good(), "vac_decel_run.csv not found");
+
+    std::string line;
+    std::getline(in, line);
+    const std::vector<std::string> header = SplitCsv(line);
+    auto column = [&](const char* name) {
+        for (size_t i = 0; i < header.size(); ++i)
+            if (header[i] == name) return static_cast<int>(i);
+        return -1;
+    };
+    const int iIas   = column("IAS");
+    const int iAoa   = column("AngleofAttack");   // V1-era DerivedAOA
+    const int iFlaps = column("flapsPos");
+    const int iPfwd  = column("Pfwd");
+    const int iP45   = column("P45");
+    TEST_ASSERT_TRUE(iIas >= 0 && iAoa >= 0 && iFlaps >= 0 && iPfwd >= 0 && iP45 >= 0);
+
+    DecelRunFit f;
+    while (std::getline(in, line))
+    {
+        const std::vector<std::string> c = SplitCsv(line);
+        const double pfwd = std::stod(c[iPfwd]);
+        DecelRunSample s;
+        s.iasKt         = std::stof(c[iIas]);
+        s.coeffP        = static_cast<float>(pfwd > 0.0 ? std::stod(c[iP45]) / pfwd : 0.0);
+        s.derivedAoaDeg = std::stof(c[iAoa]);
+        s.flapsPosDeg   = std::stoi(c[iFlaps]);
+        f.Add(s);
+    }
+    const DecelRunResult r = f.Result();
+
+    // The JS fit printed K / alpha_0 to 6 decimals and the curve to 4;
+    // K here is a float (the type the save path stores).
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(DecelRunStatus::Ok), static_cast<int>(r.status));
+    TEST_ASSERT_EQUAL_UINT32(1500u, r.sampleCount);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-5,  47.270016, r.stallIasKt);
+    TEST_ASSERT_DOUBLE_WITHIN(0.005, 42783.755486, r.kFit);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6,  0.467095, r.alpha0Deg);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-5,  19.614389, r.alphaStallDeg);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6,  0.991179, r.iasToAoaR2);
+    TEST_ASSERT_DOUBLE_WITHIN(5e-5,  0.7033,  r.cpToAoa.curve.afCoeff[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(5e-5,  27.5917, r.cpToAoa.curve.afCoeff[2]);
+    TEST_ASSERT_DOUBLE_WITHIN(5e-5,  4.0629,  r.cpToAoa.curve.afCoeff[3]);
+    TEST_ASSERT_DOUBLE_WITHIN(5e-5,  0.9906,  r.cpToAoa.r2);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_clean_run_recovers_lift_equation);
+    RUN_TEST(test_fit_stops_at_cp_peak);
+    RUN_TEST(test_stall_sample_carries_flap_detent);
+    RUN_TEST(test_too_few_samples);
+    RUN_TEST(test_non_finite_air_data_rejects_run);
+    RUN_TEST(test_no_positive_cp_is_no_stall);
+    RUN_TEST(test_rising_airspeed_rejected);
+    RUN_TEST(test_flat_aoa_is_too_thin);
+    RUN_TEST(test_reset_starts_a_new_run);
+    RUN_TEST(test_vac_decel_run_matches_js_fit);
+
+    return UNITY_END();
+}
@@ -10,6 +10,8 @@
 //   - Exact byte-level check of a known frame
 //   - Extreme values (pitch ±90, IAS 0, IAS 500)
 //   - Special percentLift values (0, 50, 99)
+//   - Binary keyframe / delta encode-decode, CRC and sequence-gap rejection
+//   - Accumulator on interleaved ASCII and binary streams
 
 #include <unity.h>
 #include <proto/DisplaySerial.h>
@@ -817,6 +819,261 @@ void test_accumulator_back_to_back_frames(void)
     TEST_ASSERT_FLOAT_WITHIN(DELTA_10, -2.5f, r2->pitchDeg);
 }
 
+// ----------------------------------------------------------------------------
+// Binary frames
+// ----------------------------------------------------------------------------
+
+static DisplayBuildInputs busyInputs()
+{
+    DisplayBuildInputs in = zeroInputs();
+    in.pitchDeg           = -12.3f;
+    in.rollDeg            = 45.6f;
+    in.iasKt              = 87.4f;
+    in.paltFt             = -1234.0f;
+    in.turnRateDps        = -3.2f;
+    in.lateralG           = -0.12f;
+    in.verticalGScaled10  = 13.0f;
+    in.percentLiftPct     = 61.7f;
+    in.vsiFpm10           = -85;
+    in.oatC               = -17;
+    in.flightPathDeg      = -3.4f;
+    in.flapsDeg           = 20;
+    in.tonesOnPctLift     = 40;
+    in.onSpeedFastPctLift = 55;
+    in.onSpeedSlowPctLift = 62;
+    in.stallWarnPctLift   = 88;
+    in.flapsMinDeg        = -5;
+    in.flapsMaxDeg        = 40;
+    in.gOnsetRate         = -1.25f;
+    in.spinRecoveryCue    = -1;
+    in.dataMark           = 7;
+    in.pipPctLift         = 44;
+    return in;
+}
+
+// The binary path must decode to exactly what the ASCII path decodes.
+static void assertSameFrame(const DisplayFrame& a, const DisplayFrame& b)
+{
+    TEST_ASSERT_EQUAL_FLOAT(a.pitchDeg,       b.pitchDeg);
+    TEST_ASSERT_EQUAL_FLOAT(a.rollDeg,        b.rollDeg);
+    TEST_ASSERT_EQUAL_FLOAT(a.iasKt,          b.iasKt);
+    TEST_ASSERT_EQUAL(a.iasIsValid,           b.iasIsValid);
+    TEST_ASSERT_EQUAL_FLOAT(a.paltFt,         b.paltFt);
+    TEST_ASSERT_EQUAL_FLOAT(a.turnRateDps,    b.turnRateDps);
+    TEST_ASSERT_EQUAL_FLOAT(a.lateralG,       b.lateralG);
+    TEST_ASSERT_EQUAL_FLOAT(a.verticalG,      b.verticalG);
+    TEST_ASSERT_EQUAL_FLOAT(a.percentLiftPct, b.percentLiftPct);
+    TEST_ASSERT_EQUAL_FLOAT(a.vsiFpm,         b.vsiFpm);
+    TEST_ASSERT_EQUAL(a.oatC,                 b.oatC);
+    TEST_ASSERT_EQUAL_FLOAT(a.flightPathDeg,  b.flightPathDeg);
+    TEST_ASSERT_EQUAL(a.flapsDeg,             b.flapsDeg);
+    TEST_ASSERT_EQUAL(a.tonesOnPctLift,       b.tonesOnPctLift);
+    TEST_ASSERT_EQUAL(a.onSpeedFastPctLift,   b.onSpeedFastPctLift);
+    TEST_ASSERT_EQUAL(a.onSpeedSlowPctLift,   b.onSpeedSlowPctLift);
+    TEST_ASSERT_EQUAL(a.stallWarnPctLift,     b.stallWarnPctLift);
+    TEST_ASSERT_EQUAL(a.flapsMinDeg,          b.flapsMinDeg);
+    TEST_ASSERT_EQUAL(a.flapsMaxDeg,          b.flapsMaxDeg);
+    TEST_ASSERT_EQUAL_FLOAT(a.gOnsetRate,     b.gOnsetRate);
+    TEST_ASSERT_EQUAL(a.spinRecoveryCue,      b.spinRecoveryCue);
+    TEST_ASSERT_EQUAL(a.dataMark,             b.dataMark);
+    TEST_ASSERT_EQUAL(a.pipPctLift,           b.pipPctLift);
+}
+
+static DisplayFrame asciiRoundTrip(const DisplayBuildInputs& in)
+{
+    buildOk(in);
+    return parseOk();
+}
+
+void test_binary_keyframe_matches_ascii(void)
+{
+    const DisplayBuildInputs in = busyInputs();
+    DisplayBinaryEncoder enc;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    const size_t n = enc.Encode(in, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(kDisplayBinHeaderBytes + kDisplayBinKeyPayloadBytes + kDisplayBinCrcBytes, n);
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinSync0, buf[0]);
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinSync1, buf[1]);
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinTypeKey, buf[2]);
+    TEST_ASSERT_EQUAL(0, buf[3]);
+
+    auto stateless = ParseDisplayFrameBinary(buf, n);
+    TEST_ASSERT_TRUE(stateless.has_value());
+    assertSameFrame(asciiRoundTrip(in), *stateless);
+
+    DisplayBinaryDecoder dec;
+    auto f = dec.Decode(buf, n);
+    TEST_ASSERT_TRUE(f.has_value());
+    assertSameFrame(*stateless, *f);
+}
+
+void test_binary_keyframe_extremes_and_sentinel(void)
+{
+    DisplayBuildInputs in = busyInputs();
+    in.paltFt      = 123456.0f;   // clamps to 99999, needs the i32 field
+    in.rollDeg     = -2000.0f;    // clamps to -9999
+    in.iasValid    = false;
+    in.dataMark    = -1;          // wraps the same way as the ASCII field
+    DisplayBinaryEncoder enc;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    const size_t n = enc.Encode(in, buf, sizeof(buf));
+    auto f = ParseDisplayFrameBinary(buf, n);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_FALSE(f->iasIsValid);
+    assertSameFrame(asciiRoundTrip(in), *f);
+}
+
+void test_binary_unchanged_frame_is_heartbeat(void)
+{
+    const DisplayBuildInputs in = busyInputs();
+    DisplayBinaryEncoder enc;
+    DisplayBinaryDecoder dec;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    TEST_ASSERT_TRUE(dec.Decode(buf, enc.Encode(in, buf, sizeof(buf))).has_value());
+
+    const size_t n = enc.Encode(in, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(kDisplayBinHeaderBytes + kDisplayBinMaskBytes + kDisplayBinCrcBytes, n);
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinTypeDelta, buf[2]);
+    TEST_ASSERT_EQUAL(1, buf[3]);
+    auto f = dec.Decode(buf, n);
+    TEST_ASSERT_TRUE(f.has_value());
+    assertSameFrame(asciiRoundTrip(in), *f);
+
+    // Deltas need a base: the stateless parser refuses them.
+    TEST_ASSERT_FALSE(ParseDisplayFrameBinary(buf, n).has_value());
+}
+
+void test_binary_delta_carries_only_changes(void)
+{
+    DisplayBuildInputs in = busyInputs();
+    DisplayBinaryEncoder enc;
+    DisplayBinaryDecoder dec;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    dec.Decode(buf, enc.Encode(in, buf, sizeof(buf)));
+
+    in.pitchDeg = 3.3f;   // i16
+    in.paltFt   = 5500;   // i32
+    in.oatC     = 12;     // i8
+    const size_t n = enc.Encode(in, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(kDisplayBinHeaderBytes + kDisplayBinMaskBytes + 2 + 4 + 1 +
+                      kDisplayBinCrcBytes, n);
+    auto f = dec.Decode(buf, n);
+    TEST_ASSERT_TRUE(f.has_value());
+    assertSameFrame(asciiRoundTrip(in), *f);
+}
+
+void test_binary_keyframe_interval(void)
+{
+    DisplayBinaryEncoder enc(3);
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    const DisplayBuildInputs in = busyInputs();
+    const uint8_t expect[] = {kDisplayBinTypeKey, kDisplayBinTypeDelta, kDisplayBinTypeDelta,
+                              kDisplayBinTypeKey, kDisplayBinTypeDelta};
+    for (uint8_t type : expect) {
+        enc.Encode(in, buf, sizeof(buf));
+        TEST_ASSERT_EQUAL_HEX8(type, buf[2]);
+    }
+    enc.ForceKeyframe();
+    enc.Encode(in, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinTypeKey, buf[2]);
+    TEST_ASSERT_EQUAL(6, enc.NextSeq());
+}
+
+void test_binary_rejects_bad_crc_and_length(void)
+{
+    DisplayBinaryEncoder enc;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    const size_t n = enc.Encode(busyInputs(), buf, sizeof(buf));
+    TEST_ASSERT_TRUE(ParseDisplayFrameBinary(buf, n).has_value());
+    TEST_ASSERT_FALSE(ParseDisplayFrameBinary(buf, n - 1).has_value());
+    TEST_ASSERT_FALSE(ParseDisplayFrameBinary(nullptr, n).has_value());
+
+    buf[10] ^= 0x04;
+    TEST_ASSERT_FALSE(ParseDisplayFrameBinary(buf, n).has_value());
+    DisplayBinaryDecoder dec;
+    TEST_ASSERT_FALSE(dec.Decode(buf, n).has_value());
+    TEST_ASSERT_FALSE(dec.HasBase());
+
+    uint8_t small[kDisplayBinMaxFrameBytes - 1];
+    TEST_ASSERT_EQUAL(0u, enc.Encode(busyInputs(), small, sizeof(small)));
+}
+
+void test_binary_seq_gap_waits_for_keyframe(void)
+{
+    DisplayBuildInputs in = busyInputs();
+    DisplayBinaryEncoder enc(4);
+    DisplayBinaryDecoder dec;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+
+    TEST_ASSERT_TRUE(dec.Decode(buf, enc.Encode(in, buf, sizeof(buf))).has_value());   // key, seq 0
+    in.pitchDeg = 1.0f;
+    enc.Encode(in, buf, sizeof(buf));                                                    // seq 1 lost
+    in.pitchDeg = 2.0f;
+    TEST_ASSERT_FALSE(dec.Decode(buf, enc.Encode(in, buf, sizeof(buf))).has_value());  // seq 2
+    TEST_ASSERT_FALSE(dec.HasBase());
+    TEST_ASSERT_FALSE(dec.Decode(buf, enc.Encode(in, buf, sizeof(buf))).has_value());  // seq 3
+
+    in.pitchDeg = 4.0f;
+    auto f = dec.Decode(buf, enc.Encode(in, buf, sizeof(buf)));                         // key, seq 4
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_FLOAT_WITHIN(DELTA_10, 4.0f, f->pitchDeg);
+    in.pitchDeg = 5.0f;
+    f = dec.Decode(buf, enc.Encode(in, buf, sizeof(buf)));
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_FLOAT_WITHIN(DELTA_10, 5.0f, f->pitchDeg);
+}
+
+void test_accumulator_mixed_ascii_and_binary(void)
+{
+    // Binary payloads routinely contain '#', CR and LF; none of them may
+    // break framing, and an ASCII frame in between must still parse.
+    DisplayBuildInputs in = busyInputs();
+    in.paltFt   = 0x23;                 // '#' in the payload
+    in.oatC     = 0x0A;                 // LF in the payload
+    DisplayBinaryEncoder enc;
+    DisplayFrameAccumulator accum;
+    uint8_t buf[kDisplayBinMaxFrameBytes];
+    int parsed = 0;
+
+    auto pump = [&](const uint8_t* b, size_t n) -> std::optional<DisplayFrame> {
+        std::optional<DisplayFrame> out;
+        for (size_t i = 0; i < n; ++i) {
+            auto r = accum.Inject(b[i]);
+            if (r) {
+                TEST_ASSERT_EQUAL(n - 1, i);
+                out = r;
+                ++parsed;
+            }
+        }
+        return out;
+    };
+
+    auto f = pump(buf, enc.Encode(in, buf, sizeof(buf)));
+    TEST_ASSERT_TRUE(f.has_value());
+    assertSameFrame(asciiRoundTrip(in), *f);
+
+    in.pitchDeg = 8.8f;
+    buildOk(in);
+    f = pump(frameBuf, kDisplayFrameSizeBytes);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_FLOAT_WITHIN(DELTA_10, 8.8f, f->pitchDeg);
+
+    // Garbage and a false sync between frames are skipped.
+    const uint8_t noise[] = {kDisplayBinSync0, 'x', 0x00, kDisplayBinSync0};
+    pump(noise, sizeof(noise));
+    TEST_ASSERT_TRUE(accum.InBinaryFrame());
+    accum.Reset();
+
+    in.pitchDeg = -7.7f;
+    f = pump(buf, enc.Encode(in, buf, sizeof(buf)));   // delta
+    TEST_ASSERT_EQUAL_HEX8(kDisplayBinTypeDelta, buf[2]);
+    TEST_ASSERT_TRUE(f.has_value());
+    TEST_ASSERT_FLOAT_WITHIN(DELTA_10, -7.7f, f->pitchDeg);
+    TEST_ASSERT_EQUAL(0x0A, f->oatC);
+    TEST_ASSERT_EQUAL(3, parsed);
+    TEST_ASSERT_FALSE(accum.InProgress());
+}
+
 // ----------------------------------------------------------------------------
 
 int main(int, char**)
@@ -891,5 +1148,14 @@ int main(int, char**)
     RUN_TEST(test_accumulator_rejects_bad_crc);
     RUN_TEST(test_accumulator_back_to_back_frames);
 
+    RUN_TEST(test_binary_keyframe_matches_ascii);
+    RUN_TEST(test_binary_keyframe_extremes_and_sentinel);
+    RUN_TEST(test_binary_unchanged_frame_is_heartbeat);
+    RUN_TEST(test_binary_delta_carries_only_changes);
+    RUN_TEST(test_binary_keyframe_interval);
+    RUN_TEST(test_binary_rejects_bad_crc_and_length);
+    RUN_TEST(test_binary_seq_gap_waits_for_keyframe);
+    RUN_TEST(test_accumulator_mixed_ascii_and_binary);
+
     return UNITY_END();
 }
@@ -183,6 +183,7 @@ void test_ekfq_defaults_finite(void) {
     TEST_ASSERT_TRUE(c.r_ay   > 0.0f && std::isfinite(c.r_ay));
     TEST_ASSERT_TRUE(c.r_az   > 0.0f && std::isfinite(c.r_az));
     TEST_ASSERT_FLOAT_WITHIN(1e-6f, 12.0f, c.tas_min_mps);
+    TEST_ASSERT_FALSE(c.sequential_update);
 }
 
 void test_ekfq_pipeline_config_override(void) {
@@ -247,6 +248,49 @@ void test_ekfq_diagnostic_states_finite_in_level_flight(void) {
     TEST_ASSERT_TRUE(std::fabs(s.beta_deg()) < 5.0f);
 }
 
+// Sequential (scalar-at-a-time) correct() is the batch update in exact
+// arithmetic. Run both over 20 s of turning, pulling, speed-changing
+// flight with a baro sample every 4th step and require the attitude and
+// altitude to agree to fp32-rounding level.
+void test_ekfq_sequential_update_tracks_batch(void) {
+    EKFQ::Config seqCfg = EKFQ::Config::defaults();
+    seqCfg.sequential_update = true;
+    EKFQ batch;
+    EKFQ seq(seqCfg);
+    batch.init(0.0f, 0.0f, 300.0f);
+    seq.init(0.0f, 0.0f, 300.0f);
+
+    float maxAtt = 0.0f, maxZ = 0.0f;
+    for (int k = 0; k < 20 * 208; ++k) {
+        const float t = k * DT;
+        EKFQ::Measurements m = {};
+        m.p = 0.2f * std::sin(0.7f * t);
+        m.q = 0.05f * std::cos(0.5f * t);
+        m.r = 0.1f * std::sin(0.3f * t);
+        m.ax = 0.5f * std::sin(t);
+        m.ay = 0.3f * std::sin(1.3f * t);
+        m.az = -G - 2.0f * std::sin(0.4f * t);
+        m.tasMps = 55.0f + 5.0f * std::sin(0.05f * t);
+        m.tasDotMps2 = 0.25f * std::cos(0.05f * t);
+        m.baroAltMeters = 300.0f + 20.0f * std::sin(0.1f * t);
+        m.updateBaro = (k % 4) == 0;
+        batch.update(m, DT);
+        seq.update(m, DT);
+        const EKFQ::State a = batch.getState();
+        const EKFQ::State b = seq.getState();
+        maxAtt = std::fmax(maxAtt, std::fabs(a.roll_deg()  - b.roll_deg()));
+        maxAtt = std::fmax(maxAtt, std::fabs(a.pitch_deg() - b.pitch_deg()));
+        maxZ   = std::fmax(maxZ,   std::fabs(a.z - b.z));
+    }
+    TEST_ASSERT_TRUE(maxAtt < 0.01f);
+    TEST_ASSERT_TRUE(maxZ < 0.01f);
+    for (int i = 0; i < EKFQ::N_STATES; ++i) {
+        TEST_ASSERT_TRUE(seq.getP(i, i) > 0.0f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * batch.getP(i, i) + 1e-9f,
+                                 batch.getP(i, i), seq.getP(i, i));
+    }
+}
+
 int main(int, char**) {
     UNITY_BEGIN();
     RUN_TEST(test_ekfq_init_default);
@@ -259,5 +303,6 @@ int main(int, char**) {
     RUN_TEST(test_ekfq_defaults_finite);
     RUN_TEST(test_ekfq_pipeline_config_override);
     RUN_TEST(test_ekfq_diagnostic_states_finite_in_level_flight);
+    RUN_TEST(test_ekfq_sequential_update_tracks_batch);
     return UNITY_END();
 }
@@ -0,0 +1,281 @@
+/**
+ * @file test_ekfq_batch.cpp
+ * @brief EKFQBatch lanes vs scalar EKFQ.
+ *
+ * Every lane is paired with a scalar EKFQ fed the same config and
+ * inputs, and state and covariance must match exactly (== compares
+ * +0 and -0 equal, which is the documented slack). Lanes get distinct
+ * configs and trajectories that cross the TAS gate, the sinc
+ * small-angle branch and baro dropouts at different times.
+ *
+ * EkfqPipelineBatch is checked the same way against scalar
+ * EkfqPipelines, through IAS-gate rising edges (vertical covariance
+ * reset) at lane-dependent thresholds.
+ */
+
+#include <unity.h>
+#include <ahrs/EKFQ.h>
+#include <ahrs/EKFQBatch.h>
+#include <ahrs/EkfqPipeline.h>
+#include <ahrs/EkfqPipelineBatch.h>
+#include <cmath>
+#include <cstdint>
+
+using namespace onspeed;
+
+static constexpr int   LANES = EKFQBatch::LANES;
+static constexpr int   NS    = EKFQ::N_STATES;
+static constexpr float DT    = 1.0f / 208.0f;
+static constexpr float G     = 9.80665f;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+struct Lcg {
+    uint32_t s;
+    float next() {   // uniform in [-1, 1)
+        s = s * 1664525u + 1013904223u;
+        return static_cast<float>(s >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+};
+
+EKFQ::Config laneConfig(int lane) {
+    EKFQ::Config c = EKFQ::Config::defaults();
+    const float k = 1.0f + 0.25f * static_cast<float>(lane);
+    c.q_quat *= k;
+    c.q_bias /= k;
+    c.r_ax   *= k;
+    c.r_baro *= 2.0f - 0.2f * static_cast<float>(lane);
+    c.k_beta_R = 0.5f * static_cast<float>(lane);
+    c.tas_min_mps = 10.0f + static_cast<float>(lane);
+    return c;
+}
+
+// Per-lane trajectory: a slow climbing turn with noise, TAS ramping
+// through the β gate, lane-dependent baro dropouts and rest periods
+// with exactly zero body rate.
+EKFQ::Measurements laneInput(int lane, int step, Lcg& rng) {
+    const float t = static_cast<float>(step) * DT;
+    EKFQ::Measurements m{};
+    const bool rest = (step / 50) % 7 == lane % 7;
+    const float ph = 0.3f * static_cast<float>(lane);
+    m.p = rest ? 0.0f : 0.2f * std::sin(0.7f * t + ph) + 0.01f * rng.next();
+    m.q = rest ? 0.0f : 0.05f * std::cos(0.5f * t) + 0.01f * rng.next();
+    m.r = rest ? 0.0f : 0.1f * std::sin(0.3f * t + ph);
+    m.ax = 0.5f * std::sin(t + ph) + 0.2f * rng.next();
+    m.ay = 0.3f * std::cos(0.9f * t) + 0.2f * rng.next();
+    m.az = -G + 0.5f * std::sin(1.3f * t) + 0.2f * rng.next();
+    m.tasMps = 3.0f * t + static_cast<float>(lane);
+    m.tasDotMps2 = 3.0f + 0.1f * rng.next();
+    m.baroAltMeters = 100.0f + 2.0f * t + 0.5f * rng.next();
+    m.updateBaro = (step % (lane + 1)) == 0;
+    return m;
+}
+
+void assertLaneMatches(const EKFQBatch& batch, int lane, const EKFQ& ref) {
+    EKFQ got;
+    batch.getLane(lane, got);
+    const float* gx = got.getX();
+    const float* rx = ref.getX();
+    for (int i = 0; i < NS; ++i) {
+        if (!(gx[i] == rx[i])) {
+            TEST_FAIL_MESSAGE("state mismatch");
+        }
+        for (int j = 0; j < NS; ++j) {
+            if (!(got.getP(i, j) == ref.getP(i, j))) {
+                TEST_FAIL_MESSAGE("covariance mismatch");
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void test_ekfq_batch_default_lanes_match_scalar_init(void) {
+    EKFQBatch batch;
+    const EKFQ ref;
+    for (int l = 0; l < LANES; ++l) assertLaneMatches(batch, l, ref);
+}
+
+// The main equivalence check: 4000 steps (~19 s) of update() per lane.
+void test_ekfq_batch_update_bit_exact(void) {
+    EKFQBatch batch;
+    EKFQ ref[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        ref[l].setConfig(laneConfig(l));
+        ref[l].init(0.05f * l, -0.02f * l, 100.0f + l);
+        batch.setConfig(l, laneConfig(l));
+        batch.init(l, 0.05f * l, -0.02f * l, 100.0f + l);
+    }
+
+    Lcg rng[LANES];
+    for (int l = 0; l < LANES; ++l) rng[l].s = 1234u + 77u * l;
+
+    for (int step = 0; step < 4000; ++step) {
+        EKFQ::Measurements m[LANES];
+        for (int l = 0; l < LANES; ++l) {
+            m[l] = laneInput(l, step, rng[l]);
+            ref[l].update(m[l], DT);
+        }
+        batch.update(m, DT);
+    }
+    for (int l = 0; l < LANES; ++l) assertLaneMatches(batch, l, ref[l]);
+}
+
+// Split predict/correct with per-lane dt and un-faded vs faded TAS, as
+// EkfqPipeline drives the filter.
+void test_ekfq_batch_predict_correct_per_lane_dt(void) {
+    EKFQBatch batch;
+    EKFQ ref[LANES];
+    Lcg rng[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        rng[l].s = 99u + l;
+        batch.setLane(l, ref[l]);
+    }
+
+    for (int step = 0; step < 1000; ++step) {
+        EKFQBatch::PredictInputs pin;
+        EKFQBatch::CorrectInputs cin;
+        for (int l = 0; l < LANES; ++l) {
+            const EKFQ::Measurements m = laneInput(l, step, rng[l]);
+            const float dt   = DT * (1.0f + 0.01f * l);
+            const float fade = (step < 500) ? step / 500.0f : 1.0f;
+            ref[l].predict(m.p, m.q, m.r, m.ax, m.ay, m.az, m.tasMps, dt);
+            ref[l].correct(m.ax, m.ay, m.az, m.tasMps * fade, m.tasDotMps2 * fade,
+                           m.q, m.r, m.baroAltMeters, m.updateBaro);
+            pin.p[l] = m.p; pin.q[l] = m.q; pin.r[l] = m.r;
+            pin.ax[l] = m.ax; pin.ay[l] = m.ay; pin.az[l] = m.az;
+            pin.tas[l] = m.tasMps; pin.dt[l] = dt;
+            cin.ax[l] = m.ax; cin.ay[l] = m.ay; cin.az[l] = m.az;
+            cin.tas[l] = m.tasMps * fade; cin.tasDot[l] = m.tasDotMps2 * fade;
+            cin.pitchRate[l] = m.q; cin.yawRate[l] = m.r;
+            cin.baroZ[l] = m.baroAltMeters; cin.updateBaro[l] = m.updateBaro;
+        }
+        batch.predict(pin);
+        batch.correct(cin);
+    }
+    for (int l = 0; l < LANES; ++l) assertLaneMatches(batch, l, ref[l]);
+}
+
+// A non-SPD innovation covariance aborts that lane's update only.
+void test_ekfq_batch_failed_cholesky_is_per_lane(void) {
+    EKFQBatch batch;
+    EKFQ ref[LANES];
+    EKFQ::Config bad = EKFQ::Config::defaults();
+    bad.r_ax = -1.0e6f;
+    ref[2].setConfig(bad);
+    batch.setConfig(2, bad);
+    const EKFQ before = ref[2];
+
+    Lcg rng[LANES];
+    EKFQ::Measurements m[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        rng[l].s = 5u + l;
+        m[l] = laneInput(l, 10, rng[l]);
+        ref[l].update(m[l], DT);
+    }
+    batch.update(m, DT);
+
+    for (int l = 0; l < LANES; ++l) assertLaneMatches(batch, l, ref[l]);
+    // The bad lane kept its P (predict ran, correct did not).
+    TEST_ASSERT_TRUE(ref[2].getP(EKFQ::Q0, EKFQ::Q0) > before.getP(EKFQ::Q0, EKFQ::Q0));
+}
+
+void test_ekfq_batch_lane_round_trip_and_vertical_reset(void) {
+    EKFQBatch batch;
+    EKFQ ref[LANES];
+    Lcg rng[LANES];
+    for (int l = 0; l < LANES; ++l) rng[l].s = 42u + l;
+    for (int step = 0; step < 200; ++step) {
+        EKFQ::Measurements m[LANES];
+        for (int l = 0; l < LANES; ++l) {
+            m[l] = laneInput(l, step, rng[l]);
+            ref[l].update(m[l], DT);
+        }
+        batch.update(m, DT);
+    }
+
+    ref[5].resetVerticalCovariance(250.0f);
+    batch.resetVerticalCovariance(5, 250.0f);
+    assertLaneMatches(batch, 5, ref[5]);
+
+    const EKFQ::State s = batch.getState(5);
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, s.z);
+    TEST_ASSERT_EQUAL_FLOAT(ref[5].getState().pitch_deg(), s.pitch_deg());
+
+    EKFQ out;
+    batch.getLane(5, out);
+    TEST_ASSERT_EQUAL_FLOAT(ref[5].alphaKinematicRad(40.0f), out.alphaKinematicRad(40.0f));
+    TEST_ASSERT_EQUAL_FLOAT(ref[5].getConfig().r_baro, batch.getConfig(5).r_baro);
+}
+
+// Every lane's outputs match a scalar EkfqPipeline with the same tuning
+// on every frame. IAS climbs through each lane's gate, drops below it
+// and climbs back, so each lane resets its vertical covariance twice.
+void test_ekfq_pipeline_batch_matches_scalar_pipelines(void) {
+    using onspeed::ahrs::EkfqPipeline;
+    using onspeed::ahrs::EkfqPipelineBatch;
+
+    onspeed::ahrs::EkfqPipelineBatch batch;
+    EkfqPipeline ref[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        EkfqPipeline::PipelineConfig pc = EkfqPipeline::PipelineConfig::defaults();
+        pc.accelEmaAlpha   *= 1.0f + 0.1f * static_cast<float>(l);
+        pc.iasGateRisingKt  = 25.0f + 3.0f * static_cast<float>(l);
+        pc.tasdotEmaAlpha  *= 1.0f - 0.05f * static_cast<float>(l);
+        ref[l].getEkfq().setConfig(laneConfig(l));
+        ref[l].setPipelineConfig(pc);
+        ref[l].Init(2.0f, -1.0f, 100.0f);
+        batch.SetConfig(l, laneConfig(l), pc);
+    }
+    batch.Init(2.0f, -1.0f, 100.0f);
+
+    Lcg rng{42u};
+    int mismatches = 0;
+    for (int step = 0; step < 3000; ++step) {
+        const float t = static_cast<float>(step) * DT;
+        EkfqPipeline::Inputs in;
+        in.accelFwdCorrG    = 0.05f * std::sin(t) + 0.02f * rng.next();
+        in.accelLatCorrG    = 0.02f * rng.next();
+        in.accelVertCorrG   = 1.0f + 0.2f * std::sin(0.5f * t) + 0.02f * rng.next();
+        in.rollRateCorrDps  = 10.0f * std::sin(0.7f * t) + 0.5f * rng.next();
+        in.pitchRateCorrDps = 3.0f * std::cos(0.5f * t) + 0.5f * rng.next();
+        in.yawRateCorrDps   = 5.0f * std::sin(0.3f * t);
+        in.iasKt            = (step < 1000) ? 0.08f * step
+                            : (step < 1500) ? 80.0f - 0.13f * (step - 1000)
+                                            : 15.0f + 0.05f * (step - 1500);
+        in.tasMps           = 0.5144f * in.iasKt * 1.05f;
+        in.baroAltMeters    = 100.0f + 0.5f * t + 0.3f * rng.next();
+        in.dtSec            = DT;
+
+        EkfqPipeline::Outputs got[LANES];
+        batch.Step(in, got);
+        for (int l = 0; l < LANES; ++l) {
+            const EkfqPipeline::Outputs want = ref[l].Step(in);
+            const bool same = got[l].pitchDeg == want.pitchDeg
+                           && got[l].rollDeg == want.rollDeg
+                           && got[l].derivedAoaDeg == want.derivedAoaDeg
+                           && got[l].earthVertG == want.earthVertG
+                           && got[l].altMeters == want.altMeters
+                           && got[l].vsiMps == want.vsiMps
+                           && got[l].compFadeIn == want.compFadeIn
+                           && got[l].iasGate == want.iasGate
+                           && got[l].iasGateRisingEdge == want.iasGateRisingEdge;
+            if (!same) ++mismatches;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ekfq_batch_default_lanes_match_scalar_init);
+    RUN_TEST(test_ekfq_batch_update_bit_exact);
+    RUN_TEST(test_ekfq_batch_predict_correct_per_lane_dt);
+    RUN_TEST(test_ekfq_batch_failed_cholesky_is_per_lane);
+    RUN_TEST(test_ekfq_batch_lane_round_trip_and_vertical_reset);
+    RUN_TEST(test_ekfq_pipeline_batch_matches_scalar_pipelines);
+    return UNITY_END();
+}
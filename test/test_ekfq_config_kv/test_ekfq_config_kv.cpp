@@ -95,6 +95,22 @@ void test_malformed_line_errors(void) {
     TEST_ASSERT_FALSE(ParseEkfqConfigKv("q_quat=notanumber\n", ekfq, pipe, capture_warn));
 }
 
+void test_sequential_update_switch(void) {
+    g_warnings.clear();
+    onspeed::EKFQ::Config ekfq{};
+    onspeed::ahrs::EkfqPipeline::PipelineConfig pipe{};
+    TEST_ASSERT_TRUE(ParseEkfqConfigKv("", ekfq, pipe, capture_warn));
+    TEST_ASSERT_FALSE(ekfq.sequential_update);
+    // Optional: leaving it out adds no missing-key warning.
+    TEST_ASSERT_EQUAL_INT(kTotalKeys, (int)g_warnings.size());
+
+    TEST_ASSERT_TRUE(ParseEkfqConfigKv("sequential_update=1\n", ekfq, pipe, capture_warn));
+    TEST_ASSERT_TRUE(ekfq.sequential_update);
+    TEST_ASSERT_TRUE(ParseEkfqConfigKv("sequential_update=0\n", ekfq, pipe, capture_warn));
+    TEST_ASSERT_FALSE(ekfq.sequential_update);
+    TEST_ASSERT_FALSE(ParseEkfqConfigKv("sequential_update=2\n", ekfq, pipe, capture_warn));
+}
+
 int main(int, char**) {
     UNITY_BEGIN();
     RUN_TEST(test_empty_file_yields_all_defaults);
@@ -103,5 +119,6 @@ int main(int, char**) {
     RUN_TEST(test_comments_and_blanks);
     RUN_TEST(test_unknown_key_errors);
     RUN_TEST(test_malformed_line_errors);
+    RUN_TEST(test_sequential_update_switch);
     return UNITY_END();
 }
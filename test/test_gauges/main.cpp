@@ -1,6 +1,6 @@
 // main.cpp — Unity entry point for the test_gauges suite.
 //
-// Runs every named test case across the four per-module files. Each test
+// Runs every named test case across the per-module files. Each test
 // case is declared in its sibling .cpp; we forward-declare them here (rather
 // than introducing a shared header) so this file remains the single source
 // of truth for which tests run.
@@ -57,6 +57,18 @@ void test_default_construction_style_fields(void);
 void test_default_state_is_deterministic(void);
 void test_modified_state_does_not_bleed_to_next_instance(void);
 
+// DirtyTiles
+void test_dirty_reset_marks_whole_frame(void);
+void test_dirty_reset_rejects_oversize_frame(void);
+void test_dirty_unchanged_frame_pushes_nothing(void);
+void test_dirty_single_pixel_marks_one_tile(void);
+void test_dirty_scan_accumulates_until_taken(void);
+void test_dirty_markrect_clips_and_rounds_to_tiles(void);
+void test_dirty_rects_merge_vertically(void);
+void test_dirty_rects_cover_exactly_marked_tiles(void);
+void test_dirty_rect_overflow_falls_back_to_bounding_box(void);
+void test_dirty_partial_edge_tiles_clip_to_frame(void);
+
 // ---- Entry point ------------------------------------------------------------
 
 int main(int, char**)
@@ -106,5 +118,17 @@ int main(int, char**)
     RUN_TEST(test_default_state_is_deterministic);
     RUN_TEST(test_modified_state_does_not_bleed_to_next_instance);
 
+    // DirtyTiles
+    RUN_TEST(test_dirty_reset_marks_whole_frame);
+    RUN_TEST(test_dirty_reset_rejects_oversize_frame);
+    RUN_TEST(test_dirty_unchanged_frame_pushes_nothing);
+    RUN_TEST(test_dirty_single_pixel_marks_one_tile);
+    RUN_TEST(test_dirty_scan_accumulates_until_taken);
+    RUN_TEST(test_dirty_markrect_clips_and_rounds_to_tiles);
+    RUN_TEST(test_dirty_rects_merge_vertically);
+    RUN_TEST(test_dirty_rects_cover_exactly_marked_tiles);
+    RUN_TEST(test_dirty_rect_overflow_falls_back_to_bounding_box);
+    RUN_TEST(test_dirty_partial_edge_tiles_clip_to_frame);
+
     return UNITY_END();
 }
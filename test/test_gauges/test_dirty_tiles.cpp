@@ -0,0 +1,243 @@
+// test_dirty_tiles.cpp — unit tests for onspeed::gauges::DirtyTileMap.
+//
+// The M5 display pushes only the tiles of its persistent framebuffer that
+// changed since the last frame. These tests pin down the two halves of
+// that: Scan() notices exactly the tiles whose pixels changed (and no
+// others), and TakeRects() turns them into a small set of rectangles that
+// covers every marked tile and nothing else.
+
+#include <unity.h>
+
+#include <gauges/DirtyTiles.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace onspeed::gauges;
+
+namespace {
+
+constexpr int kW = 320;
+constexpr int kH = 240;
+
+struct Frame {
+    int                  bpp;
+    std::vector<uint8_t> px;
+
+    explicit Frame(int bytesPerPixel)
+        : bpp(bytesPerPixel), px(static_cast<std::size_t>(kW * kH * bytesPerPixel), 0) {}
+
+    void Fill(int x, int y, int w, int h, uint8_t v)
+    {
+        for (int j = y; j < y + h; ++j)
+            std::memset(&px[static_cast<std::size_t>((j * kW + x) * bpp)], v,
+                        static_cast<std::size_t>(w * bpp));
+    }
+
+    int Scan(DirtyTileMap& m) const
+    {
+        return m.Scan(px.data(), bpp, static_cast<std::size_t>(kW * bpp));
+    }
+};
+
+// Pixel area covered by the rectangles, and whether every one stays inside
+// the frame.
+int Area(const DirtyRect* r, int n)
+{
+    int a = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        TEST_ASSERT_TRUE(r[i].x >= 0 && r[i].y >= 0);
+        TEST_ASSERT_TRUE(r[i].x + r[i].w <= kW && r[i].y + r[i].h <= kH);
+        a += r[i].w * r[i].h;
+    }
+    return a;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Reset / MarkAll
+// ---------------------------------------------------------------------------
+
+void test_dirty_reset_marks_whole_frame(void)
+{
+    DirtyTileMap m;
+    TEST_ASSERT_TRUE(m.Reset(kW, kH));
+    TEST_ASSERT_EQUAL_INT(20, m.Cols());
+    TEST_ASSERT_EQUAL_INT(15, m.Rows());
+    TEST_ASSERT_EQUAL_INT(300, m.DirtyTileCount());
+
+    DirtyRect r[kDirtyMaxRects];
+    TEST_ASSERT_EQUAL_INT(1, m.TakeRects(r, kDirtyMaxRects));
+    TEST_ASSERT_EQUAL_INT(0, r[0].x);
+    TEST_ASSERT_EQUAL_INT(0, r[0].y);
+    TEST_ASSERT_EQUAL_INT(kW, r[0].w);
+    TEST_ASSERT_EQUAL_INT(kH, r[0].h);
+    TEST_ASSERT_EQUAL_INT(0, m.DirtyTileCount());
+    TEST_ASSERT_EQUAL_INT(0, m.TakeRects(r, kDirtyMaxRects));
+}
+
+void test_dirty_reset_rejects_oversize_frame(void)
+{
+    DirtyTileMap m;
+    TEST_ASSERT_FALSE(m.Reset(kDirtyMaxWidth + 1, kH));
+    TEST_ASSERT_FALSE(m.Reset(kW, 0));
+    TEST_ASSERT_EQUAL_INT(0, m.DirtyTileCount());
+    m.MarkAll();
+    TEST_ASSERT_EQUAL_INT(0, m.DirtyTileCount());
+}
+
+// ---------------------------------------------------------------------------
+// Scan
+// ---------------------------------------------------------------------------
+
+void test_dirty_unchanged_frame_pushes_nothing(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    Frame f(1);
+    f.Fill(40, 40, 100, 60, 0x1C);
+    f.Scan(m);
+
+    DirtyRect r[kDirtyMaxRects];
+    m.TakeRects(r, kDirtyMaxRects);                 // first frame: everything
+    TEST_ASSERT_EQUAL_INT(0, f.Scan(m));            // same pixels again
+    TEST_ASSERT_EQUAL_INT(0, m.TakeRects(r, kDirtyMaxRects));
+}
+
+void test_dirty_single_pixel_marks_one_tile(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    Frame f(2);
+    DirtyRect r[kDirtyMaxRects];
+    f.Scan(m);
+    m.TakeRects(r, kDirtyMaxRects);
+
+    f.Fill(37, 53, 1, 1, 0xFF);                     // tile (2, 3)
+    TEST_ASSERT_EQUAL_INT(1, f.Scan(m));
+    TEST_ASSERT_EQUAL_INT(1, m.TakeRects(r, kDirtyMaxRects));
+    TEST_ASSERT_EQUAL_INT(32, r[0].x);
+    TEST_ASSERT_EQUAL_INT(48, r[0].y);
+    TEST_ASSERT_EQUAL_INT(16, r[0].w);
+    TEST_ASSERT_EQUAL_INT(16, r[0].h);
+
+    // Reverting the pixel is a change too.
+    f.Fill(37, 53, 1, 1, 0x00);
+    TEST_ASSERT_EQUAL_INT(1, f.Scan(m));
+}
+
+void test_dirty_scan_accumulates_until_taken(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    Frame f(1);
+    DirtyRect r[kDirtyMaxRects];
+    f.Scan(m);
+    m.TakeRects(r, kDirtyMaxRects);
+
+    f.Fill(0, 0, 1, 1, 1);
+    f.Scan(m);
+    f.Fill(0, 0, 1, 1, 0);                          // back to the pushed content
+    TEST_ASSERT_EQUAL_INT(1, f.Scan(m));            // still owed a push
+}
+
+// ---------------------------------------------------------------------------
+// MarkRect / TakeRects
+// ---------------------------------------------------------------------------
+
+void test_dirty_markrect_clips_and_rounds_to_tiles(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    DirtyRect r[kDirtyMaxRects];
+    m.TakeRects(r, kDirtyMaxRects);
+
+    m.MarkRect(-10, 230, 30, 50);                   // bottom-left corner, off-frame
+    TEST_ASSERT_EQUAL_INT(2, m.DirtyTileCount());
+    TEST_ASSERT_EQUAL_INT(1, m.TakeRects(r, kDirtyMaxRects));
+    TEST_ASSERT_EQUAL_INT(0, r[0].x);
+    TEST_ASSERT_EQUAL_INT(224, r[0].y);
+    TEST_ASSERT_EQUAL_INT(32, r[0].w);
+    TEST_ASSERT_EQUAL_INT(16, r[0].h);
+
+    m.MarkRect(400, 10, 20, 20);                    // entirely off-frame
+    m.MarkRect(10, 10, 0, 20);                      // empty
+    TEST_ASSERT_EQUAL_INT(0, m.DirtyTileCount());
+}
+
+void test_dirty_rects_merge_vertically(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    DirtyRect r[kDirtyMaxRects];
+    m.TakeRects(r, kDirtyMaxRects);
+
+    // A vertical tape: same column span on five tile rows, plus a
+    // separate ball below it.
+    m.MarkRect(260, 20, 40, 70);
+    m.MarkRect(150, 200, 10, 10);
+    TEST_ASSERT_EQUAL_INT(2, m.TakeRects(r, kDirtyMaxRects));
+    TEST_ASSERT_EQUAL_INT(256, r[0].x);
+    TEST_ASSERT_EQUAL_INT(16, r[0].y);
+    TEST_ASSERT_EQUAL_INT(48, r[0].w);
+    TEST_ASSERT_EQUAL_INT(80, r[0].h);
+    TEST_ASSERT_EQUAL_INT(144, r[1].x);
+    TEST_ASSERT_EQUAL_INT(192, r[1].y);
+}
+
+void test_dirty_rects_cover_exactly_marked_tiles(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    DirtyRect r[kDirtyMaxRects];
+    m.TakeRects(r, kDirtyMaxRects);
+
+    // Checkerboard-ish scatter: 12 isolated tiles.
+    for (int i = 0; i < 12; ++i)
+        m.MarkRect((i * 3 % 20) * 16 + 1, (i % 15) * 16 + 1, 2, 2);
+    const int tiles = m.DirtyTileCount();
+    const int n     = m.TakeRects(r, kDirtyMaxRects);
+    TEST_ASSERT_EQUAL_INT(tiles * 16 * 16, Area(r, n));
+}
+
+void test_dirty_rect_overflow_falls_back_to_bounding_box(void)
+{
+    DirtyTileMap m;
+    m.Reset(kW, kH);
+    DirtyRect r[4];
+    m.TakeRects(r, 4);
+
+    // Six disjoint tiles on one row: more runs than slots.
+    for (int c = 0; c < 12; c += 2)
+        m.MarkRect(c * 16 + 32, 64, 1, 1);
+    TEST_ASSERT_EQUAL_INT(1, m.TakeRects(r, 4));
+    TEST_ASSERT_EQUAL_INT(32, r[0].x);
+    TEST_ASSERT_EQUAL_INT(64, r[0].y);
+    TEST_ASSERT_EQUAL_INT(10 * 16 + 16, r[0].w);
+    TEST_ASSERT_EQUAL_INT(16, r[0].h);
+    TEST_ASSERT_EQUAL_INT(0, m.DirtyTileCount());
+}
+
+void test_dirty_partial_edge_tiles_clip_to_frame(void)
+{
+    DirtyTileMap m;
+    TEST_ASSERT_TRUE(m.Reset(100, 50));
+    TEST_ASSERT_EQUAL_INT(7, m.Cols());
+    TEST_ASSERT_EQUAL_INT(4, m.Rows());
+
+    std::vector<uint8_t> px(100 * 50, 0);
+    DirtyRect r[kDirtyMaxRects];
+    m.Scan(px.data(), 1, 100);
+    m.TakeRects(r, kDirtyMaxRects);
+
+    px[49 * 100 + 99] = 7;                          // last pixel
+    TEST_ASSERT_EQUAL_INT(1, m.Scan(px.data(), 1, 100));
+    TEST_ASSERT_EQUAL_INT(1, m.TakeRects(r, kDirtyMaxRects));
+    TEST_ASSERT_EQUAL_INT(96, r[0].x);
+    TEST_ASSERT_EQUAL_INT(48, r[0].y);
+    TEST_ASSERT_EQUAL_INT(4, r[0].w);
+    TEST_ASSERT_EQUAL_INT(2, r[0].h);
+}
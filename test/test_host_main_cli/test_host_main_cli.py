@@ -19,6 +19,7 @@ from __future__ import annotations
 import json
 import math
 import os
+import struct
 import subprocess
 import sys
 from pathlib import Path
@@ -304,6 +305,53 @@ def test_build_frame_missing_arg_exits_nonzero():
     assert r.returncode != 0
 
 
+# ---------------------------------------------------------------------------
+# Subcommand: export_csv
+# ---------------------------------------------------------------------------
+
+
+def _osl_file_header(session_flags: int) -> bytes:
+    """16-byte .osl file header (proto/LogBin.h): magic, binVersion 1,
+    csvFormatVersion 6, sessionFlags, reserved."""
+    return b"OSLB" + struct.pack("<HHII", 1, 6, session_flags, 0)
+
+
+def test_export_csv_header_only(tmp_path):
+    """A header-only .osl (session closed before the first block) exports
+    just the CSV header line, with the session's optional column groups."""
+    osl = tmp_path / "log_001.osl"
+    osl.write_bytes(_osl_file_header(0x1 | 0x8))   # boom + flapsRawADC
+    r = run(["export_csv", "--input", str(osl)])
+    assert r.returncode == 0, r.stderr
+    lines = r.stdout.splitlines()
+    assert len(lines) == 1
+    cols = lines[0].split(",")
+    assert cols[0] == "timeStamp"
+    assert "boomAlpha" in cols
+    assert cols[-1] == "flapsRawADC"
+
+
+def test_export_csv_truncated_block_reports_and_succeeds(tmp_path):
+    """A power-yank leaves a partial final block; export still succeeds."""
+    osl = tmp_path / "log_002.osl"
+    osl.write_bytes(_osl_file_header(0) + b"OSBK" + b"\x01\x00")
+    out = tmp_path / "log_002.csv"
+    r = run(["export_csv", "--input", str(osl), "--output", str(out)])
+    assert r.returncode == 0, r.stderr
+    assert "truncated" in r.stderr
+    assert out.read_text().count("\n") == 1
+
+
+def test_export_csv_rejects_csv_input():
+    r = run(["export_csv", "--input", str(SHORT_REPLAY)])
+    assert r.returncode != 0
+
+
+def test_export_csv_missing_arg_exits_nonzero():
+    r = run(["export_csv"])
+    assert r.returncode != 0
+
+
 # ---------------------------------------------------------------------------
 # Subcommand: replay (CSV mode — regression against golden)
 # ---------------------------------------------------------------------------
@@ -552,5 +600,249 @@ def test_replay_log_rate_cli_validation():
         )
 
 
+# ---------------------------------------------------------------------------
+# --row-cache: parsed-row sidecar
+# ---------------------------------------------------------------------------
+
+EKFQ_SMOKE_INPUT  = REPO_ROOT / "tools" / "regression" / "fixtures" / "ekfq_substrate_smoke.csv"
+EKFQ_SMOKE_CONFIG = REPO_ROOT / "tools" / "regression" / "fixtures" / "ekfq_substrate_smoke.cfg"
+
+
+def test_replay_row_cache_round_trip(tmp_path):
+    """First --row-cache run writes <log>.rowcache; the second loads it and
+    produces byte-identical output to an uncached replay."""
+    if not REPLAY_ENGINE_INPUT.exists():
+        pytest.skip(f"replay_engine_input.csv not found: {REPLAY_ENGINE_INPUT}")
+    log = tmp_path / "log.csv"
+    log.write_bytes(REPLAY_ENGINE_INPUT.read_bytes())
+    cache = tmp_path / "log.csv.rowcache"
+
+    plain = run(["replay", "--input", str(log)])
+    assert plain.returncode == 0, plain.stderr
+    assert not cache.exists()
+
+    first = run(["replay", "--input", str(log), "--row-cache"])
+    assert first.returncode == 0, first.stderr
+    assert "wrote row cache" in first.stderr
+    assert cache.exists()
+
+    second = run(["replay", "--input", str(log), "--row-cache"])
+    assert second.returncode == 0, second.stderr
+    assert "loaded row cache" in second.stderr
+    assert first.stdout == plain.stdout
+    assert second.stdout == plain.stdout
+
+
+def test_replay_row_cache_invalidated_when_log_changes(tmp_path):
+    """Rewriting the log (new size and mtime) makes the sidecar stale; the
+    next run re-parses the CSV and rebuilds it."""
+    if not REPLAY_ENGINE_INPUT.exists():
+        pytest.skip(f"replay_engine_input.csv not found: {REPLAY_ENGINE_INPUT}")
+    log = tmp_path / "log.csv"
+    lines = REPLAY_ENGINE_INPUT.read_text().splitlines(keepends=True)
+    log.write_text("".join(lines))
+    assert run(["replay", "--input", str(log), "--row-cache"]).returncode == 0
+
+    log.write_text("".join(lines[:-20]))
+    st = log.stat()
+    os.utime(log, ns=(st.st_atime_ns, st.st_mtime_ns + 1_000_000_000))
+    expected = run(["replay", "--input", str(log)])
+    r = run(["replay", "--input", str(log), "--row-cache"])
+    assert r.returncode == 0, r.stderr
+    assert "stale" in r.stderr
+    assert "wrote row cache" in r.stderr
+    assert r.stdout == expected.stdout
+
+
+def test_ahrs_tone_sdlog_row_cache_keeps_passthrough(tmp_path):
+    """A cache hit still serves --passthrough-cols from the raw CSV text."""
+    if not EKFQ_SMOKE_INPUT.exists():
+        pytest.skip(f"ekfq_substrate_smoke.csv not found: {EKFQ_SMOKE_INPUT}")
+    log = tmp_path / "log.csv"
+    log.write_bytes(EKFQ_SMOKE_INPUT.read_bytes())
+    args = [
+        "ahrs_tone", "--algorithm", "ekfq", "--input-format", "sdlog",
+        "--input", str(log), "--config", str(EKFQ_SMOKE_CONFIG),
+        "--passthrough-cols", "vnPitch,vnRoll",
+    ]
+    plain = run(args)
+    assert plain.returncode == 0, plain.stderr
+    first = run(args + ["--row-cache"])
+    second = run(args + ["--row-cache"])
+    assert "loaded row cache" in second.stderr
+    assert first.stdout == plain.stdout
+    assert second.stdout == plain.stdout
+
+
+def test_row_cache_ignored_for_stdin():
+    if not REPLAY_ENGINE_INPUT.exists():
+        pytest.skip(f"replay_engine_input.csv not found: {REPLAY_ENGINE_INPUT}")
+    r = run(["replay", "--input", "-", "--row-cache"],
+            input=REPLAY_ENGINE_INPUT.read_text())
+    assert r.returncode == 0, r.stderr
+    assert "row cache" not in r.stderr
+
+
+# ---------------------------------------------------------------------------
+# Subcommand: ekfq_sweep
+# ---------------------------------------------------------------------------
+
+SWEEP_KV = "q_quat=1e-6\n---\n# second config\nq_quat=1e-3\nr_ax=5\n---\nr_baro=0.5\n"
+
+
+def _sweep(tmp_path, text, *extra):
+    sweep = tmp_path / "sweep.kv"
+    sweep.write_text(text)
+    return run([
+        "ekfq_sweep", "--input", str(EKFQ_SMOKE_INPUT),
+        "--config", str(EKFQ_SMOKE_CONFIG), "--sweep", str(sweep), *extra,
+    ])
+
+
+def test_ekfq_sweep_scores_each_config(tmp_path):
+    if not EKFQ_SMOKE_INPUT.exists():
+        pytest.skip(f"ekfq_substrate_smoke.csv not found: {EKFQ_SMOKE_INPUT}")
+    r = _sweep(tmp_path, SWEEP_KV)
+    assert r.returncode == 0, r.stderr
+    lines = r.stdout.strip().splitlines()
+    header = lines[0].split(",")
+    assert header[:2] == ["config", "loss"]
+    rows = [dict(zip(header, l.split(","))) for l in lines[1:]]
+    assert [row["config"] for row in rows] == ["0", "1", "2"]
+    for row in rows:
+        assert row["finite"] == "1"
+        assert math.isfinite(float(row["loss"])) and float(row["loss"]) > 0.0
+        assert int(row["fresh_vn_rows"]) > 0
+    # Different configs give different scores.
+    assert len({row["loss"] for row in rows}) == 3
+
+
+def test_ekfq_sweep_output_independent_of_thread_count(tmp_path):
+    if not EKFQ_SMOKE_INPUT.exists():
+        pytest.skip(f"ekfq_substrate_smoke.csv not found: {EKFQ_SMOKE_INPUT}")
+    one = _sweep(tmp_path, SWEEP_KV, "--threads", "1")
+    many = _sweep(tmp_path, SWEEP_KV, "--threads", "3")
+    assert one.returncode == 0 and many.returncode == 0
+    assert one.stdout == many.stdout
+
+
+def test_ekfq_sweep_rejects_bad_block(tmp_path):
+    if not EKFQ_SMOKE_INPUT.exists():
+        pytest.skip(f"ekfq_substrate_smoke.csv not found: {EKFQ_SMOKE_INPUT}")
+    r = _sweep(tmp_path, "q_quat=1e-6\n---\nq_qaut=1e-3\n")
+    assert r.returncode != 0
+    assert "config 1" in r.stderr
+
+
+def test_ekfq_sweep_sequential_update_matches_batch_loss(tmp_path):
+    # sequential_update is the batch update in exact arithmetic; on the
+    # regression fixture its loss must agree with batch to rounding.
+    if not EKFQ_SMOKE_INPUT.exists():
+        pytest.skip(f"ekfq_substrate_smoke.csv not found: {EKFQ_SMOKE_INPUT}")
+    r = _sweep(tmp_path, "sequential_update=0\n---\nsequential_update=1\n")
+    assert r.returncode == 0, r.stderr
+    lines = r.stdout.strip().splitlines()
+    header = lines[0].split(",")
+    batch, seq = (dict(zip(header, l.split(","))) for l in lines[1:])
+    assert batch["finite"] == "1" and seq["finite"] == "1"
+    for key in ("loss", "pitch_rms", "roll_rms", "vz_rms"):
+        assert float(seq[key]) == pytest.approx(float(batch[key]), rel=1e-3, abs=1e-5)
+
+
+def test_ekfq_sweep_missing_args_exits_nonzero():
+    r = run(["ekfq_sweep", "--input", str(EKFQ_SMOKE_INPUT)])
+    assert r.returncode != 0
+
+
+# ---------------------------------------------------------------------------
+# Subcommand: recalibrate
+# ---------------------------------------------------------------------------
+
+RECAL_HEADER = (
+    "timeStamp,Pfwd,PfwdSmoothed,P45,P45Smoothed,PStatic,Palt,IAS,AngleofAttack,"
+    "flapsPos,DataMark,OAT,TAS,imuTemp,VerticalG,LateralG,ForwardG,RollRate,"
+    "PitchRate,YawRate,Pitch,Roll,EarthVerticalG,FlightPath,VSI,Altitude,"
+    "DerivedAOA,CoeffP"
+)
+
+
+def _recal_aoa(cp: float, flaps_deg: int) -> float:
+    return -6.0 * cp * cp + 30.0 * cp - 2.0 + 0.05 * flaps_deg
+
+
+def _write_recal_log(path: Path, flaps_deg: int, t0: int = 0) -> None:
+    """A 10 s stabilized decel on one detent, then a 1.8 G pull-up whose
+    CP/AOA pairs are off the curve (the filter must drop them)."""
+    lines = [RECAL_HEADER]
+    for i in range(700):
+        t = t0 + 20 * i
+        pull = i >= 500
+        ias = 120.0 - 0.05 * i if not pull else 95.0
+        cp = 0.3 + 0.002 * i
+        aoa = _recal_aoa(cp, flaps_deg) + (5.0 if pull else 0.0)
+        g = 1.8 if pull else 1.0
+        lines.append(
+            f"{t},0,0,0,0,1000,0,{ias:.2f},{aoa:.2f},{flaps_deg},0,15,{ias:.2f},25,"
+            f"{g:.4f},0.0100,0,0,0,0,0,0,{g:.4f},0,0,0,{aoa:.4f},{cp:.5f}"
+        )
+    path.write_text("\n".join(lines) + "\n")
+
+
+def _recalibrate(*args):
+    r = run(["recalibrate", "--config", str(CONFIG_XML), *args])
+    assert r.returncode == 0, r.stderr
+    return json.loads(r.stdout)
+
+
+def test_recalibrate_recovers_curve_per_detent(tmp_path):
+    _write_recal_log(tmp_path / "a.csv", 0)
+    _write_recal_log(tmp_path / "b.csv", 16, t0=100000)
+    out = _recalibrate("--input", str(tmp_path / "a.csv"),
+                       "--input", str(tmp_path / "b.csv"))
+    assert out["files"] == 2
+    assert out["rows"] == 1400
+    assert out["rowsUsed"] == 1000
+    flaps = out["flaps"]
+    assert [f["degrees"] for f in flaps] == [0, 16, 33]
+    for f in flaps[:2]:
+        assert f["fitted"] is True
+        assert f["samples"] == 500 and f["segments"] == 1
+        a3, a2, a1, a0 = f["new"]
+        assert a3 == 0.0
+        assert a2 == pytest.approx(-6.0, abs=1e-2)
+        assert a1 == pytest.approx(30.0, abs=1e-2)
+        assert a0 == pytest.approx(-2.0 + 0.05 * f["degrees"], abs=1e-2)
+        assert f["r2"] > 0.9999
+        assert len(f["old"]) == 4
+        assert f["changed"] is True
+    assert flaps[2]["fitted"] is False
+    assert "new" not in flaps[2]
+
+
+def test_recalibrate_output_independent_of_thread_count(tmp_path):
+    paths = []
+    for k, deg in enumerate((0, 16, 0, 33)):
+        p = tmp_path / f"log{k}.csv"
+        _write_recal_log(p, deg, t0=k * 100000)
+        paths += ["--input", str(p)]
+    one = run(["recalibrate", "--config", str(CONFIG_XML), *paths, "--threads", "1"])
+    many = run(["recalibrate", "--config", str(CONFIG_XML), *paths, "--threads", "4"])
+    assert one.returncode == 0 and many.returncode == 0
+    assert one.stdout == many.stdout
+    assert json.loads(one.stdout)["flaps"][0]["segments"] == 2
+
+
+def test_recalibrate_short_segments_dropped(tmp_path):
+    _write_recal_log(tmp_path / "a.csv", 0)
+    out = _recalibrate("--input", str(tmp_path / "a.csv"), "--min-segment-ms", "20000")
+    assert out["rowsUsed"] == 0
+    assert out["flaps"][0]["fitted"] is False
+
+
+def test_recalibrate_missing_args_exits_nonzero():
+    assert run(["recalibrate", "--config", str(CONFIG_XML)]).returncode != 0
+    assert run(["recalibrate", "--input", str(SHORT_REPLAY)]).returncode != 0
+
+
 if __name__ == "__main__":
     sys.exit(pytest.main([__file__, "-v"]))
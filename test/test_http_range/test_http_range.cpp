@@ -0,0 +1,151 @@
+// test_http_range.cpp
+//
+// Unit tests for onspeed::api HttpRange — Range header parsing, If-Range
+// matching and the download validator used by GET /download.
+
+#include <unity.h>
+
+#include <cstring>
+
+#include <api/HttpRange.h>
+
+using onspeed::api::ByteRange;
+using onspeed::api::RangeRequest;
+namespace api = onspeed::api;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void test_absent_or_malformed_is_whole_file()
+{
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("items=0-10", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=abc-", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=10-5", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=-", 1000, &r) == RangeRequest::None);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=+5-10", 1000, &r) == RangeRequest::None);
+    // Multi-range: answered with the full file.
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=0-1,5-6", 1000, &r) == RangeRequest::None);
+}
+
+static void test_closed_range()
+{
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=100-199", 1000, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 100);
+    TEST_ASSERT_TRUE(r.last == 199);
+    TEST_ASSERT_TRUE(r.Length() == 100);
+
+    // Unit is case-insensitive; whitespace around the spec is tolerated.
+    TEST_ASSERT_TRUE(api::ParseRangeHeader(" Bytes= 0 - 0 ", 1000, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 0 && r.last == 0);
+}
+
+static void test_last_is_clamped_to_eof()
+{
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=900-5000", 1000, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 900);
+    TEST_ASSERT_TRUE(r.last == 999);
+}
+
+static void test_open_range_resumes_to_eof()
+{
+    // The resume request: everything after what the client already has.
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=123456-", 300000000ull, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 123456);
+    TEST_ASSERT_TRUE(r.last == 299999999ull);
+}
+
+static void test_suffix_range()
+{
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=-100", 1000, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 900 && r.last == 999);
+    // Longer than the file: whole file as a 206.
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=-5000", 1000, &r) == RangeRequest::Partial);
+    TEST_ASSERT_TRUE(r.first == 0 && r.last == 999);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=-0", 1000, &r) == RangeRequest::Unsatisfiable);
+}
+
+static void test_start_at_or_past_eof_is_unsatisfiable()
+{
+    ByteRange r;
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=1000-", 1000, &r) == RangeRequest::Unsatisfiable);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=2000-3000", 1000, &r) == RangeRequest::Unsatisfiable);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=0-", 0, &r) == RangeRequest::Unsatisfiable);
+    TEST_ASSERT_TRUE(api::ParseRangeHeader("bytes=-10", 0, &r) == RangeRequest::Unsatisfiable);
+}
+
+static void test_content_range_format()
+{
+    char buf[64];
+    ByteRange r;
+    r.first = 100;
+    r.last  = 199;
+    TEST_ASSERT_EQUAL(18, api::FormatContentRange(&r, 1000, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("bytes 100-199/1000", buf);
+    api::FormatContentRange(nullptr, 1000, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("bytes */1000", buf);
+    TEST_ASSERT_EQUAL(0, api::FormatContentRange(&r, 1000, buf, 8));
+    TEST_ASSERT_EQUAL('\0', buf[0]);
+}
+
+static void test_etag_is_strong_and_tracks_content()
+{
+    onspeed::log::LogMeta meta;
+    strncpy(meta.utcStart, "2026-04-18T14:32:07Z", sizeof(meta.utcStart) - 1);
+    meta.rowCount = 1000;
+
+    char a[32], b[32];
+    TEST_ASSERT_TRUE(api::FormatDownloadETag("log_007.csv", 4096, &meta, a, sizeof(a)) > 0);
+    TEST_ASSERT_EQUAL('"', a[0]);
+    TEST_ASSERT_EQUAL('"', a[strlen(a) - 1]);
+
+    // Deterministic.
+    api::FormatDownloadETag("log_007.csv", 4096, &meta, b, sizeof(b));
+    TEST_ASSERT_EQUAL_STRING(a, b);
+
+    // Size, name and session identity each change it.
+    api::FormatDownloadETag("log_007.csv", 4097, &meta, b, sizeof(b));
+    TEST_ASSERT_TRUE(strcmp(a, b) != 0);
+    api::FormatDownloadETag("log_008.csv", 4096, &meta, b, sizeof(b));
+    TEST_ASSERT_TRUE(strcmp(a, b) != 0);
+    onspeed::log::LogMeta other = meta;
+    other.utcStart[18] = '8';
+    api::FormatDownloadETag("log_007.csv", 4096, &other, b, sizeof(b));
+    TEST_ASSERT_TRUE(strcmp(a, b) != 0);
+    api::FormatDownloadETag("log_007.csv", 4096, nullptr, b, sizeof(b));
+    TEST_ASSERT_TRUE(strcmp(a, b) != 0);
+
+    // Worst case (max size) fits the documented 32 bytes.
+    TEST_ASSERT_TRUE(api::FormatDownloadETag("x", UINT64_MAX, &meta, a, sizeof(a)) > 0);
+}
+
+static void test_if_range()
+{
+    const char* etag = "\"1000-deadbeef\"";
+    TEST_ASSERT_TRUE(api::IfRangeMatches("", etag));
+    TEST_ASSERT_TRUE(api::IfRangeMatches("\"1000-deadbeef\"", etag));
+    TEST_ASSERT_FALSE(api::IfRangeMatches("\"1001-deadbeef\"", etag));
+    TEST_ASSERT_FALSE(api::IfRangeMatches("W/\"1000-deadbeef\"", etag));
+    TEST_ASSERT_FALSE(api::IfRangeMatches("Wed, 21 Oct 2015 07:28:00 GMT", etag));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_absent_or_malformed_is_whole_file);
+    RUN_TEST(test_closed_range);
+    RUN_TEST(test_last_is_clamped_to_eof);
+    RUN_TEST(test_open_range_resumes_to_eof);
+    RUN_TEST(test_suffix_range);
+    RUN_TEST(test_start_at_or_past_eof_is_unsatisfiable);
+    RUN_TEST(test_content_range_format);
+    RUN_TEST(test_etag_is_strong_and_tracks_content);
+    RUN_TEST(test_if_range);
+    return UNITY_END();
+}
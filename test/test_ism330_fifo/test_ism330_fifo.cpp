@@ -0,0 +1,270 @@
+// test_ism330_fifo.cpp — native tests for the ISM330DHCX FIFO decoder.
+//
+// Verifies:
+//   - ODR code table and INTERNAL_FREQ_FINE tick scaling.
+//   - FIFO_STATUS1/2 word count and overrun decoding.
+//   - Accel/gyro pairing in either order, timestamp stamping, exact
+//     per-sample dt across a 32-bit tick wrap, and the Q16 carry for
+//     a non-integer tick period.
+//   - Temperature words, unknown tags, unpaired / untimed / dropped
+//     accounting, and Reset().
+//   - IMU330::ReadFifo's burst size: 3 * outCap words never complete more
+//     than outCap pairs, even when a burst starts mid-triple.
+
+#include <unity.h>
+#include <sensors/Ism330Fifo.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using onspeed::sensors::Ism330DecodeFifoStatus;
+using onspeed::sensors::Ism330FifoDecoder;
+using onspeed::sensors::Ism330FifoSample;
+using onspeed::sensors::Ism330FifoStatus;
+using onspeed::sensors::Ism330OdrCode;
+using onspeed::sensors::Ism330TickUsForFreqFine;
+using onspeed::sensors::kIsm330FifoWordBytes;
+using onspeed::sensors::kIsm330TagAccel;
+using onspeed::sensors::kIsm330TagGyro;
+using onspeed::sensors::kIsm330TagTemperature;
+using onspeed::sensors::kIsm330TagTimestamp;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+// Builds a FIFO byte stream the way the sensor queues it.
+struct Fifo {
+    std::vector<uint8_t> bytes;
+    uint8_t              cnt = 0;
+
+    void Word(uint8_t tag, const uint8_t data[6])
+    {
+        bytes.push_back(static_cast<uint8_t>((tag << 3) | ((cnt++ & 3) << 1)));
+        bytes.insert(bytes.end(), data, data + 6);
+    }
+    void Xyz(uint8_t tag, int16_t x, int16_t y, int16_t z)
+    {
+        const int16_t v[3] = {x, y, z};
+        uint8_t d[6];
+        for (int k = 0; k < 3; ++k)
+        {
+            d[2 * k]     = static_cast<uint8_t>(v[k] & 0xFF);
+            d[2 * k + 1] = static_cast<uint8_t>((static_cast<uint16_t>(v[k]) >> 8) & 0xFF);
+        }
+        Word(tag, d);
+    }
+    void Ts(uint32_t tick)
+    {
+        const uint8_t d[6] = {static_cast<uint8_t>(tick), static_cast<uint8_t>(tick >> 8),
+                              static_cast<uint8_t>(tick >> 16), static_cast<uint8_t>(tick >> 24), 0, 0};
+        Word(kIsm330TagTimestamp, d);
+    }
+    int Words() const { return static_cast<int>(bytes.size()) / kIsm330FifoWordBytes; }
+};
+
+}  // namespace
+
+// ============================================================================
+// Register helpers
+// ============================================================================
+
+void test_odr_codes(void)
+{
+    TEST_ASSERT_EQUAL_UINT8(0, Ism330OdrCode(0));
+    TEST_ASSERT_EQUAL_UINT8(1, Ism330OdrCode(13));
+    TEST_ASSERT_EQUAL_UINT8(5, Ism330OdrCode(208));    // 0101, as IMU330 wrote by hand
+    TEST_ASSERT_EQUAL_UINT8(6, Ism330OdrCode(416));    // 0110
+    TEST_ASSERT_EQUAL_UINT8(7, Ism330OdrCode(833));    // 0111
+    TEST_ASSERT_EQUAL_UINT8(6, Ism330OdrCode(832));    // rounds down
+    TEST_ASSERT_EQUAL_UINT8(10, Ism330OdrCode(100000));
+}
+
+void test_tick_for_freq_fine(void)
+{
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 25.0f, Ism330TickUsForFreqFine(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 25.0f / 1.015f, Ism330TickUsForFreqFine(10));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 25.0f / 0.985f, Ism330TickUsForFreqFine(-10));
+}
+
+void test_fifo_status(void)
+{
+    Ism330FifoStatus s = Ism330DecodeFifoStatus(0x34, 0x02);
+    TEST_ASSERT_EQUAL_UINT16(0x234, s.words);
+    TEST_ASSERT_FALSE(s.overrun);
+    TEST_ASSERT_TRUE(Ism330DecodeFifoStatus(0, 0x40).overrun);   // FIFO_OVR_IA
+    TEST_ASSERT_TRUE(Ism330DecodeFifoStatus(0, 0x08).overrun);   // FIFO_OVR_LATCHED
+    TEST_ASSERT_FALSE(Ism330DecodeFifoStatus(0xFF, 0xB0).overrun);
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+void test_pairs_and_exact_dt(void)
+{
+    // 208 Hz batches: 4808 us = 192.32 ticks, so ticks alternate 192/193.
+    Fifo f;
+    const uint32_t ticks[4] = {1000, 1192, 1385, 1577};
+    for (int i = 0; i < 4; ++i)
+    {
+        f.Ts(ticks[i]);
+        if (i % 2) { f.Xyz(kIsm330TagAccel, 100 + i, -200, 4096); f.Xyz(kIsm330TagGyro, 7, -8, i); }
+        else       { f.Xyz(kIsm330TagGyro, 7, -8, i); f.Xyz(kIsm330TagAccel, 100 + i, -200, 4096); }
+    }
+
+    Ism330FifoDecoder dec;
+    Ism330FifoSample  out[8];
+    TEST_ASSERT_EQUAL_INT(4, dec.Decode(f.bytes.data(), f.Words(), out, 8));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0].dtUs);
+    TEST_ASSERT_EQUAL_UINT32(0, out[0].timestampUs);
+    TEST_ASSERT_EQUAL_UINT32(192 * 25, out[1].dtUs);
+    TEST_ASSERT_EQUAL_UINT32(193 * 25, out[2].dtUs);
+    TEST_ASSERT_EQUAL_UINT32(577 * 25, out[3].timestampUs);
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT_EQUAL_INT16(100 + i, out[i].accel[0]);
+        TEST_ASSERT_EQUAL_INT16(-200, out[i].accel[1]);
+        TEST_ASSERT_EQUAL_INT16(4096, out[i].accel[2]);
+        TEST_ASSERT_EQUAL_INT16(-8, out[i].gyro[1]);
+        TEST_ASSERT_EQUAL_INT16(i, out[i].gyro[2]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(12, dec.Stats().words);
+    TEST_ASSERT_EQUAL_UINT32(4, dec.Stats().samples);
+    TEST_ASSERT_EQUAL_UINT32(0, dec.Stats().unpaired);
+}
+
+void test_tick_wrap_and_fractional_period(void)
+{
+    // A trimmed 24.6 us tick across the 32-bit counter wrap: the Q16
+    // carry keeps 1000 samples of 10 ticks within 1 us of 246000 us.
+    Ism330FifoDecoder dec(24.6f);
+    Ism330FifoSample  out[1];
+    uint32_t tick = 0xFFFFFF00u;
+    uint32_t first = 0, last = 0;
+    for (int i = 0; i <= 1000; ++i, tick += 10)
+    {
+        Fifo f;
+        f.Ts(tick);
+        f.Xyz(kIsm330TagAccel, 0, 0, 0);
+        f.Xyz(kIsm330TagGyro, 0, 0, 0);
+        TEST_ASSERT_EQUAL_INT(1, dec.Decode(f.bytes.data(), f.Words(), out, 1));
+        if (i > 0) TEST_ASSERT_TRUE(out[0].dtUs == 246u || out[0].dtUs == 245u);
+        if (i == 0) first = out[0].timestampUs;
+        last = out[0].timestampUs;
+    }
+    TEST_ASSERT_UINT32_WITHIN(1, 246000u, last - first);
+}
+
+void test_temperature_and_other_tags(void)
+{
+    Fifo f;
+    const uint8_t temp[6] = {0x00, 0x02, 0, 0, 0, 0};   // 512 counts = +2 C
+    const uint8_t cfg[6]  = {0, 0, 0, 0, 0, 0};
+    f.Word(kIsm330TagTemperature, temp);
+    f.Word(0x05, cfg);                                  // CFG_Change
+    Ism330FifoDecoder dec;
+    Ism330FifoSample  out[1];
+    TEST_ASSERT_FALSE(dec.HasTemp());
+    TEST_ASSERT_EQUAL_INT(0, dec.Decode(f.bytes.data(), f.Words(), out, 1));
+    TEST_ASSERT_TRUE(dec.HasTemp());
+    TEST_ASSERT_EQUAL_INT16(512, dec.LastTempRaw());
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().temps);
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().otherTags);
+}
+
+void test_untimed_unpaired_and_dropped(void)
+{
+    Fifo f;
+    f.Xyz(kIsm330TagAccel, 1, 1, 1);                    // before any timestamp
+    f.Xyz(kIsm330TagGyro, 1, 1, 1);
+    f.Ts(50);
+    f.Xyz(kIsm330TagAccel, 2, 2, 2);
+    f.Xyz(kIsm330TagAccel, 3, 3, 3);                    // gyro went missing
+    f.Xyz(kIsm330TagGyro, 3, 3, 3);
+    f.Ts(242);
+    f.Xyz(kIsm330TagAccel, 4, 4, 4);
+    f.Xyz(kIsm330TagGyro, 4, 4, 4);
+
+    Ism330FifoDecoder dec;
+    Ism330FifoSample  out[1];
+    TEST_ASSERT_EQUAL_INT(1, dec.Decode(f.bytes.data(), f.Words(), out, 1));
+    TEST_ASSERT_EQUAL_INT16(3, out[0].accel[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().untimed);
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().unpaired);
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, dec.Stats().samples);
+}
+
+void test_reset_restarts_timeline(void)
+{
+    Fifo a;
+    a.Ts(100);
+    a.Xyz(kIsm330TagAccel, 0, 0, 0);
+    a.Xyz(kIsm330TagGyro, 0, 0, 0);
+    a.Ts(300);
+    a.Xyz(kIsm330TagAccel, 0, 0, 0);                    // half a pair left pending
+
+    Ism330FifoDecoder dec;
+    Ism330FifoSample  out[4];
+    TEST_ASSERT_EQUAL_INT(1, dec.Decode(a.bytes.data(), a.Words(), out, 4));
+    dec.Reset();
+
+    Fifo b;
+    b.Xyz(kIsm330TagGyro, 0, 0, 0);                     // must not pair with the stale accel
+    b.Ts(9000);
+    b.Xyz(kIsm330TagAccel, 0, 0, 0);
+    TEST_ASSERT_EQUAL_INT(1, dec.Decode(b.bytes.data(), b.Words(), out, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, out[0].dtUs);
+    TEST_ASSERT_EQUAL_UINT32(0, out[0].timestampUs);
+    TEST_ASSERT_EQUAL_UINT32(0, dec.Stats().unpaired);
+}
+
+void test_burst_of_three_words_per_sample_never_drops(void)
+{
+    constexpr int kSamples = 20;
+    constexpr int kCap     = 4;
+    Fifo f;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        f.Ts(static_cast<uint32_t>(100 + 192 * i));
+        f.Xyz(kIsm330TagGyro, static_cast<int16_t>(i), 0, 0);
+        f.Xyz(kIsm330TagAccel, static_cast<int16_t>(i), 0, 0);
+    }
+
+    // Bursts as ReadFifo sizes them, after a first wake that stopped two
+    // words into a triple.
+    Ism330FifoDecoder dec;
+    Ism330FifoSample  out[kCap];
+    int got  = dec.Decode(f.bytes.data(), 2, out, kCap);
+    int word = 2;
+    while (word < f.Words())
+    {
+        const int n = std::min(3 * kCap, f.Words() - word);
+        const int s = dec.Decode(f.bytes.data() + word * kIsm330FifoWordBytes, n, out, kCap);
+        TEST_ASSERT_TRUE(s <= kCap);
+        for (int i = 0; i < s; ++i)
+            TEST_ASSERT_EQUAL_INT16(got + i, out[i].gyro[0]);
+        got  += s;
+        word += n;
+    }
+    TEST_ASSERT_EQUAL_INT(kSamples, got);
+    TEST_ASSERT_EQUAL_UINT32(0, dec.Stats().dropped);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_odr_codes);
+    RUN_TEST(test_tick_for_freq_fine);
+    RUN_TEST(test_fifo_status);
+    RUN_TEST(test_pairs_and_exact_dt);
+    RUN_TEST(test_tick_wrap_and_fractional_period);
+    RUN_TEST(test_temperature_and_other_tags);
+    RUN_TEST(test_untimed_unpaired_and_dropped);
+    RUN_TEST(test_reset_restarts_timeline);
+    RUN_TEST(test_burst_of_three_words_per_sample_never_drops);
+    return UNITY_END();
+}
@@ -0,0 +1,242 @@
+// test_live_data_bin.cpp — unit tests for onspeed::proto LiveDataBin
+//
+// Covers:
+//   - Exact byte-level check against test/fixtures/live_data_bin/v1_cruise.bin
+//     (the same file tools/web/test/wsclient.mjs decodes, so the C++
+//     encoder and the JS DataView decoder are pinned to one artifact)
+//   - Round-trip of every field
+//   - NaN (JSON null) survives the round-trip
+//   - int16 saturation and dataMark low-16-bit wrap
+//   - Short buffer / wrong version → rejected
+
+#include <unity.h>
+#include <proto/LiveDataBin.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace onspeed::proto;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static std::string FindRepoRoot() {
+#ifdef ONSPEED_REPO_ROOT
+    return std::string(ONSPEED_REPO_ROOT);
+#else
+    std::string cwd = ".";
+    for (int i = 0; i < 8; ++i) {
+        std::ifstream f(cwd + "/platformio.ini");
+        if (f.good()) return cwd;
+        cwd += "/..";
+    }
+    return ".";
+#endif
+}
+
+// Inputs that produced v1_cruise.bin.  Every float is exactly
+// representable so the JS side can compare with ===.
+static LiveDataFrame cruiseFrame()
+{
+    LiveDataFrame f;
+    f.aoaDeg             = 4.25f;
+    f.pitchDeg           = -2.5f;
+    f.rollDeg            = 3.5f;
+    f.iasKt              = 87.5f;
+    f.paltFt             = 1234.0f;
+    f.verticalG          = 1.0f;
+    f.lateralG           = -0.0625f;
+    f.coeffP             = 0.75f;
+    f.vsiFpm             = -50.5f;
+    f.flightPathDeg      = -0.375f;
+    f.pitchRateDps       = 0.125f;
+    f.decelRate          = -0.25f;
+    f.oatC               = 22.5f;
+    f.derivedAoaDeg      = 4.125f;
+    f.gOnsetRate         = 0.25f;
+    f.percentLift        = 34.75f;
+    // ekf* left at their NaN defaults (Madgwick frame).
+    f.flapsPos           = 10;
+    f.flapIndex          = 1;
+    f.flapsMinDeg        = 0;
+    f.flapsMaxDeg        = 40;
+    f.tonesOnPctLift     = 18;
+    f.onSpeedFastPctLift = 32;
+    f.onSpeedSlowPctLift = 41;
+    f.stallWarnPctLift   = 56;
+    f.pipPctLift         = 20;
+    f.dataMark           = 12;
+    return f;
+}
+
+static std::vector<uint8_t> build(const LiveDataFrame& f)
+{
+    std::vector<uint8_t> buf(kLiveDataBinFrameSizeBytes + 8, 0xAA);
+    const size_t n = BuildLiveDataBinFrame(f, buf.data(), buf.size());
+    TEST_ASSERT_EQUAL(kLiveDataBinFrameSizeBytes, n);
+    buf.resize(n);
+    return buf;
+}
+
+// ----------------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------------
+
+void test_frame_matches_fixture_bytes(void)
+{
+    std::ifstream in(FindRepoRoot() + "/test/fixtures/live_data_bin/v1_cruise.bin",
+                     std::ios::binary);
+    TEST_ASSERT_TRUE_MESSAGE(in.good(), "v1_cruise.bin not found");
+    std::vector<uint8_t> want((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+
+    const std::vector<uint8_t> got = build(cruiseFrame());
+    TEST_ASSERT_EQUAL(want.size(), got.size());
+    TEST_ASSERT_EQUAL_MEMORY(want.data(), got.data(), got.size());
+}
+
+void test_header_layout(void)
+{
+    const std::vector<uint8_t> b = build(cruiseFrame());
+    TEST_ASSERT_EQUAL_HEX8(kLiveDataBinVersion, b[0]);
+    TEST_ASSERT_EQUAL_HEX8(0, b[1]);
+    TEST_ASSERT_EQUAL_HEX8(12, b[2]);   // dataMark, little-endian
+    TEST_ASSERT_EQUAL_HEX8(0, b[3]);
+    // AOA 4.25f = 0x40880000, little-endian at offset 4.
+    const uint8_t aoa[] = {0x00, 0x00, 0x88, 0x40};
+    TEST_ASSERT_EQUAL_MEMORY(aoa, &b[4], 4);
+    // pipPctLift is the last field.
+    TEST_ASSERT_EQUAL_HEX8(20, b[108]);
+    TEST_ASSERT_EQUAL_HEX8(0, b[109]);
+}
+
+void test_round_trip_all_fields(void)
+{
+    LiveDataFrame in = cruiseFrame();
+    in.ekfBpDps   = 0.0125f;
+    in.ekfBqDps   = -0.02f;
+    in.ekfBrDps   = 0.003f;
+    in.ekfBAzMps2 = -0.04f;
+    in.ekfBetaDeg = 1.5f;
+    in.ekfYawDeg  = 271.25f;
+
+    const std::vector<uint8_t> b = build(in);
+    const auto out = ParseLiveDataBinFrame(b.data(), b.size());
+    TEST_ASSERT_TRUE(out.has_value());
+
+    TEST_ASSERT_EQUAL_FLOAT(in.aoaDeg,        out->aoaDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.pitchDeg,      out->pitchDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.rollDeg,       out->rollDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.iasKt,         out->iasKt);
+    TEST_ASSERT_EQUAL_FLOAT(in.paltFt,        out->paltFt);
+    TEST_ASSERT_EQUAL_FLOAT(in.verticalG,     out->verticalG);
+    TEST_ASSERT_EQUAL_FLOAT(in.lateralG,      out->lateralG);
+    TEST_ASSERT_EQUAL_FLOAT(in.coeffP,        out->coeffP);
+    TEST_ASSERT_EQUAL_FLOAT(in.vsiFpm,        out->vsiFpm);
+    TEST_ASSERT_EQUAL_FLOAT(in.flightPathDeg, out->flightPathDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.pitchRateDps,  out->pitchRateDps);
+    TEST_ASSERT_EQUAL_FLOAT(in.decelRate,     out->decelRate);
+    TEST_ASSERT_EQUAL_FLOAT(in.oatC,          out->oatC);
+    TEST_ASSERT_EQUAL_FLOAT(in.derivedAoaDeg, out->derivedAoaDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.gOnsetRate,    out->gOnsetRate);
+    TEST_ASSERT_EQUAL_FLOAT(in.percentLift,   out->percentLift);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfBpDps,      out->ekfBpDps);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfBqDps,      out->ekfBqDps);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfBrDps,      out->ekfBrDps);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfBAzMps2,    out->ekfBAzMps2);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfBetaDeg,    out->ekfBetaDeg);
+    TEST_ASSERT_EQUAL_FLOAT(in.ekfYawDeg,     out->ekfYawDeg);
+
+    TEST_ASSERT_EQUAL_INT(in.flapsPos,           out->flapsPos);
+    TEST_ASSERT_EQUAL_INT(in.flapIndex,          out->flapIndex);
+    TEST_ASSERT_EQUAL_INT(in.flapsMinDeg,        out->flapsMinDeg);
+    TEST_ASSERT_EQUAL_INT(in.flapsMaxDeg,        out->flapsMaxDeg);
+    TEST_ASSERT_EQUAL_INT(in.tonesOnPctLift,     out->tonesOnPctLift);
+    TEST_ASSERT_EQUAL_INT(in.onSpeedFastPctLift, out->onSpeedFastPctLift);
+    TEST_ASSERT_EQUAL_INT(in.onSpeedSlowPctLift, out->onSpeedSlowPctLift);
+    TEST_ASSERT_EQUAL_INT(in.stallWarnPctLift,   out->stallWarnPctLift);
+    TEST_ASSERT_EQUAL_INT(in.pipPctLift,         out->pipPctLift);
+    TEST_ASSERT_EQUAL_INT(in.dataMark,           out->dataMark);
+}
+
+// A default frame is the "air data invalid, Madgwick" frame: every
+// nullable field decodes as NaN (the JSON path's `null`).
+void test_null_fields_round_trip_as_nan(void)
+{
+    const std::vector<uint8_t> b = build(LiveDataFrame{});
+    const auto out = ParseLiveDataBinFrame(b.data(), b.size());
+    TEST_ASSERT_TRUE(out.has_value());
+    TEST_ASSERT_TRUE(std::isnan(out->aoaDeg));
+    TEST_ASSERT_TRUE(std::isnan(out->iasKt));
+    TEST_ASSERT_TRUE(std::isnan(out->decelRate));
+    TEST_ASSERT_TRUE(std::isnan(out->derivedAoaDeg));
+    TEST_ASSERT_TRUE(std::isnan(out->percentLift));
+    TEST_ASSERT_TRUE(std::isnan(out->ekfYawDeg));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, out->pitchDeg);
+    TEST_ASSERT_EQUAL_INT(33, out->flapsMaxDeg);
+}
+
+void test_int_fields_saturate_and_datamark_wraps(void)
+{
+    LiveDataFrame in;
+    in.flapsPos    = 100000;
+    in.flapsMinDeg = -100000;
+    in.dataMark    = 65536 + 7;
+
+    const std::vector<uint8_t> b = build(in);
+    const auto out = ParseLiveDataBinFrame(b.data(), b.size());
+    TEST_ASSERT_TRUE(out.has_value());
+    TEST_ASSERT_EQUAL_INT(32767, out->flapsPos);
+    TEST_ASSERT_EQUAL_INT(-32768, out->flapsMinDeg);
+    TEST_ASSERT_EQUAL_INT(7, out->dataMark);
+}
+
+void test_build_rejects_short_buffer(void)
+{
+    uint8_t buf[kLiveDataBinFrameSizeBytes - 1];
+    TEST_ASSERT_EQUAL(0, BuildLiveDataBinFrame(LiveDataFrame{}, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(0, BuildLiveDataBinFrame(LiveDataFrame{}, nullptr, 512));
+}
+
+void test_parse_rejects_truncated_and_unknown_version(void)
+{
+    std::vector<uint8_t> b = build(cruiseFrame());
+    TEST_ASSERT_FALSE(ParseLiveDataBinFrame(b.data(), b.size() - 1).has_value());
+    TEST_ASSERT_FALSE(ParseLiveDataBinFrame(nullptr, b.size()).has_value());
+
+    b[0] = kLiveDataBinVersion + 1;
+    TEST_ASSERT_FALSE(ParseLiveDataBinFrame(b.data(), b.size()).has_value());
+}
+
+void test_select_messages_name_the_version(void)
+{
+    // The select message and the version byte move together.
+    TEST_ASSERT_EQUAL_INT(0, std::strncmp(kLiveDataBinSelectMsg, "fmt:bin", 7));
+    TEST_ASSERT_EQUAL_INT(kLiveDataBinVersion, std::atoi(kLiveDataBinSelectMsg + 7));
+    TEST_ASSERT_EQUAL_STRING("fmt:json", kLiveDataJsonSelectMsg);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_matches_fixture_bytes);
+    RUN_TEST(test_header_layout);
+    RUN_TEST(test_round_trip_all_fields);
+    RUN_TEST(test_null_fields_round_trip_as_nan);
+    RUN_TEST(test_int_fields_saturate_and_datamark_wraps);
+    RUN_TEST(test_build_rejects_short_buffer);
+    RUN_TEST(test_parse_rejects_truncated_and_unknown_version);
+    RUN_TEST(test_select_messages_name_the_version);
+    return UNITY_END();
+}
@@ -0,0 +1,496 @@
+// test_log_bin.cpp — unit tests for onspeed::proto::log_bin
+//
+// Tests cover:
+//   - File header write / read round-trip and session feature flags
+//   - Block round-trip per column-group variant (core, boom + VN-300,
+//     EFIS with an invalid efisPercentLift), compared bit-for-bit and
+//     through FormatRow
+//   - ExportCsv output byte-identical to WriteHeader + FormatRow
+//   - Truncated final block, corrupt payload CRC, unknown column bits
+//   - Presence change inside a block is refused
+
+#include <unity.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <proto/LogBin.h>
+#include <proto/LogCsv.h>
+#include <types/LogRow.h>
+
+using onspeed::LogRow;
+namespace bin = onspeed::proto::log_bin;
+namespace csv = onspeed::proto::log_csv;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static char s_lineA[csv::kRowMaxBytes];
+static char s_lineB[csv::kRowMaxBytes];
+
+// Distinct per-row values so a column-order or row-order slip shows up.
+static LogRow MakeRow(int i, bool boom, bool efis, bool vn300, bool flapsAdc)
+{
+    LogRow r;
+    r.boomEnabled        = boom;
+    r.efisEnabled        = efis;
+    r.efisIsVn300        = vn300;
+    r.flapsRawAdcPresent = flapsAdc;
+
+    r.timeStampMs      = 100000u + (uint32_t)i * 5u;
+    r.timeStampUs      = 100000000ull + (uint64_t)i * 4808ull;
+    r.pfwdCounts       = 1200 + i;
+    r.pfwdSmoothed     = 1200.25f + (float)i;
+    r.p45Counts        = -300 + i;
+    r.p45Smoothed      = -299.75f + (float)i;
+    r.pStaticMbar      = 901.23f;
+    r.paltFt           = 4500.0f + (float)i * 0.5f;
+    r.iasKt            = 85.0f + (float)i * 0.01f;
+    r.angleOfAttackDeg = 5.0f + (float)i * 0.001f;
+    r.flapsPos         = 10;
+    r.dataMark         = i / 10;
+    r.oatCelsius       = 15.6f;
+    r.tasKt            = 92.1f;
+    r.imuTempCelsius   = 38.75f;
+    r.imuVerticalG     = 1.003456f;
+    r.imuLateralG      = 0.012345f;
+    r.imuForwardG      = -0.034567f;
+    r.imuRollRateDps   = 0.123456f;
+    r.imuPitchRateDps  = -0.654321f;
+    r.imuYawRateDps    = 0.098765f;
+    r.pitchDeg         = 2.5f;
+    r.rollDeg          = -1.25f;
+
+    if (boom) {
+        r.boomStatic  = 901.1f;
+        r.boomDynamic = 12.34f;
+        r.boomAlpha   = 3.21f + (float)i * 0.01f;
+        r.boomBeta    = -0.5f;
+        r.boomIasKt   = 88.0f;
+        r.boomAgeMs   = 25;
+    }
+
+    if (efis && !vn300) {
+        r.efisIasKt            = 88.1f;
+        r.efisPitchDeg         = 2.2f;
+        r.efisRollDeg          = -0.8f;
+        r.efisLateralG         = 0.02f;
+        r.efisVerticalG        = 1.01f;
+        r.efisPercentLift      = 55 + i;
+        r.efisPercentLiftValid = (i % 3) != 0;
+        r.efisPaltFt           = 4480;
+        r.efisVsiFpm           = -120;
+        r.efisTasKt            = 93.4f;
+        r.efisOatCelsius       = 15.0f;
+        r.efisFuelRemaining    = 25.5f;
+        r.efisFuelFlow         = 8.3f;
+        r.efisMap              = 24.5f;
+        r.efisRpm              = 2400;
+        r.efisPercentPower     = 65;
+        r.efisMagHeading       = 270;
+        r.efisAgeMs            = 40;
+        r.efisTimestampMs      = 123400u;
+    }
+
+    if (efis && vn300) {
+        r.vnAngularRateRoll  = 0.11f;
+        r.vnAngularRatePitch = 0.22f;
+        r.vnAngularRateYaw   = 0.33f;
+        r.vnVelNedNorth      = 50.1f;
+        r.vnVelNedEast       = 10.2f;
+        r.vnVelNedDown       = -1.5f;
+        r.vnAccelFwd         = 0.05f;
+        r.vnAccelLat         = 0.01f;
+        r.vnAccelVert        = 9.82f;
+        r.vnYawDeg           = 270.0f;
+        r.vnPitchDeg         = 2.5f;
+        r.vnRollDeg          = -1.25f;
+        r.vnLinAccFwd        = 0.04f;
+        r.vnLinAccLat        = 0.0f;
+        r.vnLinAccVert       = 9.81f;
+        r.vnYawSigma         = 0.3f;
+        r.vnRollSigma        = 0.1f;
+        r.vnPitchSigma       = 0.1f;
+        r.vnGnssVelNedNorth  = 49.9f;
+        r.vnGnssVelNedEast   = 10.05f;
+        r.vnGnssVelNedDown   = -1.4f;
+        // Wind stays NaN on even rows (no GNSS solution yet).
+        r.vnWindSpd          = (i % 2) ? 12.5f : NAN;
+        r.vnWindDir          = (i % 2) ? 245.0f : NAN;
+        r.vnWindVertical     = (i % 2) ? -0.3f : NAN;
+        r.vnGnssLat          = 37.12345678901 + i * 1e-7;
+        r.vnGnssLon          = -122.65432109876;
+        r.vnEstAltFt         = 4521.75f;
+        r.vnGpsFix           = 3;
+        r.vnDataAgeMs        = 55;
+        r.vnTimeStartupNs    = 1'234'567'890ULL + (uint64_t)i;
+        r.vnTimeGpsNs        = 1'400'123'456'789'000ULL;
+        r.vnTimeStatus       = 0x07;
+    }
+
+    r.earthVerticalG = 0.98f;
+    r.flightPathDeg  = -1.5f;
+    r.vsiFpm         = -300.0f;
+    r.altitudeFt     = 4520.0f;
+    r.derivedAoaDeg  = 5.1234f;
+    r.coeffP         = 0.3456f;
+    r.ekfBpDps       = 0.0123f;
+    r.ekfBqDps       = -0.0456f;
+    r.ekfBrDps       = 0.0789f;
+    r.ekfBAzMps2     = -0.1234f;
+    r.ekfBetaDeg     = 0.45f;
+    r.ekfYawDeg      = 123.45f;
+
+    if (flapsAdc) r.flapsRawAdc = (uint16_t)(1462 + i);
+
+    // Air data dead on every 7th row (empty IAS / AOA cells).
+    r.iasValid = (i % 7) != 0;
+    return r;
+}
+
+// Build a complete .osl image from `rows`, flushing a block whenever
+// the encoder refuses a row.
+static std::vector<uint8_t> BuildImage(const std::vector<LogRow>& rows)
+{
+    std::vector<uint8_t> out(bin::kFileHeaderBytes);
+    TEST_ASSERT_EQUAL(bin::kFileHeaderBytes,
+                      bin::WriteFileHeader(rows.front(), out.data(), out.size()));
+
+    static bin::BlockEncoder enc;
+    static uint8_t block[bin::kMaxBlockBytes];
+    enc.Reset();
+    for (const LogRow& r : rows) {
+        if (!enc.Append(r)) {
+            size_t n = enc.Finish(block, sizeof(block));
+            TEST_ASSERT_TRUE(n > 0);
+            out.insert(out.end(), block, block + n);
+            TEST_ASSERT_TRUE(enc.Append(r));
+        }
+    }
+    size_t n = enc.Finish(block, sizeof(block));
+    out.insert(out.end(), block, block + n);
+    return out;
+}
+
+// Expected CSV text: header + one line per row, '\n'-joined.
+static std::string ExpectedCsv(const std::vector<LogRow>& rows)
+{
+    std::string s;
+    size_t n = csv::WriteHeader(rows.front(), s_lineA, sizeof(s_lineA));
+    s.append(s_lineA, n).push_back('\n');
+    for (const LogRow& r : rows) {
+        n = csv::FormatRow(r, s_lineA, sizeof(s_lineA));
+        s.append(s_lineA, n).push_back('\n');
+    }
+    return s;
+}
+
+static bool AppendLine(void* ctx, const char* line, size_t len)
+{
+    std::string* s = static_cast<std::string*>(ctx);
+    s->append(line, len).push_back('\n');
+    return true;
+}
+
+static std::vector<LogRow> MakeRows(int count, bool boom, bool efis, bool vn300,
+                                    bool flapsAdc)
+{
+    std::vector<LogRow> rows;
+    for (int i = 0; i < count; ++i)
+        rows.push_back(MakeRow(i, boom, efis, vn300, flapsAdc));
+    return rows;
+}
+
+// Every stored column decodes to the original bit pattern.
+static void AssertColumnsEqual(const LogRow& a, const LogRow& b)
+{
+    for (int c = 0; c < bin::kColumnCount; ++c) {
+        const bin::ColumnDesc& d = bin::kColumns[c];
+        bool present = true;
+        switch (d.group) {
+            case bin::ColGroup::Boom:        present = a.boomEnabled; break;
+            case bin::ColGroup::Efis:        present = a.efisEnabled && !a.efisIsVn300; break;
+            case bin::ColGroup::Vn300:       present = a.efisEnabled && a.efisIsVn300; break;
+            case bin::ColGroup::FlapsRawAdc: present = a.flapsRawAdcPresent; break;
+            default: break;
+        }
+        if (!present) continue;
+        const uint8_t* pa = reinterpret_cast<const uint8_t*>(&a) + d.offset;
+        const uint8_t* pb = reinterpret_cast<const uint8_t*>(&b) + d.offset;
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(pa, pb, bin::ColTypeBytes(d.type), d.name);
+    }
+}
+
+static void AssertBlockRoundTrip(bool boom, bool efis, bool vn300, bool flapsAdc)
+{
+    static bin::BlockEncoder enc;
+    static uint8_t block[bin::kMaxBlockBytes];
+    enc.Reset();
+    std::vector<LogRow> rows = MakeRows(bin::kRowsPerBlock, boom, efis, vn300, flapsAdc);
+    for (const LogRow& r : rows)
+        TEST_ASSERT_TRUE(enc.Append(r));
+    TEST_ASSERT_TRUE(enc.Full());
+    TEST_ASSERT_FALSE(enc.Append(rows[0]));
+
+    const size_t expect = enc.EncodedBytes();
+    const size_t n = enc.Finish(block, sizeof(block));
+    TEST_ASSERT_EQUAL(expect, n);
+    TEST_ASSERT_TRUE(enc.Empty());
+
+    bin::BlockView view;
+    size_t used = 0;
+    TEST_ASSERT_EQUAL(bin::BlockStatus::Ok, bin::DecodeBlock(block, n, view, &used));
+    TEST_ASSERT_EQUAL(n, used);
+    TEST_ASSERT_EQUAL(bin::kRowsPerBlock, view.rowCount);
+
+    for (int i = 0; i < view.rowCount; ++i) {
+        LogRow out;
+        TEST_ASSERT_TRUE(bin::GetRow(view, i, out));
+        TEST_ASSERT_EQUAL(boom,     out.boomEnabled);
+        TEST_ASSERT_EQUAL(efis,     out.efisEnabled);
+        TEST_ASSERT_EQUAL(vn300,    out.efisIsVn300);
+        TEST_ASSERT_EQUAL(flapsAdc, out.flapsRawAdcPresent);
+        AssertColumnsEqual(rows[i], out);
+
+        size_t la = csv::FormatRow(rows[i], s_lineA, sizeof(s_lineA));
+        size_t lb = csv::FormatRow(out, s_lineB, sizeof(s_lineB));
+        TEST_ASSERT_EQUAL(la, lb);
+        TEST_ASSERT_EQUAL_MEMORY(s_lineA, s_lineB, la);
+    }
+    LogRow dummy;
+    TEST_ASSERT_FALSE(bin::GetRow(view, view.rowCount, dummy));
+}
+
+// ---------------------------------------------------------------------------
+// File header
+// ---------------------------------------------------------------------------
+
+void test_file_header_round_trip(void)
+{
+    LogRow session;
+    session.boomEnabled        = true;
+    session.efisEnabled        = true;
+    session.efisIsVn300        = true;
+    session.flapsRawAdcPresent = false;
+
+    uint8_t hdr[bin::kFileHeaderBytes];
+    TEST_ASSERT_EQUAL(bin::kFileHeaderBytes,
+                      bin::WriteFileHeader(session, hdr, sizeof(hdr)));
+    TEST_ASSERT_EQUAL_MEMORY("OSLB", hdr, 4);
+
+    bin::FileInfo info;
+    TEST_ASSERT_TRUE(bin::ReadFileHeader(hdr, sizeof(hdr), info));
+    TEST_ASSERT_EQUAL(bin::kBinVersion, info.binVersion);
+    TEST_ASSERT_EQUAL(csv::kFormatVersion, info.csvFormatVersion);
+
+    LogRow back = bin::SessionRow(info);
+    TEST_ASSERT_TRUE(back.boomEnabled);
+    TEST_ASSERT_TRUE(back.efisEnabled);
+    TEST_ASSERT_TRUE(back.efisIsVn300);
+    TEST_ASSERT_FALSE(back.flapsRawAdcPresent);
+}
+
+void test_file_header_rejects_short_and_bad_magic(void)
+{
+    uint8_t hdr[bin::kFileHeaderBytes];
+    LogRow session;
+    TEST_ASSERT_EQUAL(0, bin::WriteFileHeader(session, hdr, sizeof(hdr) - 1));
+    bin::WriteFileHeader(session, hdr, sizeof(hdr));
+
+    bin::FileInfo info;
+    TEST_ASSERT_FALSE(bin::ReadFileHeader(hdr, sizeof(hdr) - 1, info));
+    hdr[0] = 'X';
+    TEST_ASSERT_FALSE(bin::ReadFileHeader(hdr, sizeof(hdr), info));
+}
+
+// ---------------------------------------------------------------------------
+// Block round-trips
+// ---------------------------------------------------------------------------
+
+void test_block_round_trip_core_only(void)
+{
+    AssertBlockRoundTrip(false, false, false, false);
+}
+
+void test_block_round_trip_boom_vn300_flaps_adc(void)
+{
+    AssertBlockRoundTrip(true, true, true, true);
+}
+
+void test_block_round_trip_efis(void)
+{
+    AssertBlockRoundTrip(false, true, false, false);
+}
+
+void test_widest_block_fits_max_block_bytes(void)
+{
+    static bin::BlockEncoder enc;
+    enc.Reset();
+    for (const LogRow& r : MakeRows(bin::kRowsPerBlock, true, true, true, true))
+        enc.Append(r);
+    TEST_ASSERT_TRUE(enc.EncodedBytes() <= bin::kMaxBlockBytes);
+}
+
+void test_presence_change_starts_new_block(void)
+{
+    static bin::BlockEncoder enc;
+    enc.Reset();
+    TEST_ASSERT_TRUE(enc.Append(MakeRow(0, false, false, false, false)));
+    TEST_ASSERT_FALSE(enc.Append(MakeRow(1, true, false, false, false)));
+    TEST_ASSERT_EQUAL(1, enc.RowCount());
+}
+
+void test_finish_keeps_rows_when_buffer_small(void)
+{
+    static bin::BlockEncoder enc;
+    enc.Reset();
+    enc.Append(MakeRow(0, false, false, false, false));
+    uint8_t small[bin::kBlockHeaderBytes];
+    TEST_ASSERT_EQUAL(0, enc.Finish(small, sizeof(small)));
+    TEST_ASSERT_EQUAL(1, enc.RowCount());
+}
+
+// ---------------------------------------------------------------------------
+// CSV export
+// ---------------------------------------------------------------------------
+
+void test_export_matches_format_row_multi_block(void)
+{
+    // 100 rows = three full blocks plus a 4-row tail.
+    std::vector<LogRow> rows = MakeRows(100, true, true, false, true);
+    std::vector<uint8_t> img = BuildImage(rows);
+
+    std::string got;
+    bin::ExportResult res;
+    TEST_ASSERT_TRUE(bin::ExportCsv(img.data(), img.size(), AppendLine, &got, &res));
+    TEST_ASSERT_EQUAL(100, res.rows);
+    TEST_ASSERT_EQUAL(4, res.blocks);
+    TEST_ASSERT_EQUAL(0, res.skippedBlocks);
+    TEST_ASSERT_EQUAL(bin::BlockStatus::Ok, res.status);
+    TEST_ASSERT_EQUAL(img.size(), res.bytesConsumed);
+    TEST_ASSERT_TRUE(ExpectedCsv(rows) == got);
+}
+
+void test_export_header_only_file(void)
+{
+    std::vector<uint8_t> img(bin::kFileHeaderBytes);
+    LogRow session;
+    session.efisEnabled = true;
+    bin::WriteFileHeader(session, img.data(), img.size());
+
+    std::string got;
+    bin::ExportResult res;
+    TEST_ASSERT_TRUE(bin::ExportCsv(img.data(), img.size(), AppendLine, &got, &res));
+    TEST_ASSERT_EQUAL(0, res.rows);
+    size_t n = csv::WriteHeader(session, s_lineA, sizeof(s_lineA));
+    TEST_ASSERT_TRUE(std::string(s_lineA, n) + "\n" == got);
+}
+
+void test_export_stops_at_truncated_tail(void)
+{
+    std::vector<LogRow> rows = MakeRows(2 * bin::kRowsPerBlock, false, false, false, false);
+    std::vector<uint8_t> img = BuildImage(rows);
+    const size_t full = img.size();
+    img.resize(full - 10);   // power-yank inside the second block
+
+    std::string got;
+    bin::ExportResult res;
+    TEST_ASSERT_TRUE(bin::ExportCsv(img.data(), img.size(), AppendLine, &got, &res));
+    TEST_ASSERT_EQUAL(bin::kRowsPerBlock, res.rows);
+    TEST_ASSERT_EQUAL(bin::BlockStatus::Truncated, res.status);
+
+    rows.resize(bin::kRowsPerBlock);
+    TEST_ASSERT_TRUE(ExpectedCsv(rows) == got);
+}
+
+void test_export_skips_bad_crc_block(void)
+{
+    std::vector<LogRow> rows = MakeRows(3 * bin::kRowsPerBlock, false, true, true, false);
+    std::vector<uint8_t> img = BuildImage(rows);
+
+    // Flip a payload byte in the middle block.
+    const size_t blockBytes = (img.size() - bin::kFileHeaderBytes) / 3;
+    img[bin::kFileHeaderBytes + blockBytes + bin::kBlockHeaderBytes + 5] ^= 0x40;
+
+    std::string got;
+    bin::ExportResult res;
+    TEST_ASSERT_TRUE(bin::ExportCsv(img.data(), img.size(), AppendLine, &got, &res));
+    TEST_ASSERT_EQUAL(2 * bin::kRowsPerBlock, res.rows);
+    TEST_ASSERT_EQUAL(1, res.skippedBlocks);
+    TEST_ASSERT_EQUAL(bin::BlockStatus::BadCrc, res.status);
+
+    rows.erase(rows.begin() + bin::kRowsPerBlock, rows.begin() + 2 * bin::kRowsPerBlock);
+    TEST_ASSERT_TRUE(ExpectedCsv(rows) == got);
+}
+
+void test_decode_rejects_unknown_column(void)
+{
+    std::vector<uint8_t> img = BuildImage(MakeRows(4, false, false, false, false));
+    uint8_t* blk = img.data() + bin::kFileHeaderBytes;
+    blk[16 + 7] |= 0x80;   // presence bit 127
+
+    bin::BlockView view;
+    size_t used = 123;
+    TEST_ASSERT_EQUAL(bin::BlockStatus::UnknownColumn,
+                      bin::DecodeBlock(blk, img.size() - bin::kFileHeaderBytes, view, &used));
+    TEST_ASSERT_EQUAL(0, used);
+}
+
+void test_decode_rejects_bad_length(void)
+{
+    std::vector<uint8_t> img = BuildImage(MakeRows(4, false, false, false, false));
+    uint8_t* blk = img.data() + bin::kFileHeaderBytes;
+    blk[6] = 5;   // rowCount no longer matches payloadBytes
+
+    bin::BlockView view;
+    size_t used = 0;
+    TEST_ASSERT_EQUAL(bin::BlockStatus::BadLength,
+                      bin::DecodeBlock(blk, img.size() - bin::kFileHeaderBytes, view, &used));
+}
+
+static bool AbortAfterHeader(void* ctx, const char*, size_t)
+{
+    int* calls = static_cast<int*>(ctx);
+    return ++*calls < 2;
+}
+
+void test_export_sink_abort_returns_false(void)
+{
+    std::vector<uint8_t> img = BuildImage(MakeRows(4, false, false, false, false));
+    int calls = 0;
+    TEST_ASSERT_FALSE(bin::ExportCsv(img.data(), img.size(), AbortAfterHeader, &calls));
+    TEST_ASSERT_EQUAL(2, calls);
+}
+
+// ---------------------------------------------------------------------------
+
+int main(int, char**)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_file_header_round_trip);
+    RUN_TEST(test_file_header_rejects_short_and_bad_magic);
+
+    RUN_TEST(test_block_round_trip_core_only);
+    RUN_TEST(test_block_round_trip_boom_vn300_flaps_adc);
+    RUN_TEST(test_block_round_trip_efis);
+    RUN_TEST(test_widest_block_fits_max_block_bytes);
+    RUN_TEST(test_presence_change_starts_new_block);
+    RUN_TEST(test_finish_keeps_rows_when_buffer_small);
+
+    RUN_TEST(test_export_matches_format_row_multi_block);
+    RUN_TEST(test_export_header_only_file);
+    RUN_TEST(test_export_stops_at_truncated_tail);
+    RUN_TEST(test_export_skips_bad_crc_block);
+    RUN_TEST(test_decode_rejects_unknown_column);
+    RUN_TEST(test_decode_rejects_bad_length);
+    RUN_TEST(test_export_sink_abort_returns_false);
+
+    return UNITY_END();
+}
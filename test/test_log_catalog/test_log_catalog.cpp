@@ -0,0 +1,348 @@
+// test_log_catalog.cpp
+//
+// Unit tests for onspeed::log::LogCatalog — the /logs listing journal,
+// and its reconcile against a directory listing.
+
+#include <unity.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <log/LogCatalog.h>
+
+using onspeed::log::EfisType;
+using onspeed::log::LogCatalog;
+using onspeed::log::LogCatalogEntry;
+using onspeed::log::LogCatalogListedFile;
+namespace lm = onspeed::log;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static LogCatalogEntry MakeEntry(const char* name, uint64_t size)
+{
+    LogCatalogEntry e;
+    strncpy(e.name, name, sizeof(e.name) - 1);
+    e.size = size;
+    return e;
+}
+
+static LogCatalogEntry MakeFullEntry()
+{
+    LogCatalogEntry e = MakeEntry("2026-04-18_007.csv", 123456789012ull);
+    e.hasMeta = true;
+    e.hasDbg  = true;
+    strncpy(e.meta.firmware,    "4.19.0",  sizeof(e.meta.firmware)    - 1);
+    strncpy(e.meta.firmwareSha, "abc1234", sizeof(e.meta.firmwareSha) - 1);
+    e.meta.durationMs = 5432100u;
+    e.meta.rowCount   = 271605u;
+    e.meta.maxIasKt   = 142.3f;
+    e.meta.maxPaltFt  = 8420.0f;
+    e.meta.efisType   = EfisType::Vn300;
+    e.meta.gpsFixSeen = true;
+    strncpy(e.meta.utcStart,       "2026-04-18T14:32:07Z", sizeof(e.meta.utcStart)       - 1);
+    strncpy(e.meta.timeOfDayStart, "14:32:07",             sizeof(e.meta.timeOfDayStart) - 1);
+    return e;
+}
+
+static std::string Header()
+{
+    char buf[64];
+    size_t n = LogCatalog::FormatHeader(buf, sizeof(buf));
+    return std::string(buf, n);
+}
+
+static std::string Upsert(const LogCatalogEntry& e)
+{
+    char buf[lm::kLogCatalogMaxLineLen];
+    size_t n = LogCatalog::FormatUpsert(e, buf, sizeof(buf));
+    TEST_ASSERT_TRUE(n > 0);
+    return std::string(buf, n);
+}
+
+static std::string Remove(const char* name)
+{
+    char buf[64];
+    size_t n = LogCatalog::FormatRemove(name, buf, sizeof(buf));
+    TEST_ASSERT_TRUE(n > 0);
+    return std::string(buf, n);
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+static void test_round_trip_full_entry()
+{
+    const LogCatalogEntry in = MakeFullEntry();
+    const std::string text = Header() + Upsert(in);
+
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    TEST_ASSERT_EQUAL(1, cat.Entries().size());
+
+    const LogCatalogEntry& out = cat.Entries()[0];
+    TEST_ASSERT_EQUAL_STRING("2026-04-18_007.csv", out.name);
+    TEST_ASSERT_TRUE(out.size == 123456789012ull);
+    TEST_ASSERT_TRUE(out.hasMeta);
+    TEST_ASSERT_TRUE(out.hasDbg);
+    TEST_ASSERT_EQUAL_STRING("4.19.0", out.meta.firmware);
+    TEST_ASSERT_EQUAL_STRING("abc1234", out.meta.firmwareSha);
+    TEST_ASSERT_EQUAL_UINT32(5432100u, out.meta.durationMs);
+    TEST_ASSERT_EQUAL_UINT32(271605u, out.meta.rowCount);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 142.3f, out.meta.maxIasKt);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 8420.0f, out.meta.maxPaltFt);
+    TEST_ASSERT_EQUAL(EfisType::Vn300, out.meta.efisType);
+    TEST_ASSERT_TRUE(out.meta.gpsFixSeen);
+    TEST_ASSERT_EQUAL_STRING("2026-04-18T14:32:07Z", out.meta.utcStart);
+    TEST_ASSERT_EQUAL_STRING("14:32:07", out.meta.timeOfDayStart);
+}
+
+static void test_entry_without_meta_has_empty_strings()
+{
+    const std::string text = Header() + Upsert(MakeEntry("boot_log.txt", 42));
+
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    const LogCatalogEntry* e = cat.Find("boot_log.txt");
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_FALSE(e->hasMeta);
+    TEST_ASSERT_FALSE(e->hasDbg);
+    TEST_ASSERT_EQUAL_STRING("", e->meta.firmware);
+    TEST_ASSERT_EQUAL_STRING("", e->meta.timeOfDayStart);
+}
+
+static void test_replay_upsert_replaces_and_remove_drops()
+{
+    // The Open -> refresh -> Close-with-rename sequence LogSensor journals.
+    LogCatalogEntry active = MakeEntry("log_007.csv", 0);
+    LogCatalogEntry refreshed = MakeEntry("log_007.csv", 40960);
+    refreshed.hasMeta = true;
+    refreshed.meta.rowCount = 6240;
+    LogCatalogEntry renamed = refreshed;
+    strncpy(renamed.name, "2026-04-18_007.csv", sizeof(renamed.name) - 1);
+    renamed.size = 81920;
+
+    const std::string text = Header()
+                           + Upsert(MakeEntry("log_006.csv", 1000))
+                           + Upsert(active)
+                           + Upsert(refreshed)
+                           + Remove("log_007.csv")
+                           + Upsert(renamed);
+
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    TEST_ASSERT_EQUAL(2, cat.Entries().size());
+    TEST_ASSERT_NULL(cat.Find("log_007.csv"));
+    const LogCatalogEntry* e = cat.Find("2026-04-18_007.csv");
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_TRUE(e->size == 81920);
+    TEST_ASSERT_EQUAL_UINT32(6240u, e->meta.rowCount);
+    // Insertion order is preserved for untouched entries.
+    TEST_ASSERT_EQUAL_STRING("log_006.csv", cat.Entries()[0].name);
+    TEST_ASSERT_EQUAL(5, cat.RecordCount());
+}
+
+static void test_names_match_case_insensitively()
+{
+    const std::string text = Header()
+                           + Upsert(MakeEntry("LOG_001.CSV", 10))
+                           + Upsert(MakeEntry("log_001.csv", 20));
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    TEST_ASSERT_EQUAL(1, cat.Entries().size());
+    TEST_ASSERT_TRUE(cat.Find("Log_001.Csv")->size == 20);
+    TEST_ASSERT_TRUE(cat.Remove("LOG_001.csv"));
+    TEST_ASSERT_EQUAL(0, cat.Entries().size());
+}
+
+static void test_bad_header_is_rejected()
+{
+    LogCatalog cat;
+    TEST_ASSERT_FALSE(cat.Load(""));
+    TEST_ASSERT_FALSE(cat.Valid());
+    TEST_ASSERT_FALSE(cat.Load("onspeed-logcat 999\n" + Upsert(MakeEntry("a.csv", 1))));
+    TEST_ASSERT_EQUAL(0, cat.Entries().size());
+    TEST_ASSERT_FALSE(cat.Load(Upsert(MakeEntry("a.csv", 1))));
+    TEST_ASSERT_EQUAL(0, cat.Entries().size());
+}
+
+static void test_torn_final_line_is_ignored()
+{
+    std::string text = Header()
+                     + Upsert(MakeEntry("log_001.csv", 10))
+                     + Upsert(MakeEntry("log_002.csv", 20));
+    text.pop_back();   // power lost before the '\n' landed
+
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    TEST_ASSERT_EQUAL(1, cat.Entries().size());
+    TEST_ASSERT_NULL(cat.Find("log_002.csv"));
+}
+
+static void test_malformed_records_are_skipped()
+{
+    const std::string text = Header()
+                           + "+\tshort.csv\t12\n"
+                           + "+\tbad.csv\tnotanumber\t0\t0\t0\t0\t0.0\t0\t\t\tnone\t0\t\t\n"
+                           + "?\tweird\n"
+                           + Upsert(MakeEntry("good.csv", 7));
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(text));
+    TEST_ASSERT_EQUAL(1, cat.Entries().size());
+    TEST_ASSERT_EQUAL_STRING("good.csv", cat.Entries()[0].name);
+}
+
+static void test_separators_in_strings_are_sanitized()
+{
+    LogCatalogEntry e = MakeEntry("log_001.csv", 5);
+    e.hasMeta = true;
+    strncpy(e.meta.firmware, "4.1\t9\n", sizeof(e.meta.firmware) - 1);
+
+    const std::string line = Upsert(e);
+    TEST_ASSERT_EQUAL('\n', line.back());
+    TEST_ASSERT_TRUE(line.find('\n') == line.size() - 1);
+
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.Load(Header() + line));
+    TEST_ASSERT_EQUAL_STRING("4.1_9_", cat.Entries()[0].meta.firmware);
+}
+
+static void test_format_rejects_small_buffer()
+{
+    char buf[16];
+    TEST_ASSERT_EQUAL(0, LogCatalog::FormatUpsert(MakeFullEntry(), buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL('\0', buf[0]);
+    TEST_ASSERT_EQUAL(0, LogCatalog::FormatRemove("", buf, sizeof(buf)));
+}
+
+static void test_compaction_threshold()
+{
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.ApplyLine(lm::kLogCatalogHeader));
+    for (int i = 0; i < 10; ++i)
+        cat.Upsert(MakeEntry("log_001.csv", static_cast<uint64_t>(i)));
+    TEST_ASSERT_FALSE(cat.NeedsCompaction());
+    for (int i = 0; i < 30; ++i)
+        cat.Upsert(MakeEntry("log_001.csv", static_cast<uint64_t>(i)));
+    TEST_ASSERT_TRUE(cat.NeedsCompaction());
+}
+
+static void test_hidden_names()
+{
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName("log_001.meta"));
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName("LOG_001.META.TMP"));
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName("log_001.dbg"));
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName("log_001.pvw"));
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName(lm::kLogCatalogFileName));
+    TEST_ASSERT_TRUE(lm::IsLogCatalogHiddenName(lm::kLogCatalogTmpFileName));
+    TEST_ASSERT_FALSE(lm::IsLogCatalogHiddenName("log_001.csv"));
+    TEST_ASSERT_FALSE(lm::IsLogCatalogHiddenName("log_001.osl"));
+    TEST_ASSERT_FALSE(lm::IsLogCatalogHiddenName("boot_log.txt"));
+}
+
+// Counts reads and marks each read entry as having a .dbg.
+static void CountingReader(void* ctx, LogCatalogEntry& e)
+{
+    ++*static_cast<int*>(ctx);
+    e.hasDbg = true;
+}
+
+static void test_reconcile_adds_refreshes_and_drops()
+{
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.ApplyLine(lm::kLogCatalogHeader));
+    cat.Upsert(MakeEntry("log_003.csv", 300));
+    cat.Upsert(MakeEntry("LOG_001.CSV", 100));   // listed in lower case below
+    cat.Upsert(MakeEntry("log_002.osl", 200));   // resized
+    cat.Upsert(MakeEntry("gone.csv", 5));
+    cat.Upsert(MakeEntry("also_gone.csv", 6));
+
+    const LogCatalogListedFile files[] = {
+        {"log_004.csv", 400},
+        {"log_002.osl", 250},
+        {"log_001.csv", 100},
+        {"log_001.meta", 40},                     // hidden
+        {"log_003.csv", 300},
+        {"a_name_far_too_long_for_an_entry_row.csv", 1},
+    };
+    int reads = 0;
+    TEST_ASSERT_TRUE(cat.Reconcile(files, 6, CountingReader, &reads));
+    TEST_ASSERT_EQUAL_INT(2, reads);              // log_004 new, log_002 resized
+
+    TEST_ASSERT_EQUAL_size_t(4, cat.Entries().size());
+    TEST_ASSERT_NULL(cat.Find("gone.csv"));
+    TEST_ASSERT_NULL(cat.Find("also_gone.csv"));
+    TEST_ASSERT_NULL(cat.Find("log_001.meta"));
+    TEST_ASSERT_FALSE(cat.Find("log_001.csv")->hasDbg);   // unchanged, not re-read
+    TEST_ASSERT_FALSE(cat.Find("log_003.csv")->hasDbg);
+    TEST_ASSERT_TRUE(cat.Find("log_002.osl")->hasDbg);
+    TEST_ASSERT_EQUAL_UINT64(250, cat.Find("log_002.osl")->size);
+    TEST_ASSERT_TRUE(cat.Find("log_004.csv")->hasDbg);
+    // Survivors keep their order; new files go last.
+    TEST_ASSERT_EQUAL_STRING("log_003.csv", cat.Entries()[0].name);
+    TEST_ASSERT_EQUAL_STRING("log_004.csv", cat.Entries()[3].name);
+
+    // Nothing left to do.
+    reads = 0;
+    TEST_ASSERT_FALSE(cat.Reconcile(files, 6, CountingReader, &reads));
+    TEST_ASSERT_EQUAL_INT(0, reads);
+}
+
+static void test_reconcile_large_listing()
+{
+    // Every other file deleted, every fourth added; names out of order.
+    LogCatalog cat;
+    TEST_ASSERT_TRUE(cat.ApplyLine(lm::kLogCatalogHeader));
+    char name[32];
+    for (int i = 0; i < 400; ++i) {
+        std::snprintf(name, sizeof(name), "log_%03d.csv", (i * 37) % 400);
+        cat.Upsert(MakeEntry(name, 1));
+    }
+    std::vector<std::string> names;
+    for (int i = 0; i < 500; ++i)
+        if (i % 2 == 0 || i >= 400) {
+            std::snprintf(name, sizeof(name), "log_%03d.csv", (i * 7) % 500);
+            names.push_back(name);
+        }
+    std::vector<LogCatalogListedFile> files;
+    for (const std::string& n : names) files.push_back({n.c_str(), 1});
+
+    int reads = 0;
+    TEST_ASSERT_TRUE(cat.Reconcile(files.data(), files.size(), CountingReader, &reads));
+    TEST_ASSERT_EQUAL_size_t(files.size(), cat.Entries().size());
+    for (const LogCatalogListedFile& f : files)
+        TEST_ASSERT_NOT_NULL(cat.Find(f.name));
+    // Only log_400..log_499 are new; every cataloged size matches.
+    int added = 0;
+    for (const std::string& n : names)
+        if (std::atoi(n.c_str() + 4) >= 400) ++added;
+    TEST_ASSERT_EQUAL_INT(added, reads);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_full_entry);
+    RUN_TEST(test_entry_without_meta_has_empty_strings);
+    RUN_TEST(test_replay_upsert_replaces_and_remove_drops);
+    RUN_TEST(test_names_match_case_insensitively);
+    RUN_TEST(test_bad_header_is_rejected);
+    RUN_TEST(test_torn_final_line_is_ignored);
+    RUN_TEST(test_malformed_records_are_skipped);
+    RUN_TEST(test_separators_in_strings_are_sanitized);
+    RUN_TEST(test_format_rejects_small_buffer);
+    RUN_TEST(test_compaction_threshold);
+    RUN_TEST(test_hidden_names);
+    RUN_TEST(test_reconcile_adds_refreshes_and_drops);
+    RUN_TEST(test_reconcile_large_listing);
+    return UNITY_END();
+}
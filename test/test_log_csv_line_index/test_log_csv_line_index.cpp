@@ -0,0 +1,142 @@
+// test_log_csv_line_index.cpp — unit tests for onspeed::proto::log_csv::LineIndex
+//
+// Tests cover:
+//   - Header / row split, CRLF trimming, empty-line skipping
+//   - Final row without a trailing newline
+//   - Empty and blank-only input rejected
+//   - Rows parse through ParseRowByIndex straight from the index
+
+#include <unity.h>
+
+#include <string>
+#include <string_view>
+
+#include <proto/LogCsv.h>
+#include <proto/LogCsvHeaderIndex.h>
+#include <proto/LogCsvLineIndex.h>
+#include <types/LogRow.h>
+
+using onspeed::proto::log_csv::LineIndex;
+namespace csv = onspeed::proto::log_csv;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void AssertView(const char* expected, std::string_view got)
+{
+    TEST_ASSERT_EQUAL_size_t(std::string_view(expected).size(), got.size());
+    TEST_ASSERT_TRUE(std::string_view(expected) == got);
+}
+
+void test_header_and_rows(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("a,b,c\n1,2,3\n4,5,6\n"));
+    AssertView("a,b,c", idx.Header());
+    TEST_ASSERT_EQUAL_size_t(2, idx.RowCount());
+    AssertView("1,2,3", idx.Row(0));
+    AssertView("4,5,6", idx.Row(1));
+    TEST_ASSERT_EQUAL_UINT64(6, idx.RowOffset(0));
+}
+
+void test_crlf_trimmed(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("a,b\r\n1,2\r\n3,4\r\n"));
+    AssertView("a,b", idx.Header());
+    TEST_ASSERT_EQUAL_size_t(2, idx.RowCount());
+    AssertView("1,2", idx.Row(0));
+    AssertView("3,4", idx.Row(1));
+}
+
+void test_empty_lines_skipped(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("\na,b\n\n1,2\n\r\n3,4\n\n"));
+    AssertView("a,b", idx.Header());
+    TEST_ASSERT_EQUAL_size_t(2, idx.RowCount());
+    AssertView("1,2", idx.Row(0));
+    AssertView("3,4", idx.Row(1));
+}
+
+void test_last_row_without_newline(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("a,b\n1,2\n3,4"));
+    TEST_ASSERT_EQUAL_size_t(2, idx.RowCount());
+    AssertView("3,4", idx.Row(1));
+}
+
+void test_header_only(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("a,b"));
+    AssertView("a,b", idx.Header());
+    TEST_ASSERT_EQUAL_size_t(0, idx.RowCount());
+}
+
+void test_empty_input_rejected(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_FALSE(idx.Build(""));
+    TEST_ASSERT_FALSE(idx.Build("\n\r\n\n"));
+    TEST_ASSERT_EQUAL_size_t(0, idx.RowCount());
+    TEST_ASSERT_EQUAL_size_t(0, idx.Header().size());
+}
+
+void test_rebuild_discards_previous(void)
+{
+    LineIndex idx;
+    TEST_ASSERT_TRUE(idx.Build("a\n1\n2\n3\n"));
+    TEST_ASSERT_TRUE(idx.Build("b\n9\n"));
+    AssertView("b", idx.Header());
+    TEST_ASSERT_EQUAL_size_t(1, idx.RowCount());
+    AssertView("9", idx.Row(0));
+}
+
+// Rows handed out by the index parse exactly like getline'd strings.
+void test_rows_parse_through_header_index(void)
+{
+    onspeed::LogRow src;
+    src.flapsRawAdcPresent = true;
+    src.timeStampMs = 1000;
+    src.iasKt       = 87.5f;
+    src.flapsRawAdc = 1462;
+
+    static char buf[csv::kRowMaxBytes];
+    std::string text;
+    size_t n = csv::WriteHeader(src, buf, sizeof(buf));
+    text.append(buf, n).append("\r\n");
+    for (int i = 0; i < 3; ++i) {
+        src.timeStampMs = 1000u + 20u * (uint32_t)i;
+        n = csv::FormatRow(src, buf, sizeof(buf));
+        text.append(buf, n).append("\r\n");
+    }
+
+    LineIndex lines;
+    TEST_ASSERT_TRUE(lines.Build(text));
+    csv::HeaderIndex hdr;
+    TEST_ASSERT_TRUE(csv::BuildHeaderIndex(lines.Header(), hdr));
+    TEST_ASSERT_EQUAL_size_t(3, lines.RowCount());
+
+    for (size_t i = 0; i < lines.RowCount(); ++i) {
+        onspeed::LogRow row;
+        TEST_ASSERT_TRUE(csv::ParseRowByIndex(lines.Row(i), hdr, row));
+        TEST_ASSERT_EQUAL_UINT32(1000u + 20u * (uint32_t)i, row.timeStampMs);
+        TEST_ASSERT_EQUAL_UINT16(1462, row.flapsRawAdc);
+    }
+}
+
+int main(int, char**)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_header_and_rows);
+    RUN_TEST(test_crlf_trimmed);
+    RUN_TEST(test_empty_lines_skipped);
+    RUN_TEST(test_last_row_without_newline);
+    RUN_TEST(test_header_only);
+    RUN_TEST(test_empty_input_rejected);
+    RUN_TEST(test_rebuild_discards_previous);
+    RUN_TEST(test_rows_parse_through_header_index);
+    return UNITY_END();
+}
@@ -0,0 +1,379 @@
+// test_log_preview.cpp — unit tests for onspeed::log::LogPreviewBuilder
+//
+// Tests cover:
+//   - Min/max per point across a synthetic CSV built with WriteHeader/FormatRow
+//   - A one-row spike survives decimation
+//   - Byte-offset bucketing: every row lands, points >= rows leaves gaps
+//   - Lines past the snapshotted size, unparseable rows, spaced headers
+//   - JSON head/bucket/tail shape, null for non-finite values
+//   - Point clamping and sidecar identity line
+//   - .osl logs via FeedOslBlocks: same points as the CSV, split reads,
+//     truncated tail, CRC-damaged block skipped
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <log/LogPreview.h>
+#include <proto/LogBin.h>
+#include <proto/LogCsv.h>
+#include <types/LogRow.h>
+
+using namespace onspeed::log;
+namespace csv = onspeed::proto::log_csv;
+namespace bin = onspeed::proto::log_bin;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+struct CsvLog {
+    std::string           text;
+    std::string           header;
+    std::vector<uint64_t> offsets;   // start of each data line
+};
+
+// `n` rows at 20 ms; IAS ramps 60..60+n-1, VerticalG 1.0 except `spikeAt`.
+CsvLog MakeLog(size_t n, long spikeAt = -1)
+{
+    CsvLog log;
+    onspeed::LogRow proto;
+    char buf[csv::kRowMaxBytes];
+    const size_t h = csv::WriteHeader(proto, buf, sizeof(buf));
+    log.header.assign(buf, h);
+    log.text = log.header + "\n";
+    for (size_t i = 0; i < n; ++i) {
+        onspeed::LogRow r;
+        r.timeStampMs      = 1000u + 20u * static_cast<uint32_t>(i);
+        r.iasKt            = 60.0f + static_cast<float>(i);
+        r.angleOfAttackDeg = 5.0f;
+        r.paltFt           = 3000.0f;
+        r.imuVerticalG     = (static_cast<long>(i) == spikeAt) ? 3.5f : 1.0f;
+        r.flapsPos         = (i < n / 2) ? 0 : 20;
+        const size_t len = csv::FormatRow(r, buf, sizeof(buf));
+        log.offsets.push_back(log.text.size());
+        log.text.append(buf, len);
+        log.text += "\n";
+    }
+    return log;
+}
+
+// The rows of MakeLog(n, spikeAt) as a .osl file.
+std::vector<uint8_t> MakeOsl(size_t n, long spikeAt = -1)
+{
+    std::vector<uint8_t> out(bin::kFileHeaderBytes);
+    onspeed::LogRow session;
+    TEST_ASSERT_EQUAL_size_t(bin::kFileHeaderBytes,
+                             bin::WriteFileHeader(session, out.data(), out.size()));
+    std::vector<uint8_t> block(bin::kMaxBlockBytes);
+    bin::BlockEncoder enc;
+    auto flush = [&] {
+        const size_t len = enc.Finish(block.data(), block.size());
+        out.insert(out.end(), block.begin(), block.begin() + static_cast<long>(len));
+    };
+    for (size_t i = 0; i < n; ++i) {
+        onspeed::LogRow r;
+        r.timeStampMs      = 1000u + 20u * static_cast<uint32_t>(i);
+        r.iasKt            = 60.0f + static_cast<float>(i);
+        r.angleOfAttackDeg = 5.0f;
+        r.paltFt           = 3000.0f;
+        r.imuVerticalG     = (static_cast<long>(i) == spikeAt) ? 3.5f : 1.0f;
+        r.flapsPos         = (i < n / 2) ? 0 : 20;
+        TEST_ASSERT_TRUE(enc.Append(r));
+        if (enc.Full()) flush();
+    }
+    if (!enc.Empty()) flush();
+    return out;
+}
+
+// Feed `osl` after its file header in reads of at most `chunk` bytes,
+// carrying the unconsumed tail like the firmware scanner does.
+bin::BlockStatus FeedOsl(LogPreviewBuilder& b, const std::vector<uint8_t>& osl, size_t chunk)
+{
+    std::vector<uint8_t> buf;
+    size_t bufStart = bin::kFileHeaderBytes;   // file offset of buf[0]
+    size_t next     = bin::kFileHeaderBytes;
+    bin::BlockStatus st = bin::BlockStatus::Truncated;
+    while (next < osl.size()) {
+        const size_t take = std::min(chunk, osl.size() - next);
+        buf.insert(buf.end(), osl.begin() + static_cast<long>(next),
+                   osl.begin() + static_cast<long>(next + take));
+        next += take;
+        const size_t used = FeedOslBlocks(b, buf.data(), buf.size(), bufStart, st);
+        buf.erase(buf.begin(), buf.begin() + static_cast<long>(used));
+        bufStart += used;
+        if (st != bin::BlockStatus::Truncated) break;
+    }
+    return st;
+}
+
+void Feed(LogPreviewBuilder& b, const CsvLog& log)
+{
+    size_t pos = log.header.size() + 1;
+    while (pos < log.text.size()) {
+        const size_t nl = log.text.find('\n', pos);
+        b.OnLine(std::string_view(log.text).substr(pos, nl - pos + 1), pos);
+        pos = nl + 1;
+    }
+}
+
+std::string Json(const LogPreviewBuilder& b)
+{
+    char buf[1024];
+    std::string out;
+    out.append(buf, FormatPreviewJsonHead("log_001.csv", b, buf, sizeof(buf)));
+    bool first = true;
+    for (const PreviewBucket& bk : b.Buckets()) {
+        const size_t n = FormatPreviewJsonBucket(bk, first, buf, sizeof(buf));
+        if (n > 0) first = false;
+        out.append(buf, n);
+    }
+    out.append(buf, FormatPreviewJsonTail(buf, sizeof(buf)));
+    return out;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+static void test_min_max_per_point()
+{
+    const CsvLog log = MakeLog(400);
+    LogPreviewBuilder b(20, log.text.size());
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+
+    TEST_ASSERT_EQUAL_UINT32(400, b.Rows());
+    TEST_ASSERT_EQUAL_UINT32(0, b.SkippedRows());
+    TEST_ASSERT_EQUAL_size_t(20, b.Points());
+
+    uint32_t total = 0;
+    float prevMax = -1.0f;
+    for (const PreviewBucket& bk : b.Buckets()) {
+        TEST_ASSERT_TRUE(bk.rows > 0);
+        total += bk.rows;
+        // IAS ramps, so each point's range starts past the previous one.
+        TEST_ASSERT_TRUE(bk.min[0] > prevMax);
+        TEST_ASSERT_EQUAL_FLOAT(bk.min[0] + static_cast<float>(bk.rows - 1), bk.max[0]);
+        TEST_ASSERT_EQUAL_UINT32(1000u + 20u * static_cast<uint32_t>(bk.min[0] - 60.0f), bk.firstMs);
+        prevMax = bk.max[0];
+    }
+    TEST_ASSERT_EQUAL_UINT32(400, total);
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, b.Buckets().front().min[0]);
+    TEST_ASSERT_EQUAL_FLOAT(459.0f, b.Buckets().back().max[0]);
+}
+
+static void test_spike_survives()
+{
+    const CsvLog log = MakeLog(1000, 637);
+    LogPreviewBuilder b(16, log.text.size());
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+
+    int spikes = 0;
+    for (const PreviewBucket& bk : b.Buckets()) {
+        TEST_ASSERT_EQUAL_FLOAT(1.0f, bk.min[3]);
+        if (bk.max[3] > 3.0f) ++spikes;
+    }
+    TEST_ASSERT_EQUAL_INT(1, spikes);
+}
+
+static void test_more_points_than_rows_leaves_gaps()
+{
+    const CsvLog log = MakeLog(10);
+    LogPreviewBuilder b(100, log.text.size());
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+
+    size_t filled = 0;
+    for (const PreviewBucket& bk : b.Buckets())
+        if (bk.rows > 0) ++filled;
+    TEST_ASSERT_EQUAL_size_t(10, filled);
+
+    // Empty points are omitted from the JSON entirely.
+    const std::string json = Json(b);
+    size_t rows = 0;
+    for (size_t p = json.find("],["); p != std::string::npos; p = json.find("],[", p + 1)) ++rows;
+    TEST_ASSERT_EQUAL_size_t(9, rows);
+}
+
+static void test_lines_past_snapshot_ignored()
+{
+    const CsvLog log = MakeLog(100);
+    // Snapshot the size half way: the active log kept growing after.
+    const uint64_t cut = log.offsets[50];
+    LogPreviewBuilder b(10, cut);
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+    TEST_ASSERT_EQUAL_UINT32(50, b.Rows());
+}
+
+static void test_bad_rows_skipped()
+{
+    const CsvLog log = MakeLog(5);
+    LogPreviewBuilder b(16, log.text.size() + 100);
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+    b.OnLine("1,2,3\n", log.text.size());
+    b.OnLine("\r\n", log.text.size() + 10);
+    TEST_ASSERT_EQUAL_UINT32(5, b.Rows());
+    TEST_ASSERT_EQUAL_UINT32(1, b.SkippedRows());
+}
+
+static void test_header_with_spaces_and_rejects()
+{
+    LogPreviewBuilder b(16, 1000);
+    TEST_ASSERT_TRUE(b.Begin("timeStamp, IAS, AngleofAttack\r\n"));
+
+    LogPreviewBuilder junk(16, 1000);
+    TEST_ASSERT_FALSE(junk.Begin("foo,bar,baz\n"));
+    junk.OnLine("1,2,3\n", 100);
+    TEST_ASSERT_EQUAL_UINT32(0, junk.Rows());
+}
+
+static void test_json_shape()
+{
+    const CsvLog log = MakeLog(40);
+    LogPreviewBuilder b(16, log.text.size());
+    TEST_ASSERT_TRUE(b.Begin(log.header));
+    Feed(b, log);
+    const std::string json = Json(b);
+
+    TEST_ASSERT_EQUAL_INT(0, json.find("{\"name\":\"log_001.csv\",\"size\":"));
+    TEST_ASSERT_TRUE(json.find("\"points\":16,\"rows\":40,") != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"columns\":[\"tMs\",\"iasKtMin\",\"iasKtMax\",\"aoaDegMin\"")
+                     != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"flapsPosMax\"],\"data\":[[1000,60.0,") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING("]]}", json.substr(json.size() - 3).c_str());
+
+    PreviewBucket bk;
+    bk.rows    = 1;
+    bk.firstMs = 7;
+    for (size_t c = 0; c < kPreviewChannelCount; ++c) bk.min[c] = bk.max[c] = NAN;
+    bk.min[0] = bk.max[0] = 80.25f;
+    char buf[kPreviewJsonBucketMaxLen];
+    FormatPreviewJsonBucket(bk, false, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING(",[7,80.2,80.2,null,null,null,null,null,null,null,null]", buf);
+
+    // Undersized buffer: nothing partial.
+    char tiny[8];
+    TEST_ASSERT_EQUAL_size_t(0, FormatPreviewJsonBucket(bk, true, tiny, sizeof(tiny)));
+    TEST_ASSERT_EQUAL_CHAR('\0', tiny[0]);
+}
+
+static void test_clamp_points()
+{
+    TEST_ASSERT_EQUAL_size_t(kPreviewDefaultPoints, ClampPreviewPoints(0));
+    TEST_ASSERT_EQUAL_size_t(kPreviewDefaultPoints, ClampPreviewPoints(-5));
+    TEST_ASSERT_EQUAL_size_t(kPreviewMinPoints, ClampPreviewPoints(3));
+    TEST_ASSERT_EQUAL_size_t(2000, ClampPreviewPoints(2000));
+    TEST_ASSERT_EQUAL_size_t(kPreviewMaxPoints, ClampPreviewPoints(1000000));
+    TEST_ASSERT_EQUAL_STRING("verticalG", PreviewChannelName(3));
+    TEST_ASSERT_NULL(PreviewChannelName(kPreviewChannelCount));
+}
+
+static void test_sidecar_header()
+{
+    char line[kPreviewSidecarHeaderMaxLen];
+    const size_t n = FormatPreviewSidecarHeader("\"1f00-0badf00d\"", 2000, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("onspeed-preview 1\t\"1f00-0badf00d\"\t2000\n", line);
+
+    const std::string file = std::string(line, n) + "{\"name\":";
+    TEST_ASSERT_EQUAL_size_t(n, MatchPreviewSidecarHeader(file, "\"1f00-0badf00d\"", 2000));
+    TEST_ASSERT_EQUAL_size_t(0, MatchPreviewSidecarHeader(file, "\"1f00-0badf00e\"", 2000));
+    TEST_ASSERT_EQUAL_size_t(0, MatchPreviewSidecarHeader(file, "\"1f00-0badf00d\"", 1000));
+    TEST_ASSERT_EQUAL_size_t(0, MatchPreviewSidecarHeader(file.substr(0, 10), "\"1f00-0badf00d\"", 2000));
+}
+
+// ---------------------------------------------------------------------------
+
+static void test_osl_matches_csv()
+{
+    const CsvLog log = MakeLog(1000, 637);
+    const std::vector<uint8_t> osl = MakeOsl(1000, 637);
+
+    bin::FileInfo info;
+    TEST_ASSERT_TRUE(bin::ReadFileHeader(osl.data(), osl.size(), info));
+
+    LogPreviewBuilder fromCsv(16, log.text.size());
+    TEST_ASSERT_TRUE(fromCsv.Begin(log.header));
+    Feed(fromCsv, log);
+
+    // One read of the whole file, and reads smaller than a block.
+    for (size_t chunk : {osl.size(), static_cast<size_t>(700)}) {
+        LogPreviewBuilder fromOsl(16, osl.size());
+        fromOsl.BeginRows();
+        TEST_ASSERT_TRUE(FeedOsl(fromOsl, osl, chunk) == bin::BlockStatus::Truncated);
+        TEST_ASSERT_EQUAL_UINT32(1000, fromOsl.Rows());
+        TEST_ASSERT_EQUAL_UINT32(0, fromOsl.SkippedRows());
+
+        // Bucket edges differ (the encodings differ in size), but every
+        // point is populated and the extremes match.
+        int spikes = 0;
+        float lo = 1e9f, hi = -1e9f;
+        for (const PreviewBucket& bk : fromOsl.Buckets()) {
+            TEST_ASSERT_TRUE(bk.rows > 0);
+            TEST_ASSERT_EQUAL_FLOAT(5.0f, bk.min[1]);
+            TEST_ASSERT_EQUAL_FLOAT(3000.0f, bk.max[2]);
+            if (bk.max[3] > 3.0f) ++spikes;
+            lo = std::min(lo, bk.min[0]);
+            hi = std::max(hi, bk.max[0]);
+        }
+        TEST_ASSERT_EQUAL_INT(1, spikes);
+        TEST_ASSERT_EQUAL_FLOAT(fromCsv.Buckets().front().min[0], lo);
+        TEST_ASSERT_EQUAL_FLOAT(fromCsv.Buckets().back().max[0], hi);
+        TEST_ASSERT_EQUAL_UINT32(1000, fromOsl.Buckets().front().firstMs);
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, fromOsl.Buckets().front().min[4]);
+        TEST_ASSERT_EQUAL_FLOAT(20.0f, fromOsl.Buckets().back().max[4]);
+    }
+}
+
+static void test_osl_truncated_and_damaged_blocks()
+{
+    std::vector<uint8_t> osl = MakeOsl(100);   // blocks of 32, 32, 32, 4
+
+    // Power-yank mid-block: the last block is cut short and never folded.
+    std::vector<uint8_t> cut(osl.begin(), osl.end() - 10);
+    LogPreviewBuilder b(4, cut.size());
+    b.BeginRows();
+    TEST_ASSERT_TRUE(FeedOsl(b, cut, 512) == bin::BlockStatus::Truncated);
+    TEST_ASSERT_EQUAL_UINT32(96, b.Rows());
+
+    // A flipped payload byte in the first block: skipped, walk continues.
+    osl[bin::kFileHeaderBytes + bin::kBlockHeaderBytes + 3] ^= 0xFF;
+    LogPreviewBuilder d(4, osl.size());
+    d.BeginRows();
+    TEST_ASSERT_TRUE(FeedOsl(d, osl, osl.size()) == bin::BlockStatus::Truncated);
+    TEST_ASSERT_EQUAL_UINT32(68, d.Rows());
+    TEST_ASSERT_EQUAL_UINT32(32, d.SkippedRows());
+
+    // Garbage where a block should start stops the walk.
+    std::vector<uint8_t> junk(osl.begin(), osl.begin() + bin::kFileHeaderBytes);
+    junk.resize(junk.size() + bin::kBlockHeaderBytes, 0xA5);
+    LogPreviewBuilder j(4, junk.size());
+    j.BeginRows();
+    TEST_ASSERT_TRUE(FeedOsl(j, junk, junk.size()) == bin::BlockStatus::BadMagic);
+    TEST_ASSERT_EQUAL_UINT32(0, j.Rows());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_min_max_per_point);
+    RUN_TEST(test_spike_survives);
+    RUN_TEST(test_more_points_than_rows_leaves_gaps);
+    RUN_TEST(test_lines_past_snapshot_ignored);
+    RUN_TEST(test_bad_rows_skipped);
+    RUN_TEST(test_header_with_spaces_and_rejects);
+    RUN_TEST(test_json_shape);
+    RUN_TEST(test_clamp_points);
+    RUN_TEST(test_sidecar_header);
+    RUN_TEST(test_osl_matches_csv);
+    RUN_TEST(test_osl_truncated_and_damaged_blocks);
+    return UNITY_END();
+}
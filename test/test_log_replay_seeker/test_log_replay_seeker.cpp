@@ -0,0 +1,264 @@
+// test_log_replay_seeker.cpp — unit tests for onspeed::replay::LogReplaySeeker.
+//
+// The seeker's one promise: the frame it hands out for row i is
+// byte-identical to the frame a straight LogReplayTask pass
+// (processRow for every row, then flush) produces for row i, no matter
+// how it got there — sequential next(), a forward or backward seek()
+// through checkpoints, or advance(n) fast-forward. Each test builds that
+// straight-pass reference and compares against it, on both the
+// flapsRawADC path and the synth (lagged) path.
+
+#include <unity.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <config/OnSpeedConfig.h>
+#include <replay/LogReplaySeeker.h>
+#include <replay/LogReplayTask.h>
+#include <types/LogRow.h>
+
+using onspeed::LogRow;
+using onspeed::config::OnSpeedConfig;
+using onspeed::replay::LogReplaySeeker;
+using onspeed::replay::LogReplayTask;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static constexpr int kRateHz = 50;
+static constexpr int kRows   = 1500;     // 30 s at 50 Hz
+
+static OnSpeedConfig MakeMultiFlapCfg()
+{
+    OnSpeedConfig cfg;
+    cfg.aFlaps.clear();
+    for (int deg : { 0, 16, 33 }) {
+        OnSpeedConfig::SuFlaps f;
+        f.iDegrees        = deg;
+        f.iPotPosition    = 4000 - deg * 50;
+        f.fLDMAXAOA       = 4.0f + deg * 0.05f;
+        f.fONSPEEDFASTAOA = 4.5f + deg * 0.05f;
+        f.fONSPEEDSLOWAOA = 5.0f + deg * 0.05f;
+        f.fSTALLWARNAOA   = 8.0f;
+        f.fAlpha0         = -3.0f;
+        f.fAlphaStall     = 10.0f;
+        f.AoaCurve.iCurveType = 1;
+        f.AoaCurve.afCoeff[0] = 0.0f;
+        f.AoaCurve.afCoeff[1] = 0.0f;
+        f.AoaCurve.afCoeff[2] = 1.0f;
+        f.AoaCurve.afCoeff[3] = 0.0f;
+        cfg.aFlaps.push_back(f);
+    }
+    // Keep the AOA EMA on: its state is exactly what a seek must carry.
+    cfg.iAoaSmoothing = 20;
+    return cfg;
+}
+
+// Varying signals plus a flap detent change every 400 rows, so the synth
+// path has transitions inside its window at some of the seek targets.
+static LogRow MakeRow(int i, bool rawAdc)
+{
+    LogRow row;
+    row.pfwdSmoothed       = 1.0f + std::sin(i * 0.011f) * 0.3f;
+    row.p45Smoothed        = 0.5f + std::cos(i * 0.017f) * 0.2f;
+    row.pStaticMbar        = 1013.25f;
+    row.paltFt             = 1500.0f + i * 0.5f;
+    row.iasKt              = 20.0f + (i % 300) * 0.3f;   // crosses the IAS gate both ways
+    row.iasValid           = false;
+    row.flapsPos           = (i / 400) % 3 == 0 ? 0 : ((i / 400) % 3 == 1 ? 16 : 33);
+    row.flapsRawAdc        = static_cast<uint16_t>(4000 - row.flapsPos * 50);
+    row.flapsRawAdcPresent = rawAdc;
+    row.imuVerticalG       = 1.0f + std::sin(i * 0.1f) * 0.3f;
+    row.imuLateralG        = std::sin(i * 0.13f) * 0.04f;
+    row.imuForwardG        = std::cos(i * 0.07f) * 0.02f;
+    row.imuRollRateDps     = std::sin(i * 0.07f) * 5.0f;
+    row.imuPitchRateDps    = std::cos(i * 0.05f) * 3.0f;
+    row.imuYawRateDps      = std::sin(i * 0.09f) * 1.0f;
+    row.pitchDeg           = std::sin(i * 0.02f) * 5.0f;
+    row.rollDeg            = std::cos(i * 0.03f) * 10.0f;
+    row.flightPathDeg      = 2.0f + std::sin(i * 0.04f);
+    row.vsiFpm             = 100.0f + (i % 50) * 4.0f;
+    row.dataMark           = i % 100;
+    row.oatCelsius         = 15.0f + (i / 300) * 0.5f;
+    return row;
+}
+
+// Straight pass: processRow every row, flush, drop the lag empties —
+// index i is then the frame for row i (what buildWireFrames.js does).
+static std::vector<std::vector<uint8_t>> ReferenceFrames(bool rawAdc)
+{
+    LogReplayTask task(MakeMultiFlapCfg(), kRateHz, rawAdc);
+    std::vector<std::vector<uint8_t>> out;
+    for (int i = 0; i < kRows; i++) {
+        std::vector<uint8_t> f = task.processRow(MakeRow(i, rawAdc));
+        if (!f.empty()) out.push_back(std::move(f));
+    }
+    for (std::vector<uint8_t>& f : task.flush()) out.push_back(std::move(f));
+    return out;
+}
+
+static void FillSeeker(LogReplaySeeker& seeker, bool rawAdc)
+{
+    for (int i = 0; i < kRows; i++) TEST_ASSERT_TRUE(seeker.appendRow(MakeRow(i, rawAdc)));
+}
+
+static void AssertFrame(const std::vector<std::vector<uint8_t>>& ref, size_t row,
+                        const std::vector<uint8_t>& got)
+{
+    TEST_ASSERT_EQUAL_size_t(ref[row].size(), got.size());
+    TEST_ASSERT_EQUAL_MEMORY(ref[row].data(), got.data(), got.size());
+}
+
+// ----------------------------------------------------------------------------
+// Sequential playback
+// ----------------------------------------------------------------------------
+
+static void CheckSequentialMatchesReference(bool rawAdc)
+{
+    const auto ref = ReferenceFrames(rawAdc);
+    TEST_ASSERT_EQUAL_size_t(kRows, ref.size());
+
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, rawAdc);
+    FillSeeker(seeker, rawAdc);
+    for (size_t i = 0; i < ref.size(); i++) {
+        TEST_ASSERT_EQUAL_size_t(i, seeker.position());
+        AssertFrame(ref, i, seeker.next());
+    }
+    TEST_ASSERT_TRUE(seeker.next().empty());
+    TEST_ASSERT_EQUAL_size_t(kRows, seeker.position());
+}
+
+void test_sequential_matches_reference_raw_adc() { CheckSequentialMatchesReference(true); }
+void test_sequential_matches_reference_synth()   { CheckSequentialMatchesReference(false); }
+
+// ----------------------------------------------------------------------------
+// Seek
+// ----------------------------------------------------------------------------
+
+static void CheckSeekMatchesReference(bool rawAdc, bool prebuild)
+{
+    const auto ref = ReferenceFrames(rawAdc);
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, rawAdc, /*checkpointIntervalSec=*/2.0f);
+    FillSeeker(seeker, rawAdc);
+    if (prebuild) seeker.buildCheckpoints();
+
+    // Forward, backward, onto checkpoint boundaries (multiples of 100),
+    // one either side of them, both ends, and across flap transitions.
+    const size_t targets[] = { 700, 3, 1499, 100, 99, 101, 0, 1234, 1235, 400, 399,
+                               1200, 1390, 1460, 250, 251, 1000 };
+    for (size_t t : targets) {
+        TEST_ASSERT_TRUE(seeker.seek(t));
+        TEST_ASSERT_EQUAL_size_t(t, seeker.position());
+        AssertFrame(ref, t, seeker.next());
+        if (t + 1 < ref.size()) AssertFrame(ref, t + 1, seeker.next());
+    }
+}
+
+void test_seek_matches_reference_raw_adc()        { CheckSeekMatchesReference(true,  false); }
+void test_seek_matches_reference_synth()          { CheckSeekMatchesReference(false, false); }
+void test_seek_prebuilt_matches_reference_raw_adc() { CheckSeekMatchesReference(true,  true); }
+void test_seek_prebuilt_matches_reference_synth() { CheckSeekMatchesReference(false, true); }
+
+void test_seek_bounds()
+{
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, true);
+    FillSeeker(seeker, true);
+    TEST_ASSERT_TRUE(seeker.seek(kRows));
+    TEST_ASSERT_TRUE(seeker.next().empty());
+    TEST_ASSERT_FALSE(seeker.seek(kRows + 1));
+    TEST_ASSERT_EQUAL_size_t(kRows, seeker.position());
+    TEST_ASSERT_TRUE(seeker.seek(0));
+    TEST_ASSERT_FALSE(seeker.next().empty());
+}
+
+// ----------------------------------------------------------------------------
+// Fast-forward
+// ----------------------------------------------------------------------------
+
+static void CheckAdvanceMatchesReference(bool rawAdc)
+{
+    const auto ref = ReferenceFrames(rawAdc);
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, rawAdc);
+    FillSeeker(seeker, rawAdc);
+
+    // 50x: frame for rows 49, 99, 149, ...
+    size_t shown = 0;
+    for (;;) {
+        const std::vector<uint8_t> f = seeker.advance(50);
+        if (f.empty()) break;
+        shown += 50;
+        AssertFrame(ref, shown - 1, f);
+        TEST_ASSERT_EQUAL_size_t(shown, seeker.position());
+    }
+    TEST_ASSERT_EQUAL_size_t(kRows, shown);
+    TEST_ASSERT_TRUE(seeker.advance(0).empty());
+}
+
+void test_advance_matches_reference_raw_adc() { CheckAdvanceMatchesReference(true); }
+void test_advance_matches_reference_synth()   { CheckAdvanceMatchesReference(false); }
+
+// ----------------------------------------------------------------------------
+// Checkpoints / rows
+// ----------------------------------------------------------------------------
+
+void test_checkpoint_count_follows_interval()
+{
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, true, /*checkpointIntervalSec=*/4.0f);
+    FillSeeker(seeker, true);
+    TEST_ASSERT_EQUAL_size_t(200, seeker.rowsPerCheckpoint());
+    TEST_ASSERT_EQUAL_size_t(0, seeker.checkpointCount());
+
+    // Playing to row 450 records checkpoints at rows 0, 200, 400.
+    seeker.seek(450);
+    TEST_ASSERT_EQUAL_size_t(3, seeker.checkpointCount());
+
+    seeker.buildCheckpoints();
+    TEST_ASSERT_EQUAL_size_t((kRows + 199) / 200, seeker.checkpointCount());
+    TEST_ASSERT_EQUAL_size_t(450, seeker.position());
+
+    // Non-positive interval falls back to the default.
+    LogReplaySeeker fallback(MakeMultiFlapCfg(), kRateHz, true, 0.0f);
+    TEST_ASSERT_EQUAL_size_t(
+        static_cast<size_t>(onspeed::replay::kDefaultCheckpointIntervalSec * kRateHz),
+        fallback.rowsPerCheckpoint());
+}
+
+void test_append_after_end_is_rejected()
+{
+    LogReplaySeeker seeker(MakeMultiFlapCfg(), kRateHz, true);
+    TEST_ASSERT_TRUE(seeker.appendRow(MakeRow(0, true)));
+    TEST_ASSERT_FALSE(seeker.next().empty());
+    TEST_ASSERT_TRUE(seeker.appendRow(MakeRow(1, true)));   // still streaming
+    TEST_ASSERT_FALSE(seeker.next().empty());
+    TEST_ASSERT_TRUE(seeker.next().empty());                 // end reached, engine drained
+    TEST_ASSERT_FALSE(seeker.appendRow(MakeRow(2, true)));
+    TEST_ASSERT_EQUAL_size_t(2, seeker.rowCount());
+}
+
+// ----------------------------------------------------------------------------
+// Runner
+// ----------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sequential_matches_reference_raw_adc);
+    RUN_TEST(test_sequential_matches_reference_synth);
+    RUN_TEST(test_seek_matches_reference_raw_adc);
+    RUN_TEST(test_seek_matches_reference_synth);
+    RUN_TEST(test_seek_prebuilt_matches_reference_raw_adc);
+    RUN_TEST(test_seek_prebuilt_matches_reference_synth);
+    RUN_TEST(test_seek_bounds);
+    RUN_TEST(test_advance_matches_reference_raw_adc);
+    RUN_TEST(test_advance_matches_reference_synth);
+    RUN_TEST(test_checkpoint_count_follows_interval);
+    RUN_TEST(test_append_after_end_is_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,205 @@
+// test_log_row_cache.cpp — unit tests for onspeed::log row-cache images
+//
+// Tests cover:
+//   - Write/Open round trip: header index, rows, line table, header line
+//   - Zero-row image
+//   - Staleness on source size or mtime change
+//   - Bad magic, layout mismatch, truncation
+//   - Write into an undersized buffer
+
+#include <unity.h>
+
+#include <cstring>
+#include <vector>
+
+#include <log/LogRowCache.h>
+#include <proto/LogCsvHeaderIndex.h>
+#include <types/LogRow.h>
+
+using namespace onspeed::log;
+namespace csv = onspeed::proto::log_csv;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+struct Fixture {
+    csv::HeaderIndex             index;
+    std::vector<onspeed::LogRow> rows;
+    std::vector<uint64_t>        offsets;
+    std::vector<uint32_t>        lengths;
+    RowCacheImage                image;
+
+    explicit Fixture(size_t n)
+    {
+        index.idxTimeStampMs = 0;
+        index.idxIasKt       = 7;
+        index.idxFlapsRawAdc = 80;
+        index.totalColumns   = 81;
+        index.boomEnabled    = true;
+
+        for (size_t i = 0; i < n; ++i) {
+            onspeed::LogRow r;
+            r.timeStampMs        = 1000u + 20u * static_cast<uint32_t>(i);
+            r.iasKt              = 80.0f + static_cast<float>(i);
+            r.flapsRawAdc        = static_cast<uint16_t>(1400 + i);
+            r.flapsRawAdcPresent = true;
+            rows.push_back(r);
+            offsets.push_back(100 + 50 * i);
+            lengths.push_back(48);
+        }
+
+        image.source           = {123456, 1700000000123456789LL};
+        image.index            = index;
+        image.headerLineOffset = 0;
+        image.headerLineLength = 98;
+        image.rowCount         = n;
+        image.rows             = rows.data();
+        image.lineOffsets      = offsets.data();
+        image.lineLengths      = lengths.data();
+    }
+
+    std::vector<uint64_t> Write() const
+    {
+        // uint64_t storage keeps the image 8-byte aligned, as mmap would.
+        const size_t bytes = RowCacheBytes(image.rowCount);
+        std::vector<uint64_t> buf((bytes + 7) / 8);
+        const size_t n = WriteRowCache(image, reinterpret_cast<uint8_t*>(buf.data()), bytes);
+        TEST_ASSERT_EQUAL_size_t(bytes, n);
+        return buf;
+    }
+};
+
+const uint8_t* Bytes(const std::vector<uint64_t>& buf)
+{
+    return reinterpret_cast<const uint8_t*>(buf.data());
+}
+
+} // namespace
+
+void test_round_trip(void)
+{
+    Fixture f(5);
+    const std::vector<uint64_t> buf = f.Write();
+
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Ok,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(5), f.image.source, got));
+
+    TEST_ASSERT_EQUAL_size_t(5, got.rowCount);
+    TEST_ASSERT_EQUAL_INT(7,  got.index.idxIasKt);
+    TEST_ASSERT_EQUAL_INT(80, got.index.idxFlapsRawAdc);
+    TEST_ASSERT_EQUAL_INT(81, got.index.totalColumns);
+    TEST_ASSERT_TRUE(got.index.boomEnabled);
+    TEST_ASSERT_EQUAL_INT(-1, got.index.idxBoomAlpha);
+    TEST_ASSERT_EQUAL_UINT32(98, got.headerLineLength);
+
+    for (size_t i = 0; i < 5; ++i) {
+        TEST_ASSERT_EQUAL_UINT32(f.rows[i].timeStampMs, got.rows[i].timeStampMs);
+        TEST_ASSERT_EQUAL_FLOAT(f.rows[i].iasKt, got.rows[i].iasKt);
+        TEST_ASSERT_EQUAL_UINT16(f.rows[i].flapsRawAdc, got.rows[i].flapsRawAdc);
+        TEST_ASSERT_TRUE(got.rows[i].flapsRawAdcPresent);
+        TEST_ASSERT_EQUAL_UINT64(f.offsets[i], got.lineOffsets[i]);
+        TEST_ASSERT_EQUAL_UINT32(48, got.lineLengths[i]);
+    }
+}
+
+// The row array sits on a 64-byte boundary so an mmap'd image can be
+// used in place.
+void test_rows_aligned(void)
+{
+    Fixture f(3);
+    const std::vector<uint64_t> buf = f.Write();
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Ok,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(3), f.image.source, got));
+    const size_t rowsOff = static_cast<size_t>(
+        reinterpret_cast<const uint8_t*>(got.rows) - Bytes(buf));
+    TEST_ASSERT_EQUAL_size_t(0, rowsOff % kRowCacheAlign);
+}
+
+void test_zero_rows(void)
+{
+    Fixture f(0);
+    const std::vector<uint64_t> buf = f.Write();
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Ok,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(0), f.image.source, got));
+    TEST_ASSERT_EQUAL_size_t(0, got.rowCount);
+}
+
+void test_stale_on_size_or_mtime(void)
+{
+    Fixture f(2);
+    const std::vector<uint64_t> buf = f.Write();
+    RowCacheImage got;
+
+    RowCacheSource grown = f.image.source;
+    grown.sizeBytes += 1;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Stale,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(2), grown, got));
+
+    RowCacheSource touched = f.image.source;
+    touched.mtimeNs += 1;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Stale,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(2), touched, got));
+}
+
+void test_bad_magic(void)
+{
+    Fixture f(2);
+    std::vector<uint64_t> buf = f.Write();
+    reinterpret_cast<uint8_t*>(buf.data())[0] ^= 0xFF;
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::BadMagic,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(2), f.image.source, got));
+}
+
+// A build with a different LogRow layout must not reuse the rows.
+void test_layout_mismatch(void)
+{
+    Fixture f(2);
+    std::vector<uint64_t> buf = f.Write();
+    uint32_t rowBytes;
+    std::memcpy(&rowBytes, Bytes(buf) + 8, sizeof(rowBytes));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(onspeed::LogRow), rowBytes);
+    rowBytes += 8;
+    std::memcpy(reinterpret_cast<uint8_t*>(buf.data()) + 8, &rowBytes, sizeof(rowBytes));
+
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::LayoutMismatch,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(2), f.image.source, got));
+}
+
+void test_truncated(void)
+{
+    Fixture f(4);
+    const std::vector<uint64_t> buf = f.Write();
+    RowCacheImage got;
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Truncated,
+        (int)OpenRowCache(Bytes(buf), RowCacheBytes(4) - 1, f.image.source, got));
+    TEST_ASSERT_EQUAL_INT((int)RowCacheStatus::Truncated,
+        (int)OpenRowCache(Bytes(buf), kRowCacheHeaderBytes - 1, f.image.source, got));
+}
+
+void test_write_buffer_too_small(void)
+{
+    Fixture f(2);
+    std::vector<uint8_t> buf(RowCacheBytes(2) - 1);
+    TEST_ASSERT_EQUAL_size_t(0, WriteRowCache(f.image, buf.data(), buf.size()));
+}
+
+int main(int, char**)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_rows_aligned);
+    RUN_TEST(test_zero_rows);
+    RUN_TEST(test_stale_on_size_or_mtime);
+    RUN_TEST(test_bad_magic);
+    RUN_TEST(test_layout_mismatch);
+    RUN_TEST(test_truncated);
+    RUN_TEST(test_write_buffer_too_small);
+    return UNITY_END();
+}
@@ -2,6 +2,7 @@
 #include <cmath>
 
 #include <replay/LogRowToAhrsInputs.h>
+#include <sensors/Ism330Fifo.h>
 
 using onspeed::LogRow;
 using onspeed::replay::LogRowToAhrsInputs;
@@ -84,6 +85,46 @@ void test_pitch_rate_sign(void) {
     TEST_ASSERT_EQUAL_FLOAT(+5.0f, out.inputs.imu.gyroPitchDps);
 }
 
+void test_fifo_batched_rows_replay_at_odr(void) {
+    // ImuFifoReadLoop writes each FIFO read's samples back to back, rows
+    // stamped by Ism330FifoSampleHostUs from the read time. Replay must
+    // see the 208 Hz ODR, not the µs between the burst's Write() calls.
+    // The sensor timeline starts just short of its 32-bit wrap.
+    using onspeed::sensors::Ism330FifoSampleHostUs;
+    constexpr double   kOdrHz     = 208.0;
+    constexpr uint32_t kSensorT0  = 0xFFFFFFFFu - 30000u;
+    constexpr uint64_t kHostT0    = 5000000;
+    const int          batches[]  = {3, 5, 4, 6, 1, 5, 4};
+    const uint32_t     latencyUs[] = {40, 250, 90, 180, 20, 300, 120};
+
+    LogRowToAhrsInputs bridge;
+    int  n      = 0;
+    bool seeded = false;
+    for (int b = 0; b < 7; b++) {
+        uint32_t sensorUs[8];
+        for (int k = 0; k < batches[b]; k++)
+            sensorUs[k] = kSensorT0 + static_cast<uint32_t>(std::lround((n + k) * 1.0e6 / kOdrHz));
+        const uint32_t newest  = sensorUs[batches[b] - 1];
+        const uint64_t readUs  = kHostT0 + static_cast<uint32_t>(newest - kSensorT0) + latencyUs[b];
+
+        for (int k = 0; k < batches[b]; k++, n++) {
+            auto out = bridge.translate(makeRow(Ism330FifoSampleHostUs(readUs, newest, sensorUs[k]),
+                                                100.0f, 0,0,1, 0,0,0, 50, 1000, 15));
+            if (!seeded) { seeded = true; continue; }
+            if (k > 0) {
+                // Inside a batch: exactly the sensor spacing (±1 µs rounding).
+                TEST_ASSERT_FLOAT_WITHIN(1.5e-6f, static_cast<float>(1.0 / kOdrHz), out.dtSec);
+            } else {
+                // Across reads: off only by the change in read latency.
+                const float jitter = static_cast<float>(latencyUs[b]) - static_cast<float>(latencyUs[b - 1]);
+                TEST_ASSERT_FLOAT_WITHIN(1.5e-6f, static_cast<float>(1.0 / kOdrHz) + jitter * 1.0e-6f,
+                                         out.dtSec);
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(28, n);
+}
+
 int main(int, char**) {
     UNITY_BEGIN();
     RUN_TEST(test_first_row_is_seed);
@@ -91,5 +132,6 @@ int main(int, char**) {
     RUN_TEST(test_fresh_pressure_bumps_synth_timestamp);
     RUN_TEST(test_reset_clears_state);
     RUN_TEST(test_pitch_rate_sign);
+    RUN_TEST(test_fifo_batched_rows_replay_at_odr);
     return UNITY_END();
 }
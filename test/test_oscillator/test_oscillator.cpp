@@ -0,0 +1,280 @@
+// test_oscillator.cpp — Unit tests for the fixed-point phase-accumulator
+// Oscillator and its AudioMixer source path.
+//
+// Verifies:
+//   - The constexpr quarter-wave table and SineQ15/CosineQ15 accuracy.
+//   - PhaseIncrement() values, guards, and Nyquist clamp.
+//   - Rendered 400/1600 Hz carriers match the legacy cosine tables.
+//   - Chunked rendering is identical to one long render.
+//   - Glides land exactly on target, move monotonically, never jump phase.
+//   - Mix() with an oscillator source equals Mix() over the rendered PCM.
+
+#include <unity.h>
+
+#include <audio/AudioMixer.h>
+#include <audio/Oscillator.h>
+#include <audio/ToneSynth.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using onspeed::audio::CosineQ15;
+using onspeed::audio::kSineQuarterSize;
+using onspeed::audio::kSineQuarterTable;
+using onspeed::audio::Mix;
+using onspeed::audio::MixerInputs;
+using onspeed::audio::MixerState;
+using onspeed::audio::Oscillator;
+using onspeed::audio::PhaseIncrement;
+using onspeed::audio::SineQ15;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// Built at compile time.
+static_assert(kSineQuarterTable[0] == 0, "sin(0)");
+static_assert(kSineQuarterTable[kSineQuarterSize] == 32767, "sin(pi/2)");
+
+std::vector<int16_t> Render(Oscillator& osc, size_t n)
+{
+    std::vector<int16_t> out(n);
+    osc.Render(out.data(), n);
+    return out;
+}
+
+} // namespace
+
+// ============================================================================
+// Table and lookup
+// ============================================================================
+
+void test_quarter_table_monotonic(void)
+{
+    for (size_t i = 1; i <= kSineQuarterSize; ++i)
+        TEST_ASSERT_TRUE(kSineQuarterTable[i] > kSineQuarterTable[i - 1]);
+    // Mid-point: sin(pi/4) * 32767.
+    TEST_ASSERT_INT16_WITHIN(1, 23170, kSineQuarterTable[kSineQuarterSize / 2]);
+}
+
+void test_sine_matches_libm(void)
+{
+    int worst = 0;
+    for (uint32_t k = 0; k < 4096; ++k) {
+        const uint32_t phase = k * 1048573u;   // odd stride hits every quadrant
+        const double   ref   = 32767.0 * std::sin(kTwoPi * phase / 4294967296.0);
+        const int      err   = std::abs(SineQ15(phase) - static_cast<int>(std::lround(ref)));
+        if (err > worst) worst = err;
+    }
+    TEST_ASSERT_TRUE(worst <= 1);
+}
+
+void test_quadrant_points(void)
+{
+    TEST_ASSERT_EQUAL_INT16(0,      SineQ15(0));
+    TEST_ASSERT_EQUAL_INT16(32767,  SineQ15(0x40000000u));
+    TEST_ASSERT_EQUAL_INT16(0,      SineQ15(0x80000000u));
+    TEST_ASSERT_EQUAL_INT16(-32767, SineQ15(0xC0000000u));
+    TEST_ASSERT_EQUAL_INT16(32767,  CosineQ15(0));
+    TEST_ASSERT_EQUAL_INT16(-32767, CosineQ15(0x80000000u));
+}
+
+// ============================================================================
+// PhaseIncrement
+// ============================================================================
+
+void test_phase_increment(void)
+{
+    // 400 Hz at 16 kHz: 40 samples per cycle, 2^32 / 40.
+    TEST_ASSERT_EQUAL_UINT32(107374182u, PhaseIncrement(400.0f, 16000));
+    TEST_ASSERT_EQUAL_UINT32(429496730u, PhaseIncrement(1600.0f, 16000));
+    TEST_ASSERT_EQUAL_UINT32(0u, PhaseIncrement(0.0f, 16000));
+    TEST_ASSERT_EQUAL_UINT32(0u, PhaseIncrement(-5.0f, 16000));
+    TEST_ASSERT_EQUAL_UINT32(0u, PhaseIncrement(400.0f, 0));
+    TEST_ASSERT_EQUAL_UINT32(0u, PhaseIncrement(NAN, 16000));
+    TEST_ASSERT_EQUAL_UINT32(0x7FFFFFFFu, PhaseIncrement(20000.0f, 16000));
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void test_matches_legacy_carriers(void)
+{
+    for (float hz : {400.0f, 1600.0f}) {
+        std::vector<int16_t> legacy(800);
+        onspeed::audio::SynthesizeLegacyCosine(hz, 16000, legacy.data(), legacy.size());
+
+        Oscillator osc;
+        osc.SetFrequency(hz, 16000);
+        const std::vector<int16_t> out = Render(osc, legacy.size());
+        for (size_t i = 0; i < legacy.size(); ++i)
+            TEST_ASSERT_INT16_WITHIN(3, legacy[i], out[i]);
+    }
+}
+
+void test_chunked_render_identical(void)
+{
+    Oscillator a, b;
+    a.SetFrequency(1234.5f, 16000);
+    b.SetFrequency(1234.5f, 16000);
+    const std::vector<int16_t> whole = Render(a, 1000);
+    std::vector<int16_t> parts;
+    for (size_t n : {240u, 240u, 7u, 513u}) {
+        const std::vector<int16_t> p = Render(b, n);
+        parts.insert(parts.end(), p.begin(), p.end());
+    }
+    TEST_ASSERT_TRUE(whole == parts);
+    TEST_ASSERT_EQUAL_UINT32(a.Phase(), b.Phase());
+}
+
+void test_frequency_by_zero_crossings(void)
+{
+    Oscillator osc;
+    osc.SetFrequency(1600.0f, 16000);
+    const std::vector<int16_t> out = Render(osc, 16000);
+    int crossings = 0;
+    for (size_t i = 1; i < out.size(); ++i)
+        if ((out[i - 1] < 0) != (out[i] < 0)) ++crossings;
+    TEST_ASSERT_INT_WITHIN(1, 3200, crossings);
+}
+
+void test_amplitude(void)
+{
+    Oscillator osc;
+    osc.SetFrequency(400.0f, 16000);
+    TEST_ASSERT_INT16_WITHIN(1, 25000, Render(osc, 1)[0]);   // legacy default
+
+    osc.ResetPhase();
+    osc.SetAmplitude(1000);
+    TEST_ASSERT_INT16_WITHIN(1, 1000, Render(osc, 1)[0]);
+
+    osc.SetAmplitude(0);
+    for (int16_t s : Render(osc, 50)) TEST_ASSERT_EQUAL_INT16(0, s);
+}
+
+// ============================================================================
+// Glides
+// ============================================================================
+
+void test_step_keeps_phase(void)
+{
+    Oscillator osc;
+    osc.SetFrequency(400.0f, 16000);
+    Render(osc, 37);
+    const uint32_t phase = osc.Phase();
+    osc.SetFrequency(1600.0f, 16000);
+    TEST_ASSERT_EQUAL_UINT32(phase, osc.Phase());
+    TEST_ASSERT_FALSE(osc.Gliding());
+    TEST_ASSERT_EQUAL_UINT32(PhaseIncrement(1600.0f, 16000), osc.Increment());
+}
+
+void test_glide_lands_on_target(void)
+{
+    Oscillator osc;
+    osc.SetFrequency(400.0f, 16000);
+    osc.SetFrequency(1600.0f, 16000, 240);
+    TEST_ASSERT_TRUE(osc.Gliding());
+
+    uint32_t prev = osc.Increment();
+    int16_t  buf[1];
+    int16_t  last = 0;
+    int      worstJump = 0;
+    for (int i = 0; i < 240; ++i) {
+        osc.Render(buf, 1);
+        TEST_ASSERT_TRUE(osc.Increment() >= prev);
+        prev = osc.Increment();
+        if (i > 0 && std::abs(buf[0] - last) > worstJump) worstJump = std::abs(buf[0] - last);
+        last = buf[0];
+    }
+    TEST_ASSERT_FALSE(osc.Gliding());
+    TEST_ASSERT_EQUAL_UINT32(PhaseIncrement(1600.0f, 16000), osc.Increment());
+    // Never more than one 1600 Hz sample step (2 * pi / 10 of 25000).
+    TEST_ASSERT_TRUE(worstJump < 16000);
+}
+
+void test_slow_glide_moves_every_sample(void)
+{
+    // 0.05 Hz over one second is under one increment unit per sample;
+    // without the Q16 fraction bits the step would truncate to zero.
+    Oscillator osc;
+    osc.SetFrequency(1000.0f, 16000);
+    const uint32_t start = osc.Increment();
+    osc.SetFrequency(1000.05f, 16000, 16000);
+    Render(osc, 8000);
+    const uint32_t mid = osc.Increment();
+    const uint32_t end = PhaseIncrement(1000.05f, 16000);
+    TEST_ASSERT_TRUE(end - start < 16000);
+    TEST_ASSERT_TRUE(mid > start && mid < end);
+    TEST_ASSERT_INT_WITHIN(2, static_cast<int>(start + (end - start) / 2), static_cast<int>(mid));
+}
+
+void test_retarget_mid_glide(void)
+{
+    Oscillator osc;
+    osc.SetFrequency(400.0f, 16000);
+    osc.SetFrequency(1600.0f, 16000, 200);
+    Render(osc, 100);
+    const uint32_t mid = osc.Increment();
+    osc.SetFrequency(400.0f, 16000, 100);
+    Render(osc, 1);
+    TEST_ASSERT_TRUE(osc.Increment() < mid);   // heads down from where it was
+    Render(osc, 99);
+    TEST_ASSERT_EQUAL_UINT32(PhaseIncrement(400.0f, 16000), osc.Increment());
+}
+
+// ============================================================================
+// Mixer source
+// ============================================================================
+
+void test_mix_with_oscillator_matches_buffer(void)
+{
+    constexpr size_t kN = 500;   // spans the mixer's 240-sample render chunks
+    Oscillator live, ref;
+    live.SetFrequency(400.0f, 16000);
+    ref.SetFrequency(400.0f, 16000);
+    live.SetFrequency(900.0f, 16000, 300);
+    ref.SetFrequency(900.0f, 16000, 300);
+    const std::vector<int16_t> pcm = Render(ref, kN);
+
+    MixerInputs a;
+    a.oscillator = &live;
+    a.leftScale  = 0.8f;
+    a.rightScale = 0.3f;
+    MixerInputs b = a;
+    b.oscillator = nullptr;
+    b.in         = pcm.data();
+
+    std::vector<int16_t> outA(2 * kN), outB(2 * kN);
+    MixerState sa, sb;
+    Mix(a, outA.data(), kN, sa);
+    Mix(b, outB.data(), kN, sb);
+    TEST_ASSERT_TRUE(outA == outB);
+    TEST_ASSERT_EQUAL_UINT32(ref.Phase(), live.Phase());
+}
+
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_quarter_table_monotonic);
+    RUN_TEST(test_sine_matches_libm);
+    RUN_TEST(test_quadrant_points);
+    RUN_TEST(test_phase_increment);
+    RUN_TEST(test_matches_legacy_carriers);
+    RUN_TEST(test_chunked_render_identical);
+    RUN_TEST(test_frequency_by_zero_crossings);
+    RUN_TEST(test_amplitude);
+    RUN_TEST(test_step_keeps_phase);
+    RUN_TEST(test_glide_lands_on_target);
+    RUN_TEST(test_slow_glide_moves_every_sample);
+    RUN_TEST(test_retarget_mid_glide);
+    RUN_TEST(test_mix_with_oscillator_matches_buffer);
+    return UNITY_END();
+}
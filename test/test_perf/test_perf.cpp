@@ -11,10 +11,14 @@
 //   - Drain produces histograms with right count/sum/min/max.
 //   - Percentile reconstruction matches the analytical answer within
 //     bucket resolution.
+//   - recordScopeEvent() lands an explicit duration in its scope bucket.
 //   - SPI scopes route into spi_counters_ not scope_hist_.
 //   - Multi-producer (two threads, each owning a different TaskId
 //     ring) produces independent histograms with no cross-talk.
 //   - Ring overflow increments drops, doesn't corrupt.
+//   - Trace capture records ordered, timestamped events with task ids,
+//     fills its window then disarms, and only while armed; restarting
+//     it under load never strands a window.
 
 #include <unity.h>
 
@@ -33,10 +37,12 @@ void setUp(void) {
     Consumer consumer;
     consumer.drainAll();
     consumer.reset();
+    releaseTraceWindow();
 }
 
 void tearDown(void) {
     setPerfEnabled(false);
+    releaseTraceWindow();
 }
 
 // ----------------------------------------------------------------------------
@@ -92,6 +98,20 @@ void test_loop_records_with_stack(void)
     TEST_ASSERT_EQUAL_UINT32(800, consumer.taskStackHighWater(TaskId::Imu));
 }
 
+void test_scope_event_records_explicit_duration(void)
+{
+    PerfLoop loop(TaskId::Audio, 2000);
+    recordScopeEvent(ScopeId::StallOnset, nowUs(), 17000);
+    recordScopeEvent(ScopeId::StallOnset, nowUs(), 9000);
+    Consumer consumer;
+    consumer.drainAll();
+
+    const auto& h = consumer.scopeHistogram(ScopeId::StallOnset);
+    TEST_ASSERT_EQUAL_UINT64(2, h.count);
+    TEST_ASSERT_EQUAL_UINT32(9000, h.minUs);
+    TEST_ASSERT_EQUAL_UINT32(17000, h.maxUs);
+}
+
 void test_percentile_p50_matches_expected(void)
 {
     PerfLoop loop(TaskId::Sensors, 2000);
@@ -244,6 +264,143 @@ void test_boom_ring_overflow_increments_drops(void)
     TEST_ASSERT_GREATER_OR_EQUAL_UINT32(100, consumer.taskDrops(TaskId::BoomRead));
 }
 
+void test_trace_idle_records_nothing(void)
+{
+    {
+        PerfLoop loop(TaskId::Imu, 2000);
+        PerfScope guard(ScopeId::EkfqPredict);
+    }
+    TraceWindow w{};
+    TEST_ASSERT_FALSE(traceCaptureArmed());
+    TEST_ASSERT_FALSE(traceWindowReady(w));
+}
+
+void test_trace_records_nested_events_in_order(void)
+{
+    TEST_ASSERT_TRUE(startTraceCapture());
+    {
+        PerfLoop loop(TaskId::Sensors, 1234);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        {
+            PerfScope guard(ScopeId::PressureRead);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    TraceWindow w{};
+    TEST_ASSERT_FALSE(traceWindowReady(w));   // still armed
+    stopTraceCapture();
+    TEST_ASSERT_TRUE(traceWindowReady(w));
+    TEST_ASSERT_EQUAL_UINT32(2, w.count);
+    TEST_ASSERT_EQUAL_UINT32(0, w.dropped);
+
+    // Events land in completion order: the inner scope ends first.
+    const TraceEvent& scope = w.events[0];
+    const TraceEvent& loop  = w.events[1];
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ScopeId::PressureRead), scope.scopeId);
+    TEST_ASSERT_EQUAL_UINT8(0, scope.flags);
+    TEST_ASSERT_EQUAL_UINT8(kFlagLoop, loop.flags);
+    TEST_ASSERT_EQUAL_UINT16(1234, loop.stackHighWaterWords);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TaskId::Sensors), scope.taskId);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TaskId::Sensors), loop.taskId);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(100, scope.durationUs);
+    // The scope sits inside the loop on the shared timeline.
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(loop.startUs + 50, scope.startUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(loop.startUs + loop.durationUs,
+                                     scope.startUs + scope.durationUs);
+
+    // One window at a time.
+    TEST_ASSERT_FALSE(startTraceCapture());
+    releaseTraceWindow();
+    TEST_ASSERT_TRUE(startTraceCapture());
+}
+
+void test_trace_window_fills_then_disarms(void)
+{
+    TEST_ASSERT_TRUE(startTraceCapture());
+    PerfLoop loop(TaskId::Imu, 2000);
+    for (size_t i = 0; i < kTraceCapacity + 100; ++i) {
+        PerfScope guard(ScopeId::EkfqCorrect);
+    }
+    TEST_ASSERT_FALSE(traceCaptureArmed());
+    TraceWindow w{};
+    TEST_ASSERT_TRUE(traceWindowReady(w));
+    TEST_ASSERT_EQUAL_UINT32(kTraceCapacity, w.count);
+    for (uint32_t i = 1; i < w.count; ++i) {
+        TEST_ASSERT_TRUE(w.events[i].startUs >= w.events[i - 1].startUs);
+    }
+}
+
+void test_trace_multi_producer_tags_tasks(void)
+{
+    TEST_ASSERT_TRUE(startTraceCapture());
+    auto producer = [](TaskId taskId, ScopeId scopeId, int n) {
+        PerfLoop loop(taskId, 2000);
+        for (int i = 0; i < n; ++i) PerfScope guard(scopeId);
+    };
+    std::thread t1(producer, TaskId::Imu, ScopeId::EkfqCorrect, 200);
+    std::thread t2(producer, TaskId::Log, ScopeId::LogSync, 100);
+    t1.join();
+    t2.join();
+    stopTraceCapture();
+
+    TraceWindow w{};
+    TEST_ASSERT_TRUE(traceWindowReady(w));
+    TEST_ASSERT_EQUAL_UINT32(302, w.count);   // scopes + one loop each
+    int imu = 0, log = 0;
+    for (uint32_t i = 0; i < w.count; ++i) {
+        const TraceEvent& ev = w.events[i];
+        if (ev.scopeId == static_cast<uint8_t>(ScopeId::EkfqCorrect)) {
+            TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TaskId::Imu), ev.taskId);
+            ++imu;
+        } else if (ev.scopeId == static_cast<uint8_t>(ScopeId::LogSync)) {
+            TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TaskId::Log), ev.taskId);
+            ++log;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(200, imu);
+    TEST_ASSERT_EQUAL_INT(100, log);
+}
+
+// Captures started and released back to back while producers keep
+// recording. Odd cycles release without waiting for the window, so a
+// producer between its claim and its publish straddles the restart;
+// every even-cycle window must still become ready once stopped.
+void test_trace_restart_under_load_stays_ready(void)
+{
+    std::atomic<bool> stop{false};
+    auto producer = [&stop](TaskId taskId, ScopeId scopeId) {
+        PerfLoop loop(taskId, 2000);
+        while (!stop.load(std::memory_order_relaxed)) PerfScope guard(scopeId);
+    };
+    std::thread t1(producer, TaskId::Imu, ScopeId::EkfqCorrect);
+    std::thread t2(producer, TaskId::Log, ScopeId::LogSync);
+
+    int stuck = 0;
+    for (int cycle = 0; cycle < 2000 && stuck == 0; ++cycle) {
+        TEST_ASSERT_TRUE(startTraceCapture());
+        if (cycle % 3 == 0) std::this_thread::sleep_for(std::chrono::microseconds(20));
+        stopTraceCapture();
+        if (cycle % 2 == 1) {
+            releaseTraceWindow();
+            continue;
+        }
+        TraceWindow w{};
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!traceWindowReady(w)) {
+            if (std::chrono::steady_clock::now() > deadline) { stuck = cycle + 1; break; }
+            std::this_thread::yield();
+        }
+        if (stuck == 0) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(kTraceCapacity, w.count);
+        }
+        releaseTraceWindow();
+    }
+    stop.store(true);
+    t1.join();
+    t2.join();
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, stuck, "trace window never became ready");
+}
+
 void test_names(void)
 {
     TEST_ASSERT_EQUAL_STRING("ekfq.correct", scopeName(ScopeId::EkfqCorrect));
@@ -258,6 +415,7 @@ int main(int, char**)
     RUN_TEST(test_disabled_drops_all_events);
     RUN_TEST(test_scope_records_into_correct_bucket);
     RUN_TEST(test_loop_records_with_stack);
+    RUN_TEST(test_scope_event_records_explicit_duration);
     RUN_TEST(test_percentile_p50_matches_expected);
     RUN_TEST(test_spi_routes_to_counters_not_histogram);
     RUN_TEST(test_multi_producer_no_crosstalk);
@@ -265,6 +423,11 @@ int main(int, char**)
     RUN_TEST(test_default_ring_overflow_increments_drops);
     RUN_TEST(test_efis_ring_overflow_increments_drops);
     RUN_TEST(test_boom_ring_overflow_increments_drops);
+    RUN_TEST(test_trace_idle_records_nothing);
+    RUN_TEST(test_trace_records_nested_events_in_order);
+    RUN_TEST(test_trace_window_fills_then_disarms);
+    RUN_TEST(test_trace_multi_producer_tags_tasks);
+    RUN_TEST(test_trace_restart_under_load_stays_ready);
     RUN_TEST(test_names);
     return UNITY_END();
 }
@@ -0,0 +1,274 @@
+// test_tone_pipeline.cpp — Unit tests for TonePipeline (render-ahead tone
+// chunks with cancel/rewind) and its tone-change classification.
+//
+// Verifies:
+//   - Lookahead bound, FIFO order, and Pop()/Front() bookkeeping.
+//   - Queued chunks are bit-identical to mixing the same state directly.
+//   - Cancel() rewinds to the submitted audio: re-rendering unchanged
+//     reproduces the dropped chunks, and a new command starts from the
+//     exact phase and envelope the last submitted chunk left off at.
+//   - Marks follow their chunk and die with it on Cancel().
+//   - ToneChangeNeedsRerender() / IsStallWarning() classification.
+
+#include <unity.h>
+
+#include <audio/AudioMixer.h>
+#include <audio/AudioOrchestrator.h>
+#include <audio/TonePipeline.h>
+
+#include <cstdint>
+#include <vector>
+
+using onspeed::EnToneType;
+using onspeed::ToneResult;
+using onspeed::audio::DecideAndArm;
+using onspeed::audio::IsStallWarning;
+using onspeed::audio::kToneChunkFrames;
+using onspeed::audio::kToneMaxLookahead;
+using onspeed::audio::Mix;
+using onspeed::audio::MixerInputs;
+using onspeed::audio::OrchestratorConfig;
+using onspeed::audio::PackStereoI16;
+using onspeed::audio::ToneChangeNeedsRerender;
+using onspeed::audio::ToneChunkParams;
+using onspeed::audio::TonePipeline;
+using onspeed::audio::ToneRenderState;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+const OrchestratorConfig kCfg{};
+
+ToneResult Tone(EnToneType t, float pps)
+{
+    return ToneResult{t, pps, 1.0f};
+}
+
+ToneChunkParams Params(float hz)
+{
+    ToneChunkParams p;
+    p.toneHz     = hz;
+    p.leftScale  = 0.9f;
+    p.rightScale = 0.4f;
+    return p;
+}
+
+std::vector<uint32_t> Chunk(const uint32_t* frames)
+{
+    return std::vector<uint32_t>(frames, frames + kToneChunkFrames);
+}
+
+// Pop the front chunk, returning its frames.
+std::vector<uint32_t> Take(TonePipeline& p)
+{
+    TEST_ASSERT_NOT_NULL(p.Front());
+    std::vector<uint32_t> c = Chunk(p.Front());
+    p.Pop();
+    return c;
+}
+
+// Reference: render one chunk from `s` the way the pipeline should.
+std::vector<uint32_t> Direct(ToneRenderState& s, const ToneChunkParams& p)
+{
+    if (onspeed::audio::PhaseIncrement(p.toneHz, p.sampleRateHz) != s.oscillator.Target())
+        s.oscillator.SetFrequency(p.toneHz, p.sampleRateHz, p.glideSamples);
+    MixerInputs inp;
+    inp.oscillator = &s.oscillator;
+    inp.envelope   = &s.envelope;
+    inp.leftScale  = p.leftScale;
+    inp.rightScale = p.rightScale;
+    std::vector<int16_t>  stereo(2 * kToneChunkFrames);
+    std::vector<uint32_t> out(kToneChunkFrames);
+    Mix(inp, stereo.data(), kToneChunkFrames, s.mixer);
+    for (size_t j = 0; j < kToneChunkFrames; ++j)
+        out[j] = PackStereoI16(stereo[2 * j], stereo[2 * j + 1]);
+    return out;
+}
+
+bool Silent(const std::vector<uint32_t>& c)
+{
+    for (uint32_t f : c)
+        if (f != 0) return false;
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Queue
+// ============================================================================
+
+void test_lookahead_bound_and_order(void)
+{
+    TonePipeline p(3);
+    TEST_ASSERT_TRUE(p.Empty());
+    TEST_ASSERT_NULL(p.Front());
+    DecideAndArm(Tone(EnToneType::Low, 0.0f), p.Head().envelope, kCfg);
+
+    ToneRenderState ref = p.Head();
+    std::vector<std::vector<uint32_t>> expect;
+    for (int i = 0; i < 3; ++i) {
+        TEST_ASSERT_TRUE(p.Render(Params(400.0f)));
+        expect.push_back(Direct(ref, Params(400.0f)));
+    }
+    TEST_ASSERT_TRUE(p.Full());
+    TEST_ASSERT_FALSE(p.Render(Params(400.0f)));
+    TEST_ASSERT_EQUAL_size_t(3, p.Pending());
+
+    for (int i = 0; i < 3; ++i)
+        TEST_ASSERT_TRUE(Take(p) == expect[static_cast<size_t>(i)]);
+    TEST_ASSERT_TRUE(p.Empty());
+    p.Pop();   // no-op when empty
+    TEST_ASSERT_EQUAL_size_t(0, p.Pending());
+
+    // The ring wraps: keep going past kToneMaxLookahead chunks.
+    for (int i = 0; i < 10; ++i) {
+        TEST_ASSERT_TRUE(p.Render(Params(400.0f)));
+        TEST_ASSERT_TRUE(Take(p) == Direct(ref, Params(400.0f)));
+    }
+}
+
+void test_lookahead_clamped(void)
+{
+    TEST_ASSERT_EQUAL_size_t(1, TonePipeline(0).Lookahead());
+    TEST_ASSERT_EQUAL_size_t(kToneMaxLookahead, TonePipeline(99).Lookahead());
+    TEST_ASSERT_EQUAL_size_t(2, TonePipeline().Lookahead());
+}
+
+// ============================================================================
+// Cancel
+// ============================================================================
+
+void test_cancel_rerender_is_identical(void)
+{
+    TonePipeline p(4);
+    DecideAndArm(Tone(EnToneType::High, 20.0f), p.Head().envelope, kCfg);
+    for (int i = 0; i < 4; ++i) p.Render(Params(1600.0f));
+    const std::vector<uint32_t> first = Take(p);   // "submitted"
+    std::vector<std::vector<uint32_t>> queued;
+    for (int i = 0; i < 3; ++i) queued.push_back(Take(p));
+    TEST_ASSERT_FALSE(Silent(queued[2]));   // past the first-pulse delay
+
+    // Same again, but cancel the three unsubmitted chunks.
+    TonePipeline q(4);
+    DecideAndArm(Tone(EnToneType::High, 20.0f), q.Head().envelope, kCfg);
+    for (int i = 0; i < 4; ++i) q.Render(Params(1600.0f));
+    TEST_ASSERT_TRUE(Take(q) == first);
+    TEST_ASSERT_EQUAL_size_t(3, q.Cancel());
+    TEST_ASSERT_TRUE(q.Empty());
+    TEST_ASSERT_EQUAL_size_t(0, q.Cancel());
+
+    for (int i = 0; i < 3; ++i) q.Render(Params(1600.0f));
+    for (int i = 0; i < 3; ++i)
+        TEST_ASSERT_TRUE(Take(q) == queued[static_cast<size_t>(i)]);
+}
+
+void test_cancel_continues_from_submitted_audio(void)
+{
+    TonePipeline p(3);
+    DecideAndArm(Tone(EnToneType::Low, 0.0f), p.Head().envelope, kCfg);
+    p.Render(Params(400.0f));
+    const ToneRenderState afterFirst = p.Head();
+    p.Render(Params(400.0f));
+    p.Render(Params(400.0f));
+    Take(p);
+
+    // Urgent change: drop the two queued chunks, arm stall on the rewound head.
+    TEST_ASSERT_EQUAL_size_t(2, p.Cancel());
+    TEST_ASSERT_EQUAL_UINT32(afterFirst.oscillator.Phase(), p.Head().oscillator.Phase());
+    TEST_ASSERT_TRUE(afterFirst.envelope.Level() == p.Head().envelope.Level());
+
+    ToneRenderState ref = afterFirst;
+    DecideAndArm(Tone(EnToneType::High, 20.0f), ref.envelope, kCfg);
+    DecideAndArm(Tone(EnToneType::High, 20.0f), p.Head().envelope, kCfg);
+    p.Render(Params(1600.0f));
+    TEST_ASSERT_TRUE(Take(p) == Direct(ref, Params(1600.0f)));
+}
+
+// ============================================================================
+// Marks
+// ============================================================================
+
+void test_marks_follow_chunk(void)
+{
+    TonePipeline p(3);
+    uint64_t stamp = 0;
+    p.Render(Params(400.0f));
+    p.MarkNextChunk(1234);
+    p.Render(Params(400.0f));
+    p.Render(Params(400.0f));
+
+    TEST_ASSERT_FALSE(p.FrontMark(stamp));
+    p.Pop();
+    TEST_ASSERT_TRUE(p.FrontMark(stamp));
+    TEST_ASSERT_EQUAL_UINT64(1234, stamp);
+    p.Pop();
+    TEST_ASSERT_FALSE(p.FrontMark(stamp));
+    p.Pop();
+    TEST_ASSERT_FALSE(p.FrontMark(stamp));
+}
+
+void test_cancel_drops_marks(void)
+{
+    TonePipeline p(3);
+    uint64_t stamp = 0;
+    p.MarkNextChunk(1);
+    p.Render(Params(400.0f));
+    p.MarkNextChunk(2);         // pending, never rendered
+    p.Cancel();
+    p.Render(Params(400.0f));
+    TEST_ASSERT_FALSE(p.FrontMark(stamp));
+}
+
+// ============================================================================
+// Change classification
+// ============================================================================
+
+void test_stall_warning(void)
+{
+    TEST_ASSERT_TRUE(IsStallWarning(Tone(EnToneType::High, 20.0f), kCfg));
+    TEST_ASSERT_TRUE(IsStallWarning(Tone(EnToneType::High, kCfg.stallPpsThreshold), kCfg));
+    TEST_ASSERT_FALSE(IsStallWarning(Tone(EnToneType::High, 6.2f), kCfg));
+    TEST_ASSERT_FALSE(IsStallWarning(Tone(EnToneType::High, 0.0f), kCfg));
+    TEST_ASSERT_FALSE(IsStallWarning(Tone(EnToneType::Low, 20.0f), kCfg));
+}
+
+void test_change_needs_rerender(void)
+{
+    const ToneResult none   = Tone(EnToneType::None, 0.0f);
+    const ToneResult solid  = Tone(EnToneType::Low, 0.0f);
+    const ToneResult lowP   = Tone(EnToneType::Low, 3.0f);
+    const ToneResult highP  = Tone(EnToneType::High, 5.0f);
+    const ToneResult stall  = Tone(EnToneType::High, 20.0f);
+
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(highP, stall, kCfg));
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(stall, highP, kCfg));
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(none, stall, kCfg));
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(stall, none, kCfg));
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(solid, highP, kCfg));
+    TEST_ASSERT_TRUE(ToneChangeNeedsRerender(solid, lowP, kCfg));
+
+    // Drift within a band, and silence staying silent, ride the lookahead.
+    TEST_ASSERT_FALSE(ToneChangeNeedsRerender(highP, Tone(EnToneType::High, 5.5f), kCfg));
+    TEST_ASSERT_FALSE(ToneChangeNeedsRerender(lowP, Tone(EnToneType::Low, 2.0f), kCfg));
+    TEST_ASSERT_FALSE(ToneChangeNeedsRerender(stall, stall, kCfg));
+    TEST_ASSERT_FALSE(ToneChangeNeedsRerender(none, Tone(EnToneType::None, 20.0f), kCfg));
+}
+
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_lookahead_bound_and_order);
+    RUN_TEST(test_lookahead_clamped);
+    RUN_TEST(test_cancel_rerender_is_identical);
+    RUN_TEST(test_cancel_continues_from_submitted_audio);
+    RUN_TEST(test_marks_follow_chunk);
+    RUN_TEST(test_cancel_drops_marks);
+    RUN_TEST(test_stall_warning);
+    RUN_TEST(test_change_needs_rerender);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+#include <unity.h>
+#include <cmath>
+#include <limits>
+
+#include <replay/VnTruthLoss.h>
+
+using onspeed::AhrsOutputs;
+using onspeed::replay::VnTruthLoss;
+using onspeed::replay::VnTruthLossProfile;
+using onspeed::replay::VnTruthLossResult;
+using onspeed::replay::VnTruthSample;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// VN age counts up between frames and drops on a fresh one.
+static VnTruthSample makeTruth(float pitch, float roll, float vzDown,
+                               float ageMs, float tasKt = 100.0f)
+{
+    VnTruthSample t;
+    t.pitchDeg    = pitch;
+    t.rollDeg     = roll;
+    t.vzMps       = vzDown;
+    t.tasKt       = tasKt;
+    t.aoaDeg      = 4.0f;
+    t.vnDataAgeMs = ageMs;
+    return t;
+}
+
+// EKF outputs matching `t` exactly (vsiFpm is +climb, vz is +down).
+static AhrsOutputs matching(const VnTruthSample& t)
+{
+    AhrsOutputs o;
+    o.pitchDeg      = t.pitchDeg;
+    o.rollDeg       = t.rollDeg;
+    o.vsiFpm        = -t.vzMps / 0.00508f;
+    o.derivedAoaDeg = t.aoaDeg;
+    return o;
+}
+
+void test_perfect_tracking_scores_zero(void)
+{
+    VnTruthLoss loss(VnTruthLossProfile::CruiseAoa());
+    loss.seed(makeTruth(2.0f, 0.0f, 0.0f, 20.0f));
+    for (int i = 0; i < 40; ++i) {
+        const VnTruthSample t = makeTruth(2.0f + 0.1f * i, 1.0f, -1.0f,
+                                          (float)((i % 4) * 5));
+        loss.add(t, matching(t));
+    }
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_EQUAL_size_t(40, r.rows);
+    TEST_ASSERT_EQUAL_size_t(10, r.freshVnRows);   // age 15 → 0 every 4th row
+    TEST_ASSERT_TRUE(r.finite);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, r.total);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, r.pitchRms);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, r.vzRms);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.0f, r.alphaKinRms);
+}
+
+// Constant 1° pitch bias, quadratic Huber region: RMS = sqrt(0.5 · 1²).
+void test_constant_pitch_bias(void)
+{
+    VnTruthLoss loss;   // default profile, pitch knee 2°
+    loss.seed(makeTruth(0.0f, 0.0f, 0.0f, 5.0f));
+    for (int i = 0; i < 20; ++i) {
+        const VnTruthSample t = makeTruth(3.0f, 0.0f, 0.0f, (i % 2) ? 5.0f : 0.0f);
+        AhrsOutputs o = matching(t);
+        o.pitchDeg += 1.0f;
+        loss.add(t, o);
+    }
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_EQUAL_size_t(10, r.freshVnRows);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, std::sqrt(0.5f), r.pitchRms);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.0f, r.rollRms);
+    // A constant bias has no rate error.
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, r.pitchRateRms);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, std::sqrt(0.5f), r.total);
+}
+
+// Roll residuals wrap through ±180°: 179° vs −179° is a 2° error.
+void test_roll_residual_wraps(void)
+{
+    VnTruthLoss loss;
+    const VnTruthSample t = makeTruth(0.0f, -179.0f, 0.0f, 0.0f);
+    AhrsOutputs o = matching(t);
+    o.rollDeg = 179.0f;
+    loss.add(t, o);
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_EQUAL_size_t(1, r.freshVnRows);   // no seed: first row is fresh
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, std::sqrt(0.5f * 4.0f), r.rollRms);
+}
+
+// A row whose VN age did not drop is not scored for attitude.
+void test_stale_rows_not_scored(void)
+{
+    VnTruthLoss loss;
+    loss.seed(makeTruth(0.0f, 0.0f, 0.0f, 1.0f));
+    const VnTruthSample t = makeTruth(0.0f, 0.0f, 0.0f, 6.0f);
+    AhrsOutputs o = matching(t);
+    o.pitchDeg = 30.0f;
+    loss.add(t, o);
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_EQUAL_size_t(0, r.freshVnRows);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, r.pitchRms);
+}
+
+// aeroWeight 0 removes aerobatic samples from the cruise-aoa score.
+void test_aerobatic_samples_ignored_by_cruise_aoa(void)
+{
+    VnTruthLoss loss(VnTruthLossProfile::CruiseAoa());
+    const VnTruthSample t = makeTruth(45.0f, 60.0f, 0.0f, 0.0f);
+    AhrsOutputs o = matching(t);
+    o.pitchDeg += 5.0f;
+    loss.add(t, o);
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_EQUAL_size_t(1, r.freshVnRows);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, r.pitchRms);
+}
+
+void test_non_finite_output_scores_infinite(void)
+{
+    VnTruthLoss loss;
+    const VnTruthSample t = makeTruth(0.0f, 0.0f, 0.0f, 0.0f);
+    AhrsOutputs o = matching(t);
+    o.altFt = std::numeric_limits<float>::quiet_NaN();
+    loss.add(t, o);
+    const VnTruthLossResult r = loss.finish();
+    TEST_ASSERT_FALSE(r.finite);
+    TEST_ASSERT_TRUE(std::isinf(r.total));
+}
+
+// Kinematic α is gated on TAS and combines pitch and vz errors.
+void test_kinematic_alpha(void)
+{
+    VnTruthLoss slow(VnTruthLossProfile::CruiseAoa());
+    VnTruthLoss fast(VnTruthLossProfile::CruiseAoa());
+    const VnTruthSample tSlow = makeTruth(2.0f, 0.0f, 0.0f, 0.0f, 10.0f);   // 5.1 m/s
+    const VnTruthSample tFast = makeTruth(2.0f, 0.0f, 0.0f, 0.0f, 100.0f);
+    AhrsOutputs oSlow = matching(tSlow);
+    AhrsOutputs oFast = matching(tFast);
+    oSlow.vsiFpm = oFast.vsiFpm = 500.0f;   // EKF climbs 2.54 m/s, truth level
+    slow.add(tSlow, oSlow);
+    fast.add(tFast, oFast);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, slow.finish().alphaKinRms);
+
+    // α_ekf − α_vn = −asin(−2.54 / 51.44) → +2.83°, linear Huber region.
+    const double resid = -std::asin(-2.54 / (100.0 * 0.514444)) * 57.29577951308232;
+    const double expect = std::sqrt(0.5 * (resid - 0.25));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, (float)expect, fast.finish().alphaKinRms);
+}
+
+void test_profile_names(void)
+{
+    VnTruthLossProfile p;
+    TEST_ASSERT_TRUE(VnTruthLossProfile::FromName("cruise-aoa", p));
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, p.wAlpha);
+    TEST_ASSERT_TRUE(VnTruthLossProfile::FromName("cruise-pitch", p));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, p.wAlpha);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, p.wPitch);
+    TEST_ASSERT_TRUE(VnTruthLossProfile::FromName("default", p));
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, p.aeroWeight);
+    TEST_ASSERT_FALSE(VnTruthLossProfile::FromName("cruise", p));
+}
+
+int main(int, char**)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_perfect_tracking_scores_zero);
+    RUN_TEST(test_constant_pitch_bias);
+    RUN_TEST(test_roll_residual_wraps);
+    RUN_TEST(test_stale_rows_not_scored);
+    RUN_TEST(test_aerobatic_samples_ignored_by_cruise_aoa);
+    RUN_TEST(test_non_finite_output_scores_infinite);
+    RUN_TEST(test_kinematic_alpha);
+    RUN_TEST(test_profile_names);
+    return UNITY_END();
+}
@@ -0,0 +1,259 @@
+// test_voice_codec.cpp — Unit tests for VoiceCodec (compressed voice prompts).
+//
+// Verifies:
+//   - Block-header state: each block decodes from its own predictor/index.
+//   - Leading/trailing silence plays back as exact zeros around the codes.
+//   - Chunked Read() produces the same stream as one large Read().
+//   - Malformed assets (wrong block bytes, null data) decode as empty.
+//   - Every generated prompt in Audio/VoiceAssets.h decodes to the length
+//     of its Audio/PCM_*.h master, at 16 kHz, within ADPCM noise of it.
+
+#include <unity.h>
+
+#include <audio/VoiceCodec.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Masters, for comparison. Same single-TU constraint as test_wav_decode.
+#include "Audio/PCM_cal_canceled.h"
+#include "Audio/PCM_cal_mode.h"
+#include "Audio/PCM_cal_saved.h"
+#include "Audio/PCM_datamark.h"
+#include "Audio/PCM_disabled.h"
+#include "Audio/PCM_enabled.h"
+#include "Audio/PCM_glimit.h"
+#include "Audio/PCM_overg.h"
+#include "Audio/PCM_VnoChime.h"
+#include "Audio/PCM_left_speaker.h"
+#include "Audio/PCM_right_speaker.h"
+
+#include "Audio/VoiceAssets.h"
+
+using onspeed::audio::IsValidVoiceAsset;
+using onspeed::audio::kVoiceBlockBytes;
+using onspeed::audio::kVoiceBlockSamples;
+using onspeed::audio::VoiceAsset;
+using onspeed::audio::VoiceDecoder;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace {
+
+std::vector<int16_t> DecodeAll(const VoiceAsset& asset, size_t chunk)
+{
+    VoiceDecoder         dec(asset);
+    std::vector<int16_t> out;
+    std::vector<int16_t> buf(chunk);
+    for (size_t n; (n = dec.Read(buf.data(), chunk)) > 0;)
+        out.insert(out.end(), buf.begin(), buf.begin() + static_cast<long>(n));
+    return out;
+}
+
+std::vector<int16_t> Master(const unsigned char* bytes, unsigned int len)
+{
+    std::vector<int16_t> out(len / 2);
+    std::memcpy(out.data(), bytes, out.size() * sizeof(int16_t));
+    return out;
+}
+
+// One block: predictor `pred`, step index `index`, every code `code`.
+std::vector<uint8_t> Block(int16_t pred, uint8_t index, uint8_t code)
+{
+    std::vector<uint8_t> b(kVoiceBlockBytes, static_cast<uint8_t>(code | (code << 4)));
+    b[0] = static_cast<uint8_t>(pred & 0xFF);
+    b[1] = static_cast<uint8_t>((static_cast<uint16_t>(pred) >> 8) & 0xFF);
+    b[2] = index;
+    b[3] = 0;
+    return b;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+
+static void test_block_header_restarts_state()
+{
+    // Code 0 at step index 0 adds 7 >> 3 == 0: the predictor holds.
+    std::vector<uint8_t> data = Block(1000, 0, 0);
+    const std::vector<uint8_t> second = Block(-2000, 0, 0);
+    data.insert(data.end(), second.begin(), second.end());
+
+    VoiceAsset a;
+    a.blocks       = data.data();
+    a.blockBytes   = data.size();
+    a.codedSamples = static_cast<uint32_t>(kVoiceBlockSamples + 10);
+    a.sampleRateHz = 16000;
+    TEST_ASSERT_TRUE(IsValidVoiceAsset(a));
+
+    const std::vector<int16_t> pcm = DecodeAll(a, 1000);
+    TEST_ASSERT_EQUAL_size_t(kVoiceBlockSamples + 10, pcm.size());
+    TEST_ASSERT_EQUAL_INT16(1000, pcm[0]);
+    TEST_ASSERT_EQUAL_INT16(1000, pcm[kVoiceBlockSamples - 1]);
+    TEST_ASSERT_EQUAL_INT16(-2000, pcm[kVoiceBlockSamples]);
+    TEST_ASSERT_EQUAL_INT16(-2000, pcm.back());
+}
+
+static void test_code_steps_and_clamps()
+{
+    // Code 7 at index 88 adds the largest step every sample: clamps at +32767.
+    std::vector<uint8_t> data = Block(30000, 88, 7);
+    VoiceAsset a;
+    a.blocks       = data.data();
+    a.blockBytes   = data.size();
+    a.codedSamples = 4;
+    const std::vector<int16_t> up = DecodeAll(a, 4);
+    TEST_ASSERT_EQUAL_size_t(4, up.size());
+    for (int16_t s : up) TEST_ASSERT_EQUAL_INT16(32767, s);
+
+    // Code 0xF is the negative twin.
+    data = Block(-30000, 88, 0xF);
+    a.blocks = data.data();
+    for (int16_t s : DecodeAll(a, 4)) TEST_ASSERT_EQUAL_INT16(-32768, s);
+
+    // Code 4 at index 0: +7 + (7 >> 3) == +7, then index 2 (step 9): +10.
+    data = Block(0, 0, 4);
+    a.blocks = data.data();
+    const std::vector<int16_t> small = DecodeAll(a, 4);
+    TEST_ASSERT_EQUAL_INT16(7,  small[0]);
+    TEST_ASSERT_EQUAL_INT16(17, small[1]);
+}
+
+static void test_silence_padding()
+{
+    const std::vector<uint8_t> data = Block(500, 0, 0);
+    VoiceAsset a;
+    a.blocks       = data.data();
+    a.blockBytes   = data.size();
+    a.codedSamples = 3;
+    a.leadSilence  = 5;
+    a.trailSilence = 2;
+    TEST_ASSERT_EQUAL_size_t(10, a.TotalSamples());
+
+    VoiceDecoder dec(a);
+    TEST_ASSERT_EQUAL_size_t(10, dec.Remaining());
+    int16_t out[16];
+    TEST_ASSERT_EQUAL_size_t(10, dec.Read(out, 16));
+    const int16_t expect[10] = {0, 0, 0, 0, 0, 500, 500, 500, 0, 0};
+    for (size_t i = 0; i < 10; ++i) TEST_ASSERT_EQUAL_INT16(expect[i], out[i]);
+    TEST_ASSERT_TRUE(dec.Done());
+    TEST_ASSERT_EQUAL_size_t(0, dec.Read(out, 16));
+
+    // Pure silence needs no blocks at all.
+    VoiceAsset quiet;
+    quiet.leadSilence = 7;
+    TEST_ASSERT_TRUE(IsValidVoiceAsset(quiet));
+    TEST_ASSERT_EQUAL_size_t(7, DecodeAll(quiet, 3).size());
+}
+
+static void test_chunked_read_matches_whole()
+{
+    const std::vector<int16_t> whole = DecodeAll(overg_voice, overg_voice.TotalSamples());
+    TEST_ASSERT_EQUAL_size_t(overg_voice.TotalSamples(), whole.size());
+    for (size_t chunk : {size_t{1}, size_t{7}, kVoiceBlockSamples, size_t{1000}}) {
+        const std::vector<int16_t> parts = DecodeAll(overg_voice, chunk);
+        TEST_ASSERT_EQUAL_size_t(whole.size(), parts.size());
+        TEST_ASSERT_TRUE(parts == whole);
+    }
+
+    VoiceDecoder dec(overg_voice);
+    int16_t buf[4];
+    TEST_ASSERT_EQUAL_size_t(0, dec.Read(buf, 0));
+    TEST_ASSERT_EQUAL_size_t(0, dec.Read(nullptr, 4));
+    TEST_ASSERT_EQUAL_size_t(overg_voice.TotalSamples(), dec.Remaining());
+}
+
+static void test_malformed_assets_are_empty()
+{
+    const std::vector<uint8_t> data = Block(0, 0, 0);
+    VoiceAsset a;
+    a.blocks       = data.data();
+    a.blockBytes   = data.size() - 1;
+    a.codedSamples = 10;
+    a.leadSilence  = 4;
+    TEST_ASSERT_FALSE(IsValidVoiceAsset(a));
+    VoiceDecoder truncated(a);
+    TEST_ASSERT_TRUE(truncated.Done());
+
+    // One block can't hold 241 samples.
+    a.blockBytes   = data.size();
+    a.codedSamples = static_cast<uint32_t>(kVoiceBlockSamples + 1);
+    TEST_ASSERT_FALSE(IsValidVoiceAsset(a));
+
+    a.blocks       = nullptr;
+    a.codedSamples = 10;
+    TEST_ASSERT_FALSE(IsValidVoiceAsset(a));
+    TEST_ASSERT_EQUAL_size_t(0, DecodeAll(a, 16).size());
+}
+
+// ---------------------------------------------------------------------------
+// Generated assets against their masters
+// ---------------------------------------------------------------------------
+
+static void CheckAsset(const VoiceAsset& asset, const unsigned char* pcm, unsigned int pcmLen)
+{
+    TEST_ASSERT_TRUE(IsValidVoiceAsset(asset));
+    TEST_ASSERT_EQUAL_INT(16000, asset.sampleRateHz);
+
+    const std::vector<int16_t> master  = Master(pcm, pcmLen);
+    const std::vector<int16_t> decoded = DecodeAll(asset, kVoiceBlockSamples);
+    TEST_ASSERT_EQUAL_size_t(master.size(), decoded.size());
+
+    // At least 3.5:1 against the raw master.
+    TEST_ASSERT_TRUE(asset.blockBytes * 7 <= static_cast<size_t>(pcmLen) * 2);
+
+    double sig = 0.0, err = 0.0;
+    for (size_t i = 0; i < master.size(); ++i) {
+        const double d = static_cast<double>(master[i]) - decoded[i];
+        sig += static_cast<double>(master[i]) * master[i];
+        err += d * d;
+    }
+    // Trimmed ends were at most the silence threshold.
+    for (size_t i = 0; i < asset.leadSilence; ++i)
+        TEST_ASSERT_TRUE(std::abs(master[i]) <= 64);
+    TEST_ASSERT_TRUE(err > 0.0);
+    TEST_ASSERT_TRUE(10.0 * std::log10(sig / err) > 20.0);
+}
+
+static void test_generated_assets_match_masters()
+{
+    CheckAsset(datamark_voice,      datamark_pcm,      datamark_pcm_len);
+    CheckAsset(disabled_voice,      disabled_pcm,      disabled_pcm_len);
+    CheckAsset(enabled_voice,       enabled_pcm,       enabled_pcm_len);
+    CheckAsset(glimit_voice,        glimit_pcm,        glimit_pcm_len);
+    CheckAsset(cal_canceled_voice,  cal_canceled_pcm,  cal_canceled_pcm_len);
+    CheckAsset(cal_mode_voice,      cal_mode_pcm,      cal_mode_pcm_len);
+    CheckAsset(cal_saved_voice,     cal_saved_pcm,     cal_saved_pcm_len);
+    CheckAsset(overg_voice,         overg_pcm,         overg_pcm_len);
+    CheckAsset(VnoChime_voice,      VnoChime_pcm,      VnoChime_pcm_len);
+    CheckAsset(left_speaker_voice,  left_speaker_pcm,  left_speaker_pcm_len);
+    CheckAsset(right_speaker_voice, right_speaker_pcm, right_speaker_pcm_len);
+}
+
+static void test_vno_chime_silence_trimmed()
+{
+    // The chime master opens with ~160 ms of silence; it is not stored.
+    TEST_ASSERT_TRUE(VnoChime_voice.leadSilence > 2000);
+    TEST_ASSERT_TRUE(VnoChime_voice.trailSilence > 1000);
+    const std::vector<int16_t> pcm = DecodeAll(VnoChime_voice, kVoiceBlockSamples);
+    for (size_t i = 0; i < VnoChime_voice.leadSilence; ++i)
+        TEST_ASSERT_EQUAL_INT16(0, pcm[i]);
+}
+
+// ---------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_block_header_restarts_state);
+    RUN_TEST(test_code_steps_and_clamps);
+    RUN_TEST(test_silence_padding);
+    RUN_TEST(test_chunked_read_matches_whole);
+    RUN_TEST(test_malformed_assets_are_empty);
+    RUN_TEST(test_generated_assets_match_masters);
+    RUN_TEST(test_vno_chime_silence_trimmed);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# /// script
+# requires-python = ">=3.10"
+# ///
+"""compare_host_bench.py — diff a bench_core --json run against the stored
+baseline (software/Libraries/onspeed_core/bench/baseline.json).
+
+Two kinds of regression, checked per benchmark name:
+  - allocations: any increase in allocs_per_op. The hot paths are meant to
+    be heap-free, and allocation counts are exact on every machine, so this
+    is always a hard failure.
+  - time: ns_per_op above baseline × --max-slowdown. Timings depend on the
+    machine, so --time-advisory reports these without failing (CI runners
+    are not the machine the baseline was recorded on).
+
+A benchmark present in the baseline but missing from the run fails (lost
+coverage); one only in the run is reported as new.
+
+Usage:  uv run tools/bench/compare_host_bench.py BASELINE.json CURRENT.json
+            [--max-slowdown 1.5] [--time-advisory]
+Exit:   0 = no regression; 1 = regression; 2 = unreadable / wrong schema.
+
+Refreshing the baseline after an intended change:
+    build/bench_core --json software/Libraries/onspeed_core/bench/baseline.json
+"""
+import argparse
+import json
+import sys
+
+SCHEMA = 1
+ALLOC_EPSILON = 1e-3   # allocs_per_op is a ratio over N iterations
+
+
+def load(path):
+    """Return {name: entry} from a bench_core JSON file, or None on error."""
+    try:
+        with open(path) as f:
+            doc = json.load(f)
+    except (OSError, ValueError) as e:
+        print(f"error: {path}: {e}", file=sys.stderr)
+        return None
+    if not isinstance(doc, dict) or doc.get("schema") != SCHEMA:
+        print(f"error: {path}: expected schema {SCHEMA}", file=sys.stderr)
+        return None
+    return {b["name"]: b for b in doc.get("benchmarks", [])}
+
+
+def compare(baseline, current, max_slowdown, time_advisory):
+    """Return (failures, lines) for the two result maps."""
+    failures = 0
+    lines = []
+    for name, base in baseline.items():
+        cur = current.get(name)
+        if cur is None:
+            failures += 1
+            lines.append(f"FAIL  {name}: missing from current run")
+            continue
+
+        base_allocs = base["allocs_per_op"]
+        cur_allocs = cur["allocs_per_op"]
+        if cur_allocs > base_allocs + ALLOC_EPSILON:
+            failures += 1
+            lines.append(f"FAIL  {name}: allocs/op {base_allocs:g} -> {cur_allocs:g}")
+
+        base_ns = base["ns_per_op"]
+        cur_ns = cur["ns_per_op"]
+        ratio = cur_ns / base_ns if base_ns > 0 else 1.0
+        if ratio > max_slowdown:
+            if time_advisory:
+                lines.append(f"WARN  {name}: {base_ns:.1f} -> {cur_ns:.1f} ns/op ({ratio:.2f}x)")
+            else:
+                failures += 1
+                lines.append(f"FAIL  {name}: {base_ns:.1f} -> {cur_ns:.1f} ns/op ({ratio:.2f}x)")
+        else:
+            lines.append(f"ok    {name}: {base_ns:.1f} -> {cur_ns:.1f} ns/op ({ratio:.2f}x)")
+
+    for name in current:
+        if name not in baseline:
+            lines.append(f"new   {name}: {current[name]['ns_per_op']:.1f} ns/op (not in baseline)")
+    return failures, lines
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--max-slowdown", type=float, default=1.5,
+                    help="fail when ns/op exceeds baseline by this factor (default 1.5)")
+    ap.add_argument("--time-advisory", action="store_true",
+                    help="report time regressions without failing")
+    args = ap.parse_args(argv)
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    if baseline is None or current is None:
+        return 2
+
+    failures, lines = compare(baseline, current, args.max_slowdown, args.time_advisory)
+    for line in lines:
+        print(line)
+    print(f"\n{failures} regression(s)")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+# /// script
+# requires-python = ">=3.10"
+# ///
+"""
+Tests for compare_host_bench.py — the baseline comparator's own regression
+suite, in the style of test_check_snapshot_sanity.py.
+
+Asserts:
+  * Identical runs → exit 0.
+  * Any allocs/op increase → exit 1, even with --time-advisory.
+  * A slowdown past --max-slowdown → exit 1; with --time-advisory → exit 0.
+  * A slowdown within the threshold → exit 0.
+  * A baseline benchmark missing from the run → exit 1; a new one → exit 0.
+  * Missing file or wrong schema → exit 2.
+
+Run: `uv run tools/bench/test_compare_host_bench.py`
+"""
+import importlib.util
+import json
+import pathlib
+import sys
+import tempfile
+
+_HERE = pathlib.Path(__file__).parent
+_SPEC = importlib.util.spec_from_file_location(
+    "compare_host_bench", str(_HERE / "compare_host_bench.py"))
+assert _SPEC is not None and _SPEC.loader is not None
+chb = importlib.util.module_from_spec(_SPEC)
+sys.modules["compare_host_bench"] = chb
+_SPEC.loader.exec_module(chb)
+
+
+class TestFailure(Exception):
+    pass
+
+
+def expect(cond, msg):
+    if not cond:
+        raise TestFailure(msg)
+
+
+def _write(benchmarks, schema=1):
+    with tempfile.NamedTemporaryFile("w", suffix=".json", delete=False) as f:
+        json.dump({"schema": schema, "benchmarks": benchmarks}, f)
+        return f.name
+
+
+def _bench(name, ns, allocs=0.0):
+    return {"name": name, "iterations": 1000, "ns_per_op": ns,
+            "allocs_per_op": allocs, "bytes_per_op": 0.0}
+
+
+BASE = [_bench("ahrs_step/ekfq", 4000.0), _bench("log_csv/format_row", 700.0)]
+
+
+def _run(current, *flags, base=BASE):
+    return chb.main([_write(base), _write(current), *flags])
+
+
+def test_identical_passes():
+    expect(_run(BASE) == 0, "identical runs should exit 0")
+
+
+def test_alloc_increase_fails_even_when_time_advisory():
+    cur = [_bench("ahrs_step/ekfq", 4000.0, allocs=1.0), BASE[1]]
+    expect(_run(cur) == 1, "allocs/op increase should exit 1")
+    expect(_run(cur, "--time-advisory") == 1, "allocs are never advisory")
+
+
+def test_slowdown_past_threshold_fails():
+    cur = [_bench("ahrs_step/ekfq", 8000.0), BASE[1]]
+    expect(_run(cur) == 1, "2x slowdown should exit 1 at the default 1.5x")
+    expect(_run(cur, "--max-slowdown", "2.5") == 0, "2x is within a 2.5x threshold")
+
+
+def test_time_advisory_only_warns():
+    cur = [_bench("ahrs_step/ekfq", 8000.0), BASE[1]]
+    expect(_run(cur, "--time-advisory") == 0, "--time-advisory should not fail on time")
+
+
+def test_small_slowdown_passes():
+    cur = [_bench("ahrs_step/ekfq", 4400.0), BASE[1]]
+    expect(_run(cur) == 0, "1.1x slowdown is within the default threshold")
+
+
+def test_missing_benchmark_fails_new_benchmark_passes():
+    expect(_run(BASE[:1]) == 1, "a baseline case missing from the run should exit 1")
+    expect(_run(BASE + [_bench("display/build_frame", 900.0)]) == 0,
+           "a case not in the baseline is reported, not failed")
+
+
+def test_bad_input_exits_2():
+    expect(chb.main(["/tmp/definitely-not-a-bench.json", _write(BASE)]) == 2,
+           "missing file → exit 2")
+    expect(chb.main([_write(BASE, schema=99), _write(BASE)]) == 2, "wrong schema → exit 2")
+
+
+def main():
+    tests = [v for k, v in sorted(globals().items()) if k.startswith("test_") and callable(v)]
+    failures = 0
+    for t in tests:
+        try:
+            t()
+            print(f"  PASS {t.__name__}")
+        except TestFailure as e:
+            failures += 1
+            print(f"  FAIL {t.__name__}: {e}")
+    print(f"\n{len(tests) - failures}/{len(tests)} passed")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -15,6 +15,10 @@ Provides:
 - `live_snapshot` — `LiveSnapshot` dataclass; per-tick aircraft-state struct
                     consumed by display, audio, and log-replay code paths.
 
+`config`, `percent_lift` and `log_replay` run the onspeed_core C++ through
+the in-process `_onspeed_core` extension when it is built (`_native`), and
+through the host_main binary otherwise.
+
 Consumers:
 
 - `tools/m5-replay/replay.py` imports `Frame`, `FRAME_LEN`, `FlapSetpoints`,
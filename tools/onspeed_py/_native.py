@@ -0,0 +1,47 @@
+"""Optional in-process onspeed_core bindings.
+
+`software/Libraries/onspeed_core/python/build_python.sh` builds the
+`_onspeed_core` CPython extension into that directory's `dist/`. When
+it imports, the wrappers in this package call onspeed_core directly
+instead of spawning host_main and parsing its text output; when it
+doesn't, they fall back to the host_main subprocess path.
+
+`ONSPEED_CORE_PY` overrides the lookup: a directory to load the module
+from, or an empty string to force the subprocess path.
+"""
+from __future__ import annotations
+
+import os
+import sys
+from pathlib import Path
+from types import ModuleType
+
+# Repo-relative output directory of build_python.sh.
+NATIVE_DIR = (
+    Path(__file__).resolve().parents[2]
+    / "software" / "Libraries" / "onspeed_core" / "python" / "dist"
+)
+
+_module: ModuleType | None = None
+_probed = False
+
+
+def native() -> ModuleType | None:
+    """Return the `_onspeed_core` module, or None if it isn't built."""
+    global _module, _probed
+    if _probed:
+        return _module
+    _probed = True
+
+    override = os.environ.get("ONSPEED_CORE_PY")
+    if override == "":
+        return None
+    search = Path(override) if override else NATIVE_DIR
+    if search.is_dir() and str(search) not in sys.path:
+        sys.path.insert(0, str(search))
+    try:
+        import _onspeed_core
+    except ImportError:
+        return None
+    _module = _onspeed_core
+    return _module
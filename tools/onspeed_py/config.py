@@ -1,6 +1,8 @@
 """ALGORITHM CODE LIVES IN C++.
 
-This module is a subprocess wrapper around the host_main CLI binary.
+This module is a wrapper around onspeed_core's config parsers: it calls
+the in-process `_onspeed_core` extension when it is built (see
+_native.py) and otherwise the host_main CLI binary.
 The canonical implementation is in
 software/Libraries/onspeed_core/src/config/ (ConfigXmlParse.cpp for V2,
 ConfigV1Parse.cpp for V1), compiled to
@@ -25,6 +27,7 @@ from dataclasses import dataclass
 from pathlib import Path
 
 from ._host_main import require_host_main
+from ._native import native
 
 
 @dataclass
@@ -44,18 +47,25 @@ class FlapSetpoints:
 def load_flap_setpoints(cfg_path: Path) -> dict[int, FlapSetpoints]:
     """Parse OnSpeed `.cfg` XML for per-flap setpoints.
 
-    Delegates to `host_main parse_config`. Returns `{degrees: FlapSetpoints}`.
+    Delegates to `_onspeed_core.parse_config` or `host_main parse_config`.
+    Returns `{degrees: FlapSetpoints}`.
 
-    Raises `subprocess.CalledProcessError` if the file cannot be parsed.
+    Raises `OSError` / `ValueError` (in-process) or
+    `subprocess.CalledProcessError` (host_main) if the file cannot be
+    read or parsed.
     Raises `ValueError` if the config has no flap entries.
     """
-    proc = subprocess.run(
-        [str(require_host_main()), "parse_config", "--in", str(cfg_path)],
-        capture_output=True,
-        text=True,
-        check=True,
-    )
-    raw = json.loads(proc.stdout)
+    mod = native()
+    if mod is not None:
+        raw = mod.parse_config(str(cfg_path))
+    else:
+        proc = subprocess.run(
+            [str(require_host_main()), "parse_config", "--in", str(cfg_path)],
+            capture_output=True,
+            text=True,
+            check=True,
+        )
+        raw = json.loads(proc.stdout)
 
     flaps_raw = raw.get("flapsByDeg", {})
     if not flaps_raw:
@@ -1,7 +1,9 @@
 """OnSpeed SD-log → `LiveSnapshot` tick stream adapter.
 
-Algorithm code lives in C++. This module is a thin subprocess wrapper
-around the `host_main replay` CLI subcommand. The canonical replay
+Algorithm code lives in C++. This module is a thin wrapper around
+LogReplayEngine: it calls the in-process `_onspeed_core.replay_log`
+binding when it is built (see _native.py) and otherwise the
+`host_main replay` CLI subcommand. The canonical replay
 pipeline implementation is in
 software/Libraries/onspeed_core/src/replay/LogReplayEngine.{h,cpp},
 compiled to tools/regression/.pio/build/native/program by
@@ -17,9 +19,10 @@ onspeed_core (old format with `AngleofAttack`, new format with
 `DerivedAOA`, optional `flapsRawADC` column, etc.). The C++ engine
 handles format detection.
 
-**Windowing and decimation**: `host_main replay` processes the full
-log. Python reads the `timeStamp` column from the original CSV to
-apply the `t_start_s` / `t_end_s` window and `target_rate_hz`
+**Windowing and decimation**: the C++ replay processes the full
+log. The native table carries each row's `timeStamp`; on the
+host_main path Python reads the `timeStamp` column from the original
+CSV instead. Either way Python uses it to apply the `t_start_s` / `t_end_s` window and `target_rate_hz`
 decimation on the output. This matches the semantics of the old
 Python-only implementation.
 
@@ -67,6 +70,7 @@ from pathlib import Path
 from typing import Iterator
 
 from ._host_main import require_host_main
+from ._native import native
 from .live_snapshot import LiveSnapshot
 
 # Column-name aliases. First name in each tuple is what we standardize
@@ -231,6 +235,73 @@ def _to_live_snapshot(raw: dict, *,
     )
 
 
+# ---------------------------------------------------------------------------
+# Replay backends: (timestamp_ms, row dict) pairs
+# ---------------------------------------------------------------------------
+
+def _replay_rows_native(mod, log_path: Path,
+                        cfg_path: Path) -> Iterator[tuple[float, dict]]:
+    """Run `_onspeed_core.replay_log` in-process.
+
+    Output row k is input row k, and the table carries the input
+    `timeStamp` as `timestamp_ms`, so no CSV pre-scan or alignment is
+    needed. Non-finite cells are already NaN.
+    """
+    table = mod.replay_log(str(log_path), str(cfg_path))
+    columns = table.columns
+    for values in memoryview(table).tolist():
+        raw = dict(zip(columns, values))
+        yield raw['timestamp_ms'], raw
+
+
+def _replay_rows_host_main(log_path: Path,
+                           cfg_path: Path) -> Iterator[tuple[float, dict]]:
+    """Run `host_main replay` and zip its JSONL rows with CSV timestamps."""
+    host_main = require_host_main()
+
+    # Read timestamps from the original CSV for windowing and decimation.
+    # This is a lightweight pass (no pressure data extraction) — only
+    # timeStamp is needed to filter the rows that fall in [t_start_s,
+    # t_end_s] and to apply target_rate_hz decimation.
+    timestamps_ms: list[float] = []
+    with Path(log_path).open() as f:
+        reader = csv.DictReader(f)
+        if reader.fieldnames:
+            reader.fieldnames = [name.strip() for name in reader.fieldnames]
+        for row in reader:
+            ts_ms = _ffloat(row, _TIMESTAMP_NAMES)
+            timestamps_ms.append(ts_ms)
+
+    # Run host_main replay on the full log.
+    args = [
+        str(host_main), 'replay',
+        '--input', str(log_path),
+        '--config', str(cfg_path),
+        '--output-format', 'jsonl',
+    ]
+    result = subprocess.run(args, capture_output=True, text=True, check=True)
+
+    # Parse JSONL output and zip with timestamps.
+    jsonl_rows = [
+        _parse_jsonl_with_nan(line)
+        for line in result.stdout.splitlines()
+        if line.strip()
+    ]
+
+    # The C++ may emit fewer rows than the input (streaming synth lag
+    # for old logs). Align from the end: the last N input rows map to
+    # the last N output rows.
+    n_out = len(jsonl_rows)
+    n_in  = len(timestamps_ms)
+    # Offset: input row i maps to output row (i - (n_in - n_out)).
+    offset = n_in - n_out
+
+    for i, raw in enumerate(jsonl_rows):
+        in_idx = i + offset
+        ts_ms  = timestamps_ms[in_idx] if 0 <= in_idx < n_in else float('nan')
+        yield ts_ms, raw
+
+
 # ---------------------------------------------------------------------------
 # Public API
 # ---------------------------------------------------------------------------
@@ -247,8 +318,9 @@ def scenario_from_log(log_path: Path,
                       ) -> Iterator[LiveSnapshot]:
     """Yield `LiveSnapshot` ticks from a window of an OnSpeed CSV log.
 
-    Calls `host_main replay` on the full log, then windows and decimates
-    the output in Python.
+    Replays the full log (in-process via `_onspeed_core.replay_log` when
+    built, else `host_main replay`), then windows and decimates the
+    output in Python.
 
     `t_start_s` / `t_end_s` are seconds since the log epoch (i.e.,
     `timeStamp` / 1000). Resamples to `target_rate_hz` (default 50 Hz).
@@ -283,51 +355,16 @@ def scenario_from_log(log_path: Path,
             "Write a modified config to a tempfile and pass it as cfg_path."
         )
 
-    host_main = require_host_main()
-
-    # Read timestamps from the original CSV for windowing and decimation.
-    # This is a lightweight pass (no pressure data extraction) — only
-    # timeStamp is needed to filter the rows that fall in [t_start_s,
-    # t_end_s] and to apply target_rate_hz decimation.
-    timestamps_ms: list[float] = []
-    with Path(log_path).open() as f:
-        reader = csv.DictReader(f)
-        if reader.fieldnames:
-            reader.fieldnames = [name.strip() for name in reader.fieldnames]
-        for row in reader:
-            ts_ms = _ffloat(row, _TIMESTAMP_NAMES)
-            timestamps_ms.append(ts_ms)
-
-    # Run host_main replay on the full log.
-    args = [
-        str(host_main), 'replay',
-        '--input', str(log_path),
-        '--config', str(cfg_path),
-        '--output-format', 'jsonl',
-    ]
-    result = subprocess.run(args, capture_output=True, text=True, check=True)
-
-    # Parse JSONL output and zip with timestamps.
-    jsonl_rows = [
-        _parse_jsonl_with_nan(line)
-        for line in result.stdout.splitlines()
-        if line.strip()
-    ]
-
-    # The C++ may emit fewer rows than the input (streaming synth lag
-    # for old logs). Align from the end: the last N input rows map to
-    # the last N output rows.
-    n_out = len(jsonl_rows)
-    n_in  = len(timestamps_ms)
-    # Offset: input row i maps to output row (i - (n_in - n_out)).
-    offset = n_in - n_out
+    mod = native()
+    if mod is not None:
+        rows = _replay_rows_native(mod, log_path, cfg_path)
+    else:
+        rows = _replay_rows_host_main(log_path, cfg_path)
 
     target_dt_s = 1.0 / target_rate_hz
     last_emit_t: float | None = None
 
-    for i, raw in enumerate(jsonl_rows):
-        in_idx   = i + offset
-        ts_ms    = timestamps_ms[in_idx] if 0 <= in_idx < n_in else float('nan')
+    for ts_ms, raw in rows:
         ts       = ts_ms / 1000.0
         t_rel    = ts - t_start_s
 
@@ -1,6 +1,7 @@
 """ALGORITHM CODE LIVES IN C++.
 
-This module is a subprocess wrapper around the host_main CLI binary.
+This module calls the in-process `_onspeed_core` extension when it is
+built (see _native.py) and otherwise the host_main CLI binary.
 The canonical implementation is in
 software/Libraries/onspeed_core/src/aoa/PercentLift.cpp, compiled to
 tools/regression/.pio/build/native/program by `pio run -e native` in
@@ -17,12 +18,14 @@ import subprocess
 
 from .config import FlapSetpoints
 from ._host_main import require_host_main
+from ._native import native
 
 
 def compute_percent_lift(aoa: float, fs: FlapSetpoints) -> float:
     """Percent-of-stall lift fraction, clamped to [0.0, 99.9].
 
-    Delegates to `host_main percent_lift`. Algorithm lives in
+    Delegates to `_onspeed_core.compute_percent_lift` or
+    `host_main percent_lift`. Algorithm lives in
     onspeed_core/aoa/PercentLift.cpp::ComputePercentLift.
 
     NaN or non-finite AOA input: C++ ComputePercentLift returns 0.0
@@ -30,6 +33,11 @@ def compute_percent_lift(aoa: float, fs: FlapSetpoints) -> float:
     so the function clamps to 0.0). This wrapper passes the value
     through to host_main transparently; std::stof("nan") is valid C++.
     """
+    mod = native()
+    if mod is not None:
+        return mod.compute_percent_lift(
+            aoa, fs.alpha_0, fs.alpha_stall, fs.stallwarn_aoa)
+
     proc = subprocess.run(
         [
             str(require_host_main()),
@@ -0,0 +1,95 @@
+"""In-process `_onspeed_core` bindings vs the host_main subprocess path.
+
+The wrappers pick the native module when it is built
+(software/Libraries/onspeed_core/python/build_python.sh) and fall back
+to host_main otherwise. Both call the same C++, so every public wrapper
+must return the same values either way; these tests run each one down
+both paths and compare. Skipped when the module is not built.
+"""
+
+from __future__ import annotations
+
+import math
+from dataclasses import astuple
+from pathlib import Path
+
+import pytest
+
+from onspeed_py import config, log_replay, percent_lift
+from onspeed_py._host_main import HOST_MAIN
+from onspeed_py._native import native
+
+FIX = Path(__file__).resolve().parent / "fixtures"
+
+pytestmark = [
+    pytest.mark.skipif(native() is None, reason="_onspeed_core not built"),
+    pytest.mark.skipif(not HOST_MAIN.exists(), reason="host_main not built"),
+]
+
+
+@pytest.fixture
+def subprocess_only(monkeypatch):
+    """Route the wrappers through host_main for the duration of a test."""
+    for mod in (config, log_replay, percent_lift):
+        monkeypatch.setattr(mod, "native", lambda: None)
+
+
+def _close(a: float, b: float) -> bool:
+    # host_main prints %.4f; the native path carries full precision.
+    if math.isnan(a) or math.isnan(b):
+        return math.isnan(a) and math.isnan(b)
+    return math.isclose(a, b, rel_tol=1e-4, abs_tol=1e-4)
+
+
+def test_flap_setpoints_match(request) -> None:
+    cfg = FIX / "vac_config.cfg"
+    fast = config.load_flap_setpoints(cfg)
+    request.getfixturevalue("subprocess_only")
+    slow = config.load_flap_setpoints(cfg)
+
+    assert fast.keys() == slow.keys()
+    for deg in fast:
+        for a, b in zip(astuple(fast[deg]), astuple(slow[deg])):
+            assert _close(float(a), float(b)), (deg, a, b)
+
+
+def test_percent_lift_matches(request) -> None:
+    fs = config.load_flap_setpoints(FIX / "vac_config.cfg")[0]
+    aoas = [-5.0, 0.0, fs.alpha_0, 4.2, fs.stallwarn_aoa, 30.0, math.nan]
+    fast = [percent_lift.compute_percent_lift(a, fs) for a in aoas]
+    request.getfixturevalue("subprocess_only")
+    slow = [percent_lift.compute_percent_lift(a, fs) for a in aoas]
+
+    for a, f, s in zip(aoas, fast, slow):
+        assert _close(f, s), (a, f, s)
+
+
+def test_scenario_from_log_matches(request) -> None:
+    kwargs = dict(
+        log_path=FIX / "vac_decel_run.csv",
+        cfg_path=FIX / "vac_config.cfg",
+        t_start_s=2865.0,
+        t_end_s=2867.0,
+    )
+    fast = list(log_replay.scenario_from_log(**kwargs))
+    request.getfixturevalue("subprocess_only")
+    slow = list(log_replay.scenario_from_log(**kwargs))
+
+    assert len(fast) == len(slow) > 0
+    for f, s in zip(fast, slow):
+        for a, b in zip(astuple(f), astuple(s)):
+            assert _close(float(a), float(b)), (f, s)
+
+
+def test_replay_table_is_a_zero_copy_buffer() -> None:
+    table = native().replay_log(
+        str(FIX / "vac_decel_run.csv"), str(FIX / "vac_config.cfg"))
+    view = memoryview(table)
+
+    assert view.format == "d"
+    assert view.ndim == 2
+    assert view.shape[1] == len(table.columns)
+    assert table.columns[0] == "timestamp_ms"
+    # Two views alias the table's storage rather than copying it.
+    view[0, 1] = -1234.5
+    assert memoryview(table)[0, 1] == -1234.5
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+# /// script
+# requires-python = ">=3.10"
+# dependencies = [
+#     "pyserial>=3.5",
+# ]
+# ///
+"""
+perf_trace.py — turn a firmware PERF trace capture into Chrome trace JSON.
+
+What this does
+==============
+
+`perf trace [ms]` on the console of a PERF build (esp32s3-v4p-perf or
+-perf-synth) arms a bounded trace capture: every PerfScope / PerfLoop
+event, with its start time, task and core, until the 4096-event window
+fills or `ms` elapses. The PerfDump task then prints it:
+
+    ==== PERF TRACE ==== events=N dropped=D capacity=4096 origin_us=T0
+    trace ts=1234 dur=56 core=1 task=Imu scope=ekfq.predict
+    trace ts=1200 dur=410 core=1 task=Imu scope=loop stack_free=812w
+    ...
+    ==== PERF TRACE END ====
+
+This script finds that block in a serial capture (or captures it itself
+with --port) and writes Chrome trace-event JSON, which loads in
+https://ui.perfetto.dev or chrome://tracing. Each CPU core is a process
+row and each FreeRTOS task a thread row under the core it ran on; loop
+events are named "<task> loop" and enclose that iteration's scopes.
+
+Why this exists
+===============
+
+The 1 Hz PERF snapshot folds events into histograms, which hides
+ordering. A trace shows, for example, whether a `log_sync` stall on
+Core 0 lines up with `Imu` loop jitter on Core 1.
+
+Usage
+=====
+
+  # Capture directly (sends `perf trace 5000`, waits for the block):
+  uv run ./perf_trace.py --port /dev/cu.usbserial-310 -o trace.json
+
+  # Or convert a saved serial log:
+  uv run ./perf_trace.py --from-file capture.txt -o trace.json
+
+Exit: 0 = wrote the trace; 2 = no complete trace block found.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+import time
+from pathlib import Path
+
+TRACE_HEADER = "==== PERF TRACE ===="
+TRACE_END = "==== PERF TRACE END ===="
+
+
+def _kv(tokens: list[str]) -> dict[str, str]:
+    out = {}
+    for tok in tokens:
+        key, sep, value = tok.partition("=")
+        if sep:
+            out[key] = value
+    return out
+
+
+def parse_trace_blocks(raw_text: str) -> list[dict]:
+    """Return every complete trace block in `raw_text`, in order.
+
+    Each block is {"header": {...}, "events": [...]} where an event is
+    {"ts", "dur", "core", "task", "scope", "stack_free"} (stack_free only
+    on loop events). Blocks cut off before the END marker are skipped;
+    unparseable lines inside a block (serial noise) are ignored.
+    """
+    blocks = []
+    current = None
+    for line in raw_text.splitlines():
+        line = line.strip()
+        pos = line.find(TRACE_HEADER)
+        if pos >= 0:
+            header = _kv(line[pos + len(TRACE_HEADER):].split())
+            current = {"header": {k: int(v) for k, v in header.items() if v.isdigit()},
+                       "events": []}
+        elif line == TRACE_END:
+            if current is not None:
+                blocks.append(current)
+            current = None
+        elif current is not None and line.startswith("trace "):
+            f = _kv(line.split()[1:])
+            try:
+                ev = {
+                    "ts": int(f["ts"]),
+                    "dur": int(f["dur"]),
+                    "core": int(f["core"]),
+                    "task": f["task"],
+                    "scope": f["scope"],
+                }
+            except (KeyError, ValueError):
+                continue
+            if "stack_free" in f:
+                ev["stack_free"] = int(f["stack_free"].rstrip("w"))
+            current["events"].append(ev)
+    return blocks
+
+
+def to_chrome_trace(block: dict) -> dict:
+    """Convert one parsed block to a Chrome trace-event document."""
+    events = []
+    threads: dict[tuple[int, str], int] = {}
+
+    def tid_for(core: int, task: str) -> int:
+        key = (core, task)
+        if key not in threads:
+            threads[key] = len(threads) + 1
+        return threads[key]
+
+    # Sorted by start so viewers nest loops and scopes without relying on
+    # the firmware's completion order.
+    for ev in sorted(block["events"], key=lambda e: (e["ts"], -e["dur"])):
+        is_loop = ev["scope"] == "loop"
+        out = {
+            "name": f"{ev['task']} loop" if is_loop else ev["scope"],
+            "cat": "loop" if is_loop else "scope",
+            "ph": "X",
+            "ts": ev["ts"],
+            "dur": ev["dur"],
+            "pid": ev["core"],
+            "tid": tid_for(ev["core"], ev["task"]),
+        }
+        if "stack_free" in ev:
+            out["args"] = {"stack_free_words": ev["stack_free"]}
+        events.append(out)
+
+    meta = []
+    for core in sorted({c for c, _ in threads}):
+        meta.append({"name": "process_name", "ph": "M", "pid": core,
+                     "args": {"name": f"Core {core}"}})
+    for (core, task), tid in threads.items():
+        meta.append({"name": "thread_name", "ph": "M", "pid": core, "tid": tid,
+                     "args": {"name": task}})
+
+    header = block["header"]
+    return {
+        "traceEvents": meta + events,
+        "displayTimeUnit": "ms",
+        "otherData": {
+            "source": "OnSpeed PERF trace",
+            "events": header.get("events", len(block["events"])),
+            "dropped": header.get("dropped", 0),
+            "capacity": header.get("capacity", 0),
+            "origin_us": header.get("origin_us", 0),
+        },
+    }
+
+
+def capture_serial(port: str, baud: int, duration_ms: int, timeout_sec: float) -> str:
+    """Send `perf trace <ms>` and read until the trace block ends."""
+    import serial  # only needed for live capture
+
+    ser = serial.Serial(port, baud, timeout=0.5)
+    print(f"# connected: {port} @ {baud}", file=sys.stderr)
+    ser.read(8192)   # discard whatever was already buffered
+    ser.write(f"perf trace {duration_ms}\r\n".encode())
+    ser.flush()
+    print(f"# armed: perf trace {duration_ms}", file=sys.stderr)
+
+    buf = b""
+    deadline = time.time() + duration_ms / 1000.0 + timeout_sec
+    while time.time() < deadline:
+        buf += ser.read(65536)
+        if TRACE_END.encode() in buf:
+            break
+    ser.close()
+    return buf.decode(errors="replace")
+
+
+def main(argv: list[str] | None = None) -> int:
+    p = argparse.ArgumentParser(
+        description="Convert a PERF trace capture to Chrome trace JSON.",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__,
+    )
+    src = p.add_mutually_exclusive_group(required=True)
+    src.add_argument("--from-file", help="Serial capture text containing a trace block.")
+    src.add_argument("--port", help="USB serial device; capture a trace live.")
+    p.add_argument("--baud", type=int, default=921600)
+    p.add_argument("--duration-ms", type=int, default=5000,
+                   help="Upper bound on the capture window (default 5000).")
+    p.add_argument("--timeout", type=float, default=30.0,
+                   help="Seconds to wait for the block after the window (default 30).")
+    p.add_argument("-o", "--output", default="perf-trace.json")
+    args = p.parse_args(argv)
+
+    if args.from_file:
+        raw = Path(args.from_file).read_text(errors="replace")
+    else:
+        raw = capture_serial(args.port, args.baud, args.duration_ms, args.timeout)
+
+    blocks = parse_trace_blocks(raw)
+    if not blocks:
+        print("ERROR: no complete PERF TRACE block found. Is the firmware a "
+              "perf build, and did the capture include the END marker?",
+              file=sys.stderr)
+        return 2
+    if len(blocks) > 1:
+        print(f"# {len(blocks)} trace blocks found; converting the last",
+              file=sys.stderr)
+    block = blocks[-1]
+    dropped = block["header"].get("dropped", 0)
+    if dropped:
+        print(f"# WARNING: {dropped} events arrived after the window filled",
+              file=sys.stderr)
+
+    doc = to_chrome_trace(block)
+    Path(args.output).write_text(json.dumps(doc))
+    print(f"# wrote {len(block['events'])} events to {args.output}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,74 @@
+"""Unit tests for perf_trace.py — PERF trace block parsing and the Chrome
+trace conversion.
+
+Pins the contract between PerfDump's trace printout and the viewer
+JSON: a drift in either side (renamed key, missing END marker handling,
+core/task mapping) would otherwise only show up as an empty or garbled
+Perfetto timeline on the bench.
+"""
+
+import json
+
+from perf_trace import main, parse_trace_blocks, to_chrome_trace
+
+CAPTURE = """\
+==== PERF ====
+task=Imu          loops= 208 p50=   400us
+==== PERF TRACE ==== events=4 dropped=0 capacity=4096 origin_us=99000
+trace ts=0 dur=420 core=1 task=Imu scope=loop stack_free=812w
+trace ts=10 dur=120 core=1 task=Imu scope=ekfq.predict
+trace ts=150 dur=9000 core=0 task=Log scope=log_sync
+garbage line from another task
+trace ts=4808 dur=2100 core=1 task=Imu scope=loop stack_free=790w
+==== PERF TRACE END ====
+"""
+
+
+def test_parse_block_fields() -> None:
+    blocks = parse_trace_blocks(CAPTURE)
+    assert len(blocks) == 1
+    b = blocks[0]
+    assert b["header"] == {"events": 4, "dropped": 0, "capacity": 4096, "origin_us": 99000}
+    assert len(b["events"]) == 4
+    assert b["events"][0] == {"ts": 0, "dur": 420, "core": 1, "task": "Imu",
+                              "scope": "loop", "stack_free": 812}
+    assert b["events"][2]["scope"] == "log_sync"
+    assert "stack_free" not in b["events"][1]
+
+
+def test_truncated_block_is_skipped() -> None:
+    truncated = CAPTURE.split("==== PERF TRACE END ====")[0]
+    assert parse_trace_blocks(truncated) == []
+
+
+def test_chrome_trace_maps_cores_and_tasks() -> None:
+    doc = to_chrome_trace(parse_trace_blocks(CAPTURE)[0])
+    meta = [e for e in doc["traceEvents"] if e["ph"] == "M"]
+    spans = [e for e in doc["traceEvents"] if e["ph"] == "X"]
+
+    procs = {e["pid"]: e["args"]["name"] for e in meta if e["name"] == "process_name"}
+    assert procs == {0: "Core 0", 1: "Core 1"}
+    threads = {(e["pid"], e["args"]["name"]) for e in meta if e["name"] == "thread_name"}
+    assert threads == {(1, "Imu"), (0, "Log")}
+
+    # Sorted by start; the loop that encloses ekfq.predict comes first.
+    assert [s["name"] for s in spans] == ["Imu loop", "ekfq.predict", "log_sync", "Imu loop"]
+    assert spans[0]["args"] == {"stack_free_words": 812}
+    imu_tids = {s["tid"] for s in spans if s["pid"] == 1}
+    assert len(imu_tids) == 1
+    assert doc["otherData"]["capacity"] == 4096
+
+
+def test_main_writes_json(tmp_path) -> None:
+    src = tmp_path / "capture.txt"
+    src.write_text(CAPTURE)
+    out = tmp_path / "trace.json"
+    assert main(["--from-file", str(src), "-o", str(out)]) == 0
+    doc = json.loads(out.read_text())
+    assert sum(1 for e in doc["traceEvents"] if e["ph"] == "X") == 4
+
+
+def test_main_without_block_exits_2(tmp_path) -> None:
+    src = tmp_path / "capture.txt"
+    src.write_text("==== PERF ====\ntask=Imu loops=208\n")
+    assert main(["--from-file", str(src), "-o", str(tmp_path / "t.json")]) == 2
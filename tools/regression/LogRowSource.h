@@ -0,0 +1,229 @@
+// LogRowSource.h — parsed SD-log rows for host_main's replay paths.
+//
+// Wraps the two ways host_main can get onspeed::LogRow values for a CSV
+// log: index the mapped CSV with proto::log_csv::LineIndex and parse each
+// row through ParseRowByIndex, or — with the row cache enabled — load the
+// "<log>.rowcache" sidecar (log/LogRowCache.h) and use its row array in
+// place without touching the CSV at all.  A missing or stale sidecar
+// (CSV size or mtime changed) falls back to parsing; Finish() then
+// rewrites it so the next run hits.
+//
+// Host-only, header-only for the same reason as MappedFile.h.
+
+#ifndef ONSPEED_TOOLS_REGRESSION_LOG_ROW_SOURCE_H
+#define ONSPEED_TOOLS_REGRESSION_LOG_ROW_SOURCE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <log/LogRowCache.h>
+#include <proto/LogCsvHeaderIndex.h>
+#include <proto/LogCsvLineIndex.h>
+#include <types/LogRow.h>
+
+#include "MappedFile.h"
+
+class LogRowSource {
+public:
+    enum class OpenStatus { Ok, CannotOpen, Empty, BadHeader };
+
+    LogRowSource() = default;
+    LogRowSource(const LogRowSource&) = delete;
+    LogRowSource& operator=(const LogRowSource&) = delete;
+
+    // Open `path` ("-" = stdin; never cached).  `tag` prefixes cache
+    // diagnostics on stderr.  `warn` receives BuildHeaderIndex warnings;
+    // a cache hit skips header parsing, so they are only reported on the
+    // run that builds the sidecar.
+    OpenStatus Open(const char* path, bool useCache, const char* tag,
+                    onspeed::proto::log_csv::WarnSink warn)
+    {
+        m_path = path;
+        m_tag  = tag;
+        m_useCache = useCache && std::strcmp(path, "-") != 0
+                     && StatSource(path, m_source);
+        if (m_useCache) {
+            m_cachePath = m_path + ".rowcache";
+            if (TryLoadCache()) return OpenStatus::Ok;
+        }
+
+        if (!m_csv.Open(path)) return OpenStatus::CannotOpen;
+        m_csvMapped = true;
+        if (!m_lines.Build(m_csv.View())) return OpenStatus::Empty;
+        if (!onspeed::proto::log_csv::BuildHeaderIndex(m_lines.Header(), m_index, warn)) {
+            return OpenStatus::BadHeader;
+        }
+        if (m_useCache) m_built.reserve(m_lines.RowCount());
+        return OpenStatus::Ok;
+    }
+
+    const onspeed::proto::log_csv::HeaderIndex& Index() const { return m_index; }
+
+    size_t RowCount() const
+    {
+        return m_fromCache ? m_cached.rowCount : m_lines.RowCount();
+    }
+
+    bool FromCache() const { return m_fromCache; }
+
+    // Produce row `i` into `row`.  On the parse path this is
+    // ParseRowByIndex over `row` as the caller prepared it; on a cache
+    // hit the stored result is copied over `row` wholesale.  While a
+    // sidecar is being built rows must be read in order.
+    bool Read(size_t i, onspeed::LogRow& row)
+    {
+        if (m_fromCache) {
+            row = m_cached.rows[i];
+            return true;
+        }
+        if (!onspeed::proto::log_csv::ParseRowByIndex(m_lines.Row(i), m_index, row)) {
+            m_buildFailed = true;
+            return false;
+        }
+        if (m_useCache && !m_buildFailed && m_built.size() == i) m_built.push_back(row);
+        return true;
+    }
+
+    // Raw CSV text.  A cache hit maps the CSV on first use and serves
+    // lines from the sidecar's offset table; returns empty if the CSV
+    // can no longer be read.
+    std::string_view HeaderLine()
+    {
+        if (!m_fromCache) return m_lines.Header();
+        if (!EnsureCsvMapped()) return {};
+        return Slice(m_cached.headerLineOffset, m_cached.headerLineLength);
+    }
+
+    std::string_view Line(size_t i)
+    {
+        if (!m_fromCache) return m_lines.Row(i);
+        if (!EnsureCsvMapped()) return {};
+        return Slice(m_cached.lineOffsets[i], m_cached.lineLengths[i]);
+    }
+
+    // Write the sidecar if this run parsed every row.  Best effort — a
+    // read-only log directory only costs the next run a re-parse.
+    void Finish()
+    {
+        if (!m_useCache || m_fromCache || m_buildFailed
+            || m_built.size() != m_lines.RowCount()) {
+            return;
+        }
+
+        const size_t n = m_built.size();
+        std::vector<uint64_t> offsets(n);
+        std::vector<uint32_t> lengths(n);
+        for (size_t i = 0; i < n; ++i) {
+            offsets[i] = m_lines.RowOffset(i);
+            lengths[i] = static_cast<uint32_t>(m_lines.Row(i).size());
+        }
+
+        onspeed::log::RowCacheImage image;
+        image.source           = m_source;
+        image.index            = m_index;
+        image.headerLineOffset = static_cast<uint64_t>(
+            m_lines.Header().data() - m_csv.View().data());
+        image.headerLineLength = static_cast<uint32_t>(m_lines.Header().size());
+        image.rowCount         = n;
+        image.rows             = m_built.data();
+        image.lineOffsets      = offsets.data();
+        image.lineLengths      = lengths.data();
+
+        std::vector<uint8_t> buf(onspeed::log::RowCacheBytes(n));
+        const size_t len = onspeed::log::WriteRowCache(image, buf.data(), buf.size());
+
+        // Write-then-rename, as LogSensor does for .meta, so a concurrent
+        // reader never maps a half-written cache.
+        const std::string tmp = m_cachePath + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        bool ok = (f != nullptr) && std::fwrite(buf.data(), 1, len, f) == len;
+        if (f != nullptr) ok = (std::fclose(f) == 0) && ok;
+        if (ok) ok = std::rename(tmp.c_str(), m_cachePath.c_str()) == 0;
+        if (!ok) {
+            std::remove(tmp.c_str());
+            std::fprintf(stderr, "%s: cannot write row cache '%s'\n",
+                         m_tag, m_cachePath.c_str());
+            return;
+        }
+        std::fprintf(stderr, "%s: wrote row cache '%s' (%zu rows)\n",
+                     m_tag, m_cachePath.c_str(), n);
+    }
+
+private:
+    static bool StatSource(const char* path, onspeed::log::RowCacheSource& out)
+    {
+        struct stat st {};
+        if (::stat(path, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+        out.sizeBytes = static_cast<uint64_t>(st.st_size);
+#if defined(__APPLE__)
+        out.mtimeNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL
+                    + st.st_mtimespec.tv_nsec;
+#else
+        out.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL
+                    + st.st_mtim.tv_nsec;
+#endif
+        return true;
+    }
+
+    bool TryLoadCache()
+    {
+        struct stat st {};
+        if (::stat(m_cachePath.c_str(), &st) != 0) return false;   // no sidecar yet
+        if (!m_cacheFile.Open(m_cachePath.c_str())) return false;
+
+        const std::string_view v = m_cacheFile.View();
+        const onspeed::log::RowCacheStatus s = onspeed::log::OpenRowCache(
+            reinterpret_cast<const uint8_t*>(v.data()), v.size(), m_source, m_cached);
+        if (s != onspeed::log::RowCacheStatus::Ok) {
+            std::fprintf(stderr, "%s: row cache '%s' %s; re-parsing\n",
+                         m_tag, m_cachePath.c_str(),
+                         onspeed::log::RowCacheStatusName(s));
+            m_cacheFile.Close();
+            return false;
+        }
+        m_index     = m_cached.index;
+        m_fromCache = true;
+        std::fprintf(stderr, "%s: loaded row cache '%s' (%zu rows)\n",
+                     m_tag, m_cachePath.c_str(), m_cached.rowCount);
+        return true;
+    }
+
+    bool EnsureCsvMapped()
+    {
+        if (!m_csvMapped) m_csvMapped = m_csv.Open(m_path.c_str());
+        return m_csvMapped;
+    }
+
+    std::string_view Slice(uint64_t off, uint32_t len) const
+    {
+        const std::string_view v = m_csv.View();
+        if (off > v.size() || len > v.size() - off) return {};
+        return v.substr(static_cast<size_t>(off), len);
+    }
+
+    std::string m_path;
+    std::string m_cachePath;
+    const char* m_tag = "";
+    bool m_useCache    = false;
+    bool m_fromCache   = false;
+    bool m_csvMapped   = false;
+    bool m_buildFailed = false;
+
+    onspeed::log::RowCacheSource         m_source;
+    onspeed::proto::log_csv::HeaderIndex m_index;
+
+    MappedFile                              m_csv;
+    onspeed::proto::log_csv::LineIndex      m_lines;
+    std::vector<onspeed::LogRow>            m_built;
+
+    MappedFile                 m_cacheFile;
+    onspeed::log::RowCacheImage m_cached;
+};
+
+#endif  // ONSPEED_TOOLS_REGRESSION_LOG_ROW_SOURCE_H
@@ -0,0 +1,93 @@
+// MappedFile.h — read-only whole-file view for host_main.
+//
+// Maps a log file into memory once (POSIX mmap) so the replay paths can
+// index and parse it in place via proto::log_csv::LineIndex instead of
+// copying every row through std::getline.  `-` (stdin) and anything mmap
+// refuses (pipes, empty files) fall back to reading into an owned buffer,
+// so callers always get one contiguous std::string_view.
+//
+// Host-only: this lives beside host_main.cpp rather than in onspeed_core,
+// which must stay free of platform headers.
+
+#ifndef ONSPEED_TOOLS_REGRESSION_MAPPED_FILE_H
+#define ONSPEED_TOOLS_REGRESSION_MAPPED_FILE_H
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    // Open `path` ("-" = stdin).  Returns false if the file can't be read.
+    bool Open(const char* path)
+    {
+        Close();
+        if (std::strcmp(path, "-") == 0) {
+            m_owned.assign(std::istreambuf_iterator<char>(std::cin),
+                           std::istreambuf_iterator<char>());
+            m_view = m_owned;
+            return true;
+        }
+
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size),
+                             PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                // One sequential pass builds the line index; tell the
+                // kernel so it reads ahead aggressively.
+                ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                m_map    = p;
+                m_mapLen = static_cast<size_t>(st.st_size);
+                m_view   = std::string_view(static_cast<const char*>(p), m_mapLen);
+                ::close(fd);
+                return true;
+            }
+        }
+
+        // Not mappable — read it the slow way.
+        char buf[65536];
+        ssize_t n;
+        while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+            m_owned.append(buf, static_cast<size_t>(n));
+        ::close(fd);
+        if (n < 0) return false;
+        m_view = m_owned;
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_map != nullptr) ::munmap(m_map, m_mapLen);
+        m_map    = nullptr;
+        m_mapLen = 0;
+        m_owned.clear();
+        m_view = std::string_view();
+    }
+
+    std::string_view View() const { return m_view; }
+
+private:
+    void*            m_map    = nullptr;
+    size_t           m_mapLen = 0;
+    std::string      m_owned;
+    std::string_view m_view;
+};
+
+#endif  // ONSPEED_TOOLS_REGRESSION_MAPPED_FILE_H
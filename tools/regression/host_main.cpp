@@ -14,7 +14,7 @@
 //     stdin (default).  Output schema: see kAhrsToneOutputHeader (13 fields).
 //
 //   replay  [--input PATH] [--output-format csv|jsonl] [--log-rate 50|208]
-//              [--config PATH]
+//              [--config PATH] [--row-cache]
 //     Stream an OnSpeed SD log CSV through the LogReplayEngine pipeline.
 //     `--input -` reads stdin (default).  Input must be the real SD log
 //     format (timeStamp,Pfwd,PfwdSmoothed,...) — not the simplified AHRS
@@ -25,6 +25,19 @@
 //     Output schema: see kReplayEngineOutputHeader (23 fields).
 //     --log-rate {50|208}: log sample rate in Hz (default 50); rejected if
 //     any other value is supplied.
+//     --row-cache: load parsed rows from "<input>.rowcache" when it
+//     matches the log's current size and mtime, else parse the CSV and
+//     (re)write the sidecar.  Also accepted by `ahrs_tone --input-format
+//     sdlog`; ignored for stdin.
+//
+//   ekfq_sweep --input LOG --config PATH --sweep PATH [--threads N]
+//              [--loss-mode default|cruise-pitch|cruise-aoa] [--row-cache]
+//     Replay one SD log through an EKFQ Ahrs per config in --sweep
+//     ("---"-separated EkfqConfigKv blocks) on N worker threads (default:
+//     all cores) and score each against the log's VN-300 columns with
+//     replay::VnTruthLoss (tune_ekf.py's composite_loss; default
+//     loss-mode cruise-aoa).  The log is read and translated once.
+//     Output schema: see kEkfqSweepOutputHeader (one row per config).
 //
 //   percent_lift --aoa F --alpha-0 F --alpha-stall F --stallwarn F
 //     Compute percent-of-stall (0..99.9) for a single AOA sample.
@@ -46,24 +59,51 @@
 //     Build the 77-byte #1 wire frame for the given DisplayBuildInputs
 //     JSON object.  Emits the frame bytes as lowercase hex on stdout.
 //
+//   export_csv --input PATH [--output PATH]
+//     Convert a binary columnar SD log (.osl, LOGFORMAT=1) to the CSV the
+//     firmware would have written, via proto::log_bin::ExportCsv.  Output
+//     goes to stdout unless --output is given.  A truncated final block
+//     (power-yank) ends the export cleanly; blocks failing their CRC are
+//     skipped and reported on stderr.
+//
+//   recalibrate --config PATH --input LOG [--input LOG ...] [--threads N]
+//              [--order N] [--min-ias KT] [--max-g-dev G] [--max-lat-g G]
+//              [--max-ias-rate KT_PER_S] [--min-segment-ms MS]
+//              [--min-samples N]
+//     Refit every detent's CoeffP -> DerivedAOA curve (aoa::PolyFitAccumulator,
+//     default order 2 like the calibration wizard) from the stabilized
+//     segments of one or more SD logs, one file per worker thread, in
+//     bounded memory.  Emits a JSON diff: per flap the config's current
+//     afCoeff, the refit afCoeff (same [a3,a2,a1,a0] layout), sample and
+//     segment counts, R² and RMSE.  A detent with fewer than --min-samples
+//     stabilized rows (default 100) reports "fitted": false.
+//
 // No external deps.  Arg parsing is a hand-rolled 40-line dispatcher.
 // JSON output is hand-rolled printf-based emission.  JSON input
 // (build_frame) is a hand-rolled key=value extractor.
 //
 // Compiles under -Wall -Wextra -Werror -Wshadow -Wformat=2 (native env).
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include <ahrs/Ahrs.h>
 #include <ahrs/EkfqConfigKv.h>
+#include <ahrs/EkfqPipelineBatch.h>
+#include <aoa/CurveFit.h>
 #include <aoa/DisplayPctAnchors.h>
 #include <aoa/PercentLift.h>
 #include <audio/ToneCalc.h>
@@ -71,15 +111,21 @@
 #include <config/ConfigXmlParse.h>
 #include <config/OnSpeedConfig.h>
 #include <proto/DisplaySerial.h>
+#include <proto/LogBin.h>
 #include <proto/LogCsvHeaderIndex.h>
+#include <proto/LogCsvLineIndex.h>
 #include <replay/LogReplayEngine.h>
 #include <replay/LogRowToAhrsInputs.h>
+#include <replay/VnTruthLoss.h>
 #include <sensors/FlapsDetector.h>
 #include <sensors/IasAlive.h>
 #include <types/AhrsInputs.h>
 #include <types/AhrsOutputs.h>
 #include <types/LogRow.h>
 
+#include "LogRowSource.h"
+#include "MappedFile.h"
+
 // ============================================================================
 // Minimal arg parser — recognises named flags of the form "--foo VALUE".
 // Returns the value for the first occurrence of `flag`, or `default_val`
@@ -100,6 +146,15 @@ const char* ArgGet(int argc, const char* const* argv,
     return default_val;
 }
 
+// True when the bare switch `flag` (no value) appears in argv[1..argc-1].
+bool ArgHas(int argc, const char* const* argv, const char* flag)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], flag) == 0) return true;
+    }
+    return false;
+}
+
 // ---------------------------------------------------------------------------
 // Minimal JSON emitter — hand-rolled printf-based, no external deps.
 // ---------------------------------------------------------------------------
@@ -415,12 +470,14 @@ onspeed::AhrsInputs BuildAhrsInputs(const std::vector<InputRow>& rows,
 
 // RunAhrsToneSdlog — sdlog-format path for ahrs_tone.
 //
-// Reads a real OnSpeed SD log via BuildHeaderIndex/ParseRowByIndex,
-// maps LogRow → AhrsInputs, drives Ahrs::Step with --algorithm,
+// Reads a real OnSpeed SD log through LogRowSource (BuildHeaderIndex/
+// ParseRowByIndex over a LineIndex of the mapped file, or the row cache
+// sidecar with --row-cache — EKFQ tuning replays the same log once per
+// trial), maps LogRow → AhrsInputs, drives Ahrs::Step with --algorithm,
 // applies --config install bias and --ekfq-config tuning, and emits
 // an output CSV with the standard ahrs_tone columns plus appended
 // passthrough columns.
-static int RunAhrsToneSdlog(std::istream& in,
+static int RunAhrsToneSdlog(LogRowSource& src,
                             onspeed::ahrs::Algorithm algo,
                             const onspeed::config::OnSpeedConfig& pilotCfg,
                             const onspeed::EKFQ::Config& ekfqCfg,
@@ -434,43 +491,27 @@ static int RunAhrsToneSdlog(std::istream& in,
         return 1;
     }
 
-    // Parse header.
-    std::string headerLine;
-    if (!std::getline(in, headerLine)) {
-        std::fprintf(stderr, "host_main ahrs_tone: empty input\n");
-        return 1;
-    }
-
-    onspeed::proto::log_csv::HeaderIndex hdrIdx;
-    auto warnHdr = [](const char* col) {
-        std::fprintf(stderr,
-            "host_main ahrs_tone: header missing column '%s'\n", col);
-    };
-    if (!onspeed::proto::log_csv::BuildHeaderIndex(headerLine, hdrIdx, warnHdr)) {
-        std::fprintf(stderr, "host_main ahrs_tone: header parse failed\n");
-        return 1;
-    }
+    const onspeed::proto::log_csv::HeaderIndex& hdrIdx = src.Index();
 
     // Resolve passthrough column indices into the raw CSV row.
     // We tokenize each row twice: once for ParseRowByIndex → LogRow,
     // once for raw-string extraction of passthrough fields. This is
     // ~5% slower than a single-pass tokenize but keeps the change
-    // surface tiny.
+    // surface tiny.  (On a row-cache hit only the second pass runs.)
     //
     // BuildHeaderIndex maps named columns to integer ordinals on the
     // HeaderIndex struct. We need ordinals for the user's passthrough
     // names — re-parse the header line directly to build the lookup.
     std::vector<int> passthroughIdx(passthroughCols.size(), -1);
-    {
-        std::vector<std::string> headerCols;
-        std::string h(headerLine);
-        if (!h.empty() && h.back() == '\r') h.pop_back();
+    if (!passthroughCols.empty()) {
+        const std::string_view h = src.HeaderLine();
+        std::vector<std::string_view> headerCols;
         size_t p = 0;
         while (p < h.size()) {
             const size_t c = h.find(',', p);
             headerCols.push_back(h.substr(
-                p, (c == std::string::npos) ? h.size() - p : c - p));
-            if (c == std::string::npos) break;
+                p, (c == std::string_view::npos) ? h.size() - p : c - p));
+            if (c == std::string_view::npos) break;
             p = c + 1;
         }
         for (size_t i = 0; i < passthroughCols.size(); ++i) {
@@ -510,7 +551,6 @@ static int RunAhrsToneSdlog(std::istream& in,
     // Row bridge — owns dt + fresh-pressure state across rows.
     onspeed::replay::LogRowToAhrsInputs bridge;
 
-    std::string line;
     size_t rowIdx = 0;
     onspeed::LogRow row;
     row.boomEnabled        = hdrIdx.boomEnabled;
@@ -518,11 +558,12 @@ static int RunAhrsToneSdlog(std::istream& in,
     row.efisIsVn300        = hdrIdx.efisIsVn300;
     row.flapsRawAdcPresent = (hdrIdx.idxFlapsRawAdc >= 0);
 
-    while (std::getline(in, line)) {
-        if (!line.empty() && line.back() == '\r') line.pop_back();
-        if (line.empty()) continue;
+    // Passthrough tokenizer scratch, reused across rows.
+    std::vector<std::string_view> toks;
+    toks.reserve(96);
 
-        if (!onspeed::proto::log_csv::ParseRowByIndex(line, hdrIdx, row)) {
+    for (size_t li = 0; li < src.RowCount(); ++li) {
+        if (!src.Read(li, row)) {
             std::fprintf(stderr,
                 "host_main ahrs_tone: parse error at row %zu\n", rowIdx);
             return 1;
@@ -573,14 +614,14 @@ static int RunAhrsToneSdlog(std::istream& in,
 
         // Append passthrough columns by re-tokenizing the raw line.
         if (!passthroughIdx.empty()) {
-            std::vector<std::string_view> toks;
-            toks.reserve(96);
+            const std::string_view line = src.Line(li);
+            toks.clear();
             size_t p = 0;
             while (p <= line.size()) {
                 const size_t c = line.find(',', p);
                 toks.emplace_back(line.data() + p,
-                    (c == std::string::npos) ? line.size() - p : c - p);
-                if (c == std::string::npos) break;
+                    (c == std::string_view::npos) ? line.size() - p : c - p);
+                if (c == std::string_view::npos) break;
                 p = c + 1;
             }
             for (int idx : passthroughIdx) {
@@ -595,6 +636,7 @@ static int RunAhrsToneSdlog(std::istream& in,
         ++rowIdx;
     }
 
+    src.Finish();
     std::fprintf(stderr, "host_main ahrs_tone: %zu rows processed (sdlog)\n", rowIdx);
     return 0;
 }
@@ -699,6 +741,34 @@ int CmdAhrsTone(int argc, const char* const* argv)
         }
     }
 
+    if (input_is_sdlog) {
+        // SD logs run to hundreds of MB; map the file and parse rows in
+        // place rather than streaming them through std::getline.
+        // --row-cache reuses (or builds) the parsed-row sidecar instead.
+        auto warnHdr = [](const char* col) {
+            std::fprintf(stderr,
+                "host_main ahrs_tone: header missing column '%s'\n", col);
+        };
+        LogRowSource src;
+        switch (src.Open(input_path, ArgHas(argc, argv, "--row-cache"),
+                         "host_main ahrs_tone", warnHdr)) {
+        case LogRowSource::OpenStatus::Ok:
+            break;
+        case LogRowSource::OpenStatus::CannotOpen:
+            std::fprintf(stderr, "host_main ahrs_tone: cannot open '%s'\n", input_path);
+            return 1;
+        case LogRowSource::OpenStatus::Empty:
+            std::fprintf(stderr, "host_main ahrs_tone: empty input\n");
+            return 1;
+        case LogRowSource::OpenStatus::BadHeader:
+            std::fprintf(stderr, "host_main ahrs_tone: header parse failed\n");
+            return 1;
+        }
+        return RunAhrsToneSdlog(src, algo, pilotCfg, ekfqCfg, pipeCfg,
+                                passthroughCols, fmt);
+    }
+    // Else fall through to the existing synthetic-format path.
+
     // Open input — "-" means stdin.
     std::istream* in_stream = &std::cin;
     std::ifstream in_file;
@@ -711,12 +781,6 @@ int CmdAhrsTone(int argc, const char* const* argv)
         in_stream = &in_file;
     }
 
-    if (input_is_sdlog) {
-        return RunAhrsToneSdlog(*in_stream, algo, pilotCfg, ekfqCfg, pipeCfg,
-                                passthroughCols, fmt);
-    }
-    // Else fall through to the existing synthetic-format path.
-
     std::string line;
 
     if (!std::getline(*in_stream, line) || !ParseAhrsToneHeader(line)) {
@@ -817,6 +881,393 @@ int CmdAhrsTone(int argc, const char* const* argv)
     return 0;
 }
 
+// ============================================================================
+// EKFQ_SWEEP subcommand — score many EKFQ configs against one SD log.
+//
+// The Optuna tuner used to pay one process spawn, one log read and one
+// Python CSV parse per trial. ekfq_sweep reads the log once (optionally
+// through the --row-cache sidecar) and translates every row to
+// AhrsInputs once, then runs the config-independent Ahrs::SensorStage()
+// over it once. Configs replay that track in groups of EKFQBatch::LANES
+// on an EkfqPipelineBatch (one EKFQBatch update per frame for the whole
+// group); sequential_update configs, which EKFQBatch does not implement,
+// get an Ahrs each. Work items share a pool of worker threads. Each
+// replay is scored in-process by replay::VnTruthLoss against the log's
+// VN-300 columns.
+//
+// --sweep PATH holds the configs as EkfqConfigKv blocks separated by
+// lines consisting of "---". Keys a block omits keep their defaults, and
+// missing-key warnings are suppressed. Output is one CSV row per config,
+// in file order (kEkfqSweepOutputHeader).
+// ============================================================================
+
+constexpr const char* kEkfqSweepOutputHeader =
+    "config,loss,pitch_rms,roll_rms,vz_rms,"
+    "pitch_rate_rms,roll_rate_rms,vz_rate_rms,"
+    "alpha_kin_rms,alpha_pressure_diag,rows,fresh_vn_rows,finite";
+
+// Split a CSV line into `toks` (views into `line`).
+void SplitCsv(std::string_view line, std::vector<std::string_view>& toks)
+{
+    toks.clear();
+    size_t p = 0;
+    while (p <= line.size()) {
+        const size_t c = line.find(',', p);
+        toks.push_back(line.substr(
+            p, (c == std::string_view::npos) ? line.size() - p : c - p));
+        if (c == std::string_view::npos) break;
+        p = c + 1;
+    }
+}
+
+// VN-300 truth columns located by name. BuildHeaderIndex only fills the
+// LogRow VN-300 fields when the whole group is present, and logs older
+// than the per-sample timestamp columns (#637) — most of the tuning
+// corpus — fail that check. ekfq_sweep reads the four truth columns
+// straight from the CSV text instead.
+struct VnTruthColumns {
+    int pitch = -1, roll = -1, vzDown = -1, dataAge = -1;
+
+    bool Resolve(std::string_view header)
+    {
+        std::vector<std::string_view> cols;
+        SplitCsv(header, cols);
+        for (size_t i = 0; i < cols.size(); ++i) {
+            if (cols[i] == "vnPitch")      pitch   = (int)i;
+            if (cols[i] == "vnRoll")       roll    = (int)i;
+            if (cols[i] == "vnVelNedDown") vzDown  = (int)i;
+            if (cols[i] == "vnDataAge")    dataAge = (int)i;
+        }
+        return pitch >= 0 && roll >= 0 && vzDown >= 0 && dataAge >= 0;
+    }
+
+    bool Read(std::string_view line, std::vector<std::string_view>& toks,
+              onspeed::replay::VnTruthSample& out) const
+    {
+        SplitCsv(line, toks);
+        auto num = [&](int idx, double& v) {
+            if (idx >= (int)toks.size() || toks[idx].empty()) return false;
+            char buf[64];
+            const size_t n = std::min(toks[idx].size(), sizeof(buf) - 1);
+            std::memcpy(buf, toks[idx].data(), n);
+            buf[n] = '\0';
+            char* end = nullptr;
+            v = std::strtod(buf, &end);
+            return end != buf;
+        };
+        double p, r, vz, age;
+        if (!num(pitch, p) || !num(roll, r) || !num(vzDown, vz) || !num(dataAge, age)) {
+            return false;
+        }
+        out.pitchDeg    = (float)p;
+        out.rollDeg     = (float)r;
+        out.vzMps       = (float)vz;
+        out.vnDataAgeMs = (float)age;
+        return true;
+    }
+};
+
+struct SweepVariant {
+    onspeed::EKFQ::Config                       ekfq;
+    onspeed::ahrs::EkfqPipeline::PipelineConfig pipe;
+};
+
+// Split `text` on "---" lines and parse each block. Returns false (after
+// reporting the block number and parser message) on the first bad block.
+bool ParseSweepFile(std::string_view text, std::vector<SweepVariant>& out)
+{
+    size_t pos = 0;
+    std::string block;
+    auto flush = [&]() -> bool {
+        // Blocks holding only comments/whitespace (e.g. a trailing "---")
+        // are not configs.
+        bool hasKey = false;
+        size_t p = 0;
+        while (p < block.size() && !hasKey) {
+            size_t e = block.find('\n', p);
+            if (e == std::string::npos) e = block.size();
+            size_t b = p;
+            while (b < e && (block[b] == ' ' || block[b] == '\t' || block[b] == '\r')) ++b;
+            hasKey = (b < e && block[b] != '#');
+            p = e + 1;
+        }
+        if (!hasKey) { block.clear(); return true; }
+
+        SweepVariant v;
+        // Missing-key warnings only follow a successful parse, so on
+        // failure the last message is the error.
+        std::string err;
+        auto sink = [&err](const char* m) { err = m; };
+        if (!onspeed::ahrs::ParseEkfqConfigKv(block, v.ekfq, v.pipe, sink)) {
+            std::fprintf(stderr, "host_main ekfq_sweep: config %zu: %s\n",
+                         out.size(), err.c_str());
+            return false;
+        }
+        out.push_back(v);
+        block.clear();
+        return true;
+    };
+
+    while (pos <= text.size()) {
+        size_t e = text.find('\n', pos);
+        if (e == std::string_view::npos) e = text.size();
+        std::string_view line = text.substr(pos, e - pos);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line == "---") {
+            if (!flush()) return false;
+        } else {
+            block.append(line).push_back('\n');
+        }
+        pos = e + 1;
+    }
+    return flush();
+}
+
+int CmdEkfqSweep(int argc, const char* const* argv)
+{
+    const char* input_path  = ArgGet(argc, argv, "--input");
+    const char* config_path = ArgGet(argc, argv, "--config");
+    const char* sweep_path  = ArgGet(argc, argv, "--sweep");
+    if (input_path == nullptr || config_path == nullptr || sweep_path == nullptr) {
+        std::fprintf(stderr,
+            "usage: host_main ekfq_sweep --input LOG --config PATH --sweep PATH\n"
+            "       [--threads N] [--loss-mode default|cruise-pitch|cruise-aoa] [--row-cache]\n");
+        return 1;
+    }
+
+    const char* loss_mode = ArgGet(argc, argv, "--loss-mode", "cruise-aoa");
+    onspeed::replay::VnTruthLossProfile profile;
+    if (!onspeed::replay::VnTruthLossProfile::FromName(loss_mode, profile)) {
+        std::fprintf(stderr,
+            "host_main ekfq_sweep: unknown --loss-mode '%s' "
+            "(default|cruise-pitch|cruise-aoa)\n", loss_mode);
+        return 1;
+    }
+
+    unsigned threads = std::thread::hardware_concurrency();
+    if (const char* t = ArgGet(argc, argv, "--threads")) {
+        const int n = std::atoi(t);
+        if (n < 1) {
+            std::fprintf(stderr, "host_main ekfq_sweep: --threads must be >= 1 (got %s)\n", t);
+            return 1;
+        }
+        threads = static_cast<unsigned>(n);
+    }
+    if (threads == 0) threads = 1;
+
+    onspeed::config::OnSpeedConfig pilotCfg;
+    pilotCfg.LoadDefaults();
+    if (!LoadConfig(config_path, pilotCfg)) return 1;
+
+    std::vector<SweepVariant> variants;
+    {
+        std::ifstream sf(sweep_path);
+        if (!sf.is_open()) {
+            std::fprintf(stderr, "host_main ekfq_sweep: cannot open --sweep '%s'\n", sweep_path);
+            return 1;
+        }
+        const std::string text{std::istreambuf_iterator<char>(sf),
+                               std::istreambuf_iterator<char>()};
+        if (!ParseSweepFile(text, variants)) return 1;
+    }
+    if (variants.empty()) {
+        std::fprintf(stderr, "host_main ekfq_sweep: --sweep '%s' has no configs\n", sweep_path);
+        return 1;
+    }
+
+    // Load and translate the log once. The bridge is config-independent,
+    // so every variant replays the same input track.
+    auto warnHdr = [](const char* col) {
+        std::fprintf(stderr, "host_main ekfq_sweep: header missing column '%s'\n", col);
+    };
+    LogRowSource src;
+    switch (src.Open(input_path, ArgHas(argc, argv, "--row-cache"),
+                     "host_main ekfq_sweep", warnHdr)) {
+    case LogRowSource::OpenStatus::Ok:
+        break;
+    case LogRowSource::OpenStatus::CannotOpen:
+        std::fprintf(stderr, "host_main ekfq_sweep: cannot open '%s'\n", input_path);
+        return 1;
+    case LogRowSource::OpenStatus::Empty:
+        std::fprintf(stderr, "host_main ekfq_sweep: empty input\n");
+        return 1;
+    case LogRowSource::OpenStatus::BadHeader:
+        std::fprintf(stderr, "host_main ekfq_sweep: header parse failed\n");
+        return 1;
+    }
+    // Complete VN-300 logs carry the truth in LogRow (and so in the row
+    // cache); older ones are read by column name from the CSV text.
+    const bool truthInRow = src.Index().efisIsVn300;
+    VnTruthColumns truthCols;
+    if (!truthInRow && !truthCols.Resolve(src.HeaderLine())) {
+        std::fprintf(stderr,
+            "host_main ekfq_sweep: log has no VN-300 columns to score against "
+            "(needs vnPitch, vnRoll, vnVelNedDown, vnDataAge)\n");
+        return 1;
+    }
+    std::vector<std::string_view> toks;
+
+    struct Frame {
+        onspeed::AhrsInputs inputs;
+        float               dtSec;
+    };
+    std::vector<Frame>                          frames;
+    std::vector<onspeed::replay::VnTruthSample> truth;
+    frames.reserve(src.RowCount());
+    truth.reserve(src.RowCount());
+    onspeed::AhrsInputs                seedInputs{};
+    float                              seedPaltFt = 0.0f;
+    onspeed::replay::VnTruthSample     seedTruth;
+    bool                               haveSeed   = false;
+    {
+        onspeed::replay::LogRowToAhrsInputs bridge;
+        onspeed::LogRow row;
+        row.boomEnabled        = src.Index().boomEnabled;
+        row.efisEnabled        = src.Index().efisEnabled;
+        row.efisIsVn300        = src.Index().efisIsVn300;
+        row.flapsRawAdcPresent = (src.Index().idxFlapsRawAdc >= 0);
+        for (size_t li = 0; li < src.RowCount(); ++li) {
+            if (!src.Read(li, row)) {
+                std::fprintf(stderr, "host_main ekfq_sweep: parse error at row %zu\n", li);
+                return 1;
+            }
+            onspeed::replay::VnTruthSample t =
+                onspeed::replay::VnTruthSample::FromLogRow(row);
+            if (!truthInRow && !truthCols.Read(src.Line(li), toks, t)) {
+                std::fprintf(stderr,
+                    "host_main ekfq_sweep: bad VN-300 truth value at row %zu\n", li);
+                return 1;
+            }
+            const auto br = bridge.translate(row);
+            if (br.isSeedFrame) {
+                seedInputs = br.inputs;
+                seedPaltFt = row.paltFt;
+                seedTruth  = t;
+                haveSeed   = true;
+                continue;
+            }
+            frames.push_back({br.inputs, br.dtSec});
+            truth.push_back(t);
+        }
+        src.Finish();
+    }
+    if (!haveSeed || frames.empty()) {
+        std::fprintf(stderr, "host_main ekfq_sweep: no data rows\n");
+        return 1;
+    }
+
+    onspeed::ahrs::AhrsConfig ahrsCfg;
+    ahrsCfg.pitchBiasDeg         = pilotCfg.fPitchBias;
+    ahrsCfg.rollBiasDeg          = pilotCfg.fRollBias;
+    ahrsCfg.algorithm            = onspeed::ahrs::Algorithm::Ekfq;
+    ahrsCfg.gyroSmoothingWindow  = 30;
+    ahrsCfg.imuSampleRateHz      = kImuRateHz;
+    ahrsCfg.pressureSampleRateHz = kPressureRateHz;
+
+    // Stage 1 of Ahrs::Step (TAS, installation bias) does not depend on
+    // the EKFQ tuning: run it once and share the result with every
+    // config. Init() publishes the seed attitude as latest().
+    std::vector<onspeed::ahrs::EkfqPipeline::Inputs> sensed(frames.size());
+    float seedPitchDeg, seedRollDeg;
+    {
+        onspeed::ahrs::Ahrs sensorStage(ahrsCfg);
+        sensorStage.Init(seedInputs, seedPaltFt);
+        seedPitchDeg = sensorStage.latest().pitchDeg;
+        seedRollDeg  = sensorStage.latest().rollDeg;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            sensed[i] = sensorStage.SensorStage(frames[i].inputs, frames[i].dtSec);
+        }
+    }
+    const float seedAltMeters = onspeed::ft2m(seedPaltFt);
+
+    // Work items: up to LANES batch-update configs replayed together on
+    // one EkfqPipelineBatch (a short last group leaves lanes idle), and
+    // each sequential_update config alone on its own Ahrs, since
+    // EKFQBatch only implements the batch update.
+    constexpr size_t kLanes = onspeed::ahrs::EkfqPipelineBatch::LANES;
+    std::vector<std::vector<size_t>> items;
+    {
+        std::vector<size_t> group;
+        for (size_t k = 0; k < variants.size(); ++k) {
+            if (variants[k].ekfq.sequential_update) {
+                items.push_back({k});
+                continue;
+            }
+            group.push_back(k);
+            if (group.size() == kLanes) { items.push_back(group); group.clear(); }
+        }
+        if (!group.empty()) items.push_back(group);
+    }
+
+    // Work queue: each worker claims the next unscored item. Results land
+    // in per-config slots, so output order never depends on scheduling.
+    std::vector<onspeed::replay::VnTruthLossResult> results(variants.size());
+    std::atomic<size_t> next{0};
+    auto scoreScalar = [&](size_t k) {
+        onspeed::ahrs::Ahrs ahrs(ahrsCfg);
+        ahrs.SetEkfqConfig(variants[k].ekfq, variants[k].pipe);
+        ahrs.Init(seedInputs, seedPaltFt);
+        onspeed::replay::VnTruthLoss loss(profile);
+        loss.seed(seedTruth);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            loss.add(truth[i], ahrs.Step(frames[i].inputs, frames[i].dtSec));
+        }
+        results[k] = loss.finish();
+    };
+    auto scoreBatch = [&](const std::vector<size_t>& group) {
+        auto batch = std::make_unique<onspeed::ahrs::EkfqPipelineBatch>();
+        std::vector<onspeed::replay::VnTruthLoss> losses(group.size(), onspeed::replay::VnTruthLoss(profile));
+        for (size_t l = 0; l < group.size(); ++l) {
+            batch->SetConfig(static_cast<int>(l), variants[group[l]].ekfq, variants[group[l]].pipe);
+            losses[l].seed(seedTruth);
+        }
+        batch->Init(seedPitchDeg, seedRollDeg, seedAltMeters);
+        onspeed::ahrs::EkfqPipeline::Outputs out[kLanes];
+        for (size_t i = 0; i < frames.size(); ++i) {
+            batch->Step(sensed[i], out);
+            // The AhrsOutputs fields VnTruthLoss reads, as Ahrs::Step's
+            // output stage publishes them for EKFQ (VSI zeroed while the
+            // IAS display gate is closed).
+            const bool alive = frames[i].inputs.sensors.iasAlive;
+            for (size_t l = 0; l < group.size(); ++l) {
+                onspeed::AhrsOutputs o;
+                o.pitchDeg      = out[l].pitchDeg;
+                o.rollDeg       = out[l].rollDeg;
+                o.derivedAoaDeg = out[l].derivedAoaDeg;
+                o.altFt         = onspeed::m2ft(out[l].altMeters);
+                o.vsiFpm        = onspeed::mps2fpm(alive ? out[l].vsiMps : 0.0f);
+                losses[l].add(truth[i], o);
+            }
+        }
+        for (size_t l = 0; l < group.size(); ++l) results[group[l]] = losses[l].finish();
+    };
+    auto worker = [&]() {
+        for (size_t w = next.fetch_add(1); w < items.size(); w = next.fetch_add(1)) {
+            if (variants[items[w][0]].ekfq.sequential_update) scoreScalar(items[w][0]);
+            else                                              scoreBatch(items[w]);
+        }
+    };
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(items.size()));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    std::printf("%s\n", kEkfqSweepOutputHeader);
+    for (size_t k = 0; k < results.size(); ++k) {
+        const onspeed::replay::VnTruthLossResult& r = results[k];
+        std::printf("%zu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%zu,%zu,%d\n",
+            k, (double)r.total, (double)r.pitchRms, (double)r.rollRms, (double)r.vzRms,
+            (double)r.pitchRateRms, (double)r.rollRateRms, (double)r.vzRateRms,
+            (double)r.alphaKinRms, (double)r.alphaPressureDiag,
+            r.rows, r.freshVnRows, r.finite ? 1 : 0);
+    }
+    std::fprintf(stderr,
+        "host_main ekfq_sweep: %zu configs x %zu rows on %u threads (loss-mode %s)\n",
+        variants.size(), frames.size() + 1, threads, loss_mode);
+    return 0;
+}
+
 // ============================================================================
 // REPLAY subcommand — LogReplayEngine pipeline over a real SD log CSV.
 //
@@ -964,38 +1415,38 @@ int CmdReplay(int argc, const char* const* argv)
         return 1;
     }
 
-    // Open input — "-" means stdin.
-    std::istream* in_stream = &std::cin;
-    std::ifstream in_file;
-    if (std::strcmp(input_path, "-") != 0) {
-        in_file.open(input_path);
-        if (!in_file.is_open()) {
-            std::fprintf(stderr, "host_main replay: cannot open '%s'\n", input_path);
-            return 1;
-        }
-        in_stream = &in_file;
-    }
-
-    // Parse the header via BuildHeaderIndex for name-keyed column mapping.
-    // This tolerates column reordering, addition, and removal across firmware
-    // versions — the same approach used by the firmware's LogReplay task.
-    std::string header_line;
-    if (!std::getline(*in_stream, header_line)) {
-        std::fprintf(stderr, "host_main replay: empty input — no header line\n");
-        return 1;
-    }
-
-    onspeed::proto::log_csv::HeaderIndex hdr_idx;
+    // Map the input ("-" means stdin) and index its lines once.  Rows are
+    // parsed in place from the mapping — no per-row std::string — which
+    // matters when a tuning study replays the same 350 MB log per trial.
+    // With --row-cache the parsed rows come from (or are saved to) the
+    // "<input>.rowcache" sidecar, skipping CSV parsing on repeat runs.
+    //
+    // The header goes through BuildHeaderIndex for name-keyed column
+    // mapping. This tolerates column reordering, addition, and removal
+    // across firmware versions — the same approach used by the firmware's
+    // LogReplay task.
     auto warn_sink = [](const char* col) {
         std::fprintf(stderr,
             "host_main replay: header warning: missing column '%s'\n", col);
     };
-    if (!onspeed::proto::log_csv::BuildHeaderIndex(header_line, hdr_idx, warn_sink)) {
+    LogRowSource src;
+    switch (src.Open(input_path, ArgHas(argc, argv, "--row-cache"),
+                     "host_main replay", warn_sink)) {
+    case LogRowSource::OpenStatus::Ok:
+        break;
+    case LogRowSource::OpenStatus::CannotOpen:
+        std::fprintf(stderr, "host_main replay: cannot open '%s'\n", input_path);
+        return 1;
+    case LogRowSource::OpenStatus::Empty:
+        std::fprintf(stderr, "host_main replay: empty input — no header line\n");
+        return 1;
+    case LogRowSource::OpenStatus::BadHeader:
         std::fprintf(stderr,
             "host_main replay: header index build failed "
             "(too many columns or no recognized OnSpeed columns)\n");
         return 1;
     }
+    const onspeed::proto::log_csv::HeaderIndex& hdr_idx = src.Index();
 
     // Log sample rate: supplied via --log-rate {50|208} (default 50 Hz).
     // 50 Hz is the firmware default; 208 Hz logs are produced when iLogRate
@@ -1037,27 +1488,21 @@ int CmdReplay(int argc, const char* const* argv)
         std::printf("%s\n", kReplayEngineOutputHeader);
     }
 
+    // LineIndex already trimmed trailing CRs (the firmware writes \r\n on
+    // SD; git on macOS may strip \r in checkout) and dropped empty lines.
     size_t row_count = 0;
-    std::string line;
-    while (std::getline(*in_stream, line)) {
-        // Trim trailing CR so the tokenizer sees clean input on both
-        // platforms (the firmware writes \r\n on SD; git on macOS may
-        // strip \r in checkout, leaving clean \n — handle both).
-        if (!line.empty() && line.back() == '\r')
-            line.pop_back();
-        if (line.empty())
-            continue;
-
+    for (size_t li = 0; li < src.RowCount(); ++li) {
         onspeed::LogRow row;
         row.flapsRawAdcPresent = flaps_raw_adc_available;
         row.boomEnabled  = hdr_idx.boomEnabled;
         row.efisEnabled  = hdr_idx.efisEnabled;
         row.efisIsVn300  = hdr_idx.efisIsVn300;
 
-        if (!onspeed::proto::log_csv::ParseRowByIndex(line, hdr_idx, row)) {
+        if (!src.Read(li, row)) {
+            const std::string_view line = src.Line(li);
             std::fprintf(stderr,
-                "host_main replay: parse error at row %zu: %s\n",
-                row_count, line.c_str());
+                "host_main replay: parse error at row %zu: %.*s\n",
+                row_count, static_cast<int>(line.size()), line.data());
             return 1;
         }
 
@@ -1099,6 +1544,8 @@ int CmdReplay(int argc, const char* const* argv)
         return 1;
     }
 
+    src.Finish();
+
     std::fprintf(stderr, "host_main replay: %zu rows processed\n", row_count);
     return 0;
 }
@@ -1323,6 +1770,388 @@ int CmdBuildFrame(int argc, const char* const* argv)
     return 0;
 }
 
+// ============================================================================
+// EXPORT_CSV subcommand
+// ============================================================================
+
+bool WriteCsvLine(void* ctx, const char* line, size_t len)
+{
+    std::FILE* out = static_cast<std::FILE*>(ctx);
+    return std::fwrite(line, 1, len, out) == len && std::fputc('\n', out) != EOF;
+}
+
+const char* BlockStatusName(onspeed::proto::log_bin::BlockStatus st)
+{
+    using onspeed::proto::log_bin::BlockStatus;
+    switch (st) {
+        case BlockStatus::Ok:            return "ok";
+        case BlockStatus::Truncated:     return "truncated";
+        case BlockStatus::BadMagic:      return "bad block magic";
+        case BlockStatus::BadVersion:    return "unsupported block version";
+        case BlockStatus::UnknownColumn: return "unknown column";
+        case BlockStatus::BadLength:     return "bad block length";
+        case BlockStatus::BadCrc:        return "bad crc";
+    }
+    return "?";
+}
+
+int CmdExportCsv(int argc, const char* const* argv)
+{
+    namespace log_bin = onspeed::proto::log_bin;
+
+    const char* in_path  = ArgGet(argc, argv, "--input");
+    const char* out_path = ArgGet(argc, argv, "--output");
+    if (!in_path) {
+        std::fprintf(stderr, "usage: host_main export_csv --input PATH [--output PATH]\n");
+        return 1;
+    }
+
+    std::ifstream f(in_path, std::ios::binary);
+    if (!f) {
+        std::fprintf(stderr, "export_csv: cannot open %s\n", in_path);
+        return 1;
+    }
+    const std::vector<uint8_t> image((std::istreambuf_iterator<char>(f)),
+                                     std::istreambuf_iterator<char>());
+
+    std::FILE* out = stdout;
+    if (out_path) {
+        out = std::fopen(out_path, "wb");
+        if (!out) {
+            std::fprintf(stderr, "export_csv: cannot create %s\n", out_path);
+            return 1;
+        }
+    }
+
+    log_bin::ExportResult res;
+    const bool ok = log_bin::ExportCsv(image.data(), image.size(),
+                                       WriteCsvLine, out, &res);
+    if (out != stdout) std::fclose(out);
+
+    if (!ok) {
+        std::fprintf(stderr, "export_csv: %s is not a readable .osl log\n", in_path);
+        return 1;
+    }
+    if (res.skippedBlocks > 0)
+        std::fprintf(stderr, "export_csv: skipped %u corrupt block(s)\n",
+                     static_cast<unsigned>(res.skippedBlocks));
+    if (res.status != log_bin::BlockStatus::Ok &&
+        res.status != log_bin::BlockStatus::BadCrc)
+        std::fprintf(stderr, "export_csv: stopped at byte %zu (%s); %u rows exported\n",
+                     res.bytesConsumed, BlockStatusName(res.status),
+                     static_cast<unsigned>(res.rows));
+    return 0;
+}
+
+// ============================================================================
+// RECALIBRATE subcommand — refit each detent's CP→AOA curve from flight logs.
+//
+// Streams every --input log once, keeps the rows that look like stabilized
+// flight (valid IAS above --min-ias, vertical G within --max-g-dev of 1,
+// lateral G within --max-lat-g, smoothed |dIAS/dt| under --max-ias-rate,
+// flap position on a configured detent) and groups consecutive kept rows
+// into segments.  Segments at least --min-segment-ms long fold into a
+// per-detent aoa::PolyFitAccumulator; shorter ones (a pass through the
+// window during a manoeuvre) are dropped.  The fit is CoeffP → DerivedAOA,
+// the same pair the calibration wizard regresses.
+//
+// Memory is bounded by the number of files in flight, not their size:
+// each worker reads its log through a fixed-size buffer and keeps only
+// the fit sums.  Files are claimed from an atomic work queue; per-file
+// accumulators are merged in input order, so the result does not depend
+// on --threads.
+// ============================================================================
+
+struct RecalFilter {
+    float    minIasKt      = 40.0f;
+    float    maxGDev       = 0.15f;
+    float    maxLatG       = 0.10f;
+    float    maxIasRate    = 3.0f;    // kt/s, smoothed
+    uint32_t minSegmentMs  = 2000;
+    uint32_t maxGapMs      = 500;     // a longer row gap ends the segment
+};
+
+struct RecalDetent {
+    onspeed::aoa::PolyFitAccumulator fit;
+    uint32_t                         segments = 0;
+};
+
+struct RecalFileResult {
+    bool                     ok   = false;
+    uint64_t                 rows = 0;
+    uint64_t                 used = 0;
+    std::vector<RecalDetent> detents;
+};
+
+// Line-at-a-time reader over a fixed buffer: a multi-GB log never needs
+// more than kBufBytes plus its longest line.
+class ChunkedLineReader {
+public:
+    explicit ChunkedLineReader(std::FILE* f) : m_f(f), m_buf(kBufBytes) {}
+
+    // Next line without its terminator; false at end of file.
+    bool Next(std::string_view& line)
+    {
+        for (;;) {
+            const char* start = m_buf.data() + m_pos;
+            const char* nl = static_cast<const char*>(
+                std::memchr(start, '\n', m_len - m_pos));
+            if (nl != nullptr) {
+                line = std::string_view(start, static_cast<size_t>(nl - start));
+                m_pos += line.size() + 1;
+                return true;
+            }
+            if (m_eof) {
+                if (m_pos == m_len) return false;
+                line = std::string_view(start, m_len - m_pos);
+                m_pos = m_len;
+                return true;
+            }
+            // Slide the partial line down and refill behind it.
+            const size_t tail = m_len - m_pos;
+            std::memmove(m_buf.data(), start, tail);
+            m_pos = 0;
+            m_len = tail;
+            if (m_len == m_buf.size()) m_buf.resize(m_buf.size() * 2);
+            const size_t n = std::fread(m_buf.data() + m_len, 1, m_buf.size() - m_len, m_f);
+            m_len += n;
+            if (n == 0) m_eof = true;
+        }
+    }
+
+private:
+    static constexpr size_t kBufBytes = 1u << 20;
+
+    std::FILE*        m_f;
+    std::vector<char> m_buf;
+    size_t            m_pos = 0;
+    size_t            m_len = 0;
+    bool              m_eof = false;
+};
+
+RecalFileResult RecalibrateFile(const char* path,
+                                const onspeed::config::OnSpeedConfig& cfg,
+                                const RecalFilter& flt, int order)
+{
+    namespace log_csv = onspeed::proto::log_csv;
+
+    RecalFileResult res;
+    res.detents.assign(cfg.aFlaps.size(), RecalDetent{onspeed::aoa::PolyFitAccumulator(order), 0});
+
+    std::FILE* f = std::fopen(path, "rb");
+    if (f == nullptr) {
+        std::fprintf(stderr, "host_main recalibrate: cannot open '%s'\n", path);
+        return res;
+    }
+    ChunkedLineReader reader(f);
+
+    std::string_view line;
+    log_csv::HeaderIndex idx;
+    if (!reader.Next(line) || !log_csv::BuildHeaderIndex(line, idx)) {
+        std::fprintf(stderr, "host_main recalibrate: '%s' has no usable header\n", path);
+        std::fclose(f);
+        return res;
+    }
+
+    // Pending segment: its own accumulator until it proves long enough.
+    onspeed::aoa::PolyFitAccumulator seg(order);
+    int      segDetent  = -1;
+    uint32_t segStartMs = 0;
+    uint32_t lastMs     = 0;
+    bool     haveLast   = false;
+    float    lastIas    = 0.0f;
+    float    iasRate    = 0.0f;      // EMA of |dIAS/dt|, ~1 s time constant
+    auto closeSegment = [&]() {
+        if (segDetent >= 0 && lastMs - segStartMs >= flt.minSegmentMs) {
+            RecalDetent& d = res.detents[static_cast<size_t>(segDetent)];
+            d.fit.Merge(seg);
+            ++d.segments;
+            res.used += seg.SampleCount();
+        }
+        seg.Reset();
+        segDetent = -1;
+    };
+
+    onspeed::LogRow row;
+    while (reader.Next(line)) {
+        if (line.empty() || line == "\r") continue;
+        row = onspeed::LogRow{};
+        row.boomEnabled        = idx.boomEnabled;
+        row.efisEnabled        = idx.efisEnabled;
+        row.efisIsVn300        = idx.efisIsVn300;
+        row.flapsRawAdcPresent = (idx.idxFlapsRawAdc >= 0);
+        if (!log_csv::ParseRowByIndex(line, idx, row)) continue;
+        ++res.rows;
+
+        const uint32_t t = row.timeStampMs;
+        const bool gap = haveLast && (t < lastMs || t - lastMs > flt.maxGapMs);
+        if (haveLast && !gap && t > lastMs && row.iasValid && std::isfinite(row.iasKt)) {
+            const float dt    = static_cast<float>(t - lastMs) * 0.001f;
+            const float rate  = std::fabs(row.iasKt - lastIas) / dt;
+            const float alpha = std::min(1.0f, dt);
+            iasRate += alpha * (rate - iasRate);
+        } else if (gap) {
+            iasRate = 0.0f;
+        }
+
+        int detent = -1;
+        for (size_t i = 0; i < cfg.aFlaps.size(); ++i) {
+            if (cfg.aFlaps[i].iDegrees == row.flapsPos) { detent = static_cast<int>(i); break; }
+        }
+
+        const bool stable = detent >= 0 && row.iasValid && row.iasKt >= flt.minIasKt
+            && std::fabs(row.imuVerticalG - 1.0f) <= flt.maxGDev
+            && std::fabs(row.imuLateralG) <= flt.maxLatG
+            && iasRate <= flt.maxIasRate
+            && std::isfinite(row.coeffP) && std::isfinite(row.derivedAoaDeg);
+
+        if (gap || !stable || detent != segDetent) closeSegment();
+        if (stable) {
+            if (segDetent < 0) {
+                segDetent  = detent;
+                segStartMs = t;
+            }
+            seg.Add(row.coeffP, row.derivedAoaDeg);
+        }
+
+        if (row.iasValid && std::isfinite(row.iasKt)) lastIas = row.iasKt;
+        lastMs   = t;
+        haveLast = true;
+    }
+    closeSegment();
+    std::fclose(f);
+    res.ok = true;
+    return res;
+}
+
+void JsonCoeffs(const char* key, const onspeed::SuCalibrationCurve& c, bool last = false)
+{
+    std::printf("      \"%s\": [%.6g, %.6g, %.6g, %.6g]%s\n", key,
+                static_cast<double>(c.afCoeff[0]), static_cast<double>(c.afCoeff[1]),
+                static_cast<double>(c.afCoeff[2]), static_cast<double>(c.afCoeff[3]),
+                last ? "" : ",");
+}
+
+int CmdRecalibrate(int argc, const char* const* argv)
+{
+    const char* config_path = ArgGet(argc, argv, "--config");
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::strcmp(argv[i], "--input") == 0) inputs.push_back(argv[++i]);
+    }
+    if (config_path == nullptr || inputs.empty()) {
+        std::fprintf(stderr,
+            "usage: host_main recalibrate --config PATH --input LOG [--input LOG ...]\n"
+            "       [--threads N] [--order 1|2|3] [--min-ias KT] [--max-g-dev G]\n"
+            "       [--max-lat-g G] [--max-ias-rate KT_PER_S] [--min-segment-ms MS]\n"
+            "       [--min-samples N]\n");
+        return 1;
+    }
+
+    RecalFilter flt;
+    int      order      = onspeed::aoa::kCurveFitWizardOrder;
+    uint32_t minSamples = 100;
+    unsigned threads    = std::thread::hardware_concurrency();
+    try {
+        if (const char* s = ArgGet(argc, argv, "--order"))          order = std::stoi(s);
+        if (const char* s = ArgGet(argc, argv, "--min-ias"))        flt.minIasKt = std::stof(s);
+        if (const char* s = ArgGet(argc, argv, "--max-g-dev"))      flt.maxGDev = std::stof(s);
+        if (const char* s = ArgGet(argc, argv, "--max-lat-g"))      flt.maxLatG = std::stof(s);
+        if (const char* s = ArgGet(argc, argv, "--max-ias-rate"))   flt.maxIasRate = std::stof(s);
+        if (const char* s = ArgGet(argc, argv, "--min-segment-ms")) flt.minSegmentMs = static_cast<uint32_t>(std::stoul(s));
+        if (const char* s = ArgGet(argc, argv, "--min-samples"))    minSamples = static_cast<uint32_t>(std::stoul(s));
+        if (const char* s = ArgGet(argc, argv, "--threads")) {
+            const int n = std::stoi(s);
+            if (n < 1) throw std::invalid_argument("threads");
+            threads = static_cast<unsigned>(n);
+        }
+    } catch (...) {
+        std::fprintf(stderr, "host_main recalibrate: bad numeric argument\n");
+        return 1;
+    }
+    if (order < 1 || order > onspeed::aoa::kCurveFitMaxOrder) {
+        std::fprintf(stderr, "host_main recalibrate: --order must be 1..%d (got %d)\n",
+                     onspeed::aoa::kCurveFitMaxOrder, order);
+        return 1;
+    }
+    if (threads == 0) threads = 1;
+
+    onspeed::config::OnSpeedConfig cfg;
+    if (!LoadConfig(config_path, cfg)) return 1;
+    if (cfg.aFlaps.empty()) {
+        std::fprintf(stderr, "host_main recalibrate: config has no flap entries\n");
+        return 1;
+    }
+
+    std::vector<RecalFileResult> perFile(inputs.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t k = next.fetch_add(1); k < inputs.size(); k = next.fetch_add(1)) {
+            perFile[k] = RecalibrateFile(inputs[k], cfg, flt, order);
+        }
+    };
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(inputs.size()));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    std::vector<RecalDetent> total(cfg.aFlaps.size(),
+                                   RecalDetent{onspeed::aoa::PolyFitAccumulator(order), 0});
+    uint64_t rows = 0;
+    uint64_t used = 0;
+    for (const RecalFileResult& r : perFile) {
+        if (!r.ok) return 1;
+        rows += r.rows;
+        used += r.used;
+        for (size_t i = 0; i < total.size(); ++i) {
+            total[i].fit.Merge(r.detents[i].fit);
+            total[i].segments += r.detents[i].segments;
+        }
+    }
+
+    std::printf("{\n");
+    JsonInt("files", static_cast<int>(inputs.size()));
+    std::printf("  \"rows\": %llu,\n", static_cast<unsigned long long>(rows));
+    std::printf("  \"rowsUsed\": %llu,\n", static_cast<unsigned long long>(used));
+    JsonInt("order", order);
+    std::printf("  \"flaps\": [\n");
+    for (size_t i = 0; i < total.size(); ++i) {
+        const onspeed::config::OnSpeedConfig::SuFlaps& flap = cfg.aFlaps[i];
+        onspeed::aoa::CurveFitResult fit;
+        const bool fitted = total[i].fit.SampleCount() >= minSamples && total[i].fit.Solve(fit);
+        bool changed = false;
+        if (fitted) {
+            for (int k = 0; k < onspeed::MAX_CURVE_COEFF; ++k)
+                changed = changed || std::fabs(fit.curve.afCoeff[k] - flap.AoaCurve.afCoeff[k]) > 1e-4f;
+        }
+        std::printf("    {\n");
+        std::printf("      \"index\": %zu,\n", i);
+        std::printf("      \"degrees\": %d,\n", flap.iDegrees);
+        std::printf("      \"samples\": %u,\n", static_cast<unsigned>(total[i].fit.SampleCount()));
+        std::printf("      \"segments\": %u,\n", static_cast<unsigned>(total[i].segments));
+        std::printf("      \"fitted\": %s,\n", fitted ? "true" : "false");
+        JsonCoeffs("old", flap.AoaCurve, !fitted);
+        if (fitted) {
+            JsonCoeffs("new", fit.curve);
+            std::printf("      \"r2\": %.6f,\n", fit.r2);
+            std::printf("      \"rmse\": %.4f,\n", fit.rmse);
+            std::printf("      \"cpMin\": %.4f,\n", fit.xMin);
+            std::printf("      \"cpMax\": %.4f,\n", fit.xMax);
+            std::printf("      \"changed\": %s\n", changed ? "true" : "false");
+        }
+        std::printf("    }%s\n", i + 1 == total.size() ? "" : ",");
+    }
+    std::printf("  ]\n");
+    std::printf("}\n");
+
+    std::fprintf(stderr,
+        "host_main recalibrate: %zu files, %llu rows (%llu stabilized) on %u threads\n",
+        inputs.size(), static_cast<unsigned long long>(rows),
+        static_cast<unsigned long long>(used), threads);
+    return 0;
+}
+
 // ============================================================================
 // HELP subcommand
 // ============================================================================
@@ -1336,11 +2165,17 @@ int CmdHelp()
         "    Stream simplified sensor CSV (ias_kt,palt_ft,oat_c,ax,ay,az,gx,gy,gz)\n"
         "    through AHRS + Madgwick + Kalman + ToneCalc pipeline.\n"
         "    Gates against fixtures/golden.csv — the bedrock regression test.\n\n"
-        "  replay  --input PATH|'-' [--config PATH] [--output-format csv|jsonl] [--log-rate 50|208]\n"
+        "  replay  --input PATH|'-' [--config PATH] [--output-format csv|jsonl] [--log-rate 50|208]\n          [--row-cache]\n"
         "    Stream an OnSpeed SD log CSV through LogReplayEngine.\n"
         "    Input: real SD log format (timeStamp,Pfwd,...,DerivedAOA,CoeffP).\n"
         "    --config: optional V1/V2 config file (pot positions for synth ADC).\n"
-        "    --log-rate: log sample rate in Hz (50 or 208; default 50).\n\n"
+        "    --log-rate: log sample rate in Hz (50 or 208; default 50).\n"
+        "    --row-cache: reuse/write parsed rows in <input>.rowcache (also for\n"
+        "    ahrs_tone --input-format sdlog).\n\n"
+        "  ekfq_sweep --input LOG --config PATH --sweep PATH [--threads N]\n"
+        "             [--loss-mode default|cruise-pitch|cruise-aoa] [--row-cache]\n"
+        "    Score many EKFQ configs (---separated kv blocks) against the log's\n"
+        "    VN-300 truth in one pass, 8 configs per EKFQBatch on a thread pool.\n\n"
         "  percent_lift --aoa F --alpha-0 F --alpha-stall F --stallwarn F\n"
         "    Compute percent-of-stall for a single AOA reading.\n\n"
         "  parse_config --in PATH\n"
@@ -1349,6 +2184,13 @@ int CmdHelp()
         "    Compute display percent anchors for a given flap and pot position.\n\n"
         "  build_frame --record JSON\n"
         "    Build a 77-byte #1 wire frame; emit as hex.\n\n"
+        "  export_csv --input PATH [--output PATH]\n"
+        "    Convert a binary .osl SD log to the equivalent CSV.\n\n"
+        "  recalibrate --config PATH --input LOG [--input LOG ...] [--threads N]\n"
+        "              [--order N] [--min-ias KT] [--max-g-dev G] [--max-lat-g G]\n"
+        "              [--max-ias-rate KT_PER_S] [--min-segment-ms MS] [--min-samples N]\n"
+        "    Refit each detent's CP->AOA curve from stabilized segments of the\n"
+        "    logs (one file per thread) and emit old vs new coefficients as JSON.\n\n"
         "  help\n"
         "    Show this message.\n"
     );
@@ -1373,11 +2215,14 @@ int main(int argc, char* argv[])
 
     // Pass the full argc/argv so each subcommand sees its own flags.
     if (std::strcmp(sub, "ahrs_tone")       == 0) return CmdAhrsTone(argc, argv);
+    if (std::strcmp(sub, "ekfq_sweep")      == 0) return CmdEkfqSweep(argc, argv);
     if (std::strcmp(sub, "replay")          == 0) return CmdReplay(argc, argv);
     if (std::strcmp(sub, "percent_lift")    == 0) return CmdPercentLift(argc, argv);
     if (std::strcmp(sub, "parse_config")    == 0) return CmdParseConfig(argc, argv);
     if (std::strcmp(sub, "display_anchors") == 0) return CmdDisplayAnchors(argc, argv);
     if (std::strcmp(sub, "build_frame")     == 0) return CmdBuildFrame(argc, argv);
+    if (std::strcmp(sub, "export_csv")      == 0) return CmdExportCsv(argc, argv);
+    if (std::strcmp(sub, "recalibrate")     == 0) return CmdRecalibrate(argc, argv);
     if (std::strcmp(sub, "help")            == 0) return CmdHelp();
 
     std::fprintf(stderr,
@@ -899,6 +899,8 @@ function substituteAoaConfig(tpl, cfg, js, postJs) {
   body = body.replaceAll('{{serialOutOnspeedSel}}',
                          selAttr(!cfg.serialOutFormat ||
                                  cfg.serialOutFormat === 'ONSPEED'));
+  body = body.replaceAll('{{serialOutOnspeedBinSel}}',
+                         selAttr(cfg.serialOutFormat === 'ONSPEED_BIN'));
 
   body = body.replaceAll('{{acGrossWeight}}',  String(cfg.acGrossWeight));
   body = body.replaceAll('{{acBestGlideIAS}}', String(cfg.acBestGlideIAS));
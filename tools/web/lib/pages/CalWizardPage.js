@@ -7,12 +7,16 @@
 //   flydecel  — live WS connection, recording during the decel run,
 //                stall auto-detection (5 deg/sec pitch-rate + negative
 //                pitch angle, mirroring the legacy trigger)
-//   review    — polynomial fit + chart + setpoints + Save / Discard
+//   review    — fit + chart + setpoints + Save / Discard
 //
-// Setpoint math mirrors the legacy javascript_calibration.h (the same
-// IAS-to-AOA fit, the same multipliers, the same NAOA-fraction
-// computation) so the Save POST shape is byte-comparable to the
-// legacy save.  The differential test
+// The run is fitted on the firmware as it is flown: Record POSTs
+// /api/calwiz/record, Stop (or the stall trigger) POSTs
+// /api/calwiz/record/stop, and the reply carries the IAS-to-AOA and
+// CP-to-AOA fits (onspeed_core aoa/DecelRunFit.h).  This page only
+// turns the fit into setpoints.  Setpoint math mirrors the legacy
+// javascript_calibration.h (the same multipliers, the same
+// NAOA-fraction computation) so the Save POST shape is byte-comparable
+// to the legacy save.  The differential test
 // (test/test_calwiz_save_diff/) pins firmware-side equality; the JS
 // here pins client-side parity by reusing the same helper math.
 
@@ -203,12 +207,9 @@ function useLiveSamples({ recording }) {
         const sample = frameToSample(frame);
         setLast(sample);
         lastFrameMs = Date.now();
-        // Only record samples with valid air data.  iasKt and
-        // decelRateKtPerSec are null when bIasAlive is false; pushing
-        // them into samplesRef would feed null arithmetic into
-        // analyzeDecel's IAS EMA (null * 0.98 = 0 in JS) and into
-        // regression.js's IAS-vs-AOA fit, which can produce
-        // Infinity/NaN coefficients that get saved to firmware.
+        // Only record samples with valid air data (the same gate the
+        // firmware-side fit applies).  The recorded samples feed the
+        // review chart only.
         if (recordingRef.current && sample.aoaIsValid) {
           samplesRef.current.push(sample);
         }
@@ -377,23 +378,32 @@ function FlyDecelStep({ params, samples, setSamples, onAnalyzed }) {
     if (!recording || !live.last) return;
     if (Math.abs(live.last.pitchRateDegPerSec) > STALL_PITCH_RATE_DEG_PER_SEC
         && live.last.pitchDeg < 0) {
-      const captured = live.samples().slice();
-      setRecording(false);
-      setSamples(captured);
-      const result = analyzeDecel(captured, params);
-      onAnalyzed(result);
+      stopRecording();
     }
   }, [live.last, recording]);
 
-  const startRecording = () => {
+  const [recordError, setRecordError] = useState(null);
+  const startRecording = async () => {
     live.reset();
-    setRecording(true);
+    setRecordError(null);
+    try {
+      await postJson('/api/calwiz/record', {});
+      setRecording(true);
+    } catch (e) {
+      setRecordError('Could not start recording: ' + String(e.message || e));
+    }
   };
-  const stopRecording = () => {
+  // The firmware's fit of the run comes back with the stop.
+  const stopRecording = async () => {
     const captured = live.samples().slice();
     setRecording(false);
     setSamples(captured);
-    const result = analyzeDecel(captured, params);
+    let result;
+    try {
+      result = analyzeDecel(await postJson('/api/calwiz/record/stop', {}), params);
+    } catch (e) {
+      result = { ok: false, error: 'Could not read the fit: ' + String(e.message || e) };
+    }
     onAnalyzed(result);
   };
 
@@ -421,6 +431,7 @@ function FlyDecelStep({ params, samples, setSamples, onAnalyzed }) {
                 <button type="button" class="wifibutton"
                         onClick=${startRecording}>Record</button>
               </div>
+              ${recordError && html`<p class="cal-warn">${recordError}</p>`}
             </div>`}
       </div>
 
@@ -460,99 +471,42 @@ function FlyDecelStep({ params, samples, setSamples, onAnalyzed }) {
 }
 
 // ---------------------------------------------------------------------
-// Decel-run analysis — same math the legacy javascript_calibration.h
-// ran inline.  Returns { ok, error?, setpoints, fit, samples, chart }.
+// Decel-run analysis — setpoints from the firmware's fit, with the same
+// math the legacy javascript_calibration.h ran inline.  `fit` is the
+// /api/calwiz/record/stop reply.  Returns { ok, error?, setpoints, fit,
+// flapsPos, flapIndex, stallIas, stallIndex }.
 //
 // The setpoints are body angles (degrees), not wing AOA, per CLAUDE.md
 // "OnSpeed measures body angle, not wing AOA".  alpha_0 (typically
 // negative) is the floor in the lift-equation fit; the percent-lift
 // math elsewhere uses (BodyAngle − alpha_0) / (alpha_stall − alpha_0).
 // ---------------------------------------------------------------------
-export function analyzeDecel(samples, params) {
-  if (!samples || samples.length < 50) {
-    return { ok: false, error: 'Not enough samples to analyze (need a full run).' };
-  }
-
-  // Reject any sample with null/non-finite iasKt or coeffP — null
-  // arithmetic in the EMAs below produces NaN/0 that would survive
-  // into the IAS-vs-AOA regression and yield Infinity/NaN setpoints.
-  // The live-samples gate already excludes invalid frames; this is
-  // belt-and-suspenders for any future caller (e.g. file replay).
-  for (let i = 0; i < samples.length; i++) {
-    const s = samples[i];
-    if (!Number.isFinite(s.iasKt) || !Number.isFinite(s.coeffP)) {
-      return { ok: false, error: 'Invalid air data in recorded samples.' };
-    }
-  }
-
-  // Smoothed IAS / CP — same EMAs the legacy used.
-  const sIAS = new Array(samples.length);
-  const sCP  = new Array(samples.length);
-  sIAS[0] = samples[0].iasKt;
-  sCP[0]  = samples[0].coeffP;
-  let stallCP = 0, stallIas = 100, stallIdx = 0;
-  for (let i = 1; i < samples.length; i++) {
-    sIAS[i] = samples[i].iasKt   * 0.98 + sIAS[i - 1] * 0.02;
-    sCP[i]  = samples[i].coeffP  * 0.90 + sCP[i  - 1] * 0.10;
-    if (sCP[i] > stallCP) {
-      stallCP  = sCP[i];
-      stallIas = sIAS[i];
-      stallIdx = i;
-    }
-  }
-  if (stallCP === 0) {
-    return { ok: false, error: 'Stall not detected. Try again — pitch down for stall recovery.' };
-  }
 
-  // Verify IAS is decreasing (slope of linear fit on IAS vs index).
-  const iasFitData = [];
-  for (let i = 0; i <= stallIdx; i++) iasFitData.push([i, samples[i].iasKt]);
-  const iasFit = window.regression.polynomial(iasFitData, { order: 1, precision: 2 });
-  if (iasFit.equation[0] >= 0) {
-    return { ok: false, error: 'Airspeed is increasing during the run. Try again.' };
+// Why the firmware had no fit (DecelRunStatus), in the wizard's words.
+const FIT_ERRORS = {
+  tooFewSamples:      'Not enough samples to analyze (need a full run).',
+  invalidAirData:     'Invalid air data in recorded samples.',
+  noStall:            'Stall not detected. Try again — pitch down for stall recovery.',
+  airspeedIncreasing: 'Airspeed is increasing during the run. Try again.',
+  // The 1/IAS² fit collapsed (K ≈ 0, or fewer than 5 points): every
+  // setpoint would equal alpha_0 — silent calibration failure.
+  tooThin:            'Decel data is too thin to fit (slope ≈ 0). Record more samples and try again.',
+};
+
+export function analyzeDecel(fit, params) {
+  if (!fit || fit.status !== 'ok') {
+    return { ok: false, error: FIT_ERRORS[fit?.status] || 'No fit from the firmware.' };
   }
-
-  // CP-to-AOA fit (used at runtime by firmware).
-  const cpData = [];
-  for (let i = 0; i <= stallIdx; i++)
-    cpData.push([sCP[i], samples[i].derivedAoaDeg]);
-  const cpFit = window.regression.polynomial(cpData, { order: 2, precision: 4 });
-  const [a2, a1, a0] = cpFit.equation;
-
-  // IAS-to-AOA fit: DerivedAOA = K / IAS^2 + alpha_0.  Linear regression
-  // of DerivedAOA vs 1/IAS^2; intercept = alpha_0, slope = K.
-  const iasAoaData = [];
-  for (let i = 0; i <= stallIdx; i++) {
-    const v = samples[i].iasKt;
-    if (v > 0) iasAoaData.push([1.0 / (v * v), samples[i].derivedAoaDeg]);
-  }
-  const iasAoaFit = window.regression.polynomial(iasAoaData, { order: 1, precision: 6 });
-  const kFit       = iasAoaFit.equation[0];
-  const alpha0     = iasAoaFit.equation[1];
-  const alphaStall = kFit / (stallIas * stallIas) + alpha0;
-
-  // Degenerate-fit guard.  When the linear regression denominator is
-  // zero (single distinct sample, or all 1/IAS² values equal because
-  // IAS was constant), regression.js returns slope=0 and the fit
-  // collapses: every setpoint computed from `kFit / IAS² + alpha_0`
-  // equals alpha_0 verbatim.  Saving that would map every body angle
-  // from LDmax through Stall onto the same value — silent calibration
-  // failure.  Reject before reaching Save.
-  //
-  // 5 samples is the threshold the legacy wizard used implicitly
-  // (regression.js fits 1 distinct point with slope 0 and N-fold
-  // collinear points the same way).  A 1 kt/s decel from cruise
-  // produces hundreds of pre-stall samples; < 5 means the recording
-  // never built up a useful range.
-  if (Math.abs(kFit) < 1e-6 || iasAoaData.length < 5) {
-    return {
-      ok: false,
-      error: 'Decel data is too thin to fit (slope ≈ 0). Record more samples and try again.',
-    };
+  const kFit       = fit.kFit;
+  const alpha0     = fit.alpha0Deg;
+  const alphaStall = fit.alphaStallDeg;
+  const stallIas   = fit.stallIasKt;
+  for (const v of [kFit, alpha0, alphaStall, stallIas, fit.curve0, fit.curve1, fit.curve2]) {
+    if (!Number.isFinite(v)) return { ok: false, error: 'Invalid fit from the firmware.' };
   }
 
   // Setpoint math.  acVfe overrides LDmaxIAS for flapped runs.
-  const flapIndex = samples[stallIdx].flapIndex || 0;
+  const flapIndex = fit.flapIndex || 0;
   const acVfe         = parseFloat(params.vfeKt) || 0;
   const acGlimit      = parseFloat(params.gLimit) || 1;
   const acCurrentWt   = parseFloat(params.currentWeightLb) || 0;
@@ -580,9 +534,10 @@ export function analyzeDecel(samples, params) {
 
   return {
     ok: true,
-    flapsPos: samples[stallIdx].flapsPosDeg,
+    flapsPos: fit.flapsPosDeg,
     flapIndex,
     stallIas,
+    stallIndex: fit.stallIndex,
     setpoints: {
       ldMaxAoaDeg:       Number(ldMaxAoa.toFixed(2)),
       onSpeedFastAoaDeg: Number(onSpeedFastAoa.toFixed(2)),
@@ -595,13 +550,12 @@ export function analyzeDecel(samples, params) {
       kFit,
       alpha0Deg:     alpha0,
       alphaStallDeg: alphaStall,
-      curve0: a2,    // afCoeff[1] target
-      curve1: a1,    // afCoeff[2] target
-      curve2: a0,    // afCoeff[3] target
-      cpToAoaR2:    cpFit.r2,
-      iasToAoaR2:   iasAoaFit.r2,
+      curve0: fit.curve0,    // afCoeff[1] target
+      curve1: fit.curve1,    // afCoeff[2] target
+      curve2: fit.curve2,    // afCoeff[3] target
+      cpToAoaR2:    fit.cpToAoaR2,
+      iasToAoaR2:   fit.iasToAoaR2,
     },
-    smoothed: { sIAS, sCP, stallIdx },
   };
 }
 
@@ -611,15 +565,18 @@ export function analyzeDecel(samples, params) {
 function ReviewStep({ result, samples, onSave, onDiscard, saveStatus }) {
   const chartRef = useRef(null);
 
-  // Chartist chart of measured + predicted AOA vs CP.  Effect re-runs
-  // when the analysis result changes (new run loaded into review).
+  // Chartist chart of measured + predicted AOA vs CP, over the samples
+  // this page recorded up to the firmware's stall sample (the firmware
+  // counts the same 20 Hz frames; a dropped WS frame only shortens the
+  // chart).  Effect re-runs when the analysis result changes (new run
+  // loaded into review).
   useEffect(() => {
     if (!chartRef.current || !result?.ok) return;
-    const { sCP, stallIdx } = result.smoothed;
+    const stallIdx = Math.min(result.stallIndex, samples.length - 1);
     const measured = [], predicted = [];
     const [a2, a1, a0] = [result.fit.curve0, result.fit.curve1, result.fit.curve2];
     for (let i = stallIdx; i > 0; i--) {
-      const cp = sCP[i];
+      const cp = samples[i].coeffP;
       measured.push({ x: cp, y: samples[i].derivedAoaDeg });
       predicted.push({ x: cp, y: a2 * cp * cp + a1 * cp + a0 });
     }
@@ -10,10 +10,20 @@
 // Active session: download links stay enabled; checkbox and trash icon
 // hidden. The firmware's IsActiveLogFile() guard refuses sidecar deletes
 // of the active session even if the UI ever requests them.
+//
+// Flight-log downloads go through rangeDownload.js where the browser can
+// stream to a file it picked (File System Access API): the pill asks
+// where to save, writes chunks straight to disk, and a WiFi drop
+// mid-transfer resumes from the last byte received. A repeat download of
+// the active log copies the previous save and fetches only what was
+// written since. Browsers without that API follow the plain href, and
+// their own download manager streams (and resumes) it; so do middle-click
+// and "save link as".
 
 import { html, useState, useEffect } from '../../../../packages/ui-core/vendor/preact-standalone.js';
 import { PageShell } from '../shell/PageShell.js';
 import { getJsonWithRetry, postJson, ApiError } from '../shell/apiClient.js';
+import { downloadResumable, canStreamToDisk, pickSaveFile, fileSink } from '../shell/rangeDownload.js';
 
 function formatBytes(n) {
   if (n < 1024) return n + ' B';
@@ -51,9 +61,52 @@ function formatStart(meta) {
   return null;
 }
 
+// Where the active log was last saved, keyed by file name. The log only
+// grows while it is active, so the next download of it starts from a
+// copy of that file and asks the firmware for just the tail.
+const activeLogSaves = new Map();
+
+// Download `name` into the file behind `handle`.
+async function downloadLog(name, active, handle, onProgress) {
+  const url = '/download?file=' + encodeURIComponent(name);
+  const sink = await fileSink(handle);
+  try {
+    let offset = 0;
+    const prior = active ? activeLogSaves.get(name) : null;
+    if (prior) {
+      // Skip the copy if the earlier save was edited or truncated since.
+      const file = await prior.handle.getFile().catch(() => null);
+      if (file && file.size === prior.size) {
+        await sink.write(file);
+        offset = prior.size;
+      }
+    }
+    const r = await downloadResumable(url, { sink, offset, appendOnly: active, onProgress });
+    await sink.close();
+    if (active) activeLogSaves.set(name, { handle, size: r.size });
+  } catch (e) {
+    await sink.abort().catch(() => {});
+    throw e;
+  }
+}
+
+// "42%" once the size is known, byte count before that; " · resumed"
+// after a reconnect so the pilot knows the WiFi dropped.
+function formatProgress(p) {
+  const amount = p.total ? Math.floor((100 * p.received) / p.total) + '%' : formatBytes(p.received);
+  return p.resumes > 0 ? `${amount} · resumed` : amount;
+}
+
+// .osl is the binary columnar format (LOGFORMAT=1).
 function isLogFile(name) {
   const lower = name.toLowerCase();
-  return lower.endsWith('.csv') || lower.endsWith('.log');
+  return lower.endsWith('.csv') || lower.endsWith('.osl') || lower.endsWith('.log');
+}
+
+// Download pill label: the file's own extension ("csv", "osl").
+function logExtension(name) {
+  const m = /\.([^.]+)$/.exec(name);
+  return m ? m[1].toLowerCase() : 'file';
 }
 
 // Inline trash icon (Feather "trash-2").
@@ -91,7 +144,7 @@ const Stat = ({ label, value }) => html`
 // primary pill; .dbg / .meta pills appear when those sidecars exist.
 // Active row hides the trash icon and checkbox but keeps download
 // affordances so a pilot can grab the in-progress logs mid-flight.
-const LogCard = ({ file, active, selected, busyDeleting, onToggle, onDelete }) => {
+const LogCard = ({ file, active, selected, busyDeleting, progress, onToggle, onDelete, onDownload }) => {
   const meta = file.meta;
   const baseName = file.name.replace(/\.[^.]+$/, '');
   const startStr = formatStart(meta);
@@ -123,8 +176,11 @@ const LogCard = ({ file, active, selected, busyDeleting, onToggle, onDelete }) =
       <div class="log-card-right">
         <div class="log-card-downloads">
           <a class="dl-pill dl-pill-primary"
-             href=${'/download?file=' + encodeURIComponent(file.name)}>
-            <${DlIcon} />csv
+             href=${'/download?file=' + encodeURIComponent(file.name)}
+             onClick=${onDownload}>
+            <${DlIcon} />${progress
+              ? (progress.error ? 'retry' : formatProgress(progress))
+              : logExtension(file.name)}
           </a>
           ${file.hasDbg && html`
             <a class="dl-pill"
@@ -183,6 +239,7 @@ export function LogsPage() {
   const [busyDeleting, setBusyDeleting] = useState(false);
   const [retryStatus, setRetryStatus] = useState(null);
   const [diagOpen, setDiagOpen] = useState(false);
+  const [downloads, setDownloads] = useState({});
 
   const reload = async () => {
     setError(null);
@@ -226,6 +283,33 @@ export function LogsPage() {
     }
   };
 
+  const setDownload = (name, value) =>
+    setDownloads(prev => ({ ...prev, [name]: value }));
+
+  const startDownload = (name, active) => async (ev) => {
+    // Modified clicks (new tab, save-as) keep the browser's own handling,
+    // as does every click where the page can't stream to disk itself.
+    if (ev.button !== 0 || ev.metaKey || ev.ctrlKey || ev.shiftKey || ev.altKey) return;
+    if (!canStreamToDisk()) return;
+    ev.preventDefault();
+    if (downloads[name] && !downloads[name].error) return;   // already running
+    let handle;
+    try {
+      handle = await pickSaveFile(name);
+    } catch (e) {
+      if (e.name !== 'AbortError') setError(`Download of ${name} failed: ${e.message || e}`);
+      return;
+    }
+    setDownload(name, { received: 0, total: null, resumes: 0 });
+    try {
+      await downloadLog(name, active, handle, (p) => setDownload(name, p));
+      setDownload(name, null);
+    } catch (e) {
+      setDownload(name, { received: 0, total: null, resumes: 0, error: String(e) });
+      setError(`Download of ${name} failed: ${e.message || e}. Click it again to retry.`);
+    }
+  };
+
   const toggle = (name) => () => {
     setSelected(prev => {
       const next = new Set(prev);
@@ -335,8 +419,10 @@ export function LogsPage() {
                   active=${f.name === data.activeLog}
                   selected=${selected.has(f.name)}
                   busyDeleting=${busyDeleting}
+                  progress=${downloads[f.name] || null}
                   onToggle=${toggle(f.name)}
-                  onDelete=${deleteOne(f.name)} />`)}
+                  onDelete=${deleteOne(f.name)}
+                  onDownload=${startDownload(f.name, f.name === data.activeLog)} />`)}
             </div>
           </section>
 
@@ -0,0 +1,196 @@
+// Resumable downloads from the firmware's GET /download endpoint.
+//
+// The firmware answers `Range: bytes=N-` with 206 Partial Content, a
+// strong ETag and `Accept-Ranges: bytes` (see onspeed_core
+// api/HttpRange.h). Hangar WiFi drops mid-transfer often enough that a
+// 300 MB log pulled as one plain GET rarely finishes; this module keeps
+// what already arrived and asks only for the rest.
+//
+// - downloadResumable(url): fetch a whole file, resuming after network
+//   errors or short bodies. The first request is a plain GET so the
+//   firmware can gzip it (it only compresses when there is no Range
+//   header); fetch inflates transparently, so the bytes counted are file
+//   offsets and a resume asks for `bytes=<received>-` as usual. Resumes
+//   carry If-Range, so if the file changed underneath us the firmware
+//   replies 200 with the full body and we start over instead of splicing
+//   two versions together. The gzip reply has no ETag, so the first
+//   resume after one is unvalidated; the 206 it gets does carry one and
+//   guards every resume after that. Append-only files (the log being
+//   written) opt out of If-Range: their ETag changes with every write,
+//   yet the bytes we already hold stay valid.
+// - `offset` starts past bytes the caller already has, for following the
+//   active log without re-downloading what the page already saved.
+// - fileSink(handle): stream the body straight to a file picked with the
+//   File System Access API, so a 300 MB log never sits in page memory.
+//
+// Older firmware without Range support replies 200 to everything; the
+// download degrades to a plain full GET in that case.
+
+export class DownloadError extends Error {
+  constructor(status, message) {
+    super(message);
+    this.name = 'DownloadError';
+    this.status = status;
+  }
+}
+
+// "bytes 100-199/1000" -> { first: 100, last: 199, size: 1000 };
+// "bytes */1000"       -> { first: null, last: null, size: 1000 }.
+export function parseContentRange(value) {
+  if (!value) return null;
+  let m = /^\s*bytes\s+(\d+)-(\d+)\/(\d+)\s*$/i.exec(value);
+  if (m) return { first: Number(m[1]), last: Number(m[2]), size: Number(m[3]) };
+  m = /^\s*bytes\s+\*\/(\d+)\s*$/i.exec(value);
+  if (m) return { first: null, last: null, size: Number(m[1]) };
+  return null;
+}
+
+const defaultSleep = (ms) => new Promise(resolve => setTimeout(resolve, ms));
+
+// Hand the response body to `sink`, reporting progress per chunk.
+// Streams when the runtime exposes response.body so a drop mid-body still
+// keeps everything that arrived before it. Returns bytes read.
+async function readBody(response, sink, onChunk) {
+  let n = 0;
+  if (response.body && typeof response.body.getReader === 'function') {
+    const reader = response.body.getReader();
+    for (;;) {
+      const { done, value } = await reader.read();
+      if (done) break;
+      await sink.write(value);
+      n += value.byteLength;
+      onChunk(n);
+    }
+    return n;
+  }
+  const buf = new Uint8Array(await response.arrayBuffer());
+  await sink.write(buf);
+  onChunk(buf.byteLength);
+  return buf.byteLength;
+}
+
+// Default sink: collect the chunks and return them as a Blob.
+function memorySink() {
+  let parts = [];
+  return {
+    write: (chunk) => { parts.push(chunk); },
+    restart: () => { parts = []; },
+    blob: () => new Blob(parts),
+  };
+}
+
+// Download `url` in full. Resolves to { size, etag, resumes }, plus
+// `blob` when no sink was given.
+//
+// Options:
+//   sink          { write(chunk), restart() }, either may return a promise;
+//                 restart() drops everything written so far (the file
+//                 changed, or the firmware ignored Range). Default: memory
+//   offset        bytes of the file the sink already holds (default 0)
+//   appendOnly    omit If-Range on resume (file only ever grows)
+//   maxRetries    consecutive failed attempts before giving up (default 5)
+//   retryDelayMs  base back-off, multiplied by the attempt number
+//   onProgress    ({ received, total, resumes }) after every chunk
+//   signal        AbortSignal; aborting never retries
+//   fetchImpl, sleep   injection points for tests
+export async function downloadResumable(url, {
+  sink = null, offset = 0, appendOnly = false, maxRetries = 5, retryDelayMs = 1000,
+  onProgress = null, signal, fetchImpl = globalThis.fetch, sleep = defaultSleep,
+} = {}) {
+  const memory = sink ? null : memorySink();
+  const out = sink || memory;
+  let received = offset;
+  let total = null;
+  let etag = null;
+  let resumes = 0;
+  let failures = 0;
+
+  const report = () => { if (onProgress) onProgress({ received, total, resumes }); };
+
+  for (;;) {
+    const headers = {};
+    if (received > 0) {
+      headers['Range'] = `bytes=${received}-`;
+      if (etag && !appendOnly) headers['If-Range'] = etag;
+    }
+    try {
+      const response = await fetchImpl(url, { headers, signal });
+      if (response.status === 416) {
+        // Nothing past `received`: either we already have it all, or the
+        // file shrank (replaced) and our copy is no longer a prefix.
+        const cr = parseContentRange(response.headers.get('Content-Range'));
+        if (cr && received === cr.size) { total = cr.size; break; }
+        await out.restart();
+        received = 0; total = null; etag = null;
+        throw new DownloadError(416, 'file changed during download');
+      }
+      if (response.status === 206) {
+        const cr = parseContentRange(response.headers.get('Content-Range'));
+        if (!cr || cr.first !== received) {
+          throw new DownloadError(206, 'unexpected Content-Range ' + response.headers.get('Content-Range'));
+        }
+        total = cr.size;
+      } else if (response.status === 200) {
+        // Whole body: first request, Range unsupported, or If-Range
+        // rejected. Anything already written is stale.
+        if (received > 0) {
+          await out.restart();
+          received = 0;
+        }
+        // A gzip reply's Content-Length (if any) counts encoded bytes.
+        const len = response.headers.get('Content-Length');
+        const encoded = response.headers.get('Content-Encoding');
+        total = len !== null && !encoded ? Number(len) : null;
+      } else {
+        throw new DownloadError(response.status, `HTTP ${response.status}`);
+      }
+      etag = response.headers.get('ETag') || etag;
+
+      const base = received;
+      await readBody(response, out, (n) => { received = base + n; report(); });
+      failures = 0;
+      if (total === null || received >= total) break;
+      // Short body without an exception (connection closed early): resume.
+      resumes++;
+    } catch (e) {
+      if (signal && signal.aborted) throw e;
+      failures++;
+      if (failures > maxRetries) throw e;
+      await sleep(retryDelayMs * failures);
+      resumes++;
+      report();
+    }
+  }
+
+  report();
+  const result = { size: received, etag, resumes };
+  if (memory) result.blob = memory.blob();
+  return result;
+}
+
+// True when the browser can stream a download to a file it picked
+// (Chromium's File System Access API). Elsewhere the caller should let
+// the browser's own download manager handle the plain link.
+export function canStreamToDisk() {
+  return typeof globalThis.showSaveFilePicker === 'function';
+}
+
+// Ask the user where to save `filename`. Must be called from the click
+// handler, before any other await, to keep the user activation.
+// Rejects with an AbortError DOMException when the picker is dismissed.
+export function pickSaveFile(filename) {
+  return globalThis.showSaveFilePicker({ suggestedName: filename });
+}
+
+// Sink for downloadResumable that writes through to the file behind
+// `handle`. close() commits the file; abort() discards it.
+export async function fileSink(handle) {
+  const writable = await handle.createWritable();
+  return {
+    write: (chunk) => writable.write(chunk),
+    // truncate() also pulls the write position back to the new end.
+    restart: () => writable.truncate(0),
+    close: () => writable.close(),
+    abort: () => writable.abort(),
+  };
+}
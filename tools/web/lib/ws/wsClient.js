@@ -1,10 +1,11 @@
 // WebSocket client for OnSpeed live data.
 //
 // Connection lifecycle: 3 s staleness fallback, retry-storm protection
-// on close, blob-frame skipping (the DataServer broadcasts JSON text
-// frames; the blob-skip guard is defensive against any future binary
-// frame producer).  Maps the firmware's JSON schema to a record shape
-// the page components consume.
+// on close.  On open the client asks for binary live-data frames
+// (proto/LiveDataBin.h); firmware that predates them ignores the request
+// and keeps sending JSON text frames, so both are accepted.  Either
+// encoding is mapped to the JSON schema's object shape and then to the
+// record shape the page components consume.
 
 import { useEffect, useState } from '../../../../packages/ui-core/vendor/preact-standalone.js';
 
@@ -46,6 +47,51 @@ function parseFloatOr0(v) {
   return Number.isFinite(n) ? n : 0;
 }
 
+// Binary live-data frame, v1 — mirrors onspeed_core/src/proto/LiveDataBin.h.
+// Little-endian: u8 version, u8 reserved, u16 dataMark, then the f32
+// fields, then the i16 fields, in table order.  NaN on the wire is the
+// JSON `null`.  Each float is rounded to the decimals the JSON path
+// prints, so a page renders the same digits whichever encoding arrives.
+export const LIVE_DATA_BIN_VERSION = 1;
+export const LIVE_DATA_BIN_SELECT = 'fmt:bin1';
+const LIVE_DATA_BIN_SIZE = 110;
+const BIN_FLOAT_FIELDS = [
+  ['AOA', 2], ['Pitch', 2], ['Roll', 2], ['IAS', 2], ['PAlt', 2],
+  ['verticalGLoad', 2], ['lateralGLoad', 2], ['coeffP', 2], ['vsiFpm', 2],
+  ['flightPath', 2], ['PitchRate', 2], ['DecelRate', 2], ['OAT', 2],
+  ['DerivedAOA', 2], ['gOnsetRate', 2], ['percentLift', 1],
+  ['ekfBpDps', 4], ['ekfBqDps', 4], ['ekfBrDps', 4], ['ekfBAzMps2', 4],
+  ['ekfBetaDeg', 2], ['ekfYawDeg', 2],
+];
+const BIN_INT16_FIELDS = [
+  'flapsPos', 'flapIndex', 'flapsMinDeg', 'flapsMaxDeg',
+  'tonesOnPctLift', 'onSpeedFastPctLift', 'onSpeedSlowPctLift',
+  'stallWarnPctLift', 'pipPctLift',
+];
+const POW10 = [1, 10, 100, 1000, 10000];
+
+// Decode a binary frame (ArrayBuffer or typed-array view) into the same
+// object shape JSON.parse() yields for a text frame.  Returns null for a
+// short frame or an unknown version byte.  Exported for tests.
+export function decodeLiveDataBin(buf) {
+  const dv = ArrayBuffer.isView(buf)
+    ? new DataView(buf.buffer, buf.byteOffset, buf.byteLength)
+    : new DataView(buf);
+  if (dv.byteLength < LIVE_DATA_BIN_SIZE || dv.getUint8(0) !== LIVE_DATA_BIN_VERSION) return null;
+  const o = { dataMark: dv.getUint16(2, true) };
+  let off = 4;
+  for (const [key, decimals] of BIN_FLOAT_FIELDS) {
+    const v = dv.getFloat32(off, true);
+    o[key] = Number.isFinite(v) ? Math.round(v * POW10[decimals]) / POW10[decimals] : null;
+    off += 4;
+  }
+  for (const key of BIN_INT16_FIELDS) {
+    o[key] = dv.getInt16(off, true);
+    off += 2;
+  }
+  return o;
+}
+
 // Map a raw firmware JSON frame to the record shape the page components
 // expect.  Exported so tests can build records without touching the
 // network.
@@ -91,7 +137,7 @@ export function frameToRecord(o) {
 // Imperative API.  Returns `{disconnect}`.  Pages that need the
 // connection lifecycle outside a Preact component can call this
 // directly; the `useWebSocket` hook below wraps it for component use.
-export function connect({ onRecord, onStatus, onAge, uri = null }) {
+export function connect({ onRecord, onStatus, onAge, uri = null, binary = true }) {
   const wsUri = uri || resolveWsUri();
   let socket = null;
   let connecting = false;
@@ -115,7 +161,11 @@ export function connect({ onRecord, onStatus, onAge, uri = null }) {
       socket.close();
     }
     socket = new WebSocket(wsUri);
-    socket.onopen = () => setStatus('CONNECTED');
+    socket.binaryType = 'arraybuffer';
+    socket.onopen = () => {
+      setStatus('CONNECTED');
+      if (binary) socket.send(LIVE_DATA_BIN_SELECT);
+    };
     socket.onclose = () => {
       if (closed) return;
       setStatus('Reconnecting...');
@@ -127,14 +177,22 @@ export function connect({ onRecord, onStatus, onAge, uri = null }) {
 
   function handleMessage(evt) {
     connecting = false;
-    if (typeof evt.data !== 'string') return;
-    try {
-      const o = JSON.parse(evt.data);
-      lastUpdate = Date.now();
-      if (onRecord) onRecord(frameToRecord(o));
-    } catch (e) {
-      console.log('JSON parse error:', e.name, e.message);
+    let o;
+    if (typeof evt.data === 'string') {
+      try {
+        o = JSON.parse(evt.data);
+      } catch (e) {
+        console.log('JSON parse error:', e.name, e.message);
+        return;
+      }
+    } else if (evt.data instanceof ArrayBuffer) {
+      o = decodeLiveDataBin(evt.data);
+      if (!o) return;
+    } else {
+      return;
     }
+    lastUpdate = Date.now();
+    if (onRecord) onRecord(frameToRecord(o));
   }
 
   function tickAge() {
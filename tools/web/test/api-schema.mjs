@@ -193,6 +193,34 @@ if (deleteBulk) {
   }
 }
 
+// ----- /api/logs/preview ------------------------------------------------
+
+const preview = loadMock('api-logs-preview');
+if (preview) {
+  exactKeys(preview, ['name', 'size', 'points', 'rows', 'columns', 'data'], '/api/logs/preview');
+  ok(isString(preview.name), 'preview: name is string');
+  ok(isInt(preview.size) && preview.size >= 0, 'preview: size is non-negative int');
+  ok(isInt(preview.points) && preview.points > 0, 'preview: points is positive int');
+  ok(isInt(preview.rows) && preview.rows >= 0, 'preview: rows is non-negative int');
+  eq(JSON.stringify(preview.columns), JSON.stringify([
+    'tMs', 'iasKtMin', 'iasKtMax', 'aoaDegMin', 'aoaDegMax', 'paltFtMin', 'paltFtMax',
+    'verticalGMin', 'verticalGMax', 'flapsPosMin', 'flapsPosMax',
+  ]), 'preview: columns match onspeed_core log/LogPreview.h');
+  ok(Array.isArray(preview.data) && preview.data.length <= preview.points,
+     'preview: data has at most `points` rows');
+  let prevT = -1;
+  for (const [i, row] of preview.data.entries()) {
+    ok(row.length === preview.columns.length, `preview.data[${i}] has one value per column`);
+    ok(isInt(row[0]) && row[0] > prevT, `preview.data[${i}] tMs is increasing int`);
+    prevT = row[0];
+    for (let c = 1; c + 1 < row.length; c += 2) {
+      ok((row[c] === null && row[c + 1] === null) ||
+         (isNumber(row[c]) && isNumber(row[c + 1]) && row[c] <= row[c + 1]),
+         `preview.data[${i}] ${preview.columns[c]} <= ${preview.columns[c + 1]} (or both null)`);
+    }
+  }
+}
+
 // ----- /api/format, /api/reboot ----------------------------------------
 
 const format = loadMock('api-format');
@@ -260,6 +288,36 @@ if (calwiz) {
   }
 }
 
+// ----- /api/calwiz/record, /record/stop, /fit ----------------------------
+//
+// All three return the firmware's decel-run fit (CalwizFitJson.h).
+// Every number but sampleCount is 0 unless status is "ok".
+
+const calwizFitKeys = [
+  'recording', 'sampleCount', 'status',
+  'stallIndex', 'stallIasKt', 'stallCp', 'flapIndex', 'flapsPosDeg',
+  'kFit', 'alpha0Deg', 'alphaStallDeg', 'iasToAoaR2',
+  'curve0', 'curve1', 'curve2', 'cpToAoaR2',
+];
+const calwizFitStatuses = [
+  'ok', 'tooFewSamples', 'invalidAirData', 'noStall', 'airspeedIncreasing', 'tooThin',
+];
+for (const [mock, route] of [['api-calwiz-record',      '/api/calwiz/record'],
+                             ['api-calwiz-record-stop', '/api/calwiz/record/stop'],
+                             ['api-calwiz-fit',         '/api/calwiz/fit']]) {
+  const fit = loadMock(mock);
+  if (!fit) continue;
+  exactKeys(fit, calwizFitKeys, route);
+  ok(isBoolean(fit.recording), `${route}: recording is boolean`);
+  ok(calwizFitStatuses.includes(fit.status), `${route}: status is a DecelRunStatus name`);
+  for (const k of ['sampleCount', 'stallIndex', 'flapIndex', 'flapsPosDeg'])
+    ok(isInt(fit[k]), `${route}: ${k} is int`);
+  for (const k of ['stallIasKt', 'stallCp', 'kFit', 'alpha0Deg', 'alphaStallDeg',
+                   'iasToAoaR2', 'curve0', 'curve1', 'curve2', 'cpToAoaR2'])
+    ok(isNumber(fit[k]), `${route}: ${k} is number`);
+}
+eq(loadMock('api-calwiz-record')?.recording, true, '/api/calwiz/record: recording=true');
+
 // ----- /api/calwiz/save -------------------------------------------------
 //
 // Two valid shapes — happy path and warning path.  The mock fixture
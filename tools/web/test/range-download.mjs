@@ -0,0 +1,347 @@
+// Tests for lib/shell/rangeDownload.js — resumable /download client.
+//
+// A fake fetch plays the firmware's side of the Range contract
+// (onspeed_core api/HttpRange.h): 206 + Content-Range for `bytes=N-`,
+// 416 + `bytes */size` past EOF, 200 when If-Range doesn't match, and
+// (with `state.gzip`) a plain GET answered like the gzip path: no ETag,
+// no Content-Length, body already inflated as fetch would hand it over.
+// Faults are scripted per request so the resume paths run without a
+// network.
+//
+// Run with:  node tools/web/test/range-download.mjs
+//
+// Exit code 0 = all pass.
+
+import { parseContentRange, downloadResumable } from '../lib/shell/rangeDownload.js';
+
+let failed = 0;
+let passed = 0;
+const results = [];
+
+function eq(actual, expected, msg) {
+  if (actual === expected) { passed++; results.push(['  PASS', msg]); }
+  else { failed++; results.push(['  FAIL', `${msg}: got ${JSON.stringify(actual)}, want ${JSON.stringify(expected)}`]); }
+}
+
+function makeFile(n, seed = 0) {
+  const b = new Uint8Array(n);
+  for (let i = 0; i < n; i++) b[i] = (i * 7 + seed) & 0xff;
+  return b;
+}
+
+function sameBytes(a, b) {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) if (a[i] !== b[i]) return false;
+  return true;
+}
+
+async function blobBytes(blob) {
+  return new Uint8Array(await blob.arrayBuffer());
+}
+
+function headersOf(obj) {
+  const lower = Object.fromEntries(Object.entries(obj).map(([k, v]) => [k.toLowerCase(), String(v)]));
+  return { get: (k) => (k.toLowerCase() in lower ? lower[k.toLowerCase()] : null) };
+}
+
+// Body that streams `bytes` in 64-byte chunks and throws after
+// `failAfter` bytes when set (a WiFi drop mid-body).
+function bodyOf(bytes, failAfter) {
+  let pos = 0;
+  return {
+    getReader: () => ({
+      read: async () => {
+        if (failAfter !== undefined && pos >= failAfter) throw new TypeError('network error');
+        if (pos >= bytes.length) return { done: true, value: undefined };
+        const end = Math.min(bytes.length, pos + 64, failAfter ?? Infinity);
+        const value = bytes.slice(pos, end);
+        pos = end;
+        return { done: false, value };
+      },
+    }),
+  };
+}
+
+// Fake firmware. `state.file` and `state.etag` may be swapped between
+// requests; `faults[i]` applies to the i-th request:
+//   'throw'        fetch rejects before any response
+//   { failAfter }  body drops after that many bytes
+//   'ignoreRange'  reply 200 like firmware without Range support
+function makeServer(state, faults = []) {
+  const requests = [];
+  const fetchImpl = async (url, { headers = {} } = {}) => {
+    const i = requests.length;
+    requests.push({ url, headers: { ...headers } });
+    const fault = faults[i];
+    if (fault === 'throw') throw new TypeError('connection refused');
+    const file = state.file;
+    const size = file.length;
+    const m = /^bytes=(\d+)-$/.exec(headers['Range'] || '');
+    const ifRange = headers['If-Range'];
+    const useRange = m && fault !== 'ignoreRange' && (!ifRange || ifRange === state.etag);
+    const failAfter = fault && fault.failAfter;
+    if (useRange) {
+      const first = Number(m[1]);
+      if (first >= size) {
+        return { status: 416, headers: headersOf({ 'Content-Range': `bytes */${size}`, 'ETag': state.etag }) };
+      }
+      const part = file.slice(first);
+      return {
+        status: 206,
+        headers: headersOf({
+          'Content-Range': `bytes ${first}-${size - 1}/${size}`,
+          'Content-Length': part.length, 'ETag': state.etag,
+        }),
+        body: bodyOf(part, failAfter),
+        arrayBuffer: async () => part.buffer,
+      };
+    }
+    if (state.gzip && !m) {
+      return {
+        status: 200,
+        headers: headersOf({ 'Content-Encoding': 'gzip' }),
+        body: bodyOf(file, failAfter),
+        arrayBuffer: async () => file.slice().buffer,
+      };
+    }
+    return {
+      status: 200,
+      headers: headersOf({ 'Content-Length': size, 'ETag': state.etag }),
+      body: bodyOf(file, failAfter),
+      arrayBuffer: async () => file.slice().buffer,
+    };
+  };
+  return { fetchImpl, requests };
+}
+
+const noSleep = async () => {};
+
+// Sink that records what downloadResumable hands it.
+function recordingSink(initial = new Uint8Array(0)) {
+  const sink = {
+    bytes: initial,
+    restarts: 0,
+    write: async (chunk) => {
+      const next = new Uint8Array(sink.bytes.length + chunk.length);
+      next.set(sink.bytes);
+      next.set(chunk, sink.bytes.length);
+      sink.bytes = next;
+    },
+    restart: async () => { sink.bytes = new Uint8Array(0); sink.restarts++; },
+  };
+  return sink;
+}
+
+// ---- parseContentRange ------------------------------------------------
+
+{
+  const cr = parseContentRange('bytes 100-199/1000');
+  eq(cr && cr.first, 100, 'parseContentRange: first');
+  eq(cr && cr.last, 199, 'parseContentRange: last');
+  eq(cr && cr.size, 1000, 'parseContentRange: size');
+  const un = parseContentRange('bytes */1000');
+  eq(un && un.first, null, 'parseContentRange: unsatisfied form has no first');
+  eq(un && un.size, 1000, 'parseContentRange: unsatisfied form keeps size');
+  eq(parseContentRange(null), null, 'parseContentRange: null → null');
+  eq(parseContentRange('items 0-1/2'), null, 'parseContentRange: other unit → null');
+}
+
+// ---- downloadResumable -------------------------------------------------
+
+{
+  // Clean run: one request, whole file.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state);
+  const r = await downloadResumable('/download?file=log_001.csv', { fetchImpl, sleep: noSleep });
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'resumable: clean download matches');
+  eq(requests.length, 1, 'resumable: clean download is one request');
+  eq(requests[0].headers['Range'], undefined, 'resumable: first request has no Range (lets the firmware gzip)');
+  eq(requests[0].headers['If-Range'], undefined, 'resumable: first request has no If-Range');
+  eq(r.resumes, 0, 'resumable: clean download reports no resumes');
+}
+
+{
+  // Drop after 300 bytes: second request asks for the rest with If-Range.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state, [{ failAfter: 300 }]);
+  const progress = [];
+  const r = await downloadResumable('/d', {
+    fetchImpl, sleep: noSleep, onProgress: (p) => progress.push(p),
+  });
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'resumable: drop + resume matches');
+  eq(requests.length, 2, 'resumable: drop costs one extra request');
+  eq(requests[1].headers['Range'], 'bytes=300-', 'resumable: resume asks from the byte received');
+  eq(requests[1].headers['If-Range'], '"a"', 'resumable: resume carries If-Range');
+  eq(r.resumes, 1, 'resumable: resume counted');
+  eq(progress[progress.length - 1].received, 1000, 'resumable: final progress is whole file');
+}
+
+{
+  // File replaced between attempts: If-Range fails, firmware sends 200,
+  // client starts over rather than splicing two files.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const faults = [{ failAfter: 300 }];
+  const { fetchImpl } = makeServer(state, faults);
+  let calls = 0;
+  const swapping = async (url, opts) => {
+    if (calls++ === 1) { state.file = makeFile(800, 3); state.etag = '"b"'; }
+    return fetchImpl(url, opts);
+  };
+  const r = await downloadResumable('/d', { fetchImpl: swapping, sleep: noSleep });
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'resumable: changed file restarts from scratch');
+  eq(r.etag, '"b"', 'resumable: etag follows the new file');
+}
+
+{
+  // Append-only: no If-Range, even though the ETag changes as the log grows.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state, [{ failAfter: 400 }]);
+  let calls = 0;
+  const growing = async (url, opts) => {
+    if (calls++ === 1) {
+      const grown = new Uint8Array(1200);
+      grown.set(state.file);
+      grown.set(makeFile(200, 9), 1000);
+      state.file = grown; state.etag = '"a2"';
+    }
+    return fetchImpl(url, opts);
+  };
+  const r = await downloadResumable('/d', { appendOnly: true, fetchImpl: growing, sleep: noSleep });
+  eq(requests[1].headers['If-Range'], undefined, 'appendOnly: resume omits If-Range');
+  eq(r.size, 1200, 'appendOnly: picks up bytes appended meanwhile');
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'appendOnly: result matches grown file');
+}
+
+{
+  // Firmware without Range support: restart on 200 until a clean pass.
+  const state = { file: makeFile(500), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state, [{ failAfter: 100 }, 'ignoreRange']);
+  const r = await downloadResumable('/d', { fetchImpl, sleep: noSleep });
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'no-range firmware: 200 restart still matches');
+  eq(requests.length, 2, 'no-range firmware: two requests');
+}
+
+{
+  // Thrown fetch is retried; exceeding maxRetries rethrows.
+  const state = { file: makeFile(200), etag: '"a"' };
+  const { fetchImpl } = makeServer(state, ['throw', 'throw']);
+  const r = await downloadResumable('/d', { fetchImpl, sleep: noSleep, maxRetries: 2 });
+  eq(r.size, 200, 'retry: recovers after two refused connects');
+
+  const { fetchImpl: bad } = makeServer(state, ['throw', 'throw', 'throw']);
+  let threw = false;
+  try { await downloadResumable('/d', { fetchImpl: bad, sleep: noSleep, maxRetries: 2 }); }
+  catch { threw = true; }
+  eq(threw, true, 'retry: gives up after maxRetries');
+}
+
+{
+  // 416 at exactly the bytes we hold means done (the drop hit after the
+  // last byte but before the stream closed cleanly).
+  const state = { file: makeFile(256), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state, [{ failAfter: 256 }]);
+  const r = await downloadResumable('/d', { fetchImpl, sleep: noSleep });
+  eq(r.size, 256, '416 at EOF: treated as complete');
+  eq(requests.length, 2, '416 at EOF: no further requests');
+}
+
+{
+  // Gzip first reply: no ETag, no size. A drop resumes by file offset
+  // without If-Range, then the 206's ETag guards the next resume.
+  const state = { file: makeFile(1000), etag: '"a"', gzip: true };
+  const { fetchImpl, requests } = makeServer(state, [{ failAfter: 300 }, { failAfter: 400 }]);
+  const progress = [];
+  const r = await downloadResumable('/d', {
+    fetchImpl, sleep: noSleep, onProgress: (p) => progress.push(p),
+  });
+  eq(sameBytes(await blobBytes(r.blob), state.file), true, 'gzip: drop + resume matches');
+  eq(progress[0].total, null, 'gzip: size unknown on the encoded reply');
+  eq(requests[1].headers['Range'], 'bytes=300-', 'gzip: resume asks from the inflated byte count');
+  eq(requests[1].headers['If-Range'], undefined, 'gzip: no ETag yet, so no If-Range');
+  eq(requests[2].headers['Range'], 'bytes=700-', 'gzip: second resume continues');
+  eq(requests[2].headers['If-Range'], '"a"', 'gzip: second resume validated by the 206 ETag');
+}
+
+{
+  // Gzip clean run: one request, ends on the clean close.
+  const state = { file: makeFile(700), etag: '"a"', gzip: true };
+  const { fetchImpl, requests } = makeServer(state);
+  const r = await downloadResumable('/d', { fetchImpl, sleep: noSleep });
+  eq(r.size, 700, 'gzip: clean download size');
+  eq(requests.length, 1, 'gzip: clean download is one request');
+}
+
+// ---- sink / offset -----------------------------------------------------
+
+{
+  // Caller's sink gets the bytes; no Blob is built.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl } = makeServer(state, [{ failAfter: 300 }]);
+  const sink = recordingSink();
+  const r = await downloadResumable('/d', { sink, fetchImpl, sleep: noSleep });
+  eq(sameBytes(sink.bytes, state.file), true, 'sink: receives the whole file across a resume');
+  eq(sink.restarts, 0, 'sink: resume does not restart');
+  eq(r.blob, undefined, 'sink: no Blob in the result');
+}
+
+{
+  // File replaced mid-download: the sink is told to start over.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl } = makeServer(state, [{ failAfter: 300 }]);
+  let calls = 0;
+  const swapping = async (url, opts) => {
+    if (calls++ === 1) { state.file = makeFile(800, 3); state.etag = '"b"'; }
+    return fetchImpl(url, opts);
+  };
+  const sink = recordingSink();
+  await downloadResumable('/d', { sink, fetchImpl: swapping, sleep: noSleep });
+  eq(sink.restarts, 1, 'sink: changed file restarts the sink');
+  eq(sameBytes(sink.bytes, state.file), true, 'sink: holds only the new file');
+}
+
+{
+  // Offset: the sink already has the first 600 bytes (earlier save of
+  // the active log); only the tail is requested.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state);
+  const sink = recordingSink(state.file.slice(0, 600));
+  const r = await downloadResumable('/d', { sink, offset: 600, appendOnly: true, fetchImpl, sleep: noSleep });
+  eq(requests[0].headers['Range'], 'bytes=600-', 'offset: asks past offset');
+  eq(requests[0].headers['If-Range'], undefined, 'offset: appendOnly sends no If-Range');
+  eq(r.size, 1000, 'offset: reports file size');
+  eq(sameBytes(sink.bytes, state.file), true, 'offset: prior bytes + tail make the file');
+}
+
+{
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl, requests } = makeServer(state);
+  const sink = recordingSink(state.file.slice());
+  const r = await downloadResumable('/d', { sink, offset: 1000, fetchImpl, sleep: noSleep });
+  eq(requests.length, 1, 'offset: nothing new is one request');
+  eq(r.size, 1000, 'offset: nothing new keeps size');
+  eq(sink.restarts, 0, 'offset: nothing new keeps the prior bytes');
+}
+
+{
+  // Offset past EOF: the file was replaced by a shorter one. Restart and
+  // fetch it whole.
+  const state = { file: makeFile(1000), etag: '"a"' };
+  const { fetchImpl } = makeServer(state);
+  const sink = recordingSink(makeFile(5000, 1));
+  const r = await downloadResumable('/d', { sink, offset: 5000, appendOnly: true, fetchImpl, sleep: noSleep });
+  eq(sink.restarts, 1, 'offset: shorter file restarts');
+  eq(r.size, 1000, 'offset: shorter file size');
+  eq(sameBytes(sink.bytes, state.file), true, 'offset: shorter file fetched whole');
+
+  const { fetchImpl: noRange } = makeServer(state, ['ignoreRange']);
+  const sink2 = recordingSink(state.file.slice(0, 600));
+  await downloadResumable('/d', { sink: sink2, offset: 600, fetchImpl: noRange, sleep: noSleep });
+  eq(sameBytes(sink2.bytes, state.file), true, 'offset: 200 reply replaces the prior bytes');
+}
+
+// ---- Report ---------------------------------------------------------
+
+console.log('rangeDownload:');
+for (const [tag, msg] of results) console.log(tag, msg);
+console.log(`\n${passed} passed, ${failed} failed`);
+process.exit(failed > 0 ? 1 : 0);
@@ -999,8 +999,71 @@ if (typeof Module.LogReplayTask !== 'function') {
     console.log('OK: task.delete() completed without error');
 }
 
+// ---------------------------------------------------------------------------
+// LogReplaySeeker
+//
+// Checkpointed seek over the same pipeline: after seek(k), next() must
+// return exactly the bytes a straight LogReplayTask pass produced for
+// row k, forward and backward, and advance(n) the bytes for row k+n-1.
+// ---------------------------------------------------------------------------
+
+console.log('\n--- LogReplaySeeker ---');
+
+if (typeof Module.LogReplaySeeker !== 'function') {
+    console.error('FAIL: Module.LogReplaySeeker is not exported');
+    process.exit(1);
+}
+
+{
+    const seekCfg = Module.parse_config(minimalV2Xml);
+    const N = 300;
+    const rows = [];
+    for (let i = 0; i < N; i++) {
+        rows.push(Object.assign({}, minimalRow, {
+            pfwdSmoothed: 1.0 + 0.3 * Math.sin(i * 0.05),
+            p45Smoothed:  0.5 + 0.2 * Math.cos(i * 0.03),
+            iasKt:        15.0 + (i % 120) * 0.5,
+            imuVerticalG: 1.0 + 0.3 * Math.sin(i * 0.1),
+            dataMark:     i % 100,
+            flapsRawAdc:  3908,
+        }));
+    }
+
+    const task = new Module.LogReplayTask(seekCfg, 50, /*flapsRawAdcAvailable=*/true);
+    const ref = rows.map((r) => Array.from(task.processRow(r)));
+    task.delete();
+
+    // 1 s checkpoints at 50 Hz: one every 50 rows.
+    const seeker = new Module.LogReplaySeeker(seekCfg, 50, true, 1.0);
+    for (const r of rows) seeker.appendRow(r);
+    assertEqual('seeker rowCount', seeker.rowCount(), N);
+    seeker.buildCheckpoints();
+    assertEqual('seeker checkpointCount', seeker.checkpointCount(), N / 50);
+
+    const sameBytes = (label, got, want) => {
+        if (got.length !== want.length || got.some((b, j) => b !== want[j])) {
+            console.error(`FAIL: ${label}: frame differs from sequential LogReplayTask`);
+            process.exit(1);
+        }
+    };
+    for (const k of [250, 10, 149, 150, 151, 0, 299, 75]) {
+        if (!seeker.seek(k)) {
+            console.error(`FAIL: seeker.seek(${k}) returned false`);
+            process.exit(1);
+        }
+        sameBytes(`seek(${k})`, Array.from(seeker.next()), ref[k]);
+    }
+    seeker.seek(0);
+    sameBytes('advance(50)', Array.from(seeker.advance(50)), ref[49]);
+    assertEqual('seeker position after advance', seeker.position(), 50);
+    assertEqual('seek past end rejected', seeker.seek(N + 1), false);
+    console.log('OK: LogReplaySeeker seek/next/advance match sequential LogReplayTask frames');
+
+    seeker.delete();
+}
+
 // ---------------------------------------------------------------------------
 // Done
 // ---------------------------------------------------------------------------
 
-console.log('\nAll wasm-smoke checks passed. (compute_percent_lift, compute_anchors, parse_config, LogReplayEngine, build_display_frame, tone_calc, LogReplayTask)');
+console.log('\nAll wasm-smoke checks passed. (compute_percent_lift, compute_anchors, parse_config, LogReplayEngine, build_display_frame, tone_calc, LogReplayTask, LogReplaySeeker)');
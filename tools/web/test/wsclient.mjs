@@ -1,4 +1,5 @@
-// Tests for lib/ws/wsClient.js — frame-to-record mapping.
+// Tests for lib/ws/wsClient.js — frame-to-record mapping and the binary
+// frame decoder.
 //
 // Issues #358 / #455: the producer emits JSON null for AOA, DerivedAOA,
 // IAS, and percentLift when air data is invalid (bIasAlive=false on the
@@ -12,7 +13,13 @@
 //
 // Exit code 0 = all pass.
 
-import { frameToRecord } from '../lib/ws/wsClient.js';
+import { readFileSync } from 'node:fs';
+import { dirname, join } from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+import { decodeLiveDataBin, frameToRecord, LIVE_DATA_BIN_VERSION } from '../lib/ws/wsClient.js';
+
+const REPO_ROOT = join(dirname(fileURLToPath(import.meta.url)), '..', '..', '..');
 
 let failed = 0;
 let passed = 0;
@@ -89,6 +96,44 @@ eq(frameToRecord({ DecelRate: null }).decelRate, 0,
 eq(frameToRecord({ DecelRate: -0.35 }).decelRate, -0.35,
    'decelRate: numeric value preserved');
 
+// ---- Binary frames: DataView decoder vs the C++ encoder --------------
+//
+// v1_cruise.bin is the frame test/test_live_data_bin/ pins byte-for-byte
+// against BuildLiveDataBinFrame, so decoding it here checks the JS field
+// table against the C++ one.
+
+const fixture = readFileSync(join(REPO_ROOT, 'test/fixtures/live_data_bin/v1_cruise.bin'));
+const bin = decodeLiveDataBin(fixture);
+eq(bin !== null, true, 'binary: v1 fixture decodes');
+eq(bin.AOA, 4.25, 'binary: AOA');
+eq(bin.Pitch, -2.5, 'binary: Pitch');
+eq(bin.IAS, 87.5, 'binary: IAS');
+eq(bin.lateralGLoad, -0.06, 'binary: lateralGLoad rounded to the JSON\'s 2 decimals');
+eq(bin.percentLift, 34.8, 'binary: percentLift rounded to the JSON\'s 1 decimal');
+eq(bin.DecelRate, -0.25, 'binary: DecelRate');
+eq(bin.ekfYawDeg, null, 'binary: NaN decodes as null (Madgwick ekf fields)');
+eq(bin.flapsMaxDeg, 40, 'binary: flapsMaxDeg');
+eq(bin.pipPctLift, 20, 'binary: last int16 field');
+eq(bin.dataMark, 12, 'binary: dataMark');
+
+// Same keys as a JSON frame, so frameToRecord and rec.raw readers can't
+// tell the encodings apart.
+const ndjson = readFileSync(join(REPO_ROOT, 'tools/web/dev-server/replay/cruise.ndjson'), 'utf8');
+const jsonFrame = JSON.parse(ndjson.split('\n').find((l) => l.startsWith('{'))).frame;
+eq(Object.keys(bin).sort().join(','), Object.keys(jsonFrame).sort().join(','),
+   'binary: decoded key set matches a JSON frame');
+eq(frameToRecord(bin).aoaIsValid, true, 'binary: record from a decoded frame is valid');
+
+// A typed-array view with a non-zero offset decodes the same frame.
+const padded = new Uint8Array(fixture.length + 3);
+padded.set(fixture, 3);
+eq(decodeLiveDataBin(padded.subarray(3)).AOA, 4.25, 'binary: decodes from an offset view');
+
+const wrongVersion = Uint8Array.from(fixture);
+wrongVersion[0] = LIVE_DATA_BIN_VERSION + 1;
+eq(decodeLiveDataBin(wrongVersion), null, 'binary: unknown version → null');
+eq(decodeLiveDataBin(fixture.subarray(0, fixture.length - 1)), null, 'binary: short frame → null');
+
 // ---- Report ---------------------------------------------------------
 
 console.log('wsClient frameToRecord:');